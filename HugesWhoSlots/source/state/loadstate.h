@@ -15,6 +15,7 @@
 // Standard lib dependencies
 #include <string>
 #include <memory>
+#include <future>
 
 // Forward declaration(s)
 class CSprite2D;
@@ -48,15 +49,15 @@ private:
     void assetsLoad();
     void criticalLoad();
     void criticalInit();
+
+    // Animate and upload textures until the load job is done
+    void waitForLoad( std::future<void> future );
     
 private:
     
     // Load animation
     std::unique_ptr<CSprite2D> m_upSprite;
     
-    // Flag to indicate the thread load is finished
-    bool m_threadActive;
-    
     // Animation members
     float m_time;
     int m_frame;
@@ -0,0 +1,25 @@
+//------------------------ "shader_batch.vert" ------------------------
+
+// Specify which version of GLSL we are using.
+#version 100
+
+// Do not change the order of these as they need to mach the order in the vertex buffer
+// The position is already transformed by the object matrix
+attribute vec3 in_position;
+attribute vec2 in_uv;
+attribute vec4 in_color;
+
+// Camera view matrix
+uniform mat4 cameraViewProjMatrix;
+
+// Needs to be the same name as in the fragment shader
+varying vec2 uv0;
+varying vec4 color0;
+
+void main() 
+{
+    gl_Position = cameraViewProjMatrix * vec4(in_position, 1.0);
+
+    uv0 = in_uv;
+    color0 = in_color;
+}
@@ -15,6 +15,7 @@
 #include <strategy/basicspritestrategy.h>
 #include <utilities/settings.h>
 #include <utilities/highresolutiontimer.h>
+#include <system/replay.h>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -22,7 +23,7 @@
 CBallAI::CBallAI( iSprite * pSprite ) :
     m_sprite(*dynamic_cast<CSprite2D *>(pSprite)),
     m_rStrategy(CStrategyMgr::Instance().find<CBasicSpriteStrategy>("_spriteStrategy")), // Find the strategy that has this ball
-    m_generator(std::random_device{}()),
+    m_generator(CReplay::Instance().getSeed()),
     m_angularImpulse(-1, 1),
     m_rotation(-M_PI, M_PI)
 {
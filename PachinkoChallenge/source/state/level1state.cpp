@@ -28,6 +28,7 @@
 #include <script/scriptmanager.h>
 #include <managers/signalmanager.h>
 #include <common/camera.h>
+#include <system/replay.h>
 #include <common/spritedata.h>
 #include <common/worldvalue.h>
 #include <gui/uimeter.h>
@@ -54,7 +55,7 @@ CLevel1State::CLevel1State() :
         m_multiIndexPos(0),
         m_totalWin(0),
         m_multiplier(1),
-        m_generator(std::random_device{}()),
+        m_generator(CReplay::Instance().getSeed()),
         m_ballRand(0, 8)
 {
     // The state inherits from b2ContactListener to handle physics collisions
@@ -23,6 +23,7 @@
 
 // Game lib dependencies
 #include <system/device.h>
+#include <system/renderdevice.h>
 #include <objectdata/objectdatamanager.h>
 #include <managers/shadermanager.h>
 #include <managers/texturemanager.h>
@@ -33,17 +34,24 @@
 #include <utilities/highresolutiontimer.h>
 #include <utilities/settings.h>
 #include <utilities/exceptionhandling.h>
+#include <utilities/threadpool.h>
 #include <common/color.h>
 
 // Standard lib dependencies
 #include <thread>
+#include <chrono>
+
+namespace
+{
+    // Time each animation frame can spend uploading decoded textures
+    const double UPLOAD_BUDGET_MS = 4.0;
+}
 
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CLoadState::CLoadState( const CStateMessage & stateMsg ) :
     iGameState( NGameDefs::EGS_GAME_LOAD, stateMsg ),
-    m_threadActive(true),
     m_time(0),
     m_frame(0)
 {
@@ -98,14 +106,14 @@ void CLoadState::animate()
     if( m_time > 83.f )
     {
         // Clear the screen
-        glClear( GL_COLOR_BUFFER_BIT );
+        CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
 
         m_upSprite->setFrame( m_frame );
         m_frame = (m_frame + 1) % m_upSprite->getFrameCount();
 
         m_upSprite->render( CCameraMgr::Instance().getDefaultProjMatrix() );
 
-        SDL_GL_SwapWindow( CDevice::Instance().getWindow() );
+        CRenderDevice::Instance().present();
 
         // Apparently it's a good practice to do this at the end of a render cycle
         CShaderMgr::Instance().unbind();
@@ -149,9 +157,6 @@ void CLoadState::objectDataLoad()
         m_errorTitle = "Unknown Error";
         m_errorMsg = "Something bad happened and I'm not sure what it was.";
     }
-
-    // Set the flag to indicate the load is complete
-    m_threadActive = false;
 }
 
 
@@ -233,28 +238,45 @@ void CLoadState::assetsLoad()
         m_errorTitle = "Unknown Error";
         m_errorMsg = "Something bad happened and I'm not sure what it was.";
     }
-
-    // Set the flag to indicate the load is complete
-    m_threadActive = false;
 } 
 
 
 /***************************************************************************
-*    DESC:  Is the state done
+*    DESC:  Animate and upload the decoded textures until the load job
+*           is done. The images are decoded on the thread pool
 ****************************************************************************/
-bool CLoadState::doStateChange()
+void CLoadState::waitForLoad( std::future<void> future )
 {
-    CActionMgr::Instance().resetLastUsedDevice();
+    try
+    {
+        do
+        {
+            animate();
 
-    std::thread objLoadThread( &CLoadState::objectDataLoad, this );
-    objLoadThread.detach();
+            CTextureMgr::Instance().uploadDecoded( UPLOAD_BUDGET_MS );
+        }
+        while( future.wait_for( std::chrono::milliseconds( 5 ) ) != std::future_status::ready );
 
-    do
+        // Upload what's left so creating from data doesn't have to wait
+        CTextureMgr::Instance().uploadDecoded();
+    }
+    catch(...)
     {
-        animate();
-        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+        // Don't leave the job running on a state that's going away
+        future.wait();
+        throw;
     }
-    while(m_threadActive);
+}
+
+
+/***************************************************************************
+*    DESC:  Is the state done
+****************************************************************************/
+bool CLoadState::doStateChange()
+{
+    CActionMgr::Instance().resetLastUsedDevice();
+
+    waitForLoad( CThreadPool::Instance().postRetFut( &CLoadState::objectDataLoad, this ) );
 
     // If there was an error in the load thread, re-throw exception
     if( !m_errorMsg.empty() )
@@ -262,17 +284,8 @@ bool CLoadState::doStateChange()
 
     criticalLoad();
 
-    // Start the loading/unloading thread
-    m_threadActive = true;
-    std::thread loadThread( &CLoadState::assetsLoad, this );
-    loadThread.detach();
-
-    do
-    {
-        animate();
-        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
-    }
-    while(m_threadActive);
+    // Start the loading/unloading job
+    waitForLoad( CThreadPool::Instance().postRetFut( &CLoadState::assetsLoad, this ) );
 
     // If there was an error in the load thread, re-throw exception
     if( !m_errorMsg.empty() )
@@ -0,0 +1,242 @@
+// atlasPacker.cpp : Packs images into sprite sheet pages.
+//
+// The images on the command line are packed with the same packer the game
+// uses for atlas="true" textures. Each page is written as a .tga with a
+// sprite sheet .xml next to it. A glyph is named after the image's file
+// name without the folder and extension. With more than one page the
+// files are numbered, ie <name>_0.tga and <name>_0.xml.
+//
+// Use a page in the object data the same as any sprite sheet. ie
+// <texture file="data/textures/playerShip/playerShip.tga"/>
+// <mesh genType="sprite_sheet">
+//     <spriteSheet file="data/textures/playerShip/playerShip.xml">
+//         <glyph id="shipGun"/>
+//     </spriteSheet>
+// </mesh>
+
+// Game lib dependencies
+#include <utilities/atlaspacker.h>
+#include <utilities/exceptionhandling.h>
+
+// SOIL lib dependency
+#include <soil/SOIL.h>
+
+// Standard lib dependencies
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    // Smallest page
+    const int MIN_PAGE_SIZE = 64;
+
+    // Loaded RGBA image
+    class CImage
+    {
+    public:
+        unsigned char * m_pData = nullptr;
+        CSize<int> m_size;
+    };
+}
+
+/************************************************************************
+*    DESC:  Print the command line options
+************************************************************************/
+void PrintUsage()
+{
+    std::cout
+        << "atlasPacker [options] <name> <image> [image...]" << std::endl
+        << "  --size <pixels>      largest page size (default 2048)" << std::endl
+        << "  --padding <pixels>   space between the images (default 2)" << std::endl;
+}
+
+/************************************************************************
+*    DESC:  Get the glyph name. The file name without the folder and extension
+************************************************************************/
+std::string GetGlyphName( const std::string & filePath )
+{
+    const size_t slash = filePath.find_last_of( "/\\" );
+    std::string name = (slash == std::string::npos) ? filePath : filePath.substr( slash + 1 );
+
+    const size_t dot = name.find_last_of( '.' );
+    if( dot != std::string::npos )
+        name.erase( dot );
+
+    return name;
+}
+
+/************************************************************************
+*    DESC:  Write the sprite sheet of a page
+************************************************************************/
+bool WriteSpriteSheet(
+    const std::string & filePath,
+    const CAtlasPacker & packer,
+    const std::vector<std::string> & nameVec,
+    int page )
+{
+    std::ofstream file( filePath );
+    if( !file )
+        return false;
+
+    file << "<?xml version=\"1.0\"?>" << std::endl
+         << "<spriteSheet width=\"" << packer.getPageSize().w << "\" height=\"" << packer.getPageSize().h << "\">" << std::endl
+         << std::endl;
+
+    for( size_t i = 0; i < packer.getCount(); ++i )
+    {
+        if( packer.getPage( i ) != page )
+            continue;
+
+        const CRect<int> & rect = packer.getRect( i );
+
+        file << "    <rect"
+             << " x1=\"" << std::setw(4) << rect.x1 << "\""
+             << " y1=\"" << std::setw(4) << rect.y1 << "\""
+             << " x2=\"" << std::setw(4) << rect.x2 << "\""
+             << " y2=\"" << std::setw(4) << rect.y2 << "\""
+             << " cx=\"   0\" cy=\"   0\""
+             << " name=\"" << nameVec[i] << "\"/>" << std::endl;
+    }
+
+    file << std::endl << "</spriteSheet>" << std::endl;
+
+    return file.good();
+}
+
+/************************************************************************
+*    DESC:  Main entry point
+************************************************************************/
+int main( int argc, char * argv[] )
+{
+    std::vector<std::string> argVec;
+    int pageSize = 2048;
+    int padding = 2;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+
+        if( (arg == "--help") || (arg == "-h") )
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        if( (arg == "--size") && (i + 1 < argc) )
+            pageSize = std::atoi( argv[++i] );
+
+        else if( (arg == "--padding") && (i + 1 < argc) )
+            padding = std::atoi( argv[++i] );
+
+        else
+            argVec.push_back( arg );
+    }
+
+    if( (argVec.size() < 2) || (pageSize < MIN_PAGE_SIZE) )
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string name = argVec.front();
+
+    // Load the images as RGBA so they copy straight into the page
+    std::vector<CImage> imageVec;
+    std::vector<std::string> nameVec;
+    std::set<std::string> nameSet;
+    int result = 0;
+
+    for( size_t i = 1; (i < argVec.size()) && (result == 0); ++i )
+    {
+        CImage image;
+        int channels = 0;
+
+        image.m_pData = SOIL_load_image( argVec[i].c_str(), &image.m_size.w, &image.m_size.h, &channels, SOIL_LOAD_RGBA );
+
+        if( image.m_pData == nullptr )
+        {
+            std::cout << "Failed to load " << argVec[i] << " (" << SOIL_last_result() << ")" << std::endl;
+            result = 1;
+        }
+        else if( !nameSet.insert( GetGlyphName( argVec[i] ) ).second )
+        {
+            std::cout << "Glyph name used twice " << GetGlyphName( argVec[i] ) << " (" << argVec[i] << ")" << std::endl;
+            SOIL_free_image_data( image.m_pData );
+            result = 1;
+        }
+        else
+        {
+            imageVec.push_back( image );
+            nameVec.push_back( GetGlyphName( argVec[i] ) );
+        }
+    }
+
+    if( result == 0 )
+    {
+        try
+        {
+            CAtlasPacker packer( CSize<int>( pageSize, pageSize ), padding );
+
+            for( auto & iter : imageVec )
+                packer.add( iter.m_size );
+
+            packer.packToFit( MIN_PAGE_SIZE );
+
+            const CSize<int> & size = packer.getPageSize();
+
+            for( size_t page = 0; (page < packer.getPageCount()) && (result == 0); ++page )
+            {
+                // Copy the images into the page. The space between them stays clear
+                std::vector<unsigned char> pageVec( static_cast<size_t>(size.w) * size.h * 4, 0 );
+
+                for( size_t i = 0; i < imageVec.size(); ++i )
+                {
+                    if( packer.getPage( i ) != static_cast<int>(page) )
+                        continue;
+
+                    const CRect<int> & rect = packer.getRect( i );
+
+                    for( int y = 0; y < rect.y2; ++y )
+                        std::memcpy(
+                            &pageVec[((static_cast<size_t>(rect.y1 + y) * size.w) + rect.x1) * 4],
+                            imageVec[i].m_pData + (static_cast<size_t>(y) * rect.x2 * 4),
+                            static_cast<size_t>(rect.x2) * 4 );
+                }
+
+                const std::string pageName =
+                    (packer.getPageCount() > 1) ? (name + "_" + std::to_string( page )) : name;
+
+                if( SOIL_save_image( (pageName + ".tga").c_str(), SOIL_SAVE_TYPE_TGA, size.w, size.h, 4, pageVec.data() ) == 0 )
+                {
+                    std::cout << "Failed to write " << pageName << ".tga (" << SOIL_last_result() << ")" << std::endl;
+                    result = 1;
+                }
+                else if( !WriteSpriteSheet( pageName + ".xml", packer, nameVec, static_cast<int>(page) ) )
+                {
+                    std::cout << "Failed to write " << pageName << ".xml" << std::endl;
+                    result = 1;
+                }
+            }
+
+            if( result == 0 )
+                std::cout << imageVec.size() << " images packed into " << packer.getPageCount()
+                          << " pages of " << size.w << " x " << size.h << std::endl;
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            std::cout << ex.getErrorTitle() << std::endl << ex.getErrorMsg() << std::endl;
+            result = 1;
+        }
+    }
+
+    for( auto & iter : imageVec )
+        SOIL_free_image_data( iter.m_pData );
+
+    return result;
+}
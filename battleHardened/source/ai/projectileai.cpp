@@ -15,6 +15,10 @@
 #include <managers/soundmanager.h>
 #include <utilities/settings.h>
 #include <utilities/highresolutiontimer.h>
+#include <objectdata/objectdata2d.h>
+
+// Standard lib dependencies
+#include <vector>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -70,9 +74,18 @@ void CProjectileAI::update()
     else
         m_firstUpdate = false;
 
-    // Did we collide with an enemy ship?
-    //if( m_rStrategy.IsCollision( m_sprite ) != nullptr )
-    //    m_rStrategy.HandleMessage( NDefs::ESM_KILL_SPRITE, m_sprite.GetId() );
+    // Did we collide with a sprite in a group the projectile collides with?
+    m_hitSpriteVec.clear();
+    m_rStrategy.findInRadius( m_sprite.getTransPos(), m_sprite.getRadius(), m_hitSpriteVec );
+
+    for( auto iter : m_hitSpriteVec )
+    {
+        if( (iter != &m_sprite) && (m_sprite.getCollisionMask() & iter->getCollisionGroup()) )
+        {
+            m_rStrategy.setToDestroy( m_sprite.getId() );
+            return;
+        }
+    }
 
     // Delete if goes out of view
     if( m_sprite.getTransPos().getLengthSquared2D() > 250000.f )
@@ -14,6 +14,9 @@
 // Game lib dependencies
 #include <common/point.h>
 
+// Standard lib dependencies
+#include <vector>
+
 // Forward declaration(s)
 class CSprite2D;
 class iSprite;
@@ -51,6 +54,9 @@ private:
     
     // Reference to sprite strategy.
     CBasicSpriteStrategy & m_rStrategy;
+    
+    // The sprites found by the collision query. Reused each update
+    std::vector<iSprite *> m_hitSpriteVec;
 };
 
 #endif  // __projectile_ai_h__
@@ -47,6 +47,7 @@
 #include <script/scripthighresolutiontimer.h>
 #include <2d/sprite2d.h>
 #include <system/device.h>
+#include <system/renderdevice.h>
 #include <gui/menumanager.h>
 #include <gui/menu.h>
 #include <gui/uicontrol.h>
@@ -133,12 +134,12 @@ void CStartUpState::fade(
             current = finalColor;
 
         // Clear the screen
-        glClear( GL_COLOR_BUFFER_BIT );
+        CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
 
         CShaderMgr::Instance().setShaderColor( "shader_2d", "additive", current );
         sprite.render( CCameraMgr::Instance().getDefaultProjMatrix() );
 
-        SDL_GL_SwapWindow( CDevice::Instance().getWindow() );
+        CRenderDevice::Instance().present();
 
         // Apparently it's a good practice to do this at the end of a render cycle
         CShaderMgr::Instance().unbind();
@@ -2,170 +2,1644 @@
 //
 
 #include <iostream>
-#include <xmmintrin.h>
-#include <utilities/highresolutiontimer.h>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <utilities/matrixfunc.h>
+#include <utilities/matrix.h>
+#include <2d/font.h>
+#include <2d/fontlayout.h>
+#include <common/fontdata.h>
+#include <utilities/atlaspacker.h>
+#include <utilities/fixedstep.h>
+#include <2d/object2d.h>
+#include <common/transformstore.h>
+#include <system/nullrenderdevice.h>
+#include <script/scriptfunctable.h>
+#include <script/scriptmanager.h>
+#include <utilities/threadpool.h>
+#include <utilities/xmlParser.h>
+#include <utilities/exceptionhandling.h>
+#include <system/renderdevice.h>
+#include <managers/spritebatchmanager.h>
+#include <managers/texturemanager.h>
+#include <2d/spritebatch2d.h>
+#include <gui/uiscrollbox.h>
+#include <gui/uislider.h>
+#include <gui/uicontrolfactory.h>
+#include <gui/messagecracker.h>
+#include <utilities/genfunc.h>
+#include <common/irendercmdstream.h>
+#include <common/shaderdata.h>
+#include <common/vertex2d.h>
+#include <common/color.h>
+#include <GL/glew.h>
+#include <angelscript.h>
+#include <thread>
+#include <fstream>
+#include <cstdio>
 
-void MultiMatrix1()
+// Google Benchmark style harness for the matrix kernels.
+// Each benchmark loops while the state keeps running and the runner grows the
+// iteration count until the run is long enough to time.
+class CBenchState
 {
-    float TempMatrix[4][4];
-    float Matrix[4][4] = {{2,5,8,9},{5,9,3,5},{4,6,9,3},{6,9,3,5}};
-    float NewMatrix[4][4] = {{7,3,7,9},{3,9,8,5},{2,6,9,4},{6,9,3,2}};
-    
-    for (int i = 0; i < 4; ++i)
-        for (int j = 0; j < 4; ++j) 
-            TempMatrix[i][j] = (Matrix[i][j] * NewMatrix[i][j]);
+public:
+
+    CBenchState( size_t iterations ) : m_iterations(iterations), m_remaining(iterations) {}
+
+    // Returns false once the body has been run the requested number of times
+    bool keepRunning()
+    {
+        if( m_remaining == 0 )
+            return false;
+
+        --m_remaining;
+        return true;
+    }
+
+    size_t m_iterations;
+    size_t m_remaining;
+};
+
+struct CBenchmark
+{
+    std::string m_name;
+    std::function<void(CBenchState &)> m_func;
+};
+
+std::vector<CBenchmark> & GetBenchmarks()
+{
+    static std::vector<CBenchmark> benchmarks;
+    return benchmarks;
 }
 
-void MultiMatrix2()
+struct CBenchRegister
 {
-    float TempMatrix[4][4];
-    float Matrix[4][4] = {{2,5,8,9},{5,9,3,5},{4,6,9,3},{6,9,3,5}};
-    float NewMatrix[4][4] = {{7,3,7,9},{3,9,8,5},{2,6,9,4},{6,9,3,2}};
-    
-    for (int i = 0; i < 4; i++)
-        __m128 c = _mm_mul_ps( _mm_load_ps(&Matrix[i][0]), _mm_load_ps(&NewMatrix[i][0]) );
+    CBenchRegister( const char * name, void (*func)(CBenchState &) )
+    { GetBenchmarks().push_back( CBenchmark{ name, func } ); }
+};
+
+#define BENCHMARK(func) static CBenchRegister s_register_##func( #func, func )
+
+// Keeps the results from being optimized away
+volatile float g_sink = 0;
+
+const double MIN_BENCH_TIME_SEC = 0.5;
+const size_t MAX_BENCH_ITERATIONS = 1000000000;
+
+void RunBenchmarks()
+{
+    std::cout << std::left << std::setw(28) << "Benchmark" << std::right << std::setw(14) << "Time" << std::setw(14) << "Iterations" << std::endl;
+    std::cout << std::string( 56, '-' ) << std::endl;
+
+    for( auto & iter : GetBenchmarks() )
+    {
+        size_t iterations = 1;
+        double seconds = 0;
+
+        for(;;)
+        {
+            CBenchState state( iterations );
+
+            auto start = std::chrono::steady_clock::now();
+            iter.m_func( state );
+            seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+            if( (seconds >= MIN_BENCH_TIME_SEC) || (iterations >= MAX_BENCH_ITERATIONS) )
+                break;
+
+            // Estimate the count needed to hit the min time, growing by 10x at most
+            double multiplier = (seconds <= 0) ? 10.0 : (MIN_BENCH_TIME_SEC * 1.4) / seconds;
+            if( multiplier > 10.0 )
+                multiplier = 10.0;
+            if( multiplier < 1.5 )
+                multiplier = 1.5;
+
+            iterations = (size_t)(iterations * multiplier);
+        }
+
+        std::cout << std::left << std::setw(28) << iter.m_name << std::right
+                  << std::setw(11) << std::fixed << std::setprecision(2) << ((seconds * 1e9) / iterations) << " ns"
+                  << std::setw(14) << iterations << std::endl;
+    }
 }
 
-int main()
+// Random test data
+const int MATRIX_COUNT = 256;
+const int POINT_COUNT = 1024;
+
+struct CTestData
 {
-    std::cout << "Test started..." << std::endl;
-    
-    CHighResTimer::Instance().timerStart();
-    
-    for( int i = 0; i < 30000000; ++i )
-        MultiMatrix2();
-    
-    std::cout << "Execution time: " << CHighResTimer::Instance().timerStop() << std::endl;
+    CTestData()
+    {
+        std::mt19937 gen( 12345 );
+        std::uniform_real_distribution<float> dist( -10.f, 10.f );
 
-    return 0;
+        matrixVec.resize( MATRIX_COUNT * 16 );
+        for( auto & iter : matrixVec )
+            iter = dist( gen );
+
+        pointVec.resize( POINT_COUNT );
+        for( auto & iter : pointVec )
+            iter = CPoint<float>( dist( gen ), dist( gen ), dist( gen ) );
+
+        destPointVec.resize( POINT_COUNT );
+    }
+
+    const float * getMatrix( size_t index ) const
+    { return &matrixVec[(index % MATRIX_COUNT) * 16]; }
+
+    std::vector<float> matrixVec;
+    std::vector< CPoint<float> > pointVec;
+    std::vector< CPoint<float> > destPointVec;
+};
+
+CTestData & GetTestData()
+{
+    static CTestData testData;
+    return testData;
 }
 
-/*#include <xmmintrin.h>
-#include <iostream>
-#include <utilities/highresolutiontimer.h>
+void BM_MultiplyScalar( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    float dest[16];
+    size_t i = 0;
+
+    while( state.keepRunning() )
+    {
+        NMatrixFunc::MultiplyScalar( dest, data.getMatrix( i ), data.getMatrix( i + 1 ) );
+        ++i;
+    }
+
+    g_sink = dest[0];
+}
+BENCHMARK(BM_MultiplyScalar);
 
-void MultiMatrix1()
+void BM_Multiply( CBenchState & state )
 {
-    float TempMatrix[4][4];
-    float Matrix[4][4] = {{2,5,8,9},{5,9,3,5},{4,6,9,3},{6,9,3,5}};
-    float NewMatrix[4][4] = {{7,3,7,9},{3,9,8,5},{2,6,9,4},{6,9,3,2}};
-    
-    for (int i = 0; i < 4; ++i)
-        for (int j = 0; j < 4; ++j) 
-            TempMatrix[i][j] = (Matrix[i][0] * NewMatrix[0][j])
-              + (Matrix[i][1] * NewMatrix[1][j])
-              + (Matrix[i][2] * NewMatrix[2][j])
-              + (Matrix[i][3] * NewMatrix[3][j]);
-    
-    // Copy TempMatrix to Matrix:
-    for (int i = 0; i < 4; ++i)
+    CTestData & data = GetTestData();
+    float dest[16];
+    size_t i = 0;
+
+    while( state.keepRunning() )
     {
-       Matrix[i][0] = TempMatrix[i][0];
-       Matrix[i][1] = TempMatrix[i][1];
-       Matrix[i][2] = TempMatrix[i][2];
-       Matrix[i][3] = TempMatrix[i][3];
+        NMatrixFunc::Multiply( dest, data.getMatrix( i ), data.getMatrix( i + 1 ) );
+        ++i;
     }
+
+    g_sink = dest[0];
 }
+BENCHMARK(BM_Multiply);
 
-void MultiMatrix2()
+// Local matrix of a 2D object. Scaled, rotated about z and translated
+void Make2DMatrix( CMatrix & matrix, size_t index )
 {
-    float TempMatrix[16];
-    float Matrix[16]= {2,5,8,9,5,9,3,5,4,6,9,3,6,9,3,5};
-    float NewMatrix[16] = {7,3,7,9,3,9,8,5,2,6,9,4,6,9,3,2};
-    int offset;
-    
-    for (int i = 0; i < 4; ++i)
+    const float * pValue = GetTestData().getMatrix( index );
+
+    matrix.initilizeMatrix();
+    matrix.setScale( CPoint<float>( pValue[0], pValue[1], 1.f ) );
+    matrix.rotate( CPoint<float>( 0.f, 0.f, pValue[2] ) );
+    matrix.translate( CPoint<float>( pValue[3], pValue[4], pValue[5] ) );
+}
+
+void BM_Multiply2D( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    CMatrix local;
+    Make2DMatrix( local, 0 );
+    float dest[16];
+    size_t i = 0;
+
+    while( state.keepRunning() )
     {
-        offset = (i<<2);
-        
-        for (int j = 0; j < 4; ++j)
+        NMatrixFunc::Multiply( dest, local(), data.getMatrix( i++ ) );
+    }
+
+    g_sink = dest[0];
+}
+BENCHMARK(BM_Multiply2D);
+
+void BM_MultiplyAffine2D( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    CMatrix local;
+    Make2DMatrix( local, 0 );
+    float dest[16];
+    size_t i = 0;
+
+    while( state.keepRunning() )
+    {
+        NMatrixFunc::MultiplyAffine2D( dest, local(), data.getMatrix( i++ ) );
+    }
+
+    g_sink = dest[0];
+}
+BENCHMARK(BM_MultiplyAffine2D);
+
+// The local matrix rebuild and parent multiply CObject2D::transform does
+void BM_Transform2D( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    CMatrix parent( const_cast<float *>(data.getMatrix( 0 )) );
+    CMatrix local, matrix;
+    size_t i = 0;
+
+    while( state.keepRunning() )
+    {
+        Make2DMatrix( local, i++ );
+        matrix.multiply( local, parent );
+    }
+
+    g_sink = matrix[0];
+}
+BENCHMARK(BM_Transform2D);
+
+// 10k 2D objects turned every frame. One at a time, then in the batched pass of the store
+const int TRANSFORM_OBJECT_COUNT = 10000;
+
+std::vector< std::unique_ptr<CObject2D> > MakeTransformObjects( bool batch )
+{
+    std::vector< std::unique_ptr<CObject2D> > objectVec;
+
+    for( int i = 0; i < TRANSFORM_OBJECT_COUNT; ++i )
+    {
+        objectVec.emplace_back( new CObject2D );
+        objectVec.back()->setPos( (i % 100) * 10, (i / 100) * 10 );
+        objectVec.back()->setScale( 2, 2, 1 );
+        objectVec.back()->setCenterPos( 5, 5 );
+        objectVec.back()->setRot( 0, 0, i );
+        objectVec.back()->setBatchTransform( batch );
+    }
+
+    return objectVec;
+}
+
+void BM_TransformObjects_10k( CBenchState & state )
+{
+    auto objectVec = MakeTransformObjects( false );
+
+    while( state.keepRunning() )
+    {
+        for( auto & iter : objectVec )
         {
-            TempMatrix[offset+j] = (Matrix[offset] * NewMatrix[j])
-              + (Matrix[offset+1] * NewMatrix[4+j])
-              + (Matrix[offset+2] * NewMatrix[8+j])
-              + (Matrix[offset+3] * NewMatrix[12+j]);
+            iter->incRot( 0, 0, 1 );
+            iter->transform();
         }
     }
-    
-    // Copy TempMatrix to Matrix:
-    for (int i = 0; i < 16; ++i)
+
+    g_sink = objectVec.back()->getMatrix()[0];
+}
+BENCHMARK(BM_TransformObjects_10k);
+
+void BM_TransformStore_10k( CBenchState & state )
+{
+    auto objectVec = MakeTransformObjects( true );
+
+    while( state.keepRunning() )
     {
-       Matrix[i] = TempMatrix[i];
-       Matrix[i] = TempMatrix[i];
-       Matrix[i] = TempMatrix[i];
-       Matrix[i] = TempMatrix[i];
+        for( auto & iter : objectVec )
+            iter->incRot( 0, 0, 1 );
+
+        CTransformStore::Instance().transform2D();
+
+        for( auto & iter : objectVec )
+            iter->transform();
     }
+
+    g_sink = objectVec.back()->getMatrix()[0];
 }
+BENCHMARK(BM_TransformStore_10k);
 
-void MultiMatrix3()
+void BM_TransformPointScalar( CBenchState & state )
 {
-    float TempMatrix[4][4];
-    float Matrix[4][4] = {{2,5,8,9},{5,9,3,5},{4,6,9,3},{6,9,3,5}};
-    float NewMatrix[4][4] = {{7,3,7,9},{3,9,8,5},{2,6,9,4},{6,9,3,2}};
-    
-    for (int i = 0; i < 4; i++)
+    CTestData & data = GetTestData();
+    CPoint<float> dest;
+    size_t i = 0;
+
+    while( state.keepRunning() )
+    {
+        NMatrixFunc::TransformPointScalar( dest, data.pointVec[i % POINT_COUNT], data.getMatrix( i ) );
+        ++i;
+    }
+
+    g_sink = dest.x;
+}
+BENCHMARK(BM_TransformPointScalar);
+
+void BM_TransformPoint( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    CPoint<float> dest;
+    size_t i = 0;
+
+    while( state.keepRunning() )
+    {
+        NMatrixFunc::TransformPoint( dest, data.pointVec[i % POINT_COUNT], data.getMatrix( i ) );
+        ++i;
+    }
+
+    g_sink = dest.x;
+}
+BENCHMARK(BM_TransformPoint);
+
+void BM_TransformPointsScalar_1024( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    size_t i = 0;
+
+    while( state.keepRunning() )
+        NMatrixFunc::TransformPointsScalar( data.destPointVec.data(), data.pointVec.data(), POINT_COUNT, data.getMatrix( i++ ) );
+
+    g_sink = data.destPointVec.back().x;
+}
+BENCHMARK(BM_TransformPointsScalar_1024);
+
+void BM_TransformPoints_1024( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    size_t i = 0;
+
+    while( state.keepRunning() )
+        NMatrixFunc::TransformPoints( data.destPointVec.data(), data.pointVec.data(), POINT_COUNT, data.getMatrix( i++ ) );
+
+    g_sink = data.destPointVec.back().x;
+}
+BENCHMARK(BM_TransformPoints_1024);
+
+void BM_InvertScalar( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    float dest[16];
+    size_t i = 0;
+
+    while( state.keepRunning() )
+        NMatrixFunc::InvertScalar( dest, data.getMatrix( i++ ) );
+
+    g_sink = dest[0];
+}
+BENCHMARK(BM_InvertScalar);
+
+void BM_Invert( CBenchState & state )
+{
+    CTestData & data = GetTestData();
+    float dest[16];
+    size_t i = 0;
+
+    while( state.keepRunning() )
+        NMatrixFunc::Invert( dest, data.getMatrix( i++ ) );
+
+    g_sink = dest[0];
+}
+BENCHMARK(BM_Invert);
+
+// Font with made up glyphs. The digits share an advance like most fonts
+const int COUNTER_COUNT = 256;
+
+struct CFontTestData
+{
+    CFontTestData() : font("")
     {
-        for (int j = 0; j < 4; j++)
+        for( int id = ' '; id <= '~'; ++id )
         {
-            __m128 a = _mm_load_ps(&Matrix[i][0]);
-            __m128 b = _mm_load_ps(&NewMatrix[i][0]);
-            
-            __m128 c = _mm_mul_ps( a, b );
-            
-            TempMatrix[i][j] = c[0] + c[1] + c[2] + c[3];
+            CCharData charData;
+            charData.offset.w = (id >= '0' && id <= '9') ? 1 : (id % 3);
+            charData.offset.h = id % 5;
+            charData.xAdvance = (id >= '0' && id <= '9') ? 20 : 12 + (id % 9);
+            charData.rect = CRect<float>( (id % 16) * 32, (id / 16) * 32, charData.xAdvance - 2 + (id % 2), 24 + (id % 3) );
+
+            font.addCharData( id, charData );
         }
+
+        fontData.m_fontProp.m_hAlign = NDefs::EHA_HORZ_LEFT;
+
+        for( int i = 0; i < COUNTER_COUNT; ++i )
+            counterVec.push_back( "Score: " + std::to_string( 1000000 + (i * 7919) ) );
     }
-    
-    // Copy TempMatrix to Matrix:
-    for (int i = 0; i < 4; i++)
+
+    CFont font;
+    CFontData fontData;
+    std::vector<std::string> counterVec;
+};
+
+CFontTestData & GetFontTestData()
+{
+    static CFontTestData testData;
+    return testData;
+}
+
+void BM_FontLayout( CBenchState & state )
+{
+    CFontTestData & data = GetFontTestData();
+    size_t i = 0;
+
+    while( state.keepRunning() )
+        NFontLayout::Build( data.font, data.counterVec[i++ % COUNTER_COUNT], data.fontData );
+
+    g_sink = data.fontData.m_fontStrSize.w;
+}
+BENCHMARK(BM_FontLayout);
+
+void BM_FontCounterUpdate( CBenchState & state )
+{
+    CFontTestData & data = GetFontTestData();
+    size_t firstQuad, quadCount;
+    size_t i = 0;
+
+    NFontLayout::Build( data.font, data.counterVec[0], data.fontData );
+
+    while( state.keepRunning() )
+        NFontLayout::Update( data.font, data.counterVec[i++ % COUNTER_COUNT], data.fontData, firstQuad, quadCount );
+
+    g_sink = data.fontData.m_fontStrSize.w;
+}
+BENCHMARK(BM_FontCounterUpdate);
+
+// Random image sizes to pack into atlas pages
+const int ATLAS_RECT_COUNT = 256;
+const CSize<int> ATLAS_PAGE_SIZE( 512, 512 );
+
+std::vector< CSize<int> > & GetAtlasTestData()
+{
+    static std::vector< CSize<int> > sizeVec;
+
+    if( sizeVec.empty() )
     {
-       Matrix[i][0] = TempMatrix[i][0];
-       Matrix[i][1] = TempMatrix[i][1];
-       Matrix[i][2] = TempMatrix[i][2];
-       Matrix[i][3] = TempMatrix[i][3];
+        std::mt19937 gen( 12345 );
+        std::uniform_int_distribution<int> dist( 1, 128 );
+
+        for( int i = 0; i < ATLAS_RECT_COUNT; ++i )
+            sizeVec.emplace_back( dist( gen ), dist( gen ) );
     }
+
+    return sizeVec;
 }
 
-void MultiMatrix4()
+void BM_AtlasPack_256( CBenchState & state )
 {
-    float tempMatrix[16];
-    float matrix[16]= {2,5,8,9,5,9,3,5,4,6,9,3,6,9,3,5};
-    float newMatrix[16] = {7,3,7,9,3,9,8,5,2,6,9,4,6,9,3,2};
-    
-    float (*Matrix)[4] = (float (*)[4]) matrix;
-    float (*NewMatrix)[4] = (float (*)[4]) newMatrix;
-    float (*TempMatrix)[4] = (float (*)[4]) tempMatrix;
-    
-    for (int i = 0; i < 4; ++i)
-        for (int j = 0; j < 4; ++j) 
-            TempMatrix[i][j] = (Matrix[i][0] * NewMatrix[0][j])
-              + (Matrix[i][1] * NewMatrix[1][j])
-              + (Matrix[i][2] * NewMatrix[2][j])
-              + (Matrix[i][3] * NewMatrix[3][j]);
-    
-    // Copy TempMatrix to Matrix:
-    for (int i = 0; i < 4; ++i)
+    auto & sizeVec = GetAtlasTestData();
+    size_t pageCount = 0;
+
+    while( state.keepRunning() )
+    {
+        CAtlasPacker packer( ATLAS_PAGE_SIZE );
+
+        for( auto & iter : sizeVec )
+            packer.add( iter );
+
+        packer.pack();
+        pageCount += packer.getPageCount();
+    }
+
+    g_sink = pageCount;
+}
+BENCHMARK(BM_AtlasPack_256);
+
+// Check the SIMD path matches the scalar path bit for bit
+bool Verify( const char * name, bool result )
+{
+    std::cout << (result ? "PASS  " : "FAIL  ") << name << std::endl;
+    return result;
+}
+
+bool VerifyKernels()
+{
+    CTestData & data = GetTestData();
+    bool result = true;
+
+    bool same = true;
+    bool aliasSame = true;
+    for( int i = 0; i < MATRIX_COUNT; ++i )
+    {
+        float simd[16], scalar[16];
+        NMatrixFunc::Multiply( simd, data.getMatrix( i ), data.getMatrix( i + 1 ) );
+        NMatrixFunc::MultiplyScalar( scalar, data.getMatrix( i ), data.getMatrix( i + 1 ) );
+        same &= (std::memcmp( simd, scalar, sizeof(simd) ) == 0);
+
+        // dest is also a source like CMatrix::mergeMatrix
+        float alias[16];
+        std::memcpy( alias, data.getMatrix( i ), sizeof(alias) );
+        NMatrixFunc::Multiply( alias, alias, data.getMatrix( i + 1 ) );
+        aliasSame &= (std::memcmp( alias, scalar, sizeof(alias) ) == 0);
+    }
+    result &= Verify( "Multiply", same );
+    result &= Verify( "Multiply in place", aliasSame );
+
+    // The 2D path skips terms that are zero so only the sign of a zero can differ
+    same = true;
+    bool scalarSame = true;
+    for( int i = 0; i < MATRIX_COUNT; ++i )
+    {
+        CMatrix local;
+        Make2DMatrix( local, i );
+
+        float full[16], affine[16], affineScalar[16];
+        NMatrixFunc::MultiplyScalar( full, local(), data.getMatrix( i + 1 ) );
+        NMatrixFunc::MultiplyAffine2D( affine, local(), data.getMatrix( i + 1 ) );
+        NMatrixFunc::MultiplyAffine2DScalar( affineScalar, local(), data.getMatrix( i + 1 ) );
+        same &= local.isAffine2D() && std::equal( full, full + 16, affine );
+        scalarSame &= (std::memcmp( affine, affineScalar, sizeof(affine) ) == 0);
+    }
+    result &= Verify( "MultiplyAffine2D", same );
+    result &= Verify( "MultiplyAffine2D scalar", scalarSame );
+
+    // CMatrix::rotate merges a z only rotation without the full multiply
+    same = true;
+    for( int i = 0; i < MATRIX_COUNT; ++i )
+    {
+        const float * pValue = data.getMatrix( i );
+
+        float sinZ, cosZ;
+        NMatrixFunc::SinCosScalar( &sinZ, &cosZ, &pValue[6], 1 );
+
+        float rotation[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+        rotation[0] = cosZ;  rotation[1] = sinZ;
+        rotation[4] = -sinZ; rotation[5] = cosZ;
+
+        float full[16];
+        NMatrixFunc::MultiplyScalar( full, pValue, rotation );
+
+        CMatrix matrix( const_cast<float *>(pValue) );
+        matrix.rotate( CPoint<float>( 0.f, 0.f, pValue[6] ) );
+        same &= std::equal( full, full + 16, matrix() );
+    }
+    result &= Verify( "CMatrix::rotate( z )", same );
+
+    // Counts that are not a multiple of the SIMD width, from well past a full turn
+    same = true;
+    float maxSinCosError = 0;
+    for( int count = 0; count <= 19; ++count )
+    {
+        std::vector<float> angle( count ), simdSin( count ), simdCos( count ), scalarSin( count ), scalarCos( count );
+        for( int i = 0; i < count; ++i )
+            angle[i] = data.matrixVec[(count * 19) + i] * 10.f;
+
+        NMatrixFunc::SinCos( simdSin.data(), simdCos.data(), angle.data(), count );
+        NMatrixFunc::SinCosScalar( scalarSin.data(), scalarCos.data(), angle.data(), count );
+        same &= (std::memcmp( simdSin.data(), scalarSin.data(), sizeof(float) * count ) == 0) &&
+                (std::memcmp( simdCos.data(), scalarCos.data(), sizeof(float) * count ) == 0);
+
+        for( int i = 0; i < count; ++i )
+        {
+            maxSinCosError = std::max( maxSinCosError, (float)std::fabs( scalarSin[i] - std::sin( (double)angle[i] ) ) );
+            maxSinCosError = std::max( maxSinCosError, (float)std::fabs( scalarCos[i] - std::cos( (double)angle[i] ) ) );
+        }
+    }
+    result &= Verify( "SinCos", same );
+    result &= Verify( "SinCos error", maxSinCosError < 1e-6f );
+
+    same = true;
+    for( int i = 0; i < POINT_COUNT; ++i )
+    {
+        CPoint<float> simd, scalar;
+        NMatrixFunc::TransformPoint( simd, data.pointVec[i], data.getMatrix( i ) );
+        NMatrixFunc::TransformPointScalar( scalar, data.pointVec[i], data.getMatrix( i ) );
+        same &= (std::memcmp( &simd, &scalar, sizeof(simd) ) == 0);
+    }
+    result &= Verify( "TransformPoint", same );
+
+    // Counts that are not a multiple of the SIMD width
+    same = true;
+    for( int count = 0; count <= 19; ++count )
+    {
+        std::vector< CPoint<float> > simd( count ), scalar( count );
+        NMatrixFunc::TransformPoints( simd.data(), data.pointVec.data(), count, data.getMatrix( count ) );
+        NMatrixFunc::TransformPointsScalar( scalar.data(), data.pointVec.data(), count, data.getMatrix( count ) );
+        same &= (std::memcmp( simd.data(), scalar.data(), sizeof(CPoint<float>) * count ) == 0);
+    }
+    result &= Verify( "TransformPoints", same );
+
+    // CMatrix quad transform uses the batched path
+    same = true;
+    CMatrix matrix;
+    matrix.rotate( CPoint<float>( 0.3f, 1.1f, 2.7f ) );
+    matrix.translate( CPoint<float>( 5.f, -3.f, 1.f ) );
+    CQuad quad, quadDest;
+    for( int i = 0; i < 4; ++i )
+        quad.point[i] = data.pointVec[i];
+    matrix.transform( quadDest, quad );
+    for( int i = 0; i < 4; ++i )
     {
-       Matrix[i][0] = TempMatrix[i][0];
-       Matrix[i][1] = TempMatrix[i][1];
-       Matrix[i][2] = TempMatrix[i][2];
-       Matrix[i][3] = TempMatrix[i][3];
+        CPoint<float> scalar;
+        NMatrixFunc::TransformPointScalar( scalar, quad.point[i], matrix() );
+        same &= (std::memcmp( &quadDest.point[i], &scalar, sizeof(scalar) ) == 0);
     }
+    result &= Verify( "CMatrix::transform( CQuad )", same );
+
+    same = true;
+    float maxError = 0;
+    for( int i = 0; i < MATRIX_COUNT; ++i )
+    {
+        float simd[16], scalar[16];
+        const bool simdResult = NMatrixFunc::Invert( simd, data.getMatrix( i ) );
+        const bool scalarResult = NMatrixFunc::InvertScalar( scalar, data.getMatrix( i ) );
+        same &= (simdResult == scalarResult) && (std::memcmp( simd, scalar, sizeof(simd) ) == 0);
+
+        // The inverse times the matrix should be close to identity
+        float identity[16];
+        NMatrixFunc::MultiplyScalar( identity, data.getMatrix( i ), scalar );
+        for( int j = 0; j < 16; ++j )
+            maxError = std::max( maxError, std::fabs( identity[j] - (((j % 5) == 0) ? 1.f : 0.f) ) );
+    }
+    result &= Verify( "Invert", same );
+    result &= Verify( "Invert * matrix = identity", maxError < 1e-3f );
+
+    float singular[16] = { 1,2,3,4, 2,4,6,8, 0,1,0,0, 0,0,1,0 };
+    float dummy[16];
+    result &= Verify( "Invert singular", !NMatrixFunc::Invert( dummy, singular ) && !NMatrixFunc::InvertScalar( dummy, singular ) );
+
+    return result;
 }
 
+// Check the in place update lays out the same quads as a full build
+bool VerifyFontLayout()
+{
+    CFontTestData & data = GetFontTestData();
+    CFontData updateData;
+    CFontData buildData;
+    updateData.m_fontProp.copy( data.fontData.m_fontProp );
+    buildData.m_fontProp.copy( data.fontData.m_fontProp );
+    bool result = true;
 
-// Fibonacci Series
-int main()
+    NFontLayout::Build( data.font, data.counterVec[0], updateData );
+    NFontLayout::Build( data.font, data.counterVec[0], buildData );
+    const CQuad2D * pQuad = buildData.m_quadVec.data();
+
+    bool same = true;
+    bool updated = true;
+    for( int i = 1; i < COUNTER_COUNT; ++i )
+    {
+        size_t firstQuad, quadCount;
+        updated &= NFontLayout::Update( data.font, data.counterVec[i], updateData, firstQuad, quadCount );
+        NFontLayout::Build( data.font, data.counterVec[i], buildData );
+
+        same &= (updateData.m_quadVec.size() == buildData.m_quadVec.size()) &&
+                (std::memcmp( updateData.m_quadVec.data(), buildData.m_quadVec.data(), sizeof(CQuad2D) * buildData.m_quadVec.size() ) == 0) &&
+                (updateData.m_fontStrSize.w == buildData.m_fontStrSize.w);
+    }
+
+    size_t firstQuad, quadCount;
+    result &= Verify( "NFontLayout::Update", updated && same );
+    result &= Verify( "NFontLayout::Update new length", !NFontLayout::Update( data.font, "Score: 1", updateData, firstQuad, quadCount ) );
+    result &= Verify( "NFontLayout::Build no allocation", buildData.m_quadVec.data() == pQuad );
+
+    return result;
+}
+
+// Check the packed rects are on the page and don't overlap or touch the padding
+bool VerifyAtlasPacker()
 {
-    std::cout << "Test started..." << std::endl;
-    
-    CHighResTimer::Instance().timerStart();
-    
-    for( int i = 0; i < 30000000; ++i )
-        MultiMatrix3();
-    
-    std::cout << "Execution time: " << CHighResTimer::Instance().timerStop() << std::endl;
-    
+    auto & sizeVec = GetAtlasTestData();
+    const int PADDING = 2;
+    bool result = true;
+
+    CAtlasPacker packer( ATLAS_PAGE_SIZE, PADDING );
+    for( auto & iter : sizeVec )
+        packer.add( iter );
+
+    packer.pack();
+
+    bool placed = true;
+    bool overlap = false;
+    bool uvSame = true;
+    size_t area = 0;
+
+    for( size_t i = 0; i < packer.getCount(); ++i )
+    {
+        const CRect<int> & a = packer.getRect( i );
+
+        placed &= (packer.getPage( i ) >= 0) && (a.x1 >= 0) && (a.y1 >= 0) &&
+                  (a.x1 + a.x2 <= ATLAS_PAGE_SIZE.w) && (a.y1 + a.y2 <= ATLAS_PAGE_SIZE.h) &&
+                  (a.x2 == sizeVec[i].w) && (a.y2 == sizeVec[i].h);
+
+        for( size_t j = i + 1; j < packer.getCount(); ++j )
+        {
+            const CRect<int> & b = packer.getRect( j );
+
+            if( (packer.getPage( i ) == packer.getPage( j )) &&
+                (a.x1 < b.x1 + b.x2 + PADDING) && (b.x1 < a.x1 + a.x2 + PADDING) &&
+                (a.y1 < b.y1 + b.y2 + PADDING) && (b.y1 < a.y1 + a.y2 + PADDING) )
+                overlap = true;
+        }
+
+        const CRect<float> uv = packer.getGlyph( i ).getUV();
+        uvSame &= (uv.x1 * ATLAS_PAGE_SIZE.w == a.x1) && (uv.y1 * ATLAS_PAGE_SIZE.h == a.y1) &&
+                  (uv.x2 * ATLAS_PAGE_SIZE.w == a.x2) && (uv.y2 * ATLAS_PAGE_SIZE.h == a.y2);
+
+        area += a.x2 * a.y2;
+    }
+
+    std::cout << "      " << packer.getPageCount() << " pages, "
+              << std::setprecision(1) << std::fixed
+              << ((100.0 * area) / (packer.getPageCount() * ATLAS_PAGE_SIZE.w * ATLAS_PAGE_SIZE.h)) << "% used" << std::endl;
+
+    result &= Verify( "CAtlasPacker placed", placed );
+    result &= Verify( "CAtlasPacker no overlap", !overlap );
+    result &= Verify( "CAtlasPacker glyph UV", uvSame );
+
+    // A few rects fit on one small page. All of them spill onto
+    // more pages of the largest size
+    CAtlasPacker fewPacker( ATLAS_PAGE_SIZE, PADDING );
+    for( size_t i = 0; i < 8; ++i )
+        fewPacker.add( sizeVec[i] );
+
+    fewPacker.packToFit( 64 );
+
+    const CSize<int> & fewSize = fewPacker.getPageSize();
+    bool fewFits = (fewPacker.getPageCount() == 1) && (fewSize.w * fewSize.h < ATLAS_PAGE_SIZE.w * ATLAS_PAGE_SIZE.h);
+
+    for( size_t i = 0; i < fewPacker.getCount(); ++i )
+    {
+        const CRect<int> & a = fewPacker.getRect( i );
+        fewFits &= (a.x1 + a.x2 <= fewSize.w) && (a.y1 + a.y2 <= fewSize.h);
+    }
+
+    CAtlasPacker allPacker( ATLAS_PAGE_SIZE, PADDING );
+    for( auto & iter : sizeVec )
+        allPacker.add( iter );
+
+    allPacker.packToFit( 64 );
+
+    result &= Verify( "CAtlasPacker fit one page", fewFits );
+    result &= Verify( "CAtlasPacker fit many pages",
+        (allPacker.getPageCount() == packer.getPageCount()) &&
+        (allPacker.getPageSize().w == ATLAS_PAGE_SIZE.w) && (allPacker.getPageSize().h == ATLAS_PAGE_SIZE.h) );
+
+    return result;
+}
+
+// Check the fixed step runs the same steps for any frame times and
+// that an object moved in the last step is rendered between steps
+bool VerifyFixedStep()
+{
+    const float TICK_RATE = 60.f;
+    const int MAX_STEPS = 5;
+    bool result = true;
+
+    // Step a falling body from the frame times. Returns the step count
+    auto run = [TICK_RATE]( const std::vector<double> & frameTimeVec, double & pos, double & vel )
+    {
+        int stepCount = 0;
+        pos = 0;
+        vel = 0;
+
+        CFixedStep::Instance().setTickRate( TICK_RATE, MAX_STEPS );
+
+        for( auto frameTime : frameTimeVec )
+        {
+            const int steps = CFixedStep::Instance().addFrameTime( frameTime );
+
+            for( int i = 0; i < steps; ++i )
+            {
+                CFixedStep::Instance().beginStep();
+
+                const double sec = CFixedStep::Instance().getStepTime() / 1000.0;
+                vel -= 9.8 * sec;
+                pos += vel * sec;
+            }
+
+            stepCount += steps;
+        }
+
+        return stepCount;
+    };
+
+    // Two frame rates covering the same time without hitting the cap
+    std::mt19937 gen( 12345 );
+    std::uniform_real_distribution<double> dist( 1.0, 40.0 );
+    std::vector<double> slowVec, fastVec;
+    double total = 0;
+
+    for( int i = 0; i < 200; ++i )
+    {
+        slowVec.push_back( dist( gen ) );
+        total += slowVec.back();
+    }
+
+    for( int i = 0; i < 2000; ++i )
+        fastVec.push_back( total / 2000 );
+
+    double slowPos, slowVel, fastPos, fastVel;
+    const int slowSteps = run( slowVec, slowPos, slowVel );
+    const int fastSteps = run( fastVec, fastPos, fastVel );
+
+    result &= Verify( "CFixedStep same steps", (slowSteps == fastSteps) && (slowPos == fastPos) && (slowVel == fastVel) );
+
+    // A long frame only runs the max steps and the alpha stays in range
+    CFixedStep::Instance().setTickRate( TICK_RATE, MAX_STEPS );
+    const int capSteps = CFixedStep::Instance().addFrameTime( 1000.0 + 8.0 );
+    const float capAlpha = CFixedStep::Instance().getAlpha();
+    const int nextSteps = CFixedStep::Instance().addFrameTime( 0.0 );
+
+    result &= Verify( "CFixedStep catch up cap", (capSteps == MAX_STEPS) && (nextSteps == 0) && (capAlpha >= 0.f) && (capAlpha < 1.f) );
+
+    // Move an object over two steps and render half way into the next
+    CObject2D object;
+    CFixedStep::Instance().setTickRate( TICK_RATE, MAX_STEPS );
+
+    CFixedStep::Instance().addFrameTime( CFixedStep::Instance().getStepTime() );
+    CFixedStep::Instance().beginStep();
+    object.setPos( 10, 0 );
+    object.setRot( 0, 0, 350 );
+
+    CFixedStep::Instance().addFrameTime( CFixedStep::Instance().getStepTime() * 1.5 );
+    CFixedStep::Instance().beginStep();
+    object.setPos( 20, 0 );
+    object.setRot( 0, 0, 10 );
+    object.transform();
+
+    // Half way between 350 and 10 degrees the shortest way is 0 degrees
+    const CMatrix & matrix = object.getMatrix();
+    const bool halfWay = (std::fabs( matrix[m30] - 15.f ) < 1e-4f) && (std::fabs( matrix[m00] - 1.f ) < 1e-4f);
+
+    // The next step without a change ends the object on the last step
+    CFixedStep::Instance().addFrameTime( CFixedStep::Instance().getStepTime() );
+    CFixedStep::Instance().beginStep();
+    object.transform();
+    const bool lastStep = (std::fabs( object.getMatrix()[m30] - 20.f ) < 1e-4f);
+
+    result &= Verify( "CFixedStep interpolation", halfWay && lastStep );
+
+    CFixedStep::Instance().setTickRate( 0, 1 );
+
+    return result;
+}
+
+// Check the null render device tracks the handles and counts a frame
+bool VerifyNullRenderDevice()
+{
+    CNullRenderDevice device;
+    bool result = true;
+
+    const uint32_t vertexShader = device.createShader( GL_VERTEX_SHADER );
+    const uint32_t program = device.createProgram();
+    device.attachShader( program, vertexShader );
+    device.linkProgram( program );
+    const bool linked = (device.getProgram( program, GL_LINK_STATUS ) == GL_TRUE);
+    const int32_t matrixLocation = device.getUniformLocation( program, "cameraViewProjMatrix" );
+    const bool sameLocation = (device.getUniformLocation( program, "cameraViewProjMatrix" ) == matrixLocation);
+
+    const uint16_t indices[6] = { 0, 1, 2, 2, 3, 0 };
+    const float verts[12] = {};
+    const unsigned char pixels[4*4*4] = {};
+
+    const uint32_t vbo = device.genBuffer();
+    const uint32_t ibo = device.genBuffer();
+    const uint32_t texture = device.createTexture( pixels, 4, 4, 4, false );
+
+    device.bindBuffer( GL_ARRAY_BUFFER, vbo );
+    device.bufferData( GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW );
+    device.bindBuffer( GL_ELEMENT_ARRAY_BUFFER, ibo );
+    device.bufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW );
+    device.present();
+
+    // Draw the quad twice with the same bindings
+    device.enable( GL_BLEND );
+    device.useProgram( program );
+    device.bindTexture( GL_TEXTURE_2D, texture );
+    device.bindTexture( GL_TEXTURE_2D, texture );
+    device.vertexAttribPointer( 0, 3, GL_FLOAT, false, 12, 0 );
+    device.uniformMatrix4fv( matrixLocation, 1, false, CMatrix()() );
+    device.drawElements( GL_TRIANGLES, 6, GL_UNSIGNED_SHORT );
+    device.drawElements( GL_TRIANGLES, 6, GL_UNSIGNED_SHORT );
+    device.present();
+
+    // The texture was still bound from being created
+    const CRenderStats & stats = device.getFrameStats();
+    result &= Verify( "CNullRenderDevice program", linked && sameLocation );
+    result &= Verify( "CNullRenderDevice frame counts",
+        (stats.m_drawCalls == 2) && (stats.m_indices == 12) && (stats.m_stateChanges == 2) &&
+        (stats.m_textureBinds == 2) && (stats.m_redundantBinds == 2) && (stats.m_uniforms == 1) );
+    result &= Verify( "CNullRenderDevice total counts",
+        (device.getTotalStats().m_frames == 2) && (device.getTotalStats().m_bufferUploadBytes == sizeof(verts) + sizeof(indices)) );
+
+    // Drawing past the index buffer or with a deleted buffer is an error
+    auto throws = []( std::function<void()> func )
+    {
+        try { func(); }
+        catch( NExcept::CCriticalException & ) { return true; }
+        return false;
+    };
+
+    result &= Verify( "CNullRenderDevice draw out of range",
+        throws( [&device](){ device.drawElements( GL_TRIANGLES, 12, GL_UNSIGNED_SHORT ); } ) );
+
+    device.deleteBuffer( vbo );
+    result &= Verify( "CNullRenderDevice deleted buffer",
+        throws( [&device, vbo](){ device.bindBuffer( GL_ARRAY_BUFFER, vbo ); } ) && (device.getBufferCount() == 1) );
+
+    return result;
+}
+
+bool VerifyScriptFuncTable()
+{
+    bool result = true;
+
+    const XMLNode node = XMLNode::parseString(
+        "<sprite><scriptLst>"
+        "<init init=\"Sprite_Init\"/><update update=\"Sprite_Update\"/><fadeIn fadeIn=\"Ball_FadeIn\"/>"
+        "<update update=\"Sprite_Update2\"/><stop stop=\"\"/>"
+        "</scriptLst></sprite>", "sprite" );
+
+    CScriptFuncTable dataTable;
+    dataTable.loadFromNode( node );
+
+    const uint fadeInId = CScriptFuncTable::GetId( "fadeIn" );
+    result &= Verify( "CScriptFuncTable ids",
+        (CScriptFuncTable::GetId( "update" ) == CScriptFuncTable::EFI_UPDATE) &&
+        (fadeInId >= CScriptFuncTable::EFI_COUNT) && (CScriptFuncTable::GetId( "fadeIn" ) == fadeInId) );
+    result &= Verify( "CScriptFuncTable load",
+        dataTable.has( CScriptFuncTable::EFI_INIT ) && dataTable.has( CScriptFuncTable::EFI_UPDATE ) &&
+        dataTable.has( fadeInId ) && !dataTable.has( CScriptFuncTable::EFI_STOP ) );
+
+    // Sprites share the table of their data. Adding to one doesn't change the other
+    CScriptFuncTable spriteTable;
+    spriteTable.add( dataTable );
+    spriteTable.add( "clear", "Meter_Clear" );
+    result &= Verify( "CScriptFuncTable copy on write",
+        spriteTable.has( CScriptFuncTable::EFI_INIT ) && spriteTable.has( CScriptFuncTable::EFI_CLEAR ) &&
+        !dataTable.has( CScriptFuncTable::EFI_CLEAR ) && CScriptFuncTable().empty() );
+
+    return result;
+}
+
+// The values the parallel test scripts record and the thread they were applied on
+std::vector< std::pair<int, std::thread::id> > g_recordVec;
+
+void RecordValue( int value )
+{
+    CScriptMgr::Instance().runOnMainThread(
+        [value](){ g_recordVec.emplace_back( value, std::this_thread::get_id() ); } );
+}
+
+void RecordNow( int value )
+{
+    CScriptMgr::Instance().mainThreadOnly( "RecordNow" );
+    g_recordVec.emplace_back( value, std::this_thread::get_id() );
+}
+
+bool VerifyParallelScripts()
+{
+    bool result = true;
+
+    const char * listTableFile = "parallelTest.lst";
+    const char * scriptFile = "parallelTest.as";
+
+    {
+        std::ofstream listTable( listTableFile );
+        listTable << "<listTable><groupList groupName=\"(parallelTest)\" parallel=\"true\">"
+                  << "<file path=\"" << scriptFile << "\"/></groupList></listTable>";
+
+        std::ofstream script( scriptFile );
+        script << "void Run( int id ) { for( int i = 0; i < 3; ++i ) { Record( (id * 10) + i ); } }\n"
+               << "void RunNow( int id ) { RecordNow( id ); }\n";
+    }
+
+    CScriptMgr & rScriptMgr = CScriptMgr::Instance();
+    asIScriptEngine * pEngine = rScriptMgr.getEnginePtr();
+    pEngine->RegisterGlobalFunction( "void Record(int)", asFUNCTION(RecordValue), asCALL_CDECL );
+    pEngine->RegisterGlobalFunction( "void RecordNow(int)", asFUNCTION(RecordNow), asCALL_CDECL );
+
+    rScriptMgr.loadListTable( listTableFile );
+    rScriptMgr.loadGroup( "(parallelTest)" );
+
+    std::remove( listTableFile );
+    std::remove( scriptFile );
+
+    // One context vector per sprite, split between the workers
+    const int SPRITE_COUNT = 64;
+    std::vector< std::vector<asIScriptContext *> > contextVecVec( SPRITE_COUNT );
+    for( int i = 0; i < SPRITE_COUNT; ++i )
+        rScriptMgr.prepare( "(parallelTest)", "Run", contextVecVec[i], {i} );
+
+    CThreadPool::Instance().parallel_for( 0, SPRITE_COUNT, 4,
+        [&contextVecVec]( size_t first, size_t last )
+        {
+            for( size_t i = first; i < last; ++i )
+            {
+                CScriptMgr::Instance().setParallelOrder( i );
+                CScriptMgr::Instance().parallelUpdate( contextVecVec[i] );
+            }
+        } );
+
+    // Nothing is applied until the sync point
+    result &= Verify( "Parallel scripts deferred", g_recordVec.empty() );
+
+    rScriptMgr.applyCommands();
+
+    bool inOrder = (g_recordVec.size() == (SPRITE_COUNT * 3));
+    for( size_t i = 0; inOrder && (i < g_recordVec.size()); ++i )
+        inOrder = (g_recordVec[i].first == (int)(((i / 3) * 10) + (i % 3))) &&
+                  (g_recordVec[i].second == std::this_thread::get_id());
+
+    result &= Verify( "Parallel scripts applied in order on the main thread", inOrder );
+
+    // The finished contexts are recycled by the serial update
+    for( auto & iter : contextVecVec )
+        rScriptMgr.update( iter );
+
+    result &= Verify( "Parallel scripts finished",
+        std::all_of( contextVecVec.begin(), contextVecVec.end(),
+            []( const std::vector<asIScriptContext *> & contextVec ){ return contextVec.empty(); } ) );
+
+    // A call that has to return right away can't be made from a parallel script
+    g_recordVec.clear();
+    std::vector<asIScriptContext *> contextVec;
+    rScriptMgr.prepare( "(parallelTest)", "RunNow", contextVec, {1} );
+
+    bool threw = false;
+    try { rScriptMgr.parallelUpdate( contextVec ); }
+    catch( NExcept::CCriticalException & ) { threw = true; }
+
+    rScriptMgr.applyCommands();
+    rScriptMgr.update( contextVec );
+
+    result &= Verify( "Parallel scripts main thread only call", threw && g_recordVec.empty() && contextVec.empty() );
+
+    return result;
+}
+
+// Records the order of the batch commands and passes them on to the sprite batch manager
+class CRecordCmdStream : public iRenderCmdStream
+{
+public:
+
+    void upload( const CBatchVertex2D * pVert, size_t vertCount ) override
+    { m_cmds += "U"; CSpriteBatchMgr::Instance().upload( pVert, vertCount ); }
+
+    void bindShader( CShaderData * pShaderData ) override
+    { m_cmds += " S" + std::to_string( pShaderData->getProgramID() ); CSpriteBatchMgr::Instance().bindShader( pShaderData ); }
+
+    void bindTexture( uint32_t textureID ) override
+    { m_cmds += " T" + std::to_string( textureID ); CSpriteBatchMgr::Instance().bindTexture( textureID ); }
+
+    void setMatrix( const CMatrix & matrix ) override
+    { m_cmds += " M"; CSpriteBatchMgr::Instance().setMatrix( matrix ); }
+
+    void drawQuads( uint32_t first, uint32_t count ) override
+    { m_cmds += " D" + std::to_string( first ) + "," + std::to_string( count ); CSpriteBatchMgr::Instance().drawQuads( first, count ); }
+
+    std::string m_cmds;
+};
+
+bool VerifySpriteBatch()
+{
+    bool result = true;
+
+    // Render through the headless device
+    CRenderDevice::Create( NDefs::ERD_NULL, nullptr );
+    iRenderDevice & device = CRenderDevice::Instance();
+
+    CShaderData shaderA, shaderB;
+    for( auto pShader : { &shaderA, &shaderB } )
+    {
+        pShader->setProgramID( device.createProgram() );
+        pShader->setAttributeLocation( "in_position", 0 );
+        pShader->setAttributeLocation( "in_uv", 1 );
+        pShader->setAttributeLocation( "in_color", 2 );
+        pShader->setUniformLocation( "text0", 0 );
+        pShader->setUniformLocation( "cameraViewProjMatrix", 1 );
+    }
+
+    const unsigned char pixel[4] = { 255, 255, 255, 255 };
+    const uint32_t texture1 = device.createTexture( pixel, 1, 1, 4, false );
+    const uint32_t texture2 = device.createTexture( pixel, 1, 1, 4, false );
+
+    CVertex2D v0, v1, v2, v3;
+    v0.vert = CPoint<float>( -1, -1, 0 );
+    v1.vert = CPoint<float>( 1, -1, 0 );
+    v2.vert = CPoint<float>( 1, 1, 0 );
+    v3.vert = CPoint<float>( -1, 1, 0 );
+
+    CMatrix matrix;
+    CColor color;
+
+    // The scene in submission order: 3 quads of A/1, 1 of A/2, 2 of B/2 and 1 of A/1
+    struct CQuad { CShaderData * m_pShader; uint32_t m_texture; };
+    const CQuad scene[] = {
+        {&shaderA, texture1}, {&shaderA, texture1}, {&shaderA, texture1},
+        {&shaderA, texture2},
+        {&shaderB, texture2}, {&shaderB, texture2},
+        {&shaderA, texture1} };
+
+    CSpriteBatch2D batch;
+    for( auto & iter : scene )
+    {
+        batch.setState( iter.m_pShader, iter.m_texture, matrix );
+        batch.addQuad( v0, v1, v2, v3, matrix, color );
+    }
+
+    result &= Verify( "CSpriteBatch2D batch counts", (batch.getQuadCount() == 7) && (batch.getDrawCount() == 4) );
+
+    CRecordCmdStream stream;
+    batch.flush( stream );
+    device.present();
+
+    // A new shader binds its texture and matrix again. The texture manager skips the texture already bound
+    const std::string a = std::to_string( shaderA.getProgramID() );
+    const std::string b = std::to_string( shaderB.getProgramID() );
+    const std::string t1 = std::to_string( texture1 );
+    const std::string t2 = std::to_string( texture2 );
+    const std::string expected =
+        "U S" + a + " T" + t1 + " M D0,3 T" + t2 + " D3,1 S" + b + " T" + t2 + " M D4,2 S" + a + " T" + t1 + " M D6,1";
+
+    const CRenderStats & stats = device.getFrameStats();
+    result &= Verify( "CSpriteBatch2D command order", stream.m_cmds == expected );
+    result &= Verify( "CSpriteBatch2D device counts",
+        (stats.m_drawCalls == 4) && (stats.m_indices == 7 * 6) &&
+        (stats.m_programBinds == 3) && (stats.m_textureBinds == 3) && batch.isEmpty() );
+
+    return result;
+}
+
+// Check the batched pass of the transform store makes the same matrices
+// as the objects made one at a time
+bool VerifyTransformStore()
+{
+    const int OBJECT_COUNT = 1000;
+    const size_t startCount = CTransformStore::Instance().getCount();
+    bool result = true;
+
+    std::mt19937 gen( 12345 );
+    std::uniform_real_distribution<float> dist( -100.f, 100.f );
+    std::uniform_int_distribution<int> flagDist( 0, 31 );
+
+    // Each batched object has a twin that isn't batched
+    std::vector< std::unique_ptr<CObject2D> > batchVec, objectVec;
+
+    for( int i = 0; i < OBJECT_COUNT; ++i )
+    {
+        batchVec.emplace_back( new CObject2D );
+        objectVec.emplace_back( new CObject2D );
+        batchVec.back()->setBatchTransform();
+    }
+
+    // Give both twins the same random change. Some turn about x so the object makes the matrix
+    auto change = [&]()
+    {
+        for( int i = 0; i < OBJECT_COUNT; ++i )
+        {
+            const int flags = flagDist( gen );
+            const CPoint<float> value( dist( gen ), dist( gen ), dist( gen ) );
+
+            for( auto pObject : { batchVec[i].get(), objectVec[i].get() } )
+            {
+                if( flags & 1 )
+                    pObject->setPos( value );
+
+                if( flags & 2 )
+                    pObject->setRot( (flags == 31) ? value.x : 0.f, 0.f, value.z );
+
+                if( flags & 4 )
+                    pObject->setScale( value.x / 50.f, value.y / 50.f, 1.f );
+
+                if( flags & 8 )
+                    pObject->setCenterPos( value.y, value.x );
+
+                if( flags & 16 )
+                    pObject->setCropOffset( CSize<int16_t>( (int16_t)value.z, (int16_t)value.x ) );
+            }
+        }
+    };
+
+    // Batch, transform both twins and compare
+    auto same = [&]( const CMatrix * pParent )
+    {
+        CTransformStore::Instance().transform2D();
+
+        bool match = true;
+
+        for( int i = 0; i < OBJECT_COUNT; ++i )
+        {
+            CObject2D & a = *batchVec[i];
+            CObject2D & b = *objectVec[i];
+
+            if( pParent == nullptr )
+            {
+                a.transform();
+                b.transform();
+            }
+            else
+            {
+                a.transform( *pParent );
+                b.transform( *pParent );
+            }
+
+            for( uint j = 0; j < mMax; ++j )
+                match &= (a.getMatrix()[j] == b.getMatrix()[j]);
+
+            match &= (a.getTransPos() == b.getTransPos()) && (a.wasWorldPosTranformed() == b.wasWorldPosTranformed());
+        }
+
+        return match;
+    };
+
+    change();
+    const bool changed = same( nullptr );
+    const bool unchanged = same( nullptr );
+    result &= Verify( "CTransformStore batched matrices", changed && unchanged );
+
+    CMatrix parent;
+    Make2DMatrix( parent, 7 );
+    change();
+    result &= Verify( "CTransformStore batched parent", same( &parent ) );
+
+    // Render between two steps, then end on the last step
+    CFixedStep::Instance().setTickRate( 60.f, 5 );
+    CFixedStep::Instance().addFrameTime( CFixedStep::Instance().getStepTime() );
+    CFixedStep::Instance().beginStep();
+    change();
+
+    CFixedStep::Instance().addFrameTime( CFixedStep::Instance().getStepTime() * 1.5 );
+    CFixedStep::Instance().beginStep();
+    change();
+    const bool between = same( nullptr );
+
+    CFixedStep::Instance().addFrameTime( CFixedStep::Instance().getStepTime() );
+    CFixedStep::Instance().beginStep();
+    const bool lastStep = same( nullptr );
+
+    CFixedStep::Instance().setTickRate( 0, 1 );
+    result &= Verify( "CTransformStore batched interpolation", between && lastStep );
+
+    // The objects free their slots and a copy gets its own
+    const bool inUse = (CTransformStore::Instance().getCount() == startCount + (OBJECT_COUNT * 2));
+    CObject2D copy( *batchVec[0] );
+    copy.incPos( 1, 0 );
+    const bool copied = (batchVec[0]->getPos() != copy.getPos());
+
+    batchVec.clear();
+    objectVec.clear();
+    const bool freed = (CTransformStore::Instance().getCount() == startCount + 1);
+
+    result &= Verify( "CTransformStore slots", inUse && copied && freed );
+
+    return result;
+}
+
+// Check a virtual scroll box binds its recycled controls to the items scrolled into view
+bool VerifyVirtualScrollBox()
+{
+    bool result = true;
+
+    const char * scrollBoxFile = "virtualScrollBox.ctrl";
+    const char * sliderFile = "virtualSlider.ctrl";
+
+    {
+        // 3 items in view, the partial one and a margin of 1 makes a pool of 6 controls
+        std::ofstream scrollBox( scrollBoxFile );
+        scrollBox << "<UIControl><subControlList>"
+                  << "<control controlType=\"slider\" defaultState=\"inactive\"><filePath file=\"" << sliderFile << "\"/>"
+                  << "<settings orientation=\"VERT\"/></control>"
+                  << "</subControlList><scrollBoxControlList>"
+                  << "<controlInfo height=\"50\" visibleInScrollBox=\"3\" virtual=\"true\" margin=\"1\" itemCount=\"4\"/>"
+                  << "<control controlType=\"button\" defaultState=\"inactive\"/>"
+                  << "</scrollBoxControlList></UIControl>";
+
+        std::ofstream slider( sliderFile );
+        slider << "<UIControl><subControlList><control controlType=\"button\" defaultState=\"inactive\"/></subControlList>"
+               << "<settings maxTravelDistPixels=\"100\"/></UIControl>";
+    }
+
+    const std::string xml = std::string( "<control controlType=\"scroll_box\" defaultState=\"inactive\"><filePath file=\"" ) + scrollBoxFile + "\"/></control>";
+    std::unique_ptr<CUIControl> upControl( NUIControlFactory::Create( XMLNode::parseString( xml.c_str(), "control" ), "" ) );
+    CUIScrollBox * pScrollBox = NGenFunc::DynCast<CUIScrollBox>( upControl.get() );
+
+    std::remove( scrollBoxFile );
+    std::remove( sliderFile );
+
+    std::vector< std::pair<CUIControl *, int> > bindVec;
+    pScrollBox->connect_bindItem(
+        [&bindVec]( CUIControl * pCtrl, int index ){ bindVec.emplace_back( pCtrl, index ); } );
+
+    const auto & pScrollCtrlVec = pScrollBox->getScrollCtrlVec();
+
+    // The items bound since the last check must be the ones given, each to its own slot
+    auto bound = [&]( int first, int last )
+    {
+        bool match = (bindVec.size() == static_cast<size_t>(last - first));
+
+        for( int i = first; match && (i < last); ++i )
+            match = (bindVec[i - first].second == i) &&
+                    (bindVec[i - first].first == pScrollCtrlVec[i % pScrollCtrlVec.size()]) &&
+                    (pScrollBox->getBoundItem( bindVec[i - first].first ) == i);
+
+        bindVec.clear();
+
+        return match;
+    };
+
+    // Drag the slider to the position and let the scroll box pick it up
+    auto scrollTo = [&]( float pos )
+    {
+        NGenFunc::DynCast<CUISlider>( pScrollBox->getSubControl() )->setSlider( pos );
+
+        CSelectMsgCracker msgCracker;
+        msgCracker.setDeviceId( NDefs::MOUSE );
+        msgCracker.setPressType( NDefs::EAP_DOWN );
+        msgCracker.setX( 5000 );
+        msgCracker.setY( 5000 );
+        upControl->handleSelectAction( msgCracker );
+    };
+
+    // A new item count binds the items in view and the margin below again
+    pScrollBox->setItemCount( 40 );
+    result &= Verify( "CUIScrollBox virtual item count",
+        (pScrollBox->getItemCount() == 40) && (pScrollCtrlVec.size() == 6) && bound( 0, 5 ) );
+
+    // Jump well past the pool. Items 9 to 14 are in view or in the margin
+    scrollTo( 10 * 50 );
+    result &= Verify( "CUIScrollBox virtual jump", bound( 9, 15 ) );
+
+    // Scrolling by one item only binds the item coming into the margin
+    scrollTo( 11 * 50 );
+    result &= Verify( "CUIScrollBox virtual scroll", bound( 15, 16 ) );
+
+    // The slider caps the scroll at the last items
+    scrollTo( 100 * 50 );
+    result &= Verify( "CUIScrollBox virtual end", bound( 36, 40 ) );
+
+    // Back at the top the recycled controls are bound to the first items again
+    scrollTo( 0 );
+    result &= Verify( "CUIScrollBox virtual top", bound( 0, 5 ) );
+
+    return result;
+}
+
+// Check the low priority group uploads after the others and each
+// group's future is ready once its images are uploaded
+bool VerifyTextureGroupLoad()
+{
+    bool result = true;
+
+    // A 1x1 RGBA png
+    const unsigned char png[] = {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0x15, 0xc4,
+        0x89, 0x00, 0x00, 0x00, 0x0b, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0xf8, 0x0f, 0x04, 0x00,
+        0x09, 0xfb, 0x03, 0xfd, 0xfb, 0x5e, 0x6b, 0x2b, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+        0xae, 0x42, 0x60, 0x82 };
+
+    const std::vector<std::string> fileVec = { "groupLoad0.png", "groupLoad1.png", "groupLoad2.png" };
+    for( auto & iter : fileVec )
+        std::ofstream( iter, std::ios::binary ).write( reinterpret_cast<const char *>(png), sizeof(png) );
+
+    CRenderDevice::Create( NDefs::ERD_NULL, nullptr );
+    CTextureMgr & textureMgr = CTextureMgr::Instance();
+    textureMgr.setRenderThread();
+
+    auto isReady = []( const std::shared_future<void> & future )
+        { return future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready; };
+
+    textureMgr.setLowPriority( "(low)" );
+    textureMgr.loadImageFor2D( "(low)", fileVec[0] );
+    textureMgr.loadImageFor2D( "(normal)", fileVec[1] );
+    textureMgr.loadImageFor2D( "(normal)", fileVec[2] );
+
+    std::shared_future<void> normalFuture = textureMgr.getGroupFuture( "(normal)" );
+    std::shared_future<void> lowFuture = textureMgr.getGroupFuture( "(low)" );
+
+    // Wait for the decodes so the upload order only depends on the priority
+    while( (textureMgr.getGroupProgress( "(low)" ).m_decoded < 1) || (textureMgr.getGroupProgress( "(normal)" ).m_decoded < 2) )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+    // Any budget ends after the first upload
+    int uploads = 0;
+    while( !isReady( normalFuture ) && (uploads < 3) )
+        uploads += textureMgr.uploadDecoded( 1e-6 );
+
+    result &= Verify( "CTextureMgr normal group first",
+        (uploads == 2) && (textureMgr.getGroupProgress( "(normal)" ).m_uploaded == 2) &&
+        (textureMgr.getGroupProgress( "(low)" ).m_uploaded == 0) && !isReady( lowFuture ) );
+
+    textureMgr.uploadDecoded();
+    result &= Verify( "CTextureMgr low group last", isReady( lowFuture ) && isReady( textureMgr.getGroupFuture( "(none)" ) ) );
+
+    // Deleting the groups clears their progress
+    textureMgr.deleteTextureGroupFor2D( "(normal)" );
+    textureMgr.deleteTextureGroupFor2D( "(low)" );
+    result &= Verify( "CTextureMgr group delete", textureMgr.getGroupProgress( "(normal)" ).m_requested == 0 );
+
+    for( auto & iter : fileVec )
+        std::remove( iter.c_str() );
+
+    return result;
+}
+
+int main()
+{
+    std::cout << "Matrix kernels: " << NMatrixFunc::GetSimdName() << std::endl << std::endl;
+
+    if( !VerifyKernels() )
+    {
+        std::cout << std::endl << "SIMD and scalar results don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyFontLayout() )
+    {
+        std::cout << std::endl << "Font layout results don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyAtlasPacker() )
+    {
+        std::cout << std::endl << "Atlas packing failed!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyFixedStep() )
+    {
+        std::cout << std::endl << "Fixed step results don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyNullRenderDevice() )
+    {
+        std::cout << std::endl << "Null render device counts don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyScriptFuncTable() )
+    {
+        std::cout << std::endl << "Script function table results don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyParallelScripts() )
+    {
+        std::cout << std::endl << "Parallel script commands don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifySpriteBatch() )
+    {
+        std::cout << std::endl << "Sprite batch counts don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyTransformStore() )
+    {
+        std::cout << std::endl << "Transform store results don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyVirtualScrollBox() )
+    {
+        std::cout << std::endl << "Virtual scroll box bindings don't match!" << std::endl;
+        return 1;
+    }
+
+    if( !VerifyTextureGroupLoad() )
+    {
+        std::cout << std::endl << "Texture group load order doesn't match!" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::endl;
+
+    RunBenchmarks();
+
+    return 0;
+}
+
+/*#include <iostream>
+#include <vector>
+#include <queue>
+#include <atomic>
+#include <utilities/threadpool.h>
+#include <utilities/highresolutiontimer.h>
+
+// The single queue thread pool the work stealing pool replaced. Kept here to benchmark against
+class CLegacyThreadPool
+{
+public:
+
+    CLegacyThreadPool( int threads )
+    {
+        for( int i = 0; i < threads; ++i )
+        {
+            m_workers.emplace_back(
+                [this] {
+                    for (;;)
+                    {
+                        std::function<void() > task;
+
+                        {
+                            std::unique_lock<std::mutex> lock(this->m_queue_mutex);
+                            this->m_condition.wait(lock,
+                                [this] { return this->m_stop || !this->m_tasks.empty(); });
+
+                            if (this->m_stop && this->m_tasks.empty())
+                                return;
+
+                            task = std::move(this->m_tasks.front());
+                            this->m_tasks.pop();
+                        }
+
+                        task();
+                    }
+                }
+            );
+        }
+    }
+
+    ~CLegacyThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_queue_mutex );
+            m_stop = true;
+        }
+
+        m_condition.notify_all();
+
+        for( std::thread & iter : m_workers )
+            iter.join();
+    }
+
+    template<class F>
+    void post(F&& f)
+    {
+        auto task = std::make_shared < std::packaged_task <void()> >( std::forward<F>(f) );
+
+        m_jobVec.emplace_back( task->get_future() );
+        {
+            std::unique_lock<std::mutex> lock( m_queue_mutex );
+            m_tasks.emplace( [task]{ (*task)(); } );
+        }
+
+        m_condition.notify_one();
+    }
+
+    void wait()
+    {
+        for( auto && iter : m_jobVec ) iter.get();
+        m_jobVec.clear();
+    }
+
+private:
+
+    std::vector< std::thread > m_workers;
+    std::queue< std::function<void()> > m_tasks;
+    std::vector< std::future<void> > m_jobVec;
+    std::mutex m_queue_mutex;
+    std::condition_variable m_condition;
+    bool m_stop = false;
+};
+
+const int JOB_COUNT = 1000000;
+
+int main()
+{
+    std::cout << "Thread pool benchmark started..." << std::endl;
+
+    CThreadPool & threadPool = CThreadPool::Instance();
+    CLegacyThreadPool legacyPool( threadPool.getWorkerCount() );
+
+    std::cout << "Worker threads: " << threadPool.getWorkerCount() << std::endl;
+
+    // Post empty jobs to the legacy pool
+    CHighResTimer::Instance().timerStart();
+
+    for( int i = 0; i < JOB_COUNT; ++i )
+        legacyPool.post( []{} );
+
+    legacyPool.wait();
+
+    std::cout << "Legacy pool, 1M empty jobs: " << CHighResTimer::Instance().timerStop() << " ms" << std::endl;
+
+    // Post empty jobs to the work stealing pool
+    CHighResTimer::Instance().timerStart();
+
+    for( int i = 0; i < JOB_COUNT; ++i )
+        threadPool.post( []{} );
+
+    threadPool.wait();
+
+    std::cout << "Work stealing pool, 1M empty jobs: " << CHighResTimer::Instance().timerStop() << " ms" << std::endl;
+
+    // Same amount of work split with parallel_for
+    std::atomic<int> counter(0);
+
+    CHighResTimer::Instance().timerStart();
+
+    threadPool.parallel_for( 0, JOB_COUNT, 1024,
+        [&counter]( size_t first, size_t last )
+        { counter.fetch_add( last - first, std::memory_order_relaxed ); } );
+
+    std::cout << "Work stealing pool, parallel_for over 1M: " << CHighResTimer::Instance().timerStop() << " ms" << std::endl;
+
+    if( counter != JOB_COUNT )
+        std::cout << "parallel_for missed items: " << (JOB_COUNT - counter) << std::endl;
+
     return 0;
 }*/
 
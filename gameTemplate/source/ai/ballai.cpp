@@ -10,13 +10,14 @@
 
 // Game lib dependencies
 #include <2d/sprite2d.h>
+#include <system/replay.h>
 
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CBallAI::CBallAI( iSprite * pSprite ) :
     m_sprite(*dynamic_cast<CSprite2D *>(pSprite)),
-    m_generator(std::random_device{}())
+    m_generator(CReplay::Instance().getSeed())
 {
 }   // constructor
 
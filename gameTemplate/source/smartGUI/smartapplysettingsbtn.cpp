@@ -23,6 +23,7 @@
 
 // Game lib dependencies
 #include <system/device.h>
+#include <system/renderdevice.h>
 #include <gui/menumanager.h>
 #include <gui/uicheckbox.h>
 #include <gui/uibuttonlist.h>
@@ -144,7 +145,7 @@ void CSmartApplySettingsBtn::execute()
         CMenuMgr::Instance().resetDynamicOffset();
 
         // Need to reset the view port the changing the resolution
-        glViewport(0, 0, CSettings::Instance().getSize().getW(), CSettings::Instance().getSize().getH());
+        CRenderDevice::Instance().viewport(0, 0, CSettings::Instance().getSize().getW(), CSettings::Instance().getSize().getH());
     }
     else if( fullScreenChanged )
     {
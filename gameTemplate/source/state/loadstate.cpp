@@ -23,6 +23,7 @@
 
 // Game lib dependencies
 #include <system/device.h>
+#include <system/renderdevice.h>
 #include <objectdata/objectdatamanager.h>
 #include <managers/shadermanager.h>
 #include <managers/texturemanager.h>
@@ -34,17 +35,24 @@
 #include <utilities/highresolutiontimer.h>
 #include <utilities/settings.h>
 #include <utilities/exceptionhandling.h>
+#include <utilities/threadpool.h>
 #include <common/color.h>
 
 // Standard lib dependencies
 #include <thread>
+#include <chrono>
+
+namespace
+{
+    // Time each animation frame can spend uploading decoded textures
+    const double UPLOAD_BUDGET_MS = 4.0;
+}
 
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CLoadState::CLoadState( const CStateMessage & stateMsg ) :
     iGameState( NGameDefs::EGS_GAME_LOAD, stateMsg ),
-    m_threadActive(true),
     m_time(0),
     m_frame(0)
 {
@@ -78,6 +86,19 @@ void CLoadState::init()
     m_upSprite->setPos( CPoint<float>(scrnHalf.w, -scrnHalf.h) + CPoint<float>(-150, 150) );
     m_upSprite->transform();
 
+    // Allocate the progress bar. It grows from the center as the groups load
+    m_upProgressBar.reset( new CSprite2D( CObjectDataMgr::Instance().getData2D( "(loadingScreen)", "loadBar" ) ) );
+    m_upProgressBar->setPos( CPoint<float>(0, -scrnHalf.h + 40) );
+    m_upProgressBar->setScale( 0, 1, 1 );
+    m_upProgressBar->transform();
+
+    // Get the groups the next state can't start without
+    if( m_stateMessage.getLoadState() == NGameDefs::EGS_TITLE_SCREEN )
+        m_groupVec = NTitleScreenState::LoadGroups();
+
+    else if( m_stateMessage.getLoadState() == NGameDefs::EGS_RUN )
+        m_groupVec = NRunState::LoadGroups();
+
     // Setup the fade in
     CShaderMgr::Instance().setShaderColor( "shader_2d_spriteSheet", "additive", CColor(1,1,1,1) );
 
@@ -99,14 +120,18 @@ void CLoadState::animate()
     if( m_time > 83.f )
     {
         // Clear the screen
-        glClear( GL_COLOR_BUFFER_BIT );
+        CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
 
         m_upSprite->setFrame( m_frame );
         m_frame = (m_frame + 1) % m_upSprite->getFrameCount();
 
         m_upSprite->render( CCameraMgr::Instance().getDefaultProjMatrix() );
 
-        SDL_GL_SwapWindow( CDevice::Instance().getWindow() );
+        m_upProgressBar->setScale( getLoadProgress(), 1, 1 );
+        m_upProgressBar->transform();
+        m_upProgressBar->render( CCameraMgr::Instance().getDefaultProjMatrix() );
+
+        CRenderDevice::Instance().present();
 
         // Unbind everything after a round of rendering
         CShaderMgr::Instance().unbind();
@@ -119,6 +144,30 @@ void CLoadState::animate()
 }
 
 
+/***************************************************************************
+*    DESC:  Get how much of the groups the next state waits on is loaded
+*           Decoding is half the work and uploading is the other half
+****************************************************************************/
+float CLoadState::getLoadProgress() const
+{
+    int requested = 0;
+    int done = 0;
+
+    for( auto & iter : m_groupVec )
+    {
+        const CTextureMgr::CGroupProgress progress = CTextureMgr::Instance().getGroupProgress( iter );
+
+        requested += progress.m_requested;
+        done += progress.m_decoded + progress.m_uploaded;
+    }
+
+    if( requested == 0 )
+        return 0.f;
+
+    return static_cast<float>(done) / (requested * 2);
+}
+
+
 /***************************************************************************
 *    DESC:  Object Data Load
 ****************************************************************************/
@@ -150,9 +199,6 @@ void CLoadState::objectDataLoad()
         m_errorTitle = "Unknown Error";
         m_errorMsg = "Something bad happened and I'm not sure what it was.";
     }
-
-    // Set the flag to indicate the load is complete
-    m_threadActive = false;
 }
 
 
@@ -234,9 +280,35 @@ void CLoadState::assetsLoad()
         m_errorTitle = "Unknown Error";
         m_errorMsg = "Something bad happened and I'm not sure what it was.";
     }
+}
+
+
+/***************************************************************************
+*    DESC:  Animate and upload the decoded textures until the load job
+*           or texture group is done. The images are decoded on the
+*           thread pool
+****************************************************************************/
+void CLoadState::waitForLoad( std::shared_future<void> future )
+{
+    try
+    {
+        do
+        {
+            animate();
+
+            CTextureMgr::Instance().uploadDecoded( UPLOAD_BUDGET_MS );
+        }
+        while( future.wait_for( std::chrono::milliseconds( 5 ) ) != std::future_status::ready );
 
-    // Set the flag to indicate the load is complete
-    m_threadActive = false;
+        // Upload what's left so creating from data doesn't have to wait
+        CTextureMgr::Instance().uploadDecoded();
+    }
+    catch(...)
+    {
+        // Don't leave the job running on a state that's going away
+        future.wait();
+        throw;
+    }
 }
 
 
@@ -247,33 +319,20 @@ bool CLoadState::doStateChange()
 {
     CActionMgr::Instance().resetLastUsedDevice();
 
-    std::thread objLoadThread( &CLoadState::objectDataLoad, this );
-    objLoadThread.detach();
-
-    do
-    {
-        animate();
-        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
-    }
-    while(m_threadActive);
+    waitForLoad( CThreadPool::Instance().postRetFut( &CLoadState::objectDataLoad, this ).share() );
 
     // If there was an error in the load thread, re-throw exception
     if( !m_errorMsg.empty() )
         throw NExcept::CCriticalException(m_errorTitle, m_errorMsg);
 
-    criticalLoad();
+    // Upload the groups the next state needs. Low priority groups finish in that state
+    for( auto & iter : m_groupVec )
+        waitForLoad( CTextureMgr::Instance().getGroupFuture( iter ) );
 
-    // Start the loading/unloading thread
-    m_threadActive = true;
-    std::thread loadThread( &CLoadState::assetsLoad, this );
-    loadThread.detach();
+    criticalLoad();
 
-    do
-    {
-        animate();
-        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
-    }
-    while(m_threadActive);
+    // Start the loading/unloading job
+    waitForLoad( CThreadPool::Instance().postRetFut( &CLoadState::assetsLoad, this ).share() );
 
     // If there was an error in the load thread, re-throw exception
     if( !m_errorMsg.empty() )
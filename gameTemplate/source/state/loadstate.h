@@ -15,6 +15,8 @@
 // Standard lib dependencies
 #include <string>
 #include <memory>
+#include <future>
+#include <vector>
 
 // Forward declaration(s)
 class CSprite2D;
@@ -48,14 +50,21 @@ private:
     void assetsLoad();
     void criticalLoad();
     void criticalInit();
+
+    // Animate and upload textures until the load job is done
+    void waitForLoad( std::shared_future<void> future );
+
+    // Get how much of the groups the next state waits on is loaded
+    float getLoadProgress() const;
     
 private:
     
     // Load animation
     std::unique_ptr<CSprite2D> m_upSprite;
-    
-    // Flag to indicate the thread load is finished
-    bool m_threadActive;
+
+    // Load progress bar and the groups it shows
+    std::unique_ptr<CSprite2D> m_upProgressBar;
+    std::vector<std::string> m_groupVec;
     
     // Animation members
     float m_time;
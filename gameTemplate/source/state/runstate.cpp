@@ -154,6 +154,12 @@ namespace NRunState
             CStrategyMgr::Instance().create( "(sprite)", shapes[i % 6] );
     }
 
+    // Groups the load waits on before the state starts
+    std::vector<std::string> LoadGroups()
+    {
+        return { "(run)" };
+    }
+
 
     /***************************************************************************
     *    DESC:  Namespace function for unloading the assets for this state
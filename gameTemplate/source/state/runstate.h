@@ -14,6 +14,10 @@
 // Game lib dependencies
 #include <2d/sprite2d.h>
 
+// Standard lib dependencies
+#include <string>
+#include <vector>
+
 // Forward declaration(s)
 class CPhysicsWorld2D;
 
@@ -63,6 +67,7 @@ namespace NRunState
     void Load();
     void Unload();
     void CriticalInit();
+    std::vector<std::string> LoadGroups();
 }
 
 
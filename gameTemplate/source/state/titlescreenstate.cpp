@@ -13,6 +13,7 @@
 #include <utilities/highresolutiontimer.h>
 #include <utilities/xmlpreloader.h>
 #include <managers/cameramanager.h>
+#include <managers/texturemanager.h>
 #include <gui/menumanager.h>
 #include <gui/uibutton.h>
 #include <gui/uimeter.h>
@@ -20,14 +21,22 @@
 // SDL lib dependencies
 #include <SDL.h>
 
+// Standard lib dependencies
+#include <chrono>
+
+namespace
+{
+    // Time each frame can spend uploading the cube's textures
+    const double UPLOAD_BUDGET_MS = 4.0;
+}
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CTitleScreenState::CTitleScreenState() :
     CCommonState( NGameDefs::EGS_TITLE_SCREEN, NGameDefs::EGS_GAME_LOAD ),
-        m_background( CObjectDataMgr::Instance().getData2D( "(title_screen)", "background" ) ),
+        m_background( CObjectDataMgr::Instance().getData2D( "(title_screen)", "background" ) )
         //m_spriteSheetTest( CObjectDataMgr::Instance().GetData2D( "(title_screen)", "spriteSheetTest2" ) ),
-        m_cube( CObjectDataMgr::Instance().getData3D( "(cube)", "cube" ) )
 {
 }
 
@@ -41,7 +50,8 @@ void CTitleScreenState::init()
     CMenuMgr::Instance().allow();
     CMenuMgr::Instance().activateTree( "title_screen_tree" );
 
-    m_cube.setScale( 3, 3, 3 );
+    // The load didn't wait on the cube's textures
+    m_cubeLoad = CTextureMgr::Instance().getGroupFuture( "(cube)" );
 
     CCameraMgr::Instance().createPerspective( "cube" );
     CCameraMgr::Instance().setActiveCameraPos( 0, 0, 20 );
@@ -90,8 +100,34 @@ void CTitleScreenState::update()
 
     m_scriptComponent.update();
 
-    float rot = CHighResTimer::Instance().getElapsedTime() * 0.04;
-    m_cube.incRot( rot, rot, 0 );
+    if( m_upCube )
+    {
+        float rot = CHighResTimer::Instance().getElapsedTime() * 0.04;
+        m_upCube->incRot( rot, rot, 0 );
+    }
+    else
+    {
+        createCube();
+    }
+}
+
+
+/***************************************************************************
+*    DESC:  Create the cube once its textures are uploaded
+*           The cube's group is low priority so the load state doesn't
+*           wait on it. Upload a little of it each frame until it's ready
+****************************************************************************/
+void CTitleScreenState::createCube()
+{
+    CTextureMgr::Instance().uploadDecoded( UPLOAD_BUDGET_MS );
+
+    if( m_cubeLoad.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+    {
+        CObjectDataMgr::Instance().createFromData3D( "(cube)" );
+
+        m_upCube.reset( new CSprite3D( CObjectDataMgr::Instance().getData3D( "(cube)", "cube" ) ) );
+        m_upCube->setScale( 3, 3, 3 );
+    }
 }
 
 
@@ -108,7 +144,8 @@ void CTitleScreenState::transform()
 
     //m_spriteSheetTest.Transform();
 
-    m_cube.transform();
+    if( m_upCube )
+        m_upCube->transform();
 }
 
 
@@ -123,9 +160,12 @@ void CTitleScreenState::preRender()
 
     CCommonState::preRender();
 
-    auto & camera = CCameraMgr::Instance().getActiveCamera();
+    if( m_upCube )
+    {
+        auto & camera = CCameraMgr::Instance().getActiveCamera();
 
-    m_cube.render( camera.getFinalMatrix(), camera.getRotMatrix() );
+        m_upCube->render( camera.getFinalMatrix(), camera.getRotMatrix() );
+    }
 }
 
 
@@ -143,6 +183,9 @@ namespace NTitleScreenState
         CObjectDataMgr::Instance().loadGroup2D( "(title_screen)", CObjectDataMgr::DONT_CREATE_FROM_DATA );
 
         //CObjectDataMgr::Instance().LoadGroup2D( "(actor)", CObjectDataMgr::DONT_CREATE_FROM_DATA );
+
+        // The state creates the cube when it's ready so the load doesn't wait on it
+        CTextureMgr::Instance().setLowPriority( "(cube)" );
         CObjectDataMgr::Instance().loadGroup3D( "(cube)", CObjectDataMgr::DONT_CREATE_FROM_DATA );
     }
 
@@ -150,7 +193,6 @@ namespace NTitleScreenState
     {
         // Create the group's VBO, IBO, textures, etc
         CObjectDataMgr::Instance().createFromData2D( "(title_screen)" );
-        CObjectDataMgr::Instance().createFromData3D( "(cube)" );
     }
 
     void Load()
@@ -163,6 +205,12 @@ namespace NTitleScreenState
 
     }
 
+    // Groups the load waits on before the state starts
+    std::vector<std::string> LoadGroups()
+    {
+        return { "(title_screen)" };
+    }
+
 
     /***************************************************************************
     *    DESC:  Namespace function for unloading the assets for this state
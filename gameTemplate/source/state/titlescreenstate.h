@@ -19,6 +19,10 @@
 
 // Standard lib dependencies
 #include <tuple>
+#include <memory>
+#include <future>
+#include <string>
+#include <vector>
 
 // Forward declaration(s)
 class CUIMeter;
@@ -51,6 +55,11 @@ public:
     // 2D/3D Render of game content
     void preRender() override;
     
+private:
+
+    // Create the cube once its textures are uploaded
+    void createCube();
+    
 private:
 
     // The script component
@@ -61,7 +70,9 @@ private:
     
     //CSprite2D m_spriteSheetTest;
     
-    CSprite3D m_cube;
+    // The cube loads in the background after the state starts
+    std::unique_ptr<CSprite3D> m_upCube;
+    std::shared_future<void> m_cubeLoad;
 };
 
 
@@ -79,6 +90,7 @@ namespace NTitleScreenState
     void Load();
     void Unload();
     void CriticalInit();
+    std::vector<std::string> LoadGroups();
 }
 
 
@@ -185,6 +185,31 @@ void CActorSprite2D::update()
 }   // Update
 
 
+/************************************************************************
+*    DESC:  Update the script part of the actor
+************************************************************************/
+void CActorSprite2D::scriptUpdate()
+{
+    for( auto & iter : m_spriteDeq )
+        iter.scriptUpdate();
+
+}   // ScriptUpdate
+
+
+/************************************************************************
+*    DESC:  Update the part of the actor that doesn't use a script context
+************************************************************************/
+void CActorSprite2D::parallelUpdate()
+{
+    if( m_upAI )
+        m_upAI->update();
+
+    for( auto & iter : m_spriteDeq )
+        iter.parallelUpdate();
+
+}   // ParallelUpdate
+
+
 /************************************************************************
 *    DESC:  Update the physics
 ************************************************************************/
@@ -358,13 +383,18 @@ void CActorSprite2D::applyScale( CMatrix & matrix )
 
 
 /************************************************************************
-*    DESC:  Get the collision group
+*    DESC:  Get the collision group and mask
 ************************************************************************/
 uint CActorSprite2D::getCollisionGroup() const
 {
     return m_collisionGroup;
 }
 
+uint CActorSprite2D::getCollisionMask() const
+{
+    return m_collisionMask;
+}
+
 
 /************************************************************************
 *    DESC:  Get the collision radius
@@ -375,6 +405,16 @@ float CActorSprite2D::getCollisionRadius() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the radius around the translated position the actor is drawn in
+*           Same radius the actor is culled with
+************************************************************************/
+float CActorSprite2D::getRadius() const
+{
+    return m_scaledRadius;
+}
+
+
 /***************************************************************************
 *    DESC:  Check for broad phase collision against other actor sprite
 ****************************************************************************/
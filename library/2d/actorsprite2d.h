@@ -56,6 +56,8 @@ public:
 
     // Update the actor
     void update() override;
+    void scriptUpdate() override;
+    void parallelUpdate() override;
     
     // Update the physics
     void physicsUpdate() override;
@@ -80,12 +82,16 @@ public:
     // Get the sprite group
     CSprite2D & getSprite( const std::string & name );
     
-    // Get the collision group
-    uint getCollisionGroup() const;
+    // Get the collision group and mask
+    uint getCollisionGroup() const override;
+    uint getCollisionMask() const override;
     
     // Get the collision radius
     float getCollisionRadius() const;
     
+    // Get the radius around the translated position the actor is drawn in
+    float getRadius() const override;
+    
     // Check for collision against other actor sprite
     bool isCollision( CActorSprite2D & rPlayerActor );
     
@@ -99,6 +105,9 @@ protected:
     
     // Apply the scale
     void applyScale( CMatrix & matrix ) override;
+
+    // The scale sets the radius so the matrix isn't made in the batched pass
+    bool allowBatchTransform() const override { return false; }
     
 private:
     
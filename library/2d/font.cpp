@@ -89,7 +89,7 @@ void CFont::load( const std::string & group )
         char id = std::atoi(charNode.getAttribute( "id" ));
 
         // Add the character to our list
-        m_charDataMap.emplace( id, charData );
+        addCharData( id, charData );
     }
 }
 
@@ -103,20 +103,37 @@ void CFont::createFromData( const std::string & group )
 }
 
 
+/************************************************************************
+*    DESC:  Add the data for this character
+*           The first one added for a character is kept
+************************************************************************/
+void CFont::addCharData( char id, const CCharData & charData )
+{
+    const uint8_t index = static_cast<uint8_t>(id);
+
+    if( !m_charLoadedSet.test( index ) )
+    {
+        m_charDataAry[index] = charData;
+        m_charLoadedSet.set( index );
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Get the data for this character
+*           This is called for every character of every font string
+*           so it's a table lookup instead of a map search
 ************************************************************************/
 const CCharData & CFont::getCharData( char id ) const
 {
-    // See if this character is part of the map
-    auto iter = m_charDataMap.find( id );
+    const uint8_t index = static_cast<uint8_t>(id);
 
-    if( iter == m_charDataMap.end() )
+    if( !m_charLoadedSet.test( index ) )
         throw NExcept::CCriticalException("Font character data Error!",
             boost::str( boost::format("Font character ID can't be found (%s).\n\n%s\nLine: %s")
                 % id % __FUNCTION__ % __LINE__ ));
 
-    return iter->second;
+    return m_charDataAry[index];
 }
 
 
@@ -14,7 +14,8 @@
 
 // Standard lib dependencies
 #include <string>
-#include <map>
+#include <array>
+#include <bitset>
 
 class CCharData
 {
@@ -46,6 +47,9 @@ public:
     // Create the font texture from data
     void createFromData( const std::string & group );
 
+    // Add the data for this character
+    void addCharData( char id, const CCharData & charData );
+
     // Get the data for this character
     const CCharData & getCharData( char id ) const;
 
@@ -72,8 +76,11 @@ private:
     // font file path
     std::string m_filePath;
     
-    // map list of character data
-    std::map<char, CCharData> m_charDataMap;
+    // Character data indexed by the unsigned value of the character
+    std::array<CCharData, 256> m_charDataAry;
+
+    // Flags of the characters that have been added
+    std::bitset<256> m_charLoadedSet;
 
     // Line height
     float m_lineHeight;
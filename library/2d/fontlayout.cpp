@@ -0,0 +1,436 @@
+/************************************************************************
+*    FILE NAME:       fontlayout.cpp
+*
+*    DESCRIPTION:     Lays out the character quads of a font string
+*                     The vectors of the font data are reused so laying
+*                     out a string no longer than the last one doesn't
+*                     allocate. A string that only changes characters of
+*                     the same advance, like a counter, can be updated in
+*                     place by only laying out the changed characters.
+*
+*    NOTE: Line wrap feature only supported for horizontal left
+************************************************************************/
+
+// Physical component dependency
+#include <2d/fontlayout.h>
+
+// Game lib dependencies
+#include <2d/font.h>
+#include <common/fontdata.h>
+#include <common/fontproperties.h>
+
+// Standard lib dependencies
+#include <vector>
+
+namespace NFontLayout
+{
+    namespace
+    {
+        /************************************************************************
+        *    DESC:  Add the line width to the vector based on horz alignment
+        ************************************************************************/
+        void AddLineWithToVec(
+            const CFont & font,
+            std::vector<float> & lineWidthOffsetVec,
+            const NDefs::EHorzAlignment hAlign,
+            float width,
+            float firstCharOffset,
+            float lastCharOffset )
+        {
+            if( hAlign == NDefs::EHA_HORZ_LEFT )
+                lineWidthOffsetVec.push_back(-(firstCharOffset + font.getHorzPadding()));
+
+            else if( hAlign == NDefs::EHA_HORZ_CENTER )
+                lineWidthOffsetVec.push_back(-((width - font.getHorzPadding()) / 2.f));
+
+            else if( hAlign == NDefs::EHA_HORZ_RIGHT )
+                lineWidthOffsetVec.push_back(-(width - lastCharOffset - font.getHorzPadding()));
+
+            // Remove any fractional component of the last index
+            lineWidthOffsetVec.back() = (int)lineWidthOffsetVec.back();
+        }
+
+
+        /************************************************************************
+        *    DESC:  Get the length of the word after the space at index i
+        ************************************************************************/
+        float GetNextWordWidth( const CFont & font, const CFontProperties & fontProp, const std::string & str, size_t i )
+        {
+            float nextWord = 0.f;
+
+            for( size_t j = i+1; j < str.size(); ++j )
+            {
+                const char id = str[j];
+
+                if( id != '|' )
+                {
+                    // See if we can find the character
+                    const CCharData & charData = font.getCharData(id);
+
+                    // Break here when space is found
+                    // Don't add the space to the size of the next word
+                    if( id == ' ' )
+                        break;
+
+                    nextWord += charData.xAdvance + fontProp.m_kerning + font.getHorzPadding();
+                }
+            }
+
+            return nextWord;
+        }
+
+
+        /************************************************************************
+        *    DESC:  Add up all the character widths
+        ************************************************************************/
+        void CalcLineWidthOffset(
+            const CFont & font,
+            const CFontProperties & fontProp,
+            const std::string & str,
+            std::vector<float> & lineWidthOffsetVec )
+        {
+            float firstCharOffset = 0;
+            float lastCharOffset = 0;
+            float spaceWidth = 0;
+            float width = 0;
+            int counter = 0;
+
+            lineWidthOffsetVec.clear();
+
+            for( size_t i = 0; i < str.size(); ++i )
+            {
+                const char id = str[i];
+
+                // Line wrap if '|' character was used
+                if( id == '|' )
+                {
+                    // Add the line width to the vector based on horz alignment
+                    AddLineWithToVec( font, lineWidthOffsetVec, fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
+
+                    counter = 0;
+                    width = 0;
+                }
+                else
+                {
+                    // Get the next character
+                    const CCharData & charData = font.getCharData( id );
+
+                    if(counter == 0)
+                        firstCharOffset = charData.offset.w;
+
+                    spaceWidth = charData.xAdvance + fontProp.m_kerning + font.getHorzPadding();
+
+                    // Add in any additional spacing for the space character
+                    if( id == ' ' )
+                        spaceWidth += fontProp.m_spaceCharKerning;
+
+                    width += spaceWidth;
+
+                    if( id != ' ')
+                        lastCharOffset = charData.offset.w;
+
+                    ++counter;
+                }
+
+                // Wrap to another line
+                if( (id == ' ') && (fontProp.m_lineWrapWidth > 0.f) )
+                {
+                    if( width + GetNextWordWidth( font, fontProp, str, i ) >= fontProp.m_lineWrapWidth )
+                    {
+                        // Add the line width to the vector based on horz alignment
+                        AddLineWithToVec( font, lineWidthOffsetVec, fontProp.m_hAlign, width-spaceWidth, firstCharOffset, lastCharOffset );
+
+                        counter = 0;
+                        width = 0;
+                    }
+                }
+            }
+
+            // Add the line width to the vector based on horz alignment
+            AddLineWithToVec( font, lineWidthOffsetVec, fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
+        }
+
+
+        /************************************************************************
+        *    DESC:  Set the quad of a character at the pen position
+        ************************************************************************/
+        void SetQuad(
+            CQuad2D & quadBuf,
+            const CCharData & charData,
+            const CPoint<float> & pen,
+            float lineHeight,
+            const CSize<float> & textureSize )
+        {
+            const CRect<float> & rect = charData.rect;
+
+            float yOffset = (lineHeight - rect.y2 - charData.offset.h) + pen.y;
+
+            // Check if the width or height is odd. If so, we offset
+            // by 0.5 for proper orthographic rendering
+            float additionalOffsetX = 0;
+            if( (int)rect.x2 % 2 != 0 )
+                additionalOffsetX = 0.5f;
+
+            float additionalOffsetY = 0;
+            if( (int)rect.y2 % 2 != 0 )
+                additionalOffsetY = 0.5f;
+
+            // Calculate the first vertex of the first face
+            quadBuf.vert[0].vert.x = pen.x + charData.offset.w + additionalOffsetX;
+            quadBuf.vert[0].vert.y = yOffset + additionalOffsetY;
+            quadBuf.vert[0].uv.u = rect.x1 / textureSize.w;
+            quadBuf.vert[0].uv.v = (rect.y1 + rect.y2) / textureSize.h;
+
+            // Calculate the second vertex of the first face
+            quadBuf.vert[1].vert.x = pen.x + rect.x2 + charData.offset.w + additionalOffsetX;
+            quadBuf.vert[1].vert.y = yOffset + rect.y2 + additionalOffsetY;
+            quadBuf.vert[1].uv.u = (rect.x1 + rect.x2) / textureSize.w;
+            quadBuf.vert[1].uv.v = rect.y1 / textureSize.h;
+
+            // Calculate the third vertex of the first face
+            quadBuf.vert[2].vert.x = quadBuf.vert[0].vert.x;
+            quadBuf.vert[2].vert.y = quadBuf.vert[1].vert.y;
+            quadBuf.vert[2].uv.u = quadBuf.vert[0].uv.u;
+            quadBuf.vert[2].uv.v = quadBuf.vert[1].uv.v;
+
+            // Calculate the second vertex of the second face
+            quadBuf.vert[3].vert.x = quadBuf.vert[1].vert.x;
+            quadBuf.vert[3].vert.y = quadBuf.vert[0].vert.y;
+            quadBuf.vert[3].uv.u = quadBuf.vert[1].uv.u;
+            quadBuf.vert[3].uv.v = quadBuf.vert[0].uv.v;
+        }
+    }
+
+
+    /************************************************************************
+    *    DESC:  Lay out the whole string into the font data
+    ************************************************************************/
+    void Build( const CFont & font, const std::string & fontString, CFontData & fontData )
+    {
+        const CFontProperties & fontProp = fontData.m_fontProp;
+
+        fontData.m_fontString = fontString;
+        fontData.m_fontStrSize.clear();
+        fontData.m_widestLineWidth = 0.f;
+        fontData.m_widestCharIndex = std::string::npos;
+        float lastCharDif(0.f);
+
+        // Count the characters that have a quad
+        size_t charCount = 0;
+        for( auto id : fontString )
+            if( (id != ' ') && (id != '|') )
+                ++charCount;
+
+        // Size the quad array. A copy is kept for the sprite batch
+        auto & quadVec = fontData.m_quadVec;
+        quadVec.resize( charCount );
+
+        auto & penVec = fontData.m_penVec;
+        penVec.resize( charCount );
+
+        float xOffset = 0.f;
+        float width = 0.f;
+        float lineHeightOffset = 0.f;
+        float lineHeightWrap = font.getLineHeight() + font.getVertPadding() + fontProp.m_lineWrapHeight;
+        float initialHeightOffset = font.getBaselineOffset() + font.getVertPadding();
+        float lineSpace = font.getLineHeight() - font.getBaselineOffset();
+
+        size_t counter = 0;
+        int lineCount = 0;
+
+        // Get the size of the texture
+        CSize<float> textureSize = font.getTextureSize();
+
+        // Handle the horizontal alignment
+        auto & lineWidthOffsetVec = fontData.m_lineWidthOffsetVec;
+        CalcLineWidthOffset( font, fontProp, fontString, lineWidthOffsetVec );
+
+        // Set the initial line offset
+        xOffset = lineWidthOffsetVec[lineCount++];
+
+        // Handle the vertical alignment
+        if( fontProp.m_vAlign == NDefs::EVA_VERT_TOP )
+            lineHeightOffset = -initialHeightOffset;
+
+        if( fontProp.m_vAlign == NDefs::EVA_VERT_CENTER )
+        {
+            lineHeightOffset = -(initialHeightOffset - ((font.getBaselineOffset()-lineSpace) / 2.f) - font.getVertPadding());
+
+            if( lineWidthOffsetVec.size() > 1 )
+                lineHeightOffset = ((lineHeightWrap * lineWidthOffsetVec.size()) / 2.f) - font.getBaselineOffset();
+        }
+
+        else if( fontProp.m_vAlign == NDefs::EVA_VERT_BOTTOM )
+        {
+            lineHeightOffset = -(initialHeightOffset - font.getBaselineOffset() - font.getVertPadding());
+
+            if( lineWidthOffsetVec.size() > 1 )
+                lineHeightOffset += (lineHeightWrap * (lineWidthOffsetVec.size()-1));
+        }
+
+        // Remove any fractional component of the line height offset
+        lineHeightOffset = (int)lineHeightOffset;
+
+        // Setup each character in the vertex buffer
+        for( size_t i = 0; i < fontString.size(); ++i )
+        {
+            const char id = fontString[i];
+
+            // Line wrap if '|' character was used
+            if( id == '|' )
+            {
+                xOffset = lineWidthOffsetVec[lineCount];
+                width = 0.f;
+
+                lineHeightOffset += -lineHeightWrap;
+                ++lineCount;
+            }
+            else
+            {
+                // See if we can find the character
+                const CCharData & charData = font.getCharData(id);
+
+                // Ignore space characters
+                if( id != ' ' )
+                {
+                    penVec[counter] = CPoint<float>( xOffset, lineHeightOffset );
+
+                    SetQuad( quadVec[counter], charData, penVec[counter], font.getLineHeight(), textureSize );
+
+                    ++counter;
+                }
+
+                // Inc the font position
+                float inc = charData.xAdvance + fontProp.m_kerning + font.getHorzPadding();
+
+                // Add in any additional spacing for the space character
+                if( id == ' ' )
+                    inc += fontProp.m_spaceCharKerning;
+
+                width += inc;
+                xOffset += inc;
+
+                // Get the longest width of this font string
+                if( fontData.m_fontStrSize.w < width )
+                {
+                    fontData.m_fontStrSize.w = width;
+                    fontData.m_widestLineWidth = width;
+                    fontData.m_widestCharIndex = i;
+
+                    // This is the space between this character and the next.
+                    // Save this difference so that it can be subtracted at the end
+                    lastCharDif = inc - charData.rect.x2;
+                }
+
+                // Wrap to another line
+                if( (id == ' ') && (fontProp.m_lineWrapWidth > 0.f) )
+                {
+                    if( width + GetNextWordWidth( font, fontProp, fontString, i ) >= fontProp.m_lineWrapWidth )
+                    {
+                        xOffset = lineWidthOffsetVec[lineCount++];
+                        width = 0.f;
+
+                        lineHeightOffset += -lineHeightWrap;
+                    }
+                }
+            }
+        }
+
+        // Subtract the extra space after the last character
+        fontData.m_fontStrSize.w -= lastCharDif;
+        fontData.m_fontStrSize.h = font.getLineHeight();
+    }
+
+
+    /************************************************************************
+    *    DESC:  Lay out only the characters that changed
+    *
+    *           The pen position of every character stays the same if each
+    *           changed character has the same advance and offset as the
+    *           one it replaces and no line wrapping is done on spaces.
+    *           The digits of a counter are laid out this way.
+    ************************************************************************/
+    bool Update(
+        const CFont & font,
+        const std::string & fontString,
+        CFontData & fontData,
+        size_t & firstQuad,
+        size_t & quadCount )
+    {
+        const CFontProperties & fontProp = fontData.m_fontProp;
+        const std::string & oldString = fontData.m_fontString;
+
+        firstQuad = 0;
+        quadCount = 0;
+
+        if( (fontString.size() != oldString.size()) ||
+            (fontData.m_penVec.size() != fontData.m_quadVec.size()) ||
+            fontData.m_penVec.empty() ||
+            (fontProp.m_lineWrapWidth > 0.f) )
+            return false;
+
+        // Check that none of the changed characters move the ones after it
+        for( size_t i = 0; i < fontString.size(); ++i )
+        {
+            const char newId = fontString[i];
+            const char oldId = oldString[i];
+
+            if( newId != oldId )
+            {
+                if( (newId == ' ') || (newId == '|') || (oldId == ' ') || (oldId == '|') )
+                    return false;
+
+                const CCharData & newCharData = font.getCharData(newId);
+                const CCharData & oldCharData = font.getCharData(oldId);
+
+                if( (newCharData.xAdvance != oldCharData.xAdvance) || (newCharData.offset.w != oldCharData.offset.w) )
+                    return false;
+            }
+        }
+
+        // Get the size of the texture
+        CSize<float> textureSize = font.getTextureSize();
+
+        size_t counter = 0;
+        size_t lastQuad = 0;
+        bool changed = false;
+
+        for( size_t i = 0; i < fontString.size(); ++i )
+        {
+            const char id = fontString[i];
+
+            if( (id == ' ') || (id == '|') )
+                continue;
+
+            if( id != oldString[i] )
+            {
+                const CCharData & charData = font.getCharData(id);
+
+                SetQuad( fontData.m_quadVec[counter], charData, fontData.m_penVec[counter], font.getLineHeight(), textureSize );
+
+                // The width of the string ends with the width of this character
+                if( i == fontData.m_widestCharIndex )
+                {
+                    const float inc = charData.xAdvance + fontProp.m_kerning + font.getHorzPadding();
+                    fontData.m_fontStrSize.w = fontData.m_widestLineWidth - (inc - charData.rect.x2);
+                }
+
+                if( !changed )
+                    firstQuad = counter;
+
+                lastQuad = counter;
+                changed = true;
+            }
+
+            ++counter;
+        }
+
+        if( changed )
+            quadCount = (lastQuad - firstQuad) + 1;
+
+        fontData.m_fontString = fontString;
+
+        return true;
+    }
+
+}   // NFontLayout
@@ -0,0 +1,37 @@
+/************************************************************************
+*    FILE NAME:       fontlayout.h
+*
+*    DESCRIPTION:     Lays out the character quads of a font string
+*                     The vectors of the font data are reused so laying
+*                     out a string no longer than the last one doesn't
+*                     allocate. A string that only changes characters of
+*                     the same advance, like a counter, can be updated in
+*                     place by only laying out the changed characters.
+************************************************************************/
+
+#ifndef __font_layout_h__
+#define __font_layout_h__
+
+// Standard lib dependencies
+#include <string>
+
+// Forward declaration(s)
+class CFont;
+class CFontData;
+
+namespace NFontLayout
+{
+    // Lay out the whole string into the font data
+    void Build( const CFont & font, const std::string & fontString, CFontData & fontData );
+
+    // Lay out only the characters that changed. Returns false if the
+    // string needs to be built. The changed quads are returned as a range
+    bool Update(
+        const CFont & font,
+        const std::string & fontString,
+        CFontData & fontData,
+        size_t & firstQuad,
+        size_t & quadCount );
+}
+
+#endif  // __font_layout_h__
@@ -7,18 +7,29 @@
 // Physical component dependency
 #include <2d/object2d.h>
 
+// Game lib dependencies
+#include <common/defs.h>
+
+// Standard lib dependencies
+#include <cmath>
+#include <utility>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
-CObject2D::CObject2D()
+CObject2D::CObject2D() :
+    m_transPos( m_transSlot.m_pChunk->m_transPos[m_transSlot.m_index] ),
+    m_matrix( m_transSlot.m_pChunk->m_matrix[m_transSlot.m_index] )
 {
 }
 
 CObject2D::CObject2D( const CObject2D & obj ) :
     CObject( obj ),
-    m_transPos( obj.m_transPos ),
-    m_matrix( obj.m_matrix )
+    m_transPos( m_transSlot.m_pChunk->m_transPos[m_transSlot.m_index] ),
+    m_matrix( m_transSlot.m_pChunk->m_matrix[m_transSlot.m_index] )
 {
+    m_transPos = obj.m_transPos;
+    m_matrix = obj.m_matrix;
 }
 
 
@@ -30,6 +41,20 @@ CObject2D::~CObject2D()
 }
 
 
+/************************************************************************
+*    DESC:  Copy the transform and the matrix
+************************************************************************/
+CObject2D & CObject2D::operator = ( const CObject2D & obj )
+{
+    CObject::operator = ( obj );
+
+    m_transPos = obj.m_transPos;
+    m_matrix = obj.m_matrix;
+
+    return *this;
+}
+
+
 /************************************************************************
 *    DESC:  Get the object's translated position
 ************************************************************************/
@@ -41,8 +66,66 @@ const CPoint<float> & CObject2D::getTransPos() const
 
 /************************************************************************
 *    DESC:  Transform the object in local space
+*           An object changed in the last fixed step is transformed
+*           between its last two steps. The interpolated transform is
+*           swapped in so the derived scale and rotation are used
 ************************************************************************/
 void CObject2D::transformLocal( CMatrix & matrix )
+{
+    const float alpha = getInterpAlpha();
+
+    if( alpha < 1.f )
+    {
+        // Turn the shortest way between the angles
+        auto lerpAngle = []( float prev, float cur, float ratio )
+        {
+            const float diff = std::remainder( cur - prev, 360.0f * defs_DEG_TO_RAD );
+            return prev + (diff * ratio);
+        };
+
+        CPoint<CWorldValue> pos(
+            m_prevPos.x + ((m_pos.x - m_prevPos.x) * alpha),
+            m_prevPos.y + ((m_pos.y - m_prevPos.y) * alpha),
+            m_prevPos.z + ((m_pos.z - m_prevPos.z) * alpha) );
+
+        CPoint<float> rot(
+            lerpAngle( m_prevRot.x, m_rot.x, alpha ),
+            lerpAngle( m_prevRot.y, m_rot.y, alpha ),
+            lerpAngle( m_prevRot.z, m_rot.z, alpha ) );
+
+        CPoint<float> scale( m_prevScale + ((m_scale - m_prevScale) * alpha) );
+
+        std::swap( m_pos, pos );
+        std::swap( m_rot, rot );
+        std::swap( m_scale, scale );
+
+        transformLocalMatrix( matrix );
+
+        std::swap( m_pos, pos );
+        std::swap( m_rot, rot );
+        std::swap( m_scale, scale );
+
+        m_parameters.add( NDefs::INTERPOLATED );
+    }
+    else
+    {
+        transformLocalMatrix( matrix );
+
+        m_parameters.remove( NDefs::INTERPOLATED );
+    }
+
+    // Clear the check parameter
+    m_parameters.remove( NDefs::TRANSFORM | NDefs::PHYSICS_TRANSFORM );
+
+    // Indicate that translation was done
+    m_parameters.add( NDefs::WAS_TRANSFORMED );
+}
+
+
+/************************************************************************
+*    DESC:  Make the local matrix from the transform
+************************************************************************/
+void CObject2D::transformLocalMatrix( CMatrix & matrix )
 {
     // Reset the matrices
     matrix.initilizeMatrix();
@@ -63,11 +146,8 @@ void CObject2D::transformLocal( CMatrix & matrix )
     if( m_parameters.isSet( NDefs::TRANSLATE ) )
         matrix.translate( m_pos );
 
-    // Clear the check parameter
-    m_parameters.remove( NDefs::TRANSFORM | NDefs::PHYSICS_TRANSFORM );
-
-    // Indicate that translation was done
-    m_parameters.add( NDefs::WAS_TRANSFORMED );
+    // The translated position of an object without a parent
+    m_transPos = m_pos;
 }
 
 
@@ -76,29 +156,45 @@ void CObject2D::transformLocal( CMatrix & matrix )
 ************************************************************************/
 void CObject2D::transform()
 {
+    // The batched pass made the matrix this frame
+    if( m_parameters.isSet( NDefs::BATCH_TRANSFORMED ) )
+    {
+        m_parameters.remove( NDefs::BATCH_TRANSFORMED );
+        return;
+    }
+
     m_parameters.remove( NDefs::WAS_TRANSFORMED );
     
-    if( m_parameters.isSet( NDefs::TRANSFORM ) )
-    {
+    if( m_parameters.isSet( NDefs::TRANSFORM ) || isInterpolating() )
         transformLocal( m_matrix );
-    
-        m_transPos = m_pos;
-    }
 }
 
 void CObject2D::transform( const CMatrix & matrix, bool tranformWorldPos )
 {
+    // The batched pass made the local matrix this frame
+    if( m_parameters.isSet( NDefs::BATCH_TRANSFORMED ) )
+    {
+        m_parameters.remove( NDefs::BATCH_TRANSFORMED );
+
+        const CMatrix localMatrix( m_matrix );
+        m_matrix.multiply( localMatrix, matrix );
+        m_transPos.set( m_matrix[m30], m_matrix[m31], m_matrix[m32] );
+
+        return;
+    }
+
     m_parameters.remove( NDefs::WAS_TRANSFORMED );
     
-    if( m_parameters.isSet( NDefs::TRANSFORM ) || tranformWorldPos )
+    if( m_parameters.isSet( NDefs::TRANSFORM ) || tranformWorldPos || isInterpolating() )
     {
         CMatrix localMatrix;
     
         transformLocal( localMatrix );
     
-        m_matrix = localMatrix * matrix;
+        m_matrix.multiply( localMatrix, matrix );
 
-        m_matrix.transform( m_transPos, CPoint<float>() );
+        // The translated position is the translation row
+        m_transPos.set( m_matrix[m30], m_matrix[m31], m_matrix[m32] );
     }
 }
 
@@ -108,6 +204,17 @@ void CObject2D::transform( const CObject2D & object )
 }
 
 
+/************************************************************************
+*    DESC:  Does the object need to be transformed for interpolation
+*           The frame after the last interpolated one is transformed
+*           too so the object ends on its last step
+************************************************************************/
+bool CObject2D::isInterpolating() const
+{
+    return m_parameters.isSet( NDefs::INTERPOLATED ) || (getInterpAlpha() < 1.f);
+}
+
+
 /************************************************************************
 *    DESC:  Apply the scale
 ************************************************************************/
@@ -152,6 +259,28 @@ bool CObject2D::wasWorldPosTranformed() const
 }
 
 
+/************************************************************************
+*    DESC:  Make the matrix in the batched pass of the transform store
+*           An object with its own scale or rotation math isn't batched
+************************************************************************/
+void CObject2D::setBatchTransform( bool value )
+{
+    if( value && allowBatchTransform() )
+        m_parameters.add( NDefs::BATCH_TRANSFORM );
+    else
+        m_parameters.remove( NDefs::BATCH_TRANSFORM | NDefs::BATCH_TRANSFORMED );
+}
+
+
+/************************************************************************
+*    DESC:  Can the matrix be made in the batched pass
+************************************************************************/
+bool CObject2D::allowBatchTransform() const
+{
+    return true;
+}
+
+
 /************************************************************************
 *    DESC:  Force a transform from this point all the way up the line
 ************************************************************************/
@@ -24,6 +24,9 @@ public:
     CObject2D( const CObject2D & obj );
     virtual ~CObject2D();
 
+    // Copy the transform and the matrix
+    CObject2D & operator = ( const CObject2D & obj );
+
     // Transform - One call for those objects that don't have parents
     virtual void transform();
     virtual void transform( const CObject2D & object );
@@ -41,10 +44,22 @@ public:
     // Get the object's translated position
     const CPoint<float> & getTransPos() const;
 
+    // Make the matrix in the batched pass of the transform store
+    void setBatchTransform( bool value = true );
+
 protected:
 
+    // Can the matrix be made in the batched pass
+    virtual bool allowBatchTransform() const;
+
     // Transform the object in local space
     void transformLocal( CMatrix & matrix );
+
+    // Make the local matrix from the transform
+    void transformLocalMatrix( CMatrix & matrix );
+
+    // Does the object need to be transformed for interpolation
+    bool isInterpolating() const;
     
     // Apply the scale
     virtual void applyScale( CMatrix & matrix );
@@ -55,10 +70,10 @@ protected:
 protected:
 
     // Translated position
-    CPoint<float> m_transPos;
+    CPoint<float> & m_transPos;
 
     // local matrix
-    CMatrix m_matrix;
+    CMatrix & m_matrix;
 };
 
 #endif  // __object_2d_h__
@@ -0,0 +1,309 @@
+/************************************************************************
+*    FILE NAME:       spatialgrid2d.cpp
+*
+*    DESCRIPTION:     Uniform grid of circles for 2D culling and
+*                     radius queries. Each entry is added to every cell
+*                     its circle touches and is only moved between cells
+*                     when the cells it touches change.
+************************************************************************/
+
+// Physical component dependency
+#include <2d/spatialgrid2d.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Entries touching more cells than this are kept in the list instead
+    const int64_t MAX_ENTRY_CELLS = 16;
+
+    // Keep the cell coordinates in range of an int
+    const float MAX_COORD = 1.0e9f;
+}
+
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSpatialGrid2D::CSpatialGrid2D( float cellSize ) :
+    m_cellSize( std::max( cellSize, 1.f ) ),
+    m_invCellSize( 1.f / m_cellSize ),
+    m_count(0)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CSpatialGrid2D::~CSpatialGrid2D()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Add or move an entry
+************************************************************************/
+void CSpatialGrid2D::update( uint32_t id, const CPoint<float> & pos, float radius )
+{
+    if( id >= m_entryVec.size() )
+        m_entryVec.resize( id + 1 );
+
+    CEntry & rEntry = m_entryVec[id];
+
+    const float size = std::max( radius, 0.f );
+    const CCellRange range = getRange( pos.x - size, pos.y - size, pos.x + size, pos.y + size );
+    const bool inList = (radius < 0) ||
+        ((int64_t(range.m_x2 - range.m_x1) + 1) * (int64_t(range.m_y2 - range.m_y1) + 1) > MAX_ENTRY_CELLS);
+
+    // Only relink when the entry touches different cells
+    if( rEntry.m_active && ((rEntry.m_inList != inList) || !(rEntry.m_range == range)) )
+    {
+        unlink( id, rEntry );
+        rEntry.m_active = false;
+    }
+
+    rEntry.m_pos = pos;
+    rEntry.m_radius = radius;
+
+    if( !rEntry.m_active )
+    {
+        rEntry.m_range = range;
+        rEntry.m_inList = inList;
+        rEntry.m_active = true;
+        link( id, rEntry );
+        ++m_count;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Remove an entry
+************************************************************************/
+void CSpatialGrid2D::remove( uint32_t id )
+{
+    if( (id < m_entryVec.size()) && m_entryVec[id].m_active )
+    {
+        unlink( id, m_entryVec[id] );
+        m_entryVec[id].m_active = false;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Remove all the entries
+************************************************************************/
+void CSpatialGrid2D::clear()
+{
+    m_cellMap.clear();
+    m_entryVec.clear();
+    m_listVec.clear();
+    m_count = 0;
+}
+
+
+/************************************************************************
+*    DESC:  Get the ids of the entries that overlap the rect
+************************************************************************/
+void CSpatialGrid2D::queryRect( const CRect<float> & rect, std::vector<uint32_t> & idVec ) const
+{
+    const size_t first = idVec.size();
+
+    addCandidates( getRange( rect.x1, rect.y1, rect.x2, rect.y2 ), idVec );
+
+    idVec.erase(
+        std::remove_if( idVec.begin() + first, idVec.end(),
+            [this, &rect]( uint32_t id ){ return !overlaps( m_entryVec[id], rect ); } ),
+        idVec.end() );
+}
+
+
+/************************************************************************
+*    DESC:  Get the ids of the entries that overlap the circle
+************************************************************************/
+void CSpatialGrid2D::queryRadius( const CPoint<float> & pos, float radius, std::vector<uint32_t> & idVec ) const
+{
+    const size_t first = idVec.size();
+
+    addCandidates( getRange( pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius ), idVec );
+
+    idVec.erase(
+        std::remove_if( idVec.begin() + first, idVec.end(),
+            [this, &pos, radius]( uint32_t id )
+            {
+                const CEntry & entry = m_entryVec[id];
+                const float x = entry.m_pos.x - pos.x;
+                const float y = entry.m_pos.y - pos.y;
+                const float length = radius + std::max( entry.m_radius, 0.f );
+
+                return ((x * x) + (y * y)) >= (length * length);
+            } ),
+        idVec.end() );
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of entries
+************************************************************************/
+size_t CSpatialGrid2D::getCount() const
+{
+    return m_count;
+}
+
+
+/************************************************************************
+*    DESC:  Add the ids of the entries in the cells of the range and the list
+*           An entry in more than one cell is only added from the first
+*           cell where it and the range overlap so no set is needed and
+*           queries can be made from more than one thread
+************************************************************************/
+void CSpatialGrid2D::addCandidates( const CCellRange & range, std::vector<uint32_t> & idVec ) const
+{
+    idVec.insert( idVec.end(), m_listVec.begin(), m_listVec.end() );
+
+    auto addCell = [this, &range, &idVec]( int32_t x, int32_t y, const std::vector<uint32_t> & cellVec )
+    {
+        for( auto id : cellVec )
+        {
+            const CCellRange & entryRange = m_entryVec[id].m_range;
+
+            if( (std::max( entryRange.m_x1, range.m_x1 ) == x) && (std::max( entryRange.m_y1, range.m_y1 ) == y) )
+                idVec.push_back( id );
+        }
+    };
+
+    const int64_t cellCount = (int64_t(range.m_x2 - range.m_x1) + 1) * (int64_t(range.m_y2 - range.m_y1) + 1);
+
+    // A range larger than the cells in use is faster to check cell by cell
+    if( cellCount > static_cast<int64_t>(m_cellMap.size()) )
+    {
+        for( auto & iter : m_cellMap )
+        {
+            const int32_t x = static_cast<int32_t>(iter.first >> 32);
+            const int32_t y = static_cast<int32_t>(iter.first & 0xFFFFFFFF);
+
+            if( (x >= range.m_x1) && (x <= range.m_x2) && (y >= range.m_y1) && (y <= range.m_y2) )
+                addCell( x, y, iter.second );
+        }
+    }
+    else
+    {
+        for( int32_t y = range.m_y1; y <= range.m_y2; ++y )
+        {
+            for( int32_t x = range.m_x1; x <= range.m_x2; ++x )
+            {
+                auto iter = m_cellMap.find( getKey( x, y ) );
+                if( iter != m_cellMap.end() )
+                    addCell( x, y, iter->second );
+            }
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the range of cells the rect covers
+************************************************************************/
+CSpatialGrid2D::CCellRange CSpatialGrid2D::getRange( float x1, float y1, float x2, float y2 ) const
+{
+    auto toCell = [this]( float value )
+    {
+        return static_cast<int32_t>(std::floor( std::max( -MAX_COORD, std::min( value * m_invCellSize, MAX_COORD ) ) ));
+    };
+
+    CCellRange range;
+    range.m_x1 = toCell( std::min( x1, x2 ) );
+    range.m_y1 = toCell( std::min( y1, y2 ) );
+    range.m_x2 = toCell( std::max( x1, x2 ) );
+    range.m_y2 = toCell( std::max( y1, y2 ) );
+
+    return range;
+}
+
+
+/************************************************************************
+*    DESC:  Add the entry to the cells or the list
+************************************************************************/
+void CSpatialGrid2D::link( uint32_t id, CEntry & rEntry )
+{
+    if( rEntry.m_inList )
+    {
+        m_listVec.push_back( id );
+    }
+    else
+    {
+        for( int32_t y = rEntry.m_range.m_y1; y <= rEntry.m_range.m_y2; ++y )
+            for( int32_t x = rEntry.m_range.m_x1; x <= rEntry.m_range.m_x2; ++x )
+                m_cellMap[getKey( x, y )].push_back( id );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Remove the entry from the cells or the list
+************************************************************************/
+void CSpatialGrid2D::unlink( uint32_t id, const CEntry & rEntry )
+{
+    // Order in a cell doesn't matter so swap with the last and pop
+    auto removeId = [id]( std::vector<uint32_t> & idVec )
+    {
+        auto iter = std::find( idVec.begin(), idVec.end(), id );
+        if( iter != idVec.end() )
+        {
+            *iter = idVec.back();
+            idVec.pop_back();
+        }
+    };
+
+    if( rEntry.m_inList )
+    {
+        removeId( m_listVec );
+    }
+    else
+    {
+        for( int32_t y = rEntry.m_range.m_y1; y <= rEntry.m_range.m_y2; ++y )
+        {
+            for( int32_t x = rEntry.m_range.m_x1; x <= rEntry.m_range.m_x2; ++x )
+            {
+                auto iter = m_cellMap.find( getKey( x, y ) );
+                if( iter != m_cellMap.end() )
+                {
+                    removeId( iter->second );
+
+                    if( iter->second.empty() )
+                        m_cellMap.erase( iter );
+                }
+            }
+        }
+    }
+
+    --m_count;
+}
+
+
+/************************************************************************
+*    DESC:  Get the key of a cell
+************************************************************************/
+uint64_t CSpatialGrid2D::getKey( int32_t x, int32_t y )
+{
+    return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y));
+}
+
+
+/************************************************************************
+*    DESC:  Does the entry overlap the rect
+*           Entries with no size are never culled
+************************************************************************/
+bool CSpatialGrid2D::overlaps( const CEntry & entry, const CRect<float> & rect )
+{
+    if( entry.m_radius < 0 )
+        return true;
+
+    // Closest point of the rect to the center of the circle
+    const float x = std::max( std::min( rect.x1, rect.x2 ), std::min( entry.m_pos.x, std::max( rect.x1, rect.x2 ) ) ) - entry.m_pos.x;
+    const float y = std::max( std::min( rect.y1, rect.y2 ), std::min( entry.m_pos.y, std::max( rect.y1, rect.y2 ) ) ) - entry.m_pos.y;
+
+    return ((x * x) + (y * y)) <= (entry.m_radius * entry.m_radius);
+}
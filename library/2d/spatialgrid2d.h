@@ -0,0 +1,117 @@
+/************************************************************************
+*    FILE NAME:       spatialgrid2d.h
+*
+*    DESCRIPTION:     Uniform grid of circles for 2D culling and
+*                     radius queries. Each entry is added to every cell
+*                     its circle touches and is only moved between cells
+*                     when the cells it touches change.
+************************************************************************/
+
+#ifndef __spatial_grid_2d_h__
+#define __spatial_grid_2d_h__
+
+// Game lib dependencies
+#include <common/point.h>
+#include <common/rect.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class CSpatialGrid2D : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CSpatialGrid2D( float cellSize );
+
+    // Destructor
+    ~CSpatialGrid2D();
+
+    // Add or move an entry. Entries with a radius less than zero have
+    // no known size. queryRect always returns them and queryRadius
+    // treats them as a point
+    void update( uint32_t id, const CPoint<float> & pos, float radius );
+
+    // Remove an entry
+    void remove( uint32_t id );
+
+    // Remove all the entries
+    void clear();
+
+    // Get the ids of the entries that overlap the rect. In no set order
+    void queryRect( const CRect<float> & rect, std::vector<uint32_t> & idVec ) const;
+
+    // Get the ids of the entries that overlap the circle. In no set order
+    void queryRadius( const CPoint<float> & pos, float radius, std::vector<uint32_t> & idVec ) const;
+
+    // Get the number of entries
+    size_t getCount() const;
+
+private:
+
+    // Range of cells covered by a rect
+    class CCellRange
+    {
+    public:
+        int32_t m_x1 = 0, m_y1 = 0, m_x2 = 0, m_y2 = 0;
+
+        bool operator == ( const CCellRange & obj ) const
+        { return (m_x1 == obj.m_x1) && (m_y1 == obj.m_y1) && (m_x2 == obj.m_x2) && (m_y2 == obj.m_y2); }
+    };
+
+    class CEntry
+    {
+    public:
+        CPoint<float> m_pos;
+        float m_radius = 0;
+        CCellRange m_range;
+        bool m_active = false;
+
+        // Entries with no size or too large for the cells are kept in a list
+        bool m_inList = false;
+    };
+
+    // Get the range of cells the rect covers
+    CCellRange getRange( float x1, float y1, float x2, float y2 ) const;
+
+    // Add/Remove the entry from the cells or the list
+    void link( uint32_t id, CEntry & rEntry );
+    void unlink( uint32_t id, const CEntry & rEntry );
+
+    // Add the ids of the entries in the cells of the range and the list.
+    // Each id is only added once
+    void addCandidates( const CCellRange & range, std::vector<uint32_t> & idVec ) const;
+
+    // Get the key of a cell
+    static uint64_t getKey( int32_t x, int32_t y );
+
+    // Does the entry overlap the rect
+    static bool overlaps( const CEntry & entry, const CRect<float> & rect );
+
+private:
+
+    // Size of a cell
+    float m_cellSize;
+
+    // 1 / cell size
+    float m_invCellSize;
+
+    // Ids of the entries in each cell
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cellMap;
+
+    // Entries by id
+    std::vector<CEntry> m_entryVec;
+
+    // Ids of the entries that are not in the cells
+    std::vector<uint32_t> m_listVec;
+
+    // Number of entries
+    size_t m_count;
+};
+
+#endif  // __spatial_grid_2d_h__
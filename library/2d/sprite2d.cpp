@@ -18,6 +18,10 @@
 #include <common/camera.h>
 #include <utilities/xmlParser.h>
 
+// Standard lib dependencies
+#include <algorithm>
+#include <cmath>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -25,7 +29,10 @@ CSprite2D::CSprite2D( const CObjectData2D & objectData, int id ) :
     iSprite(id),
     m_rObjectData(objectData),
     m_visualComponent(objectData.getVisualData()),
-    m_physicsComponent(objectData.getPhysicsData())
+    m_physicsComponent(objectData.getPhysicsData()),
+    m_collisionGroup(0),
+    m_collisionMask(0),
+    m_pUpdateContext(nullptr)
 {
     // If there's no visual data, set the hide flag
     setVisible( objectData.getVisualData().isActive() );
@@ -67,6 +74,10 @@ void CSprite2D::load( const CSpriteData & spriteData )
     // Copy over the script functions
     copyScriptFunctions( spriteData.getScriptFunctions() );
     
+    // Copy over the collision filter
+    m_collisionGroup = spriteData.getCollisionGroup();
+    m_collisionMask = spriteData.getCollisionMask();
+    
     // See if this sprite is used for rendering a font string
     if( m_visualComponent.isFontSprite() && (spriteData.getFontData() != nullptr) )
         m_visualComponent.setFontData( *spriteData.getFontData() );
@@ -82,7 +93,7 @@ void CSprite2D::init()
     if( m_visualComponent.isFontSprite() )
         m_visualComponent.createFontString();
     
-    prepareFuncId( "init", true );
+    prepareFuncId( CScriptFuncTable::EFI_INIT, true );
 }
 
 
@@ -103,61 +114,40 @@ void CSprite2D::cleanUp()
 
 
 /************************************************************************
-*    DESC:  Init the script functions and add them to the map
+*    DESC:  Init the script functions and add them to the table
 *           This function loads the attribute info reguardless of what it is
 ************************************************************************/
 void CSprite2D::initScriptFunctions( const XMLNode & node )
 {
-    // Check for scripting - Add an empty string for scripts not defined
-    XMLNode scriptLstNode = node.getChildNode( "scriptLst" );
-    if( !scriptLstNode.isEmpty() )
-    {
-        for( int i = 0; i < scriptLstNode.nChildNode(); ++i )
-        {
-            const XMLNode scriptNode = scriptLstNode.getChildNode(i);
-            
-            // Only the first attribute is used
-            const XMLAttribute attribute = scriptNode.getAttribute(0);
-            const std::string attrName = attribute.lpszName;
-            const std::string attrValue = attribute.lpszValue;
-
-            // Add the attribute name and value to the map
-            if( !attrValue.empty() )
-            {
-                m_scriptFunctionMap.emplace( attrName, attrValue );
-                
-                if( attrName == "update" )
-                    m_parameters.add( NDefs::SCRIPT_UPDATE );
-            }
-        }
-    }
+    m_scriptFuncTable.loadFromNode( node );
+    
+    if( m_scriptFuncTable.has( CScriptFuncTable::EFI_UPDATE ) )
+        m_parameters.add( NDefs::SCRIPT_UPDATE );
 }
 
 
 /************************************************************************
 *    DESC:  Copy over the script functions
 ************************************************************************/
-void CSprite2D::copyScriptFunctions( const std::map<std::string, std::string> & scriptFunctionMap )
+void CSprite2D::copyScriptFunctions( const CScriptFuncTable & scriptFuncTable )
 {
-    for( auto & iter : scriptFunctionMap )
-    {
-        m_scriptFunctionMap.emplace( iter );
-        
-        if( iter.first == "update" )
-            m_parameters.add( NDefs::SCRIPT_UPDATE );
-    }
+    // Shares the table of the sprite data so the functions are only resolved once
+    m_scriptFuncTable.add( scriptFuncTable );
+    
+    if( m_scriptFuncTable.has( CScriptFuncTable::EFI_UPDATE ) )
+        m_parameters.add( NDefs::SCRIPT_UPDATE );
 }
 
 
 /************************************************************************
 *    DESC:  Prepare the script function to run
 ************************************************************************/
-bool CSprite2D::prepareFuncId( const std::string & scriptFuncId, bool forceUpdate )
+bool CSprite2D::prepareFuncId( uint scriptFuncId, bool forceUpdate )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
+    asIScriptFunction * pScriptFunc = m_scriptFuncTable.get( scriptFuncId, m_rObjectData.getGroup() );
+    if( pScriptFunc != nullptr )
     {
-        m_scriptComponent.prepare( m_rObjectData.getGroup(), iter->second, {this});
+        m_scriptComponent.prepare( pScriptFunc, {this});
         
         // Allow the script to execute and return it's context to the queue
         // for the scripts that don't animate
@@ -170,12 +160,17 @@ bool CSprite2D::prepareFuncId( const std::string & scriptFuncId, bool forceUpdat
     return false;
 }
 
+bool CSprite2D::prepareFuncId( const std::string & scriptFuncId, bool forceUpdate )
+{
+    return prepareFuncId( CScriptFuncTable::GetId( scriptFuncId ), forceUpdate );
+}
+
 void CSprite2D::prepare(
     const std::string & funcName,
-    const std::vector<CScriptParam> & paramVec,
+    std::initializer_list<CScriptParam> paramList,
     bool forceUpdate )
 {
-    m_scriptComponent.prepare( m_rObjectData.getGroup(), funcName, paramVec);
+    m_scriptComponent.prepare( m_rObjectData.getGroup(), funcName, paramList);
     
     // Allow the script to execute and return it's context to the queue
     // for the scripts that don't animate
@@ -208,11 +203,37 @@ void CSprite2D::handleEvent( const SDL_Event & rEvent )
 ************************************************************************/
 void CSprite2D::update()
 {
-    m_scriptComponent.update();
+    scriptUpdate();
     
-    if( m_parameters.isSet( NDefs::SCRIPT_UPDATE ) )
-        prepareFuncId( "update" );
+    parallelUpdate();
+}
+
+
+/************************************************************************
+*    DESC:  Update the script part of the sprite
+************************************************************************/
+void CSprite2D::scriptUpdate()
+{
+    m_scriptComponent.serialUpdate();
     
+    // The last update is still waiting on the frame budget. Don't stack another one
+    if( m_parameters.isSet( NDefs::SCRIPT_UPDATE ) && !m_scriptComponent.isPending( m_pUpdateContext ) )
+    {
+        asIScriptFunction * pScriptFunc = m_scriptFuncTable.get( CScriptFuncTable::EFI_UPDATE, m_rObjectData.getGroup() );
+        if( pScriptFunc != nullptr )
+            m_pUpdateContext = m_scriptComponent.prepare( pScriptFunc, {this} );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Update the part of the sprite that doesn't use a script context
+*           or only the contexts of the parallel script groups
+************************************************************************/
+void CSprite2D::parallelUpdate()
+{
+    m_scriptComponent.parallelUpdate();
+
     if( m_upAI )
         m_upAI->update();
 }
@@ -319,6 +340,51 @@ uint CSprite2D::getCurrentFrame() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the radius around the translated position the sprite is drawn in
+*           Only known for quads. The size of the other types can change
+*           with the frame or the text. The corners of the quad are put
+*           through the last transform so the scale of the sprite and
+*           it's parent, the crop offset and the rotation about the
+*           center point are all in the radius
+************************************************************************/
+float CSprite2D::getRadius() const
+{
+    if( m_rObjectData.getVisualData().getGenerationType() != NDefs::EGT_QUAD )
+        return -1.f;
+
+    const float halfW = m_rObjectData.getSize().w / 2.f;
+    const float halfH = m_rObjectData.getSize().h / 2.f;
+    const CPoint<float> cornerAry[] = { {-halfW, -halfH}, {halfW, -halfH}, {halfW, halfH}, {-halfW, halfH} };
+
+    float radiusSquared = 0.f;
+
+    for( auto & iter : cornerAry )
+    {
+        CPoint<float> corner;
+        m_matrix.transform( corner, iter );
+
+        radiusSquared = std::max( radiusSquared, corner.getLengthSquared2D( getTransPos() ) );
+    }
+
+    return std::sqrt( radiusSquared );
+}
+
+
+/************************************************************************
+*    DESC:  Get the collision group and mask
+************************************************************************/
+uint CSprite2D::getCollisionGroup() const
+{
+    return m_collisionGroup;
+}
+
+uint CSprite2D::getCollisionMask() const
+{
+    return m_collisionMask;
+}
+
+
 /************************************************************************
 *    DESC:  Set the texture ID from index
 ************************************************************************/
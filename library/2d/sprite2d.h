@@ -15,13 +15,13 @@
 #include <2d/visualcomponent2d.h>
 #include <physics/physicscomponent2d.h>
 #include <script/scriptcomponent.h>
+#include <script/scriptfunctable.h>
 
 // Boost lib dependencies
 #include <boost/noncopyable.hpp>
 
 // Standard lib dependencies
 #include <string>
-#include <map>
 #include <memory>
 
 // Forward declaration(s)
@@ -29,6 +29,7 @@ class CObjectData2D;
 class CColor;
 class CSpriteData;
 class iAIBase;
+class asIScriptContext;
 struct XMLNode;
 
 class CSprite2D : public iSprite, boost::noncopyable
@@ -45,10 +46,12 @@ public:
     void initScriptFunctions( const XMLNode & node );
     
     // Prepare the script function to run
+    // Use the CScriptFuncTable ids when called often. The name is interned on each call
+    bool prepareFuncId( uint scriptFuncId, bool forceUpdate = false );
     bool prepareFuncId( const std::string & scriptFuncId, bool forceUpdate = false );
     void prepare(
         const std::string & funcName,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>(),
+        std::initializer_list<CScriptParam> paramList = {},
         bool forceUpdate = false );
     
     // Load the sprite data
@@ -83,6 +86,8 @@ public:
 
     // Update the sprite 
     void update() override;
+    void scriptUpdate() override;
+    void parallelUpdate() override;
     
     // Update the physics 
     void physicsUpdate() override;
@@ -95,7 +100,7 @@ public:
     void setAI( iAIBase * pAIBase ) override;
     
     // Copy over the script functions
-    void copyScriptFunctions( const std::map<std::string, std::string> & scriptFunctionMap );
+    void copyScriptFunctions( const CScriptFuncTable & scriptFuncTable );
 
     // Get the frame count
     uint getFrameCount() const override;
@@ -105,6 +110,13 @@ public:
     
     // Get the current frame
     uint getCurrentFrame() const override;
+    
+    // Get the radius around the translated position the sprite is drawn in
+    float getRadius() const override;
+    
+    // Get the collision group and mask
+    uint getCollisionGroup() const override;
+    uint getCollisionMask() const override;
 
 protected:
 
@@ -123,8 +135,16 @@ protected:
     // Base AI scoped pointer
     std::unique_ptr<iAIBase> m_upAI;
     
-    // Script function map. Tie events to script functions
-    std::map<const std::string, std::string> m_scriptFunctionMap;
+    // Script function table. Tie events to script functions
+    CScriptFuncTable m_scriptFuncTable;
+    
+    // Collision group and the groups it collides with
+    uint m_collisionGroup;
+    uint m_collisionMask;
+    
+    // The update context waiting to start or be resumed
+    // NOTE: This class does not own the pointer
+    asIScriptContext * m_pUpdateContext;
 
 };
 
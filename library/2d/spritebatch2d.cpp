@@ -0,0 +1,224 @@
+/************************************************************************
+*    FILE NAME:       spritebatch2d.cpp
+*
+*    DESCRIPTION:     Collects 2D quads into one vertex stream and
+*                     records the state changes and draws needed to
+*                     render them. Quads that share a shader, texture
+*                     and view matrix are drawn with one call. The
+*                     order they were added in is always kept.
+************************************************************************/
+
+// Physical component dependency
+#include <2d/spritebatch2d.h>
+
+// Game lib dependencies
+#include <common/vertex2d.h>
+#include <common/color.h>
+#include <common/irendercmdstream.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSpriteBatch2D::CSpriteBatch2D() :
+    m_pShaderData(nullptr),
+    m_textureID(0),
+    m_drawIndex(-1),
+    m_drawCount(0)
+{
+}
+
+
+/************************************************************************
+*    DESC:  Set the state of the quads that follow
+*           Only the state that changed is recorded. Any change closes
+*           the current draw so the quads stay in the order added
+************************************************************************/
+void CSpriteBatch2D::setState( CShaderData * pShaderData, uint32_t textureID, const CMatrix & matrix )
+{
+    const bool shaderChange = (m_cmdVec.empty() || (pShaderData != m_pShaderData));
+
+    if( shaderChange )
+    {
+        m_cmdVec.emplace_back( NDefs::ERC_BIND_SHADER );
+        m_cmdVec.back().m_pShaderData = pShaderData;
+        m_pShaderData = pShaderData;
+        m_drawIndex = -1;
+    }
+
+    if( shaderChange || (textureID != m_textureID) )
+    {
+        m_cmdVec.emplace_back( NDefs::ERC_BIND_TEXTURE );
+        m_cmdVec.back().m_textureID = textureID;
+        m_textureID = textureID;
+        m_drawIndex = -1;
+    }
+
+    // A newly bound shader needs the matrix sent again
+    if( shaderChange || m_matrixVec.empty() ||
+        (std::memcmp( m_matrixVec.back()(), matrix(), sizeof(float) * 16 ) != 0) )
+    {
+        m_cmdVec.emplace_back( NDefs::ERC_SET_MATRIX );
+        m_cmdVec.back().m_first = m_matrixVec.size();
+        m_matrixVec.push_back( matrix );
+        m_drawIndex = -1;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Add a quad. The verts are expected in triangle fan order
+************************************************************************/
+void CSpriteBatch2D::addQuad(
+    const CVertex2D & v0, const CVertex2D & v1, const CVertex2D & v2, const CVertex2D & v3,
+    const CMatrix & matrix,
+    const CColor & color )
+{
+    openDraw();
+
+    addVert( v0, matrix, color );
+    addVert( v1, matrix, color );
+    addVert( v2, matrix, color );
+    addVert( v3, matrix, color );
+}
+
+
+/************************************************************************
+*    DESC:  Add a quad and map the uv into the glyph rect of a sprite
+*           sheet. This is what the sprite sheet shader does per vertex
+************************************************************************/
+void CSpriteBatch2D::addQuad(
+    const CVertex2D & v0, const CVertex2D & v1, const CVertex2D & v2, const CVertex2D & v3,
+    const CMatrix & matrix,
+    const CColor & color,
+    const CRect<float> & glyphUV )
+{
+    addQuad( v0, v1, v2, v3, matrix, color );
+
+    for( auto iter = m_vertVec.end() - 4; iter != m_vertVec.end(); ++iter )
+    {
+        iter->uv.u = glyphUV.x1 + (iter->uv.u * glyphUV.x2);
+        iter->uv.v = glyphUV.y1 + (iter->uv.v * glyphUV.y2);
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Add a transformed vertex to the stream
+************************************************************************/
+void CSpriteBatch2D::addVert( const CVertex2D & vert, const CMatrix & matrix, const CColor & color )
+{
+    m_vertVec.emplace_back();
+    CBatchVertex2D & rVert = m_vertVec.back();
+
+    matrix.transform( rVert.vert, vert.vert );
+    rVert.uv = vert.uv;
+    rVert.color = color;
+}
+
+
+/************************************************************************
+*    DESC:  Make sure there is an open draw command for the next quad
+************************************************************************/
+void CSpriteBatch2D::openDraw()
+{
+    if( (m_drawIndex < 0) || (m_cmdVec[m_drawIndex].m_count >= MAX_QUADS_PER_DRAW) )
+    {
+        m_drawIndex = m_cmdVec.size();
+        m_cmdVec.emplace_back( NDefs::ERC_DRAW_QUADS );
+        m_cmdVec.back().m_first = getQuadCount();
+        ++m_drawCount;
+    }
+
+    ++m_cmdVec[m_drawIndex].m_count;
+}
+
+
+/************************************************************************
+*    DESC:  Send the recorded commands to the stream and clear the batch
+************************************************************************/
+void CSpriteBatch2D::flush( iRenderCmdStream & stream )
+{
+    if( m_vertVec.empty() )
+    {
+        clear();
+        return;
+    }
+
+    stream.upload( m_vertVec.data(), m_vertVec.size() );
+
+    for( auto & iter : m_cmdVec )
+    {
+        if( iter.m_type == NDefs::ERC_BIND_SHADER )
+            stream.bindShader( iter.m_pShaderData );
+
+        else if( iter.m_type == NDefs::ERC_BIND_TEXTURE )
+            stream.bindTexture( iter.m_textureID );
+
+        else if( iter.m_type == NDefs::ERC_SET_MATRIX )
+            stream.setMatrix( m_matrixVec[iter.m_first] );
+
+        else if( iter.m_type == NDefs::ERC_DRAW_QUADS )
+            stream.drawQuads( iter.m_first, iter.m_count );
+    }
+
+    clear();
+}
+
+
+/************************************************************************
+*    DESC:  Clear out the batch. The memory is kept for the next frame
+************************************************************************/
+void CSpriteBatch2D::clear()
+{
+    m_vertVec.clear();
+    m_cmdVec.clear();
+    m_matrixVec.clear();
+    m_pShaderData = nullptr;
+    m_textureID = 0;
+    m_drawIndex = -1;
+    m_drawCount = 0;
+}
+
+
+/************************************************************************
+*    DESC:  Is there anything to render
+************************************************************************/
+bool CSpriteBatch2D::isEmpty() const
+{
+    return m_vertVec.empty();
+}
+
+
+/************************************************************************
+*    DESC:  Get the recorded commands
+************************************************************************/
+const std::vector<CRenderCmd> & CSpriteBatch2D::getCmdVec() const
+{
+    return m_cmdVec;
+}
+
+
+/************************************************************************
+*    DESC:  Get the vertex stream
+************************************************************************/
+const std::vector<CBatchVertex2D> & CSpriteBatch2D::getVertVec() const
+{
+    return m_vertVec;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of quads and draws recorded
+************************************************************************/
+size_t CSpriteBatch2D::getQuadCount() const
+{
+    return m_vertVec.size() / 4;
+}
+
+size_t CSpriteBatch2D::getDrawCount() const
+{
+    return m_drawCount;
+}
@@ -0,0 +1,109 @@
+/************************************************************************
+*    FILE NAME:       spritebatch2d.h
+*
+*    DESCRIPTION:     Collects 2D quads into one vertex stream and
+*                     records the state changes and draws needed to
+*                     render them. Quads that share a shader, texture
+*                     and view matrix are drawn with one call. The
+*                     order they were added in is always kept.
+************************************************************************/
+
+#ifndef __sprite_batch_2d_h__
+#define __sprite_batch_2d_h__
+
+// Game lib dependencies
+#include <common/batchvertex2d.h>
+#include <common/rendercmd.h>
+#include <common/rect.h>
+#include <utilities/matrix.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <cstdint>
+
+// Forward declaration(s)
+class CShaderData;
+class CVertex2D;
+class CColor;
+class iRenderCmdStream;
+
+class CSpriteBatch2D : boost::noncopyable
+{
+public:
+
+    // Max quads in one draw. Keeps the indices in 16 bits
+    enum{ MAX_QUADS_PER_DRAW = 16384 };
+
+    // Constructor
+    CSpriteBatch2D();
+
+    // Set the state of the quads that follow. A new run is
+    // started if it's different from the current one
+    void setState( CShaderData * pShaderData, uint32_t textureID, const CMatrix & matrix );
+
+    // Add a quad. The verts are expected in triangle fan order
+    void addQuad(
+        const CVertex2D & v0, const CVertex2D & v1, const CVertex2D & v2, const CVertex2D & v3,
+        const CMatrix & matrix,
+        const CColor & color );
+
+    // Add a quad and map the uv into the glyph rect of a sprite sheet
+    void addQuad(
+        const CVertex2D & v0, const CVertex2D & v1, const CVertex2D & v2, const CVertex2D & v3,
+        const CMatrix & matrix,
+        const CColor & color,
+        const CRect<float> & glyphUV );
+
+    // Send the recorded commands to the stream and clear the batch
+    void flush( iRenderCmdStream & stream );
+
+    // Clear out the batch
+    void clear();
+
+    // Is there anything to render
+    bool isEmpty() const;
+
+    // Get the recorded commands
+    const std::vector<CRenderCmd> & getCmdVec() const;
+
+    // Get the vertex stream
+    const std::vector<CBatchVertex2D> & getVertVec() const;
+
+    // Get the number of quads and draws recorded
+    size_t getQuadCount() const;
+    size_t getDrawCount() const;
+
+private:
+
+    // Add a transformed vertex to the stream
+    void addVert( const CVertex2D & vert, const CMatrix & matrix, const CColor & color );
+
+    // Make sure there is an open draw command for the next quad
+    void openDraw();
+
+private:
+
+    // Vertex stream for the frame
+    std::vector<CBatchVertex2D> m_vertVec;
+
+    // Recorded commands
+    std::vector<CRenderCmd> m_cmdVec;
+
+    // View matrices referenced by the commands
+    std::vector<CMatrix> m_matrixVec;
+
+    // Current state - We DON'T own this pointer, don't free
+    CShaderData * m_pShaderData;
+    uint32_t m_textureID;
+
+    // Index of the draw command being added to. -1 if none
+    int m_drawIndex;
+
+    // Number of draw commands
+    size_t m_drawCount;
+};
+
+#endif  // __sprite_batch_2d_h__
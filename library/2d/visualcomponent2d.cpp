@@ -21,6 +21,8 @@
 #include <managers/texturemanager.h>
 #include <managers/vertexbuffermanager.h>
 #include <managers/fontmanager.h>
+#include <2d/fontlayout.h>
+#include <managers/spritebatchmanager.h>
 #include <common/quad2d.h>
 #include <common/shaderdata.h>
 #include <common/fontdata.h>
@@ -31,6 +33,7 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/statcounter.h>
 #include <utilities/deletefuncs.h>
+#include <system/renderdevice.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -43,6 +46,7 @@
 ************************************************************************/
 CVisualComponent2D::CVisualComponent2D( const CObjectVisualData2D & visualData ) :
     m_pShaderData(nullptr),
+    m_pBatchShaderData(nullptr),
     m_vbo( visualData.getVBO() ),
     m_ibo( visualData.getIBO() ),
     m_textureID( visualData.getTextureID() ),
@@ -60,7 +64,8 @@ CVisualComponent2D::CVisualComponent2D( const CObjectVisualData2D & visualData )
     m_drawMode( (visualData.getGenerationType() == NDefs::EGT_QUAD || visualData.getGenerationType() == NDefs::EGT_SPRITE_SHEET) ? GL_TRIANGLE_FAN : GL_TRIANGLES ),
     m_indiceType( (visualData.getGenerationType() == NDefs::EGT_FONT) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE ),
     m_frameIndex(0),
-    m_pFontData(nullptr)
+    m_pFontData(nullptr),
+    m_vboQuadCapacity(0)
 {
     if( visualData.isActive() )
     {
@@ -85,12 +90,24 @@ CVisualComponent2D::CVisualComponent2D( const CObjectVisualData2D & visualData )
 
             m_glyphUV = visualData.getSpriteSheet().getGlyph().getUV();
             m_frameIndex = visualData.getSpriteSheet().getDefaultIndex();
+
+            // The atlas frames can be on different pages
+            if( visualData.isAtlas() )
+                m_textureID = visualData.getTextureID( m_frameIndex );
         }
 
         // Allocate the storage for the font if this is a font sprite
         // Using a normal pointer to keep the memory foot print as small as possible
         if( GENERATION_TYPE == NDefs::EGT_FONT )
             m_pFontData = new CFontData;
+
+        // Textured quads, sprite sheets and fonts can be batched if the shader has a batch version
+        if( !m_pShaderData->getBatchShaderID().empty() &&
+            (((m_textureID > 0) && ((GENERATION_TYPE == NDefs::EGT_QUAD) || (GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET))) ||
+             (GENERATION_TYPE == NDefs::EGT_FONT)) )
+        {
+            m_pBatchShaderData = &CShaderMgr::Instance().getShaderData( m_pShaderData->getBatchShaderID() );
+        }
     }
 }
 
@@ -123,8 +140,9 @@ void CVisualComponent2D::deleteFontVBO()
     // Delete the VBO if this is a font
     if( (GENERATION_TYPE == NDefs::EGT_FONT) && (m_vbo > 0) )
     {
-        glDeleteBuffers(1, &m_vbo);
+        CRenderDevice::Instance().deleteBuffer( m_vbo );
         m_vbo = 0;
+        m_vboQuadCapacity = 0;
     }
 
     // The IBO for the font is managed by the vertex buffer manager.
@@ -145,6 +163,16 @@ void CVisualComponent2D::render( const CMatrix & objMatrix, const CMatrix & matr
         // Increment our stat counter to keep track of what is going on.
         CStatCounter::Instance().incDisplayCounter();
 
+        // Add to the batch if one is being collected
+        if( (m_pBatchShaderData != nullptr) && CSpriteBatchMgr::Instance().isActive() )
+        {
+            batch( objMatrix, matrix );
+            return;
+        }
+
+        // Render anything batched before this so the order is kept
+        CSpriteBatchMgr::Instance().flush();
+
         // Bind the VBO and IBO
         CVertBufMgr::Instance().bind( m_vbo, m_ibo );
 
@@ -152,7 +180,7 @@ void CVisualComponent2D::render( const CMatrix & objMatrix, const CMatrix & matr
         CShaderMgr::Instance().bind( m_pShaderData );
 
         // Setup the vertex attribute shader data
-        glVertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (GLvoid*)0 );
+        CRenderDevice::Instance().vertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, false, VERTEX_BUF_SIZE, 0 );
 
         // Are we rendering with a texture?
         if( m_textureID > 0 )
@@ -161,14 +189,14 @@ void CVisualComponent2D::render( const CMatrix & objMatrix, const CMatrix & matr
 
             // Bind the texture
             CTextureMgr::Instance().bind( m_textureID );
-            glUniform1i( m_text0Location, 0); // 0 = TEXTURE0
+            CRenderDevice::Instance().uniform1i( m_text0Location, 0); // 0 = TEXTURE0
 
             // Setup the UV attribute shade data
-            glVertexAttribPointer( m_uvLocation, 2, GL_FLOAT, GL_FALSE, VERTEX_BUF_SIZE, (GLvoid*)UV_OFFSET );
+            CRenderDevice::Instance().vertexAttribPointer( m_uvLocation, 2, GL_FLOAT, false, VERTEX_BUF_SIZE, UV_OFFSET );
         }
 
         // Send the color to the shader
-        glUniform4fv( m_colorLocation, 1, (float*)&m_color );
+        CRenderDevice::Instance().uniform4fv( m_colorLocation, 1, (float*)&m_color );
 
         // If this is a quad, we need to take into account the vertex scale
         if( GENERATION_TYPE == NDefs::EGT_QUAD )
@@ -180,7 +208,7 @@ void CVisualComponent2D::render( const CMatrix & objMatrix, const CMatrix & matr
             finalMatrix *= matrix;
 
             // Send the final matrix to the shader
-            glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, finalMatrix() );
+            CRenderDevice::Instance().uniformMatrix4fv( m_matrixLocation, 1, false, finalMatrix() );
         }
         // If this is a sprite sheet, we need to take into account the vertex scale and glyph rect
         else if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
@@ -192,10 +220,10 @@ void CVisualComponent2D::render( const CMatrix & objMatrix, const CMatrix & matr
             finalMatrix *= matrix;
 
             // Send the final matrix to the shader
-            glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, finalMatrix() );
+            CRenderDevice::Instance().uniformMatrix4fv( m_matrixLocation, 1, false, finalMatrix() );
 
             // Send the glyph rect
-            glUniform4fv( m_glyphLocation, 1, (float*)&m_glyphUV );
+            CRenderDevice::Instance().uniform4fv( m_glyphLocation, 1, (float*)&m_glyphUV );
         }
         // this is for scaled frame and font rendering
         else
@@ -205,11 +233,44 @@ void CVisualComponent2D::render( const CMatrix & objMatrix, const CMatrix & matr
             finalMatrix *= objMatrix;
             finalMatrix *= matrix;
 
-            glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, finalMatrix() );
+            CRenderDevice::Instance().uniformMatrix4fv( m_matrixLocation, 1, false, finalMatrix() );
         }
 
         // Render it
-        glDrawElements( m_drawMode, m_iboCount, m_indiceType, nullptr );
+        CRenderDevice::Instance().drawElements( m_drawMode, m_iboCount, m_indiceType );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Add to the sprite batch instead of rendering
+*           The object matrix is applied to the verts here so only
+*           the camera matrix is left for the shader
+************************************************************************/
+void CVisualComponent2D::batch( const CMatrix & objMatrix, const CMatrix & matrix )
+{
+    CSpriteBatch2D & rBatch = CSpriteBatchMgr::Instance().getBatch();
+
+    rBatch.setState( m_pBatchShaderData, m_textureID, matrix );
+
+    if( GENERATION_TYPE == NDefs::EGT_FONT )
+    {
+        // Font quads are indexed 0,1,2 0,3,1. Add them in fan order
+        for( auto & iter : m_pFontData->m_quadVec )
+            rBatch.addQuad( iter.vert[0], iter.vert[3], iter.vert[1], iter.vert[2], objMatrix, m_color );
+    }
+    else
+    {
+        CMatrix finalMatrix;
+        finalMatrix.setScale( m_quadVertScale );
+        finalMatrix *= objMatrix;
+
+        const CQuad2D & quad = m_rVisualData.getQuad();
+
+        if( GENERATION_TYPE == NDefs::EGT_SPRITE_SHEET )
+            rBatch.addQuad( quad.vert[0], quad.vert[1], quad.vert[2], quad.vert[3], finalMatrix, m_color, m_glyphUV );
+        else
+            rBatch.addQuad( quad.vert[0], quad.vert[1], quad.vert[2], quad.vert[3], finalMatrix, m_color );
     }
 }
 
@@ -240,7 +301,12 @@ void CVisualComponent2D::setFontData( const CFontData & fontData )
 void CVisualComponent2D::setFontProperties( const CFontProperties & fontProp )
 {
     if(m_pFontData)
+    {
         m_pFontData->m_fontProp.copy( fontProp );
+
+        // The layout no longer matches the properties
+        m_pFontData->m_penVec.clear();
+    }
 }
 
 
@@ -267,233 +333,84 @@ void CVisualComponent2D::createFontString( const std::string & fontString )
         !m_pFontData->m_fontProp.m_fontName.empty() &&
         ((fontString != m_pFontData->m_fontString) || (m_vbo == 0)) )
     {
-        m_pFontData->m_fontStrSize.clear();
-        float lastCharDif(0.f);
-
         const CFont & font = CFontMgr::Instance().getFont( m_pFontData->m_fontProp.m_fontName );
 
         m_textureID = font.getTextureID();
 
-        m_pFontData->m_fontString = fontString;
+        auto & quadVec = m_pFontData->m_quadVec;
+        size_t firstQuad(0), quadCount(0);
 
-        // count up the number of space characters
-        const int spaceCharCount = NGenFunc::CountStrOccurrence( m_pFontData->m_fontString, " " );
+        // Only the changed characters are laid out and sent if the rest stay put
+        if( (m_vbo > 0) && NFontLayout::Update( font, fontString, *m_pFontData, firstQuad, quadCount ) )
+        {
+            if( quadCount > 0 )
+            {
+                CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, m_vbo );
+                CRenderDevice::Instance().bufferSubData( GL_ARRAY_BUFFER, sizeof(CQuad2D) * firstQuad, sizeof(CQuad2D) * quadCount, &quadVec[firstQuad] );
+                CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
+            }
+
+            return;
+        }
 
-        // count up the number of bar | characters
-        const int barCharCount = NGenFunc::CountStrOccurrence( m_pFontData->m_fontString, "|" );
+        NFontLayout::Build( font, fontString, *m_pFontData );
 
         // Size of the allocation
-        int charCount = m_pFontData->m_fontString.size() - spaceCharCount - barCharCount;
+        const uint32_t charCount = quadVec.size();
         m_iboCount = charCount * 6;
 
-        // Set a flag to indicate if the IBO should be built
-        const bool BUILD_FONT_IBO = (m_iboCount > CVertBufMgr::Instance().getCurrentMaxFontIndices());
-
-        // Allocate the quad array
-        std::unique_ptr<CQuad2D[]> upQuadBuf( new CQuad2D[charCount] );
-
         // Create a buffer to hold the indices
         std::unique_ptr<uint16_t[]> upIndxBuf;
 
         // Should we build or rebuild the font IBO
-        if( BUILD_FONT_IBO )
+        if( m_iboCount > CVertBufMgr::Instance().getCurrentMaxFontIndices() )
+        {
             upIndxBuf.reset( new uint16_t[m_iboCount] );
 
-        float xOffset = 0.f;
-        float width = 0.f;
-        float lineHeightOffset = 0.f;
-        float lineHeightWrap = font.getLineHeight() + font.getVertPadding() + m_pFontData->m_fontProp.m_lineWrapHeight;
-        float initialHeightOffset = font.getBaselineOffset() + font.getVertPadding();
-        float lineSpace = font.getLineHeight() - font.getBaselineOffset();
-
-        uint counter = 0;
-        int lineCount = 0;
-
-        // Get the size of the texture
-        CSize<float> textureSize = font.getTextureSize();
+            for( uint32_t i = 0; i < charCount; ++i )
+            {
+                // Create the indices into the VBO
+                int arrayIndex = i * 6;
+                int vertIndex = i * 4;
 
-        // Handle the horizontal alignment
-        std::vector<float> lineWidthOffsetVec = calcLineWidthOffset( font, m_pFontData->m_fontString );
+                upIndxBuf[arrayIndex]   = vertIndex;
+                upIndxBuf[arrayIndex+1] = vertIndex+1;
+                upIndxBuf[arrayIndex+2] = vertIndex+2;
 
-        // Set the initial line offset
-        xOffset = lineWidthOffsetVec[lineCount++];
+                upIndxBuf[arrayIndex+3] = vertIndex;
+                upIndxBuf[arrayIndex+4] = vertIndex+3;
+                upIndxBuf[arrayIndex+5] = vertIndex+1;
+            }
+        }
 
-        // Handle the vertical alignment
-        if( m_pFontData->m_fontProp.m_vAlign == NDefs::EVA_VERT_TOP )
-            lineHeightOffset = -initialHeightOffset;
+        // All fonts share the same IBO because it's always the same and the only difference is it's length
+        // This updates the current IBO if it exceeds the current max
+        m_ibo = CVertBufMgr::Instance().createDynamicFontIBO( CFontMgr::Instance().getGroup(), "dynamic_font_ibo", upIndxBuf.get(), m_iboCount );
 
-        if( m_pFontData->m_fontProp.m_vAlign == NDefs::EVA_VERT_CENTER )
+        // Save the data
+        // If one doesn't exist, create the VBO for this font
+        if( m_vbo == 0 )
         {
-            lineHeightOffset = -(initialHeightOffset - ((font.getBaselineOffset()-lineSpace) / 2.f) - font.getVertPadding());
-
-            if( lineWidthOffsetVec.size() > 1 )
-                lineHeightOffset = ((lineHeightWrap * lineWidthOffsetVec.size()) / 2.f) - font.getBaselineOffset();
+            m_vbo = CRenderDevice::Instance().genBuffer();
+            m_vboQuadCapacity = 0;
         }
 
-        else if( m_pFontData->m_fontProp.m_vAlign == NDefs::EVA_VERT_BOTTOM )
-        {
-            lineHeightOffset = -(initialHeightOffset - font.getBaselineOffset() - font.getVertPadding());
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, m_vbo );
 
-            if( lineWidthOffsetVec.size() > 1 )
-                lineHeightOffset += (lineHeightWrap * (lineWidthOffsetVec.size()-1));
+        // Reuse the buffer if the string fits. Orphan the old storage so
+        // the driver doesn't wait on a draw that is still using it
+        if( (charCount <= m_vboQuadCapacity) && (m_vboQuadCapacity > 0) )
+        {
+            CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, sizeof(CQuad2D) * m_vboQuadCapacity, nullptr, GL_DYNAMIC_DRAW );
+            CRenderDevice::Instance().bufferSubData( GL_ARRAY_BUFFER, 0, sizeof(CQuad2D) * charCount, quadVec.data() );
         }
-
-        // Remove any fractional component of the line height offset
-        lineHeightOffset = (int)lineHeightOffset;
-
-        // Setup each character in the vertex buffer
-        for( size_t i = 0; i < m_pFontData->m_fontString.size(); ++i )
+        else
         {
-            char id = m_pFontData->m_fontString[i];
-
-            // Line wrap if '|' character was used
-            if( id == '|' )
-            {
-                xOffset = lineWidthOffsetVec[lineCount];
-                width = 0.f;
-
-                lineHeightOffset += -lineHeightWrap;
-                ++lineCount;
-            }
-            else
-            {
-                // See if we can find the character
-                const CCharData & charData = font.getCharData(id);
-
-                // Ignore space characters
-                if( id != ' ' )
-                {
-                    CRect<float> rect = charData.rect;
-
-                    float yOffset = (font.getLineHeight() - rect.y2 - charData.offset.h) + lineHeightOffset;
-
-                    // Check if the width or height is odd. If so, we offset
-                    // by 0.5 for proper orthographic rendering
-                    float additionalOffsetX = 0;
-                    if( (int)rect.x2 % 2 != 0 )
-                        additionalOffsetX = 0.5f;
-
-                    float additionalOffsetY = 0;
-                    if( (int)rect.y2 % 2 != 0 )
-                        additionalOffsetY = 0.5f;
-
-                    auto & quadBuf = upQuadBuf[counter];
-
-                    // Calculate the first vertex of the first face
-                    quadBuf.vert[0].vert.x = xOffset + charData.offset.w + additionalOffsetX;
-                    quadBuf.vert[0].vert.y = yOffset + additionalOffsetY;
-                    quadBuf.vert[0].uv.u = rect.x1 / textureSize.w;
-                    quadBuf.vert[0].uv.v = (rect.y1 + rect.y2) / textureSize.h;
-
-                    // Calculate the second vertex of the first face
-                    quadBuf.vert[1].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
-                    quadBuf.vert[1].vert.y = yOffset + rect.y2 + additionalOffsetY;
-                    quadBuf.vert[1].uv.u = (rect.x1 + rect.x2) / textureSize.w;
-                    quadBuf.vert[1].uv.v = rect.y1 / textureSize.h;
-
-                    // Calculate the third vertex of the first face
-                    quadBuf.vert[2].vert.x = quadBuf.vert[0].vert.x;
-                    quadBuf.vert[2].vert.y = quadBuf.vert[1].vert.y;
-                    quadBuf.vert[2].uv.u = quadBuf.vert[0].uv.u;
-                    quadBuf.vert[2].uv.v = quadBuf.vert[1].uv.v;
-
-                    // Calculate the second vertex of the second face
-                    quadBuf.vert[3].vert.x = quadBuf.vert[1].vert.x;
-                    quadBuf.vert[3].vert.y = quadBuf.vert[0].vert.y;
-                    quadBuf.vert[3].uv.u = quadBuf.vert[1].uv.u;
-                    quadBuf.vert[3].uv.v = quadBuf.vert[0].uv.v;
-
-                    // Should we build or rebuild the font IBO
-                    if( BUILD_FONT_IBO )
-                    {
-                        // Create the indices into the VBO
-                        int arrayIndex = counter * 6;
-                        int vertIndex = counter * 4;
-
-                        upIndxBuf[arrayIndex]   = vertIndex;
-                        upIndxBuf[arrayIndex+1] = vertIndex+1;
-                        upIndxBuf[arrayIndex+2] = vertIndex+2;
-
-                        upIndxBuf[arrayIndex+3] = vertIndex;
-                        upIndxBuf[arrayIndex+4] = vertIndex+3;
-                        upIndxBuf[arrayIndex+5] = vertIndex+1;
-                    }
-
-                    ++counter;
-                }
-
-                // Inc the font position
-                float inc = charData.xAdvance + m_pFontData->m_fontProp.m_kerning + font.getHorzPadding();
-
-                // Add in any additional spacing for the space character
-                if( id == ' ' )
-                    inc += m_pFontData->m_fontProp.m_spaceCharKerning;
-
-                width += inc;
-                xOffset += inc;
-
-                // Get the longest width of this font string
-                if( m_pFontData->m_fontStrSize.w < width )
-                {
-                    m_pFontData->m_fontStrSize.w = width;
-
-                    // This is the space between this character and the next.
-                    // Save this difference so that it can be subtracted at the end
-                    lastCharDif = inc - charData.rect.x2;
-                }
-
-                // Wrap to another line
-                if( (id == ' ') && (m_pFontData->m_fontProp.m_lineWrapWidth > 0.f) )
-                {
-                    float nextWord = 0.f;
-
-                    // Get the length of the next word to see if if should wrap
-                    for( size_t j = i+1; j < m_pFontData->m_fontString.size(); ++j )
-                    {
-                        id = m_pFontData->m_fontString[j];
-
-                        if( id != '|' )
-                        {
-                            // See if we can find the character
-                            const CCharData & anotherCharData = font.getCharData(id);
-
-                            // Break here when space is found
-                            // Don't add the space to the size of the next word
-                            if( id == ' ' )
-                                break;
-
-                            // Don't count the
-                            nextWord += anotherCharData.xAdvance + m_pFontData->m_fontProp.m_kerning + font.getHorzPadding();
-                        }
-                    }
-
-                    if( width + nextWord >= m_pFontData->m_fontProp.m_lineWrapWidth )
-                    {
-                        xOffset = lineWidthOffsetVec[lineCount++];
-                        width = 0.f;
-
-                        lineHeightOffset += -lineHeightWrap;
-                    }
-                }
-            }
+            CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, sizeof(CQuad2D) * charCount, quadVec.data(), GL_DYNAMIC_DRAW );
+            m_vboQuadCapacity = charCount;
         }
 
-        // Subtract the extra space after the last character
-        m_pFontData->m_fontStrSize.w -= lastCharDif;
-        m_pFontData->m_fontStrSize.h = font.getLineHeight();
-
-        // Save the data
-        // If one doesn't exist, create the VBO and IBO for this font
-        if( m_vbo == 0 )
-            glGenBuffers( 1, &m_vbo );
-
-        glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CQuad2D) * charCount, upQuadBuf.get(), GL_STATIC_DRAW );
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
-
-        // All fonts share the same IBO because it's always the same and the only difference is it's length
-        // This updates the current IBO if it exceeds the current max
-        m_ibo = CVertBufMgr::Instance().createDynamicFontIBO( CFontMgr::Instance().getGroup(), "dynamic_font_ibo", upIndxBuf.get(), m_iboCount );
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
     }
     else if( m_pFontData &&
              fontString.empty() &&
@@ -505,123 +422,6 @@ void CVisualComponent2D::createFontString( const std::string & fontString )
 }
 
 
-/************************************************************************
-*    DESC:  Add up all the character widths
-************************************************************************/
-std::vector<float> CVisualComponent2D::calcLineWidthOffset(
-    const CFont & font,
-    const std::string & str )
-{
-    float firstCharOffset = 0;
-    float lastCharOffset = 0;
-    float spaceWidth = 0;
-    float width = 0;
-    int counter = 0;
-    std::vector<float> lineWidthOffsetVec;
-
-    for( size_t i = 0; i < str.size(); ++i )
-    {
-        char id = str[i];
-
-        // Line wrap if '|' character was used
-        if( id == '|' )
-        {
-            // Add the line width to the vector based on horz alignment
-            addLineWithToVec( font, lineWidthOffsetVec, m_pFontData->m_fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
-
-            counter = 0;
-            width = 0;
-        }
-        else
-        {
-            // Get the next character
-            const CCharData & charData = font.getCharData( id );
-
-            if(counter == 0)
-                firstCharOffset = charData.offset.w;
-
-            spaceWidth = charData.xAdvance + m_pFontData->m_fontProp.m_kerning + font.getHorzPadding();
-
-            // Add in any additional spacing for the space character
-            if( id == ' ' )
-                spaceWidth += m_pFontData->m_fontProp.m_spaceCharKerning;
-
-            width += spaceWidth;
-
-            if( id != ' ')
-                lastCharOffset = charData.offset.w;
-
-            ++counter;
-        }
-
-        // Wrap to another line
-        if( (id == ' ') && (m_pFontData->m_fontProp.m_lineWrapWidth > 0.f) )
-        {
-            float nextWord = 0.f;
-
-            // Get the length of the next word to see if if should wrap
-            for( size_t j = i+1; j < str.size(); ++j )
-            {
-                id = str[j];
-
-                if( id != '|' )
-                {
-                    // See if we can find the character
-                    const CCharData & charData = font.getCharData(id);
-
-                    // Break here when space is found
-                    // Don't add the space to the size of the next word
-                    if( id == ' ' )
-                        break;
-
-                    // Don't count the
-                    nextWord += charData.xAdvance + m_pFontData->m_fontProp.m_kerning + font.getHorzPadding();
-                }
-            }
-
-            if( width + nextWord >= m_pFontData->m_fontProp.m_lineWrapWidth )
-            {
-                // Add the line width to the vector based on horz alignment
-                addLineWithToVec( font, lineWidthOffsetVec, m_pFontData->m_fontProp.m_hAlign, width-spaceWidth, firstCharOffset, lastCharOffset );
-
-                counter = 0;
-                width = 0;
-            }
-        }
-    }
-
-    // Add the line width to the vector based on horz alignment
-    addLineWithToVec( font, lineWidthOffsetVec, m_pFontData->m_fontProp.m_hAlign, width, firstCharOffset, lastCharOffset );
-
-    return lineWidthOffsetVec;
-}
-
-
-/************************************************************************
-*    DESC:  Add the line width to the vector based on horz alignment
-************************************************************************/
-void CVisualComponent2D::addLineWithToVec(
-    const CFont & font,
-    std::vector<float> & lineWidthOffsetVec,
-    const NDefs::EHorzAlignment hAlign,
-    float width,
-    float firstCharOffset,
-    float lastCharOffset )
-{
-    if( hAlign == NDefs::EHA_HORZ_LEFT )
-        lineWidthOffsetVec.push_back(-(firstCharOffset + font.getHorzPadding()));
-
-    else if( hAlign == NDefs::EHA_HORZ_CENTER )
-        lineWidthOffsetVec.push_back(-((width - font.getHorzPadding()) / 2.f));
-
-    else if( hAlign == NDefs::EHA_HORZ_RIGHT )
-        lineWidthOffsetVec.push_back(-(width - lastCharOffset - font.getHorzPadding()));
-
-    // Remove any fractional component of the last index
-    lineWidthOffsetVec.back() = (int)lineWidthOffsetVec.back();
-}
-
-
 /************************************************************************
 *    DESC:  Get/Set the displayed font string
 ************************************************************************/
@@ -640,7 +440,12 @@ const std::string & CVisualComponent2D::getFontString()
 void CVisualComponent2D::setFontString( const std::string & fontString )
 {
     if(m_pFontData)
+    {
         m_pFontData->m_fontString = fontString;
+
+        // The layout no longer matches the string
+        m_pFontData->m_penVec.clear();
+    }
 }
 
 
@@ -722,6 +527,9 @@ void CVisualComponent2D::setFrame( uint index )
         auto rGlyph = m_rVisualData.getSpriteSheet().getGlyph( index );
         m_glyphUV = rGlyph.getUV();
         m_quadVertScale = rGlyph.getSize() * m_rVisualData.getDefaultUniformScale();
+
+        if( m_rVisualData.isAtlas() )
+            m_textureID = m_rVisualData.getTextureID( index );
     }
     else
         m_textureID = m_rVisualData.getTextureID( index );
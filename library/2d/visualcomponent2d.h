@@ -29,7 +29,6 @@
 
 // Forward declaration(s)
 class CObjectVisualData2D;
-class CFont;
 class CShaderData;
 class CFontData;
 class CFontProperties;
@@ -96,28 +95,21 @@ public:
 
 private:
 
-    // Add the line width to the vector based on horz alignment
-    void addLineWithToVec(
-        const CFont & font,
-        std::vector<float> & lineWidthOffsetVec,
-        const NDefs::EHorzAlignment hAlign,
-        float width,
-        float firstCharOffset,
-        float lastCharOffset );
-
-    // Add up all the character widths
-    std::vector<float> calcLineWidthOffset(
-        const CFont & font,
-        const std::string & str);
-    
     // Is rendering allowed?
     bool allowRender();
 
+    // Add to the sprite batch instead of rendering
+    void batch( const CMatrix & objMatrix, const CMatrix & matrix );
+
 private:
     
     // Shader data pointer - We DON'T own this pointer, don't free
     CShaderData * m_pShaderData;
 
+    // Shader used when batched. nullptr if this can't be batched
+    // We DON'T own this pointer, don't free
+    CShaderData * m_pBatchShaderData;
+
     // VBO
     uint32_t m_vbo;
 
@@ -168,6 +160,9 @@ private:
 
     // Unique pointer for font data
     CFontData * m_pFontData;
+
+    // Number of quads the font VBO has room for
+    uint32_t m_vboQuadCapacity;
     
 };
 
@@ -55,6 +55,16 @@ void CObject3D::applyRotation( CMatrix & matrix )
 }
 
 
+/************************************************************************
+*    DESC:  Can the matrix be made in the batched pass
+*           The 3D rotation is kept in its own matrix so it's never batched
+************************************************************************/
+bool CObject3D::allowBatchTransform() const
+{
+    return false;
+}
+
+
 /************************************************************************
 *    DESC:  Get the object's rotation matrix
 ************************************************************************/
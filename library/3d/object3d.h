@@ -32,6 +32,9 @@ protected:
     
     // Apply the rotation
     virtual void applyRotation( CMatrix & matrix ) override;
+
+    // Can the matrix be made in the batched pass
+    virtual bool allowBatchTransform() const override;
     
 protected:
 
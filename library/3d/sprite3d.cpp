@@ -107,6 +107,31 @@ void CSprite3D::update()
 }
 
 
+/************************************************************************
+ *    DESC:  Update the script part of the sprite
+ ************************************************************************/
+void CSprite3D::scriptUpdate()
+{
+    m_scriptComponent.serialUpdate();
+}
+
+
+/************************************************************************
+ *    DESC:  Update the part of the sprite that doesn't use a script context
+ *           or only the contexts of the parallel script groups
+ ************************************************************************/
+void CSprite3D::parallelUpdate()
+{
+    if( isVisible() )
+        m_physicsComponent.update( this );
+
+    m_scriptComponent.parallelUpdate();
+
+    if( m_upAI )
+        m_upAI->update();
+}
+
+
 /************************************************************************
 *    DESC:  Update the physics
 ************************************************************************/
@@ -59,6 +59,8 @@ public:
 
     // Update the sprite 
     void update() override;
+    void scriptUpdate() override;
+    void parallelUpdate() override;
     
     // Update the physics
     void physicsUpdate() override;
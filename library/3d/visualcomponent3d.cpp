@@ -20,6 +20,7 @@
 #include <managers/shadermanager.h>
 #include <managers/vertexbuffermanager.h>
 #include <managers/texturemanager.h>
+#include <managers/spritebatchmanager.h>
 #include <common/vertex3d.h>
 #include <common/shaderdata.h>
 #include <system/device.h>
@@ -28,6 +29,7 @@
 #include <utilities/genfunc.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/statcounter.h>
+#include <system/renderdevice.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -83,6 +85,9 @@ CVisualComponent3D::~CVisualComponent3D()
 ************************************************************************/
 void CVisualComponent3D::render( const CMatrix & matrix, const CMatrix & normalMatrix )
 {
+    // Render any batched 2D sprites before this so the order is kept
+    CSpriteBatchMgr::Instance().flush();
+
     for( auto & meshIter : m_mesh3d.getMeshVec() )
     {
         // Increment our stat counter to keep track of what is going on.
@@ -95,10 +100,10 @@ void CVisualComponent3D::render( const CMatrix & matrix, const CMatrix & normalM
         CShaderMgr::Instance().bind( m_pShaderData );
 
         // Setup the vertex attribute shader data
-        glVertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, GL_FALSE, m_VERTEX_BUF_SIZE, (GLvoid*)0 );
+        CRenderDevice::Instance().vertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, false, m_VERTEX_BUF_SIZE, 0 );
 
         // Setup the normal attribute shade data
-        glVertexAttribPointer( m_normalLocation, 3, GL_FLOAT, GL_FALSE, m_VERTEX_BUF_SIZE, (GLvoid*)12 );
+        CRenderDevice::Instance().vertexAttribPointer( m_normalLocation, 3, GL_FLOAT, false, m_VERTEX_BUF_SIZE, 12 );
 
         // Enable the UV attribute shade data
         if( m_uvLocation > -1 )
@@ -107,21 +112,21 @@ void CVisualComponent3D::render( const CMatrix & matrix, const CMatrix & normalM
             for( auto & txtIter : meshIter.m_textureVec )
             {
                 CTextureMgr::Instance().bind( txtIter.m_id );
-                glUniform1i( m_text0Location, (int)txtIter.m_type); // 0 = TEXTURE0
+                CRenderDevice::Instance().uniform1i( m_text0Location, (int)txtIter.m_type); // 0 = TEXTURE0
             }
 
             // Setup the uv attribute shade data
-            glVertexAttribPointer( m_uvLocation, 2, GL_FLOAT, GL_FALSE, m_VERTEX_BUF_SIZE, (GLvoid*)24 );
+            CRenderDevice::Instance().vertexAttribPointer( m_uvLocation, 2, GL_FLOAT, false, m_VERTEX_BUF_SIZE, 24 );
         }
 
         // Send the color to the shader
-        glUniform4fv( m_colorLocation, 1, (float*)&m_color );
+        CRenderDevice::Instance().uniform4fv( m_colorLocation, 1, (float*)&m_color );
 
-        glUniformMatrix4fv( m_matrixLocation, 1, GL_FALSE, matrix() );
-        glUniformMatrix4fv( m_normalMatrixLocation, 1, GL_FALSE, normalMatrix() );
+        CRenderDevice::Instance().uniformMatrix4fv( m_matrixLocation, 1, false, matrix() );
+        CRenderDevice::Instance().uniformMatrix4fv( m_normalMatrixLocation, 1, false, normalMatrix() );
 
         // Render it
-        glDrawElements( GL_TRIANGLES, meshIter.m_iboCount, GL_UNSIGNED_SHORT, nullptr );
+        CRenderDevice::Instance().drawElements( GL_TRIANGLES, meshIter.m_iboCount, GL_UNSIGNED_SHORT );
     }
 }
 
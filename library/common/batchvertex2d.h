@@ -0,0 +1,32 @@
+/************************************************************************
+*    FILE NAME:       batchvertex2d.h
+*
+*    DESCRIPTION:     2D vertex class used by the sprite batch.
+*                     The position is already transformed and the
+*                     color is per vertex so many sprites can share
+*                     one draw call.
+************************************************************************/  
+
+#ifndef __batch_vertex_2d_h__
+#define __batch_vertex_2d_h__
+
+// Game lib dependencies
+#include <common/point.h>
+#include <common/uv.h>
+#include <common/color.h>
+
+class CBatchVertex2D
+{
+public:
+
+    // Verts
+    CPoint<float> vert;
+
+    // uv
+    CUV uv;
+
+    // color
+    CColor color;
+};
+
+#endif  // __batch_vertex_2d_h__
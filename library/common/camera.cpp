@@ -175,11 +175,10 @@ void CCamera::incPos( CWorldValue x, CWorldValue y, CWorldValue z )
 ************************************************************************/
 void CCamera::transform()
 {
-    const bool wasTransformed( m_parameters.isSet( NDefs::TRANSFORM ) );
-    
     CObject3D::transform();
     
-    if( wasTransformed )
+    // Also transformed when interpolating between fixed steps
+    if( wasWorldPosTranformed() )
         calcFinalMatrix();
 }
 
@@ -202,3 +201,12 @@ const CMatrix & CCamera::getFinalMatrix() const
 {
     return m_finalMatrix;
 }
+
+
+/************************************************************************
+*    DESC:  Get the projection type
+************************************************************************/  
+NDefs::EProjectionType CCamera::getProjectionType() const
+{
+    return m_projType;
+}
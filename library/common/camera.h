@@ -60,6 +60,9 @@ public:
     
     // Get the final matrix
     const CMatrix & getFinalMatrix() const;
+    
+    // Get the projection type
+    NDefs::EProjectionType getProjectionType() const;
   
 private:
     
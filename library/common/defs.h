@@ -67,6 +67,14 @@ namespace NDefs
         EGT_FONT
     };
 
+    enum ERenderCmd
+    {
+        ERC_BIND_SHADER,
+        ERC_BIND_TEXTURE,
+        ERC_SET_MATRIX,
+        ERC_DRAW_QUADS
+    };
+
     enum
     {
         // No parameters
@@ -91,6 +99,16 @@ namespace NDefs
         
         // Script update flag
         SCRIPT_UPDATE       = 0x200,
+
+        // Fixed step interpolation. The previous transform was saved
+        // and the last matrix was made between the last two steps
+        INTERPOLATE         = 0x400,
+        INTERPOLATED        = 0x800,
+
+        // The matrix is made in the batched pass of the transform store
+        // and the pass made it this frame
+        BATCH_TRANSFORM     = 0x1000,
+        BATCH_TRANSFORMED   = 0x2000,
     };
     
     enum EObjectType
@@ -153,6 +171,28 @@ namespace NDefs
         EM_VERTICAL,
         EM_HORIZONTAL_VERTICAL
     };
+    
+    enum EReplayMode
+    {
+        ERM_OFF = 0,
+        ERM_RECORD,
+        ERM_PLAY
+    };
+    
+    enum ERenderDevice
+    {
+        ERD_OPENGL = 0,
+        ERD_NULL
+    };
+    
+    // Share of the script frame budget. UI scripts get all of it, AI scripts
+    // leave the last quarter to the UI, background scripts get the first half
+    enum EScriptPriority
+    {
+        ESP_UI = 0,
+        ESP_AI,
+        ESP_BACKGROUND
+    };
 
 }   // NDefs
 
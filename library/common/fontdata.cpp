@@ -19,6 +19,9 @@ void CFontData::copy( const CFontData & obj )
     m_fontString = obj.m_fontString;
     m_fontStrSize = obj.m_fontStrSize;
     m_fontProp.copy( obj.m_fontProp );
+
+    // The layout no longer matches the properties
+    m_penVec.clear();
 }
 
 
@@ -35,5 +38,8 @@ void CFontData::loadFromNode( const XMLNode & node )
             m_fontString = fontNode.getAttribute( "fontString" );
 
         m_fontProp.loadFromNode( fontNode );
+
+        // The layout no longer matches the properties
+        m_penVec.clear();
     }
 }
@@ -10,6 +10,12 @@
 // Game lib dependencies
 #include <common/fontproperties.h>
 #include <common/size.h>
+#include <common/quad2d.h>
+#include <common/point.h>
+
+// Standard lib dependencies
+#include <vector>
+#include <string>
 
 // Forward Declarations
 struct XMLNode;
@@ -35,6 +41,25 @@ public:
     // Font string size
     // Not use full for multi-line strings
     CSize<float> m_fontStrSize;
+
+    // Copy of the character quads in the VBO for the sprite batch
+    // Not copied. It's rebuilt with the font string
+    std::vector<CQuad2D> m_quadVec;
+
+    // Layout of the font string. Not copied. It's rebuilt with the font string
+    // Cleared when the properties change so the next string is fully laid out
+
+    // Offset of the start of each line
+    std::vector<float> m_lineWidthOffsetVec;
+
+    // Pen position of each quad so a changed character can be laid out in place
+    std::vector<CPoint<float>> m_penVec;
+
+    // Width of the widest line before the space after the last character is removed
+    float m_widestLineWidth = 0;
+
+    // Index of the character that ended the widest line
+    size_t m_widestCharIndex = std::string::npos;
 };
 
 #endif  // __font_data_h__
\ No newline at end of file
@@ -0,0 +1,47 @@
+/************************************************************************
+*    FILE NAME:       irendercmdstream.h
+*
+*    DESCRIPTION:     iRenderCmdStream Class
+*                     Receives the commands recorded by the sprite batch.
+*                     The sprite batch manager executes them with OpenGL.
+*                     Anything else can implement it to check the batch
+*                     without a GPU.
+************************************************************************/
+
+#ifndef __i_render_cmd_stream_h__
+#define __i_render_cmd_stream_h__
+
+// Standard lib dependencies
+#include <cstddef>
+#include <cstdint>
+
+// Forward declaration(s)
+class CShaderData;
+class CMatrix;
+class CBatchVertex2D;
+
+class iRenderCmdStream
+{
+public:
+
+    // Upload the vertices for all the commands that follow
+    virtual void upload( const CBatchVertex2D * pVert, size_t vertCount ) = 0;
+
+    // Bind the shader
+    virtual void bindShader( CShaderData * pShaderData ) = 0;
+
+    // Bind the texture
+    virtual void bindTexture( uint32_t textureID ) = 0;
+
+    // Set the view projection matrix
+    virtual void setMatrix( const CMatrix & matrix ) = 0;
+
+    // Draw a range of quads from the uploaded vertices
+    virtual void drawQuads( uint32_t first, uint32_t count ) = 0;
+
+protected:
+
+    virtual ~iRenderCmdStream(){}
+};
+
+#endif  // __i_render_cmd_stream_h__
@@ -42,6 +42,20 @@ public:
     // Update the sprite 
     virtual void update() = 0;
     
+    // Update split in two for the parallel sprite update
+    // The script part is run on the main thread except for the scripts of
+    // the parallel groups. Sprites that don't split their update do all the work here
+    // NOTE: The script part of every sprite runs before the rest so a sprite's scripts
+    //       run before it's AI, and before the physics of a 3D sprite, where update()
+    //       runs the AI of an actor before the scripts of it's sprites and the physics
+    //       of a 3D sprite first. Keeping that order would take a parallel pass before
+    //       and after the scripts every frame. Only the parallel update has this order
+    virtual void scriptUpdate(){ update(); }
+    
+    // The part that doesn't touch a script context or only the contexts of
+    // the parallel groups. Can be run on a worker thread
+    virtual void parallelUpdate(){}
+    
     // Update the physics 
     virtual void physicsUpdate() = 0;
     
@@ -70,6 +84,15 @@ public:
     
     // Get the current frame
     virtual uint getCurrentFrame() const { return 0; }
+    
+    // Get the radius around the translated position the sprite is drawn in
+    // Less than zero if the size is not known. These sprites are never culled
+    virtual float getRadius() const { return -1.f; }
+    
+    // Get the collision group and the mask of the groups it collides with
+    // Zero if the sprite doesn't collide
+    virtual uint getCollisionGroup() const { return 0; }
+    virtual uint getCollisionMask() const { return 0; }
 
 protected:
     
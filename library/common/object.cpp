@@ -9,24 +9,38 @@
 
 // Game lib dependencies
 #include <utilities/xmlparsehelper.h>
+#include <utilities/fixedstep.h>
 
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CObject::CObject() :
-    m_parameters(NDefs::VISIBLE),
-    m_scale(1,1,1)
+    CObject( CTransformStore::Instance().alloc() )
 {
+    m_parameters.add( NDefs::VISIBLE );
+    m_prevTick = CFixedStep::Instance().getTick();
 }
 
 // Copy constructor
 CObject::CObject( const CObject & obj ) :
-    m_parameters( obj.m_parameters ),
-    m_pos( obj.m_pos ),
-    m_rot( obj.m_rot ),
-    m_scale( obj.m_scale ),
-    m_centerPos( obj.m_centerPos ),
-    m_cropOffset( obj.m_cropOffset )
+    CObject( CTransformStore::Instance().alloc() )
+{
+    *this = obj;
+}
+
+// Bind the transform to its slot in the store
+CObject::CObject( const CTransformSlot & slot ) :
+    m_transSlot( slot ),
+    m_parameters( slot.m_pChunk->m_parameters[slot.m_index] ),
+    m_pos( slot.m_pChunk->m_pos[slot.m_index] ),
+    m_rot( slot.m_pChunk->m_rot[slot.m_index] ),
+    m_scale( slot.m_pChunk->m_scale[slot.m_index] ),
+    m_centerPos( slot.m_pChunk->m_centerPos[slot.m_index] ),
+    m_cropOffset( slot.m_pChunk->m_cropOffset[slot.m_index] ),
+    m_prevPos( slot.m_pChunk->m_prevPos[slot.m_index] ),
+    m_prevRot( slot.m_pChunk->m_prevRot[slot.m_index] ),
+    m_prevScale( slot.m_pChunk->m_prevScale[slot.m_index] ),
+    m_prevTick( slot.m_pChunk->m_prevTick[slot.m_index] )
 {
 }
 
@@ -36,6 +50,30 @@ CObject::CObject( const CObject & obj ) :
 ************************************************************************/
 CObject::~CObject()
 {
+    CTransformStore::Instance().free( m_transSlot );
+}
+
+
+/************************************************************************
+*    DESC:  Copy the transform. The object keeps its own slot in the store
+*           The copy isn't in the batched pass until it's flagged for it
+************************************************************************/
+CObject & CObject::operator = ( const CObject & obj )
+{
+    m_parameters = obj.m_parameters;
+    m_pos = obj.m_pos;
+    m_rot = obj.m_rot;
+    m_scale = obj.m_scale;
+    m_centerPos = obj.m_centerPos;
+    m_cropOffset = obj.m_cropOffset;
+    m_prevPos = obj.m_prevPos;
+    m_prevRot = obj.m_prevRot;
+    m_prevScale = obj.m_prevScale;
+    m_prevTick = obj.m_prevTick;
+
+    m_parameters.remove( NDefs::BATCH_TRANSFORM | NDefs::BATCH_TRANSFORMED );
+
+    return *this;
 }
 
 
@@ -53,6 +91,7 @@ const CPoint<CWorldValue> & CObject::getPos() const
 ************************************************************************/
 void CObject::setPos( const CPoint<CWorldValue> & position )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::TRANSLATE | NDefs::TRANSFORM );
 
     m_pos = position;
@@ -60,6 +99,7 @@ void CObject::setPos( const CPoint<CWorldValue> & position )
 
 void CObject::setPos( const CPoint<float> & position )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::TRANSLATE | NDefs::TRANSFORM );
 
     m_pos = position;
@@ -67,6 +107,7 @@ void CObject::setPos( const CPoint<float> & position )
 
 void CObject::setPos( CWorldValue x, CWorldValue y, CWorldValue z )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::TRANSLATE | NDefs::TRANSFORM );
 
     m_pos.set( x, y, z );
@@ -78,6 +119,7 @@ void CObject::setPos( CWorldValue x, CWorldValue y, CWorldValue z )
 ************************************************************************/
 void CObject::incPos( const CPoint<CWorldValue> & position )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::TRANSLATE | NDefs::TRANSFORM );
 
     m_pos += position;
@@ -85,6 +127,7 @@ void CObject::incPos( const CPoint<CWorldValue> & position )
 
 void CObject::incPos( const CPoint<float> & position )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::TRANSLATE | NDefs::TRANSFORM );
 
     m_pos += position;
@@ -92,6 +135,7 @@ void CObject::incPos( const CPoint<float> & position )
 
 void CObject::incPos( CWorldValue x, CWorldValue y, CWorldValue z )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::TRANSLATE | NDefs::TRANSFORM );
 
     m_pos.inc( x, y, z );
@@ -104,6 +148,7 @@ void CObject::incPos( CWorldValue x, CWorldValue y, CWorldValue z )
 ************************************************************************/
 void CObject::setRot( const CPoint<float> & rotation, bool convertToRadians )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::ROTATE | NDefs::TRANSFORM );
 
     m_rot = rotation;
@@ -116,6 +161,7 @@ void CObject::setRot( const CPoint<float> & rotation, bool convertToRadians )
 
 void CObject::setRot( float x, float y, float z, bool convertToRadians )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::ROTATE | NDefs::TRANSFORM );
     
     if( convertToRadians )
@@ -131,6 +177,7 @@ void CObject::setRot( float x, float y, float z, bool convertToRadians )
 ************************************************************************/
 void CObject::incRot( const CPoint<float> & rotation, bool convertToRadians )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::ROTATE | NDefs::TRANSFORM );
 
     if( convertToRadians )
@@ -143,6 +190,7 @@ void CObject::incRot( const CPoint<float> & rotation, bool convertToRadians )
 
 void CObject::incRot( float x, float y, float z, bool convertToRadians )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::ROTATE | NDefs::TRANSFORM );
     
     if( convertToRadians )
@@ -167,6 +215,7 @@ const CPoint<float> & CObject::getRot() const
 ************************************************************************/
 void CObject::setScale( const CPoint<float> & scale )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::SCALE | NDefs::TRANSFORM );
 
     m_scale = scale;
@@ -174,6 +223,7 @@ void CObject::setScale( const CPoint<float> & scale )
 
 void CObject::setScale( float x, float y, float z )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::SCALE | NDefs::TRANSFORM );
 
     m_scale.set( x, y, z );
@@ -185,6 +235,7 @@ void CObject::setScale( float x, float y, float z )
 ************************************************************************/
 void CObject::incScale( const CPoint<float> & scale )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::SCALE | NDefs::TRANSFORM );
 
     m_scale += scale;
@@ -192,6 +243,7 @@ void CObject::incScale( const CPoint<float> & scale )
 
 void CObject::incScale( float x, float y, float z )
 {
+    savePrevTransform();
     m_parameters.add( NDefs::SCALE | NDefs::TRANSFORM );
 
     m_scale.inc( x, y, z );
@@ -316,3 +368,39 @@ void CObject::loadTransFromNode( const XMLNode & node )
     if( loadedFlag )
         setCenterPos( centerPos );
 }
+
+
+/************************************************************************
+*    DESC:  Save the transform before it's changed in a new fixed step
+*           Only the first change of a step saves so the saved transform
+*           is the one at the start of the step. An object made in the
+*           step has nothing to save and isn't interpolated until the
+*           next step it's changed in
+************************************************************************/
+void CObject::savePrevTransform()
+{
+    const uint32_t tick = CFixedStep::Instance().getTick();
+
+    if( m_prevTick != tick )
+    {
+        m_prevTick = tick;
+        m_prevPos = m_pos;
+        m_prevRot = m_rot;
+        m_prevScale = m_scale;
+
+        m_parameters.add( NDefs::INTERPOLATE );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the alpha to interpolate the transform by
+*           Only an object changed in the last step is interpolated
+************************************************************************/
+float CObject::getInterpAlpha() const
+{
+    if( m_parameters.isSet( NDefs::INTERPOLATE ) && (m_prevTick == CFixedStep::Instance().getTick()) )
+        return CFixedStep::Instance().getAlpha();
+
+    return 1.f;
+}
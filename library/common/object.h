@@ -11,6 +11,7 @@
 #include <common/size.h>
 #include <common/point.h>
 #include <common/worldvalue.h>
+#include <common/transformstore.h>
 #include <utilities/bitmask.h>
 
 // Standard lib dependencies
@@ -27,6 +28,9 @@ public:
     CObject( const CObject & obj );
     virtual ~CObject();
 
+    // Copy the transform. The object keeps its own slot in the store
+    CObject & operator = ( const CObject & obj );
+
     // Load the transform data from node
     void loadTransFromNode( const XMLNode & node );
 
@@ -81,25 +85,45 @@ public:
     void copyTransform( const CObject * pObject );
 
 protected:
+
+    // Bind the transform to its slot in the store
+    CObject( const CTransformSlot & slot );
+
+    // Save the transform before it's changed in a new fixed step
+    void savePrevTransform();
+
+    // Get the alpha to interpolate the transform by. 1 if not interpolating
+    float getInterpAlpha() const;
+
+protected:
+
+    // Slot of the transform in the store. The members below refer into it
+    const CTransformSlot m_transSlot;
     
     // Bitmask settings to record if the object needs to be transformed
-    CBitmask<int16_t> m_parameters;
+    CBitmask<int16_t> & m_parameters;
 
     // Local position
-    CPoint<CWorldValue> m_pos;
+    CPoint<CWorldValue> & m_pos;
 
     // Local Rotation stored in radians
-    CPoint<float> m_rot;
+    CPoint<float> & m_rot;
 
     // Local scale
-    CPoint<float> m_scale;
+    CPoint<float> & m_scale;
     
     // The center point. Point of rotation
     // This is used for defining a different center point
-    CPoint<float> m_centerPos;
+    CPoint<float> & m_centerPos;
     
     // Offset due to a sprite sheet crop.
-    CSize<int16_t> m_cropOffset;
+    CSize<int16_t> & m_cropOffset;
+
+    // Transform at the start of the fixed step it was last changed in
+    CPoint<CWorldValue> & m_prevPos;
+    CPoint<float> & m_prevRot;
+    CPoint<float> & m_prevScale;
+    uint32_t & m_prevTick;
 };
 
 #endif  // __object_h__
@@ -0,0 +1,44 @@
+/************************************************************************
+*    FILE NAME:       rendercmd.h
+*
+*    DESCRIPTION:     A recorded render command
+************************************************************************/  
+
+#ifndef __render_cmd_h__
+#define __render_cmd_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+
+// Standard lib dependencies
+#include <cstdint>
+
+// Forward declaration(s)
+class CShaderData;
+
+class CRenderCmd
+{
+public:
+
+    CRenderCmd( NDefs::ERenderCmd type ) :
+        m_type(type), m_pShaderData(nullptr), m_textureID(0), m_first(0), m_count(0)
+    {}
+
+    // Command type
+    NDefs::ERenderCmd m_type;
+
+    // Shader to bind - We DON'T own this pointer, don't free
+    CShaderData * m_pShaderData;
+
+    // Texture to bind
+    uint32_t m_textureID;
+
+    // ERC_SET_MATRIX: index into the batch matrix list
+    // ERC_DRAW_QUADS: first quad in the vertex stream
+    uint32_t m_first;
+
+    // Number of quads to draw
+    uint32_t m_count;
+};
+
+#endif  // __render_cmd_h__
@@ -17,6 +17,7 @@
 
 // Game lib dependencies
 #include <utilities/exceptionhandling.h>
+#include <system/renderdevice.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -163,6 +164,20 @@ size_t CShaderData::getVertexAttribCount()
 }
 
 
+/************************************************************************
+*    DESC:  Set/Get the id of the shader used when this one is batched
+************************************************************************/
+void CShaderData::setBatchShaderID( const std::string & shaderId )
+{
+    m_batchShaderID = shaderId;
+}
+
+const std::string & CShaderData::getBatchShaderID() const
+{
+    return m_batchShaderID;
+}
+
+
 /************************************************************************
 *    DESC:  Free the data
 ************************************************************************/
@@ -171,20 +186,20 @@ void CShaderData::free()
     // Detach the shaders
     if( (m_vertexID > 0) && (m_fragmentID > 0) && (m_programID > 0) )
     {
-        glDetachShader(m_programID, m_vertexID);
-        glDetachShader(m_programID, m_fragmentID);
+        CRenderDevice::Instance().detachShader(m_programID, m_vertexID);
+        CRenderDevice::Instance().detachShader(m_programID, m_fragmentID);
     }
 
     // Delete the shaders
     if( m_vertexID > 0 )
-        glDeleteShader(m_vertexID);
+        CRenderDevice::Instance().deleteShader(m_vertexID);
 
     if( m_fragmentID > 0 )
-        glDeleteShader(m_fragmentID);
+        CRenderDevice::Instance().deleteShader(m_fragmentID);
 
     // Delete the shader program
     if( m_programID > 0 )
-        glDeleteProgram(m_programID);
+        CRenderDevice::Instance().deleteProgram(m_programID);
 
     clear();
 }
@@ -199,4 +214,5 @@ void CShaderData::clear()
 
     m_attributeMap.clear();
     m_uniformMap.clear();
+    m_batchShaderID.clear();
 }
@@ -47,6 +47,10 @@ public:
     // Get the vertex attribute count
     size_t getVertexAttribCount();
 
+    // Set/Get the id of the shader used when this one is batched
+    void setBatchShaderID( const std::string & shaderId );
+    const std::string & getBatchShaderID() const;
+
     // Free the data
     void free();
 
@@ -68,6 +72,9 @@ private:
     // uniform location shader map
     std::map<const std::string, int32_t > m_uniformMap;
 
+    // Shader used when sprites with this shader are batched
+    std::string m_batchShaderID;
+
 };
 
 #endif  // __shader_data_h__
@@ -29,7 +29,9 @@ CSpriteData::CSpriteData(
         m_group(defGroup),
         m_objectName(defObjName),
         m_aiName(defAIName),
-        m_id(defId)
+        m_id(defId),
+        m_collisionGroup(0),
+        m_collisionMask(0)
 {
     // Get the name of this specific sprite instance
     if( node.isAttributeSet( "name" ) )
@@ -63,6 +65,17 @@ CSpriteData::CSpriteData(
         m_upFontData->loadFromNode( node );
     }
 
+    // Get the collision group and the groups it collides with
+    const XMLNode collisionNode = node.getChildNode("collision");
+    if( !collisionNode.isEmpty() )
+    {
+        if( collisionNode.isAttributeSet( "group" ) )
+            m_collisionGroup = std::atoi( collisionNode.getAttribute( "group" ) );
+
+        if( collisionNode.isAttributeSet( "mask" ) )
+            m_collisionMask = std::atoi( collisionNode.getAttribute( "mask" ) );
+    }
+
     // Load the transform data from node
     loadTransFromNode( node );
     
@@ -77,7 +90,10 @@ CSpriteData::CSpriteData( const CSpriteData & data ) :
     m_group( data.m_group ),
     m_objectName( data.m_objectName ),
     m_aiName( data.m_aiName ),
-    m_id( data.m_id )
+    m_scriptFuncTable( data.m_scriptFuncTable ),
+    m_id( data.m_id ),
+    m_collisionGroup( data.m_collisionGroup ),
+    m_collisionMask( data.m_collisionMask )
 {
 }
 
@@ -144,36 +160,33 @@ const CFontData * CSpriteData::getFontData() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the collision group and mask
+************************************************************************/
+uint CSpriteData::getCollisionGroup() const
+{
+    return m_collisionGroup;
+}
+
+uint CSpriteData::getCollisionMask() const
+{
+    return m_collisionMask;
+}
+
+
 /************************************************************************
 *    DESC:  Get the script functions
 ************************************************************************/
-const std::map<std::string, std::string> & CSpriteData::getScriptFunctions() const
+const CScriptFuncTable & CSpriteData::getScriptFunctions() const
 {
-    return m_scriptFunctionMap;
+    return m_scriptFuncTable;
 }
 
 
 /************************************************************************
-*    DESC:  Load the script functions and add them to the map
+*    DESC:  Load the script functions and add them to the table
 ************************************************************************/
 void CSpriteData::loadScriptFunctions( const XMLNode & node )
 {
-    // Check for scripting - Add an empty string for scripts not defined
-    XMLNode scriptLstNode = node.getChildNode( "scriptLst" );
-    if( !scriptLstNode.isEmpty() )
-    {
-        for( int i = 0; i < scriptLstNode.nChildNode(); ++i )
-        {
-            const XMLNode scriptNode = scriptLstNode.getChildNode(i);
-            
-            // Only the first attribute is used
-            const XMLAttribute attribute = scriptNode.getAttribute(0);
-            const std::string attrName = attribute.lpszName;
-            const std::string attrValue = attribute.lpszValue;
-
-            // Add the attribute name and value to the map
-            if( !attrValue.empty() )
-                m_scriptFunctionMap.emplace( attrName, attrValue );
-        }
-    }
+    m_scriptFuncTable.loadFromNode( node );
 }
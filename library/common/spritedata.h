@@ -12,9 +12,11 @@
 #include <common/object.h>
 #include <common/color.h>
 
+// Game lib dependencies
+#include <script/scriptfunctable.h>
+
 // Standard lib dependencies
 #include <string>
-#include <map>
 #include <memory>
 
 // Forward declaration(s)
@@ -38,11 +40,11 @@ public:
     // Destructor
     ~CSpriteData();
     
-    // Init the script functions and add them to the map
+    // Init the script functions and add them to the table
     void loadScriptFunctions( const XMLNode & node );
     
     // Get the script functions
-    const std::map<std::string, std::string> & getScriptFunctions() const;
+    const CScriptFuncTable & getScriptFunctions() const;
     
     // Get the sprite name
     const std::string & getName() const;
@@ -61,6 +63,10 @@ public:
     
     // Get the font data
     const CFontData * getFontData() const;
+    
+    // Get the collision group and mask
+    uint getCollisionGroup() const;
+    uint getCollisionMask() const;
 
 private:
 
@@ -68,8 +74,10 @@ private:
     std::string m_group;
     std::string m_objectName;
     std::string m_aiName;
-    std::map<std::string, std::string> m_scriptFunctionMap;
+    CScriptFuncTable m_scriptFuncTable;
     int m_id;
+    uint m_collisionGroup;
+    uint m_collisionMask;
     std::unique_ptr<CFontData> m_upFontData;
 };
 
@@ -90,6 +90,16 @@ void CSpriteSheet::build( const CSize<int> & sheetSize )
 }
 
 
+/************************************************************************
+*    DESC:  Build the sprite sheet from the glyphs of a packed atlas
+************************************************************************/
+void CSpriteSheet::build( const CSize<int> & sheetSize, const std::vector<CSpriteSheetGlyph> & glyphVec )
+{
+    m_size = sheetSize;
+    m_glyphVec = glyphVec;
+}
+
+
 /************************************************************************
 *    DESC:  Load the glyph data from XML file
 *
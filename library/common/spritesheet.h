@@ -32,6 +32,9 @@ public:
     
     // Build the simple (grid) sprite sheet
     void build( const CSize<int> & sheetSize );
+
+    // Build the sprite sheet from the glyphs of a packed atlas
+    void build( const CSize<int> & sheetSize, const std::vector<CSpriteSheetGlyph> & glyphVec );
     
     // Load the glyph data
     void load( const std::string & filePath );
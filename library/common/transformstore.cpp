@@ -0,0 +1,280 @@
+/************************************************************************
+*    FILE NAME:       transformstore.cpp
+*
+*    DESCRIPTION:     Transform component store
+*                     The transforms of the objects are held in chunks
+*                     with an array per field. The chunks never move so
+*                     the objects hold references into them, and the
+*                     batched pass streams through the arrays to make the
+*                     2D matrices of all the objects in one loop.
+************************************************************************/
+
+// Physical component dependency
+#include <common/transformstore.h>
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <utilities/fixedstep.h>
+#include <utilities/matrixfunc.h>
+
+// Standard lib dependencies
+#include <cmath>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CTransformStore::CTransformStore()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Get a transform. Reset to the default transform
+************************************************************************/
+CTransformSlot CTransformStore::alloc()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    CTransformSlot slot;
+
+    if( !m_freeSlotVec.empty() )
+    {
+        slot = m_freeSlotVec.back();
+        m_freeSlotVec.pop_back();
+    }
+    else
+    {
+        if( m_upChunkVec.empty() || (m_upChunkVec.back()->m_count == CTransformChunk::SIZE) )
+            m_upChunkVec.emplace_back( new CTransformChunk );
+
+        slot.m_pChunk = m_upChunkVec.back().get();
+        slot.m_index = slot.m_pChunk->m_count++;
+    }
+
+    CTransformChunk & chunk = *slot.m_pChunk;
+    const uint32_t i = slot.m_index;
+
+    chunk.m_parameters[i].clear();
+    chunk.m_pos[i].clear();
+    chunk.m_rot[i].clear();
+    chunk.m_scale[i].set( 1, 1, 1 );
+    chunk.m_centerPos[i].clear();
+    chunk.m_cropOffset[i].clear();
+    chunk.m_prevPos[i].clear();
+    chunk.m_prevRot[i].clear();
+    chunk.m_prevScale[i].set( 1, 1, 1 );
+    chunk.m_prevTick[i] = 0;
+    chunk.m_transPos[i].clear();
+    chunk.m_matrix[i].initilizeMatrix();
+
+    return slot;
+}
+
+
+/************************************************************************
+*    DESC:  Free a transform
+************************************************************************/
+void CTransformStore::free( const CTransformSlot & slot )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    // Clear the flags so the batched pass skips it
+    slot.m_pChunk->m_parameters[slot.m_index].clear();
+
+    m_freeSlotVec.push_back( slot );
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of transforms in use
+************************************************************************/
+size_t CTransformStore::getCount()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    size_t count = 0;
+
+    for( auto & iter : m_upChunkVec )
+        count += iter->m_count;
+
+    return count - m_freeSlotVec.size();
+}
+
+
+/************************************************************************
+*    DESC:  Make the 2D matrices of the objects flagged for the batched pass
+*           The object's transform call then keeps the matrix made here
+************************************************************************/
+void CTransformStore::transform2D()
+{
+    const uint32_t tick = CFixedStep::Instance().getTick();
+    const float stepAlpha = CFixedStep::Instance().getAlpha();
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    for( auto & iter : m_upChunkVec )
+        transform2D( *iter, tick, stepAlpha );
+}
+
+
+/************************************************************************
+*    DESC:  Make the 2D matrices of the flagged objects of a chunk
+*           Makes the same matrix as CObject2D::transformLocalMatrix
+*           without the general matrix calls. Done in passes so the
+*           sin and cos of the chunk are done in one loop
+************************************************************************/
+void CTransformStore::transform2D( CTransformChunk & chunk, uint32_t tick, float stepAlpha )
+{
+    // Turn the shortest way between the angles
+    auto lerpAngle = []( float prev, float cur, float ratio )
+    {
+        const float diff = std::remainder( cur - prev, 360.0f * defs_DEG_TO_RAD );
+        return prev + (diff * ratio);
+    };
+
+    uint32_t indexAry[CTransformChunk::SIZE];
+    float alphaAry[CTransformChunk::SIZE];
+    float rotAry[CTransformChunk::SIZE];
+    float cosAry[CTransformChunk::SIZE];
+    float sinAry[CTransformChunk::SIZE];
+    uint32_t count = 0;
+
+    // Find the transforms that need a new matrix
+    for( uint32_t i = 0; i < chunk.m_count; ++i )
+    {
+        const CBitmask<int16_t> & rParam = chunk.m_parameters[i];
+
+        if( !rParam.isSet( NDefs::BATCH_TRANSFORM ) )
+            continue;
+
+        const float alpha =
+            (rParam.isSet( NDefs::INTERPOLATE ) && (chunk.m_prevTick[i] == tick)) ? stepAlpha : 1.f;
+
+        if( !rParam.isSet( NDefs::TRANSFORM ) && !rParam.isSet( NDefs::INTERPOLATED ) && !(alpha < 1.f) )
+            continue;
+
+        // A rotation about x or y is left to the object
+        if( !chunk.m_rot[i].isXEmpty() || !chunk.m_rot[i].isYEmpty() ||
+            ((alpha < 1.f) && (!chunk.m_prevRot[i].isXEmpty() || !chunk.m_prevRot[i].isYEmpty())) )
+            continue;
+
+        if( !rParam.isSet( NDefs::ROTATE ) )
+            rotAry[count] = 0.f;
+        else if( alpha < 1.f )
+            rotAry[count] = lerpAngle( chunk.m_prevRot[i].z, chunk.m_rot[i].z, alpha );
+        else
+            rotAry[count] = chunk.m_rot[i].z;
+
+        alphaAry[count] = alpha;
+        indexAry[count++] = i;
+    }
+
+    NMatrixFunc::SinCos( sinAry, cosAry, rotAry, count );
+
+    // Make the matrices
+    for( uint32_t j = 0; j < count; ++j )
+    {
+        const uint32_t i = indexAry[j];
+        const float alpha = alphaAry[j];
+        CBitmask<int16_t> & rParam = chunk.m_parameters[i];
+
+        // The world values are only copied when interpolating
+        CPoint<float> pos;
+        CPoint<float> scale( chunk.m_scale[i] );
+
+        if( alpha < 1.f )
+        {
+            const CPoint<CWorldValue> & rPos = chunk.m_pos[i];
+            const CPoint<CWorldValue> & rPrevPos = chunk.m_prevPos[i];
+
+            pos.x = rPrevPos.x + ((rPos.x - rPrevPos.x) * alpha);
+            pos.y = rPrevPos.y + ((rPos.y - rPrevPos.y) * alpha);
+            pos.z = rPrevPos.z + ((rPos.z - rPrevPos.z) * alpha);
+
+            scale = chunk.m_prevScale[i] + ((scale - chunk.m_prevScale[i]) * alpha);
+        }
+        else
+        {
+            const CPoint<CWorldValue> & rPos = chunk.m_pos[i];
+
+            pos.x = rPos.x.getFloat();
+            pos.y = rPos.y.getFloat();
+            pos.z = rPos.z.getFloat();
+        }
+
+        float r00 = 1.f, r01 = 0.f, r10 = 0.f, r11 = 1.f, r22 = 1.f;
+        float tx = 0.f, ty = 0.f, tz = 0.f;
+
+        if( rParam.isSet( NDefs::CROP_OFFSET ) )
+        {
+            tx += static_cast<float>(chunk.m_cropOffset[i].w);
+            ty += static_cast<float>(chunk.m_cropOffset[i].h);
+        }
+
+        if( rParam.isSet( NDefs::SCALE ) )
+        {
+            r00 *= scale.x;
+            r11 *= scale.y;
+            r22 *= scale.z;
+        }
+
+        if( rParam.isSet( NDefs::ROTATE ) )
+        {
+            const CPoint<float> & rCenter = chunk.m_centerPos[i];
+            const bool center = rParam.isSet( NDefs::CENTER_POINT );
+
+            if( center )
+            {
+                tx += rCenter.x;
+                ty += rCenter.y;
+                tz += rCenter.z;
+            }
+
+            if( rotAry[j] != 0.f )
+            {
+                const float cosZ = cosAry[j];
+                const float sinZ = sinAry[j];
+                const float x = tx;
+
+                r01 = r00 * sinZ;
+                r00 = r00 * cosZ;
+                r10 = r11 * -sinZ;
+                r11 = r11 * cosZ;
+                tx = (x * cosZ) + (ty * -sinZ);
+                ty = (x * sinZ) + (ty * cosZ);
+            }
+
+            if( center )
+            {
+                tx += -rCenter.x;
+                ty += -rCenter.y;
+                tz += -rCenter.z;
+            }
+        }
+
+        if( rParam.isSet( NDefs::TRANSLATE ) )
+        {
+            tx += pos.x;
+            ty += pos.y;
+            tz += pos.z;
+        }
+
+        // Write the whole matrix in one go
+        float * pMat = &chunk.m_matrix[i][m00];
+        pMat[m00] = r00; pMat[m01] = r01; pMat[m02] = 0.f; pMat[m03] = 0.f;
+        pMat[m10] = r10; pMat[m11] = r11; pMat[m12] = 0.f; pMat[m13] = 0.f;
+        pMat[m20] = 0.f; pMat[m21] = 0.f; pMat[m22] = r22; pMat[m23] = 0.f;
+        pMat[m30] = tx;  pMat[m31] = ty;  pMat[m32] = tz;  pMat[m33] = 1.f;
+
+        // The translated position of an object without a parent
+        chunk.m_transPos[i] = pos;
+
+        if( alpha < 1.f )
+            rParam.add( NDefs::INTERPOLATED );
+        else
+            rParam.remove( NDefs::INTERPOLATED );
+
+        rParam.remove( NDefs::TRANSFORM | NDefs::PHYSICS_TRANSFORM );
+        rParam.add( NDefs::WAS_TRANSFORMED | NDefs::BATCH_TRANSFORMED );
+    }
+}
@@ -0,0 +1,104 @@
+/************************************************************************
+*    FILE NAME:       transformstore.h
+*
+*    DESCRIPTION:     Transform component store
+*                     The transforms of the objects are held in chunks
+*                     with an array per field. The chunks never move so
+*                     the objects hold references into them, and the
+*                     batched pass streams through the arrays to make the
+*                     2D matrices of all the objects in one loop.
+************************************************************************/
+
+#ifndef __transform_store_h__
+#define __transform_store_h__
+
+// Game lib dependencies
+#include <common/size.h>
+#include <common/point.h>
+#include <common/worldvalue.h>
+#include <utilities/bitmask.h>
+#include <utilities/matrix.h>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+class CTransformChunk
+{
+public:
+
+    // Number of transforms in a chunk
+    static const uint32_t SIZE = 256;
+
+    CBitmask<int16_t> m_parameters[SIZE];
+    CPoint<CWorldValue> m_pos[SIZE];
+    CPoint<float> m_rot[SIZE];
+    CPoint<float> m_scale[SIZE];
+    CPoint<float> m_centerPos[SIZE];
+    CSize<int16_t> m_cropOffset[SIZE];
+    CPoint<CWorldValue> m_prevPos[SIZE];
+    CPoint<float> m_prevRot[SIZE];
+    CPoint<float> m_prevScale[SIZE];
+    uint32_t m_prevTick[SIZE];
+    CPoint<float> m_transPos[SIZE];
+    CMatrix m_matrix[SIZE];
+
+    // Number of transforms handed out. The batched pass stops here
+    uint32_t m_count = 0;
+};
+
+class CTransformSlot
+{
+public:
+
+    CTransformChunk * m_pChunk;
+    uint32_t m_index;
+};
+
+class CTransformStore
+{
+public:
+
+    // Get the instance of the singleton class
+    // Never destroyed so the objects in the other singletons can free their slots
+    static CTransformStore & Instance()
+    {
+        static CTransformStore * pStore = new CTransformStore;
+        return *pStore;
+    }
+
+    // Get a transform. Reset to the default transform
+    CTransformSlot alloc();
+
+    // Free a transform
+    void free( const CTransformSlot & slot );
+
+    // Make the 2D matrices of the objects flagged for the batched pass
+    void transform2D();
+
+    // Get the number of transforms in use
+    size_t getCount();
+
+private:
+
+    // Constructor
+    CTransformStore();
+
+    // Make the 2D matrices of the flagged objects of a chunk
+    void transform2D( CTransformChunk & chunk, uint32_t tick, float stepAlpha );
+
+private:
+
+    // The chunks of transforms
+    std::vector<std::unique_ptr<CTransformChunk>> m_upChunkVec;
+
+    // The freed transforms
+    std::vector<CTransformSlot> m_freeSlotVec;
+
+    // The objects are made and freed on the worker threads too
+    std::mutex m_mutex;
+};
+
+#endif  // __transform_store_h__
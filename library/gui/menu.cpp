@@ -29,6 +29,17 @@
 #include <boost/format.hpp>
 #include <boost/bind.hpp>
 
+// Standard lib dependencies
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace
+{
+    // Size of the hit grid cells in pixels
+    const float HIT_GRID_CELL_SIZE = 128.f;
+}
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -37,10 +48,17 @@ CMenu::CMenu( const std::string & name, const std::string & group ) :
     m_group(group),
     m_pActiveNode(nullptr),
     m_state(NMenu::EMS_INACTIVE),
-    m_alpha(0.f)
+    m_alpha(0.f),
+    m_eventRouteGeneration(0),
+    m_hitGrid(HIT_GRID_CELL_SIZE),
+    m_hitGridDirty(true),
+    m_fullMouseMove(true)
 {
     // The menu needs to default hidden
     setVisible(false);
+
+    // Menu scripts get the part of the budget the AI leaves
+    m_scriptComponent.setPriority( NDefs::ESP_UI );
 }
 
 
@@ -189,6 +207,7 @@ void CMenu::loadStaticSpriteFromNode( const XMLNode & node )
 
     // Init the script functions
     m_spriteDeq.back().initScriptFunctions( node );
+    m_spriteDeq.back().getScriptComponent().setPriority( NDefs::ESP_UI );
 }
 
 
@@ -385,6 +404,7 @@ void CMenu::cleanUp()
 ************************************************************************/
 void CMenu::activateMenu()
 {
+    m_fullMouseMove = true;
     m_state = NMenu::EMS_IDLE;
     setVisible(true);
     setAlpha(1.f);
@@ -431,11 +451,18 @@ void CMenu::transform()
         for( auto iter : m_pStaticControlVec )
             iter->transform( *this );
 
+        // The hit grid is rebuilt when a mouse move control was moved
         for( auto iter : m_pMouseOnlyControlVec )
+        {
             iter->transform( *this );
+            m_hitGridDirty = m_hitGridDirty || iter->wasHitAreaTransformed();
+        }
 
         for( auto iter : m_pControlVec )
+        {
             iter->transform( *this );
+            m_hitGridDirty = m_hitGridDirty || iter->wasHitAreaTransformed();
+        }
     }
 }
 
@@ -451,11 +478,18 @@ void CMenu::transform( const CObject2D & object )
         for( auto iter : m_pStaticControlVec )
             iter->transform( *this );
 
+        // The hit grid is rebuilt when a mouse move control was moved
         for( auto iter : m_pMouseOnlyControlVec )
+        {
             iter->transform( *this );
+            m_hitGridDirty = m_hitGridDirty || iter->wasHitAreaTransformed();
+        }
 
         for( auto iter : m_pControlVec )
+        {
             iter->transform( *this );
+            m_hitGridDirty = m_hitGridDirty || iter->wasHitAreaTransformed();
+        }
     }
 }
 
@@ -496,12 +530,27 @@ const std::string & CMenu::getName() const
 ************************************************************************/
 void CMenu::handleEvent( const SDL_Event & rEvent )
 {
-    // Have the controls handle events
-    for( auto iter : m_pControlVec )
+    // Have the controls subscribed to this type of event handle it
+    for( auto iter : getEventRoute( rEvent.type ) )
         iter->handleEvent( rEvent );
 
-    for( auto iter : m_pMouseOnlyControlVec )
-        iter->handleEvent( rEvent );
+    // Keep track of the controls the next mouse move has to visit
+    if( rEvent.type == NMenu::EGE_MENU_CONTROL_STATE_CHANGE )
+    {
+        uint32_t id;
+        if( !findHitId( rEvent.user.data1, id ) )
+            m_fullMouseMove = true;
+
+        else if( std::find( m_hotIdVec.begin(), m_hotIdVec.end(), id ) == m_hotIdVec.end() )
+            m_hotIdVec.push_back( id );
+    }
+    else if( (rEvent.type == NMenu::EGE_MENU_TRANS_IN) ||
+             (rEvent.type == NMenu::EGE_MENU_TRANS_OUT) ||
+             (rEvent.type == NMenu::EGE_MENU_REACTIVATE) ||
+             (rEvent.type == NMenu::EGE_MENU_SET_ACTIVE_CONTROL) )
+    {
+        m_fullMouseMove = true;
+    }
 
     if( rEvent.type == NMenu::EGE_MENU_TRANS_IN )
     {
@@ -647,17 +696,169 @@ void CMenu::navigateMenu( CUIControlNavNode::ENavNode navNodeAction )
 ************************************************************************/
 void CMenu::onMouseMove( const SDL_Event & rEvent )
 {
-    for( auto iter : m_pControlNodeVec )
+    const uint32_t count = m_pControlNodeVec.size() + m_pMouseOnlyControlVec.size();
+
+    // A control being dragged takes the moves off of its area so all
+    // the controls get the moves while a button is down
+    if( m_fullMouseMove || (rEvent.motion.state != 0) )
     {
-        if( iter->getControl()->onMouseMove( rEvent ) )
-            m_pActiveNode = iter;
-        else
-            iter->getControl()->deactivateControl();
+        m_fullMouseMove = false;
+        m_hotIdVec.clear();
+
+        for( uint32_t id = 0; id < count; ++id )
+            onMouseMove( id, rEvent );
+
+        return;
     }
 
-    for( auto iter : m_pMouseOnlyControlVec )
-        if( !iter->onMouseMove( rEvent ) )
-            iter->deactivateControl();
+    updateHitGrid();
+
+    // The controls under the mouse, the ones under it at the last move
+    // that need to be deactivated and the active one
+    m_hitIdVec.clear();
+    m_hitGrid.queryRect(
+        CRect<float>( rEvent.motion.x, rEvent.motion.y, rEvent.motion.x, rEvent.motion.y ), m_hitIdVec );
+
+    m_hitIdVec.insert( m_hitIdVec.end(), m_hotIdVec.begin(), m_hotIdVec.end() );
+
+    uint32_t activeId;
+    if( (m_pActiveNode != nullptr) && findHitId( m_pActiveNode->getControl(), activeId ) )
+        m_hitIdVec.push_back( activeId );
+
+    // Visit them in the same order as all the controls
+    std::sort( m_hitIdVec.begin(), m_hitIdVec.end() );
+    m_hitIdVec.erase( std::unique( m_hitIdVec.begin(), m_hitIdVec.end() ), m_hitIdVec.end() );
+
+    m_hotIdVec.clear();
+
+    for( auto id : m_hitIdVec )
+        onMouseMove( id, rEvent );
+}
+
+
+/************************************************************************
+*    DESC:  Handle the mouse move of the control of the hit id
+************************************************************************/
+void CMenu::onMouseMove( uint32_t id, const SDL_Event & rEvent )
+{
+    CUIControl * pControl = getHitControl( id );
+
+    if( pControl->onMouseMove( rEvent ) )
+    {
+        if( id < m_pControlNodeVec.size() )
+            m_pActiveNode = m_pControlNodeVec[id];
+
+        m_hotIdVec.push_back( id );
+    }
+    else
+    {
+        pControl->deactivateControl();
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the controls subscribed to the type of event
+*           The routes are built the first time the type is handled
+************************************************************************/
+const std::vector<CUIControl *> & CMenu::getEventRoute( uint32_t type )
+{
+    // A control's subscriptions changed
+    if( m_eventRouteGeneration != CUIControl::getSubscriptionGeneration() )
+    {
+        m_eventRouteGeneration = CUIControl::getSubscriptionGeneration();
+        m_eventRouteMap.clear();
+    }
+
+    auto iter = m_eventRouteMap.find( type );
+    if( iter == m_eventRouteMap.end() )
+    {
+        iter = m_eventRouteMap.emplace( type, std::vector<CUIControl *>() ).first;
+
+        for( auto ctrlIter : m_pControlVec )
+            if( ctrlIter->isSubscribed( type ) )
+                iter->second.push_back( ctrlIter );
+
+        for( auto ctrlIter : m_pMouseOnlyControlVec )
+            if( ctrlIter->isSubscribed( type ) )
+                iter->second.push_back( ctrlIter );
+    }
+
+    return iter->second;
+}
+
+
+/************************************************************************
+*    DESC:  Rebuild the hit grid if a control was moved
+*           Each control is added as the circle around its area
+************************************************************************/
+void CMenu::updateHitGrid()
+{
+    if( !m_hitGridDirty )
+        return;
+
+    m_hitGridDirty = false;
+    m_hitGrid.clear();
+
+    const uint32_t count = m_pControlNodeVec.size() + m_pMouseOnlyControlVec.size();
+
+    for( uint32_t id = 0; id < count; ++id )
+    {
+        CRect<float> rect( std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                           std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() );
+
+        getHitControl( id )->addHitArea( rect );
+
+        // Controls without an area are never under the mouse
+        if( rect.x1 <= rect.x2 )
+        {
+            const float halfW = (rect.x2 - rect.x1) * 0.5f;
+            const float halfH = (rect.y2 - rect.y1) * 0.5f;
+
+            m_hitGrid.update(
+                id,
+                CPoint<float>( rect.x1 + halfW, rect.y1 + halfH ),
+                std::sqrt( (halfW * halfW) + (halfH * halfH) ) );
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the control of the hit id
+************************************************************************/
+CUIControl * CMenu::getHitControl( uint32_t id ) const
+{
+    if( id < m_pControlNodeVec.size() )
+        return m_pControlNodeVec[id]->getControl();
+
+    return m_pMouseOnlyControlVec[id - m_pControlNodeVec.size()];
+}
+
+
+/************************************************************************
+*    DESC:  Get the hit id of the control
+*           False if it's not a mouse move control of this menu
+************************************************************************/
+bool CMenu::findHitId( const void * pControl, uint32_t & id )
+{
+    // The controls don't change after the menu is loaded
+    const uint32_t count = m_pControlNodeVec.size() + m_pMouseOnlyControlVec.size();
+    if( m_hitIdMap.size() != count )
+    {
+        m_hitIdMap.clear();
+
+        for( uint32_t i = 0; i < count; ++i )
+            m_hitIdMap.emplace( getHitControl( i ), i );
+    }
+
+    auto iter = m_hitIdMap.find( pControl );
+    if( iter == m_hitIdMap.end() )
+        return false;
+
+    id = iter->second;
+
+    return true;
 }
 
 
@@ -818,6 +1019,8 @@ void CMenu::activateFirstInactiveControl()
 ************************************************************************/
 void CMenu::reset()
 {
+    m_fullMouseMove = true;
+
     for( auto iter : m_pControlVec )
         iter->reset( true );
 
@@ -18,6 +18,7 @@
 #include <gui/scrollparam.h>
 #include <script/scriptcomponent.h>
 #include <common/dynamicoffset.h>
+#include <2d/spatialgrid2d.h>
 
 // SDL/OpenGL lib dependencies
 #include <SDL.h>
@@ -30,7 +31,9 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <unordered_map>
 #include <memory>
+#include <cstdint>
 
 // Forward declaration(s)
 class CSprite2D;
@@ -159,6 +162,21 @@ private:
     void onTransOut( const SDL_Event & rEvent );
     void onMouseMove( const SDL_Event & rEvent );
     
+    // Handle the mouse move of the control of the hit id
+    void onMouseMove( uint32_t id, const SDL_Event & rEvent );
+    
+    // Get the controls subscribed to the type of event
+    const std::vector<CUIControl *> & getEventRoute( uint32_t type );
+    
+    // Rebuild the hit grid if a control was moved
+    void updateHitGrid();
+    
+    // Get the control of the hit id
+    CUIControl * getHitControl( uint32_t id ) const;
+    
+    // Get the hit id of the control. False if it's not a mouse move control of this menu
+    bool findHitId( const void * pControl, uint32_t & id );
+    
     // Prepare the script function to run
     void prepare( const std::string & scriptFuncId );
 
@@ -218,6 +236,29 @@ private:
     
     // menu alpha value
     float m_alpha;
+    
+    // Controls subscribed to each type of event. Built the first time the type is handled
+    std::unordered_map<uint32_t, std::vector<CUIControl *>> m_eventRouteMap;
+    
+    // Control subscription count the routes were built with
+    uint m_eventRouteGeneration;
+    
+    // Screen grid of the areas of the controls that take mouse moves.
+    // The hit ids are the nav node indexes followed by the mouse only control indexes
+    CSpatialGrid2D m_hitGrid;
+    
+    // Hit ids of the controls
+    std::unordered_map<const void *, uint32_t> m_hitIdMap;
+    
+    // Was a control moved since the hit grid was built
+    bool m_hitGridDirty;
+    
+    // Hit ids of the controls under the mouse at the last move and the ones visited by this move
+    std::vector<uint32_t> m_hotIdVec;
+    std::vector<uint32_t> m_hitIdVec;
+    
+    // Send the next mouse move to all the controls
+    bool m_fullMouseMove;
 
 };
 
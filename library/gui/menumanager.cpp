@@ -19,6 +19,7 @@
 #include <gui/messagecracker.h>
 #include <managers/actionmanager.h>
 #include <managers/signalmanager.h>
+#include <utilities/profiler.h>
 
 // SDL/OpenGL lib dependencies
 #include <SDL.h>
@@ -51,6 +52,8 @@ CMenuMgr::~CMenuMgr()
  ************************************************************************/
 void CMenuMgr::loadGroup( const std::string & group, const bool doInit )
 {
+    PROFILE_ZONE( "CMenuMgr::loadGroup" );
+
     // Check for a hardware extension
     std::string ext;
     if( !m_mobileExt.empty() && NBDefs::IsMobileDevice() )
@@ -29,6 +29,9 @@
 // Standard lib dependencies
 #include <cstring>
 #include <iostream>
+#include <algorithm>
+
+uint CUIControl::m_subscriptionGeneration = 0;
 
 /************************************************************************
 *    DESC:  Constructor
@@ -40,6 +43,8 @@ CUIControl::CUIControl( const std::string & group ) :
     m_actionType(NUIControl::ECAT_NULL),
     m_mouseSelectType(NDefs::EAP_UP)
 {
+    // Control scripts get the part of the budget the AI leaves
+    m_scriptComponent.setPriority( NDefs::ESP_UI );
 }
 
 
@@ -178,6 +183,7 @@ void CUIControl::loadSpriteFromNode( const XMLNode & node, size_t & fontSpriteCo
     // Internally allocate the sprite in the deque
     m_spriteDeq.emplace_back( CObjectDataMgr::Instance().getData2D( m_group, objectName ) );
     auto & rSprite = m_spriteDeq.back();
+    rSprite.getScriptComponent().setPriority( NDefs::ESP_UI );
 
     // Load the sprite data
     rSprite.load( node );
@@ -449,6 +455,61 @@ void CUIControl::onReactivate( const SDL_Event & rEvent )
 }
 
 
+/************************************************************************
+*    DESC:  Does the control handle this type of event
+*           The menu only routes the types a control is subscribed to
+************************************************************************/
+bool CUIControl::isSubscribed( uint32_t type ) const
+{
+    // The smart gui handler sees every event
+    if( m_upSmartGui )
+        return true;
+
+    return (type == NMenu::EGE_MENU_CONTROL_STATE_CHANGE) ||
+           (type == NMenu::EGE_MENU_SELECT_EXECUTE) ||
+           (type == NMenu::EGE_MENU_SET_ACTIVE_CONTROL) ||
+           (type == NMenu::EGE_MENU_REACTIVATE) ||
+           (type == NMenu::EGE_MENU_TRANS_IN) ||
+           (type == NMenu::EGE_MENU_TRANS_OUT);
+}
+
+
+/************************************************************************
+*    DESC:  Get the count of the changes to the subscriptions of all the controls
+************************************************************************/
+uint CUIControl::getSubscriptionGeneration()
+{
+    return m_subscriptionGeneration;
+}
+
+
+/************************************************************************
+*    DESC:  Add the screen area the control takes mouse moves in to the rect
+************************************************************************/
+void CUIControl::addHitArea( CRect<float> & rect ) const
+{
+    if( !m_size.isEmpty() )
+    {
+        for( int i = 0; i < 4; ++i )
+        {
+            rect.x1 = std::min( rect.x1, m_collisionQuad.point[i].x );
+            rect.y1 = std::min( rect.y1, m_collisionQuad.point[i].y );
+            rect.x2 = std::max( rect.x2, m_collisionQuad.point[i].x );
+            rect.y2 = std::max( rect.y2, m_collisionQuad.point[i].y );
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Was the hit area moved by the last transform
+************************************************************************/
+bool CUIControl::wasHitAreaTransformed() const
+{
+    return wasWorldPosTranformed();
+}
+
+
 /************************************************************************
 *    DESC:  Handle the mouse move
 ************************************************************************/
@@ -604,27 +665,27 @@ void CUIControl::cleanUp()
 ************************************************************************/
 void CUIControl::prepareSpriteScriptFunction( NUIControl::EControlState controlState )
 {
-    std::string scriptFuncMapKey = "null";
+    uint scriptFuncId(CScriptFuncTable::EFI_COUNT);
     bool forceUpdate(false);
 
     switch( controlState )
     {
         case NUIControl::ECS_DISABLED:
-            scriptFuncMapKey = "disabled";
+            scriptFuncId = CScriptFuncTable::EFI_DISABLED;
             forceUpdate = true;
         break;
 
         case NUIControl::ECS_INACTIVE:
-            scriptFuncMapKey = "inactive";
+            scriptFuncId = CScriptFuncTable::EFI_INACTIVE;
             forceUpdate = true;
         break;
 
         case NUIControl::ECS_ACTIVE:
-            scriptFuncMapKey = "active";
+            scriptFuncId = CScriptFuncTable::EFI_ACTIVE;
         break;
 
         case NUIControl::ECS_SELECTED:
-            scriptFuncMapKey = "selected";
+            scriptFuncId = CScriptFuncTable::EFI_SELECTED;
         break;
 
         case NUIControl::ECS_INIT:
@@ -633,22 +694,27 @@ void CUIControl::prepareSpriteScriptFunction( NUIControl::EControlState controlS
         case NUIControl::ECS_NULL:
             throw NExcept::CCriticalException("Control State NULL!",
                 boost::str( boost::format("Control state can't use this state for sprites (%s)!\n\n%s\nLine: %s")
-                    % scriptFuncMapKey %  __FUNCTION__ % __LINE__ ));
+                    % controlState %  __FUNCTION__ % __LINE__ ));
         break;
     };
 
     // Force an update for states that just change settings and don't animate
-    callSpriteScriptFuncKey( scriptFuncMapKey, forceUpdate );
+    callSpriteScriptFuncKey( scriptFuncId, forceUpdate );
 }
 
 
 /************************************************************************
 *    DESC:  Call a script function map key for sprite
 ************************************************************************/
-void CUIControl::callSpriteScriptFuncKey( const std::string & scriptFuncMapKey, bool forceUpdate )
+void CUIControl::callSpriteScriptFuncKey( uint scriptFuncId, bool forceUpdate )
 {
     for( auto & iter : m_spriteDeq )
-        iter.prepareFuncId( scriptFuncMapKey, forceUpdate );
+        iter.prepareFuncId( scriptFuncId, forceUpdate );
+}
+
+void CUIControl::callSpriteScriptFuncKey( const std::string & scriptFuncMapKey, bool forceUpdate )
+{
+    callSpriteScriptFuncKey( CScriptFuncTable::GetId( scriptFuncMapKey ), forceUpdate );
 }
 
 
@@ -717,6 +783,9 @@ void CUIControl::setDefaultState( NUIControl::EControlState value )
 void CUIControl::setSmartGui( CSmartGuiControl * pSmartGuiControl )
 {
     m_upSmartGui.reset( pSmartGuiControl );
+
+    // Smart gui controls are subscribed to all events
+    ++m_subscriptionGeneration;
 }
 
 CSmartGuiControl * CUIControl::getSmartGuiPtr()
@@ -68,6 +68,19 @@ public:
 
     // Handle events
     virtual void handleEvent( const SDL_Event & rEvent );
+    
+    // Does the control handle this type of event. The menu only routes
+    // the types a control is subscribed to
+    virtual bool isSubscribed( uint32_t type ) const;
+    
+    // Get the count of the changes to the subscriptions of all the controls
+    static uint getSubscriptionGeneration();
+    
+    // Add the screen area the control takes mouse moves in to the rect
+    virtual void addHitArea( CRect<float> & rect ) const;
+    
+    // Was the hit area moved by the last transform
+    virtual bool wasHitAreaTransformed() const;
 
     // Set the control to their default behavior
     void revertToDefaultState();
@@ -160,6 +173,7 @@ public:
     void connect_executionAction( const ExecutionActionSignal::slot_type & slot );
     
     // Call a script function map key for sprite
+    void callSpriteScriptFuncKey( uint scriptFuncId, bool forceUpdate = false );
     void callSpriteScriptFuncKey( const std::string & scriptFuncMapKey, bool forceUpdate = false );
     
     // Set the alpha value of this menu
@@ -280,6 +294,9 @@ private:
     
     // Boost signals
     ExecutionActionSignal m_executionActionSignal;
+    
+    // Changed when a control's subscriptions change so the menus rebuild their routes
+    static uint m_subscriptionGeneration;
 };
 
 #endif  // __ui_control_h__
@@ -215,7 +215,7 @@ void CUIMeter::initBangRange( const CBangRange & bangRange )
     m_startUpTimer.set( bangRange.m_slowStartTime );
 
     // Prepare the start script function if one exists
-    m_pSprite->prepareFuncId( "start" );
+    m_pSprite->prepareFuncId( CScriptFuncTable::EFI_START );
 }
 
 
@@ -304,7 +304,7 @@ void CUIMeter::update()
                 m_bangUp = false;
 
                 // Prepare the stop script function if one exists
-                m_pSprite->prepareFuncId( "stop" );
+                m_pSprite->prepareFuncId( CScriptFuncTable::EFI_STOP );
             }
 
             // Display the value in the meter
@@ -364,6 +364,6 @@ void CUIMeter::clear()
     m_lastValue = m_currentValue = m_targetValue = 0;
     m_bangUp = false;
 
-    if( !m_pSprite->prepareFuncId( "clear" ) )
+    if( !m_pSprite->prepareFuncId( CScriptFuncTable::EFI_CLEAR ) )
         m_pSprite->getVisualComponent().createFontString( boost::lexical_cast<std::string>((int64_t)m_currentValue ) );
 }
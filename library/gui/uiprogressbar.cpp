@@ -19,6 +19,7 @@
 #include <2d/sprite2d.h>
 #include <objectdata/objectdatamanager.h>
 #include <objectdata/objectdata2d.h>
+#include <system/renderdevice.h>
 
 // Boost lib dependencies
 
@@ -179,35 +180,35 @@ void CUIProgressBar::render( const CMatrix & matrix )
             if( static_cast<int>(i) == m_spriteApplyIndex )
             {
                 // Disable rendering to the color buffer
-                glColorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
-                glDepthMask( GL_FALSE );
+                CRenderDevice::Instance().colorMask( false, false, false, false );
+                CRenderDevice::Instance().depthMask( false );
 
                 // Start using the stencil
-                glEnable( GL_STENCIL_TEST );
+                CRenderDevice::Instance().enable( GL_STENCIL_TEST );
 
-                glStencilFunc( GL_ALWAYS, 0x1, 0x1 );
-                glStencilOp( GL_REPLACE, GL_REPLACE, GL_REPLACE );
+                CRenderDevice::Instance().stencilFunc( GL_ALWAYS, 0x1, 0x1 );
+                CRenderDevice::Instance().stencilOp( GL_REPLACE, GL_REPLACE, GL_REPLACE );
 
 
                 m_upStencilMaskSprite->render( matrix );
 
 
                 // Re-enable color
-                glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+                CRenderDevice::Instance().colorMask( true, true, true, true );
 
                 // Where a 1 was not rendered
-                glStencilFunc( GL_EQUAL, 0x1, 0x1 );
+                CRenderDevice::Instance().stencilFunc( GL_EQUAL, 0x1, 0x1 );
 
                 // Keep the pixel
-                glStencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
+                CRenderDevice::Instance().stencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
 
                 // Disable any writing to the stencil buffer
-                glDepthMask(GL_TRUE);
+                CRenderDevice::Instance().depthMask( true );
 
                 m_spriteDeq[i].render( matrix );
 
                 // Finished using stencil
-                glDisable( GL_STENCIL_TEST );
+                CRenderDevice::Instance().disable( GL_STENCIL_TEST );
             }
             else
                 m_spriteDeq[i].render( matrix );
@@ -28,6 +28,15 @@
 #include <gui/messagecracker.h>
 #include <objectdata/objectdatamanager.h>
 #include <objectdata/objectdata2d.h>
+#include <system/renderdevice.h>
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <cstring>
+#include <algorithm>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -53,7 +62,10 @@ CUIScrollBox::CUIScrollBox( const std::string & group ) :
     m_scrollDistance(0),
     m_endScroll(false),
     m_scrollMsg(false),
-    m_endScrollSelection(false)
+    m_endScrollSelection(false),
+    m_virtual(false),
+    m_itemCount(0),
+    m_marginCount(1)
 {
     m_type = NUIControl::ECT_SCROLL_BOX;
 }
@@ -118,14 +130,59 @@ void CUIScrollBox::loadControlFromNode( const XMLNode & node )
         m_controlHeight = std::atoi( controlInfoNode.getAttribute( "height" ) );
         m_visibleCount = std::atoi( controlInfoNode.getAttribute( "visibleInScrollBox" ) );
 
-        // Get the number of controls in this scroll box
-        const int scrollControlCount = menuControlsNode.nChildNode( "control" );
+        // A virtual scroll box only creates the controls that can be in view
+        // from the first control node and binds them to the items as it scrolls
+        if( controlInfoNode.isAttributeSet( "virtual" ) )
+            m_virtual = ( std::strcmp( controlInfoNode.getAttribute("virtual"), "true" ) == 0 );
+
+        if( m_virtual )
+        {
+            if( controlInfoNode.isAttributeSet( "margin" ) )
+                m_marginCount = std::atoi( controlInfoNode.getAttribute( "margin" ) );
+
+            if( controlInfoNode.isAttributeSet( "itemCount" ) )
+                m_itemCount = std::atoi( controlInfoNode.getAttribute( "itemCount" ) );
+
+            const XMLNode controlNode = menuControlsNode.getChildNode( "control" );
+            if( controlNode.isEmpty() )
+                throw NExcept::CCriticalException("Scroll Box Load Error!",
+                    boost::str( boost::format("Virtual scroll box has no control to recycle (%s).\n\n%s\nLine: %s")
+                        % getName() % __FUNCTION__ % __LINE__ ));
+
+            // The visible controls, the partial one and the margin above and below
+            const int poolCount = m_visibleCount + 1 + (m_marginCount * 2);
+
+            m_pScrollControlVec.reserve( poolCount );
+
+            for( int i = 0; i < poolCount; ++i )
+            {
+                CUIControl * pCtrl = NUIControlFactory::Create( controlNode, getGroup() );
+                m_pScrollControlVec.push_back( pCtrl );
+
+                // The y offset is set when the control is bound to an item
+                pCtrl->setPos( m_initialOffset );
+
+                // Init the control visual state
+                pCtrl->deactivateControl();
+            }
+
+            m_boundItemVec.assign( poolCount, NUIControl::NO_ACTIVE_CONTROL );
+
+            // Calculate the maximum scroll amount in pixels
+            if( m_itemCount > m_visibleCount )
+                m_maxMoveAmount = (m_itemCount - m_visibleCount) * m_controlHeight;
+        }
+        else
+        {
+            // Get the number of controls in this scroll box
+            const int scrollControlCount = menuControlsNode.nChildNode( "control" );
 
-        m_pScrollControlVec.reserve( scrollControlCount );
+            m_pScrollControlVec.reserve( scrollControlCount );
 
-        // Add the scroll control from node
-        for( int i = 0; i < scrollControlCount; ++i )
-            addScrollControlFromNode( menuControlsNode.getChildNode( "control", i ) );
+            // Add the scroll control from node
+            for( int i = 0; i < scrollControlCount; ++i )
+                addScrollControlFromNode( menuControlsNode.getChildNode( "control", i ) );
+        }
     }
 
     // Get the stencil mask node
@@ -148,7 +205,8 @@ void CUIScrollBox::loadControlFromNode( const XMLNode & node )
 /************************************************************************
 *    DESC:  Add the scroll control from node
 *           NOTE: This function recalulates the scroll box members because
-*                 it is also used for run-time dynamic scroll boxes
+*                 it is also used for run-time dynamic scroll boxes.
+*                 A virtual scroll box uses setItemCount instead
 ************************************************************************/
 CUIControl * CUIScrollBox::addScrollControlFromNode( const XMLNode & node )
 {
@@ -211,7 +269,27 @@ void CUIScrollBox::handleEvent( const SDL_Event & rEvent )
     CUISubControl::handleEvent( rEvent );
 
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
-        m_pScrollControlVec[i]->handleEvent( rEvent );
+    {
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+            pCtrl->handleEvent( rEvent );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Does the control, a sub control or a scroll control handle this type of event
+************************************************************************/
+bool CUIScrollBox::isSubscribed( uint32_t type ) const
+{
+    if( CUISubControl::isSubscribed( type ) )
+        return true;
+
+    for( auto iter : m_pScrollControlVec )
+        if( iter->isSubscribed( type ) )
+            return true;
+
+    return false;
 }
 
 
@@ -312,7 +390,11 @@ void CUIScrollBox::update()
 
     // Update all controls
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
-        m_pScrollControlVec[i]->update();
+    {
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+            pCtrl->update();
+    }
 
     // Handle any scrolling
     handleScrollUpdate();
@@ -329,7 +411,11 @@ void CUIScrollBox::transform( const CObject2D & object )
 
     // Transform all controls
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
-        m_pScrollControlVec[i]->transform( *this );
+    {
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+            pCtrl->transform( *this );
+    }
 
     // Transform the mask
     m_upStencilMaskSprite->transform( getMatrix(), wasWorldPosTranformed() );
@@ -345,40 +431,44 @@ void CUIScrollBox::render( const CMatrix & matrix )
     CUISubControl::render( matrix );
 
     // Disable rendering to the color buffer
-    glColorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
+    CRenderDevice::Instance().colorMask( false, false, false, false );
 
     // Disable rendering to the depth mask
-    glDepthMask( GL_FALSE );
+    CRenderDevice::Instance().depthMask( false );
 
     // Start using the stencil
-    glEnable( GL_STENCIL_TEST );
+    CRenderDevice::Instance().enable( GL_STENCIL_TEST );
 
-    glStencilFunc( GL_ALWAYS, 0x1, 0x1 );
-    glStencilOp( GL_REPLACE, GL_REPLACE, GL_REPLACE );
+    CRenderDevice::Instance().stencilFunc( GL_ALWAYS, 0x1, 0x1 );
+    CRenderDevice::Instance().stencilOp( GL_REPLACE, GL_REPLACE, GL_REPLACE );
 
 
     m_upStencilMaskSprite->render( matrix );
 
 
     // Re-enable color
-    glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+    CRenderDevice::Instance().colorMask( true, true, true, true );
 
     // Where a 1 was not rendered
-    glStencilFunc( GL_EQUAL, 0x1, 0x1 );
+    CRenderDevice::Instance().stencilFunc( GL_EQUAL, 0x1, 0x1 );
 
     // Keep the pixel
-    glStencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
+    CRenderDevice::Instance().stencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
 
     // Enable rendering to the depth mask
-    glDepthMask( GL_TRUE );
+    CRenderDevice::Instance().depthMask( true );
 
 
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
-        m_pScrollControlVec[i]->render( matrix );
+    {
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+            pCtrl->render( matrix );
+    }
 
 
     // Finished using stencil
-    glDisable( GL_STENCIL_TEST );
+    CRenderDevice::Instance().disable( GL_STENCIL_TEST );
 }
 
 
@@ -390,9 +480,11 @@ bool CUIScrollBox::activateFirstInactiveControl()
 {
     if( CUIControl::activateFirstInactiveControl() )
     {
-        for( size_t i = 0; i < m_pScrollControlVec.size(); ++i )
+        for( int i = 0; i < getItemCount(); ++i )
         {
-            if( m_pScrollControlVec[i]->activateFirstInactiveControl() )
+            CUIControl * pCtrl = getScrollCtrl(i);
+
+            if( (pCtrl != nullptr) && pCtrl->activateFirstInactiveControl() )
             {
                 m_activeScrollCtrl = i;
                 break;
@@ -448,7 +540,7 @@ void CUIScrollBox::handlePageScroll( int scrollVector )
 
             // Make sure we have some place to page to
             if( (SCROLL_UP && (m_firstScrollCtrlIndex > 0)) ||
-                (SCROLL_DOWN && (m_firstScrollCtrlIndex + m_visibleCount < (int)m_pScrollControlVec.size())) )
+                (SCROLL_DOWN && (m_firstScrollCtrlIndex + m_visibleCount < getItemCount())) )
             {
                 int visibleCount = m_visibleCount;
 
@@ -458,9 +550,9 @@ void CUIScrollBox::handlePageScroll( int scrollVector )
                     visibleCount = m_firstScrollCtrlIndex;
                 }
                 else if( SCROLL_DOWN &&
-                       ((visibleCount + m_firstScrollCtrlIndex + m_visibleCount - 1) >= (int)m_pScrollControlVec.size()) )
+                       ((visibleCount + m_firstScrollCtrlIndex + m_visibleCount - 1) >= getItemCount()) )
                 {
-                    visibleCount = m_pScrollControlVec.size() - m_firstScrollCtrlIndex - m_visibleCount;
+                    visibleCount = getItemCount() - m_firstScrollCtrlIndex - m_visibleCount;
                 }
 
                 // Init the scroll
@@ -469,8 +561,9 @@ void CUIScrollBox::handlePageScroll( int scrollVector )
                 // Deactivate the last control if the scrolling has been activated
                 if( m_scrollVector )
                 {
-                    if( m_activeScrollCtrl != NUIControl::NO_ACTIVE_CONTROL )
-                        m_pScrollControlVec[m_activeScrollCtrl]->deactivateControl();
+                    CUIControl * pCtrl = getScrollCtrl( m_activeScrollCtrl );
+                    if( pCtrl != nullptr )
+                        pCtrl->deactivateControl();
                 }
             }
             else
@@ -532,7 +625,7 @@ CBitmask<uint> CUIScrollBox::selectNextControl( int scrollVector )
         NGenFunc::DispatchEvent(
             NMenu::EGE_MENU_CONTROL_STATE_CHANGE,
             NUIControl::ECS_ACTIVE,
-            (void *)m_pScrollControlVec[m_activeScrollCtrl] );
+            (void *)getScrollCtrl(m_activeScrollCtrl) );
     }
 
     return scrollResult;
@@ -586,9 +679,9 @@ void CUIScrollBox::selectPagedControl( int scrollVector )
         m_activeScrollCtrl = 0;
         scrollVector = 1;
     }
-    else if( m_activeScrollCtrl >= (int)m_pScrollControlVec.size() - 1 )
+    else if( m_activeScrollCtrl >= getItemCount() - 1 )
     {
-        m_activeScrollCtrl = (int)m_pScrollControlVec.size() -1;
+        m_activeScrollCtrl = getItemCount() -1;
         scrollVector = -1;
     }
 
@@ -607,8 +700,9 @@ bool CUIScrollBox::setActiveCtrlToViewableArea( int scrollVector )
     // If the active control is not within the active area, make it so that it will be the first one selected
     if( (m_activeScrollCtrl < m_firstScrollCtrlIndex) || (m_activeScrollCtrl >= (m_firstScrollCtrlIndex + m_visibleCount)) )
     {
-        if( m_activeScrollCtrl != NUIControl::NO_ACTIVE_CONTROL )
-            m_pScrollControlVec[m_activeScrollCtrl]->deactivateControl();
+        CUIControl * pCtrl = getScrollCtrl( m_activeScrollCtrl );
+        if( pCtrl != nullptr )
+            pCtrl->deactivateControl();
 
         m_activeScrollCtrl = m_firstScrollCtrlIndex;
 
@@ -664,14 +758,14 @@ CBitmask<uint> CUIScrollBox::scrollToTheNextCtrlInViewableArea( int scrollVector
 ************************************************************************/
 bool CUIScrollBox::activateScrollCtrl( int scrollControlIndex )
 {
-    if( (scrollControlIndex != NUIControl::NO_ACTIVE_CONTROL) &&
-        (scrollControlIndex < (int)m_pScrollControlVec.size()) &&
-        !m_pScrollControlVec.at(scrollControlIndex)->isDisabled() )
+    CUIControl * pCtrl = getScrollCtrl( scrollControlIndex );
+
+    if( (pCtrl != nullptr) && !pCtrl->isDisabled() )
     {
         NGenFunc::DispatchEvent(
             NMenu::EGE_MENU_CONTROL_STATE_CHANGE,
             NUIControl::ECS_ACTIVE,
-            (void *)m_pScrollControlVec[scrollControlIndex] );
+            (void *)pCtrl );
 
         return true;
     }
@@ -792,7 +886,11 @@ CUIControl * CUIScrollBox::findSubControl( const std::string & name )
     CUIControl * pCtrl = CUISubControl::findSubControl( name );
 
     for( int i = m_visStartPos; i < m_visEndPos && (pCtrl == nullptr); ++i )
-        pCtrl = m_pScrollControlVec[i]->findControl( name );
+    {
+        CUIControl * pScrollCtrl = getScrollCtrl(i);
+        if( pScrollCtrl != nullptr )
+            pCtrl = pScrollCtrl->findControl( name );
+    }
 
     return pCtrl;
 }
@@ -806,8 +904,11 @@ CUIControl * CUIScrollBox::findSubControl( void * pVoid )
     CUIControl * pCtrl = CUISubControl::findSubControl( pVoid );
 
     for( int i = m_visStartPos; i < m_visEndPos && (pCtrl == nullptr); ++i )
-        if( (void *)m_pScrollControlVec[i] == pVoid )
-            pCtrl = m_pScrollControlVec[i];
+    {
+        CUIControl * pScrollCtrl = getScrollCtrl(i);
+        if( (pScrollCtrl != nullptr) && ((void *)pScrollCtrl == pVoid) )
+            pCtrl = pScrollCtrl;
+    }
 
     return pCtrl;
 }
@@ -825,7 +926,9 @@ bool CUIScrollBox::onSubControlMouseMove( const SDL_Event & rEvent )
     {
         for( int i = m_visStartPos; i < m_visEndPos && !result; ++i )
         {
-            result = m_pScrollControlVec[i]->onMouseMove( rEvent );
+            CUIControl * pCtrl = getScrollCtrl(i);
+            if( pCtrl != nullptr )
+                result = pCtrl->onMouseMove( rEvent );
 
             if( result )
                 m_activeScrollCtrl = i;
@@ -844,7 +947,11 @@ void CUIScrollBox::deactivateSubControl()
     CUISubControl::deactivateSubControl();
 
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
-        m_pScrollControlVec[i]->deactivateControl();
+    {
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+            pCtrl->deactivateControl();
+    }
 }
 
 
@@ -865,8 +972,12 @@ void CUIScrollBox::setStartEndPos()
     if( m_visStartPos < 0 )
         m_visStartPos = 0;
 
-    if( m_visEndPos > static_cast<int>(m_pScrollControlVec.size()) )
-        m_visEndPos = static_cast<int>(m_pScrollControlVec.size());
+    if( m_visEndPos > getItemCount() )
+        m_visEndPos = getItemCount();
+
+    // Rebind the recycled controls that scrolled into view
+    if( m_virtual )
+        bindScrollControls();
 }
 
 
@@ -877,9 +988,13 @@ void CUIScrollBox::repositionScrollControls()
 {
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
     {
-        CPoint<float> pos( m_pScrollControlVec[i]->getPos() );
-        pos.y = m_defaultOffsetVec[i] + m_scrollCurPos;
-        m_pScrollControlVec[i]->setPos( pos );
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+        {
+            CPoint<float> pos( pCtrl->getPos() );
+            pos.y = getDefaultOffset(i) + m_scrollCurPos;
+            pCtrl->setPos( pos );
+        }
     }
 }
 
@@ -894,8 +1009,8 @@ void CUIScrollBox::alignScrollPostion()
     if( m_firstScrollCtrlIndex < 0 )
         m_firstScrollCtrlIndex = 0;
 
-    else if( (m_firstScrollCtrlIndex + m_visibleCount) > static_cast<int>(m_pScrollControlVec.size()) )
-        m_firstScrollCtrlIndex = static_cast<int>(m_pScrollControlVec.size() - m_visibleCount);
+    else if( (m_firstScrollCtrlIndex + m_visibleCount) > getItemCount() )
+        m_firstScrollCtrlIndex = getItemCount() - m_visibleCount;
 
     // Recalucate the scroll position which will wipe the fractional component
     m_scrollCurPos = m_firstScrollCtrlIndex * m_controlHeight;
@@ -913,6 +1028,7 @@ void CUIScrollBox::deactivateControl()
 
 /************************************************************************
 *    DESC:  Get the scroll control vector
+*           NOTE: For a virtual scroll box these are the recycled controls
 ************************************************************************/
 const std::vector<CUIControl *> & CUIScrollBox::getScrollCtrlVec()
 {
@@ -920,6 +1036,159 @@ const std::vector<CUIControl *> & CUIScrollBox::getScrollCtrlVec()
 } 
 
 
+/************************************************************************
+*    DESC:  Set the number of items in a virtual scroll box
+*           All the controls in view are bound again because the
+*           items they were bound to may have changed
+************************************************************************/
+void CUIScrollBox::setItemCount( int count )
+{
+    if( !m_virtual )
+        throw NExcept::CCriticalException("Scroll Box Error!",
+            boost::str( boost::format("Item count can only be set on a virtual scroll box (%s).\n\n%s\nLine: %s")
+                % getName() % __FUNCTION__ % __LINE__ ));
+
+    m_itemCount = count;
+
+    // Calculate the maximum scroll amount in pixels
+    m_maxMoveAmount = 0;
+    if( m_itemCount > m_visibleCount )
+        m_maxMoveAmount = (m_itemCount - m_visibleCount) * m_controlHeight;
+
+    // Keep the scroll position within the items
+    if( m_scrollCurPos > m_maxMoveAmount )
+        m_scrollCurPos = m_maxMoveAmount;
+
+    NGenFunc::DynCast<CUISlider>(getSubControl())->setMaxValue(m_maxMoveAmount);
+    NGenFunc::DynCast<CUISlider>(getSubControl())->setSlider(m_scrollCurPos);
+
+    if( m_activeScrollCtrl >= m_itemCount )
+        m_activeScrollCtrl = NUIControl::NO_ACTIVE_CONTROL;
+
+    // Unbind all the controls so that they bind again
+    std::fill( m_boundItemVec.begin(), m_boundItemVec.end(), NUIControl::NO_ACTIVE_CONTROL );
+
+    // Set the bounds
+    setStartEndPos();
+
+    // Reposition the scroll controls
+    repositionScrollControls();
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of items or scroll controls
+************************************************************************/
+int CUIScrollBox::getItemCount() const
+{
+    if( m_virtual )
+        return m_itemCount;
+
+    return m_pScrollControlVec.size();
+}
+
+
+/************************************************************************
+*    DESC:  Get the item the scroll control is bound to
+*           Returns NO_ACTIVE_CONTROL if it's not a scroll control
+************************************************************************/
+int CUIScrollBox::getBoundItem( const CUIControl * pCtrl ) const
+{
+    auto iter = std::find( m_pScrollControlVec.begin(), m_pScrollControlVec.end(), pCtrl );
+    if( iter == m_pScrollControlVec.end() )
+        return NUIControl::NO_ACTIVE_CONTROL;
+
+    const int index = iter - m_pScrollControlVec.begin();
+
+    if( m_virtual )
+        return m_boundItemVec[index];
+
+    return index;
+}
+
+
+/************************************************************************
+*    DESC:  Connect to the bind item signal
+*           The slot sets up the control for the item. The control is
+*           enabled and inactive when the slot is called
+************************************************************************/
+void CUIScrollBox::connect_bindItem( const BindItemSignal::slot_type & slot )
+{
+    m_bindItemSignal.connect(slot);
+}
+
+
+/************************************************************************
+*    DESC:  Get the scroll control of the item
+*           Returns nullptr if no control is bound to the item
+************************************************************************/
+CUIControl * CUIScrollBox::getScrollCtrl( int index ) const
+{
+    if( m_virtual )
+    {
+        if( (index >= 0) && (index < m_itemCount) )
+        {
+            const size_t slot = index % m_pScrollControlVec.size();
+
+            if( m_boundItemVec[slot] == index )
+                return m_pScrollControlVec[slot];
+        }
+
+        return nullptr;
+    }
+
+    if( (index >= 0) && (index < static_cast<int>(m_pScrollControlVec.size())) )
+        return m_pScrollControlVec[index];
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Bind the controls of the virtual scroll box to the items in view
+*           Each item has a fixed control slot and there are enough
+*           controls that the items in view and the margin never share one
+************************************************************************/
+void CUIScrollBox::bindScrollControls()
+{
+    const int start = std::max( m_visStartPos - m_marginCount, 0 );
+    const int end = std::min( m_visEndPos + m_marginCount, m_itemCount );
+
+    for( int i = start; i < end; ++i )
+    {
+        const size_t slot = i % m_pScrollControlVec.size();
+
+        if( m_boundItemVec[slot] != i )
+        {
+            CUIControl * pCtrl = m_pScrollControlVec[slot];
+            m_boundItemVec[slot] = i;
+
+            // Clear the state left over from the last item
+            pCtrl->enableControl();
+            pCtrl->deactivateControl();
+
+            CPoint<float> pos( pCtrl->getPos() );
+            pos.y = getDefaultOffset(i) + m_scrollCurPos;
+            pCtrl->setPos( pos );
+
+            m_bindItemSignal( pCtrl, i );
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the default y offset of the item
+************************************************************************/
+float CUIScrollBox::getDefaultOffset( int index ) const
+{
+    if( m_virtual )
+        return m_initialOffset.y - (float)(m_controlHeight * index);
+
+    return m_defaultOffsetVec[index];
+}
+
+
 /************************************************************************
 *    DESC:  Set the alpha value of this control
 ************************************************************************/
@@ -928,7 +1197,11 @@ void CUIScrollBox::setAlpha( float alpha )
     CUISubControl::setAlpha( alpha );
 
     for( int i = m_visStartPos; i < m_visEndPos; ++i )
-        m_pScrollControlVec[i]->setAlpha( alpha );
+    {
+        CUIControl * pCtrl = getScrollCtrl(i);
+        if( pCtrl != nullptr )
+            pCtrl->setAlpha( alpha );
+    }
 }
 
 
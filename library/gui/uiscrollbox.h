@@ -17,6 +17,9 @@
 #include <utilities/bitmask.h>
 #include <2d/sprite2d.h>
 
+// Boost lib dependencies
+#include <boost/signals2.hpp>
+
 // Standard lib dependencies
 #include <vector>
 #include <memory>
@@ -28,6 +31,9 @@ class CUIScrollBox : public CUISubControl
 {
 public:
 
+    // Boost signal definition
+    typedef boost::signals2::signal<void (CUIControl *, int)> BindItemSignal;
+
     // Constructor
     CUIScrollBox( const std::string & group );
 
@@ -48,6 +54,9 @@ public:
     
     // Handle events
     void handleEvent( const SDL_Event & rEvent ) override;
+    
+    // Does the control, a sub control or a scroll control handle this type of event
+    bool isSubscribed( uint32_t type ) const override;
 
     // Transform the control
     void transform( const CObject2D & object ) override;
@@ -67,6 +76,18 @@ public:
     // Get the scroll control vector
     const std::vector<CUIControl *> & getScrollCtrlVec();
     
+    // Set the number of items in a virtual scroll box
+    void setItemCount( int count );
+    
+    // Get the number of items or scroll controls
+    int getItemCount() const;
+    
+    // Get the item the scroll control is bound to
+    int getBoundItem( const CUIControl * pCtrl ) const;
+    
+    // Connect to the bind item signal
+    void connect_bindItem( const BindItemSignal::slot_type & slot );
+    
     // Set the alpha value of this menu
     void setAlpha( float alpha ) override;
     
@@ -119,9 +140,18 @@ protected:
     
     // Reposition the scroll controls
     void repositionScrollControls();
+    
+    // Get the scroll control of the item
+    CUIControl * getScrollCtrl( int index ) const;
 
 private:
     
+    // Bind the controls of the virtual scroll box to the items in view
+    void bindScrollControls();
+    
+    // Get the default y offset of the item
+    float getDefaultOffset( int index ) const;
+    
     // Handle the time based Scrolling of the contents of the scroll box
     void handleScrollUpdate();
     
@@ -222,6 +252,21 @@ private:
     
     // Flag to allow for end scroll selection
     bool m_endScrollSelection;
+    
+    // Flag to indicate the scroll controls are recycled and bound to items
+    bool m_virtual;
+    
+    // Number of items in a virtual scroll box
+    int m_itemCount;
+    
+    // Number of controls kept bound above and below the visible ones
+    int m_marginCount;
+    
+    // The item each recycled scroll control is bound to
+    std::vector<int> m_boundItemVec;
+    
+    // Boost signals
+    BindItemSignal m_bindItemSignal;
 
 };
 
@@ -445,6 +445,57 @@ void CUISubControl::reset( bool complete )
 }
 
 
+/************************************************************************
+*    DESC:  Does the control or a sub control handle this type of event
+************************************************************************/
+bool CUISubControl::isSubscribed( uint32_t type ) const
+{
+    if( CUIControl::isSubscribed( type ) )
+        return true;
+
+    // The action, scroll and tab messages are handled when active
+    if( ((type >= NMenu::EGE_MENU_UP_ACTION) && (type <= NMenu::EGE_MENU_RIGHT_ACTION)) ||
+        ((type >= NMenu::EGE_MENU_SCROLL_UP) && (type <= NMenu::EGE_MENU_SCROLL_RIGHT)) ||
+        (type == NMenu::EGE_MENU_TAB_LEFT) ||
+        (type == NMenu::EGE_MENU_TAB_RIGHT) )
+        return true;
+
+    for( auto iter : m_pSubControlVec )
+        if( iter->isSubscribed( type ) )
+            return true;
+
+    return false;
+}
+
+
+/************************************************************************
+*    DESC:  Add the screen area of the control and the sub controls to the rect
+************************************************************************/
+void CUISubControl::addHitArea( CRect<float> & rect ) const
+{
+    CUIControl::addHitArea( rect );
+
+    for( auto iter : m_pSubControlVec )
+        iter->addHitArea( rect );
+}
+
+
+/************************************************************************
+*    DESC:  Was the hit area of the control or a sub control moved by the last transform
+************************************************************************/
+bool CUISubControl::wasHitAreaTransformed() const
+{
+    if( CUIControl::wasHitAreaTransformed() )
+        return true;
+
+    for( auto iter : m_pSubControlVec )
+        if( iter->wasHitAreaTransformed() )
+            return true;
+
+    return false;
+}
+
+
 /************************************************************************
 *    DESC:  Handle the mouse move
 ************************************************************************/
@@ -48,6 +48,15 @@ public:
 
     // Handle events
     virtual void handleEvent( const SDL_Event & rEvent ) override;
+    
+    // Does the control or a sub control handle this type of event
+    virtual bool isSubscribed( uint32_t type ) const override;
+    
+    // Add the screen area of the control and the sub controls to the rect
+    virtual void addHitArea( CRect<float> & rect ) const override;
+    
+    // Was the hit area of the control or a sub control moved by the last transform
+    virtual bool wasHitAreaTransformed() const override;
 
     // Reset the control to inactive if its not disabled
     virtual void reset( bool complete = false ) override;
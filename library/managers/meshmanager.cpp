@@ -25,6 +25,7 @@
 #include <common/uv.h>
 #include <common/texture.h>
 #include <common/vertex3d.h>
+#include <system/renderdevice.h>
 
 // SDL lib dependencies
 #include <SDL.h>
@@ -56,8 +57,8 @@ CMeshMgr::~CMeshMgr()
         {
             for( auto & iter : mapIter.second.getMeshVec() )
             {
-                glDeleteBuffers( 1, &iter.m_ibo );
-                glDeleteBuffers( 1, &iter.m_vbo );
+                CRenderDevice::Instance().deleteBuffer( iter.m_ibo );
+                CRenderDevice::Instance().deleteBuffer( iter.m_vbo );
             }
         }
     }
@@ -308,20 +309,20 @@ void CMeshMgr::createFromData(
     for( auto & iter : meshVec )
     {
         // Create the VBO
-        glGenBuffers( 1, &iter.m_vbo );
-        glBindBuffer( GL_ARRAY_BUFFER, iter.m_vbo );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CVertex3D)*iter.m_faceGroup.vertexBufCount, iter.m_spVBO.get(), GL_STATIC_DRAW );
+        iter.m_vbo = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, iter.m_vbo );
+        CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, sizeof(CVertex3D)*iter.m_faceGroup.vertexBufCount, iter.m_spVBO.get(), GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
 
         // Create the IBO - It's saved in the binary file as needed. Don't need to build it.
-        glGenBuffers( 1, &iter.m_ibo );
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iter.m_ibo );
-        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * iter.m_faceGroup.indexBufCount, iter.m_spIndexBuf.get(), GL_STATIC_DRAW );
+        iter.m_ibo = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, iter.m_ibo );
+        CRenderDevice::Instance().bufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * iter.m_faceGroup.indexBufCount, iter.m_spIndexBuf.get(), GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 
         // Reserve texture space
         iter.m_textureVec.reserve(iter.m_faceGroup.textureCount);
@@ -395,20 +396,20 @@ void CMeshMgr::loadFromFile(
         }
 
         // Create the VBO
-        glGenBuffers( 1, &mesh3d.back().m_vbo );
-        glBindBuffer( GL_ARRAY_BUFFER, mesh3d.back().m_vbo );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CVertex3D_no_txt)*mesh.m_faceGroup.vertexBufCount, mesh.m_spVBONoTxt.get(), GL_STATIC_DRAW );
+        mesh3d.back().m_vbo = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, mesh3d.back().m_vbo );
+        CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, sizeof(CVertex3D_no_txt)*mesh.m_faceGroup.vertexBufCount, mesh.m_spVBONoTxt.get(), GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
 
         // Create the IBO - It's saved in the binary file as needed. Don't need to build it.
-        glGenBuffers( 1, &mesh3d.back().m_ibo );
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, mesh3d.back().m_ibo );
-        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * mesh.m_faceGroup.indexBufCount, mesh.m_spIndexBuf.get(), GL_STATIC_DRAW );
+        mesh3d.back().m_ibo = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, mesh3d.back().m_ibo );
+        CRenderDevice::Instance().bufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * mesh.m_faceGroup.indexBufCount, mesh.m_spIndexBuf.get(), GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 
         // Save the number of indexes in the IBO buffer - Will need this for the render call
         mesh3d.back().m_iboCount = mesh.m_faceGroup.indexBufCount;;
@@ -508,8 +509,8 @@ void CMeshMgr::deleteBufferGroup( const std::string & group )
         {
             for( auto & iter : mapIter.second.getMeshVec() )
             {
-                glDeleteBuffers( 1, &iter.m_ibo );
-                glDeleteBuffers( 1, &iter.m_vbo );
+                CRenderDevice::Instance().deleteBuffer( iter.m_ibo );
+                CRenderDevice::Instance().deleteBuffer( iter.m_vbo );
             }
         }
 
@@ -18,6 +18,7 @@
 // Game lib dependencies
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
+#include <system/renderdevice.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -93,6 +94,10 @@ void CShaderMgr::createShader( const XMLNode & node )
     // This is to aid in cleanup in the event of an error
     m_Iter = m_shaderMap.emplace( shaderStrId, CShaderData() ).first;
 
+    // Shader to switch to when sprites using this one are batched
+    if( node.isAttributeSet("batchShaderId") )
+        m_Iter->second.setBatchShaderID( node.getAttribute("batchShaderId") );
+
     // Create the vertex shader
     createShader( GL_VERTEX_SHADER, vertexNode.getAttribute("file") );
 
@@ -122,7 +127,7 @@ void CShaderMgr::createShader( const XMLNode & node )
 void CShaderMgr::createShader( uint32_t shaderType, const std::string & filePath )
 {
     // Create the shader
-    uint32_t shaderID = glCreateShader( shaderType );
+    uint32_t shaderID = CRenderDevice::Instance().createShader( shaderType );
     if( shaderID == 0 )
     {
         throw NExcept::CCriticalException("Create Shader Error!",
@@ -138,21 +143,19 @@ void CShaderMgr::createShader( uint32_t shaderType, const std::string & filePath
     // Load the shader from file
     std::shared_ptr<char> spChar = NGenFunc::FileToBuf( filePath );
     const char * pChar = spChar.get();
-    glShaderSource( shaderID, 1, &pChar, nullptr );
+    CRenderDevice::Instance().shaderSource( shaderID, pChar );
 
     // Compile shader source
-    glCompileShader( shaderID );
+    CRenderDevice::Instance().compileShader( shaderID );
 
     // Check shader for errors
-    int32_t success( GL_FALSE );
-    glGetShaderiv( shaderID, GL_COMPILE_STATUS, &success );
+    int32_t success( CRenderDevice::Instance().getShader( shaderID, GL_COMPILE_STATUS ) );
     if( success != GL_TRUE )
     {
-        int32_t maxLength = 0;
-        glGetShaderiv(shaderID, GL_INFO_LOG_LENGTH, &maxLength);
+        int32_t maxLength = CRenderDevice::Instance().getShader( shaderID, GL_INFO_LOG_LENGTH );
 
         std::unique_ptr<char[]> upError( new char[maxLength] );
-        glGetShaderInfoLog(shaderID, maxLength, &maxLength, upError.get());
+        CRenderDevice::Instance().getShaderInfoLog( shaderID, maxLength, &maxLength, upError.get() );
 
         throw NExcept::CCriticalException("Create Vertex Shader Error!",
             boost::str( boost::format("Error compiling vertex shader (%s).\n\n%s.\n\n%s\nLine: %s")
@@ -167,7 +170,7 @@ void CShaderMgr::createShader( uint32_t shaderType, const std::string & filePath
 void CShaderMgr::createProgram()
 {
     // Create the program - OpenGL shaders are called programs
-    m_Iter->second.setProgramID( glCreateProgram() );
+    m_Iter->second.setProgramID( CRenderDevice::Instance().createProgram() );
     if( m_Iter->second.getProgramID() == 0 )
     {
         throw NExcept::CCriticalException("Create Shader Error!",
@@ -176,8 +179,8 @@ void CShaderMgr::createProgram()
     }
 
     // Attach shaders to the program
-    glAttachShader( m_Iter->second.getProgramID(), m_Iter->second.getVertexID() );
-    glAttachShader( m_Iter->second.getProgramID(), m_Iter->second.getFragmentID() );
+    CRenderDevice::Instance().attachShader( m_Iter->second.getProgramID(), m_Iter->second.getVertexID() );
+    CRenderDevice::Instance().attachShader( m_Iter->second.getProgramID(), m_Iter->second.getFragmentID() );
 }
 
 
@@ -202,9 +205,9 @@ void CShaderMgr::bindAttributeLocation( const XMLNode & vertexNode )
             m_Iter->second.setAttributeLocation( attributeName, location );
 
             // Bind a constant attribute location for positions of vertices
-            glBindAttribLocation( m_Iter->second.getProgramID(), (uint32_t)location, attributeName.c_str() );
+            CRenderDevice::Instance().bindAttribLocation( m_Iter->second.getProgramID(), (uint32_t)location, attributeName.c_str() );
 
-            uint32_t error(glGetError());
+            uint32_t error(CRenderDevice::Instance().getError());
             if( error != GL_NO_ERROR)
                 throw NExcept::CCriticalException("Create Shader Error!",
                     boost::str( boost::format("Error binding attribute (%s).\n\n%s\nLine: %s")
@@ -220,11 +223,10 @@ void CShaderMgr::bindAttributeLocation( const XMLNode & vertexNode )
 void CShaderMgr::linkProgram()
 {
     // Link shader program
-    glLinkProgram( m_Iter->second.getProgramID() );
+    CRenderDevice::Instance().linkProgram( m_Iter->second.getProgramID() );
 
     // Check for errors
-    int32_t success( GL_TRUE );
-    glGetProgramiv( m_Iter->second.getProgramID(), GL_LINK_STATUS, &success );
+    int32_t success( CRenderDevice::Instance().getProgram( m_Iter->second.getProgramID(), GL_LINK_STATUS ) );
     if( success != GL_TRUE )
     {
         throw NExcept::CCriticalException("Link Shader Error!",
@@ -263,7 +265,7 @@ void CShaderMgr::getUniformLocation( const XMLNode & node )
 {
     std::string name = node.getAttribute("name");
 
-    int32_t location = glGetUniformLocation( m_Iter->second.getProgramID(), name.c_str() );
+    int32_t location = CRenderDevice::Instance().getUniformLocation( m_Iter->second.getProgramID(), name.c_str() );
 
     m_Iter->second.setUniformLocation( name, location );
 
@@ -309,7 +311,7 @@ void CShaderMgr::bind( CShaderData * pShaderData )
             m_currentVertexAttribCount = pShaderData->getVertexAttribCount();
 
             for( size_t i = 0; i < m_currentVertexAttribCount; ++i )
-                glEnableVertexAttribArray(i);
+                CRenderDevice::Instance().enableVertexAttribArray(i);
         }
         else if( m_currentVertexAttribCount != pShaderData->getVertexAttribCount() )
         {
@@ -318,12 +320,12 @@ void CShaderMgr::bind( CShaderData * pShaderData )
             if( m_currentVertexAttribCount < attribCount )
             {
                 for( size_t i = m_currentVertexAttribCount; i < attribCount; ++i )
-                    glEnableVertexAttribArray(i);
+                    CRenderDevice::Instance().enableVertexAttribArray(i);
             }
             else
             {
                 for( size_t i = attribCount; i < m_currentVertexAttribCount; ++i )
-                    glDisableVertexAttribArray(i);
+                    CRenderDevice::Instance().disableVertexAttribArray(i);
             }
 
             m_currentVertexAttribCount = attribCount;
@@ -333,7 +335,7 @@ void CShaderMgr::bind( CShaderData * pShaderData )
         m_pCurrentShaderData = pShaderData;
 
         // Have OpenGL bind this shader now
-        glUseProgram( pShaderData->getProgramID() );
+        CRenderDevice::Instance().useProgram( pShaderData->getProgramID() );
     }
 }
 
@@ -344,11 +346,11 @@ void CShaderMgr::bind( CShaderData * pShaderData )
 void CShaderMgr::unbind()
 {
     for( size_t i = 0; i < m_currentVertexAttribCount; ++i )
-        glDisableVertexAttribArray(i);
+        CRenderDevice::Instance().disableVertexAttribArray(i);
 
     m_pCurrentShaderData = nullptr;
     m_currentVertexAttribCount = 0;
-    glUseProgram( 0 );
+    CRenderDevice::Instance().useProgram( 0 );
 }
 
 
@@ -403,11 +405,15 @@ void CShaderMgr::setShaderColor( CShaderData & shaderData, const std::string & l
         bind( &shaderData );
 
         // Set the color
-        glUniform4fv( location, 1, (float *)&color );
+        CRenderDevice::Instance().uniform4fv( location, 1, (float *)&color );
 
         // Unbind now that we are done
         unbind();
     }
+
+    // Keep the batch version of this shader in sync
+    if( !shaderData.getBatchShaderID().empty() )
+        setShaderColor( getShaderData( shaderData.getBatchShaderID() ), locationId, color );
 }
 
 
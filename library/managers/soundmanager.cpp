@@ -14,6 +14,7 @@
 #include <utilities/genfunc.h>
 #include <utilities/settings.h>
 #include <common/defs.h>
+#include <utilities/profiler.h>
 
 // SDL lib dependencies
 #include <SDL_mixer.h>
@@ -78,6 +79,8 @@ CSoundMgr::~CSoundMgr()
 ************************************************************************/
 void CSoundMgr::loadGroup( const std::string & group )
 {
+    PROFILE_ZONE( "CSoundMgr::loadGroup" );
+
     // Make sure the group we are looking has been defined in the list table file
     auto listTableIter = m_listTableMap.find( group );
     if( listTableIter == m_listTableMap.end() )
@@ -0,0 +1,225 @@
+/************************************************************************
+*    FILE NAME:       spritebatchmanager.cpp
+*
+*    DESCRIPTION:     sprite batch manager class singleton
+*                     Owns the frame's sprite batch and executes it's
+*                     recorded commands with OpenGL using one streaming
+*                     vertex buffer and a shared quad index buffer.
+************************************************************************/
+
+#if defined(__IOS__) || defined(__ANDROID__) || defined(__arm__)
+#include "SDL_opengles2.h"
+#else
+#include <GL/glew.h>     // Glew dependencies (have to be defined first)
+#include <SDL_opengl.h>  // SDL/OpenGL lib dependencies
+#endif
+
+// Physical component dependency
+#include <managers/spritebatchmanager.h>
+
+// Game lib dependencies
+#include <managers/shadermanager.h>
+#include <managers/texturemanager.h>
+#include <managers/vertexbuffermanager.h>
+#include <common/shaderdata.h>
+#include <common/batchvertex2d.h>
+#include <utilities/matrix.h>
+#include <system/renderdevice.h>
+
+// Standard lib dependencies
+#include <vector>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSpriteBatchMgr::CSpriteBatchMgr() :
+    m_beginCount(0),
+    m_vbo(0),
+    m_vboSize(0),
+    m_ibo(0),
+    m_vertexLocation(-1),
+    m_uvLocation(-1),
+    m_colorLocation(-1),
+    m_text0Location(-1),
+    m_matrixLocation(-1)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CSpriteBatchMgr::~CSpriteBatchMgr()
+{
+    if( m_vbo > 0 )
+        CRenderDevice::Instance().deleteBuffer( m_vbo );
+
+    if( m_ibo > 0 )
+        CRenderDevice::Instance().deleteBuffer( m_ibo );
+}
+
+
+/************************************************************************
+*    DESC:  Start collecting sprites. Calls can be nested
+************************************************************************/
+void CSpriteBatchMgr::begin()
+{
+    ++m_beginCount;
+}
+
+
+/************************************************************************
+*    DESC:  Stop collecting sprites
+*           The batch is rendered by the outer most call
+************************************************************************/
+void CSpriteBatchMgr::end()
+{
+    if( (m_beginCount > 0) && (--m_beginCount == 0) )
+        flush();
+}
+
+
+/************************************************************************
+*    DESC:  Are the sprites being collected
+************************************************************************/
+bool CSpriteBatchMgr::isActive() const
+{
+    return (m_beginCount > 0);
+}
+
+
+/************************************************************************
+*    DESC:  Get the batch to add to
+************************************************************************/
+CSpriteBatch2D & CSpriteBatchMgr::getBatch()
+{
+    return m_batch;
+}
+
+
+/************************************************************************
+*    DESC:  Render what has been collected so far
+*           Called before a sprite that can't be batched is rendered
+*           so the draw order is kept
+************************************************************************/
+void CSpriteBatchMgr::flush()
+{
+    if( !m_batch.isEmpty() )
+        m_batch.flush( *this );
+}
+
+
+/************************************************************************
+*    DESC:  Upload the vertices for all the commands that follow
+*           The buffer is orphaned so the driver doesn't have to wait
+*           on the last frame's draws
+************************************************************************/
+void CSpriteBatchMgr::upload( const CBatchVertex2D * pVert, size_t vertCount )
+{
+    if( m_vbo == 0 )
+        m_vbo = CRenderDevice::Instance().genBuffer();
+
+    if( m_ibo == 0 )
+        createIBO();
+
+    CVertBufMgr::Instance().bind( m_vbo, m_ibo );
+
+    const size_t size = sizeof(CBatchVertex2D) * vertCount;
+
+    // Grow by doubling so the size settles after a few frames
+    if( size > m_vboSize )
+    {
+        while( m_vboSize < size )
+            m_vboSize = (m_vboSize == 0) ? size : m_vboSize * 2;
+    }
+
+    CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, m_vboSize, nullptr, GL_STREAM_DRAW );
+    CRenderDevice::Instance().bufferSubData( GL_ARRAY_BUFFER, 0, size, pVert );
+}
+
+
+/************************************************************************
+*    DESC:  Bind the shader
+************************************************************************/
+void CSpriteBatchMgr::bindShader( CShaderData * pShaderData )
+{
+    CShaderMgr::Instance().bind( pShaderData );
+
+    m_vertexLocation = pShaderData->getAttributeLocation( "in_position" );
+    m_uvLocation = pShaderData->getAttributeLocation( "in_uv" );
+    m_colorLocation = pShaderData->getAttributeLocation( "in_color" );
+    m_text0Location = pShaderData->getUniformLocation( "text0" );
+    m_matrixLocation = pShaderData->getUniformLocation( "cameraViewProjMatrix" );
+
+    CRenderDevice::Instance().uniform1i( m_text0Location, 0 ); // 0 = TEXTURE0
+}
+
+
+/************************************************************************
+*    DESC:  Bind the texture
+************************************************************************/
+void CSpriteBatchMgr::bindTexture( uint32_t textureID )
+{
+    CTextureMgr::Instance().bind( textureID );
+}
+
+
+/************************************************************************
+*    DESC:  Set the view projection matrix
+************************************************************************/
+void CSpriteBatchMgr::setMatrix( const CMatrix & matrix )
+{
+    CRenderDevice::Instance().uniformMatrix4fv( m_matrixLocation, 1, false, matrix() );
+}
+
+
+/************************************************************************
+*    DESC:  Draw a range of quads from the uploaded vertices
+*           There is no base vertex in GLES 2 so the attribute
+*           pointers are offset to the first quad instead
+************************************************************************/
+void CSpriteBatchMgr::drawQuads( uint32_t first, uint32_t count )
+{
+    const int32_t VERTEX_BUF_SIZE( sizeof(CBatchVertex2D) );
+    const size_t offset( sizeof(CBatchVertex2D) * 4 * first );
+    const size_t UV_OFFSET( sizeof(CPoint<float>) );
+    const size_t COLOR_OFFSET( sizeof(CPoint<float>) + sizeof(CUV) );
+
+    CVertBufMgr::Instance().bind( m_vbo, m_ibo );
+
+    CRenderDevice::Instance().vertexAttribPointer( m_vertexLocation, 3, GL_FLOAT, false, VERTEX_BUF_SIZE, offset );
+    CRenderDevice::Instance().vertexAttribPointer( m_uvLocation, 2, GL_FLOAT, false, VERTEX_BUF_SIZE, offset + UV_OFFSET );
+    CRenderDevice::Instance().vertexAttribPointer( m_colorLocation, 4, GL_FLOAT, false, VERTEX_BUF_SIZE, offset + COLOR_OFFSET );
+
+    CRenderDevice::Instance().drawElements( GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT );
+}
+
+
+/************************************************************************
+*    DESC:  Create the index buffer shared by all the draws
+*           The quads are added in triangle fan order
+************************************************************************/
+void CSpriteBatchMgr::createIBO()
+{
+    std::vector<uint16_t> indexVec;
+    indexVec.reserve( CSpriteBatch2D::MAX_QUADS_PER_DRAW * 6 );
+
+    for( uint16_t i = 0; i < CSpriteBatch2D::MAX_QUADS_PER_DRAW; ++i )
+    {
+        const uint16_t vertIndex = i * 4;
+
+        indexVec.push_back( vertIndex );
+        indexVec.push_back( vertIndex+1 );
+        indexVec.push_back( vertIndex+2 );
+
+        indexVec.push_back( vertIndex );
+        indexVec.push_back( vertIndex+2 );
+        indexVec.push_back( vertIndex+3 );
+    }
+
+    m_ibo = CRenderDevice::Instance().genBuffer();
+
+    CVertBufMgr::Instance().bind( m_vbo, m_ibo );
+
+    CRenderDevice::Instance().bufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * indexVec.size(), indexVec.data(), GL_STATIC_DRAW );
+}
@@ -0,0 +1,102 @@
+/************************************************************************
+*    FILE NAME:       spritebatchmanager.h
+*
+*    DESCRIPTION:     sprite batch manager class singleton
+*                     Owns the frame's sprite batch and executes it's
+*                     recorded commands with OpenGL using one streaming
+*                     vertex buffer and a shared quad index buffer.
+************************************************************************/
+
+#ifndef __sprite_batch_manager_h__
+#define __sprite_batch_manager_h__
+
+// Physical component dependency
+#include <common/irendercmdstream.h>
+
+// Game lib dependencies
+#include <2d/spritebatch2d.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <cstdint>
+
+class CSpriteBatchMgr : public iRenderCmdStream, boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CSpriteBatchMgr & Instance()
+    {
+        static CSpriteBatchMgr spriteBatchMgr;
+        return spriteBatchMgr;
+    }
+
+    // Start collecting sprites. Calls can be nested
+    void begin();
+
+    // Stop collecting sprites. The batch is rendered by the outer most call
+    void end();
+
+    // Are the sprites being collected
+    bool isActive() const;
+
+    // Get the batch to add to
+    CSpriteBatch2D & getBatch();
+
+    // Render what has been collected so far
+    void flush();
+
+    // NOTE: Interface overridden member functions
+
+    // Upload the vertices for all the commands that follow
+    void upload( const CBatchVertex2D * pVert, size_t vertCount ) override;
+
+    // Bind the shader
+    void bindShader( CShaderData * pShaderData ) override;
+
+    // Bind the texture
+    void bindTexture( uint32_t textureID ) override;
+
+    // Set the view projection matrix
+    void setMatrix( const CMatrix & matrix ) override;
+
+    // Draw a range of quads from the uploaded vertices
+    void drawQuads( uint32_t first, uint32_t count ) override;
+
+private:
+
+    // Constructor
+    CSpriteBatchMgr();
+
+    // Destructor
+    ~CSpriteBatchMgr();
+
+    // Create the index buffer shared by all the draws
+    void createIBO();
+
+private:
+
+    // The frame's batch
+    CSpriteBatch2D m_batch;
+
+    // Nested begin count
+    int m_beginCount;
+
+    // Streaming VBO and it's allocated size in bytes
+    uint32_t m_vbo;
+    size_t m_vboSize;
+
+    // Quad IBO
+    uint32_t m_ibo;
+
+    // shader location data of the bound shader
+    int32_t m_vertexLocation;
+    int32_t m_uvLocation;
+    int32_t m_colorLocation;
+    int32_t m_text0Location;
+    int32_t m_matrixLocation;
+};
+
+#endif  // __sprite_batch_manager_h__
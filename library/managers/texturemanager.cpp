@@ -3,6 +3,9 @@
 *    FILE NAME:       texturemanager.h
 *
 *    DESCRIPTION:     texture class singleton
+*                     Images are decoded on the thread pool and the
+*                     decoded images wait in a bounded staging area
+*                     until the render thread uploads them.
 ************************************************************************/
 
 #if defined(__IOS__) || defined(__ANDROID__) || defined(__arm__)
@@ -18,6 +21,10 @@
 // Game lib dependencies
 #include <utilities/exceptionhandling.h>
 #include <utilities/settings.h>
+#include <utilities/threadpool.h>
+#include <utilities/profiler.h>
+#include <utilities/atlaspacker.h>
+#include <system/renderdevice.h>
 
 // SOIL lib dependency
 #include <soil/SOIL.h>
@@ -29,12 +36,63 @@
 // SDL lib dependencies
 #include <SDL.h>
 
+// Standard lib dependencies
+#include <chrono>
+#include <algorithm>
+
+namespace
+{
+    // Limit of the decoded image memory waiting to be uploaded
+    const size_t STAGING_LIMIT = 128 * 1024 * 1024;
+
+    // Images each worker can have in flight
+    const int DECODES_PER_WORKER = 2;
+
+    // Smallest and largest atlas page
+    const int MIN_ATLAS_SIZE = 64;
+    const int MAX_ATLAS_SIZE = 2048;
+
+    /************************************************************************
+    *    DESC:  Copy the image into the RGBA atlas page
+    ************************************************************************/
+    void CopyToPage( unsigned char * pPage, int pageWidth, const CTexture & image, const CRect<int> & rect )
+    {
+        const int channels = image.m_channels;
+
+        for( int y = 0; y < rect.y2; ++y )
+        {
+            const unsigned char * pSrc = image.m_pData + (static_cast<size_t>(y) * image.m_size.w * channels);
+            unsigned char * pDest = pPage + (((static_cast<size_t>(rect.y1 + y) * pageWidth) + rect.x1) * 4);
+
+            for( int x = 0; x < rect.x2; ++x, pSrc += channels, pDest += 4 )
+            {
+                if( channels < 3 )
+                {
+                    // Luminance with or without alpha
+                    pDest[0] = pDest[1] = pDest[2] = pSrc[0];
+                    pDest[3] = (channels == 2) ? pSrc[1] : 255;
+                }
+                else
+                {
+                    pDest[0] = pSrc[0];
+                    pDest[1] = pSrc[1];
+                    pDest[2] = pSrc[2];
+                    pDest[3] = (channels == 4) ? pSrc[3] : 255;
+                }
+            }
+        }
+    }
+}
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CTextureMgr::CTextureMgr() :
     m_currentTextureID(0),
-    m_anisotropicLevel(0)
+    m_anisotropicLevel(0),
+    m_stagingBytes(0),
+    m_decodeCount(0),
+    m_decodeLimit(std::max( 1, CThreadPool::Instance().getWorkerCount() ) * DECODES_PER_WORKER)
 {
     initAnisotropic();
 }
@@ -45,12 +103,24 @@ CTextureMgr::CTextureMgr() :
 ************************************************************************/
 CTextureMgr::~CTextureMgr()
 {
+    // Wait for the decodes still running and free the images not uploaded
+    {
+        std::unique_lock<std::mutex> lock( m_streamMutex );
+
+        m_streamCondition.wait( lock,
+            [this]{ return std::all_of( m_streamVec.begin(), m_streamVec.end(),
+                [](const std::unique_ptr<CStreamImage> & rImage){ return rImage->m_decoded; } ); } );
+
+        for( auto & iter : m_streamVec )
+            SOIL_free_image_data( iter->m_pTexture->m_pData );
+    }
+
     // Free all textures in all groups
     for( auto & mapMapIter : m_textureFor2DMapMap )
     {
         for( auto & mapIter : mapMapIter.second )
         {
-            glDeleteTextures(1, &mapIter.second.m_id);
+            CRenderDevice::Instance().deleteTexture( mapIter.second.m_id );
         }
     }
 
@@ -58,7 +128,7 @@ CTextureMgr::~CTextureMgr()
     {
         for( auto & mapIter : mapMapIter.second )
         {
-            glDeleteTextures(1, &mapIter.second.m_id);
+            CRenderDevice::Instance().deleteTexture( mapIter.second.m_id );
         }
     }
 }
@@ -67,7 +137,7 @@ CTextureMgr::~CTextureMgr()
 /************************************************************************
 *    DESC:  Load the image from file path
 ************************************************************************/
-void CTextureMgr::loadImageFor2D( const std::string & group, const std::string & filePath )
+void CTextureMgr::loadImageFor2D( const std::string & group, const std::string & filePath, bool compressed )
 {
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_textureFor2DMapMap.find( group );
@@ -77,16 +147,13 @@ void CTextureMgr::loadImageFor2D( const std::string & group, const std::string &
     // See if this texture has already been loaded
     auto mapIter = mapMapIter->second.find( filePath );
 
-    // If it's not found, load the texture and add it to the list
+    // If it's not found, add it to the list and decode the image on the thread pool
     if( mapIter == mapMapIter->second.end() )
     {
-        CTexture texture;
-
-        // Load the image from file path
-        loadImage( texture, filePath );
+        mapIter = mapMapIter->second.emplace( filePath, CTexture() ).first;
+        mapIter->second.m_textFilePath = filePath;
 
-        // Insert the new texture info
-        mapIter = mapMapIter->second.emplace( filePath, texture ).first;
+        streamImage( mapIter->second, group, filePath, compressed, false );
     }
 }
 
@@ -110,28 +177,216 @@ const CTexture & CTextureMgr::createTextureFor2D( const std::string & group, con
             boost::str( boost::format("Error creating texture (%s)(%s).\n\n%s\nLine: %s")
                 % filePath % __FUNCTION__ % __LINE__ ));
 
+    // Wait for the image if it's still decoding and upload it now
     if( mapIter->second.getID() == 0 )
+        finishStream( mapIter->second, compressed );
+
+    return mapIter->second;
+}
+
+
+/************************************************************************
+*    DESC:  Load the image to be packed into the group's shared atlas pages
+*           The image is decoded as usual but never becomes a texture of
+*           it's own. An image already in the atlas is shared
+************************************************************************/
+void CTextureMgr::loadAtlasImageFor2D( const std::string & group, const std::string & filePath )
+{
+    CAtlasGroup & rAtlasGroup = m_atlasGroupMap[group];
+
+    if( rAtlasGroup.m_imageMap.find( filePath ) != rAtlasGroup.m_imageMap.end() )
+        return;
+
+    // The image can't be an atlas image and a texture of it's own
+    auto mapMapIter = m_textureFor2DMapMap.find( group );
+    if( (mapMapIter != m_textureFor2DMapMap.end()) && (mapMapIter->second.find( filePath ) != mapMapIter->second.end()) )
+        throw NExcept::CCriticalException("Load Atlas Image Error!",
+            boost::str( boost::format("Atlas image is already loaded as a texture (%s)(%s).\n\n%s\nLine: %s")
+                % filePath % group % __FUNCTION__ % __LINE__ ));
+
+    loadImageFor2D( group, filePath );
+
+    rAtlasGroup.m_imageMap.emplace( filePath, CAtlasImage() );
+}
+
+
+/************************************************************************
+*    DESC:  Get the atlas page holding the image and add the image's glyph
+*           The first request packs all the group's atlas images loaded
+*           so far so the group shares as few pages as it can
+************************************************************************/
+const CTexture & CTextureMgr::getAtlasPageFor2D(
+    const std::string & group,
+    const std::string & filePath,
+    std::vector<CSpriteSheetGlyph> & glyphVec )
+{
+    auto groupIter = m_atlasGroupMap.find( group );
+    if( groupIter == m_atlasGroupMap.end() )
+        throw NExcept::CCriticalException("Create Atlas Error!",
+            boost::str( boost::format("Atlas group has no images (%s).\n\n%s\nLine: %s")
+                % group % __FUNCTION__ % __LINE__ ));
+
+    auto imageIter = groupIter->second.m_imageMap.find( filePath );
+    if( imageIter == groupIter->second.m_imageMap.end() )
+        throw NExcept::CCriticalException("Create Atlas Error!",
+            boost::str( boost::format("Atlas image was not loaded (%s)(%s).\n\n%s\nLine: %s")
+                % filePath % group % __FUNCTION__ % __LINE__ ));
+
+    if( imageIter->second.m_page.empty() )
+        packAtlas( group, groupIter->second );
+
+    const CTexture & rPage = m_textureFor2DMapMap[group][imageIter->second.m_page];
+    const CRect<int> & rect = imageIter->second.m_rect;
+
+    // The UV is laid out the same as a sprite sheet file
+    glyphVec.emplace_back(
+        CSize<int>( rect.x2, rect.y2 ),
+        CRect<float>(
+            (float)rect.x1 / (float)rPage.m_size.w,
+            (float)rect.y1 / (float)rPage.m_size.h,
+            (float)rect.x2 / (float)rPage.m_size.w,
+            (float)rect.y2 / (float)rPage.m_size.h ) );
+
+    return rPage;
+}
+
+
+/************************************************************************
+*    DESC:  Pack the group's atlas images that aren't packed yet into
+*           new pages
+*
+*           A page is the smallest power of two that holds them all.
+*           When one page of the largest size isn't enough they go on
+*           more pages of that size. Each image is a glyph on a page so
+*           the sprite sheet renders them with the page's texture
+************************************************************************/
+void CTextureMgr::packAtlas( const std::string & group, CAtlasGroup & atlasGroup )
+{
+    auto & textureMap = m_textureFor2DMapMap[group];
+
+    std::vector<std::string> filePathVec;
+    for( auto & iter : atlasGroup.m_imageMap )
+        if( iter.second.m_page.empty() )
+            filePathVec.push_back( iter.first );
+
+    // Take the decoded images from the stream
+    std::vector< std::unique_ptr<CStreamImage> > imageVec;
+    imageVec.reserve( filePathVec.size() );
+
+    // The taken images are freed once they're in the pages or when it fails.
+    // Only the pages stay in the texture map
+    auto releaseImages = [this, &imageVec, &textureMap]()
+    {
+        for( auto & iter : imageVec )
+        {
+            SOIL_free_image_data( iter->m_pTexture->m_pData );
+            iter->m_pTexture->m_pData = nullptr;
+
+            endStream( *iter );
+            textureMap.erase( iter->m_filePath );
+        }
+
+        imageVec.clear();
+    };
+
+    for( auto & iter : filePathVec )
+    {
+        auto textIter = textureMap.find( iter );
+
+        // The image needs to be loaded and not already made into a texture
+        if( (textIter == textureMap.end()) || (textIter->second.getID() != 0) )
+        {
+            releaseImages();
+
+            throw NExcept::CCriticalException("Create Atlas Error!",
+                boost::str( boost::format("Atlas image is not loaded or is already a texture (%s)(%s).\n\n%s\nLine: %s")
+                    % iter % group % __FUNCTION__ % __LINE__ ));
+        }
+
+        try
+        {
+            imageVec.push_back( takeStream( textIter->second ) );
+        }
+        catch( ... )
+        {
+            releaseImages();
+            throw;
+        }
+
+        if( !imageVec.back()->m_error.empty() )
+        {
+            const std::string error = imageVec.back()->m_error;
+            releaseImages();
+
+            throw NExcept::CCriticalException("Load Image Error!",
+                boost::str( boost::format("Error loading image (%s)(%s).\n\n%s\nLine: %s")
+                    % error % iter % __FUNCTION__ % __LINE__ ));
+        }
+    }
+
+    const int32_t maxPageSize = std::min(
+        std::max( CRenderDevice::Instance().getInteger( GL_MAX_TEXTURE_SIZE ), MIN_ATLAS_SIZE ), MAX_ATLAS_SIZE );
+
+    CAtlasPacker packer( CSize<int>( maxPageSize, maxPageSize ) );
+
+    try
+    {
+        for( auto & iter : imageVec )
+            packer.add( iter->m_pTexture->m_size );
+    }
+    catch( ... )
     {
-        // Load the texture from file path
-        createTexture( mapIter->second, compressed );
+        releaseImages();
+        throw;
+    }
+
+    packer.packToFit( MIN_ATLAS_SIZE );
+
+    // Copy the images into their pages. The space between them stays clear
+    const CSize<int> & pageSize = packer.getPageSize();
+    std::vector< std::vector<unsigned char> > pageVec(
+        packer.getPageCount(), std::vector<unsigned char>( static_cast<size_t>(pageSize.w) * pageSize.h * 4, 0 ) );
+
+    for( size_t i = 0; i < imageVec.size(); ++i )
+        CopyToPage( pageVec[packer.getPage( i )].data(), pageSize.w, *imageVec[i]->m_pTexture, packer.getRect( i ) );
 
-        // NOTE: Now handled in SOIL (reason for commenting it out))
-        // Init with common features until I need to configure differently
-        //glBindTexture(GL_TEXTURE_2D, texture.GetID());
-        //glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-        //glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+    // The images are in the pages now
+    releaseImages();
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+    const int firstPage = atlasGroup.m_pageCount;
+
+    for( auto & iter : pageVec )
+    {
+        const std::string pageName = boost::str( boost::format("(atlas page %d)") % atlasGroup.m_pageCount++ );
+
+        CTexture & rTexture = textureMap[pageName];
+        rTexture.m_textFilePath = pageName;
+        rTexture.m_size = pageSize;
+        rTexture.m_channels = 4;
+        rTexture.m_id = CRenderDevice::Instance().createTexture( iter.data(), pageSize.w, pageSize.h, 4, false );
+
+        if( rTexture.getID() == 0 )
+            throw NExcept::CCriticalException("Create Atlas Error!",
+                boost::str( boost::format("Error creating atlas texture (%s)(%s).\n\n%s\nLine: %s")
+                    % stbi_failure_reason() % group % __FUNCTION__ % __LINE__ ));
     }
 
-    return mapIter->second;
+    CRenderDevice::Instance().bindTexture(GL_TEXTURE_2D, 0);
+    m_currentTextureID = 0;
+
+    for( size_t i = 0; i < filePathVec.size(); ++i )
+    {
+        CAtlasImage & rImage = atlasGroup.m_imageMap[filePathVec[i]];
+        rImage.m_page = boost::str( boost::format("(atlas page %d)") % (firstPage + packer.getPage( i )) );
+        rImage.m_rect = packer.getRect( i );
+    }
 }
 
 
 /************************************************************************
 *    DESC:  Load the texture from file path
 ************************************************************************/
-void CTextureMgr::loadImageFor3D( const std::string & group, const std::string & filePath )
+void CTextureMgr::loadImageFor3D( const std::string & group, const std::string & filePath, bool compressed )
 {
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_textureFor3DMapMap.find( group );
@@ -141,16 +396,13 @@ void CTextureMgr::loadImageFor3D( const std::string & group, const std::string &
     // See if this texture has already been loaded
     auto mapIter = mapMapIter->second.find( filePath );
 
-    // If it's not found, load the texture and add it to the list
+    // If it's not found, add it to the list and decode the image on the thread pool
     if( mapIter == mapMapIter->second.end() )
     {
-        CTexture texture;
+        mapIter = mapMapIter->second.emplace( filePath, CTexture() ).first;
+        mapIter->second.m_textFilePath = filePath;
 
-        // Load the texture from file path
-        loadImage( texture, filePath );
-
-        // Insert the new texture info
-        mapIter = mapMapIter->second.emplace( filePath, texture ).first;
+        streamImage( mapIter->second, group, filePath, compressed, true );
     }
 }
 
@@ -174,22 +426,9 @@ const CTexture & CTextureMgr::createTextureFor3D( const std::string & group, con
             boost::str( boost::format("Error creating texture (%s)(%s).\n\n%s\nLine: %s")
                 % filePath % group % __FUNCTION__ % __LINE__ ));
 
-    // If it's not found, create the texture and add it to the list
+    // Wait for the image if it's still decoding and upload it now
     if( mapIter->second.getID() == 0 )
-    {
-        // Load the texture from file path
-        createTexture( mapIter->second, compressed );
-
-        // Init with common features until I need to configure differently
-        glBindTexture(GL_TEXTURE_2D, mapIter->second.getID());
-
-        // Set the anisotropic value
-        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, m_anisotropicLevel );
-        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
+        finishStream( mapIter->second, compressed );
 
     return mapIter->second;
 }
@@ -200,13 +439,16 @@ const CTexture & CTextureMgr::createTextureFor3D( const std::string & group, con
 ************************************************************************/
 void CTextureMgr::loadTexture( CTexture & texture, const std::string & filePath, bool compressed )
 {
-    texture.m_id = SOIL_load_OGL_texture(
+    unsigned char * pData = SOIL_load_image(
         filePath.c_str(),
         &texture.m_size.w,
         &texture.m_size.h,
-        SOIL_LOAD_AUTO,
-        SOIL_CREATE_NEW_ID,
-        (compressed == true) ? SOIL_FLAG_COMPRESS_TO_DXT : SOIL_FLAG_ORIGINAL_TEXTURE_FORMAT );
+        &texture.m_channels,
+        SOIL_LOAD_AUTO );
+
+    texture.m_id = CRenderDevice::Instance().createTexture( pData, texture.m_size.w, texture.m_size.h, texture.m_channels, compressed );
+
+    SOIL_free_image_data( pData );
 
     if( texture.getID() == 0 )
         throw NExcept::CCriticalException("Load Texture Error!",
@@ -216,22 +458,404 @@ void CTextureMgr::loadTexture( CTexture & texture, const std::string & filePath,
 
 
 /************************************************************************
-*    DESC:  Load the just the image from file path
+*    DESC:  Queue the image to be decoded on the thread pool
+*           Posting waits while the staging area is full or too many
+*           decodes are in flight. The render thread can't wait on
+*           itself so it makes room by uploading. Waiting on a decode
+*           helps run the pool's jobs so a worker can post too
 ************************************************************************/
-void CTextureMgr::loadImage( CTexture & texture, const std::string & filePath )
+void CTextureMgr::streamImage(
+    CTexture & texture, const std::string & group, const std::string & filePath, bool compressed, bool for3D )
 {
-    texture.m_pData = SOIL_load_image(
-        filePath.c_str(),
-        &texture.m_size.w,
-        &texture.m_size.h,
-        &texture.m_channels,
+    std::unique_ptr<CStreamImage> upImage( new CStreamImage );
+    upImage->m_pTexture = &texture;
+    upImage->m_group = group;
+    upImage->m_filePath = filePath;
+    upImage->m_compressed = compressed;
+    upImage->m_for3D = for3D;
+
+    CStreamImage * pImage = upImage.get();
+
+    for(;;)
+    {
+        CJobHandle decodeJob;
+
+        {
+            std::unique_lock<std::mutex> lock( m_streamMutex );
+
+            if( m_stagingBytes >= STAGING_LIMIT )
+            {
+                if( std::this_thread::get_id() == m_renderThreadId )
+                {
+                    lock.unlock();
+                    uploadDecoded();
+                    continue;
+                }
+
+                m_streamCondition.wait( lock, [this]{ return m_stagingBytes < STAGING_LIMIT; } );
+            }
+
+            if( m_decodeCount < m_decodeLimit )
+            {
+                pImage->m_decodeJob = CThreadPool::Instance().createJob( [this, pImage]{ decodeImage( pImage ); } );
+
+                m_streamVec.push_back( std::move(upImage) );
+                ++m_decodeCount;
+
+                // A group that was done waits on this image now
+                CGroupLoad & rGroupLoad = m_groupLoadMap[group];
+                if( rGroupLoad.m_ready )
+                {
+                    rGroupLoad.m_promise = std::promise<void>();
+                    rGroupLoad.m_future = rGroupLoad.m_promise.get_future().share();
+                    rGroupLoad.m_ready = false;
+                }
+
+                ++rGroupLoad.m_progress.m_requested;
+                break;
+            }
+
+            // Wait on the oldest decode still in flight
+            for( auto & iter : m_streamVec )
+            {
+                if( !iter->m_decoded )
+                {
+                    decodeJob = iter->m_decodeJob;
+                    break;
+                }
+            }
+        }
+
+        CThreadPool::Instance().wait( decodeJob );
+    }
+
+    CThreadPool::Instance().run( pImage->m_decodeJob );
+}
+
+
+/************************************************************************
+*    DESC:  Decode the image. Runs on a pool worker
+*           Errors are held until the render thread uploads the image
+************************************************************************/
+void CTextureMgr::decodeImage( CStreamImage * pImage )
+{
+    PROFILE_ZONE( "CTextureMgr::decodeImage" );
+
+    CSize<int> size;
+    int channels = 0;
+
+    unsigned char * pData = SOIL_load_image(
+        pImage->m_filePath.c_str(),
+        &size.w,
+        &size.h,
+        &channels,
         SOIL_LOAD_AUTO
     );
 
-    if( texture.m_pData == nullptr )
+    {
+        std::unique_lock<std::mutex> lock( m_streamMutex );
+
+        if( pData == nullptr )
+        {
+            const char * pReason = stbi_failure_reason();
+            pImage->m_error = (pReason != nullptr) ? pReason : "unknown";
+        }
+        else
+        {
+            pImage->m_pTexture->m_pData = pData;
+            pImage->m_pTexture->m_size = size;
+            pImage->m_pTexture->m_channels = channels;
+            pImage->m_bytes = static_cast<size_t>(size.w) * size.h * channels;
+
+            m_stagingBytes += pImage->m_bytes;
+        }
+
+        pImage->m_decoded = true;
+        --m_decodeCount;
+
+        auto groupIter = m_groupLoadMap.find( pImage->m_group );
+        if( groupIter != m_groupLoadMap.end() )
+            ++groupIter->second.m_progress.m_decoded;
+
+        // Notify under the lock. The destructor can run as soon as the last decode is marked
+        m_streamCondition.notify_all();
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Upload the decoded images until the time budget is used
+*           Call from the render thread. A budget of zero uploads them all
+*           The images of low priority groups upload once nothing
+*           else is waiting
+*
+*    ret:   int - number of images uploaded
+************************************************************************/
+int CTextureMgr::uploadDecoded( double budgetMs )
+{
+    const auto start = std::chrono::steady_clock::now();
+    int count = 0;
+
+    for(;;)
+    {
+        std::unique_ptr<CStreamImage> upImage;
+
+        {
+            std::unique_lock<std::mutex> lock( m_streamMutex );
+
+            auto iter = std::find_if( m_streamVec.begin(), m_streamVec.end(),
+                [this](const std::unique_ptr<CStreamImage> & rImage)
+                    { return rImage->m_decoded && (m_lowPriorityGroupSet.count( rImage->m_group ) == 0); } );
+
+            if( iter == m_streamVec.end() )
+                iter = std::find_if( m_streamVec.begin(), m_streamVec.end(),
+                    [](const std::unique_ptr<CStreamImage> & rImage){ return rImage->m_decoded; } );
+
+            if( iter == m_streamVec.end() )
+                break;
+
+            upImage = std::move( *iter );
+            m_streamVec.erase( iter );
+        }
+
+        uploadImage( std::move(upImage) );
+        ++count;
+
+        if( (budgetMs > 0) &&
+            (std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count() >= budgetMs) )
+            break;
+    }
+
+    return count;
+}
+
+
+/************************************************************************
+*    DESC:  Upload a decoded image
+************************************************************************/
+void CTextureMgr::uploadImage( std::unique_ptr<CStreamImage> upImage )
+{
+    if( !upImage->m_error.empty() )
+    {
+        // Finish the image so the group's future doesn't wait on it
+        endStream( *upImage );
+
         throw NExcept::CCriticalException("Load Image Error!",
             boost::str( boost::format("Error loading image (%s)(%s).\n\n%s\nLine: %s")
-                % stbi_failure_reason() % filePath % __FUNCTION__ % __LINE__ ));
+                % upImage->m_error % upImage->m_filePath % __FUNCTION__ % __LINE__ ));
+    }
+
+    CTexture & texture = *upImage->m_pTexture;
+
+    createTexture( texture, upImage->m_compressed );
+
+    if( upImage->m_for3D )
+        initTexture3D( texture );
+
+    CRenderDevice::Instance().bindTexture(GL_TEXTURE_2D, 0);
+    m_currentTextureID = 0;
+
+    endStream( *upImage );
+}
+
+
+/************************************************************************
+*    DESC:  Count the image as uploaded and release it's staging memory
+************************************************************************/
+void CTextureMgr::endStream( const CStreamImage & image )
+{
+    {
+        std::unique_lock<std::mutex> lock( m_streamMutex );
+
+        m_stagingBytes -= image.m_bytes;
+
+        auto groupIter = m_groupLoadMap.find( image.m_group );
+        if( groupIter != m_groupLoadMap.end() )
+        {
+            ++groupIter->second.m_progress.m_uploaded;
+            readyGroupLoad( groupIter->second );
+        }
+    }
+
+    m_streamCondition.notify_all();
+}
+
+
+/************************************************************************
+*    DESC:  Wait for the texture's image to be decoded and upload it
+************************************************************************/
+void CTextureMgr::finishStream( CTexture & texture, bool compressed )
+{
+    std::unique_ptr<CStreamImage> upImage = takeStream( texture );
+
+    upImage->m_compressed = compressed;
+
+    uploadImage( std::move(upImage) );
+}
+
+
+/************************************************************************
+*    DESC:  Wait for the texture's image to be decoded and take it from the stream
+************************************************************************/
+std::unique_ptr<CTextureMgr::CStreamImage> CTextureMgr::takeStream( CTexture & texture )
+{
+    std::unique_ptr<CStreamImage> upImage;
+
+    {
+        std::unique_lock<std::mutex> lock( m_streamMutex );
+
+        auto findImage = [this, &texture]()
+        {
+            return std::find_if( m_streamVec.begin(), m_streamVec.end(),
+                [&texture](const std::unique_ptr<CStreamImage> & rImage){ return rImage->m_pTexture == &texture; } );
+        };
+
+        auto iter = findImage();
+        if( iter == m_streamVec.end() )
+            throw NExcept::CCriticalException("Create Texture Error!",
+                boost::str( boost::format("Texture image was not loaded (%s).\n\n%s\nLine: %s")
+                    % texture.m_textFilePath % __FUNCTION__ % __LINE__ ));
+
+        CStreamImage * pImage = iter->get();
+        m_streamCondition.wait( lock, [pImage]{ return pImage->m_decoded; } );
+
+        // The vector may have grown while waiting
+        iter = findImage();
+        upImage = std::move( *iter );
+        m_streamVec.erase( iter );
+    }
+
+    return upImage;
+}
+
+
+/************************************************************************
+*    DESC:  Wait for the group's decodes and drop them
+************************************************************************/
+void CTextureMgr::cancelStream( const std::string & group, bool for3D )
+{
+    auto inGroup = [&group, for3D](const std::unique_ptr<CStreamImage> & rImage)
+        { return (rImage->m_group == group) && (rImage->m_for3D == for3D); };
+
+    {
+        std::unique_lock<std::mutex> lock( m_streamMutex );
+
+        // The decodes still running write to the textures
+        m_streamCondition.wait( lock,
+            [this, &inGroup]{ return std::none_of( m_streamVec.begin(), m_streamVec.end(),
+                [&inGroup](const std::unique_ptr<CStreamImage> & rImage){ return inGroup( rImage ) && !rImage->m_decoded; } ); } );
+
+        for( auto & iter : m_streamVec )
+        {
+            if( inGroup( iter ) )
+            {
+                SOIL_free_image_data( iter->m_pTexture->m_pData );
+                iter->m_pTexture->m_pData = nullptr;
+                m_stagingBytes -= iter->m_bytes;
+            }
+        }
+
+        m_streamVec.erase( std::remove_if( m_streamVec.begin(), m_streamVec.end(), inGroup ), m_streamVec.end() );
+
+        // The group is gone so nothing waits on it
+        auto groupIter = m_groupLoadMap.find( group );
+        if( groupIter != m_groupLoadMap.end() )
+        {
+            if( !groupIter->second.m_ready )
+                groupIter->second.m_promise.set_value();
+
+            m_groupLoadMap.erase( groupIter );
+        }
+
+        m_lowPriorityGroupSet.erase( group );
+    }
+
+    m_streamCondition.notify_all();
+}
+
+
+/************************************************************************
+*    DESC:  Keep the group's promise if all it's requested images are
+*           uploaded. Call with the stream locked
+************************************************************************/
+void CTextureMgr::readyGroupLoad( CGroupLoad & groupLoad )
+{
+    if( !groupLoad.m_ready && (groupLoad.m_progress.m_uploaded >= groupLoad.m_progress.m_requested) )
+    {
+        groupLoad.m_promise.set_value();
+        groupLoad.m_ready = true;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the requested, decoded and uploaded image count of a group
+*           The counts add up until the group is deleted
+************************************************************************/
+CTextureMgr::CGroupProgress CTextureMgr::getGroupProgress( const std::string & group ) const
+{
+    std::unique_lock<std::mutex> lock( m_streamMutex );
+
+    auto iter = m_groupLoadMap.find( group );
+    if( iter == m_groupLoadMap.end() )
+        return CGroupProgress();
+
+    return iter->second.m_progress;
+}
+
+
+/************************************************************************
+*    DESC:  Get the future that's ready once the group's requested images
+*           are uploaded. Get it after the group's images are requested.
+*           The render thread has to keep uploading for it to be ready
+************************************************************************/
+std::shared_future<void> CTextureMgr::getGroupFuture( const std::string & group )
+{
+    std::unique_lock<std::mutex> lock( m_streamMutex );
+
+    auto iter = m_groupLoadMap.find( group );
+    if( iter == m_groupLoadMap.end() )
+    {
+        // Nothing was requested so there's nothing to wait on
+        std::promise<void> promise;
+        promise.set_value();
+
+        return promise.get_future().share();
+    }
+
+    readyGroupLoad( iter->second );
+
+    return iter->second.m_future;
+}
+
+
+/************************************************************************
+*    DESC:  Mark the group as low priority
+*           Its images upload after the other groups' images so a load
+*           can finish without waiting on it. Deleting the group clears it
+************************************************************************/
+void CTextureMgr::setLowPriority( const std::string & group, bool lowPriority )
+{
+    std::unique_lock<std::mutex> lock( m_streamMutex );
+
+    if( lowPriority )
+        m_lowPriorityGroupSet.insert( group );
+    else
+        m_lowPriorityGroupSet.erase( group );
+}
+
+
+/************************************************************************
+*    DESC:  Set the calling thread as the one that owns the GL context
+*           Call from the render thread at startup. When the staging
+*           area is full that thread makes room by uploading instead of
+*           waiting for an upload that only it can do
+************************************************************************/
+void CTextureMgr::setRenderThread()
+{
+    std::unique_lock<std::mutex> lock( m_streamMutex );
+
+    m_renderThreadId = std::this_thread::get_id();
 }
 
 
@@ -245,14 +869,8 @@ void CTextureMgr::createTexture( CTexture & texture, bool compressed )
             boost::str( boost::format("Can't create texture from null pointer.\n\n%s\nLine: %s")
                 % __FUNCTION__ % __LINE__ ));
 
-    texture.m_id = SOIL_create_OGL_texture(
-        texture.m_pData,
-        texture.m_size.w,
-        texture.m_size.h,
-        texture.m_channels,
-        SOIL_CREATE_NEW_ID,
-        (compressed == true) ? SOIL_FLAG_COMPRESS_TO_DXT : SOIL_FLAG_ORIGINAL_TEXTURE_FORMAT
-    );
+    texture.m_id = CRenderDevice::Instance().createTexture(
+        texture.m_pData, texture.m_size.w, texture.m_size.h, texture.m_channels, compressed );
 
     SOIL_free_image_data( texture.m_pData );
 
@@ -265,22 +883,41 @@ void CTextureMgr::createTexture( CTexture & texture, bool compressed )
 }
 
 
+/************************************************************************
+*    DESC:  Set the texture parameters used for 3D
+************************************************************************/
+void CTextureMgr::initTexture3D( const CTexture & texture )
+{
+    // Init with common features until I need to configure differently
+    CRenderDevice::Instance().bindTexture(GL_TEXTURE_2D, texture.getID());
+
+    // Set the anisotropic value
+    CRenderDevice::Instance().texParameter( GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, m_anisotropicLevel );
+    CRenderDevice::Instance().texParameter( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+    CRenderDevice::Instance().texParameter( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+}
+
+
 /************************************************************************
 *    DESC:  Delete a texture in a group
 ************************************************************************/
 void CTextureMgr::deleteTextureGroupFor2D( const std::string & group )
 {
+    cancelStream( group, false );
+
     // Free the texture group if it exists
     auto mapMapIter = m_textureFor2DMapMap.find( group );
     if( mapMapIter != m_textureFor2DMapMap.end() )
     {
         // Delete all the textures in this group
         for( auto & mapIter : mapMapIter->second )
-            glDeleteTextures(1, &mapIter.second.m_id);
+            CRenderDevice::Instance().deleteTexture( mapIter.second.m_id );
 
         // Erase this group
         m_textureFor2DMapMap.erase( mapMapIter );
     }
+
+    m_atlasGroupMap.erase( group );
 }
 
 
@@ -289,13 +926,15 @@ void CTextureMgr::deleteTextureGroupFor2D( const std::string & group )
 ************************************************************************/
 void CTextureMgr::deleteTextureGroupFor3D( const std::string & group )
 {
+    cancelStream( group, true );
+
     // Free the texture group if it exists
     auto mapMapIter = m_textureFor3DMapMap.find( group );
     if( mapMapIter != m_textureFor3DMapMap.end() )
     {
         // Delete all the textures in this group
         for( auto & mapIter : mapMapIter->second )
-            glDeleteTextures(1, &mapIter.second.m_id);
+            CRenderDevice::Instance().deleteTexture( mapIter.second.m_id );
 
         // Erase this group
         m_textureFor3DMapMap.erase( mapMapIter );
@@ -315,7 +954,7 @@ void CTextureMgr::bind( uint32_t textureID )
         m_currentTextureID = textureID;
 
         // Have OpenGL bind this texture now
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        CRenderDevice::Instance().bindTexture(GL_TEXTURE_2D, textureID);
     }
 }
 
@@ -326,7 +965,7 @@ void CTextureMgr::bind( uint32_t textureID )
 void CTextureMgr::unbind()
 {
     m_currentTextureID = 0;
-    glBindTexture(GL_TEXTURE_2D, 0);
+    CRenderDevice::Instance().bindTexture(GL_TEXTURE_2D, 0);
 }
 
 
@@ -335,8 +974,7 @@ void CTextureMgr::unbind()
 ************************************************************************/
 void CTextureMgr::initAnisotropic()
 {
-    int32_t maxAnisotropicLevel(0);
-    glGetIntegerv( GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropicLevel );
+    int32_t maxAnisotropicLevel( CRenderDevice::Instance().getInteger( GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT ) );
 
     if( maxAnisotropicLevel < 0 )
         maxAnisotropicLevel = 0;
@@ -3,6 +3,9 @@
 *    FILE NAME:       texturemanager.h
 *
 *    DESCRIPTION:     texture class singleton
+*                     Images are decoded on the thread pool and the
+*                     decoded images wait in a bounded staging area
+*                     until the render thread uploads them.
 ************************************************************************/ 
 
 #ifndef __texture_manager_h__
@@ -10,16 +13,37 @@
 
 // Game lib dependencies
 #include <common/texture.h>
+#include <common/spritesheetglyph.h>
+#include <common/rect.h>
+#include <utilities/jobqueue.h>
 
 // Standard lib dependencies
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
 
 
 class CTextureMgr
 {
 public:
 
+    // Requested, decoded and uploaded image count of a group
+    class CGroupProgress
+    {
+    public:
+
+        int m_requested = 0;
+        int m_decoded = 0;
+        int m_uploaded = 0;
+    };
+
     // Get the instance of the singleton class
     static CTextureMgr & Instance()
     {
@@ -27,14 +51,38 @@ public:
         return textMgr;
     }
     
-    // Load the image from file path
-    void loadImageFor2D( const std::string & group, const std::string & filePath );
-    void loadImageFor3D( const std::string & group, const std::string & filePath );
+    // Load the image from file path. The image is decoded on the thread pool
+    void loadImageFor2D( const std::string & group, const std::string & filePath, bool compressed = false );
+    void loadImageFor3D( const std::string & group, const std::string & filePath, bool compressed = false );
+
+    // Upload the decoded images until the time budget is used. Zero uploads them all
+    int uploadDecoded( double budgetMs = 0 );
+
+    // Get the requested, decoded and uploaded image count of a group
+    CGroupProgress getGroupProgress( const std::string & group ) const;
+
+    // Get the future that's ready once the group's requested images are uploaded
+    std::shared_future<void> getGroupFuture( const std::string & group );
+
+    // Mark the group as low priority. Its images upload after the other groups' images
+    void setLowPriority( const std::string & group, bool lowPriority = true );
+
+    // Set the calling thread as the one that owns the GL context
+    void setRenderThread();
     
     // Create the texture from file path
     const CTexture & createTextureFor2D( const std::string & group, const std::string & filePath, bool compressed = false );
     const CTexture & createTextureFor3D( const std::string & group, const std::string & filePath, bool compressed = false );
 
+    // Load the image to be packed into the group's shared atlas pages
+    void loadAtlasImageFor2D( const std::string & group, const std::string & filePath );
+
+    // Get the atlas page holding the image and add the image's glyph
+    const CTexture & getAtlasPageFor2D(
+        const std::string & group,
+        const std::string & filePath,
+        std::vector<CSpriteSheetGlyph> & glyphVec );
+
     // Texture deleting
     void deleteTextureGroupFor2D( const std::string & group );
     void deleteTextureGroupFor3D( const std::string & group );
@@ -59,23 +107,131 @@ private:
     // Load the texture from file path
     void loadTexture( CTexture & texture, const std::string & filePath, bool compressed );
     
-    // Load the just the image from file path
-    void loadImage( CTexture & texture, const std::string & filePath );
-    
     // Create the texture from image data loaded into memory
     void createTexture( CTexture & texture, bool compressed );
 
+    // Set the texture parameters used for 3D
+    void initTexture3D( const CTexture & texture );
+
+private:
+
+    // Image being decoded or waiting to be uploaded
+    class CStreamImage
+    {
+    public:
+
+        // Texture in the group map. Map nodes don't move
+        CTexture * m_pTexture = nullptr;
+
+        std::string m_group;
+        std::string m_filePath;
+        std::string m_error;
+        CJobHandle m_decodeJob;
+        size_t m_bytes = 0;
+        bool m_compressed = false;
+        bool m_for3D = false;
+        bool m_decoded = false;
+    };
+
+    // Where an image is in the group's atlas
+    class CAtlasImage
+    {
+    public:
+
+        // Name of the page texture. Empty until the image is packed
+        std::string m_page;
+
+        // Position and size in pixels. x2 and y2 are the size
+        CRect<int> m_rect;
+    };
+
+    // Atlas images of a group and the number of pages made for them
+    class CAtlasGroup
+    {
+    public:
+
+        std::map< const std::string, CAtlasImage > m_imageMap;
+        int m_pageCount = 0;
+    };
+
+    // Progress of a group and the promise kept once its images are uploaded
+    class CGroupLoad
+    {
+    public:
+
+        CGroupLoad() : m_future( m_promise.get_future().share() )
+        {}
+
+        CGroupProgress m_progress;
+        std::promise<void> m_promise;
+        std::shared_future<void> m_future;
+        bool m_ready = false;
+    };
+
+    // Queue the image to be decoded on the thread pool
+    void streamImage( CTexture & texture, const std::string & group, const std::string & filePath, bool compressed, bool for3D );
+
+    // Decode the image. Runs on a pool worker
+    void decodeImage( CStreamImage * pImage );
+
+    // Upload a decoded image
+    void uploadImage( std::unique_ptr<CStreamImage> upImage );
+
+    // Wait for the texture's image to be decoded and upload it
+    void finishStream( CTexture & texture, bool compressed );
+
+    // Wait for the texture's image to be decoded and take it from the stream
+    std::unique_ptr<CStreamImage> takeStream( CTexture & texture );
+
+    // Count the image as uploaded and release it's staging memory
+    void endStream( const CStreamImage & image );
+
+    // Wait for the group's decodes and drop them
+    void cancelStream( const std::string & group, bool for3D );
+
+    // Pack the group's atlas images that aren't packed yet into new pages
+    void packAtlas( const std::string & group, CAtlasGroup & atlasGroup );
+
+    // Keep the group's promise if all it's requested images are uploaded
+    void readyGroupLoad( CGroupLoad & groupLoad );
+
 private:
 
     // Map containing a group of texture handles
     std::map< const std::string, std::map< const std::string, CTexture > > m_textureFor2DMapMap;
     std::map< const std::string, std::map< const std::string, CTexture > > m_textureFor3DMapMap;
 
+    // Atlas images of each group
+    std::map< const std::string, CAtlasGroup > m_atlasGroupMap;
+
     // Current texture ID
     uint32_t m_currentTextureID;
     
     // Largest possible anisotropic value
     int32_t m_anisotropicLevel;
+
+    // Images being decoded or waiting to be uploaded
+    std::vector< std::unique_ptr<CStreamImage> > m_streamVec;
+
+    // Progress of each group
+    std::map< const std::string, CGroupLoad > m_groupLoadMap;
+
+    // Groups whose images upload last
+    std::set<std::string> m_lowPriorityGroupSet;
+
+    // Decoded image memory waiting to be uploaded
+    size_t m_stagingBytes;
+
+    // Images being decoded and the limit. Bounds the memory of the decodes in flight
+    int m_decodeCount;
+    int m_decodeLimit;
+
+    // The thread that owns the GL context
+    std::thread::id m_renderThreadId;
+
+    // synchronization of the stream
+    mutable std::mutex m_streamMutex;
+    std::condition_variable m_streamCondition;
 };
 
 #endif  // __texture_manager_h__
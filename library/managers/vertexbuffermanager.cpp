@@ -20,6 +20,7 @@
 #include <common/shaderdata.h>
 #include <common/scaledframe.h>
 #include <common/uv.h>
+#include <system/renderdevice.h>
 
 #include <iostream>
 
@@ -44,7 +45,7 @@ CVertBufMgr::~CVertBufMgr()
     {
         for( auto & mapIter : mapMapIter.second )
         {
-            glDeleteBuffers(1, &mapIter.second);
+            CRenderDevice::Instance().deleteBuffer( mapIter.second );
         }
     }
 
@@ -53,7 +54,7 @@ CVertBufMgr::~CVertBufMgr()
     {
         for( auto & mapIter : mapMapIter.second )
         {
-            glDeleteBuffers(1, &mapIter.second);
+            CRenderDevice::Instance().deleteBuffer( mapIter.second );
         }
     }
 }
@@ -78,13 +79,12 @@ uint32_t CVertBufMgr::createVBO(
     // If it's not found, create the vertex buffer and add it to the list
     if( mapIter == mapMapIter->second.end() )
     {
-        uint32_t vboID = 0;
-        glGenBuffers( 1, &vboID );
-        glBindBuffer( GL_ARRAY_BUFFER, vboID );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CVertex2D)*vertVec.size(), vertVec.data(), GL_STATIC_DRAW );
+        const uint32_t vboID = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, vboID );
+        CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, sizeof(CVertex2D)*vertVec.size(), vertVec.data(), GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
 
         // Insert the new vertex buffer info
         mapIter = mapMapIter->second.emplace( name, vboID ).first;
@@ -110,13 +110,12 @@ uint32_t CVertBufMgr::createIBO( const std::string & group, const std::string &
     // If it's not found, create the intex buffer and add it to the list
     if( mapIter == mapMapIter->second.end() )
     {
-        uint32_t iboID = 0;
-        glGenBuffers( 1, &iboID );
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
-        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeInBytes, indexData, GL_STATIC_DRAW );
+        const uint32_t iboID = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
+        CRenderDevice::Instance().bufferData( GL_ELEMENT_ARRAY_BUFFER, sizeInBytes, indexData, GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 
         // Insert the new intex buffer info
         mapIter = mapMapIter->second.emplace( name, iboID ).first;
@@ -142,8 +141,7 @@ uint32_t CVertBufMgr::createDynamicFontIBO( const std::string & group, const std
     // If it's not found, create the intex buffer and add it to the list
     if( mapIter == mapMapIter->second.end() )
     {
-        uint32_t iboID = 0;
-        glGenBuffers( 1, &iboID );
+        const uint32_t iboID = CRenderDevice::Instance().genBuffer();
 
         // Insert the new intex buffer info
         mapIter = mapMapIter->second.emplace( name, iboID ).first;
@@ -152,11 +150,11 @@ uint32_t CVertBufMgr::createDynamicFontIBO( const std::string & group, const std
     // If the new indices are greater then the current, init the IBO with the newest
     if( maxIndicies > m_currentMaxFontIndices )
     {
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, mapIter->second );
-        glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * maxIndicies, pIndexData, GL_STATIC_DRAW );
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, mapIter->second );
+        CRenderDevice::Instance().bufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * maxIndicies, pIndexData, GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 
         m_currentMaxFontIndices = maxIndicies;
     }
@@ -201,13 +199,12 @@ uint32_t CVertBufMgr::createScaledFrame(
         if( !vertVecTmp.empty() )
             vertVecTmp.insert( vertVecTmp.end(), vertVec.begin(), vertVec.end() );
 
-        uint32_t vboID = 0;
-        glGenBuffers( 1, &vboID );
-        glBindBuffer( GL_ARRAY_BUFFER, vboID );
-        glBufferData( GL_ARRAY_BUFFER, sizeof(CVertex2D)*vertVecTmp.size(), vertVecTmp.data(), GL_STATIC_DRAW );
+        const uint32_t vboID = CRenderDevice::Instance().genBuffer();
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, vboID );
+        CRenderDevice::Instance().bufferData( GL_ARRAY_BUFFER, sizeof(CVertex2D)*vertVecTmp.size(), vertVecTmp.data(), GL_STATIC_DRAW );
 
         // unbind the buffer
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
 
         // Insert the new vertex buffer info
         mapIter = mapMapIter->second.emplace( name, vboID ).first;
@@ -420,7 +417,7 @@ void CVertBufMgr::bind( uint32_t vboID, uint32_t iboID )
         m_currentVBOID = vboID;
 
         // Have OpenGL bind this buffer now
-        glBindBuffer( GL_ARRAY_BUFFER, vboID );
+        CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, vboID );
     }
 
     if( m_currentIBOID != iboID )
@@ -429,7 +426,7 @@ void CVertBufMgr::bind( uint32_t vboID, uint32_t iboID )
         m_currentIBOID = iboID;
 
         // Have OpenGL bind this buffer now
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
+        CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, iboID );
     }
 }
 
@@ -441,8 +438,8 @@ void CVertBufMgr::unbind()
 {
     m_currentVBOID = 0;
     m_currentIBOID = 0;
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+    CRenderDevice::Instance().bindBuffer( GL_ARRAY_BUFFER, 0 );
+    CRenderDevice::Instance().bindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
 }
 
 
@@ -458,7 +455,7 @@ void CVertBufMgr::deleteBufferGroupFor2D( const std::string & group )
             // Delete all the buffers in this group
             for( auto & mapIter : mapMapIter->second )
             {
-                glDeleteBuffers(1, &mapIter.second);
+                CRenderDevice::Instance().deleteBuffer( mapIter.second );
             }
 
             // Erase this group
@@ -473,7 +470,7 @@ void CVertBufMgr::deleteBufferGroupFor2D( const std::string & group )
             // Delete all the buffers in this group
             for( auto & mapIter : mapMapIter->second )
             {
-                glDeleteBuffers(1, &mapIter.second);
+                CRenderDevice::Instance().deleteBuffer( mapIter.second );
             }
 
             // Erase this group
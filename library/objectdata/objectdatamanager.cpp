@@ -19,6 +19,7 @@
 #include <managers/texturemanager.h>
 #include <managers/meshmanager.h>
 #include <managers/spritesheetmanager.h>
+#include <utilities/profiler.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -44,6 +45,8 @@ CObjectDataMgr::~CObjectDataMgr()
  ************************************************************************/
 void CObjectDataMgr::loadGroup2D( const std::string & group, const bool createFromData )
 {
+    PROFILE_ZONE( "CObjectDataMgr::loadGroup2D" );
+
     // Check for a hardware extension
     std::string ext;
     if( !m_mobileExt.empty() && NBDefs::IsMobileDevice() )
@@ -244,6 +247,8 @@ const CObjectData2D & CObjectDataMgr::getData2D( const CSpriteData & spriteData
  ************************************************************************/
 void CObjectDataMgr::loadGroup3D( const std::string & group, const bool createFromData )
 {
+    PROFILE_ZONE( "CObjectDataMgr::loadGroup3D" );
+
     // Make sure the group we are looking has been defined in the list table file
     auto listTableIter = m_listTableMap.find( group );
     if( listTableIter == m_listTableMap.end() )
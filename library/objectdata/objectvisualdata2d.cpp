@@ -43,6 +43,7 @@ CObjectVisualData2D::CObjectVisualData2D() :
     m_genType(NDefs::EGT_NULL),
     m_textureSequenceCount(0),
     m_compressed(false),
+    m_atlas(false),
     m_iboCount(0),
     m_vertexScale(1,1),
     m_defaultUniformScale(1),
@@ -108,6 +109,10 @@ void CObjectVisualData2D::loadFromNode( const XMLNode & objectNode )
             // Is this a compressed texture?
             if( textureNode.isAttributeSet("compressed") )
                 m_compressed = (std::strcmp(textureNode.getAttribute( "compressed" ), "true") == 0);
+
+            // Are the images packed into the group's atlas?
+            if( textureNode.isAttributeSet("atlas") )
+                m_atlas = (std::strcmp(textureNode.getAttribute( "atlas" ), "true") == 0);
         }
 
         // Get the mesh node
@@ -233,6 +238,14 @@ void CObjectVisualData2D::loadFromNode( const XMLNode & objectNode )
                 boost::str( boost::format("Shader object data missing.\n\n%s\nLine: %s")
                     % __FUNCTION__ % __LINE__ ));
         }
+
+        // The atlas images are drawn as a sprite sheet
+        if( m_atlas && ((m_genType != NDefs::EGT_SPRITE_SHEET) || !m_spriteSheetFilePath.empty()) )
+        {
+            throw NExcept::CCriticalException("Texture atlas error!",
+                boost::str( boost::format("Texture atlas needs a sprite sheet mesh without a file (%s).\n\n%s\nLine: %s")
+                    % m_textureFilePath % __FUNCTION__ % __LINE__ ));
+        }
     }
 }
 
@@ -258,7 +271,10 @@ void CObjectVisualData2D::loadImage( const std::string & group )
                 if( !m_resExt.empty() )
                     NGenFunc::AddFileExt( file, filePath, m_resExt );
 
-                CTextureMgr::Instance().loadImageFor2D( group, filePath );
+                if( m_atlas )
+                    CTextureMgr::Instance().loadAtlasImageFor2D( group, filePath );
+                else
+                    CTextureMgr::Instance().loadImageFor2D( group, filePath, m_compressed );
             }
         }
         else
@@ -269,7 +285,10 @@ void CObjectVisualData2D::loadImage( const std::string & group )
             if( !m_resExt.empty() )
                 NGenFunc::AddFileExt( m_textureFilePath, filePath, m_resExt );
 
-            CTextureMgr::Instance().loadImageFor2D( group, filePath );
+            if( m_atlas )
+                CTextureMgr::Instance().loadAtlasImageFor2D( group, filePath );
+            else
+                CTextureMgr::Instance().loadImageFor2D( group, filePath, m_compressed );
         }
     }
 }
@@ -299,7 +318,8 @@ void CObjectVisualData2D::createFromData( const std::string & group, CSize<int>
     else if( m_genType == NDefs::EGT_SPRITE_SHEET )
     {
         // Build the simple (grid) sprite sheet from XML data
-        if( m_spriteSheetFilePath.empty() )
+        // An atlas has it's glyphs from the packing
+        if( m_spriteSheetFilePath.empty() && !m_atlas )
             m_spriteSheet.build( rSize );
 
         // Generate a quad
@@ -338,7 +358,41 @@ void CObjectVisualData2D::createTexture( const std::string & group, CTexture & r
 {
     if( !m_textureFilePath.empty() )
     {
-        if( m_textureSequenceCount > 0 )
+        // The images are glyphs on the group's shared atlas pages. Each frame
+        // has the page it's on so the frames of a sequence can span pages
+        if( m_atlas )
+        {
+            std::vector<std::string> filePathVec;
+
+            if( m_textureSequenceCount > 0 )
+            {
+                for( int i = 0; i < m_textureSequenceCount; ++i )
+                    filePathVec.push_back( boost::str( boost::format(m_textureFilePath) % i ) );
+            }
+            else
+            {
+                filePathVec.push_back( m_textureFilePath );
+            }
+
+            std::vector<CSpriteSheetGlyph> glyphVec;
+            glyphVec.reserve( filePathVec.size() );
+            m_textureIDVec.reserve( filePathVec.size() );
+
+            for( auto & iter : filePathVec )
+            {
+                std::string filePath = iter;
+
+                // Add in the resource swap file extension if needed
+                if( !m_resExt.empty() )
+                    NGenFunc::AddFileExt( iter, filePath, m_resExt );
+
+                rTexture = CTextureMgr::Instance().getAtlasPageFor2D( group, filePath, glyphVec );
+                m_textureIDVec.push_back( rTexture.getID() );
+            }
+
+            m_spriteSheet.build( rTexture.getSize(), glyphVec );
+        }
+        else if( m_textureSequenceCount > 0 )
         {
             m_textureIDVec.reserve( m_textureSequenceCount );
 
@@ -420,6 +474,10 @@ void CObjectVisualData2D::generateQuad( const std::string & group )
         vertVec[3].uv.v = 0.0;
     }
 
+    // Keep a copy for the sprite batch
+    for( size_t i = 0; i < vertVec.size(); ++i )
+        m_quad.vert[i] = vertVec[i];
+
     m_vbo = CVertBufMgr::Instance().createVBO( group, "quad_0011" + horzStr + vertStr, vertVec );
     m_ibo = CVertBufMgr::Instance().createIBO( group, "quad_0123", indexData, sizeof(indexData) );
 
@@ -677,6 +735,15 @@ int CObjectVisualData2D::getIBOCount() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the quad verts. Used when batching quads and sprite sheets
+************************************************************************/
+const CQuad2D & CObjectVisualData2D::getQuad() const
+{
+    return m_quad;
+}
+
+
 /************************************************************************
 *    DESC:  Get the frame count
 ************************************************************************/
@@ -689,6 +756,16 @@ size_t CObjectVisualData2D::getFrameCount() const
 }
 
 
+/************************************************************************
+*    DESC:  Are the images on the group's atlas pages
+*           Each sprite sheet frame has the texture of it's page
+************************************************************************/
+bool CObjectVisualData2D::isAtlas() const
+{
+    return m_atlas;
+}
+
+
 /************************************************************************
 *    DESC:  Get the vertex scale
 ************************************************************************/
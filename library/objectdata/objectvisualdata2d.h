@@ -15,6 +15,7 @@
 #include <common/point.h>
 #include <common/defs.h>
 #include <common/face2d.h>
+#include <common/quad2d.h>
 #include <common/scaledframe.h>
 #include <common/texture.h>
 #include <common/spritesheet.h>
@@ -67,9 +68,15 @@ public:
     // Get the ibo count
     int getIBOCount() const;
 
+    // Get the quad verts. Used when batching quads and sprite sheets
+    const CQuad2D & getQuad() const;
+
     // Get the frame count
     size_t getFrameCount() const;
 
+    // Are the images on the group's atlas pages
+    bool isAtlas() const;
+
     // Whether or not the visual tag was specified
     bool isActive() const;
     
@@ -146,12 +153,18 @@ private:
     // Compressed flag
     bool m_compressed;
 
+    // Pack the texture sequence into one texture
+    bool m_atlas;
+
     // mesh file path
     std::string m_meshFilePath;
 
     // ibo count
     int m_iboCount;
 
+    // Copy of the quad verts in the VBO
+    CQuad2D m_quad;
+
     // The vertex scale of the object
     CSize<float> m_vertexScale;
 
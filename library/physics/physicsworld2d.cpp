@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <utilities/xmlParser.h>
 #include <utilities/highresolutiontimer.h>
+#include <utilities/settings.h>
 #include <utilities/mathfunc.h>
 #include <utilities/exceptionhandling.h>
 
@@ -158,6 +159,9 @@ void CPhysicsWorld2D::destroyBody( b2Body * pBody )
 
 /************************************************************************
 *    DESC:  Perform fixed time step physics simulation
+*           Steps until the time is used up so a slow frame doesn't
+*           slow down the simulation. The steps are capped and the
+*           time over the cap is dropped so it can't spiral
 ************************************************************************/
 void CPhysicsWorld2D::fixedTimeStep()
 {
@@ -166,14 +170,19 @@ void CPhysicsWorld2D::fixedTimeStep()
         // Increment the timer
         m_timer += CHighResTimer::Instance().getElapsedTime();
 
-        if( m_timer > m_stepTime )
+        const int maxSteps = CSettings::Instance().getMaxStepsPerFrame();
+
+        for( int i = 0; (i < maxSteps) && (m_timer >= m_stepTime); ++i )
         {
-            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
+            m_timer -= m_stepTime;
 
             // Begin the physics world step
             m_world.Step( m_stepTimeSec, m_velStepCount, m_posStepCount );
         }
 
+        if( m_timer >= m_stepTime )
+            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
+
         m_timeRatio = m_timer / m_stepTime;
     }
 }
@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <utilities/xmlParser.h>
 #include <utilities/highresolutiontimer.h>
+#include <utilities/settings.h>
 #include <utilities/mathfunc.h>
 #include <utilities/exceptionhandling.h>
 
@@ -111,6 +112,9 @@ void CPhysicsWorld3D::removeRigidBody( btRigidBody * pBody )
 
 /************************************************************************
  *    DESC:  Perform fixed time step physics simulation
+ *           Steps until the time is used up so a slow frame doesn't
+ *           slow down the simulation. The steps are capped and the
+ *           time over the cap is dropped so it can't spiral
  ************************************************************************/
 void CPhysicsWorld3D::fixedTimeStep()
 {
@@ -119,14 +123,19 @@ void CPhysicsWorld3D::fixedTimeStep()
         // Increment the timer
         m_timer += CHighResTimer::Instance().getElapsedTime();
 
-        if( m_timer > m_stepTime )
+        const int maxSteps = CSettings::Instance().getMaxStepsPerFrame();
+
+        for( int i = 0; (i < maxSteps) && (m_timer >= m_stepTime); ++i )
         {
-            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
+            m_timer -= m_stepTime;
 
             // Begin the physics world step - same as m_stepTime / 1000.0f
             m_world.stepSimulation( m_stepTimeSec, 1, m_stepTimeSec );
         }
 
+        if( m_timer >= m_stepTime )
+            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
+
         m_timeRatio = m_timer / m_stepTime;
     }
 }
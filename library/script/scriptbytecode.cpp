@@ -0,0 +1,340 @@
+/************************************************************************
+*    FILE NAME:       scriptbytecode.cpp
+*
+*    DESCRIPTION:     Cache of the compiled byte code of a script group
+*                     The cache file is only used when the group name,
+*                     the script sources and everything registered with
+*                     the engine still match what it was saved with.
+*                     Otherwise the group is compiled and saved again.
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptbytecode.h>
+
+// Game lib dependencies
+#include <utilities/genfunc.h>
+#include <utilities/smartpointers.h>
+
+// SDL lib dependencies
+#include <SDL.h>
+
+// Standard lib dependencies
+#include <cstring>
+#include <cctype>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+
+namespace NScriptByteCode
+{
+    namespace
+    {
+        // Cache file layout
+        //  CHeader
+        //  byte code - as written by asIScriptModule::SaveByteCode
+        class CHeader
+        {
+        public:
+            char m_magic[4];
+            uint32_t m_version;
+            uint32_t m_engineVersion;
+            uint32_t m_byteCodeSize;
+            uint64_t m_sourceHash;
+            uint64_t m_interfaceHash;
+        };
+
+        const char MAGIC[4] = { 'A', 'S', 'B', 'C' };
+
+        /************************************************************************
+        *    desc:  FNV-1a hash that the data is added to a piece at a time
+        ************************************************************************/
+        class CHash
+        {
+        public:
+
+            void add( const void * pData, size_t size )
+            {
+                const unsigned char * pByte = static_cast<const unsigned char *>(pData);
+
+                for( size_t i = 0; i < size; ++i )
+                {
+                    m_hash ^= pByte[i];
+                    m_hash *= 0x100000001b3ULL;
+                }
+            }
+
+            // Strings are added with the terminator so "ab","c" and "a","bc" differ
+            void add( const char * pStr )
+            {
+                if( pStr != nullptr )
+                    add( pStr, std::strlen( pStr ) + 1 );
+                else
+                    add( "", 1 );
+            }
+
+            void add( const std::string & str )
+            {
+                add( str.c_str(), str.size() + 1 );
+            }
+
+            void add( int64_t value )
+            {
+                add( &value, sizeof(value) );
+            }
+
+            uint64_t m_hash = 0xcbf29ce484222325ULL;
+        };
+
+        /************************************************************************
+        *    desc:  Memory stream the module byte code is saved to and loaded from
+        ************************************************************************/
+        class CByteCodeStream : public asIBinaryStream
+        {
+        public:
+
+            int Read( void * ptr, asUINT size ) override
+            {
+                if( m_readPos + size > m_buffer.size() )
+                    return -1;
+
+                std::memcpy( ptr, m_buffer.data() + m_readPos, size );
+                m_readPos += size;
+
+                return 0;
+            }
+
+            int Write( const void * ptr, asUINT size ) override
+            {
+                const char * pByte = static_cast<const char *>(ptr);
+                m_buffer.insert( m_buffer.end(), pByte, pByte + size );
+
+                return 0;
+            }
+
+            std::vector<char> m_buffer;
+            size_t m_readPos = 0;
+        };
+
+        /************************************************************************
+        *    DESC:  Add the declarations of a registered type to the hash
+        ************************************************************************/
+        void AddType( CHash & hash, const asITypeInfo * pType )
+        {
+            hash.add( pType->GetNamespace() );
+            hash.add( pType->GetName() );
+            hash.add( static_cast<int64_t>(pType->GetFlags()) );
+            hash.add( static_cast<int64_t>(pType->GetSize()) );
+
+            for( asUINT i = 0; i < pType->GetFactoryCount(); ++i )
+                hash.add( pType->GetFactoryByIndex(i)->GetDeclaration(true, true, false) );
+
+            for( asUINT i = 0; i < pType->GetBehaviourCount(); ++i )
+            {
+                asEBehaviours behaviour;
+                const asIScriptFunction * pFunc = pType->GetBehaviourByIndex(i, &behaviour);
+
+                hash.add( static_cast<int64_t>(behaviour) );
+                hash.add( pFunc->GetDeclaration(true, true, false) );
+            }
+
+            for( asUINT i = 0; i < pType->GetMethodCount(); ++i )
+                hash.add( pType->GetMethodByIndex(i)->GetDeclaration(true, true, false) );
+
+            for( asUINT i = 0; i < pType->GetPropertyCount(); ++i )
+                hash.add( pType->GetPropertyDeclaration(i, true) );
+        }
+
+        /************************************************************************
+        *    DESC:  Read in the whole file
+        ************************************************************************/
+        bool ReadFile( const std::string & filePath, std::vector<char> & buffer )
+        {
+            NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( filePath.c_str(), "rb" ) );
+            if( scpFile.isNull() )
+                return false;
+
+            const Sint64 size = SDL_RWseek( scpFile.get(), 0, RW_SEEK_END );
+            if( size <= 0 )
+                return false;
+
+            buffer.resize( size );
+            SDL_RWseek( scpFile.get(), 0, RW_SEEK_SET );
+
+            return (SDL_RWread( scpFile.get(), buffer.data(), 1, size ) == static_cast<size_t>(size));
+        }
+    }
+
+
+    /************************************************************************
+    *    DESC:  Get the cache file path of the group
+    *           Only the letters, numbers, '_' and '-' of the group name
+    *           are used. ie "(menu)" is saved as "menu.asbc"
+    ************************************************************************/
+    std::string GetFilePath( const std::string & folder, const std::string & group )
+    {
+        std::string filePath = folder;
+
+        if( !filePath.empty() && (filePath.back() != '/') && (filePath.back() != '\\') )
+            filePath += '/';
+
+        for( auto iter : group )
+            if( std::isalnum( static_cast<unsigned char>(iter) ) || (iter == '_') || (iter == '-') )
+                filePath += iter;
+
+        return filePath + EXTENSION;
+
+    }   // GetFilePath
+
+
+    /************************************************************************
+    *    DESC:  Hash of the group name and it's script sources
+    ************************************************************************/
+    uint64_t SourceHash( const std::string & group, const std::vector<std::string> & fileVec )
+    {
+        CHash hash;
+        hash.add( group );
+
+        for( auto & iter : fileVec )
+        {
+            size_t sizeInBytes(0);
+            std::shared_ptr<char> spChar = NGenFunc::FileToBuf( iter, sizeInBytes );
+
+            hash.add( iter );
+            hash.add( static_cast<int64_t>(sizeInBytes) );
+            hash.add( spChar.get(), sizeInBytes );
+        }
+
+        return hash.m_hash;
+
+    }   // SourceHash
+
+
+    /************************************************************************
+    *    DESC:  Hash of everything registered with the engine
+    *           Byte code refers to the registered functions and types by
+    *           declaration so any change to them invalidates the cache.
+    *           The type sizes are part of it so a cache saved on a 64 bit
+    *           build is recompiled on 32 bit if a value type changes size.
+    ************************************************************************/
+    uint64_t InterfaceHash( asIScriptEngine * pEngine )
+    {
+        CHash hash;
+        hash.add( static_cast<int64_t>(ANGELSCRIPT_VERSION) );
+
+        for( int i = 1; i < asEP_LAST_PROPERTY; ++i )
+            hash.add( static_cast<int64_t>(pEngine->GetEngineProperty( static_cast<asEEngineProp>(i) )) );
+
+        for( asUINT i = 0; i < pEngine->GetObjectTypeCount(); ++i )
+            AddType( hash, pEngine->GetObjectTypeByIndex(i) );
+
+        for( asUINT i = 0; i < pEngine->GetEnumCount(); ++i )
+        {
+            const asITypeInfo * pEnum = pEngine->GetEnumByIndex(i);
+            hash.add( pEnum->GetNamespace() );
+            hash.add( pEnum->GetName() );
+
+            for( asUINT j = 0; j < pEnum->GetEnumValueCount(); ++j )
+            {
+                int value(0);
+                hash.add( pEnum->GetEnumValueByIndex(j, &value) );
+                hash.add( static_cast<int64_t>(value) );
+            }
+        }
+
+        for( asUINT i = 0; i < pEngine->GetFuncdefCount(); ++i )
+            hash.add( pEngine->GetFuncdefByIndex(i)->GetFuncdefSignature()->GetDeclaration(true, true, false) );
+
+        for( asUINT i = 0; i < pEngine->GetTypedefCount(); ++i )
+        {
+            const asITypeInfo * pTypedef = pEngine->GetTypedefByIndex(i);
+            hash.add( pTypedef->GetNamespace() );
+            hash.add( pTypedef->GetName() );
+            hash.add( pEngine->GetTypeDeclaration( pTypedef->GetTypedefTypeId(), true ) );
+        }
+
+        for( asUINT i = 0; i < pEngine->GetGlobalFunctionCount(); ++i )
+            hash.add( pEngine->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true, false) );
+
+        for( asUINT i = 0; i < pEngine->GetGlobalPropertyCount(); ++i )
+        {
+            const char * pName(nullptr);
+            const char * pNameSpace(nullptr);
+            int typeId(0);
+            bool isConst(false);
+            pEngine->GetGlobalPropertyByIndex(i, &pName, &pNameSpace, &typeId, &isConst);
+
+            hash.add( pNameSpace );
+            hash.add( pName );
+            hash.add( pEngine->GetTypeDeclaration( typeId, true ) );
+            hash.add( static_cast<int64_t>(isConst) );
+        }
+
+        return hash.m_hash;
+
+    }   // InterfaceHash
+
+
+    /************************************************************************
+    *    DESC:  Load the byte code into the module if the cache file is up to date
+    *           On failure the module may be partly loaded and should be
+    *           discarded before the scripts are compiled
+    ************************************************************************/
+    bool Load( asIScriptModule * pScriptModule, const std::string & filePath, uint64_t sourceHash, uint64_t interfaceHash )
+    {
+        std::vector<char> buffer;
+        if( !ReadFile( filePath, buffer ) || (buffer.size() < sizeof(CHeader)) )
+            return false;
+
+        CHeader header;
+        std::memcpy( &header, buffer.data(), sizeof(header) );
+
+        if( (std::memcmp( header.m_magic, MAGIC, sizeof(MAGIC) ) != 0) ||
+            (header.m_version != VERSION) ||
+            (header.m_engineVersion != ANGELSCRIPT_VERSION) ||
+            (header.m_byteCodeSize != buffer.size() - sizeof(header)) ||
+            (header.m_sourceHash != sourceHash) ||
+            (header.m_interfaceHash != interfaceHash) )
+            return false;
+
+        CByteCodeStream stream;
+        stream.m_buffer.swap( buffer );
+        stream.m_readPos = sizeof(header);
+
+        return (pScriptModule->LoadByteCode( &stream ) >= 0);
+
+    }   // Load
+
+
+    /************************************************************************
+    *    DESC:  Save the byte code of the built module
+    *           Debug info is kept so script exceptions still have line numbers
+    ************************************************************************/
+    bool Save( asIScriptModule * pScriptModule, const std::string & filePath, uint64_t sourceHash, uint64_t interfaceHash )
+    {
+        CByteCodeStream stream;
+        if( pScriptModule->SaveByteCode( &stream ) < 0 )
+            return false;
+
+        CHeader header;
+        std::memcpy( header.m_magic, MAGIC, sizeof(MAGIC) );
+        header.m_version = VERSION;
+        header.m_engineVersion = ANGELSCRIPT_VERSION;
+        header.m_byteCodeSize = stream.m_buffer.size();
+        header.m_sourceHash = sourceHash;
+        header.m_interfaceHash = interfaceHash;
+
+        // Mobile builds read from the read only package so this fails quietly
+        NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( filePath.c_str(), "wb" ) );
+        if( scpFile.isNull() )
+            return false;
+
+        bool result = (SDL_RWwrite( scpFile.get(), &header, sizeof(header), 1 ) == 1);
+
+        if( result && !stream.m_buffer.empty() )
+            result = (SDL_RWwrite( scpFile.get(), stream.m_buffer.data(), stream.m_buffer.size(), 1 ) == 1);
+
+        return result;
+
+    }   // Save
+
+}   // NScriptByteCode
@@ -0,0 +1,48 @@
+/************************************************************************
+*    FILE NAME:       scriptbytecode.h
+*
+*    DESCRIPTION:     Cache of the compiled byte code of a script group
+*                     The cache file is only used when the group name,
+*                     the script sources and everything registered with
+*                     the engine still match what it was saved with.
+*                     Otherwise the group is compiled and saved again.
+************************************************************************/
+
+#ifndef __script_byte_code_h__
+#define __script_byte_code_h__
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Forward declaration(s)
+class asIScriptEngine;
+class asIScriptModule;
+
+namespace NScriptByteCode
+{
+    // Version of the cache file. Bump it when the layout changes
+    const uint32_t VERSION = 1;
+
+    // Extension of the cache file
+    const char * const EXTENSION = ".asbc";
+
+    // Get the cache file path of the group
+    std::string GetFilePath( const std::string & folder, const std::string & group );
+
+    // Hash of the group name and it's script sources
+    uint64_t SourceHash( const std::string & group, const std::vector<std::string> & fileVec );
+
+    // Hash of everything registered with the engine
+    uint64_t InterfaceHash( asIScriptEngine * pEngine );
+
+    // Load the byte code into the module if the cache file is up to date
+    bool Load( asIScriptModule * pScriptModule, const std::string & filePath, uint64_t sourceHash, uint64_t interfaceHash );
+
+    // Save the byte code of the built module
+    bool Save( asIScriptModule * pScriptModule, const std::string & filePath, uint64_t sourceHash, uint64_t interfaceHash );
+
+}   // NScriptByteCode
+
+#endif  // __script_byte_code_h__
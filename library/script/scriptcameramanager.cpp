@@ -12,12 +12,56 @@
 #include <managers/cameramanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
 
 namespace NScriptCameraManager
 {
+    /************************************************************************
+    *    DESC:  Create the camera. Can't be called from a parallel script
+    ************************************************************************/
+    CCamera * CreateOrthographic( const std::string & id, float minZDist, float maxZDist, float scale, CCameraMgr & rCameraMgr )
+    {
+        try
+        {
+            CScriptMgr::Instance().mainThreadOnly( "createOrthographic" );
+
+            return &rCameraMgr.createOrthographic( id, minZDist, maxZDist, scale );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+
+        return nullptr;
+    }
+
+    CCamera * CreatePerspective( const std::string & id, float angle, float minZDist, float maxZDist, float scale, CCameraMgr & rCameraMgr )
+    {
+        try
+        {
+            CScriptMgr::Instance().mainThreadOnly( "createPerspective" );
+
+            return &rCameraMgr.createPerspective( id, angle, minZDist, maxZDist, scale );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+
+        return nullptr;
+    }
+
     /************************************************************************
     *    DESC:  Register global functions
     ************************************************************************/
@@ -33,11 +77,11 @@ namespace NScriptCameraManager
         Throw( pEngine->RegisterObjectMethod(
             "CCameraMgr",
             "CCamera & createOrthographic(string &in, float minZDist = 5, float maxZDist = 1000, float scale = 1.f)",
-            asMETHOD(CCameraMgr, createOrthographic), asCALL_THISCALL) );
+            asFUNCTION(CreateOrthographic), asCALL_CDECL_OBJLAST) );
         
         Throw( pEngine->RegisterObjectMethod("CCameraMgr",
             "CCamera & createPerspective(string &in, float angle = 45, float minZDist = 5, float maxZDist = 1000, float scale = 1.f)",
-            asMETHOD(CCameraMgr, createPerspective), asCALL_THISCALL) );
+            asFUNCTION(CreatePerspective), asCALL_CDECL_OBJLAST) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CCameraMgr CameraMgr", &CCameraMgr::Instance()) );
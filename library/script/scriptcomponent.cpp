@@ -21,11 +21,13 @@
 
 // Standard lib dependencies
 #include <iostream>
+#include <algorithm>
 
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
-CScriptComponent::CScriptComponent()
+CScriptComponent::CScriptComponent( NDefs::EScriptPriority priority ) :
+    m_priority(priority)
 {
 }
 
@@ -43,13 +45,25 @@ CScriptComponent::~CScriptComponent()
 
 /************************************************************************
 *    DESC:  Prepare the script function to run
+*           The prepared context is added to the back of the vector
 ************************************************************************/
-void CScriptComponent::prepare(
+asIScriptContext * CScriptComponent::prepare(
     const std::string & group,
     const std::string & funcName,
-    const std::vector<CScriptParam> & paramVec )
+    std::initializer_list<CScriptParam> paramList )
 {
-    CScriptMgr::Instance().prepare( group, funcName, m_pContextVec, paramVec );
+    CScriptMgr::Instance().prepare( group, funcName, m_pContextVec, paramList );
+
+    return m_pContextVec.back();
+}
+
+asIScriptContext * CScriptComponent::prepare(
+    asIScriptFunction * pScriptFunc,
+    std::initializer_list<CScriptParam> paramList )
+{
+    CScriptMgr::Instance().prepare( pScriptFunc, m_pContextVec, paramList );
+
+    return m_pContextVec.back();
 }
 
 
@@ -59,7 +73,27 @@ void CScriptComponent::prepare(
 void CScriptComponent::update()
 {
     if( !m_pContextVec.empty() )
-        CScriptMgr::Instance().update( m_pContextVec );
+        CScriptMgr::Instance().update( m_pContextVec, m_priority );
+}
+
+
+/************************************************************************
+*    DESC:  Update the script leaving the contexts of the parallel groups
+************************************************************************/
+void CScriptComponent::serialUpdate()
+{
+    if( !m_pContextVec.empty() )
+        CScriptMgr::Instance().update( m_pContextVec, m_priority, true );
+}
+
+
+/************************************************************************
+*    DESC:  Update the contexts of the parallel groups
+************************************************************************/
+void CScriptComponent::parallelUpdate()
+{
+    if( !m_pContextVec.empty() && CScriptMgr::Instance().isParallel() )
+        CScriptMgr::Instance().parallelUpdate( m_pContextVec );
 }
 
 
@@ -72,6 +106,34 @@ bool CScriptComponent::isActive()
 }
 
 
+/************************************************************************
+*    DESC:  Is the context still waiting to start or to be resumed
+*           A finished context is recycled out of the vector so it's
+*           only pending while this component still holds it
+************************************************************************/
+bool CScriptComponent::isPending( asIScriptContext * pContext ) const
+{
+    if( pContext == nullptr )
+        return false;
+
+    auto iter = std::find( m_pContextVec.begin(), m_pContextVec.end(), pContext );
+    if( iter == m_pContextVec.end() )
+        return false;
+
+    return (pContext->GetState() == asEXECUTION_PREPARED) ||
+           (pContext->GetState() == asEXECUTION_SUSPENDED);
+}
+
+
+/************************************************************************
+*    DESC:  Set the share of the script frame budget the contexts get
+************************************************************************/
+void CScriptComponent::setPriority( NDefs::EScriptPriority priority )
+{
+    m_priority = priority;
+}
+
+
 /************************************************************************
 *    DESC:  Reset the contexts and recycle
 ************************************************************************/
@@ -18,28 +18,40 @@
 // Standard lib dependencies
 #include <string>
 #include <vector>
+#include <initializer_list>
 
 // Forward declaration(s)
 class asIScriptContext;
+class asIScriptFunction;
 
 class CScriptComponent : boost::noncopyable
 {
 public:
     
     // Constructor
-    CScriptComponent();
+    CScriptComponent( NDefs::EScriptPriority priority = NDefs::ESP_AI );
 
     // Destructor
     ~CScriptComponent();
     
-    // Prepare the script function to run
-    void prepare(
+    // Prepare the script function to run. Returns the prepared context
+    asIScriptContext * prepare(
         const std::string & group,
         const std::string & funcName,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        std::initializer_list<CScriptParam> paramList = {} );
+    
+    asIScriptContext * prepare(
+        asIScriptFunction * pScriptFunc,
+        std::initializer_list<CScriptParam> paramList = {} );
 
     // Update the script
     void update();
+    
+    // Update the script leaving the contexts of the parallel groups
+    void serialUpdate();
+    
+    // Update the contexts of the parallel groups. Can be called from the workers
+    void parallelUpdate();
 
     // Reset the contexts and recycle
     void resetAndRecycle();
@@ -49,12 +61,21 @@ public:
 
     // Is this component active?
     bool isActive();
+    
+    // Is the context still waiting to start or to be resumed
+    bool isPending( asIScriptContext * pContext ) const;
+    
+    // Set the share of the script frame budget the contexts get
+    void setPriority( NDefs::EScriptPriority priority );
 
 private:
 
     // dynamic context vector
     // NOTE: This class does not own the pointer
     std::vector<asIScriptContext *> m_pContextVec;
+    
+    // Share of the script frame budget
+    NDefs::EScriptPriority m_priority;
 
 };
 
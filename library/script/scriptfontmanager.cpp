@@ -21,12 +21,16 @@ namespace NScriptFontManager
 {
     /************************************************************************
     *    DESC:  Load the data list table
+    *           The calls here are queued to the sync point when called
+    *           from a parallel script
     ************************************************************************/
     void Load( const std::string & filePath, const bool createFromData, CFontMgr & rFontMgr )
     {
         try
         {
-            rFontMgr.load( filePath, createFromData );
+            CFontMgr * pFontMgr = &rFontMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [filePath, createFromData, pFontMgr](){ pFontMgr->load( filePath, createFromData ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -45,7 +49,9 @@ namespace NScriptFontManager
     {
         try
         {
-            rFontMgr.createFromData();
+            CFontMgr * pFontMgr = &rFontMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [pFontMgr](){ pFontMgr->createFromData(); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
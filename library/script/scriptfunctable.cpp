@@ -0,0 +1,184 @@
+/************************************************************************
+*    FILE NAME:       scriptfunctable.cpp
+*
+*    DESCRIPTION:     Table of the script functions tied to events
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptfunctable.h>
+
+// Game lib dependencies
+#include <script/scriptmanager.h>
+#include <utilities/xmlParser.h>
+
+// Standard lib dependencies
+#include <unordered_map>
+#include <mutex>
+
+namespace
+{
+    // Interned event names. Seeded with the ids the library uses
+    std::unordered_map<std::string, uint> & IdMap()
+    {
+        static std::unordered_map<std::string, uint> idMap = {
+            {"init",     CScriptFuncTable::EFI_INIT},
+            {"update",   CScriptFuncTable::EFI_UPDATE},
+            {"disabled", CScriptFuncTable::EFI_DISABLED},
+            {"inactive", CScriptFuncTable::EFI_INACTIVE},
+            {"active",   CScriptFuncTable::EFI_ACTIVE},
+            {"selected", CScriptFuncTable::EFI_SELECTED},
+            {"start",    CScriptFuncTable::EFI_START},
+            {"stop",     CScriptFuncTable::EFI_STOP},
+            {"clear",    CScriptFuncTable::EFI_CLEAR},
+            {"animate",  CScriptFuncTable::EFI_ANIMATE} };
+
+        return idMap;
+    }
+
+    // Sprites can be loaded on a thread
+    std::mutex idMutex;
+}
+
+
+/************************************************************************
+*    DESC:  Get the id of the event name
+************************************************************************/
+uint CScriptFuncTable::GetId( const std::string & eventName )
+{
+    std::unique_lock<std::mutex> lock( idMutex );
+
+    auto & idMap = IdMap();
+
+    return idMap.emplace( eventName, idMap.size() ).first->second;
+}
+
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptFuncTable::CScriptFuncTable()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Load the events of the script list node
+************************************************************************/
+void CScriptFuncTable::loadFromNode( const XMLNode & node )
+{
+    // Check for scripting - Add an empty string for scripts not defined
+    XMLNode scriptLstNode = node.getChildNode( "scriptLst" );
+    if( !scriptLstNode.isEmpty() )
+    {
+        for( int i = 0; i < scriptLstNode.nChildNode(); ++i )
+        {
+            const XMLNode scriptNode = scriptLstNode.getChildNode(i);
+
+            // Only the first attribute is used
+            const XMLAttribute attribute = scriptNode.getAttribute(0);
+            const std::string attrValue = attribute.lpszValue;
+
+            // Add the attribute name and value to the table
+            if( !attrValue.empty() )
+                add( attribute.lpszName, attrValue );
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Add the function of the event
+************************************************************************/
+void CScriptFuncTable::add( const std::string & eventName, const std::string & funcName )
+{
+    const uint id = GetId( eventName );
+
+    if( !has( id ) )
+        getWritable().emplace_back( id, funcName );
+}
+
+void CScriptFuncTable::add( const CScriptFuncTable & table )
+{
+    if( table.empty() )
+        return;
+
+    if( empty() )
+    {
+        m_spEntryVec = table.m_spEntryVec;
+        return;
+    }
+
+    for( auto & iter : *table.m_spEntryVec )
+    {
+        if( !has( iter.m_id ) )
+            getWritable().emplace_back( iter.m_id, iter.m_funcName );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the entries to add to
+************************************************************************/
+std::vector<CScriptFuncTable::CEntry> & CScriptFuncTable::getWritable()
+{
+    if( !m_spEntryVec )
+        m_spEntryVec = std::make_shared< std::vector<CEntry> >();
+
+    else if( m_spEntryVec.use_count() > 1 )
+        m_spEntryVec = std::make_shared< std::vector<CEntry> >( *m_spEntryVec );
+
+    return *m_spEntryVec;
+}
+
+
+/************************************************************************
+*    DESC:  Is there a function for the event
+************************************************************************/
+bool CScriptFuncTable::has( uint id ) const
+{
+    if( m_spEntryVec )
+    {
+        for( auto & iter : *m_spEntryVec )
+            if( iter.m_id == id )
+                return true;
+    }
+
+    return false;
+}
+
+
+/************************************************************************
+*    DESC:  Is the table empty
+************************************************************************/
+bool CScriptFuncTable::empty() const
+{
+    return !m_spEntryVec || m_spEntryVec->empty();
+}
+
+
+/************************************************************************
+*    DESC:  Get the function of the event
+************************************************************************/
+asIScriptFunction * CScriptFuncTable::get( uint id, const std::string & group ) const
+{
+    if( m_spEntryVec )
+    {
+        for( auto & iter : *m_spEntryVec )
+        {
+            if( iter.m_id == id )
+            {
+                const uint generation = CScriptMgr::Instance().getGeneration();
+
+                if( (iter.m_pFunc == nullptr) || (iter.m_generation != generation) )
+                {
+                    iter.m_pFunc = CScriptMgr::Instance().getPtrToFunc( group, iter.m_funcName );
+                    iter.m_generation = generation;
+                }
+
+                return iter.m_pFunc;
+            }
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,103 @@
+/************************************************************************
+*    FILE NAME:       scriptfunctable.h
+*
+*    DESCRIPTION:     Table of the script functions tied to events
+*                     The event names are interned to ids and the
+*                     functions are kept in a small flat array that's
+*                     shared by the copies of the table. A function is
+*                     resolved to its AngelScript pointer the first time
+*                     it's used so the sprites of the same data only look
+*                     it up once.
+************************************************************************/
+
+#ifndef __script_func_table_h__
+#define __script_func_table_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <memory>
+
+// Forward declaration(s)
+class asIScriptFunction;
+struct XMLNode;
+
+class CScriptFuncTable
+{
+public:
+
+    // Ids of the events the library prepares. Other event
+    // names get the next id the first time they are seen
+    enum EFuncId
+    {
+        EFI_INIT,
+        EFI_UPDATE,
+        EFI_DISABLED,
+        EFI_INACTIVE,
+        EFI_ACTIVE,
+        EFI_SELECTED,
+        EFI_START,
+        EFI_STOP,
+        EFI_CLEAR,
+        EFI_ANIMATE,
+        EFI_COUNT
+    };
+
+    // Get the id of the event name
+    static uint GetId( const std::string & eventName );
+
+    // Constructor
+    CScriptFuncTable();
+
+    // Load the events of the script list node
+    // Only the first attribute of each child is used
+    void loadFromNode( const XMLNode & node );
+
+    // Add the function of the event. The first one added for an event is kept
+    void add( const std::string & eventName, const std::string & funcName );
+
+    // Add the functions of the table for events not already added
+    // An empty table shares the other's functions so they're only resolved once
+    void add( const CScriptFuncTable & table );
+
+    // Is there a function for the event
+    bool has( uint id ) const;
+
+    // Is the table empty
+    bool empty() const;
+
+    // Get the function of the event or nullptr if it has none
+    // Resolved from the group the first time and again after a group is loaded or freed
+    asIScriptFunction * get( uint id, const std::string & group ) const;
+
+private:
+
+    class CEntry
+    {
+    public:
+
+        CEntry( uint id, const std::string & funcName ) :
+            m_id(id), m_funcName(funcName), m_pFunc(nullptr), m_generation(0)
+        {}
+
+        uint m_id;
+        std::string m_funcName;
+
+        // The resolved function and the script manager generation it was resolved in
+        asIScriptFunction * m_pFunc;
+        uint m_generation;
+    };
+
+    // Get the entries to add to. Copied first if they are shared
+    std::vector<CEntry> & getWritable();
+
+private:
+
+    // Entries shared by the copies of the table
+    std::shared_ptr< std::vector<CEntry> > m_spEntryVec;
+};
+
+#endif  // __script_func_table_h__
@@ -45,6 +45,24 @@ namespace NScriptGlobals
         if( ctx )
             ctx->Suspend();
     }
+
+    /************************************************************************
+    *    DESC:  Print the debug message
+    *           Queued to the sync point when called from a parallel script
+    ************************************************************************/
+    void Print( const std::string & msg )
+    {
+        CScriptMgr::Instance().runOnMainThread( [msg](){ NGenFunc::PostDebugMsg( msg ); } );
+    }
+
+    /************************************************************************
+    *    DESC:  Dispatch the event
+    *           Queued to the sync point when called from a parallel script
+    ************************************************************************/
+    void DispatchEvent( int type, int code )
+    {
+        CScriptMgr::Instance().runOnMainThread( [type, code](){ NGenFunc::DispatchEvent( type, code ); } );
+    }
  
 
     /************************************************************************
@@ -54,13 +72,12 @@ namespace NScriptGlobals
     {
         asIScriptEngine * pEngine = CScriptMgr::Instance().getEnginePtr();
 
-        Throw( pEngine->RegisterGlobalFunction("void Print(string &in)", asFUNCTION(NGenFunc::PostDebugMsg), asCALL_CDECL) );
+        Throw( pEngine->RegisterGlobalFunction("void Print(string &in)", asFUNCTION(Print), asCALL_CDECL) );
         Throw( pEngine->RegisterGlobalFunction("void Suspend()", asFUNCTION(Suspend), asCALL_CDECL) );
         Throw( pEngine->RegisterGlobalFunction("int UniformRandomInt(int startRange, int endRange, int seed = 0)", asFUNCTION( NGenFunc::UniformRandomInt), asCALL_CDECL ) );
         Throw( pEngine->RegisterGlobalFunction("float UniformRandomFloat(float startRange, float endRange, int seed = 0)", asFUNCTION( NGenFunc::UniformRandomFloat), asCALL_CDECL ) );
-        // The DispatchEvent function has 4 parameters and because they are not defined here, they only return garbage
-        // AngelScript is not allowing the other two voided pointers
-        Throw( pEngine->RegisterGlobalFunction("void DispatchEvent(int type, int code = 0)", asFUNCTION(NGenFunc::DispatchEvent), asCALL_CDECL) );
+        // AngelScript is not allowing the two voided pointers of the event so they are passed as null
+        Throw( pEngine->RegisterGlobalFunction("void DispatchEvent(int type, int code = 0)", asFUNCTION(DispatchEvent), asCALL_CDECL) );
         Throw( pEngine->RegisterGlobalFunction("void Spawn(string &in)", asMETHOD(CScriptMgr, prepareSpawn), asCALL_THISCALL_ASGLOBAL, &CScriptMgr::Instance()) );
     }
 }
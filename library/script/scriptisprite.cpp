@@ -20,7 +20,8 @@
 
 namespace NScriptiSprite
 {
-    CPoint<float> point;
+    // One per thread for the scripts of the parallel groups
+    thread_local CPoint<float> point;
 
     /************************************************************************
     *    DESC:  Wrapper function due to virtual inheritance
@@ -156,9 +157,12 @@ namespace NScriptiSprite
         return sprite.getVisualInterface()->getDefaultAlpha();
     }
 
+    // Creates render buffers so a parallel script's call is queued to the sync point
     void CreateFontString(const std::string & fontStr, iSprite & sprite)
     {
-        sprite.getVisualInterface()->createFontString(fontStr);
+        iSprite * pSprite = &sprite;
+        CScriptMgr::Instance().runOnMainThread(
+            [fontStr, pSprite](){ pSprite->getVisualInterface()->createFontString(fontStr); } );
     }
 
     const std::string & GetFontString(iSprite & sprite)
@@ -176,24 +180,33 @@ namespace NScriptiSprite
         return sprite.getVisualInterface()->isFontSprite();
     }
 
+    // The physics world is shared so a parallel script's calls are queued to the sync point
     void SetTransform(float x, float y, float angle, bool resetVelocity, iSprite & sprite)
     {
-        sprite.getPhysicsInterface()->setTransform( x, y, angle, resetVelocity );
+        iSprite * pSprite = &sprite;
+        CScriptMgr::Instance().runOnMainThread(
+            [x, y, angle, resetVelocity, pSprite](){ pSprite->getPhysicsInterface()->setTransform( x, y, angle, resetVelocity ); } );
     }
 
     void SetLinearVelocity(float x, float y, iSprite & sprite)
     {
-        sprite.getPhysicsInterface()->setLinearVelocity( x, y );
+        iSprite * pSprite = &sprite;
+        CScriptMgr::Instance().runOnMainThread(
+            [x, y, pSprite](){ pSprite->getPhysicsInterface()->setLinearVelocity( x, y ); } );
     }
     
     void SetAngularVelocity(float angle, iSprite & sprite)
     {
-        sprite.getPhysicsInterface()->setAngularVelocity( angle );
+        iSprite * pSprite = &sprite;
+        CScriptMgr::Instance().runOnMainThread(
+            [angle, pSprite](){ pSprite->getPhysicsInterface()->setAngularVelocity( angle ); } );
     }
     
     void ApplyAngularImpulse(float value, bool wake, iSprite & sprite)
     {
-        sprite.getPhysicsInterface()->applyAngularImpulse( value, wake );
+        iSprite * pSprite = &sprite;
+        CScriptMgr::Instance().runOnMainThread(
+            [value, wake, pSprite](){ pSprite->getPhysicsInterface()->applyAngularImpulse( value, wake ); } );
     }
     
     /************************************************************************
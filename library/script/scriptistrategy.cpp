@@ -20,12 +20,49 @@
 namespace NScriptiStrategy
 {
     /************************************************************************
-    *    DESC:  Create a basic stage strategy                                                            
+    *    DESC:  Set the camera, the id offset and direction and the sprites
+    *           to destroy and create
+    *           Queued to the sync point when called from a parallel script
+    ************************************************************************/
+    void SetCameraId( const std::string & cameraId, iStrategy & rStrategy )
+    {
+        iStrategy * pStrategy = &rStrategy;
+        CScriptMgr::Instance().runOnMainThread( [cameraId, pStrategy](){ pStrategy->setCameraId( cameraId ); } );
+    }
+
+    void SetIdOffset( int offset, iStrategy & rStrategy )
+    {
+        iStrategy * pStrategy = &rStrategy;
+        CScriptMgr::Instance().runOnMainThread( [offset, pStrategy](){ pStrategy->setIdOffset( offset ); } );
+    }
+
+    void SetIdDir( int dir, iStrategy & rStrategy )
+    {
+        iStrategy * pStrategy = &rStrategy;
+        CScriptMgr::Instance().runOnMainThread( [dir, pStrategy](){ pStrategy->setIdDir( dir ); } );
+    }
+
+    void SetToDestroy( int spriteIndex, iStrategy & rStrategy )
+    {
+        iStrategy * pStrategy = &rStrategy;
+        CScriptMgr::Instance().runOnMainThread( [spriteIndex, pStrategy](){ pStrategy->setToDestroy( spriteIndex ); } );
+    }
+
+    void SetToCreate( const std::string & name, iStrategy & rStrategy )
+    {
+        iStrategy * pStrategy = &rStrategy;
+        CScriptMgr::Instance().runOnMainThread( [name, pStrategy](){ pStrategy->setToCreate( name ); } );
+    }
+
+    /************************************************************************
+    *    DESC:  Create a sprite. Can't be called from a parallel script
     ************************************************************************/
     iSprite * CreateSprite1( const std::string & group, const std::string & name, iStrategy & rStrategy )
     {
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createSprite" );
+
             return rStrategy.create( group, name );
         }
         catch( NExcept::CCriticalException & ex )
@@ -44,6 +81,8 @@ namespace NScriptiStrategy
     {
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createSprite" );
+
             return rStrategy.create( name );
         }
         catch( NExcept::CCriticalException & ex )
@@ -70,12 +109,12 @@ namespace NScriptiStrategy
         // Register type
         Throw( pEngine->RegisterObjectType("iStrategy", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setCameraId(string &in)",   asMETHOD(iStrategy, setCameraId),         asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setIdOffset(int)",          asMETHOD(iStrategy, setIdOffset),         asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setIdDir(int)",             asMETHOD(iStrategy, setIdDir),            asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setCameraId(string &in)",   asFUNCTION(SetCameraId),   asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setIdOffset(int)",          asFUNCTION(SetIdOffset),   asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setIdDir(int)",             asFUNCTION(SetIdDir),      asCALL_CDECL_OBJLAST) );
         
-        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setToDestroy(int)",         asMETHOD(iStrategy, setToDestroy),        asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setToCreate(string &in)",   asMETHOD(iStrategy, setToCreate),         asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setToDestroy(int)",         asFUNCTION(SetToDestroy),  asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("iStrategy", "void setToCreate(string &in)",   asFUNCTION(SetToCreate),   asCALL_CDECL_OBJLAST) );
         
         Throw( pEngine->RegisterObjectMethod("iStrategy", "iSprite & createSprite(string &in, string &in)", asFUNCTION(CreateSprite1), asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("iStrategy", "iSprite & createSprite(string &in)",             asFUNCTION(CreateSprite1), asCALL_CDECL_OBJLAST) );
@@ -14,20 +14,47 @@
 #include <utilities/genfunc.h>
 #include <utilities/statcounter.h>
 #include <script/scriptglobals.h>
+#include <script/scriptbytecode.h>
+#include <utilities/profiler.h>
+#include <utilities/settings.h>
+#include <utilities/highresolutiontimer.h>
+#include <common/build_defs.h>
+#include <utilities/threadpool.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
 // Standard lib dependencies
 #include <cstring>
+#include <algorithm>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
 
+namespace
+{
+    // User data of the modules of the groups flagged parallel in the list table
+    const asPWORD PARALLEL_USER_DATA = 1002;
+}
+
+thread_local bool CScriptMgr::m_parallelThread = false;
+thread_local std::vector<asIScriptContext *> * CScriptMgr::m_pParallelContextVec = nullptr;
+thread_local size_t CScriptMgr::m_parallelOrder = 0;
+thread_local std::vector<CScriptMgr::CCommand> * CScriptMgr::m_pCommandBuf = nullptr;
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
-CScriptMgr::CScriptMgr()
+CScriptMgr::CScriptMgr() :
+    m_generation(0),
+    m_frameBudget(0),
+    m_frameBudgetCount(0),
+    m_frameUsedCount(0),
+    m_frame(1),
+    m_sliceEnd(0),
+    m_executeDepth(0),
+    m_parallel(CSettings::Instance().getScriptParallel()),
+    m_commandsQueued(false)
 {
     // Create the script engine
     scpEngine.reset( asCreateScriptEngine(ANGELSCRIPT_VERSION) );
@@ -46,6 +73,12 @@ CScriptMgr::CScriptMgr()
     throw NExcept::CCriticalException("Error Creating AngelScript Engine!",
         boost::str( boost::format("AngelScript message callback could not be created.\n\n%s\nLine: %s")
             % __FUNCTION__ % __LINE__ ));
+
+    setFrameBudget( CSettings::Instance().getScriptFrameBudget() );
+
+    // The workers that execute the parallel scripts free AngelScript's thread data when they end
+    if( m_parallel )
+        CThreadPool::Instance().setThreadExit( [](){ asThreadCleanup(); } );
 }
 
 
@@ -63,6 +96,28 @@ CScriptMgr::~CScriptMgr()
 }
 
 
+/************************************************************************
+*    DESC:  Load the list table
+*           The groups flagged parallel="true" only call the game through
+*           functions that are safe to run on the workers
+************************************************************************/
+void CScriptMgr::loadListTable( const std::string & filePath )
+{
+    CManagerBase::loadListTable( filePath );
+
+    const XMLNode node = XMLNode::openFileHelper(filePath.c_str(), "listTable");
+
+    for( int i = 0; i < node.nChildNode(); ++i )
+    {
+        const XMLNode dataListNode = node.getChildNode("groupList", i);
+
+        if( dataListNode.isAttributeSet("parallel") &&
+            (std::strcmp( dataListNode.getAttribute("parallel"), "true" ) == 0) )
+            m_parallelGroupSet.insert( dataListNode.getAttribute("groupName") );
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Load all of the scripts of a specific group
 *
@@ -70,6 +125,11 @@ CScriptMgr::~CScriptMgr()
 ************************************************************************/
 void CScriptMgr::loadGroup( const std::string & group )
 {
+    PROFILE_ZONE( "CScriptMgr::loadGroup" );
+
+    // Function pointers of a rebuilt module are stale
+    ++m_generation;
+
     // Make sure the group we are looking has been defined in the list table file
     auto listTableIter = m_listTableMap.find( group );
     if( listTableIter == m_listTableMap.end() )
@@ -86,12 +146,43 @@ void CScriptMgr::loadGroup( const std::string & group )
                 % group % __FUNCTION__ % __LINE__ ));
     }
 
+    // Use the byte code saved the last time the group was built if nothing has changed
+    const std::string & byteCodePath = CSettings::Instance().getScriptByteCodePath();
+    std::string byteCodeFile;
+    uint64_t sourceHash(0), interfaceHash(0);
+
+    if( !byteCodePath.empty() )
+    {
+        byteCodeFile = NScriptByteCode::GetFilePath( byteCodePath, group );
+        sourceHash = NScriptByteCode::SourceHash( group, listTableIter->second );
+        interfaceHash = NScriptByteCode::InterfaceHash( scpEngine.get() );
+
+        if( NScriptByteCode::Load( pScriptModule, byteCodeFile, sourceHash, interfaceHash ) )
+        {
+            if( m_parallelGroupSet.find( group ) != m_parallelGroupSet.end() )
+                pScriptModule->SetUserData( this, PARALLEL_USER_DATA );
+
+            return;
+        }
+
+        // Start over with an empty module in case the byte code was partly loaded
+        pScriptModule = scpEngine->GetModule(group.c_str(), asGM_ALWAYS_CREATE);
+    }
+
     // Add the scripts to the module
     for( auto & iter : listTableIter->second )
         addScript( pScriptModule, iter );
 
     // Build all the scripts added to the module
     buildScript( pScriptModule, group );
+
+    // Save the byte code for the next time the group is loaded
+    if( !byteCodePath.empty() )
+        NScriptByteCode::Save( pScriptModule, byteCodeFile, sourceHash, interfaceHash );
+
+    // Flag the module so its contexts can be found without a look up by name
+    if( m_parallelGroupSet.find( group ) != m_parallelGroupSet.end() )
+        pScriptModule->SetUserData( this, PARALLEL_USER_DATA );
 }
 
 
@@ -230,6 +321,15 @@ asIScriptEngine * CScriptMgr::getEnginePtr()
 }
 
 
+/************************************************************************
+*    DESC:  Get the count of the group loads and frees
+************************************************************************/
+uint CScriptMgr::getGeneration() const
+{
+    return m_generation;
+}
+
+
 /************************************************************************
 *    DESC:  Free all of the scripts of a specific data group
 ************************************************************************/
@@ -244,11 +344,15 @@ void CScriptMgr::freeGroup( const std::string & group )
 
     // Discard the module and free its memory.
     scpEngine->DiscardModule( group.c_str() );
+    ++m_generation;
 
     // Erase the group from the map
     auto mapMapIter = m_scriptFunctMapMap.find( group );
     if( mapMapIter != m_scriptFunctMapMap.end() )
             m_scriptFunctMapMap.erase( mapMapIter );
+
+    // The timed function pointers are stale
+    CStatCounter::Instance().clearScriptTimes();
 }
 
 
@@ -259,64 +363,72 @@ void CScriptMgr::prepare(
     const std::string & group,
     const std::string & funcName,
     std::vector<asIScriptContext *> & pContextVec,
-    const std::vector<CScriptParam> & paramVec )
+    std::initializer_list<CScriptParam> paramList )
+{
+    prepare( getPtrToFunc(group, funcName), pContextVec, paramList );
+}
+
+void CScriptMgr::prepare(
+    const std::string & group,
+    const std::string & funcName,
+    std::initializer_list<CScriptParam> paramList )
+{
+    prepare( getPtrToFunc(group, funcName), m_pActiveContextVec, paramList );
+}
+
+void CScriptMgr::prepare(
+    asIScriptFunction * pScriptFunc,
+    std::vector<asIScriptContext *> & pContextVec,
+    std::initializer_list<CScriptParam> paramList )
 {
     // Get a context from the script manager pool
     pContextVec.push_back( getContext() );
     auto * pContext = pContextVec.back();
 
-    // Get the function pointer
-    asIScriptFunction * pScriptFunc = getPtrToFunc(group, funcName);
-
     // Prepare the function to run
     if( pContext->Prepare(pScriptFunc) < 0 )
     {
         throw NExcept::CCriticalException("Error Preparing Script!",
             boost::str( boost::format("There was an error preparing the script (%s).\n\n%s\nLine: %s")
-                % funcName % __FUNCTION__ % __LINE__ ));
+                % pScriptFunc->GetName() % __FUNCTION__ % __LINE__ ));
     }
 
     // Pass the parameters to the script function
-    for( size_t i = 0; i < paramVec.size(); ++i )
+    asUINT i(0);
+    for( auto & param : paramList )
     {
         int returnVal(0);
 
-        if( paramVec[i].getType() == CScriptParam::EPT_BOOL )
+        if( param.getType() == CScriptParam::EPT_BOOL )
         {
-            returnVal = pContext->SetArgByte(i, paramVec[i].get<bool>());
+            returnVal = pContext->SetArgByte(i, param.get<bool>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_INT )
+        else if( param.getType() == CScriptParam::EPT_INT )
         {
-            returnVal = pContext->SetArgDWord(i, paramVec[i].get<int>());
+            returnVal = pContext->SetArgDWord(i, param.get<int>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_UINT )
+        else if( param.getType() == CScriptParam::EPT_UINT )
         {
-            returnVal = pContext->SetArgDWord(i, paramVec[i].get<uint>());
+            returnVal = pContext->SetArgDWord(i, param.get<uint>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_FLOAT )
+        else if( param.getType() == CScriptParam::EPT_FLOAT )
         {
-            returnVal = pContext->SetArgFloat(i, paramVec[i].get<float>());
+            returnVal = pContext->SetArgFloat(i, param.get<float>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_REG_OBJ )
+        else if( param.getType() == CScriptParam::EPT_REG_OBJ )
         {
-            returnVal = pContext->SetArgObject(i, paramVec[i].get<void *>());
+            returnVal = pContext->SetArgObject(i, param.get<void *>());
         }
 
         if( returnVal < 0 )
         {
             throw NExcept::CCriticalException("Error Setting Script Param!",
                 boost::str( boost::format("There was an error setting the script parameter (%s).\n\n%s\nLine: %s")
-                    % funcName % __FUNCTION__ % __LINE__ ));
+                    % pScriptFunc->GetName() % __FUNCTION__ % __LINE__ ));
         }
-    }
-}
 
-void CScriptMgr::prepare(
-    const std::string & group,
-    const std::string & funcName,
-    const std::vector<CScriptParam> & paramVec )
-{
-    prepare( group, funcName, m_pActiveContextVec, paramVec );
+        ++i;
+    }
 }
 
 
@@ -332,7 +444,8 @@ void CScriptMgr::prepareSpawn( const std::string & funcName )
         std::string group = pContex->GetFunction()->GetModuleName();
 
         // Prepare the script function to run
-        prepare( group, funcName, m_pActiveContextVec );
+        runOnMainThread( [this, group, funcName]()
+            { prepare( group, funcName, m_pActiveContextVec ); } );
     }
 }
 
@@ -345,7 +458,8 @@ void CScriptMgr::prepareSpawnVoid( const std::string & funcName, void * pVoid )
         std::string group = pContex->GetFunction()->GetModuleName();
 
         // Prepare the script function to run
-        prepare( group, funcName, m_pActiveContextVec, {pVoid} );
+        runOnMainThread( [this, group, funcName, pVoid]()
+            { prepare( group, funcName, m_pActiveContextVec, {pVoid} ); } );
     }
 }
 
@@ -357,51 +471,105 @@ void CScriptMgr::prepareLocalSpawnVoid( const std::string & funcName, void * pVo
         // Get the module name
         std::string group = pContex->GetFunction()->GetModuleName();
 
-        // Prepare the script function to run
-        prepare( group, funcName, m_pLocalSpawnContextVec, {pVoid} );
+        // A parallel script's local spawn is added to the vector it's executing
+        // at the sync point. It starts executing in the next update
+        if( m_parallelThread )
+        {
+            auto pContextVec = m_pParallelContextVec;
+            queueCommand( [this, group, funcName, pVoid, pContextVec]()
+                { prepare( group, funcName, *pContextVec, {pVoid} ); } );
+        }
+        else
+        {
+            // Prepare the script function to run
+            prepare( group, funcName, m_pLocalSpawnContextVec, {pVoid} );
+        }
     }
 }
 
 
+/************************************************************************
+*    DESC:  Start the script time budget of the frame
+************************************************************************/
+void CScriptMgr::beginFrame()
+{
+    ++m_frame;
+    m_frameUsedCount = 0;
+}
+
+
+/************************************************************************
+*    DESC:  Set/Get the script time budget of a frame in microseconds
+************************************************************************/
+void CScriptMgr::setFrameBudget( uint microseconds )
+{
+    m_frameBudget = microseconds;
+    m_frameBudgetCount = static_cast<uint64_t>(microseconds / (CHighResTimer::Instance().toMilliseconds( 1 ) * 1000.0));
+}
+
+uint CScriptMgr::getFrameBudget() const
+{
+    return m_frameBudget;
+}
+
+
 /************************************************************************
 *    DESC:  Update the script
 ************************************************************************/
 void CScriptMgr::update()
 {
+    PROFILE_ZONE( "CScriptMgr::update" );
+
     if( !m_pActiveContextVec.empty() )
         update( m_pActiveContextVec );
 }
 
-void CScriptMgr::update( std::vector<asIScriptContext *> & pContextVec )
+void CScriptMgr::update(
+    std::vector<asIScriptContext *> & pContextVec,
+    NDefs::EScriptPriority priority,
+    bool leaveParallel )
 {
+    leaveParallel = leaveParallel && m_parallel;
+
+    // With a budget, the contexts start from a different one each frame
+    // so the ones late in the vector aren't always the ones left over budget
+    const size_t count = pContextVec.size();
+    const size_t start = ((m_frameBudgetCount != 0) && (count > 1)) ? (m_frame % count) : 0;
+
     // Using a for loop because it simplifies the implementation that new
     // spawns are added to the vector be it through a local spawn or a global spawn.
     // For example, if this is the m_pActiveContextVec, PrepareSpawn adds a context to the vector
-    for( size_t i = 0; i < pContextVec.size(); ++i )
+    // The spawns are added past the contexts the loop started with and run after them
+    for( size_t n = 0; n < pContextVec.size(); ++n )
     {
+        const size_t i = (n < count) ? ((start + n) % count) : n;
         auto pContext = pContextVec[i];
 
         // See if this context is still being used
         if( (pContext->GetState() == asEXECUTION_SUSPENDED) ||
             (pContext->GetState() == asEXECUTION_PREPARED) )
         {
-            // Increment the active script context counter
-            CStatCounter::Instance().incActiveScriptContexCounter();
+            // Executed on the workers by parallelUpdate
+            if( leaveParallel && isParallelSafe( pContext ) )
+                continue;
 
-            // Execute the script and check for errors
-            // Since the script can be suspended, this also is used to continue execution
-            const int execReturnCode = pContext->Execute();
-            if( execReturnCode == asEXECUTION_ERROR )
+            if( m_frameBudgetCount == 0 )
             {
-                throw NExcept::CCriticalException(
-                    "Error Calling Spawn Script!",
-                    "There was an error executing the script.");
+                execute( pContext, 0, NBDefs::IsDebugMode() ? CHighResTimer::Instance().getCounter() : 0 );
             }
-            else if( execReturnCode == asEXECUTION_EXCEPTION )
+            else
             {
-                throw NExcept::CCriticalException("Error Calling Spawn Script!",
-                    boost::str( boost::format("There was an error executing the script (%s).")
-                        % pContext->GetExceptionString() ));
+                const uint64_t now = CHighResTimer::Instance().getCounter();
+                const uint64_t sliceEnd = getSliceEnd( priority, now );
+
+                // Over budget. Leave the context for the next frame
+                if( sliceEnd == 0 )
+                {
+                    CStatCounter::Instance().incDeferredScriptContexCounter();
+                    continue;
+                }
+
+                execute( pContext, sliceEnd, now );
             }
 
             // If this execution spawned any local contexts, they will be in this vector.
@@ -416,18 +584,248 @@ void CScriptMgr::update( std::vector<asIScriptContext *> & pContextVec )
         }
     }
 
-    auto iter = pContextVec.begin();
-    while( iter != pContextVec.end() )
+    // Return the finished contexts to the pool. The last context is swapped
+    // into the place of a finished one so the compaction is a single pass
+    size_t i(0);
+    while( i < pContextVec.size() )
     {
-        // Return the context to the pool if it has not been suspended
-        if( (*iter)->GetState() != asEXECUTION_SUSPENDED )
+        const auto state = pContextVec[i]->GetState();
+
+        // Keep the contexts that are suspended or were left over budget
+        if( (state != asEXECUTION_SUSPENDED) && (state != asEXECUTION_PREPARED) )
         {
-            recycleContext( (*iter) );
-            iter = pContextVec.erase( iter );
+            recycleContext( pContextVec[i] );
+            pContextVec[i] = pContextVec.back();
+            pContextVec.pop_back();
         }
         else
         {
-            ++iter;
+            ++i;
         }
     }
 }
+
+
+/************************************************************************
+*    DESC:  Get the performance count the context has to suspend at
+*           Zero is don't run it this frame
+************************************************************************/
+uint64_t CScriptMgr::getSliceEnd( NDefs::EScriptPriority priority, uint64_t now ) const
+{
+    // Every slice comes out of what's left of the frame budget. The AI scripts
+    // leave the last quarter to the UI and background scripts get the first half
+    uint64_t limit = m_frameBudgetCount;
+    if( priority == NDefs::ESP_AI )
+        limit -= m_frameBudgetCount / 4;
+    else if( priority == NDefs::ESP_BACKGROUND )
+        limit = m_frameBudgetCount / 2;
+    if( m_frameUsedCount < limit )
+        return now + (limit - m_frameUsedCount);
+
+    return 0;
+}
+
+
+/************************************************************************
+*    DESC:  Execute the context until it ends or suspends
+*           Since the script can be suspended, this also is used to continue execution
+************************************************************************/
+void CScriptMgr::execute( asIScriptContext * pContext, uint64_t sliceEnd, uint64_t start )
+{
+    // Increment the active script context counter
+    CStatCounter::Instance().incActiveScriptContexCounter();
+
+    // A context executed from within a script has its own slice
+    const uint64_t lastSliceEnd = m_sliceEnd;
+    m_sliceEnd = sliceEnd;
+
+    if( sliceEnd != 0 )
+        pContext->SetLineCallback( asMETHOD(CScriptMgr, lineCallback), this, asCALL_THISCALL );
+
+    // The function the context was prepared with is at the bottom of the call stack
+    asIScriptFunction * pScriptFunc = pContext->GetFunction( pContext->GetCallstackSize() - 1 );
+
+    // Execute the script and check for errors
+    ++m_executeDepth;
+    const int execReturnCode = pContext->Execute();
+    --m_executeDepth;
+
+    m_sliceEnd = lastSliceEnd;
+
+    checkExecuteError( pContext, execReturnCode );
+
+    if( start != 0 )
+    {
+        const uint64_t elapsed = CHighResTimer::Instance().getCounter() - start;
+
+        // The time of a context executed from within a script is part of the outer one
+        if( m_executeDepth == 0 )
+            m_frameUsedCount += elapsed;
+
+        if( NBDefs::IsDebugMode() && (pScriptFunc != nullptr) )
+            CStatCounter::Instance().addScriptTime(
+                pScriptFunc, pScriptFunc->GetName(), CHighResTimer::Instance().toMilliseconds( elapsed ) );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Throw if the execution ended in an error
+************************************************************************/
+void CScriptMgr::checkExecuteError( asIScriptContext * pContext, int execReturnCode )
+{
+    if( execReturnCode == asEXECUTION_ERROR )
+    {
+        throw NExcept::CCriticalException(
+            "Error Calling Spawn Script!",
+            "There was an error executing the script.");
+    }
+    else if( execReturnCode == asEXECUTION_EXCEPTION )
+    {
+        throw NExcept::CCriticalException("Error Calling Spawn Script!",
+            boost::str( boost::format("There was an error executing the script (%s).")
+                % pContext->GetExceptionString() ));
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Are the contexts of the parallel groups run on the workers
+************************************************************************/
+bool CScriptMgr::isParallel() const
+{
+    return m_parallel;
+}
+
+
+/************************************************************************
+*    DESC:  Is the context's function in a parallel group
+************************************************************************/
+bool CScriptMgr::isParallelSafe( asIScriptContext * pContext ) const
+{
+    asIScriptFunction * pScriptFunc = pContext->GetFunction( pContext->GetCallstackSize() - 1 );
+    if( pScriptFunc == nullptr )
+        return false;
+
+    asIScriptModule * pScriptModule = pScriptFunc->GetModule();
+
+    return (pScriptModule != nullptr) && (pScriptModule->GetUserData( PARALLEL_USER_DATA ) != nullptr);
+}
+
+
+/************************************************************************
+*    DESC:  Execute the contexts of the parallel groups
+*           Can be called from the workers. The calls into the game are
+*           queued until applyCommands. These contexts aren't budgeted
+*           and the finished ones are recycled by the serial update
+************************************************************************/
+void CScriptMgr::parallelUpdate( std::vector<asIScriptContext *> & pContextVec )
+{
+    const bool lastParallelThread = m_parallelThread;
+    auto pLastContextVec = m_pParallelContextVec;
+    m_parallelThread = true;
+    m_pParallelContextVec = &pContextVec;
+
+    // Spawns are queued so the vector doesn't change while it's executed
+    for( auto pContext : pContextVec )
+    {
+        if( ((pContext->GetState() == asEXECUTION_SUSPENDED) ||
+             (pContext->GetState() == asEXECUTION_PREPARED)) &&
+            isParallelSafe( pContext ) )
+        {
+            // The line call back uses the time slice of the main thread
+            pContext->ClearLineCallback();
+
+            checkExecuteError( pContext, pContext->Execute() );
+        }
+    }
+
+    m_parallelThread = lastParallelThread;
+    m_pParallelContextVec = pLastContextVec;
+}
+
+
+/************************************************************************
+*    DESC:  Set the order the calls queued by the calling thread are applied in
+*           The sprite index so the game sees the calls in the same order
+*           no matter how the sprites were split between the workers
+************************************************************************/
+void CScriptMgr::setParallelOrder( size_t order )
+{
+    m_parallelOrder = order;
+}
+
+
+/************************************************************************
+*    DESC:  Queue a call for the sync point
+*           Each thread has its own buffer. The lock is only taken the
+*           first time a thread queues a call
+************************************************************************/
+void CScriptMgr::queueCommand( std::function<void()> && command )
+{
+    if( m_pCommandBuf == nullptr )
+    {
+        std::lock_guard<std::mutex> lock( m_commandMutex );
+        m_upCommandBufVec.emplace_back( new std::vector<CCommand> );
+        m_pCommandBuf = m_upCommandBufVec.back().get();
+    }
+
+    m_pCommandBuf->push_back( {m_parallelOrder, std::move(command)} );
+    m_commandsQueued = true;
+}
+
+
+/************************************************************************
+*    DESC:  Throw if called from a parallel script
+*           For the calls that return what they make so they can't be queued
+************************************************************************/
+void CScriptMgr::mainThreadOnly( const std::string & funcName ) const
+{
+    if( m_parallelThread )
+    {
+        throw NExcept::CCriticalException("Script Call Error!",
+            boost::str( boost::format("Function can't be called from a parallel script group (%s).\n\n%s\nLine: %s")
+                % funcName % __FUNCTION__ % __LINE__ ));
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Run the calls queued by the parallel scripts
+*           The sync point. Only call from the main thread when the
+*           workers are done
+************************************************************************/
+void CScriptMgr::applyCommands()
+{
+    if( !m_commandsQueued )
+        return;
+
+    PROFILE_ZONE( "CScriptMgr::applyCommands" );
+
+    m_commandsQueued = false;
+
+    for( auto & upCommandBuf : m_upCommandBufVec )
+    {
+        std::move( upCommandBuf->begin(), upCommandBuf->end(), std::back_inserter(m_applyVec) );
+        upCommandBuf->clear();
+    }
+
+    // The calls of a sprite were all queued by one thread so they stay in the order they were made
+    std::stable_sort( m_applyVec.begin(), m_applyVec.end(),
+        []( const CCommand & a, const CCommand & b ){ return a.m_order < b.m_order; } );
+
+    for( auto & iter : m_applyVec )
+        iter.m_func();
+
+    m_applyVec.clear();
+}
+
+
+/************************************************************************
+*    DESC:  Call back to suspend the executing context when its time slice is used up
+************************************************************************/
+void CScriptMgr::lineCallback( asIScriptContext * pContext )
+{
+    if( (m_sliceEnd != 0) && (CHighResTimer::Instance().getCounter() >= m_sliceEnd) )
+        pContext->Suspend();
+}
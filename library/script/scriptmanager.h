@@ -18,6 +18,12 @@
 // Standard lib dependencies
 #include <string>
 #include <vector>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
 
 // Forward declaration(s)
 class asIScriptEngine;
@@ -40,6 +46,10 @@ public:
 
     // Get the pointer to the script engine
     asIScriptEngine * getEnginePtr();
+    
+    // Load the list table. The groups flagged parallel="true" only call
+    // the game through functions that are safe to run on the workers
+    void loadListTable( const std::string & filePath );
 
     // Load all of the scripts of a specific group
     void loadGroup( const std::string & group );
@@ -52,9 +62,42 @@ public:
     //       holding on to it when the game terminates
     asIScriptContext * getContext();
     
+    // Start the script time budget of the frame
+    void beginFrame();
+    
+    // Set/Get the script time budget of a frame in microseconds. Zero is no budget
+    void setFrameBudget( uint microseconds );
+    uint getFrameBudget() const;
+    
     // Update the active scripts
+    // Over budget, contexts are left suspended and resumed the next frame
+    // In parallel mode the contexts of the parallel groups can be left for parallelUpdate
     void update();
-    void update( std::vector<asIScriptContext *> & pContextVec );
+    void update(
+        std::vector<asIScriptContext *> & pContextVec,
+        NDefs::EScriptPriority priority = NDefs::ESP_AI,
+        bool leaveParallel = false );
+    
+    // Are the contexts of the parallel groups run on the workers
+    bool isParallel() const;
+    
+    // Execute the contexts of the parallel groups. Can be called from the workers
+    // Their calls into the game are queued until applyCommands is called
+    void parallelUpdate( std::vector<asIScriptContext *> & pContextVec );
+    
+    // Set the order the calls queued by the calling thread are applied in
+    void setParallelOrder( size_t order );
+    
+    // Run the call now or queue it for the sync point when called from a parallel script
+    template<class F>
+    void runOnMainThread( F && func );
+    
+    // Throw if called from a parallel script
+    // For the calls that return what they make so they can't be queued
+    void mainThreadOnly( const std::string & funcName ) const;
+    
+    // Run the calls queued by the parallel scripts. The sync point on the main thread
+    void applyCommands();
 
     // Add the script context back to the managed pool
     void recycleContext( asIScriptContext * pContext );
@@ -62,17 +105,27 @@ public:
     // Get pointer to function
     asIScriptFunction * getPtrToFunc( const std::string & group, const std::string & name );
     
+    // Get the count of the group loads and frees
+    // Function pointers gotten before the count changed may be stale
+    uint getGeneration() const;
+    
     // Prepare the script function to run
+    // The params are passed in a fixed list so nothing is allocated
     void prepare(
         const std::string & group,
         const std::string & funcName,
         std::vector<asIScriptContext *> & pContextVec,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        std::initializer_list<CScriptParam> paramList = {} );
     
     void prepare(
         const std::string & group,
         const std::string & funcName,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        std::initializer_list<CScriptParam> paramList = {} );
+    
+    void prepare(
+        asIScriptFunction * pScriptFunc,
+        std::vector<asIScriptContext *> & pContextVec,
+        std::initializer_list<CScriptParam> paramList = {} );
     
     // Prepare the spawn script function to run
     void prepareSpawn( const std::string & funcName );
@@ -95,6 +148,24 @@ private:
 
     // Call back to display AngelScript messages
     void messageCallback(const asSMessageInfo & msg);
+    
+    // Call back to suspend the executing context when its time slice is used up
+    void lineCallback( asIScriptContext * pContext );
+    
+    // Get the performance count the context has to suspend at. Zero is don't run it this frame
+    uint64_t getSliceEnd( NDefs::EScriptPriority priority, uint64_t now ) const;
+    
+    // Execute the context until it ends or suspends
+    void execute( asIScriptContext * pContext, uint64_t sliceEnd, uint64_t start );
+    
+    // Throw if the execution ended in an error
+    void checkExecuteError( asIScriptContext * pContext, int execReturnCode );
+    
+    // Is the context's function in a parallel group
+    bool isParallelSafe( asIScriptContext * pContext ) const;
+    
+    // Queue a call for the sync point
+    void queueCommand( std::function<void()> && command );
 
 private:
 
@@ -112,9 +183,69 @@ private:
     
     // Holds the spawn contexts to be added to the component pool
     std::vector<asIScriptContext *> m_pLocalSpawnContextVec;
+    
+    // Count of the group loads and frees
+    uint m_generation;
+    
+    // Script time budget of a frame in microseconds and performance counts
+    uint m_frameBudget;
+    uint64_t m_frameBudgetCount;
+    
+    // Script time used this frame in performance counts
+    uint64_t m_frameUsedCount;
+    
+    // Frame count. Rotates the context the update starts from
+    uint m_frame;
+    
+    // Performance count the executing context suspends at
+    uint64_t m_sliceEnd;
+    
+    // Depth of the contexts executing from within a script
+    int m_executeDepth;
+    
+    // Run the parallel groups on the workers and the groups flagged in the list table
+    bool m_parallel;
+    std::set<std::string> m_parallelGroupSet;
+    
+    // Call queued by a parallel script and the order it's applied in
+    class CCommand
+    {
+    public:
+        size_t m_order;
+        std::function<void()> m_func;
+    };
+    
+    // A command buffer per thread so the workers don't contend
+    std::vector< std::unique_ptr< std::vector<CCommand> > > m_upCommandBufVec;
+    std::mutex m_commandMutex;
+    std::atomic<bool> m_commandsQueued;
+    
+    // Reused to sort the commands being applied
+    std::vector<CCommand> m_applyVec;
+    
+    // Is the thread executing parallel scripts, the vector it's executing,
+    // the order of its queued calls and its command buffer
+    static thread_local bool m_parallelThread;
+    static thread_local std::vector<asIScriptContext *> * m_pParallelContextVec;
+    static thread_local size_t m_parallelOrder;
+    static thread_local std::vector<CCommand> * m_pCommandBuf;
 
 };
 
+
+/************************************************************************
+*    DESC:  Run the call now or queue it for the sync point when called
+*           from a parallel script
+************************************************************************/
+template<class F>
+void CScriptMgr::runOnMainThread( F && func )
+{
+    if( m_parallelThread )
+        queueCommand( std::function<void()>( std::forward<F>(func) ) );
+    else
+        func();
+}
+
 #endif  // __script_manager_h__
 
 
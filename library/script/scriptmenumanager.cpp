@@ -21,12 +21,16 @@ namespace NScriptMenuManager
 {
     /************************************************************************
     *    DESC:  Load the data list table
+    *           The calls that change the menus are queued to the sync
+    *           point when called from a parallel script
     ************************************************************************/
     void LoadListTable( const std::string & filePath, CMenuMgr & rMenuMgr )
     {
         try
         {
-            rMenuMgr.loadListTable( filePath );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [filePath, pMenuMgr](){ pMenuMgr->loadListTable( filePath ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -45,7 +49,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.loadGroup( group, doInit );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, doInit, pMenuMgr](){ pMenuMgr->loadGroup( group, doInit ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -64,7 +70,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.initGroup( group );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pMenuMgr](){ pMenuMgr->initGroup( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -83,7 +91,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.freeGroup( group );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pMenuMgr](){ pMenuMgr->freeGroup( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -102,7 +112,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.activateMenu( group, treeStr, menuName );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, treeStr, menuName, pMenuMgr](){ pMenuMgr->activateMenu( group, treeStr, menuName ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -121,7 +133,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.activateMenu( treeStr, menuName );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [treeStr, menuName, pMenuMgr](){ pMenuMgr->activateMenu( treeStr, menuName ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -140,7 +154,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.activateTree( group, treeStr );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, treeStr, pMenuMgr](){ pMenuMgr->activateTree( group, treeStr ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -159,7 +175,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.activateTree( treeStr );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [treeStr, pMenuMgr](){ pMenuMgr->activateTree( treeStr ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -178,7 +196,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.deactivateTree( group, treeStr );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, treeStr, pMenuMgr](){ pMenuMgr->deactivateTree( group, treeStr ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -197,7 +217,9 @@ namespace NScriptMenuManager
     {
         try
         {
-            rMenuMgr.deactivateTree( treeStr );
+            CMenuMgr * pMenuMgr = &rMenuMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [treeStr, pMenuMgr](){ pMenuMgr->deactivateTree( treeStr ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -251,6 +273,33 @@ namespace NScriptMenuManager
         return nullptr;
     }
 
+    /************************************************************************
+    *    DESC:  Load the menu action, clear the trees, reset the offset and allow the menus
+    ************************************************************************/
+    void LoadMenuAction( const std::string & filePath, CMenuMgr & rMenuMgr )
+    {
+        CMenuMgr * pMenuMgr = &rMenuMgr;
+        CScriptMgr::Instance().runOnMainThread( [filePath, pMenuMgr](){ pMenuMgr->loadMenuAction( filePath ); } );
+    }
+
+    void ClearActiveTrees( CMenuMgr & rMenuMgr )
+    {
+        CMenuMgr * pMenuMgr = &rMenuMgr;
+        CScriptMgr::Instance().runOnMainThread( [pMenuMgr](){ pMenuMgr->clearActiveTrees(); } );
+    }
+
+    void ResetDynamicOffset( CMenuMgr & rMenuMgr )
+    {
+        CMenuMgr * pMenuMgr = &rMenuMgr;
+        CScriptMgr::Instance().runOnMainThread( [pMenuMgr](){ pMenuMgr->resetDynamicOffset(); } );
+    }
+
+    void Allow( bool allow, CMenuMgr & rMenuMgr )
+    {
+        CMenuMgr * pMenuMgr = &rMenuMgr;
+        CScriptMgr::Instance().runOnMainThread( [allow, pMenuMgr](){ pMenuMgr->allow( allow ); } );
+    }
+
     /************************************************************************
     *    DESC:  Register global functions
     ************************************************************************/
@@ -266,7 +315,7 @@ namespace NScriptMenuManager
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CUIControl & getMenuControl(string &in, string &in)", asMETHOD(CMenuMgr, getPtrToMenuControl), asCALL_THISCALL) );
 
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadListTable(string &in)",                 asFUNCTION(LoadListTable),              asCALL_CDECL_OBJLAST) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadMenuAction(string &in)",                asMETHOD(CMenuMgr, loadMenuAction), asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadMenuAction(string &in)",                asFUNCTION(LoadMenuAction),         asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadGroup(string &in, bool doInit = true)", asFUNCTION(LoadGroup),              asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void initGroup(string &in)",                     asFUNCTION(InitGroup),              asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void freeGroup(string &in)",                     asFUNCTION(FreeGroup),              asCALL_CDECL_OBJLAST) );
@@ -280,7 +329,7 @@ namespace NScriptMenuManager
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void deactivateTree(string &in, string &in)",           asFUNCTION(DeactivateTree1),   asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void deactivateTree(string &in)",                       asFUNCTION(DeactivateTree2),   asCALL_CDECL_OBJLAST) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void clearActiveTrees(string &in)",                     asMETHOD(CMenuMgr, clearActiveTrees),  asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void clearActiveTrees()",                               asFUNCTION(ClearActiveTrees),  asCALL_CDECL_OBJLAST) );
 
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CMenu & getMenu(string &in)",                           asFUNCTION(GetMenu),   asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CMenu & getActiveMenu()",                               asFUNCTION(GetActiveMenu),   asCALL_CDECL_OBJLAST) );
@@ -291,8 +340,8 @@ namespace NScriptMenuManager
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isMenuItemActive()",        asMETHOD(CMenuMgr, isMenuItemActive), asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isInterfaceItemActive()",   asMETHOD(CMenuMgr, isInterfaceItemActive), asCALL_THISCALL) );
         
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void resetDynamicOffset()",      asMETHOD(CMenuMgr, resetDynamicOffset), asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void allow(bool allow = true)",  asMETHOD(CMenuMgr, allow), asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void resetDynamicOffset()",      asFUNCTION(ResetDynamicOffset), asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void allow(bool allow = true)",  asFUNCTION(Allow), asCALL_CDECL_OBJLAST) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CMenuMgr MenuMgr", &CMenuMgr::Instance()) );
@@ -20,13 +20,17 @@
 namespace NScriptObjectDataManager
 {
     /************************************************************************
-    *    DESC:  Load the data list table                                                            
+    *    DESC:  Load the data list table
+    *           The calls here are queued to the sync point when called
+    *           from a parallel script
     ************************************************************************/
     void LoadListTable( const std::string & filePath, CObjectDataMgr & rObjectDataMgr )
     {
         try
         {
-            rObjectDataMgr.loadListTable( filePath );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [filePath, pObjectDataMgr](){ pObjectDataMgr->loadListTable( filePath ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -45,7 +49,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.loadGroup2D( group, createFromData );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, createFromData, pObjectDataMgr](){ pObjectDataMgr->loadGroup2D( group, createFromData ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -61,7 +67,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.loadGroup3D( group, createFromData );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, createFromData, pObjectDataMgr](){ pObjectDataMgr->loadGroup3D( group, createFromData ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -80,7 +88,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.createFromData2D( group );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pObjectDataMgr](){ pObjectDataMgr->createFromData2D( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -96,7 +106,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.createFromData2D( group );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pObjectDataMgr](){ pObjectDataMgr->createFromData2D( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -115,7 +127,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.freeGroup2D( group, freeOpenGLObjects );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, freeOpenGLObjects, pObjectDataMgr](){ pObjectDataMgr->freeGroup2D( group, freeOpenGLObjects ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -131,7 +145,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.freeGroup3D( group, freeOpenGLObjects );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, freeOpenGLObjects, pObjectDataMgr](){ pObjectDataMgr->freeGroup3D( group, freeOpenGLObjects ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -150,7 +166,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.freeOpenGL2D( group );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pObjectDataMgr](){ pObjectDataMgr->freeOpenGL2D( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -166,7 +184,9 @@ namespace NScriptObjectDataManager
     {
         try
         {
-            rObjectDataMgr.freeOpenGL3D( group );
+            CObjectDataMgr * pObjectDataMgr = &rObjectDataMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pObjectDataMgr](){ pObjectDataMgr->freeOpenGL3D( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
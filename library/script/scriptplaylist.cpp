@@ -18,6 +18,40 @@
 
 namespace NScriptPlayLst
 {
+    /************************************************************************
+    *    DESC:  Play, stop, pause, resume and set the volume
+    *           Queued to the sync point when called from a parallel script
+    ************************************************************************/
+    void Play( int channel, int loopCount, CPlayList & rPlayList )
+    {
+        CPlayList * pPlayList = &rPlayList;
+        CScriptMgr::Instance().runOnMainThread( [channel, loopCount, pPlayList](){ pPlayList->play( channel, loopCount ); } );
+    }
+
+    void Stop( CPlayList & rPlayList )
+    {
+        CPlayList * pPlayList = &rPlayList;
+        CScriptMgr::Instance().runOnMainThread( [pPlayList](){ pPlayList->stop(); } );
+    }
+
+    void Pause( CPlayList & rPlayList )
+    {
+        CPlayList * pPlayList = &rPlayList;
+        CScriptMgr::Instance().runOnMainThread( [pPlayList](){ pPlayList->pause(); } );
+    }
+
+    void Resume( CPlayList & rPlayList )
+    {
+        CPlayList * pPlayList = &rPlayList;
+        CScriptMgr::Instance().runOnMainThread( [pPlayList](){ pPlayList->resume(); } );
+    }
+
+    void SetVolume( int volume, CPlayList & rPlayList )
+    {
+        CPlayList * pPlayList = &rPlayList;
+        CScriptMgr::Instance().runOnMainThread( [volume, pPlayList](){ pPlayList->setVolume( volume ); } );
+    }
+
     /************************************************************************
     *    DESC:  Register the class with AngelScript
     ************************************************************************/
@@ -30,11 +64,11 @@ namespace NScriptPlayLst
         // Register type
         Throw( pEngine->RegisterObjectType("CPlayList", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void play( int channel = -1, int loopCount = 0 )", asMETHOD(CPlayList, play),      asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void stop()",                                      asMETHOD(CPlayList, stop),      asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void pause()",                                     asMETHOD(CPlayList, pause),     asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void resume()",                                    asMETHOD(CPlayList, resume),    asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void setVolume(int)",                              asMETHOD(CPlayList, setVolume), asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void play( int channel = -1, int loopCount = 0 )", asFUNCTION(Play),               asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void stop()",                                      asFUNCTION(Stop),               asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void pause()",                                     asFUNCTION(Pause),              asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void resume()",                                    asFUNCTION(Resume),             asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void setVolume(int)",                              asFUNCTION(SetVolume),          asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CPlayList", "int getVolume()",                                  asMETHOD(CPlayList, getVolume), asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CPlayList", "bool isPlaying()",                                 asMETHOD(CPlayList, isPlaying), asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CPlayList", "bool isPaused()",                                  asMETHOD(CPlayList, isPaused),  asCALL_THISCALL) );
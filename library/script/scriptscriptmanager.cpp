@@ -19,13 +19,17 @@
 namespace NScriptScriptManager
 {
     /************************************************************************
-    *    DESC:  Load the script group                                                            
+    *    DESC:  Load the script group
+    *           The calls here are queued to the sync point when called
+    *           from a parallel script
     ************************************************************************/
     void LoadGroup( const std::string & group, CScriptMgr & rScriptMgr )
     {
         try
         {
-            rScriptMgr.loadGroup( group );
+            CScriptMgr * pScriptMgr = &rScriptMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pScriptMgr](){ pScriptMgr->loadGroup( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -44,7 +48,9 @@ namespace NScriptScriptManager
     {
         try
         {
-            rScriptMgr.freeGroup( group );
+            CScriptMgr * pScriptMgr = &rScriptMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pScriptMgr](){ pScriptMgr->freeGroup( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
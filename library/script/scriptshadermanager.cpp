@@ -21,13 +21,17 @@
 namespace NScriptShaderManager
 {
     /************************************************************************
-    *    DESC:  Load the shader from xml file path                                                        
+    *    DESC:  Load the shader from xml file path
+    *           The calls here are queued to the sync point when called
+    *           from a parallel script
     ************************************************************************/
     void Load( const std::string & filePath, CShaderMgr & rShaderMgr )
     {
         try
         {
-            rShaderMgr.load( filePath );
+            CShaderMgr * pShaderMgr = &rShaderMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [filePath, pShaderMgr](){ pShaderMgr->load( filePath ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
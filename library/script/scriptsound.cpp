@@ -18,6 +18,40 @@
 
 namespace NScriptSound
 {
+    /************************************************************************
+    *    DESC:  Play, stop, pause, resume and set the volume
+    *           Queued to the sync point when called from a parallel script
+    ************************************************************************/
+    void Play( int channel, int loopCount, CSound & rSound )
+    {
+        CSound * pSound = &rSound;
+        CScriptMgr::Instance().runOnMainThread( [channel, loopCount, pSound](){ pSound->play( channel, loopCount ); } );
+    }
+
+    void Stop( CSound & rSound )
+    {
+        CSound * pSound = &rSound;
+        CScriptMgr::Instance().runOnMainThread( [pSound](){ pSound->stop(); } );
+    }
+
+    void Pause( CSound & rSound )
+    {
+        CSound * pSound = &rSound;
+        CScriptMgr::Instance().runOnMainThread( [pSound](){ pSound->pause(); } );
+    }
+
+    void Resume( CSound & rSound )
+    {
+        CSound * pSound = &rSound;
+        CScriptMgr::Instance().runOnMainThread( [pSound](){ pSound->resume(); } );
+    }
+
+    void SetVolume( int volume, CSound & rSound )
+    {
+        CSound * pSound = &rSound;
+        CScriptMgr::Instance().runOnMainThread( [volume, pSound](){ pSound->setVolume( volume ); } );
+    }
+
     /************************************************************************
     *    DESC:  Register the class with AngelScript
     ************************************************************************/
@@ -30,11 +64,11 @@ namespace NScriptSound
         // Register type
         Throw( pEngine->RegisterObjectType("CSound", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CSound", "void play( int channel = -1, int loopCount = 0 )", asMETHOD(CSound, play),      asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void stop()",                                      asMETHOD(CSound, stop),      asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void pause()",                                     asMETHOD(CSound, pause),     asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void resume()",                                    asMETHOD(CSound, resume),    asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void setVolume(int)",                              asMETHOD(CSound, setVolume), asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void play( int channel = -1, int loopCount = 0 )", asFUNCTION(Play),            asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void stop()",                                      asFUNCTION(Stop),            asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void pause()",                                     asFUNCTION(Pause),           asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void resume()",                                    asFUNCTION(Resume),          asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void setVolume(int)",                              asFUNCTION(SetVolume),       asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CSound", "int getVolume()",                                  asMETHOD(CSound, getVolume), asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CSound", "bool isPlaying()",                                 asMETHOD(CSound, isPlaying), asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CSound", "bool isPaused()",                                  asMETHOD(CSound, isPaused),  asCALL_THISCALL) );
@@ -20,13 +20,17 @@
 namespace NScriptSoundManager
 {
     /************************************************************************
-    *    DESC:  Load the data list table                                                            
+    *    DESC:  Load the data list table
+    *           The calls that change the sounds are queued to the sync
+    *           point when called from a parallel script
     ************************************************************************/
     void LoadListTable( const std::string & filePath, CSoundMgr & rSoundMgr )
     {
         try
         {
-            rSoundMgr.loadListTable( filePath );
+            CSoundMgr * pSoundMgr = &rSoundMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [filePath, pSoundMgr](){ pSoundMgr->loadListTable( filePath ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -45,7 +49,9 @@ namespace NScriptSoundManager
     {
         try
         {
-            rSoundMgr.loadGroup( group );
+            CSoundMgr * pSoundMgr = &rSoundMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pSoundMgr](){ pSoundMgr->loadGroup( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -64,7 +70,9 @@ namespace NScriptSoundManager
     {
         try
         {
-            rSoundMgr.freeGroup( group );
+            CSoundMgr * pSoundMgr = &rSoundMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [group, pSoundMgr](){ pSoundMgr->freeGroup( group ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -76,6 +84,44 @@ namespace NScriptSoundManager
         }
     }
     
+    /************************************************************************
+    *    DESC:  Play, pause, resume, stop and set the volume of the sound
+    ************************************************************************/
+    void Play( const std::string & group, const std::string & soundID, int loopCount, CSoundMgr & rSoundMgr )
+    {
+        CSoundMgr * pSoundMgr = &rSoundMgr;
+        CScriptMgr::Instance().runOnMainThread(
+            [group, soundID, loopCount, pSoundMgr](){ pSoundMgr->play( group, soundID, loopCount ); } );
+    }
+
+    void Pause( const std::string & group, const std::string & soundID, CSoundMgr & rSoundMgr )
+    {
+        CSoundMgr * pSoundMgr = &rSoundMgr;
+        CScriptMgr::Instance().runOnMainThread(
+            [group, soundID, pSoundMgr](){ pSoundMgr->pause( group, soundID ); } );
+    }
+
+    void Resume( const std::string & group, const std::string & soundID, CSoundMgr & rSoundMgr )
+    {
+        CSoundMgr * pSoundMgr = &rSoundMgr;
+        CScriptMgr::Instance().runOnMainThread(
+            [group, soundID, pSoundMgr](){ pSoundMgr->resume( group, soundID ); } );
+    }
+
+    void Stop( const std::string & group, const std::string & soundID, CSoundMgr & rSoundMgr )
+    {
+        CSoundMgr * pSoundMgr = &rSoundMgr;
+        CScriptMgr::Instance().runOnMainThread(
+            [group, soundID, pSoundMgr](){ pSoundMgr->stop( group, soundID ); } );
+    }
+
+    void SetVolume( const std::string & group, const std::string & soundID, int volume, CSoundMgr & rSoundMgr )
+    {
+        CSoundMgr * pSoundMgr = &rSoundMgr;
+        CScriptMgr::Instance().runOnMainThread(
+            [group, soundID, volume, pSoundMgr](){ pSoundMgr->setVolume( group, soundID, volume ); } );
+    }
+    
     /************************************************************************
     *    DESC:  Register global functions
     ************************************************************************/
@@ -92,11 +138,11 @@ namespace NScriptSoundManager
         Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void loadGroup(string &in)",                         asFUNCTION(LoadGroup),     asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void freeGroup(string &in)",                         asFUNCTION(FreeGroup),     asCALL_CDECL_OBJLAST) );
         
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void play(string &in, string &in, int loopCount=0)", asMETHOD(CSoundMgr, play),        asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void pause(string &in, string &in)",                 asMETHOD(CSoundMgr, pause),       asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void resume(string &in, string &in)",                asMETHOD(CSoundMgr, resume),      asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void stop(string &in, string &in)",                  asMETHOD(CSoundMgr, stop),        asCALL_THISCALL) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void setVolume(string &in, string &in, int)",        asMETHOD(CSoundMgr, setVolume),   asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void play(string &in, string &in, int loopCount=0)", asFUNCTION(Play),          asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void pause(string &in, string &in)",                 asFUNCTION(Pause),         asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void resume(string &in, string &in)",                asFUNCTION(Resume),        asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void stop(string &in, string &in)",                  asFUNCTION(Stop),          asCALL_CDECL_OBJLAST) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void setVolume(string &in, string &in, int)",        asFUNCTION(SetVolume),     asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CSoundMgr", "int getVolume(string &in, string &in)",              asMETHOD(CSoundMgr, getVolume),   asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CSoundMgr", "bool isPlaying(string &in, string &in)",             asMETHOD(CSoundMgr, isPlaying),   asCALL_THISCALL) );
         Throw( pEngine->RegisterObjectMethod("CSoundMgr", "bool isPaused(string &in, string &in)",              asMETHOD(CSoundMgr, isPaused),    asCALL_THISCALL) );
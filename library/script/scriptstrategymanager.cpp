@@ -32,6 +32,8 @@ namespace NScriptStrategyManager
         
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createBasicSpriteStrategy" );
+
             pStrategy = rStrategyMgr.addStrategy( strategyId, new CBasicSpriteStrategy );
         }
         catch( NExcept::CCriticalException & ex )
@@ -55,6 +57,8 @@ namespace NScriptStrategyManager
         
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createBasicStageStrategy" );
+
             pStrategy = rStrategyMgr.addStrategy( strategyId, new CBasicStageStrategy );
         }
         catch( NExcept::CCriticalException & ex )
@@ -78,6 +82,8 @@ namespace NScriptStrategyManager
         
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createMenuStrategy" );
+
             pStrategy = rStrategyMgr.addStrategy( strategyId, new CMenuStrategy );
         }
         catch( NExcept::CCriticalException & ex )
@@ -139,13 +145,16 @@ namespace NScriptStrategyManager
     }
 
     /************************************************************************
-    *    DESC:  Create a basic stage strategy                                                            
+    *    DESC:  Delete the strategy
+    *           Queued to the sync point when called from a parallel script
     ************************************************************************/
     void DeleteStrategy( const std::string & strategyId, CStrategyMgr & rStrategyMgr )
     {
         try
         {
-            rStrategyMgr.deleteStrategy( strategyId );
+            CStrategyMgr * pStrategyMgr = &rStrategyMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [strategyId, pStrategyMgr](){ pStrategyMgr->deleteStrategy( strategyId ); } );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -158,12 +167,36 @@ namespace NScriptStrategyManager
     }
 
     /************************************************************************
-    *    DESC:  Create a basic stage strategy                                                            
+    *    DESC:  Delete the sprite
+    *           Queued to the sync point when called from a parallel script
+    ************************************************************************/
+    void DeleteSprite( const std::string & strategyId, int spriteId, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            CStrategyMgr * pStrategyMgr = &rStrategyMgr;
+            CScriptMgr::Instance().runOnMainThread(
+                [strategyId, spriteId, pStrategyMgr](){ pStrategyMgr->deleteSprite( strategyId, spriteId ); } );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Create a sprite. Can't be called from a parallel script
     ************************************************************************/
     iSprite * CreateSprite1( const std::string & strategyId, const std::string & group, const std::string & name, CStrategyMgr & rStrategyMgr )
     {
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createSprite" );
+
             return rStrategyMgr.create( strategyId, group, name );
         }
         catch( NExcept::CCriticalException & ex )
@@ -182,6 +215,8 @@ namespace NScriptStrategyManager
     {
         try
         {
+            CScriptMgr::Instance().mainThreadOnly( "createSprite" );
+
             return rStrategyMgr.create( strategyId, name );
         }
         catch( NExcept::CCriticalException & ex )
@@ -214,7 +249,7 @@ namespace NScriptStrategyManager
         Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "iStrategy & getStrategy(string &in)",                  asFUNCTION(GetStrategy), asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "iStrategy & findStrategy(string &in)",                 asFUNCTION(FindStrategy), asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategy(string &in)",                            asFUNCTION(DeleteStrategy), asCALL_CDECL_OBJLAST) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteSprite(string &in, int)",                         asMETHOD(CStrategyMgr, deleteSprite),   asCALL_THISCALL) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteSprite(string &in, int)",                         asFUNCTION(DeleteSprite), asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "iSprite & createSprite(string &in, string &in, string &in)", asFUNCTION(CreateSprite1), asCALL_CDECL_OBJLAST) );
         Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "iSprite & createSprite(string &in, string &in)",             asFUNCTION(CreateSprite2), asCALL_CDECL_OBJLAST) );
 
@@ -0,0 +1,158 @@
+/************************************************************************
+*    FILE NAME:       aliastable.cpp
+*
+*    DESCRIPTION:     Walker/Vose alias table for O(1) weighted draws
+*                     Built with integer math so the draw probabilities
+*                     are exactly weight / total weight
+************************************************************************/
+
+// Physical component dependency
+#include <slot/aliastable.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+#include <utilities/randfunc.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <limits>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CAliasTable::CAliasTable() :
+    m_totalWeight(0),
+    m_singleDraw(true)
+{
+}
+
+CAliasTable::CAliasTable( const std::vector<int> & weightVec ) :
+    m_totalWeight(0),
+    m_singleDraw(true)
+{
+    init( weightVec );
+}
+
+
+/************************************************************************
+*    DESC:  Build the table from the weights
+*
+*           Each weight is scaled by the number of buckets so every
+*           bucket holds exactly the total weight. Buckets under the
+*           total are topped off by a bucket that's over.
+************************************************************************/
+void CAliasTable::init( const std::vector<int> & weightVec )
+{
+    const size_t count = weightVec.size();
+
+    uint64_t totalWeight(0);
+    for( int iter : weightVec )
+    {
+        if( iter < 0 )
+            throw NExcept::CCriticalException("Alias Table Error!",
+                boost::str( boost::format("Negative weight (%d).\n\n%s\nLine: %s")
+                    % iter % __FUNCTION__ % __LINE__ ));
+
+        totalWeight += iter;
+    }
+
+    if( totalWeight > std::numeric_limits<uint32_t>::max() )
+        throw NExcept::CCriticalException("Alias Table Error!",
+            boost::str( boost::format("Total weight is too large (%d).\n\n%s\nLine: %s")
+                % totalWeight % __FUNCTION__ % __LINE__ ));
+
+    m_totalWeight = totalWeight;
+    m_singleDraw = ((uint64_t(count) * m_totalWeight) <= std::numeric_limits<uint32_t>::max());
+
+    m_thresholdVec.assign( count, m_totalWeight );
+    m_aliasVec.resize( count );
+
+    std::vector<uint64_t> scaledVec( count );
+    std::vector<int> smallVec;
+    std::vector<int> largeVec;
+    smallVec.reserve( count );
+    largeVec.reserve( count );
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        m_aliasVec[i] = i;
+        scaledVec[i] = uint64_t(weightVec[i]) * count;
+
+        if( scaledVec[i] < m_totalWeight )
+            smallVec.push_back( i );
+        else
+            largeVec.push_back( i );
+    }
+
+    while( !smallVec.empty() && !largeVec.empty() )
+    {
+        const int small = smallVec.back();
+        const int large = largeVec.back();
+        smallVec.pop_back();
+
+        m_thresholdVec[small] = scaledVec[small];
+        m_aliasVec[small] = large;
+
+        // The large bucket gives up what it took to fill the small one
+        scaledVec[large] -= (m_totalWeight - scaledVec[small]);
+
+        if( scaledVec[large] < m_totalWeight )
+        {
+            largeVec.pop_back();
+            smallVec.push_back( large );
+        }
+    }
+
+    // The integer math balances out so whatever is left is exactly full
+}
+
+
+/************************************************************************
+*    DESC:  Draw a weighted index
+************************************************************************/
+int CAliasTable::draw( std::mt19937 & rRng ) const
+{
+    if( m_totalWeight == 0 )
+        return 0;
+
+    if( m_singleDraw )
+    {
+        const uint32_t value = NRandFunc::Bounded( rRng, m_thresholdVec.size() * m_totalWeight );
+
+        return getIndex( value / m_totalWeight, value % m_totalWeight );
+    }
+
+    const uint32_t bucket = NRandFunc::Bounded( rRng, m_thresholdVec.size() );
+
+    return getIndex( bucket, NRandFunc::Bounded( rRng, m_totalWeight ) );
+}
+
+
+/************************************************************************
+*    DESC:  Get the index from a bucket and a value in the range
+*           [0, total weight)
+************************************************************************/
+int CAliasTable::getIndex( uint32_t bucket, uint32_t value ) const
+{
+    return (value < m_thresholdVec[bucket]) ? bucket : m_aliasVec[bucket];
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of buckets
+************************************************************************/
+size_t CAliasTable::size() const
+{
+    return m_thresholdVec.size();
+}
+
+
+/************************************************************************
+*    DESC:  Get the total weight
+************************************************************************/
+uint32_t CAliasTable::getTotalWeight() const
+{
+    return m_totalWeight;
+}
@@ -0,0 +1,55 @@
+/************************************************************************
+*    FILE NAME:       aliastable.h
+*
+*    DESCRIPTION:     Walker/Vose alias table for O(1) weighted draws
+*                     Built with integer math so the draw probabilities
+*                     are exactly weight / total weight
+************************************************************************/
+
+#ifndef __alias_table_h__
+#define __alias_table_h__
+
+// Standard lib dependencies
+#include <vector>
+#include <random>
+#include <cstdint>
+
+class CAliasTable
+{
+public:
+
+    // Constructor
+    CAliasTable();
+    CAliasTable( const std::vector<int> & weightVec );
+
+    // Build the table from the weights
+    void init( const std::vector<int> & weightVec );
+
+    // Draw a weighted index
+    int draw( std::mt19937 & rRng ) const;
+
+    // Get the index from a bucket and a value in the range [0, total weight)
+    int getIndex( uint32_t bucket, uint32_t value ) const;
+
+    // Get the number of buckets
+    size_t size() const;
+
+    // Get the total weight
+    uint32_t getTotalWeight() const;
+
+private:
+
+    // Threshold of each bucket. Values below it select the bucket, the rest the alias
+    std::vector<uint32_t> m_thresholdVec;
+
+    // Index used when the value is past the threshold
+    std::vector<int> m_aliasVec;
+
+    // total weight
+    uint32_t m_totalWeight;
+
+    // The bucket and value are split out of one random number when the range fits
+    bool m_singleDraw;
+};
+
+#endif  // __alias_table_h__
@@ -127,7 +127,7 @@ void CAnimatedCycleResults::startAnimation()
         {
             auto symbol = rCycleResultSymb.at(iter.getReel()).at(iter.getPos());
             symbol->getSprite().getVisualComponent().setDefaultColor();
-            symbol->getSprite().prepareFuncId( "animate" );
+            symbol->getSprite().prepareFuncId( CScriptFuncTable::EFI_ANIMATE );
             symbol->setDeferredRender( true );
         }
 
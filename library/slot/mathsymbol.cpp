@@ -15,9 +15,14 @@
 *    DESC:  Constructor
 ************************************************************************/
 CMathSymbol::CMathSymbol(
-    const std::string & symbolID, const std::vector<std::string> & wildMatches ) :
+    const std::string & symbolID,
+    const std::vector<std::string> & wildMatches,
+    const int index,
+    const uint64_t matchMask ) :
         m_id( symbolID ),
-        m_wildMatches( wildMatches )
+        m_wildMatches( wildMatches ),
+        m_index( index ),
+        m_matchMask( matchMask )
 {
 }
 
@@ -31,6 +36,15 @@ const std::string & CMathSymbol::getID() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the interned symbol index
+************************************************************************/
+int CMathSymbol::getIndex() const
+{
+    return m_index;
+}
+
+
 /************************************************************************
 *    DESC:  Is this a wild symbol?
 ************************************************************************/
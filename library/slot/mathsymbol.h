@@ -11,17 +11,29 @@
 // Standard lib dependencies
 #include <string>
 #include <vector>
+#include <cstdint>
 
 class CMathSymbol
 {
 public:
 
     // Constructor
-    CMathSymbol( const std::string & symbolID, const std::vector<std::string> & wildMatches );
+    CMathSymbol(
+        const std::string & symbolID,
+        const std::vector<std::string> & wildMatches,
+        const int index = -1,
+        const uint64_t matchMask = 0 );
     
     // Get the string ID
     const std::string & getID() const;
     
+    // Get the interned symbol index
+    int getIndex() const;
+    
+    // Get the bitmask of the symbol indexes this symbol matches
+    uint64_t getMatchMask() const
+    { return m_matchMask; }
+    
     // Is this a wild symbol?
     bool isWild() const;
     
@@ -31,6 +43,10 @@ public:
     // Does symbol match?
     bool isMatch( const std::string & symbolID ) const;
     
+    // Does symbol match? Uses the interned index for evaluation
+    bool isMatch( const int symbolIndex ) const
+    { return ((m_matchMask >> symbolIndex) & 1) != 0; }
+    
     // Equality operator. The symbols are equal if their id's are
     bool operator == ( const CMathSymbol & mathSymbol ) const;
     bool operator == ( const std::string & symbolID ) const;
@@ -42,6 +58,12 @@ private:
     
     // ID's of other math symbols that this symbol is wild for
     const std::vector<std::string> m_wildMatches;
+    
+    // Interned symbol index
+    const int m_index;
+    
+    // Bit for this symbol's index and the index of every symbol it's wild for
+    const uint64_t m_matchMask;
 
 };
 
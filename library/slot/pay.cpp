@@ -20,17 +20,41 @@ CPay::CPay(
     const int bonusCode,
     const uint multiplier,
     const int payLine,
-    const std::vector<CSymbPos> & symbPos ) :
+    const std::vector<CSymbPos> & symbPos,
+    const CPayCombo * pPayCombo ) :
         m_payType(payType),
         m_award(award),
         m_bonusCode(bonusCode),
         m_multiplier(multiplier),
         m_payLine(payLine),
-        m_symbPosVec(symbPos)
+        m_symbPosVec(symbPos),
+        m_pPayCombo(pPayCombo)
 {
 }
 
 
+/************************************************************************
+*    DESC:  Reuse this pay. The symbol position vector keeps it's memory
+************************************************************************/
+void CPay::set(
+    const NSlotDefs::EPayType payType,
+    const uint award,
+    const int bonusCode,
+    const uint multiplier,
+    const int payLine,
+    const std::vector<CSymbPos> & symbPos,
+    const CPayCombo * pPayCombo )
+{
+    m_payType = payType;
+    m_award = award;
+    m_bonusCode = bonusCode;
+    m_multiplier = multiplier;
+    m_payLine = payLine;
+    m_symbPosVec.assign( symbPos.begin(), symbPos.end() );
+    m_pPayCombo = pPayCombo;
+}
+
+
 /************************************************************************
 *    DESC:  Get the pay type
 ************************************************************************/
@@ -94,6 +118,15 @@ const std::vector<CSymbPos> & CPay::getSymbPos() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the pay combo that was awarded
+************************************************************************/
+const CPayCombo * CPay::getPayCombo() const
+{
+    return m_pPayCombo;
+}
+
+
 /************************************************************************
 *    DESC:  Debug output
 ************************************************************************/
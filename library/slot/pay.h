@@ -16,6 +16,9 @@
 // Standard lib dependencies
 #include <vector>
 
+// Forward declaration(s)
+class CPayCombo;
+
 class CPay
 {
 public:
@@ -27,7 +30,18 @@ public:
         const int bonusCode,
         const uint multiplier,
         const int payLine,
-        const std::vector<CSymbPos> & symbPos );
+        const std::vector<CSymbPos> & symbPos,
+        const CPayCombo * pPayCombo = nullptr );
+    
+    // Reuse this pay. The symbol position vector keeps it's memory
+    void set(
+        const NSlotDefs::EPayType payType,
+        const uint award,
+        const int bonusCode,
+        const uint multiplier,
+        const int payLine,
+        const std::vector<CSymbPos> & symbPos,
+        const CPayCombo * pPayCombo = nullptr );
     
     // Get the pay type
     NSlotDefs::EPayType getPayType() const;
@@ -49,6 +63,9 @@ public:
     
     // Get the symbol positions
     const std::vector<CSymbPos> & getSymbPos() const;
+
+    // Get the pay combo that was awarded
+    const CPayCombo * getPayCombo() const;
     
     // Debug output
     void debug() const;
@@ -73,6 +90,9 @@ private:
     // Vector of symbol positions per reel that contribute to the win
     std::vector<CSymbPos> m_symbPosVec;
 
+    // Pay combo that was awarded
+    const CPayCombo * m_pPayCombo;
+
 };
 
 #endif  // __pay_h__
@@ -11,11 +11,12 @@
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
-CPayCombo::CPayCombo( const std::string & symb, const int count, const uint award, const int bonusCode ) :
+CPayCombo::CPayCombo( const std::string & symb, const int count, const uint award, const int bonusCode, const int symbIndex ) :
     m_symbol(symb),
     m_count(count),
     m_award(award),
-    m_bonusCode(bonusCode)
+    m_bonusCode(bonusCode),
+    m_symbIndex(symbIndex)
 {
 }
 
@@ -29,6 +30,15 @@ const std::string & CPayCombo::getSymbol() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the interned symbol index
+************************************************************************/
+int CPayCombo::getSymbolIndex() const
+{
+    return m_symbIndex;
+}
+
+
 /************************************************************************
 *    DESC:  Get the number of symbols involved in this pay
 ************************************************************************/
@@ -21,11 +21,14 @@ class CPayCombo
 public:
 
     // Constructor
-    CPayCombo( const std::string & symb, const int count, const uint award, const int bonusCode );
+    CPayCombo( const std::string & symb, const int count, const uint award, const int bonusCode, const int symbIndex = -1 );
     
     // Get the symbol ID
     const std::string & getSymbol() const;
     
+    // Get the interned symbol index
+    int getSymbolIndex() const;
+    
     // Get the number of symbols involved in this pay
     int getCount() const;
     
@@ -49,6 +52,9 @@ private:
     // Bonus code
     const int m_bonusCode;
     
+    // Interned symbol index
+    const int m_symbIndex;
+    
 };
 
 #endif  // __pay_combo_h__
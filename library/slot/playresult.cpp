@@ -11,11 +11,13 @@
 
 // Standard lib dependencies
 #include <algorithm>
+#include <stdexcept>
 
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CPlayResult::CPlayResult() :
+    m_payCount(0),
     m_totalWinAmount(0)
 {
 }
@@ -31,7 +33,13 @@ void CPlayResult::addPay(
     const int winLine,
     const std::vector<CSymbPos> & symbPos )
 {
-    m_payVec.emplace_back( payType, rCombo.getAward(), rCombo.getBonusCode(), multiplier, winLine, symbPos );
+    // Reuse a pay from a previous play so evaluation doesn't allocate
+    if( m_payCount < m_payVec.size() )
+        m_payVec[m_payCount].set( payType, rCombo.getAward(), rCombo.getBonusCode(), multiplier, winLine, symbPos, &rCombo );
+    else
+        m_payVec.emplace_back( payType, rCombo.getAward(), rCombo.getBonusCode(), multiplier, winLine, symbPos, &rCombo );
+
+    ++m_payCount;
 }
 
 
@@ -41,7 +49,7 @@ void CPlayResult::addPay(
 void CPlayResult::sortPays()
 {
     // Sort via lamda expression
-    std::sort(m_payVec.begin(), m_payVec.end(),
+    std::sort(m_payVec.begin(), m_payVec.begin() + m_payCount,
         [](const CPay & a, const CPay & b){ return (a.getBaseAward() >= b.getBaseAward()); });
 }
 
@@ -53,8 +61,8 @@ uint CPlayResult::addUpWin()
 {
     m_totalWinAmount = 0;
 
-    for( auto & iter : m_payVec )
-        m_totalWinAmount += iter.getFinalAward();
+    for( uint i = 0; i < m_payCount; ++i )
+        m_totalWinAmount += m_payVec[i].getFinalAward();
 
     return m_totalWinAmount;
 }
@@ -66,7 +74,7 @@ uint CPlayResult::addUpWin()
 void CPlayResult::clear()
 {
     m_totalWinAmount = 0;
-    m_payVec.clear();
+    m_payCount = 0;
 }
 
 
@@ -75,7 +83,10 @@ void CPlayResult::clear()
 ************************************************************************/
 const CPay & CPlayResult::getPay( int index ) const
 {
-    return m_payVec.at( index );
+    if( (index < 0) || (static_cast<uint>(index) >= m_payCount) )
+        throw std::out_of_range( "CPlayResult::getPay index out of range" );
+
+    return m_payVec[index];
 }
 
 
@@ -84,5 +95,5 @@ const CPay & CPlayResult::getPay( int index ) const
 ************************************************************************/
 uint CPlayResult::getPayCount() const
 {
-    return m_payVec.size();
+    return m_payCount;
 }
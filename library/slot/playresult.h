@@ -49,9 +49,12 @@ public:
     
 private:
     
-    // Vector of pays
+    // Vector of pays. Pays past the count are kept to be reused
     std::vector<CPay> m_payVec;
 
+    // Number of pays in use
+    uint m_payCount;
+
     // Total win amount
     uint m_totalWinAmount;
 };
@@ -28,6 +28,7 @@
 #include <utilities/matrix.h>
 #include <common/sound.h>
 #include <managers/soundmanager.h>
+#include <system/renderdevice.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -489,30 +490,30 @@ void CReelStripView::render( const CMatrix & matrix )
         iter.render( matrix );
 
     // Disable rendering to the color buffer
-    glColorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
-    glDepthMask( GL_FALSE );
+    CRenderDevice::Instance().colorMask( false, false, false, false );
+    CRenderDevice::Instance().depthMask( false );
 
     // Start using the stencil
-    glEnable( GL_STENCIL_TEST );
+    CRenderDevice::Instance().enable( GL_STENCIL_TEST );
 
-    glStencilFunc( GL_ALWAYS, 0x1, 0x1 );
-    glStencilOp( GL_REPLACE, GL_REPLACE, GL_REPLACE );
+    CRenderDevice::Instance().stencilFunc( GL_ALWAYS, 0x1, 0x1 );
+    CRenderDevice::Instance().stencilOp( GL_REPLACE, GL_REPLACE, GL_REPLACE );
 
 
     m_upStencilMaskSprite->render( matrix );
 
 
     // Re-enable color
-    glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+    CRenderDevice::Instance().colorMask( true, true, true, true );
 
     // Where a 1 was not rendered
-    glStencilFunc( GL_EQUAL, 0x1, 0x1 );
+    CRenderDevice::Instance().stencilFunc( GL_EQUAL, 0x1, 0x1 );
 
     // Keep the pixel
-    glStencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
+    CRenderDevice::Instance().stencilOp( GL_KEEP, GL_KEEP, GL_KEEP );
 
     // Disable any writing to the stencil buffer
-    glDepthMask(GL_TRUE);
+    CRenderDevice::Instance().depthMask( true );
 
 
     for( size_t i = 0; i < m_symbolDeq.size(); ++i )
@@ -529,7 +530,7 @@ void CReelStripView::render( const CMatrix & matrix )
 
 
     // Finished using stencil
-    glDisable( GL_STENCIL_TEST );
+    CRenderDevice::Instance().disable( GL_STENCIL_TEST );
 }
 
 
@@ -0,0 +1,546 @@
+
+/************************************************************************
+*    FILE NAME:       slotcycleevaluator.cpp
+*
+*    DESCRIPTION:     Exhaustive full cycle evaluation of the slot math
+*                     Every stop combination of a strip set is evaluated
+*                     with the same line and scatter rules as the slot
+*                     group model, weighted by the strip stop weights.
+*                     The strips are walked one at a time and the partial
+*                     payline matches are memoized so identical prefixes
+*                     are only evaluated once.
+************************************************************************/
+
+// Physical component dependency
+#include <slot/slotcycleevaluator.h>
+
+// Game lib dependencies
+#include <slot/slotmath.h>
+#include <slot/paylineset.h>
+#include <slot/paycombo.h>
+#include <slot/paytableset.h>
+#include <slot/stripset.h>
+#include <slot/stripstop.h>
+#include <slot/mathsymbol.h>
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <map>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSlotCycleEvaluator::CSlotCycleEvaluator(
+    const CSlotMath & rSlotMath,
+    const CPaylineSet & rPaylineSet,
+    const std::string & stripSetId,
+    const std::string & paytableSetId ) :
+        m_rSlotMath( rSlotMath ),
+        m_rPaylineSet( rPaylineSet ),
+        m_lineBet(1),
+        m_totalBet(1),
+        m_stateCount(0)
+{
+    compile( stripSetId, paytableSetId );
+}
+
+
+/************************************************************************
+*    DESC:  Compile the paytables, paylines and strip windows
+************************************************************************/
+void CSlotCycleEvaluator::compile( const std::string & stripSetId, const std::string & paytableSetId )
+{
+    const auto & rStripSetVec = m_rSlotMath.getStripSet( stripSetId );
+    const auto & rLineDataVecVec = m_rPaylineSet.getLineData();
+    const size_t stripCount = rStripSetVec.size();
+
+    // Compile the paytables in paytable set order
+    std::vector<std::vector<int>> scatterSymbVecVec;
+    for( auto & iter : m_rSlotMath.getPaytableSet( paytableSetId ) )
+    {
+        const auto & rPayComboVec = m_rSlotMath.getPayComboSet( iter.getId() );
+
+        if( iter.getType() == NSlotDefs::EP_PAYLINE )
+        {
+            m_linePaytableVec.emplace_back();
+            CLinePaytable & rPaytable = m_linePaytableVec.back();
+            rPaytable.m_endComboVecVec.resize( stripCount );
+
+            for( auto & cboIter : rPayComboVec )
+            {
+                const int combo = rPaytable.m_comboVec.size();
+                rPaytable.m_comboVec.push_back(
+                    { cboIter.getSymbolIndex(), cboIter.getCount(), cboIter.getAward(), static_cast<int>(m_payComboVec.size()) } );
+
+                // Combos longer than the strip set can never be matched by the model
+                if( (cboIter.getCount() > 0) && (cboIter.getCount() <= static_cast<int>(stripCount)) )
+                    rPaytable.m_endComboVecVec[cboIter.getCount() - 1].push_back( combo );
+
+                m_payComboVec.push_back( &cboIter );
+            }
+
+            // Once a payline has a best combo, only the symbols of the earlier
+            // combos that are still to be finished can change the outcome
+            const size_t comboCount = rPaytable.m_comboVec.size();
+            rPaytable.m_relevantMaskVecVec.assign( stripCount + 1, std::vector<uint64_t>( comboCount + 1, 0 ) );
+            for( size_t depth = 0; depth <= stripCount; ++depth )
+            {
+                for( size_t best = 1; best <= comboCount; ++best )
+                {
+                    const CLineCombo & rCombo = rPaytable.m_comboVec[best - 1];
+                    uint64_t mask = rPaytable.m_relevantMaskVecVec[depth][best - 1];
+
+                    if( (rCombo.m_count > static_cast<int>(depth)) && (rCombo.m_count <= static_cast<int>(stripCount)) )
+                        mask |= uint64_t(1) << rCombo.m_symbIndex;
+
+                    rPaytable.m_relevantMaskVecVec[depth][best] = mask;
+                }
+            }
+
+            for( size_t payline = 0; payline < rLineDataVecVec.size(); ++payline )
+            {
+                m_unitPaytableVec.push_back( m_linePaytableVec.size() - 1 );
+                m_unitPaylineVec.push_back( payline );
+            }
+        }
+        else if( iter.getType() == NSlotDefs::EP_SCATTER )
+        {
+            // Each unique symbol of the scatter paytable gets a slot to count it's positions
+            std::vector<int> slotSymbVec;
+            const int firstSlot = m_scatterCapVec.size();
+
+            for( auto & cboIter : rPayComboVec )
+            {
+                auto symbIter = std::find( slotSymbVec.begin(), slotSymbVec.end(), cboIter.getSymbolIndex() );
+                const int slot = firstSlot + (symbIter - slotSymbVec.begin());
+
+                if( symbIter == slotSymbVec.end() )
+                {
+                    slotSymbVec.push_back( cboIter.getSymbolIndex() );
+                    m_scatterCapVec.push_back( 0 );
+                }
+
+                if( (cboIter.getCount() < 0) || (cboIter.getCount() >= 255) )
+                {
+                    throw NExcept::CCriticalException("Slot Cycle Evaluator Error!",
+                        boost::str( boost::format("Scatter count out of range (%s - %d).\n\n%s\nLine: %s")
+                            % cboIter.getSymbol() % cboIter.getCount() % __FUNCTION__ % __LINE__ ));
+                }
+
+                // Any count past the largest one pays nothing so they can all be counted as one
+                m_scatterCapVec[slot] = std::max<int>( m_scatterCapVec[slot], cboIter.getCount() + 1 );
+
+                m_scatterComboVec.push_back(
+                    { slot, cboIter.getCount(), cboIter.getAward(), static_cast<int>(m_payComboVec.size()) } );
+
+                m_payComboVec.push_back( &cboIter );
+            }
+
+            scatterSymbVecVec.push_back( slotSymbVec );
+        }
+    }
+
+    // Flatten the scatter slot symbols
+    std::vector<int> slotSymbVec;
+    for( auto & iter : scatterSymbVecVec )
+        slotSymbVec.insert( slotSymbVec.end(), iter.begin(), iter.end() );
+
+    // Transpose the paylines to look up the row on each strip
+    m_paylineRowVecVec.assign( stripCount, std::vector<int8_t>( rLineDataVecVec.size() ) );
+    for( size_t payline = 0; payline < rLineDataVecVec.size(); ++payline )
+    {
+        if( rLineDataVecVec[payline].size() < stripCount )
+        {
+            throw NExcept::CCriticalException("Slot Cycle Evaluator Error!",
+                boost::str( boost::format("Payline shorter than the strip set (%s - %d).\n\n%s\nLine: %s")
+                    % stripSetId % payline % __FUNCTION__ % __LINE__ ));
+        }
+
+        for( size_t strip = 0; strip < stripCount; ++strip )
+            m_paylineRowVecVec[strip][payline] = rLineDataVecVec[payline][strip];
+    }
+
+    // Group the stops of each strip that show the same evaluation symbols
+    m_windowVecVec.resize( stripCount );
+    for( size_t strip = 0; strip < stripCount; ++strip )
+    {
+        const auto & rStripVec = m_rSlotMath.getStrip( rStripSetVec[strip].getId() );
+        const auto & rEvalIndexVec = rStripSetVec[strip].getEvalIndexVec();
+        const int stripSize = rStripVec.size();
+
+        std::map<std::vector<uint64_t>, size_t> windowIndexMap;
+
+        for( int stop = 0; stop < stripSize; ++stop )
+        {
+            if( rStripVec[stop].getWeight() <= 0 )
+                continue;
+
+            std::vector<uint64_t> maskVec;
+            maskVec.reserve( rEvalIndexVec.size() );
+
+            for( auto evalIndex : rEvalIndexVec )
+            {
+                int index = (stop + evalIndex) % stripSize;
+                if( index < 0 )
+                    index += stripSize;
+
+                maskVec.push_back( rStripVec[index].getMathSymbol().getMatchMask() );
+            }
+
+            auto mapIter = windowIndexMap.find( maskVec );
+            if( mapIter == windowIndexMap.end() )
+            {
+                mapIter = windowIndexMap.emplace( maskVec, m_windowVecVec[strip].size() ).first;
+
+                m_windowVecVec[strip].emplace_back();
+                CWindow & rWindow = m_windowVecVec[strip].back();
+                rWindow.m_maskVec = maskVec;
+                rWindow.m_scatterCountVec.resize( slotSymbVec.size() );
+
+                // Count the scatter symbols on the allowed positions
+                for( size_t slot = 0; slot < slotSymbVec.size(); ++slot )
+                    for( size_t pos = 0; pos < maskVec.size(); ++pos )
+                        if( m_rPaylineSet.indexOfScaterData( strip, pos ) && ((maskVec[pos] >> slotSymbVec[slot]) & 1) )
+                            ++rWindow.m_scatterCountVec[slot];
+            }
+
+            m_windowVecVec[strip][mapIter->second].m_weight += rStripVec[stop].getWeight();
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Evaluate the full cycle
+*           The windows of the first strip are handed out to the threads.
+*           Each thread keeps it's own memo so no locking is needed
+************************************************************************/
+void CSlotCycleEvaluator::evaluate( const uint lineBet, const uint totalBet, uint threads )
+{
+    m_lineBet = lineBet;
+    m_totalBet = totalBet;
+    m_stateCount = 0;
+
+    m_result = CResult();
+    m_result.m_comboHitVec.resize( m_payComboVec.size() );
+
+    if( m_windowVecVec.empty() )
+        return;
+
+    // Every payline of every line paytable starts out able to match anything in the paytable
+    CState root;
+    root.m_scatterCountVec.resize( m_scatterCapVec.size() );
+    for( size_t unit = 0; unit < m_unitPaytableVec.size(); ++unit )
+    {
+        const CLinePaytable & rPaytable = m_linePaytableVec[m_unitPaytableVec[unit]];
+        const uint32_t best = rPaytable.m_comboVec.size();
+        const uint64_t mask = rPaytable.m_relevantMaskVecVec[0][best];
+
+        if( mask != 0 )
+            root.m_lineVec.push_back( { static_cast<uint32_t>(unit), best, mask } );
+    }
+
+    if( threads == 0 )
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    const auto & rRootWindowVec = m_windowVecVec.front();
+    threads = std::min<uint>( threads, rRootWindowVec.size() );
+
+    std::vector<CResult> resultVec( threads );
+    std::vector<size_t> stateCountVec( threads );
+    std::atomic<size_t> nextWindow(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto worker =
+        [&]( const uint thread )
+        {
+            try
+            {
+                memo_vec memoVec( m_windowVecVec.size() + 1 );
+                CResult & rResult = resultVec[thread];
+                rResult.m_comboHitVec.resize( m_payComboVec.size() );
+
+                for( size_t window = nextWindow++; window < rRootWindowVec.size(); window = nextWindow++ )
+                    addWindow( 0, root, rRootWindowVec[window], memoVec, rResult );
+
+                for( auto & iter : memoVec )
+                    stateCountVec[thread] += iter.size();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock( exceptionMutex );
+                if( !exception )
+                    exception = std::current_exception();
+            }
+        };
+
+    std::vector<std::thread> threadVec;
+    for( uint i = 1; i < threads; ++i )
+        threadVec.emplace_back( worker, i );
+
+    // The calling thread does it's share
+    worker( 0 );
+
+    for( auto & iter : threadVec )
+        iter.join();
+
+    if( exception )
+        std::rethrow_exception( exception );
+
+    for( size_t i = 0; i < resultVec.size(); ++i )
+    {
+        merge( m_result, resultVec[i] );
+        m_stateCount += stateCountVec[i];
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Evaluate the combinations that follow a state
+************************************************************************/
+const CSlotCycleEvaluator::CResult & CSlotCycleEvaluator::solve(
+    const size_t depth, const CState & state, memo_vec & rMemoVec )
+{
+    // Build the memo key from the paylines still being matched and the scatter counts
+    std::vector<uint64_t> key;
+    key.reserve( (state.m_lineVec.size() * 2) + (state.m_scatterCountVec.size() / 8) + 1 );
+
+    for( auto & iter : state.m_lineVec )
+    {
+        key.push_back( (uint64_t(iter.m_unit) << 32) | iter.m_best );
+        key.push_back( iter.m_mask );
+    }
+
+    for( size_t i = 0; i < state.m_scatterCountVec.size(); i += 8 )
+    {
+        uint64_t packed = 0;
+        for( size_t j = i; (j < i + 8) && (j < state.m_scatterCountVec.size()); ++j )
+            packed |= uint64_t(state.m_scatterCountVec[j]) << ((j - i) * 8);
+
+        key.push_back( packed );
+    }
+
+    memo_map & rMemo = rMemoVec[depth];
+
+    auto iter = rMemo.find( key );
+    if( iter != rMemo.end() )
+        return iter->second;
+
+    CResult result;
+    result.m_comboHitVec.resize( m_payComboVec.size() );
+
+    if( depth == m_windowVecVec.size() )
+        solveLeaf( state, result );
+    else
+        for( auto & windowIter : m_windowVecVec[depth] )
+            addWindow( depth, state, windowIter, rMemoVec, result );
+
+    return rMemo.emplace( std::move(key), std::move(result) ).first->second;
+}
+
+
+/************************************************************************
+*    DESC:  Add a window of the strip at this depth to the result
+*           Paylines that can no longer change are paid out here and
+*           dropped from the state handed to the next strip
+************************************************************************/
+void CSlotCycleEvaluator::addWindow(
+    const size_t depth,
+    const CState & state,
+    const CWindow & rWindow,
+    memo_vec & rMemoVec,
+    CResult & rResult )
+{
+    CState child;
+    child.m_lineVec.reserve( state.m_lineVec.size() );
+    child.m_scatterCountVec.resize( state.m_scatterCountVec.size() );
+
+    std::vector<int> decidedVec;
+    uint64_t decidedWin = 0;
+
+    for( auto & iter : state.m_lineVec )
+    {
+        const CLinePaytable & rPaytable = m_linePaytableVec[m_unitPaytableVec[iter.m_unit]];
+        const int row = m_paylineRowVecVec[depth][m_unitPaylineVec[iter.m_unit]];
+
+        uint64_t mask = iter.m_mask & rWindow.m_maskVec.at(row);
+        uint32_t best = iter.m_best;
+
+        // The first combo in paytable order that ends on this strip is the one the model awards
+        for( auto combo : rPaytable.m_endComboVecVec[depth] )
+        {
+            if( combo >= static_cast<int>(best) )
+                break;
+
+            if( (mask >> rPaytable.m_comboVec[combo].m_symbIndex) & 1 )
+            {
+                best = combo;
+                break;
+            }
+        }
+
+        mask &= rPaytable.m_relevantMaskVecVec[depth + 1][best];
+
+        if( mask != 0 )
+            child.m_lineVec.push_back( { iter.m_unit, best, mask } );
+
+        else if( best < rPaytable.m_comboVec.size() )
+        {
+            decidedWin += rPaytable.m_comboVec[best].m_award * m_lineBet;
+            decidedVec.push_back( rPaytable.m_comboVec[best].m_comboIndex );
+        }
+    }
+
+    for( size_t slot = 0; slot < state.m_scatterCountVec.size(); ++slot )
+        child.m_scatterCountVec[slot] =
+            std::min<int>( state.m_scatterCountVec[slot] + rWindow.m_scatterCountVec[slot], m_scatterCapVec[slot] );
+
+    const CResult & rChild = solve( depth + 1, child, rMemoVec );
+    const cycle_t weight = rWindow.m_weight;
+    const cycle_t win = decidedWin;
+
+    // The decided win is added to every combination that follows
+    rResult.m_weight += weight * rChild.m_weight;
+    rResult.m_win += weight * ((win * rChild.m_weight) + rChild.m_win);
+    rResult.m_winSquared += weight * ((win * win * rChild.m_weight) + (2 * win * rChild.m_win) + rChild.m_winSquared);
+    rResult.m_hits += weight * ((decidedWin > 0) ? rChild.m_weight : rChild.m_hits);
+    rResult.m_maxWin = std::max( rResult.m_maxWin, decidedWin + rChild.m_maxWin );
+
+    for( size_t i = 0; i < rChild.m_comboHitVec.size(); ++i )
+        if( rChild.m_comboHitVec[i] != 0 )
+            rResult.m_comboHitVec[i] += weight * rChild.m_comboHitVec[i];
+
+    for( auto iter : decidedVec )
+        rResult.m_comboHitVec[iter] += weight * rChild.m_weight;
+}
+
+
+/************************************************************************
+*    DESC:  Evaluate the scatters of a finished state
+************************************************************************/
+void CSlotCycleEvaluator::solveLeaf( const CState & state, CResult & rResult ) const
+{
+    uint64_t win = 0;
+
+    for( auto & iter : m_scatterComboVec )
+    {
+        if( state.m_scatterCountVec[iter.m_slot] == iter.m_count )
+        {
+            win += iter.m_award * m_totalBet;
+            rResult.m_comboHitVec[iter.m_comboIndex] = 1;
+        }
+    }
+
+    rResult.m_weight = 1;
+    rResult.m_win = win;
+    rResult.m_winSquared = cycle_t(win) * win;
+    rResult.m_hits = (win > 0) ? 1 : 0;
+    rResult.m_maxWin = win;
+}
+
+
+/************************************************************************
+*    DESC:  Add one result to another
+************************************************************************/
+void CSlotCycleEvaluator::merge( CResult & rDest, const CResult & source ) const
+{
+    rDest.m_weight += source.m_weight;
+    rDest.m_win += source.m_win;
+    rDest.m_winSquared += source.m_winSquared;
+    rDest.m_hits += source.m_hits;
+    rDest.m_maxWin = std::max( rDest.m_maxWin, source.m_maxWin );
+
+    for( size_t i = 0; i < source.m_comboHitVec.size(); ++i )
+        rDest.m_comboHitVec[i] += source.m_comboHitVec[i];
+}
+
+
+/************************************************************************
+*    DESC:  Hash of the memo key
+************************************************************************/
+size_t CSlotCycleEvaluator::CKeyHash::operator()( const std::vector<uint64_t> & key ) const
+{
+    return boost::hash_range( key.begin(), key.end() );
+}
+
+
+/************************************************************************
+*    DESC:  Get the cycle size
+************************************************************************/
+const CSlotCycleEvaluator::cycle_t & CSlotCycleEvaluator::getCycle() const
+{
+    return m_result.m_weight;
+}
+
+
+/************************************************************************
+*    DESC:  Get the weighted sum of the wins
+************************************************************************/
+const CSlotCycleEvaluator::cycle_t & CSlotCycleEvaluator::getTotalWin() const
+{
+    return m_result.m_win;
+}
+
+
+/************************************************************************
+*    DESC:  Get the weighted sum of the squared wins
+************************************************************************/
+const CSlotCycleEvaluator::cycle_t & CSlotCycleEvaluator::getTotalWinSquared() const
+{
+    return m_result.m_winSquared;
+}
+
+
+/************************************************************************
+*    DESC:  Get the weight of the combinations that win
+************************************************************************/
+const CSlotCycleEvaluator::cycle_t & CSlotCycleEvaluator::getHits() const
+{
+    return m_result.m_hits;
+}
+
+
+/************************************************************************
+*    DESC:  Get the largest win of the cycle
+************************************************************************/
+uint64_t CSlotCycleEvaluator::getMaxWin() const
+{
+    return m_result.m_maxWin;
+}
+
+
+/************************************************************************
+*    DESC:  Get the pay combos in paytable set order
+************************************************************************/
+const std::vector<const CPayCombo *> & CSlotCycleEvaluator::getPayComboVec() const
+{
+    return m_payComboVec;
+}
+
+
+/************************************************************************
+*    DESC:  Get the weighted hits of each pay combo
+************************************************************************/
+const std::vector<CSlotCycleEvaluator::cycle_t> & CSlotCycleEvaluator::getComboHitVec() const
+{
+    return m_result.m_comboHitVec;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of memoized partial states
+************************************************************************/
+size_t CSlotCycleEvaluator::getStateCount() const
+{
+    return m_stateCount;
+}
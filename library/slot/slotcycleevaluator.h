@@ -0,0 +1,226 @@
+
+/************************************************************************
+*    FILE NAME:       slotcycleevaluator.h
+*
+*    DESCRIPTION:     Exhaustive full cycle evaluation of the slot math
+*                     Every stop combination of a strip set is evaluated
+*                     with the same line and scatter rules as the slot
+*                     group model, weighted by the strip stop weights.
+*                     The strips are walked one at a time and the partial
+*                     payline matches are memoized so identical prefixes
+*                     are only evaluated once.
+************************************************************************/
+
+#ifndef __slot_cycle_evaluator_h__
+#define __slot_cycle_evaluator_h__
+
+// Game lib dependencies
+#include <slot/slotdefs.h>
+
+// Boost lib dependencies
+#include <boost/multiprecision/cpp_int.hpp>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Forward declaration(s)
+class CSlotMath;
+class CPaylineSet;
+class CPayCombo;
+
+class CSlotCycleEvaluator
+{
+public:
+
+    // Exact integer type used for the cycle sums. Throws on overflow
+    typedef boost::multiprecision::checked_uint256_t cycle_t;
+
+    // Constructor
+    CSlotCycleEvaluator(
+        const CSlotMath & rSlotMath,
+        const CPaylineSet & rPaylineSet,
+        const std::string & stripSetId,
+        const std::string & paytableSetId );
+
+    // Evaluate the full cycle
+    void evaluate( const uint lineBet, const uint totalBet, uint threads = 0 );
+
+    // Get the cycle size. The sum of the weights of every stop combination
+    const cycle_t & getCycle() const;
+
+    // Get the weighted sum of the wins
+    const cycle_t & getTotalWin() const;
+
+    // Get the weighted sum of the squared wins
+    const cycle_t & getTotalWinSquared() const;
+
+    // Get the weight of the combinations that win
+    const cycle_t & getHits() const;
+
+    // Get the largest win of the cycle
+    uint64_t getMaxWin() const;
+
+    // Get the pay combos in paytable set order
+    const std::vector<const CPayCombo *> & getPayComboVec() const;
+
+    // Get the weighted hits of each pay combo
+    const std::vector<cycle_t> & getComboHitVec() const;
+
+    // Get the number of memoized partial states
+    size_t getStateCount() const;
+
+private:
+
+    // Sums over every combination that follows a partial state
+    class CResult
+    {
+    public:
+
+        cycle_t m_weight;
+        cycle_t m_win;
+        cycle_t m_winSquared;
+        cycle_t m_hits;
+        uint64_t m_maxWin = 0;
+        std::vector<cycle_t> m_comboHitVec;
+    };
+
+    // Distinct evaluation window of a strip with the summed weight of the stops that show it
+    class CWindow
+    {
+    public:
+
+        uint64_t m_weight = 0;
+        std::vector<uint64_t> m_maskVec;
+        std::vector<uint8_t> m_scatterCountVec;
+    };
+
+    // Line pay compiled for the walk
+    class CLineCombo
+    {
+    public:
+
+        int m_symbIndex;
+        int m_count;
+        uint64_t m_award;
+        int m_comboIndex;
+    };
+
+    // Line paytable compiled for the walk
+    class CLinePaytable
+    {
+    public:
+
+        std::vector<CLineCombo> m_comboVec;
+
+        // Combos that end on each strip in paytable order
+        std::vector<std::vector<int>> m_endComboVecVec;
+
+        // Symbols still worth tracking after a strip for each best combo so far
+        std::vector<std::vector<uint64_t>> m_relevantMaskVecVec;
+    };
+
+    // Scatter pay compiled for the walk
+    class CScatterCombo
+    {
+    public:
+
+        int m_slot;
+        int m_count;
+        uint64_t m_award;
+        int m_comboIndex;
+    };
+
+    // Payline of a line paytable still being matched
+    class CLineState
+    {
+    public:
+
+        uint32_t m_unit;
+        uint32_t m_best;
+        uint64_t m_mask;
+    };
+
+    // Partial evaluation after a number of strips
+    class CState
+    {
+    public:
+
+        std::vector<CLineState> m_lineVec;
+        std::vector<uint8_t> m_scatterCountVec;
+    };
+
+    // Hash of the memo key
+    class CKeyHash
+    {
+    public:
+        size_t operator()( const std::vector<uint64_t> & key ) const;
+    };
+
+    typedef std::unordered_map<std::vector<uint64_t>, CResult, CKeyHash> memo_map;
+
+    // Memo of each strip depth. One per thread
+    typedef std::vector<memo_map> memo_vec;
+
+    // Compile the paytables, paylines and strip windows
+    void compile( const std::string & stripSetId, const std::string & paytableSetId );
+
+    // Evaluate the combinations that follow a state
+    const CResult & solve( const size_t depth, const CState & state, memo_vec & rMemoVec );
+
+    // Add a window of the strip at this depth to the result
+    void addWindow(
+        const size_t depth,
+        const CState & state,
+        const CWindow & rWindow,
+        memo_vec & rMemoVec,
+        CResult & rResult );
+
+    // Evaluate the scatters of a finished state
+    void solveLeaf( const CState & state, CResult & rResult ) const;
+
+    // Add one result to another
+    void merge( CResult & rDest, const CResult & source ) const;
+
+private:
+
+    // Slot math
+    const CSlotMath & m_rSlotMath;
+
+    // Payline set
+    const CPaylineSet & m_rPaylineSet;
+
+    // Line and scatter paytables
+    std::vector<CLinePaytable> m_linePaytableVec;
+    std::vector<CScatterCombo> m_scatterComboVec;
+
+    // Count a scatter slot is capped at. Past the largest count nothing pays
+    std::vector<uint8_t> m_scatterCapVec;
+
+    // Line paytable and payline of each line unit
+    std::vector<int> m_unitPaytableVec;
+    std::vector<int> m_unitPaylineVec;
+
+    // Evaluation symbol index of each payline on each strip
+    std::vector<std::vector<int8_t>> m_paylineRowVecVec;
+
+    // Distinct windows of each strip
+    std::vector<std::vector<CWindow>> m_windowVecVec;
+
+    // All the pay combos in paytable set order
+    std::vector<const CPayCombo *> m_payComboVec;
+
+    // Bets the line and scatter awards are multiplied by
+    uint m_lineBet;
+    uint m_totalBet;
+
+    // The result of the full cycle
+    CResult m_result;
+
+    // Number of memoized states
+    size_t m_stateCount;
+};
+
+#endif  // __slot_cycle_evaluator_h__
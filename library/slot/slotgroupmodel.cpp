@@ -17,12 +17,13 @@
 #include <slot/paylineset.h>
 #include <utilities/xmlParser.h>
 #include <utilities/exceptionhandling.h>
+#include <system/replay.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
 // Standard lib dependencies
-#include <chrono>
+#include <algorithm>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -32,10 +33,8 @@ CSlotGroupModel::CSlotGroupModel( const CSlotMath & rSlotMath, CPlayResult & rPl
     m_rPlayResult( rPlayResult ),
     m_rPaylineSet( CSlotMathMgr::Instance().getPaylineSet( rSlotMath.getPaylineSetID() ) )
 {
-    // Seed the random number generator
-    auto time = std::chrono::high_resolution_clock::now().time_since_epoch();
-    auto seed = std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
-    m_rng.seed( seed );
+    // Seed the random number generator. Recorded so a replay spins the same
+    m_rng.seed( CReplay::Instance().getSeed() );
 
 }
 
@@ -67,6 +66,91 @@ void CSlotGroupModel::create(
     m_evalMathSymbs.resize( rStripSetVec.size() );
     for( size_t i = 0; i < rStripSetVec.size(); ++i )
         m_evalMathSymbs.at(i).resize( rStripSetVec.at(i).getEvalIndexVec().size() );
+
+    compileEvaluation();
+}
+
+
+/************************************************************************
+*    DESC:  Compile the paytables and paylines into integer arrays
+*           so the evaluation doesn't do string compares or allocate
+************************************************************************/
+void CSlotGroupModel::compileEvaluation()
+{
+    // Lay out the evaluation symbols of all the strips back to back
+    m_evalOffsetVec.clear();
+    m_evalMaskVec.clear();
+    for( auto & iter : m_evalMathSymbs )
+    {
+        m_evalOffsetVec.push_back( m_evalMaskVec.size() );
+        m_evalMaskVec.resize( m_evalMaskVec.size() + iter.size() );
+    }
+
+    // Convert the payline offsets to match mask indexes
+    const auto & rPaylineSetVecVec = m_rPaylineSet.getLineData();
+    m_paylineIndexVecVec.resize( rPaylineSetVecVec.size() );
+    for( size_t payline = 0; payline < rPaylineSetVecVec.size(); ++payline )
+    {
+        m_paylineIndexVecVec[payline].clear();
+
+        for( size_t strip = 0; strip < rPaylineSetVecVec[payline].size(); ++strip )
+            m_paylineIndexVecVec[payline].push_back( m_evalOffsetVec.at(strip) + rPaylineSetVecVec[payline][strip] );
+    }
+
+    // Record the evaluation symbols allowed to scatter in strip order
+    m_scatterPosVec.clear();
+    m_scatterIndexVec.clear();
+    for( size_t strip = 0; strip < m_evalMathSymbs.size(); ++strip )
+    {
+        for( size_t pos = 0; pos < m_evalMathSymbs[strip].size(); ++pos )
+        {
+            if( m_rPaylineSet.indexOfScaterData( strip, pos ) )
+            {
+                m_scatterPosVec.emplace_back( strip, pos );
+                m_scatterIndexVec.push_back( m_evalOffsetVec[strip] + pos );
+            }
+        }
+    }
+
+    // Compile the paytables
+    size_t maxScatterSymbs = 0;
+    m_evalPaytableVec.clear();
+    for( auto & iter : m_rSlotMath.getPaytableSet( m_paytableSetId ) )
+    {
+        if( (iter.getType() != NSlotDefs::EP_PAYLINE) && (iter.getType() != NSlotDefs::EP_SCATTER) )
+            continue;
+
+        m_evalPaytableVec.emplace_back();
+        CEvalPaytable & rPaytable = m_evalPaytableVec.back();
+
+        rPaytable.m_type = iter.getType();
+        rPaytable.m_pPayComboVec = &m_rSlotMath.getPayComboSet( iter.getId() );
+
+        for( auto & cboIter : *rPaytable.m_pPayComboVec )
+        {
+            rPaytable.m_comboSymbVec.push_back( cboIter.getSymbolIndex() );
+            rPaytable.m_comboCountVec.push_back( cboIter.getCount() );
+
+            // Record each unique scatter symbol
+            if( rPaytable.m_type == NSlotDefs::EP_SCATTER )
+            {
+                auto symbIter = std::find( rPaytable.m_scatterSymbVec.begin(), rPaytable.m_scatterSymbVec.end(), cboIter.getSymbolIndex() );
+                rPaytable.m_comboScatterVec.push_back( symbIter - rPaytable.m_scatterSymbVec.begin() );
+
+                if( symbIter == rPaytable.m_scatterSymbVec.end() )
+                    rPaytable.m_scatterSymbVec.push_back( cboIter.getSymbolIndex() );
+            }
+        }
+
+        maxScatterSymbs = std::max( maxScatterSymbs, rPaytable.m_scatterSymbVec.size() );
+    }
+
+    // Size the scratch memory for the worst case
+    m_awardedVec.resize( rPaylineSetVecVec.size() );
+    m_symbPosVec.reserve( m_evalMathSymbs.size() );
+    m_scatterHitVecVec.resize( maxScatterSymbs );
+    for( auto & iter : m_scatterHitVecVec )
+        iter.reserve( m_scatterPosVec.size() );
 }
 
 
@@ -80,22 +164,51 @@ void CSlotGroupModel::generateStops()
 }
 
 
+/************************************************************************
+*    DESC:  Set the reel stops
+*           Used to step through every stop combination
+************************************************************************/
+void CSlotGroupModel::setStops( const std::vector<int> & stopVec )
+{
+    for( size_t i = 0; i < m_slotStripModelDeq.size(); ++i )
+        m_slotStripModelDeq[i].setStop( stopVec.at(i) );
+}
+
+
+/************************************************************************
+*    DESC:  Seed the random number generator
+************************************************************************/
+void CSlotGroupModel::seed( const std::mt19937::result_type seed )
+{
+    m_rng.seed( seed );
+}
+
+void CSlotGroupModel::seed( std::seed_seq & seedSeq )
+{
+    m_rng.seed( seedSeq );
+}
+
+
 /************************************************************************
 *    DESC:  Evaluate the strips
 ************************************************************************/
 void CSlotGroupModel::evaluate()
+{
+    evaluate( CBetMgr::Instance().getLineBet(), CBetMgr::Instance().getTotalBet() );
+}
+
+void CSlotGroupModel::evaluate( const uint lineBet, const uint totalBet )
 {
     generateEvalSymbs();
 
-    // Get the paytable set and evaluate as line pay or scatter
-    auto & rPaytableSetVec = m_rSlotMath.getPaytableSet( m_paytableSetId );
-    for( auto & iter: rPaytableSetVec )
+    // Evaluate the compiled paytables as line pay or scatter
+    for( auto & iter: m_evalPaytableVec )
     {
-        if( iter.getType() == NSlotDefs::EP_PAYLINE )
-            evaluateLinePays( iter.getId() );
+        if( iter.m_type == NSlotDefs::EP_PAYLINE )
+            evaluateLinePays( iter, lineBet );
 
-        else if( iter.getType() == NSlotDefs::EP_SCATTER )
-            evaluateScatters( iter.getId() );
+        else
+            evaluateScatters( iter, totalBet );
     }
 }
 
@@ -107,11 +220,18 @@ void CSlotGroupModel::generateEvalSymbs()
 {
     for( size_t strip = 0; strip < m_slotStripModelDeq.size(); ++strip )
     {
-        const int stop = m_slotStripModelDeq.at(strip).getStop();
-        const auto & rEvalSymbIndexVec = m_slotStripModelDeq.at(strip).getEvalIndexVec();
+        const auto & rStrip = m_slotStripModelDeq[strip];
+        const int stop = rStrip.getStop();
+        const auto & rEvalSymbIndexVec = rStrip.getEvalIndexVec();
+        uint64_t * pMask = &m_evalMaskVec[m_evalOffsetVec[strip]];
 
         for( size_t symb = 0; symb < rEvalSymbIndexVec.size(); ++symb )
-            m_evalMathSymbs.at(strip).at(symb) = &m_slotStripModelDeq.at(strip).getSymbol( stop + rEvalSymbIndexVec.at(symb) );
+        {
+            const CMathSymbol * pMathSymb = &rStrip.getSymbol( stop + rEvalSymbIndexVec[symb] );
+
+            m_evalMathSymbs[strip][symb] = pMathSymb;
+            pMask[symb] = pMathSymb->getMatchMask();
+        }
     }
 }
 
@@ -119,39 +239,38 @@ void CSlotGroupModel::generateEvalSymbs()
 /************************************************************************
 *    DESC:  Evaluate the line pays
 ************************************************************************/
-void CSlotGroupModel::evaluateLinePays( const std::string & paytable )
+void CSlotGroupModel::evaluateLinePays( const CEvalPaytable & rPaytable, const uint lineBet )
 {
-    auto & rPayComboVec = m_rSlotMath.getPayComboSet( paytable );
+    const uint64_t * pMask = m_evalMaskVec.data();
 
-    const auto & rPaylineSetVecVec = m_rPaylineSet.getLineData();
-
-    // An vector of flags to indicate a payline has been awarded and is no longer checked
-    std::vector<bool> awarded(rPaylineSetVecVec.size());
+    // Flags to indicate a payline has been awarded and is no longer checked
+    std::fill( m_awardedVec.begin(), m_awardedVec.end(), 0 );
 
-    for( auto & cboIter : rPayComboVec )
+    for( size_t combo = 0; combo < rPaytable.m_comboSymbVec.size(); ++combo )
     {
-        for( size_t payline = 0; payline < rPaylineSetVecVec.size(); ++payline )
+        const int symbIndex = rPaytable.m_comboSymbVec[combo];
+        const size_t lastStrip = rPaytable.m_comboCountVec[combo] - 1;
+
+        for( size_t payline = 0; payline < m_paylineIndexVecVec.size(); ++payline )
         {
             // Continue if this payline has already been awarded
-            if( awarded.at(payline) )
+            if( m_awardedVec[payline] )
                 continue;
 
-            for( size_t strip = 0; strip < rPaylineSetVecVec.at(payline).size(); ++strip )
-            {
-                const int pos = rPaylineSetVecVec.at(payline).at(strip);
-
-                auto pMathSymb = m_evalMathSymbs.at(strip).at(pos);
+            const auto & rIndexVec = m_paylineIndexVecVec[payline];
 
+            for( size_t strip = 0; strip < rIndexVec.size(); ++strip )
+            {
                 // Break here if not a match to start checking the next payline
-                if( !pMathSymb->isMatch( cboIter.getSymbol() ) )
+                if( ((pMask[rIndexVec[strip]] >> symbIndex) & 1) == 0 )
                     break;
 
                 // If we made it this far and the below condition is true, then it's a match
-                if( strip == static_cast<size_t>(cboIter.getCount()-1) )
+                if( strip == lastStrip )
                 {
-                    awarded.at(payline) = true;
+                    m_awardedVec[payline] = 1;
 
-                    addLinePay( cboIter, payline, rPaylineSetVecVec );
+                    addLinePay( (*rPaytable.m_pPayComboVec)[combo], payline, lineBet );
 
                     break;
                 }
@@ -167,76 +286,53 @@ void CSlotGroupModel::evaluateLinePays( const std::string & paytable )
 void CSlotGroupModel::addLinePay(
     const CPayCombo & rPayCombo,
     const int payline,
-    const std::vector<std::vector<int8_t>> & rPaylineSetVecVec )
+    const uint lineBet )
 {
-    std::vector<CSymbPos> symbPos;
-    symbPos.reserve(rPayCombo.getCount());
+    const auto & rLineVec = m_rPaylineSet.getLineData()[payline];
 
     // Copy over the symbol offsets for the number of strips effected by the win
+    m_symbPosVec.clear();
     for( int i = 0; i < rPayCombo.getCount(); ++i )
-        symbPos.emplace_back( i, rPaylineSetVecVec.at(payline).at(i) );
+        m_symbPosVec.emplace_back( i, rLineVec[i] );
 
     // Add the win to the play result
-    m_rPlayResult.addPay( NSlotDefs::EP_PAYLINE, rPayCombo, CBetMgr::Instance().getLineBet(), payline, symbPos );
+    m_rPlayResult.addPay( NSlotDefs::EP_PAYLINE, rPayCombo, lineBet, payline, m_symbPosVec );
 }
 
 
 /************************************************************************
 *    DESC:  Evaluate the scatter pays
 ************************************************************************/
-void CSlotGroupModel::evaluateScatters( const std::string & paytable )
+void CSlotGroupModel::evaluateScatters( const CEvalPaytable & rPaytable, const uint totalBet )
 {
-    const std::vector<CPayCombo> & rPayComboVec = m_rSlotMath.getPayComboSet( paytable );
+    const size_t symbCount = rPaytable.m_scatterSymbVec.size();
 
-    // An array of each unique scatter symbol name in the paytable
-    std::vector<std::string> symbVec;
-    // A multi-dementional array to record the position of scatter symbols
-    std::vector<std::vector<CSymbPos>> posVecVec;
+    // Clear the list of positions of each scatter symbol
+    for( size_t symb = 0; symb < symbCount; ++symb )
+        m_scatterHitVecVec[symb].clear();
 
-	 // Record each unique scatter symbol and setup a multi-dementional array
-    // to hold the list of positions of each scatter symbol found on the strips.
-    for( auto & cboIter : rPayComboVec )
+    // Go through the allowed scatter positions to find these symbols
+    for( size_t i = 0; i < m_scatterIndexVec.size(); ++i )
     {
-        if( std::find( symbVec.begin(), symbVec.end(), cboIter.getSymbol() ) == symbVec.end() )
-        {
-            symbVec.push_back( cboIter.getSymbol() );
-            posVecVec.emplace_back();
-        }
-    }
+        const uint64_t mask = m_evalMaskVec[m_scatterIndexVec[i]];
 
-    // Go through the eval symbols to find these symbols
-    for( size_t strip = 0; strip < m_evalMathSymbs.size(); ++strip )
-    {
-        for( size_t pos = 0; pos < m_evalMathSymbs.at(strip).size(); ++pos )
+        for( size_t symb = 0; symb < symbCount; ++symb )
         {
-            // Check if these scatter positions are allowed
-            if( m_rPaylineSet.indexOfScaterData( strip, pos ) )
-            {
-                auto pMathSymb = m_evalMathSymbs.at(strip).at(pos);
-
-                for( size_t symb = 0; symb < symbVec.size(); ++symb )
-                {
-                    // If the symbol is a match, record it's position
-                    if( pMathSymb->isMatch( symbVec.at(symb) )  )
-                    {
-                        posVecVec.at(symb).emplace_back( strip, pos );
-                    }
-                }
-            }
+            // If the symbol is a match, record it's position
+            if( (mask >> rPaytable.m_scatterSymbVec[symb]) & 1 )
+                m_scatterHitVecVec[symb].push_back( m_scatterPosVec[i] );
         }
     }
 
-    // Go throught the combo, check for the symbol and see if any of the counts match
-    for( auto & cboIter : rPayComboVec )
+    // Go throught the combos and see if any of the counts match
+    for( size_t combo = 0; combo < rPaytable.m_comboScatterVec.size(); ++combo )
     {
-        for( size_t symb = 0; symb < symbVec.size(); ++symb )
+        const auto & rPosVec = m_scatterHitVecVec[rPaytable.m_comboScatterVec[combo]];
+
+        if( rPosVec.size() == static_cast<size_t>(rPaytable.m_comboCountVec[combo]) )
         {
-            if( (cboIter.getSymbol() == symbVec.at(symb)) &&
-                (posVecVec.at(symb).size() == static_cast<size_t>(cboIter.getCount())) )
-            {
-                // Add the win to the play result
-                m_rPlayResult.addPay( NSlotDefs::EP_SCATTER, cboIter, CBetMgr::Instance().getTotalBet(), -1, posVecVec.at(symb) );
-            }
+            // Add the win to the play result
+            m_rPlayResult.addPay( NSlotDefs::EP_SCATTER, (*rPaytable.m_pPayComboVec)[combo], totalBet, -1, rPosVec );
         }
     }
 }
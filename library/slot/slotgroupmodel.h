@@ -10,12 +10,16 @@
 
 // Game lib dependencies
 #include <slot/slotstripmodel.h>
+#include <slot/slotdefs.h>
+#include <slot/symbolposition.h>
+#include <common/defs.h>
 
 // Standard lib dependencies
 #include <deque>
 #include <random>
 #include <string>
 #include <vector>
+#include <cstdint>
 
 // Forward declaration(s)
 class CSlotMath;
@@ -40,9 +44,17 @@ public:
     
     // Generate the reel stops
     void generateStops();
+
+    // Set the reel stops
+    void setStops( const std::vector<int> & stopVec );
     
     // Evaluate the reels
     void evaluate();
+    void evaluate( const uint lineBet, const uint totalBet );
+
+    // Seed the random number generator
+    void seed( const std::mt19937::result_type seed );
+    void seed( std::seed_seq & seedSeq );
     
     // Get the strips
     const CSlotStripModel & getStrip( int index ) const;
@@ -55,20 +67,46 @@ private:
     // Generate the evaluation symbols
     void generateEvalSymbs();
     
+    // Paytable compiled for evaluation
+    class CEvalPaytable;
+    
+    // Compile the paytables and paylines into integer arrays
+    void compileEvaluation();
+    
     // Evaluate the line pays
-    void evaluateLinePays( const std::string & paytable );
+    void evaluateLinePays( const CEvalPaytable & rPaytable, const uint lineBet );
     
     // Evaluate the scatter pays
-    void evaluateScatters( const std::string & paytable );
+    void evaluateScatters( const CEvalPaytable & rPaytable, const uint totalBet );
     
     // Add line pay to slot result
     void addLinePay(
         const CPayCombo & rPayCombo,
         const int payline,
-        const std::vector<std::vector<int8_t>> & rPaylineSetVecVec );
+        const uint lineBet );
     
 private:
     
+    // Paytable compiled for evaluation
+    class CEvalPaytable
+    {
+    public:
+        
+        // Line pay or scatter
+        NSlotDefs::EPayType m_type;
+        
+        // Pay combos of this paytable
+        const std::vector<CPayCombo> * m_pPayComboVec;
+        
+        // Interned symbol index and count of each combo
+        std::vector<int> m_comboSymbVec;
+        std::vector<int> m_comboCountVec;
+        
+        // Unique scatter symbols and which one each combo uses
+        std::vector<int> m_scatterSymbVec;
+        std::vector<int> m_comboScatterVec;
+    };
+    
     // slot math reference
     const CSlotMath & m_rSlotMath;
     
@@ -89,6 +127,27 @@ private:
     
     // Paytable Set Id
     std::string m_paytableSetId;
+    
+    // Compiled paytables of the paytable set
+    std::vector<CEvalPaytable> m_evalPaytableVec;
+    
+    // Match mask of each evaluation symbol. The strips are back to back
+    std::vector<uint64_t> m_evalMaskVec;
+    
+    // Offset of each strip into the match mask vector
+    std::vector<int> m_evalOffsetVec;
+    
+    // Match mask index of each payline position
+    std::vector<std::vector<int>> m_paylineIndexVecVec;
+    
+    // Evaluation symbols allowed to scatter and their match mask index
+    std::vector<CSymbPos> m_scatterPosVec;
+    std::vector<int> m_scatterIndexVec;
+    
+    // Scratch memory reused by each evaluation
+    std::vector<uint8_t> m_awardedVec;
+    std::vector<CSymbPos> m_symbPosVec;
+    std::vector<std::vector<CSymbPos>> m_scatterHitVecVec;
 
 };
 
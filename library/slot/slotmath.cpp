@@ -200,6 +200,55 @@ void CSlotMath::loadFromNode( const XMLNode & node )
 }
 
 
+/************************************************************************
+*    DESC:  Intern the symbol id to a small integer
+*           The index is a bit in the match mask so there's a limit
+************************************************************************/
+int CSlotMath::internSymbol( const std::string & id )
+{
+    auto iter = m_symbolIndexMap.find( id );
+    if( iter != m_symbolIndexMap.end() )
+        return iter->second;
+
+    const int index = m_symbolIndexMap.size();
+
+    if( index >= MAX_SYMBOLS )
+    {
+        throw NExcept::CCriticalException("Math Data Load Group Error!",
+            boost::str( boost::format("Too many unique symbols, max is %d (%s - %s).\n\n%s\nLine: %s")
+                % MAX_SYMBOLS % id % m_group % __FUNCTION__ % __LINE__ ));
+    }
+
+    m_symbolIndexMap.emplace( id, index );
+
+    return index;
+}
+
+
+/************************************************************************
+*    DESC:  Get the interned index of a symbol id
+*
+*    ret:   int - -1 if not found
+************************************************************************/
+int CSlotMath::getSymbolIndex( const std::string & id ) const
+{
+    auto iter = m_symbolIndexMap.find( id );
+    if( iter == m_symbolIndexMap.end() )
+        return -1;
+
+    return iter->second;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of interned symbols
+************************************************************************/
+size_t CSlotMath::getSymbolCount() const
+{
+    return m_symbolIndexMap.size();
+}
+
+
 /************************************************************************
 *    DESC:  Load the symbol set data from node
 ************************************************************************/
@@ -275,6 +324,10 @@ void CSlotMath::loadSymbolSetsFromNode( const XMLNode & node )
         // Get the symbol list node
         const XMLNode symbLstNode = symbSetNode.getChildNode( "symbolList" );
 
+        // Intern the symbols in the order they are listed
+        for( int symb = 0; symb < symbLstNode.nChildNode(); ++symb )
+            internSymbol( symbLstNode.getChildNode( symb ).getAttribute( "id" ) );
+
         for( int symb = 0; symb < symbLstNode.nChildNode(); ++symb )
         {
             // Get the symbol node
@@ -282,16 +335,26 @@ void CSlotMath::loadSymbolSetsFromNode( const XMLNode & node )
 
             // Get the symbol id
             const std::string symbId = symbNode.getAttribute( "id" );
+            const int symbIndex = internSymbol( symbId );
+
+            // A symbol always matches itself
+            uint64_t matchMask = uint64_t(1) << symbIndex;
 
             // See if this symbol has a wild match
             pWildMatches = &dummy;
             auto wildMatchIter = wildMatchesMap.find( symbId );
             if( wildMatchIter != wildMatchesMap.end() )
+            {
                 pWildMatches = &wildMatchIter->second;
 
+                // Add the symbols it's wild for to the match mask
+                for( auto & wildIter : wildMatchIter->second )
+                    matchMask |= uint64_t(1) << internSymbol( wildIter );
+            }
+
             // Create the math symbol
             auto symbIter = symbSetIter.first->second.emplace(
-                std::piecewise_construct, std::forward_as_tuple(symbId), std::forward_as_tuple(symbId, *pWildMatches) );
+                std::piecewise_construct, std::forward_as_tuple(symbId), std::forward_as_tuple(symbId, *pWildMatches, symbIndex, matchMask) );
 
             // Check for duplicate names
             if( !symbIter.second )
@@ -497,7 +560,7 @@ void CSlotMath::loadPayComboFromNode( const XMLNode & node )
                     bonusCode = std::atoi(payComboNode.getAttribute( "bonusCode" ));
 
                 // Add the combo pay
-                payComboMapIter.first->second.emplace_back( symb, count, award, bonusCode );
+                payComboMapIter.first->second.emplace_back( symb, count, award, bonusCode, internSymbol( symb ) );
             }
         }
     }
@@ -29,6 +29,9 @@ class CSlotMath
 {
 public:
 
+    // Max number of unique symbols. Each one is a bit in the match mask
+    enum{ MAX_SYMBOLS = 64 };
+
     // Constructor
     CSlotMath( const std::string & group );
     
@@ -66,6 +69,12 @@ public:
     // Load thes reel group data from node
     void loadFromNode( const XMLNode & node );
     
+    // Get the interned index of a symbol id. Returns -1 if not found
+    int getSymbolIndex( const std::string & id ) const;
+    
+    // Get the number of interned symbols
+    size_t getSymbolCount() const;
+    
 private:
     
     // Load the symbol set data from node
@@ -89,6 +98,9 @@ private:
     // Load the value table data from node
     void loadValueTableFromNode( const XMLNode & node );
     
+    // Intern the symbol id to a small integer
+    int internSymbol( const std::string & id );
+    
 private:
     
     // The group the math data is in
@@ -108,6 +120,10 @@ private:
     // Map of math symbol set
     std::map<const std::string, std::map<const std::string, CMathSymbol> > m_symbolSetMapMap;
     
+    // Interned index of every symbol id used by this math. Shared by all
+    // the symbol sets so pay combos can be matched against any of them
+    std::map<const std::string, int> m_symbolIndexMap;
+    
     // Map of math symbol strips
     std::map<const std::string, std::vector<CStripStop>> m_stripMapVec;
     
@@ -24,13 +24,17 @@ CSlotStripModel::CSlotStripModel(
         m_rMathStripVec(rMathStripVec),
         m_rRng(rRng),
         m_evalSymbIndexVec(evalSymbIndexVec),
-        m_totalWeight(0),
         m_lastStop(0),
         m_stop(0)
 {
-    // Get the total weight of the slot strip
+    // Compile the strip weights into an alias table
+    std::vector<int> weightVec;
+    weightVec.reserve( rMathStripVec.size() );
+
     for( auto & iter : rMathStripVec )
-        m_totalWeight += iter.getWeight();
+        weightVec.push_back( iter.getWeight() );
+
+    m_aliasTable.init( weightVec );
 }
 
 
@@ -48,20 +52,18 @@ CSlotStripModel::~CSlotStripModel()
 void CSlotStripModel::generateStop()
 {
     m_lastStop = m_stop;
-    m_stop = 0;
-    int weightCount = 0;
-
-    int awardedWeight = m_rRng() % (m_totalWeight + 1);
-
-    for( auto & iter : m_rMathStripVec )
-    {
-        weightCount += iter.getWeight();
+    m_stop = m_aliasTable.draw( m_rRng );
+}
 
-        if( awardedWeight <= weightCount )
-            break;
 
-        ++m_stop;
-    }
+/************************************************************************
+*    DESC:  Set the strip stop
+*           Used to step through every stop of the strip
+************************************************************************/
+void CSlotStripModel::setStop( const int stop )
+{
+    m_lastStop = m_stop;
+    m_stop = getSymbolIndex( stop );
 }
 
 
@@ -8,6 +8,9 @@
 #ifndef __slot_strip_model_h__
 #define __slot_strip_model_h__
 
+// Game lib dependencies
+#include <slot/aliastable.h>
+
 // Boost lib dependencies
 #include <boost/noncopyable.hpp>
 
@@ -36,6 +39,9 @@ public:
     
     // Generate the strip stop
     void generateStop();
+
+    // Set the strip stop
+    void setStop( const int stop );
     
     // Get the last stop
     int getLastStop() const;
@@ -66,8 +72,8 @@ private:
     // Evaluation symbol index vector
     std::vector<int8_t> m_evalSymbIndexVec;
     
-    // total weight
-    int m_totalWeight;
+    // Strip weights compiled for O(1) draws
+    CAliasTable m_aliasTable;
     
     // last strip stop
     int m_lastStop;
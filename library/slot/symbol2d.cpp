@@ -92,13 +92,9 @@ void CSymbol2d::transform()
 {
     m_parameters.remove( NDefs::WAS_TRANSFORMED );
 
-    if( m_parameters.isSet( NDefs::TRANSFORM ) )
-    {
+    if( m_parameters.isSet( NDefs::TRANSFORM ) || isInterpolating() )
         transformLocal( m_finalMatrix );
 
-        m_transPos = m_pos;
-    }
-
     for( auto & iter : m_spriteDeq )
         iter.transform( m_finalMatrix, wasWorldPosTranformed() );
 }
@@ -107,7 +103,7 @@ void CSymbol2d::transform( const CMatrix & matrix, bool tranformWorldPos )
 {
     m_parameters.remove( NDefs::WAS_TRANSFORMED );
 
-    if( m_parameters.isSet( NDefs::TRANSFORM ) )
+    if( m_parameters.isSet( NDefs::TRANSFORM ) || isInterpolating() )
         transformLocal( m_matrix );
 
     if( m_parameters.isSet( NDefs::WAS_TRANSFORMED ) || tranformWorldPos )
@@ -8,6 +8,9 @@
 // Physical component dependency
 #include <slot/weightedtable.h>
 
+// Standard lib dependencies
+#include <algorithm>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -17,8 +20,17 @@ CWeightedTable::CWeightedTable(
     const std::vector<int> & valueVec ) :
         CValueTable( valueVec ),
             m_totalWeight(totalWeight),
-            m_weightVec(weightVec)
+            m_weightVec(weightVec),
+            m_aliasTable(weightVec)
 {
+    m_cumulativeVec.reserve( weightVec.size() );
+
+    int weightCount(0);
+    for( int iter : weightVec )
+    {
+        weightCount += iter;
+        m_cumulativeVec.push_back( weightCount );
+    }
 }
 
 
@@ -32,25 +44,20 @@ CWeightedTable::~CWeightedTable()
 
 /************************************************************************
  *    DESC:  Get the value from the weighted table
+ *           The first entry who's running total reaches the rng value
  ************************************************************************/
 int CWeightedTable::getWeightedValue( const int rngValue ) const
 {
-    int index(0);
-    int weightCount(0);
-
-    for( int iter : m_weightVec )
-    {
-        weightCount += iter;
-
-        if( rngValue <= weightCount )
-            break;
-
-        ++index;
-    }
+    const int index = std::lower_bound( m_cumulativeVec.begin(), m_cumulativeVec.end(), rngValue ) - m_cumulativeVec.begin();
 
     return getValue(index);
 }
 
+int CWeightedTable::getWeightedValue( std::mt19937 & rRng ) const
+{
+    return getValue( m_aliasTable.draw( rRng ) );
+}
+
 
 /************************************************************************
  *    DESC:  Get the total weight value
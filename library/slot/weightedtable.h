@@ -11,6 +11,12 @@
 // Physical component dependency
 #include <slot/valuetable.h>
 
+// Game lib dependencies
+#include <slot/aliastable.h>
+
+// Standard lib dependencies
+#include <random>
+
 class CWeightedTable : public CValueTable
 {
 public:
@@ -26,6 +32,7 @@ public:
     
     // Get the value from the weighted table
     int getWeightedValue( const int rngValue ) const;
+    int getWeightedValue( std::mt19937 & rRng ) const;
     
     // Get the total weight value
     int getTotalWeight() const;
@@ -37,6 +44,12 @@ private:
     
     // weight
     const std::vector<int> m_weightVec;
+
+    // Running total of the weights for the binary search
+    std::vector<int> m_cumulativeVec;
+
+    // Weights compiled for O(1) draws
+    CAliasTable m_aliasTable;
 };
 
 #endif  // __weighted_table_h__
@@ -25,6 +25,7 @@ CBaseStrategy::CBaseStrategy()
  ************************************************************************/
 void CBaseStrategy::setToDestroy( int spriteIndex )
 {
+    std::unique_lock<std::mutex> lock( m_deferMutex );
     m_deleteSet.insert( spriteIndex );
 }
 
@@ -34,6 +35,7 @@ void CBaseStrategy::setToDestroy( int spriteIndex )
  ************************************************************************/
 void CBaseStrategy::setToCreate( const std::string & name )
 {
+    std::unique_lock<std::mutex> lock( m_deferMutex );
     m_createSet.insert( name );
 }
 
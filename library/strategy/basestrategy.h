@@ -14,6 +14,7 @@
 // Standard lib dependencies
 #include <set>
 #include <string>
+#include <mutex>
 
 class CBaseStrategy : public iStrategy
 {
@@ -58,6 +59,10 @@ private:
     // Using a set insures only unique entries are inserted
     std::set<std::string> m_createSet;
     
+    // AI can request a delete/create from a worker thread
+    // during the parallel sprite update
+    std::mutex m_deferMutex;
+    
 };
 
 #endif  // __base_strategy_h__
@@ -14,22 +14,43 @@
 #include <2d/sprite2d.h>
 #include <3d/sprite3d.h>
 #include <2d/actorsprite2d.h>
+#include <2d/spatialgrid2d.h>
+#include <common/camera.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/xmlParser.h>
-#include <utilities/deletefuncs.h>
 #include <utilities/genfunc.h>
+#include <utilities/settings.h>
+#include <utilities/threadpool.h>
 #include <managers/cameramanager.h>
 #include <managers/signalmanager.h>
+#include <managers/spritebatchmanager.h>
 #include <objectdata/objectdata2d.h>
 #include <objectdata/objectdatamanager.h>
+#include <utilities/profiler.h>
+#include <script/scriptmanager.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <new>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    // No deleted sprites are waiting to be removed from the draw list
+    const size_t NO_HOLE = std::numeric_limits<size_t>::max();
+}
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
-CBasicSpriteStrategy::CBasicSpriteStrategy()
+CBasicSpriteStrategy::CBasicSpriteStrategy() :
+    m_allowParallel(true),
+    m_firstHole(NO_HOLE),
+    m_querySlotVecVec(CThreadPool::Instance().getWorkerCount() + 1)
 {
 }
 
@@ -39,8 +60,9 @@ CBasicSpriteStrategy::CBasicSpriteStrategy()
 ************************************************************************/
 CBasicSpriteStrategy::~CBasicSpriteStrategy()
 {
-    for( auto & iter : m_spriteMap )
-        NDelFunc::Delete( iter.second );
+    for( uint32_t i = 0; i < m_slotVec.size(); ++i )
+        if( m_slotVec[i].m_pSprite != nullptr )
+            freeSlot( i );
 }
 
 
@@ -65,6 +87,14 @@ void CBasicSpriteStrategy::loadFromFile( const std::string & file )
         if( spriteListNode.isAttributeSet( "defaultAIName" ) )
             defAIName = spriteListNode.getAttribute( "defaultAIName" );
 
+        // Keep the sprites in a spatial index for culling and radius queries
+        if( spriteListNode.isAttributeSet( "spatialCellSize" ) )
+        {
+            const float cellSize = std::atof( spriteListNode.getAttribute( "spatialCellSize" ) );
+            if( cellSize > 0 )
+                m_upSpatialGrid.reset( new CSpatialGrid2D( cellSize ) );
+        }
+
         // Load the sprite data
         for( int i = 0; i < spriteListNode.nChildNode(); ++i )
         {
@@ -76,26 +106,36 @@ void CBasicSpriteStrategy::loadFromFile( const std::string & file )
             const std::string tag( spriteNode.getName() );
 
             bool duplicate(false);
+            size_t spriteSize(0);
 
             // Load the sprite data into the map
             if( tag == "sprite2d" )
+            {
                 duplicate = !m_dataMap.emplace(
                     std::piecewise_construct,
                     std::forward_as_tuple(name),
                     std::forward_as_tuple(new CSpriteData(spriteNode, defGroup, defObjName, defAIName), NDefs::EOT_SPRITE2D) ).second;
 
+                spriteSize = sizeof(CSprite2D);
+            }
             else if( tag == "sprite3d" )
+            {
                 duplicate = !m_dataMap.emplace(
                     std::piecewise_construct,
                     std::forward_as_tuple(name),
                     std::forward_as_tuple(new CSpriteData(spriteNode, defGroup, defObjName, defAIName), NDefs::EOT_SPRITE3D) ).second;
 
+                spriteSize = sizeof(CSprite3D);
+            }
             else if( tag == "actor2d" )
+            {
                 duplicate = !m_dataMap.emplace(
                     std::piecewise_construct,
                     std::forward_as_tuple(name),
                     std::forward_as_tuple(new CActorData(spriteNode, defGroup, defObjName, defAIName), NDefs::EOT_OBJECT_NODE) ).second;
 
+                spriteSize = sizeof(CActorSprite2D);
+            }
             else
                 throw NExcept::CCriticalException("Sprite Load Error!",
                     boost::str( boost::format("Undefined sprite tag (%s).\n\n%s\nLine: %s")
@@ -108,6 +148,16 @@ void CBasicSpriteStrategy::loadFromFile( const std::string & file )
                     boost::str( boost::format("Duplicate sprite name (%s).\n\n%s\nLine: %s")
                         % name % __FUNCTION__ % __LINE__ ));
             }
+
+            // The sprites of this data are allocated from their own pool.
+            // poolSize of them can be allocated up front. ie projectiles
+            auto & rPool = m_poolMap.emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(name),
+                std::forward_as_tuple(spriteSize) ).first->second;
+
+            if( spriteNode.isAttributeSet( "poolSize" ) )
+                rPool.reserve( std::max( 0, std::atoi( spriteNode.getAttribute( "poolSize" ) ) ) );
         }
     }
 }
@@ -139,84 +189,106 @@ iSprite * CBasicSpriteStrategy::create(
     const CPoint<float> & scale )
 {
     std::string aiName;
-    const CSpriteDataContainer & rSpriteDataContainer = getData( dataName );
+    iSprite * pSprite = createFromData( dataName, aiName );
 
-    // If the sprite defined a unique id then use that
-    int spriteId( ((m_spriteInc++) + m_idOffset) * m_idDir );
+    // Use passed in transforms if specified
+    if( !pos.isEmpty() )
+        pSprite->setPos(pos);
 
-    std::pair<std::map<const int, iSprite *>::iterator, bool> iter;
+    if( !rot.isEmpty() )
+        pSprite->setRot(rot, false);
 
-    // Create the sprite
-    if( rSpriteDataContainer.getType() == NDefs::EOT_SPRITE2D )
-    {
-        const auto & rData = rSpriteDataContainer.get<CSpriteData>();
-        if( rData.getId() != defs_SPRITE_DEFAULT_ID )
-            spriteId = rData.getId();
+    if( scale != CPoint<float>(1,1,1) )
+        pSprite->setScale(scale);
 
-        // Allocate the sprite
-        iter = m_spriteMap.emplace( spriteId, new CSprite2D( CObjectDataMgr::Instance().getData2D( rData ), spriteId ) );
+    // Init the physics
+    pSprite->initPhysics();
+    
+    // Init the sprite
+    pSprite->init();
 
-        // Load the rest from sprite data
-        dynamic_cast<CSprite2D *>(iter.first->second)->load( rData );
+    // Broadcast the signal to create the sprite AI
+    if( !aiName.empty() )
+        CSignalMgr::Instance().broadcast( aiName, pSprite );
 
-        aiName = rData.getAIName();
-    }
-    else if( rSpriteDataContainer.getType() == NDefs::EOT_OBJECT_NODE )
-    {
-        const auto & rData = rSpriteDataContainer.get<CActorData>();
-        if( rData.getId() != defs_SPRITE_DEFAULT_ID )
-            spriteId = rData.getId();
+    return pSprite;
+}
 
-        // Allocate the actor sprite
-        iter = m_spriteMap.emplace( spriteId, new CActorSprite2D( rData, spriteId ) );
+iSprite * CBasicSpriteStrategy::create(
+    const std::string & dataName )
+{
+    std::string aiName;
+    iSprite * pSprite = createFromData( dataName, aiName );
 
-        aiName = rData.getAIName();
-    }
+    // Init the physics
+    pSprite->initPhysics();
+    
+    // Init the sprite
+    pSprite->init();
 
-    // Check for duplicate id's
-    if( !iter.second )
-    {
-        throw NExcept::CCriticalException("Sprite Create Error!",
-            boost::str( boost::format("Duplicate sprite id (%s - %d).\n\n%s\nLine: %s")
-                % dataName % spriteId % __FUNCTION__ % __LINE__ ));
-    }
+    // Broadcast the signal to create the sprite AI
+    if( !aiName.empty() )
+        CSignalMgr::Instance().broadcast( aiName, pSprite );
+
+    return pSprite;
+}
+
+iSprite * CBasicSpriteStrategy::create(
+    const std::string & group,
+    const std::string & name,
+    const CPoint<CWorldValue> & pos,
+    const CPoint<float> & rot,
+    const CPoint<float> & scale )
+{
+    iSprite * pSprite = createFromObjectData( group, name );
 
     // Use passed in transforms if specified
     if( !pos.isEmpty() )
-        iter.first->second->setPos(pos);
+        pSprite->setPos(pos);
 
     if( !rot.isEmpty() )
-        iter.first->second->setRot(rot, false);
+        pSprite->setRot(rot, false);
 
     if( scale != CPoint<float>(1,1,1) )
-        iter.first->second->setScale(scale);
+        pSprite->setScale(scale);
 
     // Init the physics
-    iter.first->second->initPhysics();
+    pSprite->initPhysics();
     
     // Init the sprite
-    iter.first->second->init();
+    pSprite->init();
 
-    // Broadcast the signal to create the sprite AI
-    if( !aiName.empty() )
-        CSignalMgr::Instance().broadcast( aiName, iter.first->second );
+    return pSprite;
+}
 
-    // Add the sprite pointer to the vector for rendering
-    m_pSpriteVec.push_back( iter.first->second );
+iSprite * CBasicSpriteStrategy::create(
+    const std::string & group,
+    const std::string & name )
+{
+    iSprite * pSprite = createFromObjectData( group, name );
+
+    // Init the physics
+    pSprite->initPhysics();
+    
+    // Init the sprite
+    pSprite->init();
 
-    return iter.first->second;
+    return pSprite;
 }
 
-iSprite * CBasicSpriteStrategy::create(
-    const std::string & dataName )
+
+/************************************************************************
+*    DESC:  Allocate the sprite from the pool of it's sprite data
+************************************************************************/
+iSprite * CBasicSpriteStrategy::createFromData( const std::string & dataName, std::string & aiName )
 {
-    std::string aiName;
     const CSpriteDataContainer & rSpriteDataContainer = getData( dataName );
+    CSlabAllocator & rPool = m_poolMap.find( dataName )->second;
 
     // If the sprite defined a unique id then use that
     int spriteId( ((m_spriteInc++) + m_idOffset) * m_idDir );
 
-    std::pair<std::map<const int, iSprite *>::iterator, bool> iter;
+    iSprite * pSprite(nullptr);
 
     // Create the sprite
     if( rSpriteDataContainer.getType() == NDefs::EOT_SPRITE2D )
@@ -225,13 +297,17 @@ iSprite * CBasicSpriteStrategy::create(
         if( rData.getId() != defs_SPRITE_DEFAULT_ID )
             spriteId = rData.getId();
 
+        checkDuplicateId( spriteId, dataName );
+
         // Allocate the sprite
-        iter = m_spriteMap.emplace( spriteId, new CSprite2D( CObjectDataMgr::Instance().getData2D( rData ), spriteId ) );
+        CSprite2D * pSprite2D = new(rPool.allocate()) CSprite2D( CObjectDataMgr::Instance().getData2D( rData ), spriteId );
+        addSprite( pSprite2D, &rPool );
 
         // Load the rest from sprite data
-        dynamic_cast<CSprite2D *>(iter.first->second)->load( rData );
+        pSprite2D->load( rData );
 
         aiName = rData.getAIName();
+        pSprite = pSprite2D;
     }
     else if( rSpriteDataContainer.getType() == NDefs::EOT_OBJECT_NODE )
     {
@@ -239,129 +315,136 @@ iSprite * CBasicSpriteStrategy::create(
         if( rData.getId() != defs_SPRITE_DEFAULT_ID )
             spriteId = rData.getId();
 
+        checkDuplicateId( spriteId, dataName );
+
         // Allocate the actor sprite
-        iter = m_spriteMap.emplace( spriteId, new CActorSprite2D( rData, spriteId ) );
+        pSprite = new(rPool.allocate()) CActorSprite2D( rData, spriteId );
+        addSprite( pSprite, &rPool );
 
         aiName = rData.getAIName();
     }
-
-    // Init the physics
-    iter.first->second->initPhysics();
-    
-    // Init the sprite
-    iter.first->second->init();
-
-    // Check for duplicate id's
-    if( !iter.second )
+    else
     {
         throw NExcept::CCriticalException("Sprite Create Error!",
-            boost::str( boost::format("Duplicate sprite id (%s - %d).\n\n%s\nLine: %s")
-                % dataName % spriteId % __FUNCTION__ % __LINE__ ));
+            boost::str( boost::format("Sprite type can't be created from sprite data (%s).\n\n%s\nLine: %s")
+                % dataName % __FUNCTION__ % __LINE__ ));
     }
 
-    // Broadcast the signal to create the sprite AI
-    if( !aiName.empty() )
-        CSignalMgr::Instance().broadcast( aiName, iter.first->second );
-
-    // Add the sprite pointer to the vector for rendering
-    m_pSpriteVec.push_back( iter.first->second );
-
-    return iter.first->second;
+    return pSprite;
 }
 
-iSprite * CBasicSpriteStrategy::create(
-    const std::string & group,
-    const std::string & name,
-    const CPoint<CWorldValue> & pos,
-    const CPoint<float> & rot,
-    const CPoint<float> & scale )
+
+/************************************************************************
+*    DESC:  Allocate the sprite from the object data
+************************************************************************/
+iSprite * CBasicSpriteStrategy::createFromObjectData( const std::string & group, const std::string & name )
 {
     // If the sprite defined a unique id then use that
     int spriteId( ((m_spriteInc++) + m_idOffset) * m_idDir );
 
-    std::pair<std::map<const int, iSprite *>::iterator, bool> iter;
+    checkDuplicateId( spriteId, name );
+
+    iSprite * pSprite(nullptr);
 
     // Allocate the sprite
     if( CObjectDataMgr::Instance().isData2D( group, name ) )
     {
         auto & objData = CObjectDataMgr::Instance().getData2D( group, name );
-        iter = m_spriteMap.emplace( spriteId, new CSprite2D( objData, spriteId ) );
+        pSprite = new CSprite2D( objData, spriteId );
     }
     else if( CObjectDataMgr::Instance().isData3D( group, name ) )
     {
         auto & objData = CObjectDataMgr::Instance().getData3D( group, name );
-        iter = m_spriteMap.emplace( spriteId, new CSprite3D( objData, spriteId ) );
+        pSprite = new CSprite3D( objData, spriteId );
+    }
+    else
+    {
+        throw NExcept::CCriticalException("Sprite Create Error!",
+            boost::str( boost::format("Object data can't be found (%s - %s).\n\n%s\nLine: %s")
+                % group % name % __FUNCTION__ % __LINE__ ));
     }
 
-    // Check for duplicate id's
-    if( !iter.second )
+    addSprite( pSprite, nullptr );
+
+    return pSprite;
+}
+
+
+/************************************************************************
+*    DESC:  Throw if the sprite id is already used
+************************************************************************/
+void CBasicSpriteStrategy::checkDuplicateId( int spriteId, const std::string & name ) const
+{
+    if( m_spriteMap.find( spriteId ) != m_spriteMap.end() )
     {
         throw NExcept::CCriticalException("Sprite Create Error!",
             boost::str( boost::format("Duplicate sprite id (%s - %d).\n\n%s\nLine: %s")
                 % name % spriteId % __FUNCTION__ % __LINE__ ));
     }
+}
 
-    // Use passed in transforms if specified
-    if( !pos.isEmpty() )
-        iter.first->second->setPos(pos);
 
-    if( !rot.isEmpty() )
-        iter.first->second->setRot(rot, false);
+/************************************************************************
+*    DESC:  Add the sprite to a slot and the end of the draw list
+************************************************************************/
+void CBasicSpriteStrategy::addSprite( iSprite * pSprite, CSlabAllocator * pPool )
+{
+    uint32_t slotIndex;
 
-    if( scale != CPoint<float>(1,1,1) )
-        iter.first->second->setScale(scale);
+    if( !m_freeSlotVec.empty() )
+    {
+        slotIndex = m_freeSlotVec.back();
+        m_freeSlotVec.pop_back();
+    }
+    else
+    {
+        slotIndex = m_slotVec.size();
+        m_slotVec.emplace_back();
+    }
 
-    // Init the physics
-    iter.first->second->initPhysics();
-    
-    // Init the sprite
-    iter.first->second->init();
+    // The strategy transforms its sprites without a parent so they can be batched
+    pSprite->setBatchTransform();
 
-    // Add the sprite pointer to the vector for rendering
-    m_pSpriteVec.push_back( iter.first->second );
+    CSpriteSlot & rSlot = m_slotVec[slotIndex];
+    rSlot.m_pSprite = pSprite;
+    rSlot.m_pPool = pPool;
+    rSlot.m_drawIndex = m_pSpriteVec.size();
+
+    m_spriteMap.emplace( pSprite->getId(), slotIndex );
 
-    return iter.first->second;
+    // Add the sprite pointer to the vector for rendering
+    m_pSpriteVec.push_back( pSprite );
+    m_drawSlotVec.push_back( slotIndex );
 }
 
-iSprite * CBasicSpriteStrategy::create(
-    const std::string & group,
-    const std::string & name )
-{
-    // If the sprite defined a unique id then use that
-    int spriteId( ((m_spriteInc++) + m_idOffset) * m_idDir );
 
-    std::pair<std::map<const int, iSprite *>::iterator, bool> iter;
+/************************************************************************
+*    DESC:  Destroy the sprite and free it's slot
+************************************************************************/
+void CBasicSpriteStrategy::freeSlot( uint32_t slotIndex )
+{
+    CSpriteSlot & rSlot = m_slotVec[slotIndex];
 
-    // Allocate the sprite
-    if( CObjectDataMgr::Instance().isData2D( group, name ) )
+    if( rSlot.m_pPool != nullptr )
     {
-        auto & objData = CObjectDataMgr::Instance().getData2D( group, name );
-        iter = m_spriteMap.emplace( spriteId, new CSprite2D( objData, spriteId ) );
+        // The slot memory starts at the most derived object
+        void * pMem = dynamic_cast<void *>(rSlot.m_pSprite);
+        rSlot.m_pSprite->~iSprite();
+        rSlot.m_pPool->deallocate( pMem );
     }
-    else if( CObjectDataMgr::Instance().isData3D( group, name ) )
+    else
     {
-        auto & objData = CObjectDataMgr::Instance().getData3D( group, name );
-        iter = m_spriteMap.emplace( spriteId, new CSprite3D( objData, spriteId ) );
+        delete rSlot.m_pSprite;
     }
 
-    // Check for duplicate id's
-    if( !iter.second )
-    {
-        throw NExcept::CCriticalException("Sprite Create Error!",
-            boost::str( boost::format("Duplicate sprite id (%s - %d).\n\n%s\nLine: %s")
-                % name % spriteId % __FUNCTION__ % __LINE__ ));
-    }
+    rSlot.m_pSprite = nullptr;
+    rSlot.m_pPool = nullptr;
+    ++rSlot.m_generation;
 
-    // Init the physics
-    iter.first->second->initPhysics();
-    
-    // Init the sprite
-    iter.first->second->init();
+    if( m_upSpatialGrid )
+        m_upSpatialGrid->remove( slotIndex );
 
-    // Add the sprite pointer to the vector for rendering
-    m_pSpriteVec.push_back( iter.first->second );
-
-    return iter.first->second;
+    m_freeSlotVec.push_back( slotIndex );
 }
 
 
@@ -374,6 +457,21 @@ void CBasicSpriteStrategy::createObj( const std::string & name )
 }
 
 
+/***************************************************************************
+*    DESC:  Handle the deleting of any sprites
+*           The deleted sprites leave holes in the draw list that are
+*           closed up in one pass once all the deletes are done. This
+*           keeps the draw order without moving the list for each delete
+****************************************************************************/
+void CBasicSpriteStrategy::handleDelete()
+{
+    CBaseStrategy::handleDelete();
+
+    if( m_firstHole < m_pSpriteVec.size() )
+        compactSpriteVec();
+}
+
+
 /***************************************************************************
 *    DESC:  Handle the deleting of any sprites
 *           NOTE: Do not call from a destructor!
@@ -384,16 +482,19 @@ void CBasicSpriteStrategy::deleteObj( int index )
     const auto iter = m_spriteMap.find( index );
     if( iter != m_spriteMap.end() )
     {
+        const uint32_t slotIndex = iter->second;
+        const uint32_t drawIndex = m_slotVec[slotIndex].m_drawIndex;
+
         // specifically delete the physics body before deleting the sprite
         // Deleting the physics always needs to be done externally and
         // under the right conditions. NEVER call from destructor
-        iter->second->cleanUp();
+        m_slotVec[slotIndex].m_pSprite->cleanUp();
 
-        auto spriteIter = std::find( m_pSpriteVec.begin(), m_pSpriteVec.end(), iter->second );
-        if( spriteIter != m_pSpriteVec.end() )
-            m_pSpriteVec.erase( spriteIter );
+        // Leave a hole in the draw list
+        m_pSpriteVec[drawIndex] = nullptr;
+        m_firstHole = std::min( m_firstHole, (size_t)drawIndex );
 
-        NDelFunc::Delete( iter->second );
+        freeSlot( slotIndex );
         m_spriteMap.erase( iter );
     }
     else
@@ -404,6 +505,30 @@ void CBasicSpriteStrategy::deleteObj( int index )
 }
 
 
+/***************************************************************************
+*    DESC:  Close up the holes left in the draw list by the deleted sprites
+****************************************************************************/
+void CBasicSpriteStrategy::compactSpriteVec()
+{
+    size_t count = m_firstHole;
+
+    for( size_t i = m_firstHole; i < m_pSpriteVec.size(); ++i )
+    {
+        if( m_pSpriteVec[i] != nullptr )
+        {
+            m_pSpriteVec[count] = m_pSpriteVec[i];
+            m_drawSlotVec[count] = m_drawSlotVec[i];
+            m_slotVec[m_drawSlotVec[count]].m_drawIndex = count;
+            ++count;
+        }
+    }
+
+    m_pSpriteVec.resize( count );
+    m_drawSlotVec.resize( count );
+    m_firstHole = NO_HOLE;
+}
+
+
 /************************************************************************
 *    DESC:  Do some cleanup
 ************************************************************************/
@@ -419,11 +544,45 @@ void CBasicSpriteStrategy::cleanUp()
 ****************************************************************************/
 void CBasicSpriteStrategy::update()
 {
-    for( auto iter : m_pSpriteVec )
+    PROFILE_ZONE( "CBasicSpriteStrategy::update" );
+
+    if( useParallel( CSettings::Instance().getParallelSpriteUpdate() ) )
+    {
+        // Script contexts are not thread safe so they are run here
+        // except for the ones of the groups flagged parallel.
+        // All the scripts run before the AI and 3D physics. See iSprite::scriptUpdate
+        for( auto iter : m_pSpriteVec )
+            iter->scriptUpdate();
+
+        // Any sprite creates/deletes requested by the AI are
+        // deferred through setToCreate/setToDestroy
+        CThreadPool::Instance().parallel_for(
+            0, m_pSpriteVec.size(), CSettings::Instance().getParallelSpriteGrainSize(),
+            [this]( size_t first, size_t last )
+            {
+                PROFILE_ZONE( "CBasicSpriteStrategy::updateRange" );
+
+                for( size_t i = first; i < last; ++i )
+                {
+                    // The calls the parallel scripts make into the game are applied in sprite order
+                    CScriptMgr::Instance().setParallelOrder( i );
+
+                    m_pSpriteVec[i]->parallelUpdate();
+                    m_pSpriteVec[i]->physicsUpdate();
+                }
+            } );
+    }
+    else
     {
-        iter->update();
-        iter->physicsUpdate();
+        for( auto iter : m_pSpriteVec )
+        {
+            iter->update();
+            iter->physicsUpdate();
+        }
     }
+
+    // Sync point of the calls the parallel scripts queued
+    CScriptMgr::Instance().applyCommands();
 }
 
 
@@ -432,8 +591,86 @@ void CBasicSpriteStrategy::update()
 ************************************************************************/
 void CBasicSpriteStrategy::transform()
 {
-    for( auto iter : m_pSpriteVec )
-        iter->transform();
+    PROFILE_ZONE( "CBasicSpriteStrategy::transform" );
+
+    if( useParallel( CSettings::Instance().getParallelSpriteTransform() ) )
+    {
+        CThreadPool::Instance().parallel_for(
+            0, m_pSpriteVec.size(), CSettings::Instance().getParallelSpriteGrainSize(),
+            [this]( size_t first, size_t last )
+            {
+                PROFILE_ZONE( "CBasicSpriteStrategy::transformRange" );
+
+                for( size_t i = first; i < last; ++i )
+                    m_pSpriteVec[i]->transform();
+            } );
+    }
+    else
+    {
+        for( auto iter : m_pSpriteVec )
+            iter->transform();
+    }
+
+    updateSpatialIndex();
+}
+
+
+/************************************************************************
+*    DESC:  Move the sprites in the spatial index to their transformed position
+*           Done after the transform, on this thread, so the AI can query
+*           the index from the worker threads during the update
+************************************************************************/
+void CBasicSpriteStrategy::updateSpatialIndex()
+{
+    if( m_upSpatialGrid )
+    {
+        for( size_t i = 0; i < m_pSpriteVec.size(); ++i )
+            m_upSpatialGrid->update( m_drawSlotVec[i], m_pSpriteVec[i]->getTransPos(), m_pSpriteVec[i]->getRadius() );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the draw indexes of the sprites in view of the camera
+*           Only orthographic cameras are culled. The corners of the
+*           screen are taken back to world space so a moved, scaled or
+*           rotated camera still gets the right area
+************************************************************************/
+bool CBasicSpriteStrategy::cull( const CCamera & camera )
+{
+    if( !m_upSpatialGrid || (camera.getProjectionType() != NDefs::EPT_ORTHOGRAPHIC) )
+        return false;
+
+    CMatrix matrix( camera.getFinalMatrix() );
+    if( !matrix.invert() )
+        return false;
+
+    CRect<float> rect( std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                       std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() );
+
+    const float CORNER[4][2] = { {-1,-1}, {1,-1}, {1,1}, {-1,1} };
+
+    for( int i = 0; i < 4; ++i )
+    {
+        CPoint<float> point;
+        matrix.transform( point, CPoint<float>( CORNER[i][0], CORNER[i][1], 0 ) );
+
+        rect.x1 = std::min( rect.x1, point.x );
+        rect.y1 = std::min( rect.y1, point.y );
+        rect.x2 = std::max( rect.x2, point.x );
+        rect.y2 = std::max( rect.y2, point.y );
+    }
+
+    m_visibleVec.clear();
+    m_upSpatialGrid->queryRect( rect, m_visibleVec );
+
+    // Render in draw order
+    for( auto & iter : m_visibleVec )
+        iter = m_slotVec[iter].m_drawIndex;
+
+    std::sort( m_visibleVec.begin(), m_visibleVec.end() );
+
+    return true;
 }
 
 
@@ -442,22 +679,51 @@ void CBasicSpriteStrategy::transform()
 ****************************************************************************/
 void CBasicSpriteStrategy::render( const CMatrix & matrix )
 {
+    PROFILE_ZONE( "CBasicSpriteStrategy::render" );
+
+    const bool spriteBatch( CSettings::Instance().getSpriteBatch() );
+
+    if( spriteBatch )
+        CSpriteBatchMgr::Instance().begin();
+
     for( auto iter : m_pSpriteVec )
         iter->render( matrix );
+
+    if( spriteBatch )
+        CSpriteBatchMgr::Instance().end();
 }
 
 void CBasicSpriteStrategy::render( const CMatrix & matrix, const CMatrix & rotMatrix )
 {
+    PROFILE_ZONE( "CBasicSpriteStrategy::render" );
+
     for( auto iter : m_pSpriteVec )
         iter->render( matrix, rotMatrix );
 }
 
 void CBasicSpriteStrategy::render()
 {
+    PROFILE_ZONE( "CBasicSpriteStrategy::render" );
+
     const auto & camera = CCameraMgr::Instance().getCamera( m_cameraId );
+    const bool spriteBatch( CSettings::Instance().getSpriteBatch() );
 
-    for( auto iter : m_pSpriteVec )
-        iter->render( camera );
+    if( spriteBatch )
+        CSpriteBatchMgr::Instance().begin();
+
+    if( cull( camera ) )
+    {
+        for( auto iter : m_visibleVec )
+            m_pSpriteVec[iter]->render( camera );
+    }
+    else
+    {
+        for( auto iter : m_pSpriteVec )
+            iter->render( camera );
+    }
+
+    if( spriteBatch )
+        CSpriteBatchMgr::Instance().end();
 }
 
 
@@ -473,7 +739,33 @@ iSprite * CBasicSpriteStrategy::getSprite( const int id )
             boost::str( boost::format("Requested sprite has not been created! (%d).\n\n%s\nLine: %s")
                 % id % __FUNCTION__ % __LINE__ ));
 
-    return iter->second;
+    return m_slotVec[iter->second].m_pSprite;
+}
+
+iSprite * CBasicSpriteStrategy::getSprite( const CSpriteHandle & handle ) const
+{
+    if( (handle.m_slot < m_slotVec.size()) && (m_slotVec[handle.m_slot].m_generation == handle.m_generation) )
+        return m_slotVec[handle.m_slot].m_pSprite;
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Get the handle of the sprite. Null handle if not found
+************************************************************************/
+CSpriteHandle CBasicSpriteStrategy::getHandle( const int id ) const
+{
+    CSpriteHandle handle;
+
+    auto iter = m_spriteMap.find( id );
+    if( iter != m_spriteMap.end() )
+    {
+        handle.m_slot = iter->second;
+        handle.m_generation = m_slotVec[iter->second].m_generation;
+    }
+
+    return handle;
 }
 
 
@@ -484,8 +776,57 @@ bool CBasicSpriteStrategy::find( iSprite * piSprite )
 {
     // See if this sprite has already been created
     auto iter = m_spriteMap.find( piSprite->getId() );
-    if( iter != m_spriteMap.end() && (iter->second == piSprite) )
+    if( iter != m_spriteMap.end() && (m_slotVec[iter->second].m_pSprite == piSprite) )
         return true;
 
     return false;
 }
+
+
+/************************************************************************
+ *    DESC:  Get the sprites that overlap the circle
+ *           Uses the spatial index when there is one. Safe to call from
+ *           the AI during the parallel update
+ ************************************************************************/
+void CBasicSpriteStrategy::findInRadius( const CPoint<float> & pos, float radius, std::vector<iSprite *> & spriteVec ) const
+{
+    if( m_upSpatialGrid )
+    {
+        // Each thread reuses it's own scratch vector
+        std::vector<uint32_t> & slotVec = m_querySlotVecVec[CThreadPool::Instance().getThreadIndex()];
+        slotVec.clear();
+        m_upSpatialGrid->queryRadius( pos, radius, slotVec );
+
+        for( auto iter : slotVec )
+            spriteVec.push_back( m_slotVec[iter].m_pSprite );
+    }
+    else
+    {
+        for( auto iter : m_pSpriteVec )
+        {
+            const float length = radius + std::max( iter->getRadius(), 0.f );
+
+            if( iter->getTransPos().getLengthSquared2D( pos ) < (length * length) )
+                spriteVec.push_back( iter );
+        }
+    }
+}
+
+
+/************************************************************************
+ *    DESC:  Allow this strategy to use the parallel sprite update/transform
+ ************************************************************************/
+void CBasicSpriteStrategy::allowParallel( bool allow )
+{
+    m_allowParallel = allow;
+}
+
+
+/************************************************************************
+ *    DESC:  Is the sprite list split across the thread pool
+ ************************************************************************/
+bool CBasicSpriteStrategy::useParallel( bool enabled ) const
+{
+    return enabled && m_allowParallel &&
+           (m_pSpriteVec.size() >= (size_t)CSettings::Instance().getParallelSpriteMinCount());
+}
@@ -16,6 +16,7 @@
 #include <common/defs.h>
 #include <common/worldvalue.h>
 #include <common/spritedatacontainer.h>
+#include <utilities/slaballocator.h>
 
 // Boost lib dependencies
 #include <boost/noncopyable.hpp>
@@ -24,11 +25,33 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
 
 // Forward Declarations
 class iSprite;
 class CSpriteDataContainer;
 class CMatrix;
+class CCamera;
+class CSpatialGrid2D;
+
+/************************************************************************
+*    desc:  Handle to a sprite of the strategy. Unlike a pointer, a handle
+*           to a deleted sprite is detected because the slot generation
+*           no longer matches.
+************************************************************************/
+class CSpriteHandle
+{
+public:
+
+    enum : uint32_t { NULL_SLOT = 0xFFFFFFFF };
+
+    bool isNull() const { return (m_slot == NULL_SLOT); }
+
+    uint32_t m_slot = NULL_SLOT;
+    uint32_t m_generation = 0;
+};
 
 class CBasicSpriteStrategy : public CBaseStrategy, boost::noncopyable
 {
@@ -84,15 +107,36 @@ public:
         return *dynamic_cast<target *>(getSprite( id ));
     }
     
+    // Get the pointer to the sprite. nullptr if it has been deleted
+    template<typename target>
+    target * get( const CSpriteHandle & handle )
+    {
+        return dynamic_cast<target *>(getSprite( handle ));
+    }
+    
+    // Get the handle of the sprite. Null handle if not found
+    CSpriteHandle getHandle( const int id ) const;
+    
+    // Get the pointer to the sprite. nullptr if it has been deleted
+    iSprite * getSprite( const CSpriteHandle & handle ) const;
+    
     // Find if the sprite exists
     bool find( iSprite * piSprite );
     
+    // Get the sprites that overlap the circle. Positions are from the last transform
+    void findInRadius( const CPoint<float> & pos, float radius, std::vector<iSprite *> & spriteVec ) const;
+    
+    // Allow this strategy to use the parallel sprite update/transform
+    // For strategies whose AI is not safe to run on a worker thread
+    void allowParallel( bool allow );
+    
     // Get the sprite data by name
     CSpriteDataContainer & getData( const std::string & name );
 
 protected:
     
     // Handle the deleting of any sprites
+    void handleDelete() override;
     void deleteObj( int index ) override;
     
     // Handle the creating of any object by name
@@ -100,17 +144,83 @@ protected:
     
     // Get the pointer to the sprite
     iSprite * getSprite( const int id );
+    
+    // Is the sprite list split across the thread pool
+    bool useParallel( bool enabled ) const;
+
+private:
+    
+    // Allocate the sprite from the pool of it's sprite data
+    iSprite * createFromData( const std::string & dataName, std::string & aiName );
+    
+    // Allocate the sprite from the object data
+    iSprite * createFromObjectData( const std::string & group, const std::string & name );
+    
+    // Throw if the sprite id is already used
+    void checkDuplicateId( int spriteId, const std::string & name ) const;
+    
+    // Add the sprite to a slot and the end of the draw list
+    void addSprite( iSprite * pSprite, CSlabAllocator * pPool );
+    
+    // Destroy the sprite and free it's slot
+    void freeSlot( uint32_t slotIndex );
+    
+    // Close up the holes left in the draw list by the deleted sprites
+    void compactSpriteVec();
+    
+    // Move the sprites in the spatial index to their transformed position
+    void updateSpatialIndex();
+    
+    // Get the draw indexes of the sprites in view of the camera
+    bool cull( const CCamera & camera );
 
 protected:
     
     // Map of the sprite data
     std::map<const std::string, CSpriteDataContainer> m_dataMap;
+    
+    // Pool of each sprite data the sprites are allocated from
+    std::map<const std::string, CSlabAllocator> m_poolMap;
 
-    // Map of all the sprites
-    std::map<const int, iSprite *> m_spriteMap;
+    // Map of the sprite ids to their slot
+    std::unordered_map<int, uint32_t> m_spriteMap;
     
-    // Vector of iSprite pointers
+    // Vector of iSprite pointers in draw order
     std::vector<iSprite *> m_pSpriteVec;
+    
+    // Allow the parallel sprite update/transform
+    bool m_allowParallel;
+
+private:
+    
+    // Sprite slot. The generation is bumped each time the slot is freed
+    class CSpriteSlot
+    {
+    public:
+        iSprite * m_pSprite = nullptr;
+        CSlabAllocator * m_pPool = nullptr;
+        uint32_t m_drawIndex = 0;
+        uint32_t m_generation = 0;
+    };
+    
+    // The sprite slots and the free ones
+    std::vector<CSpriteSlot> m_slotVec;
+    std::vector<uint32_t> m_freeSlotVec;
+    
+    // Slot of each sprite in the draw list
+    std::vector<uint32_t> m_drawSlotVec;
+    
+    // Index of the first hole in the draw list
+    size_t m_firstHole;
+    
+    // Spatial index of the sprite slots. Only made when the sprite list sets a cell size
+    std::unique_ptr<CSpatialGrid2D> m_upSpatialGrid;
+    
+    // Draw indexes of the sprites in view
+    std::vector<uint32_t> m_visibleVec;
+    
+    // Slots found by the radius query. One per worker thread plus one for the main thread
+    mutable std::vector< std::vector<uint32_t> > m_querySlotVecVec;
 };
 
 #endif  // __basic_sprite_strategy_h__
@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <utilities/xmlParser.h>
 #include <managers/cameramanager.h>
+#include <utilities/profiler.h>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -92,6 +93,8 @@ void CBasicStageStrategy::cleanUp()
 ****************************************************************************/
 void CBasicStageStrategy::update()
 {
+    PROFILE_ZONE( "CBasicStageStrategy::update" );
+
     for( auto & iter : m_sectorDeq )
         iter.update();
 }
@@ -102,12 +105,16 @@ void CBasicStageStrategy::update()
 ************************************************************************/
 void CBasicStageStrategy::transform()
 {
+    PROFILE_ZONE( "CBasicStageStrategy::transform" );
+
     for( auto & iter : m_sectorDeq )
         iter.transform();
 }
 
 void CBasicStageStrategy::transform( const CObject2D & object )
 {
+    PROFILE_ZONE( "CBasicStageStrategy::transform" );
+
     for( auto & iter : m_sectorDeq )
         iter.transform( object );
 }
@@ -118,18 +125,24 @@ void CBasicStageStrategy::transform( const CObject2D & object )
 ****************************************************************************/
 void CBasicStageStrategy::render( const CMatrix & matrix )
 {
+    PROFILE_ZONE( "CBasicStageStrategy::render" );
+
     for( auto & iter : m_sectorDeq )
         iter.render( matrix );
 }
 
 void CBasicStageStrategy::render( const CMatrix & matrix, const CMatrix & rotMatrix )
 {
+    PROFILE_ZONE( "CBasicStageStrategy::render" );
+
     for( auto & iter : m_sectorDeq )
         iter.render( matrix, rotMatrix );
 }
 
 void CBasicStageStrategy::render()
 {
+    PROFILE_ZONE( "CBasicStageStrategy::render" );
+
     const auto & camera = CCameraMgr::Instance().getCamera( m_cameraId );
 
     for( auto & iter : m_sectorDeq )
@@ -13,6 +13,9 @@
 #include <utilities/deletefuncs.h>
 #include <strategy/istrategy.h>
 #include <utilities/exceptionhandling.h>
+#include <utilities/profiler.h>
+#include <utilities/settings.h>
+#include <common/transformstore.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -216,6 +219,8 @@ void CStrategyMgr::miscProcess()
 ****************************************************************************/
 void CStrategyMgr::update()
 {
+    PROFILE_ZONE( "CStrategyMgr::update" );
+
     for( auto iter : m_pStrategyVec )
         iter->update();
 }
@@ -226,12 +231,24 @@ void CStrategyMgr::update()
 ************************************************************************/
 void CStrategyMgr::transform()
 {
+    PROFILE_ZONE( "CStrategyMgr::transform" );
+
+    // Make the sprite matrices in one pass. The sprites then keep them
+    if( CSettings::Instance().getBatchTransform() )
+        CTransformStore::Instance().transform2D();
+
     for( auto iter : m_pStrategyVec )
         iter->transform();
 }
 
 void CStrategyMgr::transform( const CObject2D & object )
 {
+    PROFILE_ZONE( "CStrategyMgr::transform" );
+
+    // Make the local sprite matrices in one pass. The sprites then apply the parent
+    if( CSettings::Instance().getBatchTransform() )
+        CTransformStore::Instance().transform2D();
+
     for( auto iter : m_pStrategyVec )
         iter->transform( object );
 }
@@ -242,18 +259,24 @@ void CStrategyMgr::transform( const CObject2D & object )
 ****************************************************************************/
 void CStrategyMgr::render()
 {
+    PROFILE_ZONE( "CStrategyMgr::render" );
+
     for( auto iter : m_pStrategyVec )
         iter->render();
 }
 
 void CStrategyMgr::render( const CMatrix & matrix )
 {
+    PROFILE_ZONE( "CStrategyMgr::render" );
+
     for( auto iter : m_pStrategyVec )
         iter->render( matrix );
 }
 
 void CStrategyMgr::render( const CMatrix & matrix, const CMatrix & rotMatrix )
 {
+    PROFILE_ZONE( "CStrategyMgr::render" );
+
     for( auto iter : m_pStrategyVec )
         iter->render( matrix, rotMatrix );
 }
@@ -19,16 +19,23 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/settings.h>
 #include <utilities/highresolutiontimer.h>
+#include <utilities/fixedstep.h>
 #include <utilities/statcounter.h>
+#include <utilities/profiler.h>
+#include <utilities/genfunc.h>
 #include <system/device.h>
+#include <system/replay.h>
+#include <system/renderdevice.h>
 #include <managers/shadermanager.h>
 #include <managers/texturemanager.h>
 #include <managers/vertexbuffermanager.h>
 #include <managers/meshmanager.h>
 #include <common/build_defs.h>
+#include <script/scriptmanager.h>
 
 // Standard lib dependencies
 #include <stdio.h>
+#include <cstdlib>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -47,6 +54,33 @@ CBaseGame::CBaseGame()
 ************************************************************************/
 CBaseGame::~CBaseGame()
 {
+    // Close the replay file and print the play back timing
+    CReplay::Instance().stop();
+
+    // Print the render counts of a headless run
+    if( CRenderDevice::Instance().isHeadless() )
+    {
+        const CRenderStats & stats = CRenderDevice::Instance().getTotalStats();
+
+        if( stats.m_frames > 0 )
+        {
+            const double frames = static_cast<double>(stats.m_frames);
+
+            printf( "Render: %llu frames, %.1f draw calls, %.1f indices, %.1f state changes, %.1f binds (%.1f redundant), %.1f uniforms per frame\n",
+                static_cast<unsigned long long>(stats.m_frames),
+                stats.m_drawCalls / frames,
+                stats.m_indices / frames,
+                stats.m_stateChanges / frames,
+                (stats.m_bufferBinds + stats.m_textureBinds + stats.m_programBinds) / frames,
+                stats.m_redundantBinds / frames,
+                stats.m_uniforms / frames );
+        }
+    }
+
+    // Save the profile zones still in the buffers
+    if( CProfiler::isEnabled() && !CSettings::Instance().getProfilerTraceFile().empty() )
+        CProfiler::Instance().exportChromeTrace( CSettings::Instance().getProfilerTraceFile() );
+
     // Destroy the window and OpenGL context
     CDevice::Instance().destroy();
 
@@ -77,27 +111,48 @@ void CBaseGame::create()
 ************************************************************************/
 void CBaseGame::init()
 {
+    // Start recording the profile zones
+    CProfiler::Instance().enable( CSettings::Instance().getProfilerEnable() );
+
+    // Init the fixed step of the game loop
+    CFixedStep::Instance().setTickRate(
+        CSettings::Instance().getTickRate(),
+        CSettings::Instance().getMaxStepsPerFrame() );
+
+    // Start recording or playing back the session
+    CReplay::Instance().start(
+        CSettings::Instance().getReplayMode(),
+        CSettings::Instance().getReplayFile(),
+        CSettings::Instance().getReplayRender() );
+
+    // Seed the random number generators so they can be played back
+    std::srand( CReplay::Instance().getSeed() );
+    NGenFunc::SeedRandom( CReplay::Instance().getSeed() );
+
     // Init the clear color
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    CRenderDevice::Instance().clearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     // Init the stencil clear mask based on the bit size of the mask
     // Stencil buffer can only be 1 or 8 bits per pixel
     if( CSettings::Instance().getStencilBufferBitSize() == 1 )
-        glStencilMask(0x1);
+        CRenderDevice::Instance().stencilMask(0x1);
     else if( CSettings::Instance().getStencilBufferBitSize() == 8 )
-        glStencilMask(0xff);
+        CRenderDevice::Instance().stencilMask(0xff);
 
     // Cull the back face
-    glFrontFace(GL_CCW);
-    glCullFace(GL_BACK);
-    glEnable(GL_CULL_FACE);
+    CRenderDevice::Instance().frontFace(GL_CCW);
+    CRenderDevice::Instance().cullFace(GL_BACK);
+    CRenderDevice::Instance().enable(GL_CULL_FACE);
 
     // Enable alpha blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CRenderDevice::Instance().enable(GL_BLEND);
+    CRenderDevice::Instance().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Make the zero texture the active texture
-    glActiveTexture(GL_TEXTURE0);
+    CRenderDevice::Instance().activeTexture(GL_TEXTURE0);
+
+    // This thread owns the context so it's the one that uploads the streamed textures
+    CTextureMgr::Instance().setRenderThread();
 
     // Init the clear buffer mask
     if( CSettings::Instance().getClearTargetBuffer() )
@@ -110,19 +165,19 @@ void CBaseGame::init()
         m_clearBufferMask |= GL_STENCIL_BUFFER_BIT;
 
     if( CSettings::Instance().getEnableDepthBuffer() )
-        glEnable( GL_DEPTH_TEST );
+        CRenderDevice::Instance().enable( GL_DEPTH_TEST );
 
     // Clear the back buffer and flip it prior to showing the window
     // Keeps us from seeing a flash or flicker of pre init junk
-    glClear( GL_COLOR_BUFFER_BIT );
-    SDL_GL_SwapWindow( m_pWindow );
+    CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
+    CRenderDevice::Instance().present();
 
     // Show the window
     CDevice::Instance().showWindow( true );
 
     // Display a black screen
-    glClear( GL_COLOR_BUFFER_BIT );
-    SDL_GL_SwapWindow( m_pWindow );
+    CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
+    CRenderDevice::Instance().present();
 }
 
 
@@ -134,12 +189,11 @@ void CBaseGame::pollEvents()
     // Event handler
     SDL_Event msgEvent;
 
-    // Handle events on queue
-    while( SDL_PollEvent( &msgEvent ) )
+    // let the game handle the event
+    // turns true on quit
+    auto handle = [this]( const SDL_Event & rEvent )
     {
-        // let the game handle the event
-        // turns true on quit
-        if( handleEvent( msgEvent ) )
+        if( handleEvent( rEvent ) )
         {
             // Stop the game
             m_gameRunning = false;
@@ -147,9 +201,16 @@ void CBaseGame::pollEvents()
             // Hide the window to give the impression of a quick exit
             CDevice::Instance().showWindow( false );
 
-            break;
+            return true;
         }
-    }
+
+        return false;
+    };
+
+    // Handle events on queue. Recorded or played back by the replay
+    while( CReplay::Instance().pollEvent( msgEvent ) )
+        if( handle( msgEvent ) )
+            break;
 }
 
 
@@ -158,37 +219,76 @@ void CBaseGame::pollEvents()
 ****************************************************************************/
 bool CBaseGame::gameLoop()
 {
+    CProfiler::Instance().beginFrame();
+    PROFILE_ZONE( "gameLoop" );
+
+    // Start of the frame for the frame limit
+    const uint64_t frameStart = CHighResTimer::Instance().getCounter();
+
+    // Start the frame's script time budget. The fixed steps of the frame share it
+    CScriptMgr::Instance().beginFrame();
+
+    // Begin the replay frame. The game stops when the play back runs out
+    if( !CReplay::Instance().beginFrame() )
+        stopGame();
+
     // Handle the state change
     doStateChange();
 
     // Poll for game events
-    pollEvents();
+    {
+        PROFILE_ZONE( "pollEvents" );
+        pollEvents();
+    }
 
-    // Get our elapsed time
+    // Get our elapsed time. Played back from the replay
     CHighResTimer::Instance().calcElapsedTime();
+    CReplay::Instance().syncElapsedTime();
 
     if( m_gameRunning )
     {
-        // Handle any misc processing before the real work is started
-        miscProcess();
-
-        // Handle the physics
-        physics();
-
-        // Update animations, Move sprites, Check for collision
-        update();
+        if( CFixedStep::Instance().isEnabled() )
+        {
+            // Use up the frame time in fixed steps. The game only
+            // sees the step time so it runs the same at any frame rate
+            const int steps = CFixedStep::Instance().addFrameTime( CHighResTimer::Instance().getElapsedTime() );
 
-        // Transform game objects
-        transform();
+            for( int i = 0; (i < steps) && m_gameRunning; ++i )
+            {
+                CFixedStep::Instance().beginStep();
+                CHighResTimer::Instance().setElapsedTime( CFixedStep::Instance().getStepTime() );
 
-        // Clear the buffers
-        glClear( m_clearBufferMask );
+                simulate();
+            }
+        }
+        else
+        {
+            simulate();
+        }
 
-        // Do the rendering
-        render();
+        // Transform game objects. Objects moved in the last step are
+        // transformed between their last two steps by the fixed step alpha
+        {
+            PROFILE_ZONE( "transform" );
+            transform();
+        }
 
-        // Do the back buffer swap
-        SDL_GL_SwapWindow( m_pWindow );
+        // A play back can skip rendering to only time the game
+        if( CReplay::Instance().isRendering() )
+        {
+            // Clear the buffers and do the rendering
+            {
+                PROFILE_ZONE( "render" );
+                CRenderDevice::Instance().clear( m_clearBufferMask );
+                render();
+            }
+
+            // Do the back buffer swap
+            {
+                PROFILE_ZONE( "swap" );
+                CRenderDevice::Instance().present();
+            }
+        }
 
         // Unbind everything after a round of rendering
         CShaderMgr::Instance().unbind();
@@ -198,12 +298,65 @@ bool CBaseGame::gameLoop()
         // Inc the cycle
         if( NBDefs::IsDebugMode() )
             CStatCounter::Instance().incCycle();
+
+        // Sleep off the rest of the frame
+        limitFrameRate( frameStart );
     }
 
     return m_gameRunning;
 }
 
 
+/***************************************************************************
+*   DESC:  Run a step of the game
+****************************************************************************/
+void CBaseGame::simulate()
+{
+    // Handle any misc processing before the real work is started
+    miscProcess();
+
+    // Handle the physics
+    {
+        PROFILE_ZONE( "physics" );
+        physics();
+    }
+
+    // Update animations, Move sprites, Check for collision
+    {
+        PROFILE_ZONE( "update" );
+        update();
+    }
+
+    // Sync point of any calls the parallel scripts queued outside of the sprite strategies
+    CScriptMgr::Instance().applyCommands();
+}
+
+
+/***************************************************************************
+*   DESC:  Sleep off the rest of the frame when the frame rate is limited
+*          Sleeps in whole milliseconds so the frame can run a hair
+*          short but the CPU isn't spun waiting
+****************************************************************************/
+void CBaseGame::limitFrameRate( uint64_t frameStart )
+{
+    const float frameLimit = CSettings::Instance().getFrameLimit();
+
+    if( frameLimit > 0.f )
+    {
+        const double frameTime =
+            CHighResTimer::Instance().toMilliseconds( CHighResTimer::Instance().getCounter() - frameStart );
+
+        const double sleepTime = (1000.0 / frameLimit) - frameTime;
+
+        if( sleepTime >= 1.0 )
+        {
+            PROFILE_ZONE( "frameLimit" );
+            SDL_Delay( static_cast<Uint32>(sleepTime) );
+        }
+    }
+}
+
+
 /***************************************************************************
 *   DESC:  Display error massage
 ****************************************************************************/
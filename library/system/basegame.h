@@ -74,6 +74,14 @@ protected:
     // Poll for game events
     void pollEvents();
 
+private:
+
+    // Run a step of the game
+    void simulate();
+
+    // Sleep off the rest of the frame when the frame rate is limited
+    void limitFrameRate( uint64_t frameStart );
+
 protected:
 
     // The window we'll be rendering to
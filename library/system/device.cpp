@@ -19,6 +19,7 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/settings.h>
 #include <utilities/genfunc.h>
+#include <system/renderdevice.h>
 #include <common/size.h>
 
 // Boost lib dependencies
@@ -65,16 +66,39 @@ void CDevice::destroy()
 
 /***************************************************************************
 *   DESC:  Create the window and OpenGL context
+*          Running headless with the null render device there's no
+*          window or context and video isn't initialized
  ****************************************************************************/
 void CDevice::create()
 {
     // Initialize SDL - The File I/O and Threading subsystems are initialized by default.
-    if( SDL_Init( SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER | SDL_INIT_TIMER ) < 0 )
+    // Video is initialized after the settings are loaded unless the settings need it
+    uint32_t flags( SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER | SDL_INIT_TIMER );
+
+    #if defined(__IOS__) || defined(__ANDROID__)
+    // The settings get the display size
+    flags |= SDL_INIT_VIDEO;
+    #endif
+
+    if( SDL_Init( flags ) < 0 )
         throw NExcept::CCriticalException("SDL could not initialize!", SDL_GetError() );
 
     // All file I/O is handled by SDL and SDL_Init must be called before doing any I/O.
     CSettings::Instance().loadXML();
 
+    if( CSettings::Instance().getRenderDevice() == NDefs::ERD_NULL )
+    {
+        CRenderDevice::Create( NDefs::ERD_NULL, nullptr );
+
+        // Init current gamepads plugged in at startup
+        initStartupGamepads();
+
+        return;
+    }
+
+    if( SDL_InitSubSystem( SDL_INIT_VIDEO ) < 0 )
+        throw NExcept::CCriticalException("SDL could not initialize video!", SDL_GetError() );
+
     // Use OpenGL 3.3 core
     SDL_GL_SetAttribute( SDL_GL_CONTEXT_MAJOR_VERSION, CSettings::Instance().getMajorVersion() );
     SDL_GL_SetAttribute( SDL_GL_CONTEXT_MINOR_VERSION, CSettings::Instance().getMinorVersion() );
@@ -97,6 +121,9 @@ void CDevice::create()
     if( m_context == nullptr )
         throw NExcept::CCriticalException("OpenGL context could not be created!", SDL_GetError() );
 
+    // Render to the window with OpenGL
+    CRenderDevice::Create( NDefs::ERD_OPENGL, m_pWindow );
+
     #if !(defined(__IOS__) || defined(__ANDROID__))
     #if !defined(__arm__)
     // Initialize GLEW
@@ -125,7 +152,7 @@ void CDevice::create()
 
     // Depth testing is off by default. Enable it?
     if( CSettings::Instance().getEnableDepthBuffer() )
-        glEnable(GL_DEPTH_TEST);
+        CRenderDevice::Instance().enable(GL_DEPTH_TEST);
 
     // Init current gamepads plugged in at startup
     initStartupGamepads();
@@ -137,6 +164,10 @@ void CDevice::create()
  ****************************************************************************/
 void CDevice::enableVSync( bool enable )
 {
+    // No window when headless
+    if( m_pWindow == nullptr )
+        return;
+
     if( SDL_GL_SetSwapInterval( (enable == true) ? 1 : 0 ) < 0 )
         NGenFunc::PostDebugMsg( boost::str( boost::format("Warning: Unable to set VSync! SDL GL Error: %s") % SDL_GetError() ) );
 }
@@ -147,6 +178,9 @@ void CDevice::enableVSync( bool enable )
  ****************************************************************************/
 void CDevice::showWindow( bool visible )
 {
+    if( m_pWindow == nullptr )
+        return;
+
     if( visible )
         SDL_ShowWindow( m_pWindow );
     else
@@ -159,6 +193,9 @@ void CDevice::showWindow( bool visible )
  ****************************************************************************/
 void CDevice::setFullScreen( bool fullscreen )
 {
+    if( m_pWindow == nullptr )
+        return;
+
     int flag(0);
 
     if( fullscreen )
@@ -0,0 +1,351 @@
+/************************************************************************
+*    FILE NAME:       glrenderdevice.cpp
+*
+*    DESCRIPTION:     OpenGL render device
+************************************************************************/
+
+#if defined(__IOS__) || defined(__ANDROID__) || defined(__arm__)
+#include "SDL_opengles2.h"
+#else
+#include <GL/glew.h>     // Glew dependencies (have to be defined first)
+#include <SDL_opengl.h>  // SDL/OpenGL lib dependencies
+#endif
+
+// Physical component dependency
+#include <system/glrenderdevice.h>
+
+// SOIL lib dependency
+#include <soil/SOIL.h>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CGLRenderDevice::CGLRenderDevice( SDL_Window * pWindow ) :
+    m_pWindow(pWindow)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CGLRenderDevice::~CGLRenderDevice()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Is the device headless
+************************************************************************/
+bool CGLRenderDevice::isHeadless() const
+{
+    return false;
+}
+
+
+/************************************************************************
+*    DESC:  Get the counts of the last frame presented and of all the frames
+************************************************************************/
+const CRenderStats & CGLRenderDevice::getFrameStats() const
+{
+    return m_frameStats;
+}
+
+const CRenderStats & CGLRenderDevice::getTotalStats() const
+{
+    return m_totalStats;
+}
+
+
+/************************************************************************
+*    DESC:  Swap the back buffer and end the frame
+************************************************************************/
+void CGLRenderDevice::present()
+{
+    SDL_GL_SwapWindow( m_pWindow );
+
+    m_frameStats.m_frames = 1;
+    ++m_totalStats.m_frames;
+}
+
+
+/************************************************************************
+*    DESC:  Render state
+************************************************************************/
+void CGLRenderDevice::enable( uint32_t cap )
+{
+    glEnable( cap );
+}
+
+void CGLRenderDevice::disable( uint32_t cap )
+{
+    glDisable( cap );
+}
+
+void CGLRenderDevice::colorMask( bool red, bool green, bool blue, bool alpha )
+{
+    glColorMask( red ? GL_TRUE : GL_FALSE, green ? GL_TRUE : GL_FALSE, blue ? GL_TRUE : GL_FALSE, alpha ? GL_TRUE : GL_FALSE );
+}
+
+void CGLRenderDevice::depthMask( bool flag )
+{
+    glDepthMask( flag ? GL_TRUE : GL_FALSE );
+}
+
+void CGLRenderDevice::stencilFunc( uint32_t func, int32_t ref, uint32_t mask )
+{
+    glStencilFunc( func, ref, mask );
+}
+
+void CGLRenderDevice::stencilOp( uint32_t sfail, uint32_t dpfail, uint32_t dppass )
+{
+    glStencilOp( sfail, dpfail, dppass );
+}
+
+void CGLRenderDevice::stencilMask( uint32_t mask )
+{
+    glStencilMask( mask );
+}
+
+void CGLRenderDevice::blendFunc( uint32_t sfactor, uint32_t dfactor )
+{
+    glBlendFunc( sfactor, dfactor );
+}
+
+void CGLRenderDevice::frontFace( uint32_t mode )
+{
+    glFrontFace( mode );
+}
+
+void CGLRenderDevice::cullFace( uint32_t mode )
+{
+    glCullFace( mode );
+}
+
+void CGLRenderDevice::activeTexture( uint32_t texture )
+{
+    glActiveTexture( texture );
+}
+
+void CGLRenderDevice::viewport( int32_t x, int32_t y, int32_t width, int32_t height )
+{
+    glViewport( x, y, width, height );
+}
+
+void CGLRenderDevice::clearColor( float red, float green, float blue, float alpha )
+{
+    glClearColor( red, green, blue, alpha );
+}
+
+void CGLRenderDevice::clear( uint32_t mask )
+{
+    glClear( mask );
+}
+
+int32_t CGLRenderDevice::getInteger( uint32_t pname )
+{
+    GLint value(0);
+    glGetIntegerv( pname, &value );
+
+    return value;
+}
+
+uint32_t CGLRenderDevice::getError()
+{
+    return glGetError();
+}
+
+
+/************************************************************************
+*    DESC:  Buffers
+************************************************************************/
+uint32_t CGLRenderDevice::genBuffer()
+{
+    GLuint buffer(0);
+    glGenBuffers( 1, &buffer );
+
+    return buffer;
+}
+
+void CGLRenderDevice::deleteBuffer( uint32_t buffer )
+{
+    glDeleteBuffers( 1, &buffer );
+}
+
+void CGLRenderDevice::bindBuffer( uint32_t target, uint32_t buffer )
+{
+    glBindBuffer( target, buffer );
+}
+
+void CGLRenderDevice::bufferData( uint32_t target, size_t size, const void * pData, uint32_t usage )
+{
+    glBufferData( target, size, pData, usage );
+}
+
+void CGLRenderDevice::bufferSubData( uint32_t target, size_t offset, size_t size, const void * pData )
+{
+    glBufferSubData( target, offset, size, pData );
+}
+
+
+/************************************************************************
+*    DESC:  Vertex attributes
+************************************************************************/
+void CGLRenderDevice::enableVertexAttribArray( uint32_t index )
+{
+    glEnableVertexAttribArray( index );
+}
+
+void CGLRenderDevice::disableVertexAttribArray( uint32_t index )
+{
+    glDisableVertexAttribArray( index );
+}
+
+void CGLRenderDevice::vertexAttribPointer(
+    uint32_t index, int32_t size, uint32_t type, bool normalized, int32_t stride, size_t offset )
+{
+    glVertexAttribPointer( index, size, type, normalized ? GL_TRUE : GL_FALSE, stride, (GLvoid*)offset );
+}
+
+
+/************************************************************************
+*    DESC:  Draw the indices of the bound index buffer
+************************************************************************/
+void CGLRenderDevice::drawElements( uint32_t mode, int32_t count, uint32_t type )
+{
+    glDrawElements( mode, count, type, nullptr );
+}
+
+
+/************************************************************************
+*    DESC:  Textures
+************************************************************************/
+uint32_t CGLRenderDevice::createTexture( const unsigned char * pData, int width, int height, int channels, bool compressed )
+{
+    return SOIL_create_OGL_texture(
+        pData,
+        width,
+        height,
+        channels,
+        SOIL_CREATE_NEW_ID,
+        (compressed == true) ? SOIL_FLAG_COMPRESS_TO_DXT : SOIL_FLAG_ORIGINAL_TEXTURE_FORMAT );
+}
+
+void CGLRenderDevice::deleteTexture( uint32_t texture )
+{
+    glDeleteTextures( 1, &texture );
+}
+
+void CGLRenderDevice::bindTexture( uint32_t target, uint32_t texture )
+{
+    glBindTexture( target, texture );
+}
+
+void CGLRenderDevice::texParameter( uint32_t target, uint32_t pname, int32_t param )
+{
+    glTexParameteri( target, pname, param );
+}
+
+
+/************************************************************************
+*    DESC:  Shaders
+************************************************************************/
+uint32_t CGLRenderDevice::createShader( uint32_t type )
+{
+    return glCreateShader( type );
+}
+
+void CGLRenderDevice::deleteShader( uint32_t shader )
+{
+    glDeleteShader( shader );
+}
+
+void CGLRenderDevice::shaderSource( uint32_t shader, const char * pSource )
+{
+    glShaderSource( shader, 1, &pSource, nullptr );
+}
+
+void CGLRenderDevice::compileShader( uint32_t shader )
+{
+    glCompileShader( shader );
+}
+
+int32_t CGLRenderDevice::getShader( uint32_t shader, uint32_t pname )
+{
+    GLint value(0);
+    glGetShaderiv( shader, pname, &value );
+
+    return value;
+}
+
+void CGLRenderDevice::getShaderInfoLog( uint32_t shader, int32_t bufSize, int32_t * pLength, char * pInfoLog )
+{
+    glGetShaderInfoLog( shader, bufSize, pLength, pInfoLog );
+}
+
+uint32_t CGLRenderDevice::createProgram()
+{
+    return glCreateProgram();
+}
+
+void CGLRenderDevice::deleteProgram( uint32_t program )
+{
+    glDeleteProgram( program );
+}
+
+void CGLRenderDevice::attachShader( uint32_t program, uint32_t shader )
+{
+    glAttachShader( program, shader );
+}
+
+void CGLRenderDevice::detachShader( uint32_t program, uint32_t shader )
+{
+    glDetachShader( program, shader );
+}
+
+void CGLRenderDevice::bindAttribLocation( uint32_t program, uint32_t index, const char * pName )
+{
+    glBindAttribLocation( program, index, pName );
+}
+
+void CGLRenderDevice::linkProgram( uint32_t program )
+{
+    glLinkProgram( program );
+}
+
+int32_t CGLRenderDevice::getProgram( uint32_t program, uint32_t pname )
+{
+    GLint value(0);
+    glGetProgramiv( program, pname, &value );
+
+    return value;
+}
+
+int32_t CGLRenderDevice::getUniformLocation( uint32_t program, const char * pName )
+{
+    return glGetUniformLocation( program, pName );
+}
+
+void CGLRenderDevice::useProgram( uint32_t program )
+{
+    glUseProgram( program );
+}
+
+
+/************************************************************************
+*    DESC:  Uniforms of the program in use
+************************************************************************/
+void CGLRenderDevice::uniform1i( int32_t location, int32_t value )
+{
+    glUniform1i( location, value );
+}
+
+void CGLRenderDevice::uniform4fv( int32_t location, int32_t count, const float * pValue )
+{
+    glUniform4fv( location, count, pValue );
+}
+
+void CGLRenderDevice::uniformMatrix4fv( int32_t location, int32_t count, bool transpose, const float * pValue )
+{
+    glUniformMatrix4fv( location, count, transpose ? GL_TRUE : GL_FALSE, pValue );
+}
@@ -0,0 +1,150 @@
+/************************************************************************
+*    FILE NAME:       irenderdevice.h
+*
+*    DESCRIPTION:     Render device interface
+*                     All the rendering goes through the device so the
+*                     game can run with OpenGL or headless with a device
+*                     that only records the handles and calls.
+*                     The enums and constants are the OpenGL ones.
+************************************************************************/
+
+#ifndef __i_render_device_h__
+#define __i_render_device_h__
+
+// Standard lib dependencies
+#include <cstdint>
+#include <cstddef>
+
+// Counts of the render calls
+class CRenderStats
+{
+public:
+
+    CRenderStats() :
+        m_frames(0),
+        m_drawCalls(0),
+        m_indices(0),
+        m_stateChanges(0),
+        m_bufferBinds(0),
+        m_textureBinds(0),
+        m_programBinds(0),
+        m_redundantBinds(0),
+        m_uniforms(0),
+        m_bufferUploadBytes(0),
+        m_textureUploadBytes(0)
+    {}
+
+    // Add the counts of another
+    void add( const CRenderStats & stats )
+    {
+        m_frames += stats.m_frames;
+        m_drawCalls += stats.m_drawCalls;
+        m_indices += stats.m_indices;
+        m_stateChanges += stats.m_stateChanges;
+        m_bufferBinds += stats.m_bufferBinds;
+        m_textureBinds += stats.m_textureBinds;
+        m_programBinds += stats.m_programBinds;
+        m_redundantBinds += stats.m_redundantBinds;
+        m_uniforms += stats.m_uniforms;
+        m_bufferUploadBytes += stats.m_bufferUploadBytes;
+        m_textureUploadBytes += stats.m_textureUploadBytes;
+    }
+
+    uint64_t m_frames;
+    uint64_t m_drawCalls;
+    uint64_t m_indices;
+    uint64_t m_stateChanges;
+    uint64_t m_bufferBinds;
+    uint64_t m_textureBinds;
+    uint64_t m_programBinds;
+
+    // Binds of the handle already bound
+    uint64_t m_redundantBinds;
+
+    uint64_t m_uniforms;
+    uint64_t m_bufferUploadBytes;
+    uint64_t m_textureUploadBytes;
+};
+
+class iRenderDevice
+{
+public:
+
+    // Destructor
+    virtual ~iRenderDevice(){}
+
+    // Is the device headless
+    virtual bool isHeadless() const = 0;
+
+    // Get the counts of the last frame presented and of all the frames.
+    // Only counted by a recording device
+    virtual const CRenderStats & getFrameStats() const = 0;
+    virtual const CRenderStats & getTotalStats() const = 0;
+
+    // Swap the back buffer and end the frame
+    virtual void present() = 0;
+
+    // Render state
+    virtual void enable( uint32_t cap ) = 0;
+    virtual void disable( uint32_t cap ) = 0;
+    virtual void colorMask( bool red, bool green, bool blue, bool alpha ) = 0;
+    virtual void depthMask( bool flag ) = 0;
+    virtual void stencilFunc( uint32_t func, int32_t ref, uint32_t mask ) = 0;
+    virtual void stencilOp( uint32_t sfail, uint32_t dpfail, uint32_t dppass ) = 0;
+    virtual void stencilMask( uint32_t mask ) = 0;
+    virtual void blendFunc( uint32_t sfactor, uint32_t dfactor ) = 0;
+    virtual void frontFace( uint32_t mode ) = 0;
+    virtual void cullFace( uint32_t mode ) = 0;
+    virtual void activeTexture( uint32_t texture ) = 0;
+    virtual void viewport( int32_t x, int32_t y, int32_t width, int32_t height ) = 0;
+    virtual void clearColor( float red, float green, float blue, float alpha ) = 0;
+    virtual void clear( uint32_t mask ) = 0;
+    virtual int32_t getInteger( uint32_t pname ) = 0;
+    virtual uint32_t getError() = 0;
+
+    // Buffers
+    virtual uint32_t genBuffer() = 0;
+    virtual void deleteBuffer( uint32_t buffer ) = 0;
+    virtual void bindBuffer( uint32_t target, uint32_t buffer ) = 0;
+    virtual void bufferData( uint32_t target, size_t size, const void * pData, uint32_t usage ) = 0;
+    virtual void bufferSubData( uint32_t target, size_t offset, size_t size, const void * pData ) = 0;
+
+    // Vertex attributes
+    virtual void enableVertexAttribArray( uint32_t index ) = 0;
+    virtual void disableVertexAttribArray( uint32_t index ) = 0;
+    virtual void vertexAttribPointer(
+        uint32_t index, int32_t size, uint32_t type, bool normalized, int32_t stride, size_t offset ) = 0;
+
+    // Draw the indices of the bound index buffer
+    virtual void drawElements( uint32_t mode, int32_t count, uint32_t type ) = 0;
+
+    // Textures. The image data is uploaded as a new 2D texture
+    virtual uint32_t createTexture( const unsigned char * pData, int width, int height, int channels, bool compressed ) = 0;
+    virtual void deleteTexture( uint32_t texture ) = 0;
+    virtual void bindTexture( uint32_t target, uint32_t texture ) = 0;
+    virtual void texParameter( uint32_t target, uint32_t pname, int32_t param ) = 0;
+
+    // Shaders
+    virtual uint32_t createShader( uint32_t type ) = 0;
+    virtual void deleteShader( uint32_t shader ) = 0;
+    virtual void shaderSource( uint32_t shader, const char * pSource ) = 0;
+    virtual void compileShader( uint32_t shader ) = 0;
+    virtual int32_t getShader( uint32_t shader, uint32_t pname ) = 0;
+    virtual void getShaderInfoLog( uint32_t shader, int32_t bufSize, int32_t * pLength, char * pInfoLog ) = 0;
+    virtual uint32_t createProgram() = 0;
+    virtual void deleteProgram( uint32_t program ) = 0;
+    virtual void attachShader( uint32_t program, uint32_t shader ) = 0;
+    virtual void detachShader( uint32_t program, uint32_t shader ) = 0;
+    virtual void bindAttribLocation( uint32_t program, uint32_t index, const char * pName ) = 0;
+    virtual void linkProgram( uint32_t program ) = 0;
+    virtual int32_t getProgram( uint32_t program, uint32_t pname ) = 0;
+    virtual int32_t getUniformLocation( uint32_t program, const char * pName ) = 0;
+    virtual void useProgram( uint32_t program ) = 0;
+
+    // Uniforms of the program in use
+    virtual void uniform1i( int32_t location, int32_t value ) = 0;
+    virtual void uniform4fv( int32_t location, int32_t count, const float * pValue ) = 0;
+    virtual void uniformMatrix4fv( int32_t location, int32_t count, bool transpose, const float * pValue ) = 0;
+};
+
+#endif  // __i_render_device_h__
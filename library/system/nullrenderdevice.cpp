@@ -0,0 +1,522 @@
+/************************************************************************
+*    FILE NAME:       nullrenderdevice.cpp
+*
+*    DESCRIPTION:     Headless render device
+*                     Nothing is drawn. The buffer, texture and shader
+*                     handles are tracked in memory and the draw calls
+*                     and state changes are counted so the game can be
+*                     run and benchmarked without a GPU. Using a handle
+*                     that was never created or is already deleted is
+*                     an error the same as a bad index buffer draw.
+************************************************************************/
+
+#if defined(__IOS__) || defined(__ANDROID__) || defined(__arm__)
+#include "SDL_opengles2.h"
+#else
+#include <GL/glew.h>     // Glew dependencies (have to be defined first)
+#include <SDL_opengl.h>  // SDL/OpenGL lib dependencies
+#endif
+
+// Physical component dependency
+#include <system/nullrenderdevice.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+namespace
+{
+    // Largest texture size reported
+    const int32_t MAX_TEXTURE_SIZE = 8192;
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CNullRenderDevice::CNullRenderDevice() :
+    m_nextHandle(1),
+    m_arrayBuffer(0),
+    m_elementBuffer(0),
+    m_texture(0),
+    m_program(0)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CNullRenderDevice::~CNullRenderDevice()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Is the device headless
+************************************************************************/
+bool CNullRenderDevice::isHeadless() const
+{
+    return true;
+}
+
+
+/************************************************************************
+*    DESC:  Get the counts of the last frame presented and of all the frames
+************************************************************************/
+const CRenderStats & CNullRenderDevice::getFrameStats() const
+{
+    return m_frameStats;
+}
+
+const CRenderStats & CNullRenderDevice::getTotalStats() const
+{
+    return m_totalStats;
+}
+
+
+/************************************************************************
+*    DESC:  End the frame. The counts start over for the next one
+************************************************************************/
+void CNullRenderDevice::present()
+{
+    m_stats.m_frames = 1;
+    m_totalStats.add( m_stats );
+    m_frameStats = m_stats;
+    m_stats = CRenderStats();
+}
+
+
+/************************************************************************
+*    DESC:  Render state. Only counted
+************************************************************************/
+void CNullRenderDevice::enable( uint32_t cap )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::disable( uint32_t cap )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::colorMask( bool red, bool green, bool blue, bool alpha )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::depthMask( bool flag )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::stencilFunc( uint32_t func, int32_t ref, uint32_t mask )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::stencilOp( uint32_t sfail, uint32_t dpfail, uint32_t dppass )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::stencilMask( uint32_t mask )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::blendFunc( uint32_t sfactor, uint32_t dfactor )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::frontFace( uint32_t mode )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::cullFace( uint32_t mode )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::activeTexture( uint32_t texture )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::viewport( int32_t x, int32_t y, int32_t width, int32_t height )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::clearColor( float red, float green, float blue, float alpha )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::clear( uint32_t mask )
+{
+}
+
+int32_t CNullRenderDevice::getInteger( uint32_t pname )
+{
+    if( pname == GL_MAX_TEXTURE_SIZE )
+        return MAX_TEXTURE_SIZE;
+
+    return 0;
+}
+
+uint32_t CNullRenderDevice::getError()
+{
+    return GL_NO_ERROR;
+}
+
+
+/************************************************************************
+*    DESC:  Buffers
+************************************************************************/
+uint32_t CNullRenderDevice::genBuffer()
+{
+    const uint32_t buffer = m_nextHandle++;
+    m_bufferMap.emplace( buffer, 0 );
+
+    return buffer;
+}
+
+void CNullRenderDevice::deleteBuffer( uint32_t buffer )
+{
+    // Like OpenGL, deleting zero or an unknown buffer is ignored
+    m_bufferMap.erase( buffer );
+
+    if( m_arrayBuffer == buffer )
+        m_arrayBuffer = 0;
+
+    if( m_elementBuffer == buffer )
+        m_elementBuffer = 0;
+}
+
+void CNullRenderDevice::bindBuffer( uint32_t target, uint32_t buffer )
+{
+    if( buffer != 0 )
+        checkHandle( m_bufferMap.find( buffer ) != m_bufferMap.end(), "buffer", buffer );
+
+    uint32_t & rBinding = getBinding( target );
+
+    if( rBinding == buffer )
+        ++m_stats.m_redundantBinds;
+
+    rBinding = buffer;
+    ++m_stats.m_bufferBinds;
+}
+
+void CNullRenderDevice::bufferData( uint32_t target, size_t size, const void * pData, uint32_t usage )
+{
+    const uint32_t buffer = getBinding( target );
+    checkHandle( buffer != 0, "bound buffer", buffer );
+
+    m_bufferMap[buffer] = size;
+
+    if( pData != nullptr )
+        m_stats.m_bufferUploadBytes += size;
+}
+
+void CNullRenderDevice::bufferSubData( uint32_t target, size_t offset, size_t size, const void * pData )
+{
+    const uint32_t buffer = getBinding( target );
+    checkHandle( buffer != 0, "bound buffer", buffer );
+
+    if( offset + size > m_bufferMap[buffer] )
+        throw NExcept::CCriticalException("Render Device Error!",
+            boost::str( boost::format("Buffer sub data is out of range (%d)(%d, %d, %d).\n\n%s\nLine: %s")
+                % buffer % offset % size % m_bufferMap[buffer] % __FUNCTION__ % __LINE__ ));
+
+    m_stats.m_bufferUploadBytes += size;
+}
+
+
+/************************************************************************
+*    DESC:  Vertex attributes
+************************************************************************/
+void CNullRenderDevice::enableVertexAttribArray( uint32_t index )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::disableVertexAttribArray( uint32_t index )
+{
+    ++m_stats.m_stateChanges;
+}
+
+void CNullRenderDevice::vertexAttribPointer(
+    uint32_t index, int32_t size, uint32_t type, bool normalized, int32_t stride, size_t offset )
+{
+    checkHandle( m_arrayBuffer != 0, "bound vertex buffer", m_arrayBuffer );
+
+    ++m_stats.m_stateChanges;
+}
+
+
+/************************************************************************
+*    DESC:  Draw the indices of the bound index buffer
+*           The indices have to fit in the buffer
+************************************************************************/
+void CNullRenderDevice::drawElements( uint32_t mode, int32_t count, uint32_t type )
+{
+    checkHandle( m_elementBuffer != 0, "bound index buffer", m_elementBuffer );
+    checkHandle( m_program != 0, "program in use", m_program );
+
+    size_t indexSize = sizeof(uint16_t);
+    if( type == GL_UNSIGNED_BYTE )
+        indexSize = sizeof(uint8_t);
+    else if( type == GL_UNSIGNED_INT )
+        indexSize = sizeof(uint32_t);
+
+    if( (count < 0) || (static_cast<size_t>(count) * indexSize > m_bufferMap[m_elementBuffer]) )
+        throw NExcept::CCriticalException("Render Device Error!",
+            boost::str( boost::format("Draw is out of range of the index buffer (%d)(%d, %d).\n\n%s\nLine: %s")
+                % m_elementBuffer % count % m_bufferMap[m_elementBuffer] % __FUNCTION__ % __LINE__ ));
+
+    ++m_stats.m_drawCalls;
+    m_stats.m_indices += count;
+}
+
+
+/************************************************************************
+*    DESC:  Textures
+************************************************************************/
+uint32_t CNullRenderDevice::createTexture( const unsigned char * pData, int width, int height, int channels, bool compressed )
+{
+    if( pData == nullptr )
+        return 0;
+
+    const size_t size = static_cast<size_t>(width) * height * channels;
+    const uint32_t texture = m_nextHandle++;
+    m_textureMap.emplace( texture, size );
+
+    // Creating the texture leaves it bound like SOIL does
+    m_texture = texture;
+    m_stats.m_textureUploadBytes += size;
+
+    return texture;
+}
+
+void CNullRenderDevice::deleteTexture( uint32_t texture )
+{
+    m_textureMap.erase( texture );
+
+    if( m_texture == texture )
+        m_texture = 0;
+}
+
+void CNullRenderDevice::bindTexture( uint32_t target, uint32_t texture )
+{
+    if( texture != 0 )
+        checkHandle( m_textureMap.find( texture ) != m_textureMap.end(), "texture", texture );
+
+    if( m_texture == texture )
+        ++m_stats.m_redundantBinds;
+
+    m_texture = texture;
+    ++m_stats.m_textureBinds;
+}
+
+void CNullRenderDevice::texParameter( uint32_t target, uint32_t pname, int32_t param )
+{
+    checkHandle( m_texture != 0, "bound texture", m_texture );
+
+    ++m_stats.m_stateChanges;
+}
+
+
+/************************************************************************
+*    DESC:  Shaders. They always compile and link
+************************************************************************/
+uint32_t CNullRenderDevice::createShader( uint32_t type )
+{
+    const uint32_t shader = m_nextHandle++;
+    m_shaderSet.insert( shader );
+
+    return shader;
+}
+
+void CNullRenderDevice::deleteShader( uint32_t shader )
+{
+    m_shaderSet.erase( shader );
+}
+
+void CNullRenderDevice::shaderSource( uint32_t shader, const char * pSource )
+{
+    checkHandle( m_shaderSet.find( shader ) != m_shaderSet.end(), "shader", shader );
+}
+
+void CNullRenderDevice::compileShader( uint32_t shader )
+{
+    checkHandle( m_shaderSet.find( shader ) != m_shaderSet.end(), "shader", shader );
+}
+
+int32_t CNullRenderDevice::getShader( uint32_t shader, uint32_t pname )
+{
+    checkHandle( m_shaderSet.find( shader ) != m_shaderSet.end(), "shader", shader );
+
+    if( pname == GL_COMPILE_STATUS )
+        return GL_TRUE;
+
+    return 0;
+}
+
+void CNullRenderDevice::getShaderInfoLog( uint32_t shader, int32_t bufSize, int32_t * pLength, char * pInfoLog )
+{
+    if( pLength != nullptr )
+        *pLength = 0;
+
+    if( (pInfoLog != nullptr) && (bufSize > 0) )
+        pInfoLog[0] = '\0';
+}
+
+uint32_t CNullRenderDevice::createProgram()
+{
+    const uint32_t program = m_nextHandle++;
+    m_programMap[program];
+
+    return program;
+}
+
+void CNullRenderDevice::deleteProgram( uint32_t program )
+{
+    m_programMap.erase( program );
+
+    if( m_program == program )
+        m_program = 0;
+}
+
+void CNullRenderDevice::attachShader( uint32_t program, uint32_t shader )
+{
+    checkHandle( m_programMap.find( program ) != m_programMap.end(), "program", program );
+    checkHandle( m_shaderSet.find( shader ) != m_shaderSet.end(), "shader", shader );
+}
+
+void CNullRenderDevice::detachShader( uint32_t program, uint32_t shader )
+{
+}
+
+void CNullRenderDevice::bindAttribLocation( uint32_t program, uint32_t index, const char * pName )
+{
+    checkHandle( m_programMap.find( program ) != m_programMap.end(), "program", program );
+}
+
+void CNullRenderDevice::linkProgram( uint32_t program )
+{
+    checkHandle( m_programMap.find( program ) != m_programMap.end(), "program", program );
+}
+
+int32_t CNullRenderDevice::getProgram( uint32_t program, uint32_t pname )
+{
+    checkHandle( m_programMap.find( program ) != m_programMap.end(), "program", program );
+
+    if( pname == GL_LINK_STATUS )
+        return GL_TRUE;
+
+    return 0;
+}
+
+int32_t CNullRenderDevice::getUniformLocation( uint32_t program, const char * pName )
+{
+    auto iter = m_programMap.find( program );
+    checkHandle( iter != m_programMap.end(), "program", program );
+
+    // Each new name of the program gets the next location
+    auto & rLocationMap = iter->second;
+    return rLocationMap.emplace( pName, static_cast<int32_t>(rLocationMap.size()) ).first->second;
+}
+
+void CNullRenderDevice::useProgram( uint32_t program )
+{
+    if( program != 0 )
+        checkHandle( m_programMap.find( program ) != m_programMap.end(), "program", program );
+
+    if( m_program == program )
+        ++m_stats.m_redundantBinds;
+
+    m_program = program;
+    ++m_stats.m_programBinds;
+}
+
+
+/************************************************************************
+*    DESC:  Uniforms of the program in use
+************************************************************************/
+void CNullRenderDevice::uniform1i( int32_t location, int32_t value )
+{
+    checkHandle( m_program != 0, "program in use", m_program );
+
+    ++m_stats.m_uniforms;
+}
+
+void CNullRenderDevice::uniform4fv( int32_t location, int32_t count, const float * pValue )
+{
+    checkHandle( m_program != 0, "program in use", m_program );
+
+    ++m_stats.m_uniforms;
+}
+
+void CNullRenderDevice::uniformMatrix4fv( int32_t location, int32_t count, bool transpose, const float * pValue )
+{
+    checkHandle( m_program != 0, "program in use", m_program );
+
+    ++m_stats.m_uniforms;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of live handles
+************************************************************************/
+size_t CNullRenderDevice::getBufferCount() const
+{
+    return m_bufferMap.size();
+}
+
+size_t CNullRenderDevice::getTextureCount() const
+{
+    return m_textureMap.size();
+}
+
+size_t CNullRenderDevice::getShaderCount() const
+{
+    return m_shaderSet.size();
+}
+
+size_t CNullRenderDevice::getProgramCount() const
+{
+    return m_programMap.size();
+}
+
+
+/************************************************************************
+*    DESC:  Get the buffer bound to the target
+************************************************************************/
+uint32_t & CNullRenderDevice::getBinding( uint32_t target )
+{
+    if( target == GL_ARRAY_BUFFER )
+        return m_arrayBuffer;
+
+    if( target == GL_ELEMENT_ARRAY_BUFFER )
+        return m_elementBuffer;
+
+    throw NExcept::CCriticalException("Render Device Error!",
+        boost::str( boost::format("Buffer target not supported (%d).\n\n%s\nLine: %s")
+            % target % __FUNCTION__ % __LINE__ ));
+}
+
+
+/************************************************************************
+*    DESC:  Throw if the handle isn't live
+************************************************************************/
+void CNullRenderDevice::checkHandle( bool live, const char * pType, uint32_t handle ) const
+{
+    if( !live )
+        throw NExcept::CCriticalException("Render Device Error!",
+            boost::str( boost::format("Invalid %s (%d).\n\n%s\nLine: %s")
+                % pType % handle % __FUNCTION__ % __LINE__ ));
+}
@@ -0,0 +1,149 @@
+/************************************************************************
+*    FILE NAME:       nullrenderdevice.h
+*
+*    DESCRIPTION:     Headless render device
+*                     Nothing is drawn. The buffer, texture and shader
+*                     handles are tracked in memory and the draw calls
+*                     and state changes are counted so the game can be
+*                     run and benchmarked without a GPU. Using a handle
+*                     that was never created or is already deleted is
+*                     an error the same as a bad index buffer draw.
+************************************************************************/
+
+#ifndef __null_render_device_h__
+#define __null_render_device_h__
+
+// Physical component dependency
+#include <system/irenderdevice.h>
+
+// Standard lib dependencies
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class CNullRenderDevice : public iRenderDevice
+{
+public:
+
+    // Constructor
+    CNullRenderDevice();
+
+    // Destructor
+    virtual ~CNullRenderDevice();
+
+    // Is the device headless
+    bool isHeadless() const override;
+
+    // Get the counts of the last frame presented and of all the frames
+    const CRenderStats & getFrameStats() const override;
+    const CRenderStats & getTotalStats() const override;
+
+    // Swap the back buffer and end the frame
+    void present() override;
+
+    // Render state
+    void enable( uint32_t cap ) override;
+    void disable( uint32_t cap ) override;
+    void colorMask( bool red, bool green, bool blue, bool alpha ) override;
+    void depthMask( bool flag ) override;
+    void stencilFunc( uint32_t func, int32_t ref, uint32_t mask ) override;
+    void stencilOp( uint32_t sfail, uint32_t dpfail, uint32_t dppass ) override;
+    void stencilMask( uint32_t mask ) override;
+    void blendFunc( uint32_t sfactor, uint32_t dfactor ) override;
+    void frontFace( uint32_t mode ) override;
+    void cullFace( uint32_t mode ) override;
+    void activeTexture( uint32_t texture ) override;
+    void viewport( int32_t x, int32_t y, int32_t width, int32_t height ) override;
+    void clearColor( float red, float green, float blue, float alpha ) override;
+    void clear( uint32_t mask ) override;
+    int32_t getInteger( uint32_t pname ) override;
+    uint32_t getError() override;
+
+    // Buffers
+    uint32_t genBuffer() override;
+    void deleteBuffer( uint32_t buffer ) override;
+    void bindBuffer( uint32_t target, uint32_t buffer ) override;
+    void bufferData( uint32_t target, size_t size, const void * pData, uint32_t usage ) override;
+    void bufferSubData( uint32_t target, size_t offset, size_t size, const void * pData ) override;
+
+    // Vertex attributes
+    void enableVertexAttribArray( uint32_t index ) override;
+    void disableVertexAttribArray( uint32_t index ) override;
+    void vertexAttribPointer(
+        uint32_t index, int32_t size, uint32_t type, bool normalized, int32_t stride, size_t offset ) override;
+
+    // Draw the indices of the bound index buffer
+    void drawElements( uint32_t mode, int32_t count, uint32_t type ) override;
+
+    // Textures
+    uint32_t createTexture( const unsigned char * pData, int width, int height, int channels, bool compressed ) override;
+    void deleteTexture( uint32_t texture ) override;
+    void bindTexture( uint32_t target, uint32_t texture ) override;
+    void texParameter( uint32_t target, uint32_t pname, int32_t param ) override;
+
+    // Shaders
+    uint32_t createShader( uint32_t type ) override;
+    void deleteShader( uint32_t shader ) override;
+    void shaderSource( uint32_t shader, const char * pSource ) override;
+    void compileShader( uint32_t shader ) override;
+    int32_t getShader( uint32_t shader, uint32_t pname ) override;
+    void getShaderInfoLog( uint32_t shader, int32_t bufSize, int32_t * pLength, char * pInfoLog ) override;
+    uint32_t createProgram() override;
+    void deleteProgram( uint32_t program ) override;
+    void attachShader( uint32_t program, uint32_t shader ) override;
+    void detachShader( uint32_t program, uint32_t shader ) override;
+    void bindAttribLocation( uint32_t program, uint32_t index, const char * pName ) override;
+    void linkProgram( uint32_t program ) override;
+    int32_t getProgram( uint32_t program, uint32_t pname ) override;
+    int32_t getUniformLocation( uint32_t program, const char * pName ) override;
+    void useProgram( uint32_t program ) override;
+
+    // Uniforms of the program in use
+    void uniform1i( int32_t location, int32_t value ) override;
+    void uniform4fv( int32_t location, int32_t count, const float * pValue ) override;
+    void uniformMatrix4fv( int32_t location, int32_t count, bool transpose, const float * pValue ) override;
+
+    // Get the number of live handles
+    size_t getBufferCount() const;
+    size_t getTextureCount() const;
+    size_t getShaderCount() const;
+    size_t getProgramCount() const;
+
+private:
+
+    // Get the buffer bound to the target
+    uint32_t & getBinding( uint32_t target );
+
+    // Throw if the handle isn't live
+    void checkHandle( bool live, const char * pType, uint32_t handle ) const;
+
+private:
+
+    // Next handle given out. Zero is never used like OpenGL
+    uint32_t m_nextHandle;
+
+    // Live buffers and their size in bytes
+    std::unordered_map<uint32_t, size_t> m_bufferMap;
+
+    // Live textures and their size in bytes
+    std::unordered_map<uint32_t, size_t> m_textureMap;
+
+    // Live shaders
+    std::unordered_set<uint32_t> m_shaderSet;
+
+    // Live programs and the locations given to their uniforms
+    std::unordered_map<uint32_t, std::unordered_map<std::string, int32_t>> m_programMap;
+
+    // The bound handles
+    uint32_t m_arrayBuffer;
+    uint32_t m_elementBuffer;
+    uint32_t m_texture;
+    uint32_t m_program;
+
+    // Counts of the frame being rendered, the last frame presented and all the frames
+    CRenderStats m_stats;
+    CRenderStats m_frameStats;
+    CRenderStats m_totalStats;
+};
+
+#endif  // __null_render_device_h__
@@ -0,0 +1,36 @@
+/************************************************************************
+*    FILE NAME:       renderdevice.cpp
+*
+*    DESCRIPTION:     Holds the render device everything renders with
+************************************************************************/
+
+// Physical component dependency
+#include <system/renderdevice.h>
+
+// Game lib dependencies
+#include <system/glrenderdevice.h>
+#include <system/nullrenderdevice.h>
+
+/************************************************************************
+*    DESC:  Create the render device of the type
+************************************************************************/
+void CRenderDevice::Create( NDefs::ERenderDevice type, SDL_Window * pWindow )
+{
+    if( type == NDefs::ERD_NULL )
+        Holder().reset( new CNullRenderDevice );
+    else
+        Holder().reset( new CGLRenderDevice( pWindow ) );
+}
+
+
+/************************************************************************
+*    DESC:  Get the pointer holding the render device
+*           The holder is never destroyed. The manager singletons delete
+*           their textures, buffers and shaders through the device in
+*           their destructors and static destruction order isn't known
+************************************************************************/
+std::unique_ptr<iRenderDevice> & CRenderDevice::Holder()
+{
+    static std::unique_ptr<iRenderDevice> * pUpDevice = new std::unique_ptr<iRenderDevice>( new CGLRenderDevice );
+    return *pUpDevice;
+}
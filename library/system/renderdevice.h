@@ -0,0 +1,39 @@
+/************************************************************************
+*    FILE NAME:       renderdevice.h
+*
+*    DESCRIPTION:     Holds the render device everything renders with
+************************************************************************/
+
+#ifndef __render_device_h__
+#define __render_device_h__
+
+// Game lib dependencies
+#include <system/irenderdevice.h>
+#include <common/defs.h>
+
+// SDL lib dependencies
+#include <SDL.h>
+
+// Standard lib dependencies
+#include <memory>
+
+class CRenderDevice
+{
+public:
+
+    // Get the render device. OpenGL until one is created
+    static iRenderDevice & Instance()
+    {
+        return *Holder();
+    }
+
+    // Create the render device of the type
+    static void Create( NDefs::ERenderDevice type, SDL_Window * pWindow );
+
+private:
+
+    // Get the pointer holding the render device
+    static std::unique_ptr<iRenderDevice> & Holder();
+};
+
+#endif  // __render_device_h__
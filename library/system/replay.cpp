@@ -0,0 +1,462 @@
+/************************************************************************
+*    FILE NAME:       replay.cpp
+*
+*    DESCRIPTION:     Records and plays back a game session
+*                     The input events, elapsed time and random seeds of
+*                     each frame are saved so a session can be played
+*                     back the same as it was recorded. The game's own
+*                     events are not saved, only their place among the
+*                     input events so they're handled in the same order.
+************************************************************************/
+
+// Physical component dependency
+#include <system/replay.h>
+
+// Game lib dependencies
+#include <utilities/highresolutiontimer.h>
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdio.h>
+
+namespace
+{
+    const char MAGIC[4] = { 'R', 'P', 'L', 'Y' };
+    const uint32_t VERSION = 1;
+
+    // Record types
+    const uint8_t FRAME_RECORD = 'F';
+    const uint8_t SEED_RECORD = 'S';
+
+    // Event kinds of a frame record
+    const uint8_t GAME_EVENT = 0;
+    const uint8_t INPUT_EVENT = 1;
+
+    /************************************************************************
+    *    DESC:  Read a value from the buffer
+    *
+    *    ret:   bool - false if the buffer is too short
+    ************************************************************************/
+    template <typename T>
+    bool Read( const std::vector<char> & buffer, size_t & pos, T & value )
+    {
+        if( pos + sizeof(T) > buffer.size() )
+            return false;
+
+        std::memcpy( &value, buffer.data() + pos, sizeof(T) );
+        pos += sizeof(T);
+
+        return true;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CReplay::CReplay() :
+    m_mode(NDefs::ERM_OFF),
+    m_render(true),
+    m_recordEventCount(0),
+    m_recordCountPos(0),
+    m_frameIndex(0),
+    m_eventIndex(0),
+    m_seedIndex(0),
+    m_startCounter(0),
+    m_frameCounter(0),
+    m_timedFrameCount(0),
+    m_maxFrameTime(0)
+{
+}
+
+
+/************************************************************************
+*    DESC:  Destructor
+************************************************************************/
+CReplay::~CReplay()
+{
+    stop();
+}
+
+
+/************************************************************************
+*    DESC:  Start recording to or playing back from the file
+************************************************************************/
+void CReplay::start( NDefs::EReplayMode mode, const std::string & filePath, bool render )
+{
+    stop();
+
+    if( mode == NDefs::ERM_RECORD )
+    {
+        m_scpFile.reset( SDL_RWFromFile( filePath.c_str(), "wb" ) );
+        if( m_scpFile.isNull() )
+            throw NExcept::CCriticalException("Replay Record Error!",
+                boost::str( boost::format("Replay file can't be created (%s).\n\n%s\nLine: %s")
+                    % filePath % __FUNCTION__ % __LINE__ ));
+
+        const uint32_t eventSize = sizeof(SDL_Event);
+
+        m_recordBuf.clear();
+        write( MAGIC, sizeof(MAGIC) );
+        write( &VERSION, sizeof(VERSION) );
+        write( &eventSize, sizeof(eventSize) );
+
+        SDL_RWwrite( m_scpFile.get(), m_recordBuf.data(), m_recordBuf.size(), 1 );
+        m_recordBuf.clear();
+    }
+    else if( mode == NDefs::ERM_PLAY )
+    {
+        load( filePath );
+    }
+
+    m_mode = mode;
+    m_render = render;
+}
+
+
+/************************************************************************
+*    DESC:  Stop recording or playing back
+*           The timing of the play back is printed for comparing runs
+************************************************************************/
+void CReplay::stop()
+{
+    if( (m_mode == NDefs::ERM_PLAY) && (m_timedFrameCount > 0) )
+    {
+        const double totalTime = CHighResTimer::Instance().toMilliseconds( m_frameCounter - m_startCounter );
+
+        printf( "Replay: %d frames, %.3f ms average, %.3f ms max\n",
+            static_cast<int>(m_timedFrameCount),
+            totalTime / static_cast<double>(m_timedFrameCount),
+            m_maxFrameTime );
+    }
+
+    m_scpFile.reset();
+    m_recordBuf.clear();
+    m_frameVec.clear();
+    m_eventVec.clear();
+    m_seedVec.clear();
+    m_frameIndex = 0;
+    m_eventIndex = 0;
+    m_seedIndex = 0;
+    m_timedFrameCount = 0;
+    m_maxFrameTime = 0;
+    m_mode = NDefs::ERM_OFF;
+}
+
+
+/************************************************************************
+*    DESC:  Load the file to play back
+************************************************************************/
+void CReplay::load( const std::string & filePath )
+{
+    std::vector<char> buffer;
+
+    NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( filePath.c_str(), "rb" ) );
+    if( !scpFile.isNull() )
+    {
+        const Sint64 size = SDL_RWseek( scpFile.get(), 0, RW_SEEK_END );
+        if( size > 0 )
+        {
+            buffer.resize( size );
+            SDL_RWseek( scpFile.get(), 0, RW_SEEK_SET );
+
+            if( SDL_RWread( scpFile.get(), buffer.data(), 1, size ) != static_cast<size_t>(size) )
+                buffer.clear();
+        }
+    }
+
+    size_t pos = 0;
+    char magic[sizeof(MAGIC)] = {};
+    uint32_t version(0), eventSize(0);
+
+    for( auto & iter : magic )
+        Read( buffer, pos, iter );
+
+    if( !Read( buffer, pos, version ) || !Read( buffer, pos, eventSize ) ||
+        (std::memcmp( magic, MAGIC, sizeof(MAGIC) ) != 0) ||
+        (version != VERSION) || (eventSize != sizeof(SDL_Event)) )
+        throw NExcept::CCriticalException("Replay Play Back Error!",
+            boost::str( boost::format("Replay file can't be loaded or is from a different build (%s).\n\n%s\nLine: %s")
+                % filePath % __FUNCTION__ % __LINE__ ));
+
+    // A record cut short by the game closing ends the play back
+    uint8_t type;
+    while( Read( buffer, pos, type ) )
+    {
+        if( type == FRAME_RECORD )
+        {
+            CFrame frame;
+            uint32_t count;
+            bool result = Read( buffer, pos, count );
+
+            frame.m_firstEvent = m_eventVec.size();
+            frame.m_eventCount = count;
+
+            for( uint32_t i = 0; result && (i < count); ++i )
+            {
+                uint8_t kind;
+                SDL_Event event;
+                event.type = SDL_FIRSTEVENT;
+
+                result = Read( buffer, pos, kind );
+
+                if( result && (kind == INPUT_EVENT) )
+                    result = Read( buffer, pos, event );
+
+                m_eventVec.push_back( event );
+            }
+
+            if( !result || !Read( buffer, pos, frame.m_elapsedTime ) )
+                break;
+
+            m_frameVec.push_back( frame );
+        }
+        else if( type == SEED_RECORD )
+        {
+            uint32_t seed;
+            if( !Read( buffer, pos, seed ) )
+                break;
+
+            m_seedVec.push_back( seed );
+        }
+        else
+        {
+            throw NExcept::CCriticalException("Replay Play Back Error!",
+                boost::str( boost::format("Replay file is corrupt (%s).\n\n%s\nLine: %s")
+                    % filePath % __FUNCTION__ % __LINE__ ));
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Begin a frame
+*
+*    ret:   bool - false when the play back has run out of frames
+************************************************************************/
+bool CReplay::beginFrame()
+{
+    if( m_mode == NDefs::ERM_RECORD )
+    {
+        // The event count is filled in when the frame is saved
+        m_recordBuf.clear();
+        m_recordEventCount = 0;
+
+        write( &FRAME_RECORD, sizeof(FRAME_RECORD) );
+        m_recordCountPos = m_recordBuf.size();
+        write( &m_recordEventCount, sizeof(m_recordEventCount) );
+    }
+    else if( m_mode == NDefs::ERM_PLAY )
+    {
+        const uint64_t counter = CHighResTimer::Instance().getCounter();
+
+        // Time the frame that just ended
+        if( m_frameIndex == 0 )
+        {
+            m_startCounter = m_frameCounter = counter;
+        }
+        else if( m_timedFrameCount < m_frameIndex )
+        {
+            m_maxFrameTime = std::max( m_maxFrameTime, CHighResTimer::Instance().toMilliseconds( counter - m_frameCounter ) );
+            m_frameCounter = counter;
+            ++m_timedFrameCount;
+        }
+
+        if( m_frameIndex == m_frameVec.size() )
+            return false;
+
+        m_eventIndex = m_frameVec[m_frameIndex].m_firstEvent;
+        ++m_frameIndex;
+    }
+
+    return true;
+}
+
+
+/************************************************************************
+*    DESC:  Save the frame's elapsed time or replace it with the saved one
+*           Recording saves the frame so it's called after the events
+*           have been polled
+************************************************************************/
+void CReplay::syncElapsedTime()
+{
+    if( m_mode == NDefs::ERM_RECORD )
+    {
+        const double elapsedTime = CHighResTimer::Instance().getElapsedTime();
+        write( &elapsedTime, sizeof(elapsedTime) );
+
+        std::memcpy( m_recordBuf.data() + m_recordCountPos, &m_recordEventCount, sizeof(m_recordEventCount) );
+
+        SDL_RWwrite( m_scpFile.get(), m_recordBuf.data(), m_recordBuf.size(), 1 );
+        m_recordBuf.clear();
+    }
+    else if( (m_mode == NDefs::ERM_PLAY) && (m_frameIndex > 0) )
+    {
+        CHighResTimer::Instance().setElapsedTime( m_frameVec[m_frameIndex - 1].m_elapsedTime );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Save the polled event
+*           Only the place of the game's own events is saved
+************************************************************************/
+void CReplay::recordEvent( const SDL_Event & event )
+{
+    if( m_mode == NDefs::ERM_RECORD )
+    {
+        if( IsInput( event ) )
+        {
+            write( &INPUT_EVENT, sizeof(INPUT_EVENT) );
+            write( &event, sizeof(event) );
+        }
+        else
+        {
+            write( &GAME_EVENT, sizeof(GAME_EVENT) );
+        }
+
+        ++m_recordEventCount;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the next event of the frame being played back
+*           The game's own events are taken from the queue in their
+*           saved place and the live input is dropped
+*
+*    ret:   bool - false when the frame has no more events
+************************************************************************/
+bool CReplay::getEvent( SDL_Event & event )
+{
+    if( (m_mode != NDefs::ERM_PLAY) || (m_frameIndex == 0) )
+        return false;
+
+    const CFrame & frame = m_frameVec[m_frameIndex - 1];
+
+    while( m_eventIndex < frame.m_firstEvent + frame.m_eventCount )
+    {
+        const SDL_Event & rEvent = m_eventVec[m_eventIndex++];
+
+        if( rEvent.type != SDL_FIRSTEVENT )
+        {
+            event = rEvent;
+            return true;
+        }
+
+        while( SDL_PollEvent( &event ) )
+            if( !IsInput( event ) )
+                return true;
+    }
+
+    return false;
+}
+
+
+/************************************************************************
+*    DESC:  Poll the next event. Use in place of SDL_PollEvent
+*           The events of the frame being played back come first.
+*           The live events are saved when recording and the live
+*           input is dropped when playing back
+*
+*    ret:   bool - false when there are no more events
+************************************************************************/
+bool CReplay::pollEvent( SDL_Event & event )
+{
+    if( getEvent( event ) )
+        return true;
+
+    while( SDL_PollEvent( &event ) )
+    {
+        if( (m_mode == NDefs::ERM_PLAY) && IsInput( event ) )
+            continue;
+
+        recordEvent( event );
+
+        return true;
+    }
+
+    return false;
+}
+
+
+/************************************************************************
+*    DESC:  Get a seed for a random number generator
+*           The seeds are played back in the order they were asked for
+************************************************************************/
+uint32_t CReplay::getSeed()
+{
+    if( m_mode == NDefs::ERM_PLAY )
+    {
+        if( m_seedIndex == m_seedVec.size() )
+            throw NExcept::CCriticalException("Replay Play Back Error!",
+                boost::str( boost::format("Play back asked for more seeds than were recorded (%d).\n\n%s\nLine: %s")
+                    % m_seedVec.size() % __FUNCTION__ % __LINE__ ));
+
+        return m_seedVec[m_seedIndex++];
+    }
+
+    const uint32_t seed = std::random_device{}();
+
+    if( m_mode == NDefs::ERM_RECORD )
+    {
+        char record[sizeof(SEED_RECORD) + sizeof(seed)];
+        std::memcpy( record, &SEED_RECORD, sizeof(SEED_RECORD) );
+        std::memcpy( record + sizeof(SEED_RECORD), &seed, sizeof(seed) );
+
+        SDL_RWwrite( m_scpFile.get(), record, sizeof(record), 1 );
+    }
+
+    return seed;
+}
+
+
+/************************************************************************
+*    DESC:  Add data to the record buffer
+************************************************************************/
+void CReplay::write( const void * pData, size_t size )
+{
+    const char * pChar = static_cast<const char *>(pData);
+    m_recordBuf.insert( m_recordBuf.end(), pChar, pChar + size );
+}
+
+
+/************************************************************************
+*    DESC:  Is the session being recorded or played back
+************************************************************************/
+bool CReplay::isRecording() const
+{
+    return (m_mode == NDefs::ERM_RECORD);
+}
+
+bool CReplay::isPlaying() const
+{
+    return (m_mode == NDefs::ERM_PLAY);
+}
+
+
+/************************************************************************
+*    DESC:  Is the play back rendered
+************************************************************************/
+bool CReplay::isRendering() const
+{
+    return (m_mode != NDefs::ERM_PLAY) || m_render;
+}
+
+
+/************************************************************************
+*    DESC:  Is the event input that's saved
+*           The window, keyboard, mouse, game pad and touch events.
+*           Quit is left live so a play back can be closed. System and
+*           drop events point to memory that won't be there when played back
+************************************************************************/
+bool CReplay::IsInput( const SDL_Event & event )
+{
+    return (event.type >= SDL_WINDOWEVENT) && (event.type < SDL_DROPFILE) && (event.type != SDL_SYSWMEVENT);
+}
@@ -0,0 +1,129 @@
+/************************************************************************
+*    FILE NAME:       replay.h
+*
+*    DESCRIPTION:     Records and plays back a game session
+*                     The input events, elapsed time and random seeds of
+*                     each frame are saved so a session can be played
+*                     back the same as it was recorded. The game's own
+*                     events are not saved, only their place among the
+*                     input events so they're handled in the same order.
+************************************************************************/
+
+#ifndef __replay_h__
+#define __replay_h__
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <utilities/smartpointers.h>
+
+// SDL lib dependencies
+#include <SDL.h>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CReplay
+{
+public:
+
+    // Get the instance of the singleton class
+    static CReplay & Instance()
+    {
+        static CReplay replay;
+        return replay;
+    }
+
+    // Start recording to or playing back from the file
+    void start( NDefs::EReplayMode mode, const std::string & filePath, bool render = true );
+
+    // Stop recording or playing back
+    void stop();
+
+    // Begin a frame. Returns false when the play back has run out of frames
+    bool beginFrame();
+
+    // Save the frame's elapsed time or replace it with the saved one
+    void syncElapsedTime();
+
+    // Save the polled event
+    void recordEvent( const SDL_Event & event );
+
+    // Get the next event of the frame being played back
+    bool getEvent( SDL_Event & event );
+
+    // Poll the next event. Use in place of SDL_PollEvent
+    bool pollEvent( SDL_Event & event );
+
+    // Get a seed for a random number generator
+    uint32_t getSeed();
+
+    // Is the session being recorded or played back
+    bool isRecording() const;
+    bool isPlaying() const;
+
+    // Is the play back rendered
+    bool isRendering() const;
+
+    // Is the event input that's saved
+    static bool IsInput( const SDL_Event & event );
+
+private:
+
+    // Constructor
+    CReplay();
+
+    // Destructor
+    ~CReplay();
+
+    // Load the file to play back
+    void load( const std::string & filePath );
+
+    // Add data to the record buffer
+    void write( const void * pData, size_t size );
+
+private:
+
+    // Replay mode
+    NDefs::EReplayMode m_mode;
+
+    // Render the play back
+    bool m_render;
+
+    // File being recorded to
+    NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> m_scpFile;
+
+    // Data of the frame being recorded
+    std::vector<char> m_recordBuf;
+    uint32_t m_recordEventCount;
+    size_t m_recordCountPos;
+
+    // Frame being played back
+    class CFrame
+    {
+    public:
+        double m_elapsedTime;
+        size_t m_firstEvent;
+        size_t m_eventCount;
+    };
+
+    // Frames, events and seeds being played back
+    // An event type of zero marks the place of one of the game's own events
+    std::vector<CFrame> m_frameVec;
+    std::vector<SDL_Event> m_eventVec;
+    std::vector<uint32_t> m_seedVec;
+
+    // Play back position
+    size_t m_frameIndex;
+    size_t m_eventIndex;
+    size_t m_seedIndex;
+
+    // Timing of the play back
+    uint64_t m_startCounter;
+    uint64_t m_frameCounter;
+    size_t m_timedFrameCount;
+    double m_maxFrameTime;
+};
+
+#endif  // __replay_h__
@@ -0,0 +1,309 @@
+/************************************************************************
+*    FILE NAME:       atlaspacker.cpp
+*
+*    DESCRIPTION:     Packs rects into texture atlas pages
+*                     Uses a skyline with the bottom left rule. The rects
+*                     are placed tallest first and a page is added when
+*                     a rect doesn't fit the pages already started.
+*                     CPU only so it can be used by tools.
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/atlaspacker.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <climits>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CAtlasPacker::CAtlasPacker( const CSize<int> & pageSize, int padding ) :
+    m_pageSize( pageSize ),
+    m_padding( std::max( padding, 0 ) )
+{
+}
+
+
+/************************************************************************
+*    DESC:  Add a rect to be packed. Returns it's index
+************************************************************************/
+size_t CAtlasPacker::add( const CSize<int> & size )
+{
+    if( (size.w > m_pageSize.w) || (size.h > m_pageSize.h) )
+        throw NExcept::CCriticalException("Atlas Pack Error!",
+            boost::str( boost::format("Rect is larger than the page (%d x %d).\n\n%s\nLine: %s")
+                % size.w % size.h % __FUNCTION__ % __LINE__ ));
+
+    CPlacement placement;
+    placement.m_size.w = std::max( size.w, 0 );
+    placement.m_size.h = std::max( size.h, 0 );
+    m_placementVec.push_back( placement );
+
+    return m_placementVec.size() - 1;
+}
+
+
+/************************************************************************
+*    DESC:  Pack the added rects
+*           Packing again starts over with empty pages
+************************************************************************/
+void CAtlasPacker::pack()
+{
+    m_pageVec.clear();
+
+    // Place the tallest first. Ties go to the widest
+    std::vector<size_t> orderVec( m_placementVec.size() );
+    for( size_t i = 0; i < orderVec.size(); ++i )
+        orderVec[i] = i;
+
+    std::stable_sort( orderVec.begin(), orderVec.end(),
+        [this]( size_t a, size_t b )
+        {
+            const CSize<int> & sizeA = m_placementVec[a].m_size;
+            const CSize<int> & sizeB = m_placementVec[b].m_size;
+
+            if( sizeA.h != sizeB.h )
+                return sizeA.h > sizeB.h;
+
+            return sizeA.w > sizeB.w;
+        } );
+
+    for( auto iter : orderVec )
+    {
+        CPlacement & rPlacement = m_placementVec[iter];
+
+        // The padding is on the right and bottom of each rect. The page
+        // is made that much larger so a rect can go to the edge
+        const int w = std::max( rPlacement.m_size.w + m_padding, 1 );
+        const int h = std::max( rPlacement.m_size.h + m_padding, 1 );
+
+        size_t index(0);
+        int x(0), y(0);
+        size_t page = 0;
+
+        for( ; page < m_pageVec.size(); ++page )
+            if( findPosition( m_pageVec[page], w, h, index, x, y ) )
+                break;
+
+        if( page == m_pageVec.size() )
+        {
+            m_pageVec.emplace_back( 1, CSkylineNode{ 0, 0, m_pageSize.w + m_padding } );
+            findPosition( m_pageVec[page], w, h, index, x, y );
+        }
+
+        addSkyline( m_pageVec[page], index, x, y, w, h );
+
+        rPlacement.m_page = static_cast<int>(page);
+        rPlacement.m_rect = CRect<int>( x, y, rPlacement.m_size.w, rPlacement.m_size.h );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Pack the added rects into the smallest page that holds them all
+*           The page starts at the min size and doubles, the shorter
+*           side first, up to the size given to the constructor. If
+*           one page of that size isn't enough they go on more pages
+************************************************************************/
+void CAtlasPacker::packToFit( int minSize )
+{
+    const CSize<int> maxSize = m_pageSize;
+    CSize<int> size( std::min( std::max( minSize, 1 ), maxSize.w ), std::min( std::max( minSize, 1 ), maxSize.h ) );
+
+    for(;;)
+    {
+        m_pageSize = size;
+
+        const bool fitsPage = std::all_of( m_placementVec.begin(), m_placementVec.end(),
+            [&size]( const CPlacement & rPlacement )
+                { return (rPlacement.m_size.w <= size.w) && (rPlacement.m_size.h <= size.h); } );
+
+        if( fitsPage )
+        {
+            pack();
+
+            if( getPageCount() <= 1 )
+                break;
+        }
+
+        // Out of room to grow. Keep the pages of the largest size
+        if( (size.w >= maxSize.w) && (size.h >= maxSize.h) )
+            break;
+
+        if( ((size.w <= size.h) || (size.h >= maxSize.h)) && (size.w < maxSize.w) )
+            size.w = std::min( size.w * 2, maxSize.w );
+        else
+            size.h = std::min( size.h * 2, maxSize.h );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Find the lowest spot of the rect on the page
+*           Returns false if it doesn't fit
+************************************************************************/
+bool CAtlasPacker::findPosition(
+    const std::vector<CSkylineNode> & skylineVec, int w, int h, size_t & index, int & x, int & y ) const
+{
+    int bestTop = INT_MAX;
+    int bestX = INT_MAX;
+
+    for( size_t i = 0; i < skylineVec.size(); ++i )
+    {
+        const int top = fit( skylineVec, i, w, h );
+
+        if( top >= 0 )
+        {
+            // Bottom left rule. The lowest bottom edge then the leftmost
+            if( (top + h < bestTop) || ((top + h == bestTop) && (skylineVec[i].m_x < bestX)) )
+            {
+                bestTop = top + h;
+                bestX = skylineVec[i].m_x;
+                index = i;
+                x = skylineVec[i].m_x;
+                y = top;
+            }
+        }
+    }
+
+    return (bestTop != INT_MAX);
+}
+
+
+/************************************************************************
+*    DESC:  Get the top of the rect placed at the node
+*           Returns -1 if it doesn't fit
+************************************************************************/
+int CAtlasPacker::fit( const std::vector<CSkylineNode> & skylineVec, size_t index, int w, int h ) const
+{
+    if( skylineVec[index].m_x + w > m_pageSize.w + m_padding )
+        return -1;
+
+    int y = skylineVec[index].m_y;
+    int widthLeft = w;
+
+    // The rect rests on the highest node it spans
+    for( size_t i = index; widthLeft > 0; ++i )
+    {
+        y = std::max( y, skylineVec[i].m_y );
+
+        if( y + h > m_pageSize.h + m_padding )
+            return -1;
+
+        widthLeft -= skylineVec[i].m_w;
+    }
+
+    return y;
+}
+
+
+/************************************************************************
+*    DESC:  Raise the skyline under the placed rect
+************************************************************************/
+void CAtlasPacker::addSkyline( std::vector<CSkylineNode> & skylineVec, size_t index, int x, int y, int w, int h )
+{
+    skylineVec.insert( skylineVec.begin() + index, CSkylineNode{ x, y + h, w } );
+
+    // Shrink or remove the nodes now under the new one
+    for( size_t i = index + 1; i < skylineVec.size(); )
+    {
+        const CSkylineNode & prev = skylineVec[i-1];
+        CSkylineNode & node = skylineVec[i];
+
+        if( node.m_x >= prev.m_x + prev.m_w )
+            break;
+
+        const int shrink = (prev.m_x + prev.m_w) - node.m_x;
+        node.m_x += shrink;
+        node.m_w -= shrink;
+
+        if( node.m_w > 0 )
+            break;
+
+        skylineVec.erase( skylineVec.begin() + i );
+    }
+
+    // Join the neighbors at the same height
+    for( size_t i = 0; i + 1 < skylineVec.size(); )
+    {
+        if( skylineVec[i].m_y == skylineVec[i+1].m_y )
+        {
+            skylineVec[i].m_w += skylineVec[i+1].m_w;
+            skylineVec.erase( skylineVec.begin() + i + 1 );
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of pages used
+************************************************************************/
+size_t CAtlasPacker::getPageCount() const
+{
+    return m_pageVec.size();
+}
+
+
+/************************************************************************
+*    DESC:  Get the page size
+************************************************************************/
+const CSize<int> & CAtlasPacker::getPageSize() const
+{
+    return m_pageSize;
+}
+
+
+/************************************************************************
+*    DESC:  Get the page of the rect. -1 if it hasn't been packed
+************************************************************************/
+int CAtlasPacker::getPage( size_t index ) const
+{
+    return m_placementVec.at( index ).m_page;
+}
+
+
+/************************************************************************
+*    DESC:  Get the rect's position and size in pixels
+************************************************************************/
+const CRect<int> & CAtlasPacker::getRect( size_t index ) const
+{
+    return m_placementVec.at( index ).m_rect;
+}
+
+
+/************************************************************************
+*    DESC:  Get the glyph of the rect with the UV of the page
+*           The UV is laid out the same as a sprite sheet file
+************************************************************************/
+CSpriteSheetGlyph CAtlasPacker::getGlyph( size_t index ) const
+{
+    const CRect<int> & rect = getRect( index );
+
+    return CSpriteSheetGlyph(
+        CSize<int>( rect.x2, rect.y2 ),
+        CRect<float>(
+            (float)rect.x1 / (float)m_pageSize.w,
+            (float)rect.y1 / (float)m_pageSize.h,
+            (float)rect.x2 / (float)m_pageSize.w,
+            (float)rect.y2 / (float)m_pageSize.h ) );
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of rects
+************************************************************************/
+size_t CAtlasPacker::getCount() const
+{
+    return m_placementVec.size();
+}
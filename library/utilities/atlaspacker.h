@@ -0,0 +1,98 @@
+/************************************************************************
+*    FILE NAME:       atlaspacker.h
+*
+*    DESCRIPTION:     Packs rects into texture atlas pages
+*                     Uses a skyline with the bottom left rule. The rects
+*                     are placed tallest first and a page is added when
+*                     a rect doesn't fit the pages already started.
+*                     CPU only so it can be used by tools.
+************************************************************************/
+
+#ifndef __atlas_packer_h__
+#define __atlas_packer_h__
+
+// Game lib dependencies
+#include <common/size.h>
+#include <common/rect.h>
+#include <common/spritesheetglyph.h>
+
+// Standard lib dependencies
+#include <vector>
+
+class CAtlasPacker
+{
+public:
+
+    // Constructor
+    CAtlasPacker( const CSize<int> & pageSize, int padding = 2 );
+
+    // Add a rect to be packed. Returns it's index
+    size_t add( const CSize<int> & size );
+
+    // Pack the added rects
+    void pack();
+
+    // Pack the added rects into the smallest page that holds them all
+    void packToFit( int minSize );
+
+    // Get the number of pages used
+    size_t getPageCount() const;
+
+    // Get the page size
+    const CSize<int> & getPageSize() const;
+
+    // Get the page of the rect
+    int getPage( size_t index ) const;
+
+    // Get the rect's position and size in pixels. x2 and y2 are the size
+    const CRect<int> & getRect( size_t index ) const;
+
+    // Get the glyph of the rect with the UV of the page
+    CSpriteSheetGlyph getGlyph( size_t index ) const;
+
+    // Get the number of rects
+    size_t getCount() const;
+
+private:
+
+    // Span of the skyline
+    class CSkylineNode
+    {
+    public:
+        int m_x, m_y, m_w;
+    };
+
+    // Placement of a rect
+    class CPlacement
+    {
+    public:
+        CSize<int> m_size;
+        CRect<int> m_rect;
+        int m_page = -1;
+    };
+
+    // Find the lowest spot of the rect on the page. Returns false if it doesn't fit
+    bool findPosition( const std::vector<CSkylineNode> & skylineVec, int w, int h, size_t & index, int & x, int & y ) const;
+
+    // Get the top of the rect placed at the node. Returns -1 if it doesn't fit
+    int fit( const std::vector<CSkylineNode> & skylineVec, size_t index, int w, int h ) const;
+
+    // Raise the skyline under the placed rect
+    void addSkyline( std::vector<CSkylineNode> & skylineVec, size_t index, int x, int y, int w, int h );
+
+private:
+
+    // Size of a page
+    CSize<int> m_pageSize;
+
+    // Space between the rects
+    int m_padding;
+
+    // The rects
+    std::vector<CPlacement> m_placementVec;
+
+    // Skyline of each page
+    std::vector<std::vector<CSkylineNode>> m_pageVec;
+};
+
+#endif  // __atlas_packer_h__
@@ -0,0 +1,125 @@
+/************************************************************************
+*    FILE NAME:       fixedstep.cpp
+*
+*    DESCRIPTION:     Fixed step game clock
+*                     The frame time is added to an accumulator and used
+*                     up in steps of the same size so the game runs the
+*                     same at any frame rate. The time left over is the
+*                     alpha used to render between the last two steps.
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/fixedstep.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cmath>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CFixedStep::CFixedStep() :
+    m_stepTime(0.0),
+    m_accumulator(0.0),
+    m_maxStepsPerFrame(1),
+    m_tick(0),
+    m_alpha(1.f)
+{
+}
+
+
+/************************************************************************
+*    DESC:  Destructor
+************************************************************************/
+CFixedStep::~CFixedStep()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Set the number of steps per second. Zero disables the fixed step
+************************************************************************/
+void CFixedStep::setTickRate( float tickRate, int maxStepsPerFrame )
+{
+    m_stepTime = (tickRate > 0.f) ? (1000.0 / tickRate) : 0.0;
+    m_maxStepsPerFrame = std::max( maxStepsPerFrame, 1 );
+    m_accumulator = 0.0;
+    m_alpha = 1.f;
+}
+
+
+/************************************************************************
+*    DESC:  Is the fixed step enabled
+************************************************************************/
+bool CFixedStep::isEnabled() const
+{
+    return (m_stepTime > 0.0);
+}
+
+
+/************************************************************************
+*    DESC:  Add the frame time and get the number of steps to run
+************************************************************************/
+int CFixedStep::addFrameTime( double elapsedTime )
+{
+    if( !isEnabled() )
+        return 0;
+
+    m_accumulator += std::max( elapsedTime, 0.0 );
+
+    int steps = static_cast<int>(m_accumulator / m_stepTime);
+
+    // A frame too slow to catch up on drops the time over the max
+    // steps instead of running more steps the next frame
+    if( steps > m_maxStepsPerFrame )
+    {
+        steps = m_maxStepsPerFrame;
+        m_accumulator = std::fmod( m_accumulator, m_stepTime ) + (m_stepTime * steps);
+    }
+
+    m_accumulator -= m_stepTime * steps;
+
+    // The accumulator can land a hair under zero from rounding
+    m_accumulator = std::max( m_accumulator, 0.0 );
+
+    m_alpha = std::min( static_cast<float>(m_accumulator / m_stepTime), 1.f );
+
+    return steps;
+}
+
+
+/************************************************************************
+*    DESC:  Begin a step
+************************************************************************/
+void CFixedStep::beginStep()
+{
+    ++m_tick;
+}
+
+
+/************************************************************************
+*    DESC:  Get the step time in milliseconds
+************************************************************************/
+double CFixedStep::getStepTime() const
+{
+    return m_stepTime;
+}
+
+
+/************************************************************************
+*    DESC:  Get the current step
+************************************************************************/
+uint32_t CFixedStep::getTick() const
+{
+    return m_tick;
+}
+
+
+/************************************************************************
+*    DESC:  Get how far the render is between the last two steps
+*           Always 1 when the fixed step is disabled
+************************************************************************/
+float CFixedStep::getAlpha() const
+{
+    return isEnabled() ? m_alpha : 1.f;
+}
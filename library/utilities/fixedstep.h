@@ -0,0 +1,75 @@
+/************************************************************************
+*    FILE NAME:       fixedstep.h
+*
+*    DESCRIPTION:     Fixed step game clock
+*                     The frame time is added to an accumulator and used
+*                     up in steps of the same size so the game runs the
+*                     same at any frame rate. The time left over is the
+*                     alpha used to render between the last two steps.
+************************************************************************/
+
+#ifndef __fixed_step_h__
+#define __fixed_step_h__
+
+// Standard lib dependencies
+#include <cstdint>
+
+class CFixedStep
+{
+public:
+
+    // Get the instance of the singleton class
+    static CFixedStep & Instance()
+    {
+        static CFixedStep fixedStep;
+        return fixedStep;
+    }
+
+    // Set the number of steps per second. Zero disables the fixed step
+    void setTickRate( float tickRate, int maxStepsPerFrame );
+
+    // Is the fixed step enabled
+    bool isEnabled() const;
+
+    // Add the frame time and get the number of steps to run
+    int addFrameTime( double elapsedTime );
+
+    // Begin a step
+    void beginStep();
+
+    // Get the step time in milliseconds
+    double getStepTime() const;
+
+    // Get the current step
+    uint32_t getTick() const;
+
+    // Get how far the render is between the last two steps
+    float getAlpha() const;
+
+private:
+
+    // Constructor
+    CFixedStep();
+
+    // Destructor
+    ~CFixedStep();
+
+private:
+
+    // Time of a step in milliseconds
+    double m_stepTime;
+
+    // Time not yet used up by a step
+    double m_accumulator;
+
+    // Maximum number of steps run in a frame. Time over the max is dropped
+    int m_maxStepsPerFrame;
+
+    // The current step
+    uint32_t m_tick;
+
+    // How far the render is between the last two steps
+    float m_alpha;
+};
+
+#endif  // __fixed_step_h__
@@ -30,7 +30,7 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
-#include <chrono>
+#include <mutex>
 
 #if defined(__ANDROID__)
 #include <android/log.h>
@@ -43,6 +43,13 @@
 
 namespace NGenFunc
 {
+    namespace
+    {
+        // Generator used by the uniform random functions when no seed is given
+        std::mt19937 randomGenerator;
+        std::mutex randomMutex;
+    }
+
     /************************************************************************
     *    DESC:  Count the number of occurrences of sub string
     ************************************************************************/
@@ -177,24 +184,32 @@ namespace NGenFunc
     }   // Convert2Dto3D
 
 
+    /************************************************************************
+    *    DESC:  Seed the generator the uniform random numbers use when
+    *           no seed is given. Seeded from the replay so it can be
+    *           played back
+    ************************************************************************/
+    void SeedRandom( uint32_t seed )
+    {
+        std::lock_guard<std::mutex> lock( randomMutex );
+        randomGenerator.seed( seed );
+    }
+
+
     /************************************************************************
     *    DESC:  Uniform int random number generation
     ************************************************************************/
     int UniformRandomInt( int startRange, int endRange, int seed )
     {
-        std::default_random_engine generator;
+        std::uniform_int_distribution<int> distribution( startRange, endRange );
 
         if( seed == 0 )
         {
-            auto timeInNano = std::chrono::high_resolution_clock::now().time_since_epoch();
-            generator.seed( std::chrono::duration_cast<std::chrono::nanoseconds>(timeInNano).count() );
-        }
-        else
-        {
-            generator.seed( seed );
+            std::lock_guard<std::mutex> lock( randomMutex );
+            return distribution( randomGenerator );
         }
 
-        std::uniform_int_distribution<int> distribution( startRange, endRange );
+        std::default_random_engine generator( seed );
         return distribution( generator );
     }
 
@@ -203,19 +218,15 @@ namespace NGenFunc
     ************************************************************************/
     float UniformRandomFloat( float startRange, float endRange, int seed )
     {
-        std::default_random_engine generator;
+        std::uniform_real_distribution<float> distribution( startRange, endRange );
 
         if( seed == 0 )
         {
-            auto timeInNano = std::chrono::high_resolution_clock::now().time_since_epoch();
-            generator.seed( std::chrono::duration_cast<std::chrono::nanoseconds>(timeInNano).count() );
-        }
-        else
-        {
-            generator.seed( seed );
+            std::lock_guard<std::mutex> lock( randomMutex );
+            return distribution( randomGenerator );
         }
 
-        std::uniform_real_distribution<float> distribution( startRange, endRange );
+        std::default_random_engine generator( seed );
         return distribution( generator );
     }
     
@@ -10,6 +10,7 @@
 // Standard lib dependencies
 #include <string>
 #include <memory>
+#include <cstdint>
 #include <assert.h>
 
 namespace NGenFunc
@@ -30,6 +31,9 @@ namespace NGenFunc
     // Convert 2d screen coordinates to 3D perspective space
     void Convert2Dto3D( float & destX, float & destY, float x, float y, float width, float height );
 
+    // Seed the generator the uniform random numbers use when no seed is given
+    void SeedRandom( uint32_t seed );
+
     // Uniform float random number generation
     int UniformRandomInt( int startRange, int endRange, int seed = 0 );
 
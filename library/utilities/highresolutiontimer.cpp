@@ -92,6 +92,16 @@ double CHighResTimer::getElapsedTime()
 }
 
 
+/***************************************************************************
+*    DESC:  Set the elapsed time
+*           Used to give the fixed step to the game
+****************************************************************************/
+void CHighResTimer::setElapsedTime( double elapsedTime )
+{
+    m_elapsedTime = elapsedTime;
+}
+
+
 /***************************************************************************
 *    DESC:  get the elapsed time
 ****************************************************************************/
@@ -111,3 +121,21 @@ double CHighResTimer::getTime()
 
     return (double)(time * m_inverseTimerFrequency);
 }
+
+
+/***************************************************************************
+*    DESC:  get the raw performance counter
+****************************************************************************/
+uint64_t CHighResTimer::getCounter() const
+{
+    return SDL_GetPerformanceCounter();
+}
+
+
+/***************************************************************************
+*    DESC:  Convert a performance counter difference to milliseconds
+****************************************************************************/
+double CHighResTimer::toMilliseconds( uint64_t count ) const
+{
+    return static_cast<double>(count) * m_inverseTimerFrequency;
+}
@@ -26,6 +26,9 @@ public:
 
     // Get the elapsed time
     double getElapsedTime();
+
+    // Set the elapsed time. Used to give the fixed step to the game
+    void setElapsedTime( double elapsedTime );
     
     // Simple timer start
     void timerStart();
@@ -39,6 +42,12 @@ public:
     // Get the time
     double getTime();
 
+    // Get the raw performance counter
+    uint64_t getCounter() const;
+
+    // Convert a performance counter difference to milliseconds
+    double toMilliseconds( uint64_t count ) const;
+
 private:
 
     // Constructor
@@ -0,0 +1,313 @@
+/************************************************************************
+*    FILE NAME:       jobqueue.cpp
+*
+*    DESCRIPTION:     Job, job handle and per-worker work stealing queue
+*                     used by the thread pool
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/jobqueue.h>
+
+// Standard lib dependencies
+#include <algorithm>
+
+/************************************************************************
+*    DESC:  Hold on to the first exception thrown by a posted job
+************************************************************************/
+void CJobGroup::storeException( std::exception_ptr exception )
+{
+    bool failed = false;
+
+    if( m_failed.compare_exchange_strong( failed, true, std::memory_order_relaxed ) )
+        m_exception = exception;
+}
+
+
+/************************************************************************
+*    DESC:  Take the exception. Only called once the group is done so
+*           the posted jobs that stored it are finished
+************************************************************************/
+std::exception_ptr CJobGroup::takeException()
+{
+    std::exception_ptr exception;
+
+    if( m_failed.load( std::memory_order_relaxed ) )
+    {
+        std::swap( exception, m_exception );
+        m_failed.store( false, std::memory_order_relaxed );
+    }
+
+    return exception;
+}
+
+
+/************************************************************************
+*    DESC:  Run the callable and destroy it
+*           The callable is destroyed even if it throws
+************************************************************************/
+void CJob::execute()
+{
+    try
+    {
+        m_pInvoke( &m_storage );
+    }
+    catch(...)
+    {
+        m_pDestroy( &m_storage );
+        throw;
+    }
+
+    m_pDestroy( &m_storage );
+}
+
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CJobQueue::CJobQueue() :
+    m_top(0),
+    m_bottom(0),
+    m_pRemoteFree(nullptr),
+    m_inUse(false),
+    m_failedCount(0)
+{
+    m_ringVec.emplace_back( new CRing( INITIAL_CAPACITY ) );
+    m_pRing.store( m_ringVec.back().get(), std::memory_order_relaxed );
+}
+
+
+/************************************************************************
+*    DESC:  Push a job to the bottom. Only called by the owning thread
+*           A full deque doubles in size so the job is always queued
+************************************************************************/
+void CJobQueue::push( CJob * pJob )
+{
+    const int64_t bottom = m_bottom.load( std::memory_order_relaxed );
+    const int64_t top = m_top.load( std::memory_order_acquire );
+    CRing * pRing = m_pRing.load( std::memory_order_relaxed );
+
+    if( bottom - top >= pRing->m_capacity )
+        pRing = grow( top, bottom );
+
+    pRing->at( bottom ).store( pJob, std::memory_order_relaxed );
+    m_bottom.store( bottom + 1, std::memory_order_release );
+}
+
+
+/************************************************************************
+*    DESC:  Double the size of the ring. Only called by the owning thread
+*           The jobs are copied, not moved, so a stealer still reading
+*           the old ring gets the same job
+************************************************************************/
+CJobQueue::CRing * CJobQueue::grow( int64_t top, int64_t bottom )
+{
+    CRing * pOldRing = m_pRing.load( std::memory_order_relaxed );
+
+    m_ringVec.emplace_back( new CRing( pOldRing->m_capacity * 2 ) );
+    CRing * pRing = m_ringVec.back().get();
+
+    for( int64_t i = top; i < bottom; ++i )
+        pRing->at( i ).store( pOldRing->at( i ).load( std::memory_order_relaxed ), std::memory_order_relaxed );
+
+    m_pRing.store( pRing, std::memory_order_release );
+
+    return pRing;
+}
+
+
+/************************************************************************
+*    DESC:  Pop a job from the bottom. Only called by the owning thread
+************************************************************************/
+CJob * CJobQueue::pop()
+{
+    const int64_t bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+    m_bottom.store( bottom, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64_t top = m_top.load( std::memory_order_relaxed );
+
+    CJob * pJob = nullptr;
+
+    if( top <= bottom )
+    {
+        pJob = m_pRing.load( std::memory_order_relaxed )->at( bottom ).load( std::memory_order_relaxed );
+
+        // Last job in the deque. Race the stealers for it
+        if( top == bottom )
+        {
+            if( !m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+                pJob = nullptr;
+
+            m_bottom.store( bottom + 1, std::memory_order_relaxed );
+        }
+    }
+    else
+    {
+        m_bottom.store( bottom + 1, std::memory_order_relaxed );
+    }
+
+    return pJob;
+}
+
+
+/************************************************************************
+*    DESC:  Steal a job from the top. Can be called by any thread
+************************************************************************/
+CJob * CJobQueue::steal()
+{
+    int64_t top = m_top.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    const int64_t bottom = m_bottom.load( std::memory_order_acquire );
+
+    if( top < bottom )
+    {
+        CJob * pJob = m_pRing.load( std::memory_order_acquire )->at( top ).load( std::memory_order_relaxed );
+
+        if( m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+            return pJob;
+    }
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Allocate a job. Only called by the owning thread
+*           The memory is only allocated in chunks when the free lists
+*           run dry so a warmed up queue never touches the heap
+************************************************************************/
+CJob * CJobQueue::alloc()
+{
+    // Take back everything other threads have freed
+    if( m_pLocalFree == nullptr )
+        m_pLocalFree = m_pRemoteFree.exchange( nullptr, std::memory_order_acquire );
+
+    if( m_pLocalFree == nullptr )
+    {
+        m_jobChunkVec.emplace_back( new CJob[JOB_CHUNK] );
+        CJob * pChunk = m_jobChunkVec.back().get();
+
+        for( int i = 0; i < JOB_CHUNK; ++i )
+        {
+            pChunk[i].m_pOwner = this;
+            pChunk[i].m_generation.store( 0, std::memory_order_relaxed );
+            pChunk[i].m_pNext = (i + 1 < JOB_CHUNK) ? &pChunk[i + 1] : nullptr;
+        }
+
+        m_pLocalFree = pChunk;
+    }
+
+    CJob * pJob = m_pLocalFree;
+    m_pLocalFree = pJob->m_pNext;
+
+    pJob->m_pNext = nullptr;
+    pJob->m_pParent = nullptr;
+    pJob->m_pGroup = nullptr;
+    pJob->m_unfinished.store( 1, std::memory_order_relaxed );
+
+    return pJob;
+}
+
+
+/************************************************************************
+*    DESC:  Return a job to the free list. Can be called by any thread
+*           Only the owner ever removes from the remote list and it
+*           takes the whole list at once so there is no ABA problem
+************************************************************************/
+void CJobQueue::free( CJob * pJob )
+{
+    CJob * pHead = m_pRemoteFree.load( std::memory_order_relaxed );
+
+    do
+    {
+        pJob->m_pNext = pHead;
+    }
+    while( !m_pRemoteFree.compare_exchange_weak( pHead, pJob, std::memory_order_release, std::memory_order_relaxed ) );
+}
+
+
+/************************************************************************
+*    DESC:  Take ownership of this queue for the calling thread
+*
+*    ret:   bool - false if another thread owns it
+************************************************************************/
+bool CJobQueue::acquire()
+{
+    bool inUse = false;
+
+    return m_inUse.compare_exchange_strong( inUse, true, std::memory_order_acquire, std::memory_order_relaxed );
+}
+
+
+/************************************************************************
+*    DESC:  Give up ownership of this queue
+*           Any jobs left in it are still available to be stolen
+************************************************************************/
+void CJobQueue::release()
+{
+    m_inUse.store( false, std::memory_order_release );
+}
+
+
+/************************************************************************
+*    DESC:  Hold the exception of a failed job for the waiter of it's
+*           handle. Called before the job finishes so the generation
+*           is still the one the handle has
+************************************************************************/
+void CJobQueue::storeException( const CJob * pJob, uint32_t generation, std::exception_ptr exception )
+{
+    std::unique_lock<std::mutex> lock( m_failedMutex );
+
+    m_failedVec.push_back( CFailedJob{ pJob, generation, exception } );
+    m_failedCount.fetch_add( 1, std::memory_order_release );
+}
+
+
+/************************************************************************
+*    DESC:  Take the exception of the job the handle refers to
+*
+*    ret:   std::exception_ptr - null if the job didn't fail
+************************************************************************/
+std::exception_ptr CJobQueue::takeException( const CJobHandle & handle )
+{
+    std::exception_ptr exception;
+
+    if( m_failedCount.load( std::memory_order_acquire ) > 0 )
+    {
+        std::unique_lock<std::mutex> lock( m_failedMutex );
+
+        auto iter = std::find_if( m_failedVec.begin(), m_failedVec.end(),
+            [&handle](const CFailedJob & rFailed)
+                { return (rFailed.m_pJob == handle.m_pJob) && (rFailed.m_generation == handle.m_generation); } );
+
+        if( iter != m_failedVec.end() )
+        {
+            exception = iter->m_exception;
+            m_failedVec.erase( iter );
+            m_failedCount.fetch_sub( 1, std::memory_order_relaxed );
+        }
+    }
+
+    return exception;
+}
+
+
+/************************************************************************
+*    DESC:  Drop the exceptions left over from the earlier uses of the job
+*           Called when the job is finished again after being recycled.
+*           No one waited on the handle of the failed job before it's
+*           memory was reused, so the exception is not kept any longer
+************************************************************************/
+void CJobQueue::dropException( const CJob * pJob, uint32_t generation )
+{
+    if( m_failedCount.load( std::memory_order_acquire ) > 0 )
+    {
+        std::unique_lock<std::mutex> lock( m_failedMutex );
+
+        auto iter = std::remove_if( m_failedVec.begin(), m_failedVec.end(),
+            [pJob, generation](const CFailedJob & rFailed)
+                { return (rFailed.m_pJob == pJob) && (rFailed.m_generation != generation); } );
+
+        m_failedCount.fetch_sub( m_failedVec.end() - iter, std::memory_order_relaxed );
+        m_failedVec.erase( iter, m_failedVec.end() );
+    }
+}
@@ -0,0 +1,303 @@
+/************************************************************************
+*    FILE NAME:       jobqueue.h
+*
+*    DESCRIPTION:     Job, job handle and per-worker work stealing queue
+*                     used by the thread pool
+************************************************************************/
+
+#ifndef __job_queue_h__
+#define __job_queue_h__
+
+// Standard lib dependencies
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <exception>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// Forward declaration(s)
+class CJobQueue;
+
+/************************************************************************
+*    desc:  The jobs posted from one thread or from one running job.
+*           Wait only waits on the jobs of the caller's group, so a job
+*           can post more work and wait on it without waiting on itself
+************************************************************************/
+class CJobGroup
+{
+public:
+
+    CJobGroup() : m_pending(0), m_failed(false)
+    {}
+
+    // Count a posted job
+    void add()
+    { m_pending.fetch_add( 1, std::memory_order_relaxed ); }
+
+    // A posted job is done
+    void done()
+    { m_pending.fetch_sub( 1, std::memory_order_release ); }
+
+    // Are all the posted jobs done
+    bool isDone() const
+    { return m_pending.load( std::memory_order_acquire ) <= 0; }
+
+    // Hold on to the first exception thrown by a posted job
+    void storeException( std::exception_ptr exception );
+
+    // Take the exception. Only called once the group is done
+    std::exception_ptr takeException();
+
+private:
+
+    // Number of posted jobs not yet finished
+    std::atomic<int> m_pending;
+
+    // First exception thrown by a posted job
+    std::atomic<bool> m_failed;
+    std::exception_ptr m_exception;
+};
+
+/************************************************************************
+*    desc:  A unit of work. The callable is constructed in place in the
+*           small buffer so posting a job does not touch the heap.
+*           Callables that don't fit are boxed.
+************************************************************************/
+class CJob
+{
+public:
+
+    // Size of the in place storage for the callable
+    enum{ STORAGE_SIZE = 64 };
+
+    // Construct the callable in place
+    template<class F>
+    void set( F && func );
+
+    // Run the callable and destroy it
+    void execute();
+
+    // Storage for the callable
+    typename std::aligned_storage<STORAGE_SIZE, alignof(std::max_align_t)>::type m_storage;
+
+    // Function pointers that run and destroy the callable
+    void (*m_pInvoke)(void *) = nullptr;
+    void (*m_pDestroy)(void *) = nullptr;
+
+    // Parent job to notify when this job and all it's children are done
+    CJob * m_pParent = nullptr;
+
+    // Queue that owns the memory of this job
+    CJobQueue * m_pOwner = nullptr;
+
+    // Next job in the free list
+    CJob * m_pNext = nullptr;
+
+    // Group of a posted job. Null for jobs created with a handle
+    CJobGroup * m_pGroup = nullptr;
+
+    // Number of unfinished jobs. Self + children
+    std::atomic<int> m_unfinished;
+
+    // Incremented each time the job finishes. Handles use it to
+    // know if the job they refer to is done
+    std::atomic<uint32_t> m_generation;
+
+private:
+
+    template<class F>
+    static void invoke( void * pStorage )
+    { (*static_cast<F *>(pStorage))(); }
+
+    template<class F>
+    static void destroy( void * pStorage )
+    { static_cast<F *>(pStorage)->~F(); }
+
+    // Callables too large for the small buffer are boxed
+    template<class F>
+    struct CBoxed
+    {
+        std::unique_ptr<F> m_upFunc;
+        void operator()() { (*m_upFunc)(); }
+    };
+
+    template<class F>
+    void setInPlace( F && func, std::true_type );
+
+    template<class F>
+    void setInPlace( F && func, std::false_type );
+};
+
+
+/************************************************************************
+*    desc:  Handle to a job. The job memory is recycled when done so
+*           the generation is used to tell if the job is finished
+************************************************************************/
+class CJobHandle
+{
+public:
+
+    CJobHandle() = default;
+    CJobHandle( CJob * pJob, uint32_t generation ) : m_pJob(pJob), m_generation(generation)
+    {}
+
+    // Is the job this handle refers to done
+    bool isDone() const
+    { return (m_pJob == nullptr) || (m_pJob->m_generation.load( std::memory_order_acquire ) != m_generation); }
+
+    // Is this handle valid
+    bool isValid() const
+    { return (m_pJob != nullptr); }
+
+    CJob * m_pJob = nullptr;
+    uint32_t m_generation = 0;
+};
+
+
+/************************************************************************
+*    desc:  Growable lock-free work stealing deque (Chase-Lev) along
+*           with the free list of jobs allocated by the owning thread.
+*           Only the owning thread may push/pop/alloc. Any thread may
+*           steal or free.
+************************************************************************/
+class CJobQueue
+{
+public:
+
+    // Starting number of jobs the deque can hold. Must be a power of two
+    enum{ INITIAL_CAPACITY = 4096, JOB_CHUNK = 256 };
+
+    // Constructor
+    CJobQueue();
+
+    // Push a job to the bottom. The deque grows when it's full
+    void push( CJob * pJob );
+
+    // Pop a job from the bottom
+    CJob * pop();
+
+    // Steal a job from the top
+    CJob * steal();
+
+    // Allocate a job from this queue's free list
+    CJob * alloc();
+
+    // Return a job to the free list of the queue that owns it
+    void free( CJob * pJob );
+
+    // Take/give up ownership of this queue for the calling thread
+    bool acquire();
+    void release();
+
+    // Hold the exception of a failed job allocated from this queue for the waiter of it's handle
+    void storeException( const CJob * pJob, uint32_t generation, std::exception_ptr exception );
+
+    // Take the exception of the job the handle refers to
+    std::exception_ptr takeException( const CJobHandle & handle );
+
+    // Drop the exceptions left over from the earlier uses of the job
+    void dropException( const CJob * pJob, uint32_t generation );
+
+private:
+
+    // Ring buffer of jobs
+    class CRing
+    {
+    public:
+
+        CRing( int64_t capacity ) : m_capacity(capacity), m_upJob( new std::atomic<CJob *>[capacity] )
+        {}
+
+        std::atomic<CJob *> & at( int64_t index )
+        { return m_upJob[index & (m_capacity - 1)]; }
+
+        const int64_t m_capacity;
+        std::unique_ptr< std::atomic<CJob *>[] > m_upJob;
+    };
+
+    // Exception of a failed job waiting to be taken
+    class CFailedJob
+    {
+    public:
+
+        const CJob * m_pJob;
+        uint32_t m_generation;
+        std::exception_ptr m_exception;
+    };
+
+    // Double the size of the ring
+    CRing * grow( int64_t top, int64_t bottom );
+
+private:
+
+    // Index of the top and bottom. Padded to keep them on different cache lines
+    std::atomic<int64_t> m_top;
+    char m_padTop[64 - sizeof(int64_t)];
+    std::atomic<int64_t> m_bottom;
+    char m_padBottom[64 - sizeof(int64_t)];
+
+    // Ring buffer of jobs
+    std::atomic<CRing *> m_pRing;
+
+    // All the rings. The old ones are kept because a stealer may still be reading them
+    std::vector< std::unique_ptr<CRing> > m_ringVec;
+
+    // Free list only used by the owner thread
+    CJob * m_pLocalFree = nullptr;
+
+    // Free list other threads push to
+    std::atomic<CJob *> m_pRemoteFree;
+
+    // Allocated blocks of jobs
+    std::vector< std::unique_ptr<CJob[]> > m_jobChunkVec;
+
+    // Is a thread using this queue
+    std::atomic<bool> m_inUse;
+
+    // Exceptions of failed jobs not yet taken by a waiter
+    std::vector<CFailedJob> m_failedVec;
+    std::atomic<int> m_failedCount;
+    std::mutex m_failedMutex;
+};
+
+
+/************************************************************************
+*    desc:  Construct the callable in place
+************************************************************************/
+template<class F>
+void CJob::set( F && func )
+{
+    typedef typename std::decay<F>::type func_type;
+
+    setInPlace( std::forward<F>(func),
+        std::integral_constant<bool, (sizeof(func_type) <= STORAGE_SIZE) && (alignof(func_type) <= alignof(std::max_align_t))>() );
+}
+
+template<class F>
+void CJob::setInPlace( F && func, std::true_type )
+{
+    typedef typename std::decay<F>::type func_type;
+
+    new(&m_storage) func_type( std::forward<F>(func) );
+    m_pInvoke = &CJob::invoke<func_type>;
+    m_pDestroy = &CJob::destroy<func_type>;
+}
+
+template<class F>
+void CJob::setInPlace( F && func, std::false_type )
+{
+    typedef typename std::decay<F>::type func_type;
+
+    static_assert( sizeof(CBoxed<func_type>) <= STORAGE_SIZE, "Boxed job too large" );
+
+    new(&m_storage) CBoxed<func_type>{ std::unique_ptr<func_type>( new func_type( std::forward<F>(func) ) ) };
+    m_pInvoke = &CJob::invoke< CBoxed<func_type> >;
+    m_pDestroy = &CJob::destroy< CBoxed<func_type> >;
+}
+
+#endif  // __job_queue_h__
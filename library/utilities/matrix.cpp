@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
+#include <utilities/matrixfunc.h>
 #include <common/defs.h>
 
 // Boost lib dependencies
@@ -107,26 +108,7 @@ void CMatrix::clearTranlate()
 ************************************************************************/
 void CMatrix::mergeMatrix( const float mat[mMax] )
 {
-    float temp[mMax];
-    
-    // Converting to a two demensional array much faster for the 4 loops
-    float (*Mat)[4] = (float (*)[4]) mat;
-    float (*Matrix)[4] = (float (*)[4]) matrix;
-    float (*Temp)[4] = (float (*)[4]) temp;
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        {
-            Temp[i][j] = (Matrix[i][0] * Mat[0][j])
-            + (Matrix[i][1] * Mat[1][j])
-            + (Matrix[i][2] * Mat[2][j])
-            + (Matrix[i][3] * Mat[3][j]);
-        }
-    }
-
-    // Copy temp to master Matrix
-    std::memcpy( matrix, temp, sizeof(temp) );
+    NMatrixFunc::Multiply( matrix, matrix, mat );
 
 }  // MergeMatrix
 
@@ -136,6 +118,32 @@ void CMatrix::mergeMatrix( const CMatrix & obj )
 }
 
 
+/************************************************************************
+*    DESC:  this = a * b
+*           The 2D objects are transformed this way every frame so the
+*           zero terms of a 2D affine matrix are skipped
+************************************************************************/
+void CMatrix::multiply( const CMatrix & a, const CMatrix & b )
+{
+    if( a.isAffine2D() )
+        NMatrixFunc::MultiplyAffine2D( matrix, a.matrix, b.matrix );
+    else
+        NMatrixFunc::Multiply( matrix, a.matrix, b.matrix );
+}
+
+
+/************************************************************************
+*    DESC:  Does the matrix only rotate about z, scale and translate
+************************************************************************/
+bool CMatrix::isAffine2D() const
+{
+    return (matrix[m02] == 0.f) && (matrix[m03] == 0.f) &&
+           (matrix[m12] == 0.f) && (matrix[m13] == 0.f) &&
+           (matrix[m20] == 0.f) && (matrix[m21] == 0.f) && (matrix[m23] == 0.f) &&
+           (matrix[m33] == 1.f);
+}
+
+
 /************************************************************************
 *    DESC:  Merge source matrix into destination matrix.
 *
@@ -144,26 +152,7 @@ void CMatrix::mergeMatrix( const CMatrix & obj )
 ************************************************************************/
 void CMatrix::mergeMatrices( float dest[mMax], const float source[mMax] )
 {
-    float temp[mMax];
-    
-    // Converting to a two demensional array much faster for the 4 loops
-    float (*Dest)[4] = (float (*)[4]) dest;
-    float (*Source)[4] = (float (*)[4]) source;
-    float (*Temp)[4] = (float (*)[4]) temp;
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        {
-            Temp[i][j] = ( Source[i][0] * Dest[0][j] )
-            + ( Source[i][1] * Dest[1][j] )
-            + ( Source[i][2] * Dest[2][j] )
-            + ( Source[i][3] * Dest[3][j] );
-        }
-    }
-
-    // Copy Temp to Dest
-    std::memcpy( dest, temp, sizeof(temp) );
+    NMatrixFunc::Multiply( dest, source, dest );
 }
 
 
@@ -180,6 +169,29 @@ void CMatrix::mergeMatrices( float dest[mMax], const float source[mMax] )
 ************************************************************************/
 void CMatrix::rotate( const CPoint<float> & radian )
 {
+    // 2D objects only rotate about z. Merge the rotation directly
+    // into the first two columns instead of a full matrix multiply
+    if( radian.isXEmpty() && radian.isYEmpty() )
+    {
+        if( !radian.isZEmpty() )
+        {
+            // Same sin and cos as the batched pass of the transform store
+            float sinZ, cosZ;
+            NMatrixFunc::SinCos( &sinZ, &cosZ, &radian.z, 1 );
+
+            for( int i = 0; i < mMax; i += 4 )
+            {
+                const float x = matrix[i];
+                const float y = matrix[i+1];
+
+                matrix[i]   = (x * cosZ) + (y * -sinZ);
+                matrix[i+1] = (x * sinZ) + (y * cosZ);
+            }
+        }
+
+        return;
+    }
+
     int flags = NO_ROT;
     float rMatrix[ 16 ];
 
@@ -250,20 +262,7 @@ void CMatrix::translate( const CSize<int16_t> & size )
 void CMatrix::transform( CPoint<float> & dest, const CPoint<float> & source ) const
 {
     // Transform vertex by master matrix:
-    dest.x = ( source.x * matrix[ 0 ] )
-           + ( source.y * matrix[ 4 ] )
-           + ( source.z * matrix[ 8 ] )
-           + matrix[ 12 ];
-
-    dest.y = ( source.x * matrix[ 1 ] )
-           + ( source.y * matrix[ 5 ] )
-           + ( source.z * matrix[ 9 ] )
-           + matrix[ 13 ];
-
-    dest.z = ( source.x * matrix[ 2 ] )
-           + ( source.y * matrix[ 6 ] )
-           + ( source.z * matrix[ 10 ] )
-           + matrix[ 14 ];
+    NMatrixFunc::TransformPoint( dest, source, matrix );
 }
 
 
@@ -274,20 +273,7 @@ void CMatrix::transform( CPoint<float> & dest, const CPoint<float> & source ) co
 void CMatrix::transform( CPoint<float> * pDest, const CPoint<float> * pSource ) const
 {
     // Transform vertex by master matrix:
-    pDest->x = ( pSource->x * matrix[ 0 ] )
-           + ( pSource->y * matrix[ 4 ] )
-           + ( pSource->z * matrix[ 8 ] )
-           + matrix[ 12 ];
-
-    pDest->y = ( pSource->x * matrix[ 1 ] )
-           + ( pSource->y * matrix[ 5 ] )
-           + ( pSource->z * matrix[ 9 ] )
-           + matrix[ 13 ];
-
-    pDest->z = ( pSource->x * matrix[ 2 ] )
-           + ( pSource->y * matrix[ 6 ] )
-           + ( pSource->z * matrix[ 10 ] )
-           + matrix[ 14 ];
+    NMatrixFunc::TransformPoint( *pDest, *pSource, matrix );
 }
 
 
@@ -368,8 +354,21 @@ void CMatrix::transform3x3( CPoint<float> & dest, const CPoint<float> & source )
 void CMatrix::transform( CQuad & dest, const CQuad & source ) const
 {
     // Transform vertex by master matrix:
-    for( int i = 0; i < 4; ++i )
-        transform( dest.point[i], source.point[i] );
+    NMatrixFunc::TransformPoints( dest.point, source.point, 4, matrix );
+}
+
+
+/************************************************************************
+*    DESC:  Transform an array of vertices using the master matrix
+*           pDest can be the same array as pSource
+*
+*    param: CPoint<float> * pDest - transformed vertices
+*           const CPoint<float> * pSource - vertices to transform
+*           size_t count - number of vertices
+************************************************************************/
+void CMatrix::transformPoints( CPoint<float> * pDest, const CPoint<float> * pSource, size_t count ) const
+{
+    NMatrixFunc::TransformPoints( pDest, pSource, count, matrix );
 }
 
 
@@ -592,135 +591,13 @@ bool CMatrix::inverse()
 
 
 /************************************************************************
-*    DESC:  Inverses this matrix. Assumes that the last column is [0 0 0 1]
+*    DESC:  General inverse of this matrix
+*
+*    ret:   bool - false if the matrix can't be inverted
 ************************************************************************/
 bool CMatrix::invert()
 {
-    float inv[16];
-
-    inv[0] = matrix[5]  * matrix[10] * matrix[15] -
-             matrix[5]  * matrix[11] * matrix[14] -
-             matrix[9]  * matrix[6]  * matrix[15] +
-             matrix[9]  * matrix[7]  * matrix[14] +
-             matrix[13] * matrix[6]  * matrix[11] -
-             matrix[13] * matrix[7]  * matrix[10];
-
-    inv[4] = -matrix[4]  * matrix[10] * matrix[15] +
-              matrix[4]  * matrix[11] * matrix[14] +
-              matrix[8]  * matrix[6]  * matrix[15] -
-              matrix[8]  * matrix[7]  * matrix[14] -
-              matrix[12] * matrix[6]  * matrix[11] +
-              matrix[12] * matrix[7]  * matrix[10];
-
-    inv[8] = matrix[4]  * matrix[9]  * matrix[15] -
-             matrix[4]  * matrix[11] * matrix[13] -
-             matrix[8]  * matrix[5]  * matrix[15] +
-             matrix[8]  * matrix[7]  * matrix[13] +
-             matrix[12] * matrix[5]  * matrix[11] -
-             matrix[12] * matrix[7]  * matrix[9];
-
-    inv[12] = -matrix[4]  * matrix[9]  * matrix[14] +
-               matrix[4]  * matrix[10] * matrix[13] +
-               matrix[8]  * matrix[5]  * matrix[14] -
-               matrix[8]  * matrix[6]  * matrix[13] -
-               matrix[12] * matrix[5]  * matrix[10] +
-               matrix[12] * matrix[6]  * matrix[9];
-
-    inv[1] = -matrix[1]  * matrix[10] * matrix[15] +
-              matrix[1]  * matrix[11] * matrix[14] +
-              matrix[9]  * matrix[2]  * matrix[15] -
-              matrix[9]  * matrix[3]  * matrix[14] -
-              matrix[13] * matrix[2]  * matrix[11] +
-              matrix[13] * matrix[3]  * matrix[10];
-
-    inv[5] = matrix[0]  * matrix[10] * matrix[15] -
-             matrix[0]  * matrix[11] * matrix[14] -
-             matrix[8]  * matrix[2]  * matrix[15] +
-             matrix[8]  * matrix[3]  * matrix[14] +
-             matrix[12] * matrix[2]  * matrix[11] -
-             matrix[12] * matrix[3]  * matrix[10];
-
-    inv[9] = -matrix[0]  * matrix[9]  * matrix[15] +
-              matrix[0]  * matrix[11] * matrix[13] +
-              matrix[8]  * matrix[1]  * matrix[15] -
-              matrix[8]  * matrix[3]  * matrix[13] -
-              matrix[12] * matrix[1]  * matrix[11] +
-              matrix[12] * matrix[3]  * matrix[9];
-
-    inv[13] = matrix[0]  * matrix[9]  * matrix[14] -
-              matrix[0]  * matrix[10] * matrix[13] -
-              matrix[8]  * matrix[1]  * matrix[14] +
-              matrix[8]  * matrix[2]  * matrix[13] +
-              matrix[12] * matrix[1]  * matrix[10] -
-              matrix[12] * matrix[2]  * matrix[9];
-
-    inv[2] = matrix[1]  * matrix[6] * matrix[15] -
-             matrix[1]  * matrix[7] * matrix[14] -
-             matrix[5]  * matrix[2] * matrix[15] +
-             matrix[5]  * matrix[3] * matrix[14] +
-             matrix[13] * matrix[2] * matrix[7] -
-             matrix[13] * matrix[3] * matrix[6];
-
-    inv[6] = -matrix[0]  * matrix[6] * matrix[15] +
-              matrix[0]  * matrix[7] * matrix[14] +
-              matrix[4]  * matrix[2] * matrix[15] -
-              matrix[4]  * matrix[3] * matrix[14] -
-              matrix[12] * matrix[2] * matrix[7] +
-              matrix[12] * matrix[3] * matrix[6];
-
-    inv[10] = matrix[0]  * matrix[5] * matrix[15] -
-              matrix[0]  * matrix[7] * matrix[13] -
-              matrix[4]  * matrix[1] * matrix[15] +
-              matrix[4]  * matrix[3] * matrix[13] +
-              matrix[12] * matrix[1] * matrix[7] -
-              matrix[12] * matrix[3] * matrix[5];
-
-    inv[14] = -matrix[0]  * matrix[5] * matrix[14] +
-               matrix[0]  * matrix[6] * matrix[13] +
-               matrix[4]  * matrix[1] * matrix[14] -
-               matrix[4]  * matrix[2] * matrix[13] -
-               matrix[12] * matrix[1] * matrix[6] +
-               matrix[12] * matrix[2] * matrix[5];
-
-    inv[3] = -matrix[1] * matrix[6] * matrix[11] +
-              matrix[1] * matrix[7] * matrix[10] +
-              matrix[5] * matrix[2] * matrix[11] -
-              matrix[5] * matrix[3] * matrix[10] -
-              matrix[9] * matrix[2] * matrix[7] +
-              matrix[9] * matrix[3] * matrix[6];
-
-    inv[7] = matrix[0] * matrix[6] * matrix[11] -
-             matrix[0] * matrix[7] * matrix[10] -
-             matrix[4] * matrix[2] * matrix[11] +
-             matrix[4] * matrix[3] * matrix[10] +
-             matrix[8] * matrix[2] * matrix[7] -
-             matrix[8] * matrix[3] * matrix[6];
-
-    inv[11] = -matrix[0] * matrix[5] * matrix[11] +
-               matrix[0] * matrix[7] * matrix[9] +
-               matrix[4] * matrix[1] * matrix[11] -
-               matrix[4] * matrix[3] * matrix[9] -
-               matrix[8] * matrix[1] * matrix[7] +
-               matrix[8] * matrix[3] * matrix[5];
-
-    inv[15] = matrix[0] * matrix[5] * matrix[10] -
-              matrix[0] * matrix[6] * matrix[9] -
-              matrix[4] * matrix[1] * matrix[10] +
-              matrix[4] * matrix[2] * matrix[9] +
-              matrix[8] * matrix[1] * matrix[6] -
-              matrix[8] * matrix[2] * matrix[5];
-
-    float det = matrix[0] * inv[0] + matrix[1] * inv[4] + matrix[2] * inv[8] + matrix[3] * inv[12];
-
-    if( det == 0 )
-        return false;
-
-    det = 1.0 / det;
-
-    for( int i = 0; i < 16; i++ )
-        matrix[i] = inv[i] * det;
-
-    return true;
+    return NMatrixFunc::Invert( matrix, matrix );
 }
 
 
@@ -1070,16 +947,7 @@ CMatrix CMatrix::operator * ( const CMatrix & obj ) const
 {
     float tmp[mMax];
 
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        {
-            tmp[(i*4)+j] =   (matrix[i*4]     * obj[j])
-                           + (matrix[(i*4)+1] * obj[4+j])
-                           + (matrix[(i*4)+2] * obj[8+j])
-                           + (matrix[(i*4)+3] * obj[12+j]);
-        }
-    }
+    NMatrixFunc::Multiply( tmp, matrix, obj.matrix );
 
     return CMatrix(tmp);
 }
@@ -1090,21 +958,7 @@ CMatrix CMatrix::operator * ( const CMatrix & obj ) const
 ************************************************************************/
 CMatrix CMatrix::operator *= ( const CMatrix & obj )
 {
-    float tmp[mMax];
-
-    for( int i = 0; i < 4; ++i )
-    {
-        for( int j = 0; j < 4; ++j )
-        {
-            tmp[(i*4)+j] =    (matrix[i*4]     * obj[j])
-                            + (matrix[(i*4)+1] * obj[4+j])
-                            + (matrix[(i*4)+2] * obj[8+j])
-                            + (matrix[(i*4)+3] * obj[12+j]);
-        }
-    }
-
-    // Copy the tmp matrix to the class matrix
-    std::memcpy( matrix, tmp, sizeof(tmp) );
+    NMatrixFunc::Multiply( matrix, matrix, obj.matrix );
 
     return *this;
 }
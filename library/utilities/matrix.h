@@ -17,6 +17,7 @@
 
 // Standard lib dependencies
 #include <cstdint>
+#include <cstddef>
 
 enum
 {
@@ -72,10 +73,19 @@ public:
     void transform( CRect<float> & dest, const CRect<float> & source ) const;
     void transform( CQuad & dest, const CQuad & source ) const;
     void transform3x3( CPoint<float> & dest, const CPoint<float> & source ) const;
+
+    // Transform an array of points using the master matrix
+    void transformPoints( CPoint<float> * pDest, const CPoint<float> * pSource, size_t count ) const;
     
     // Merge matrix into master matrix
     void mergeMatrix( const CMatrix & obj );
 
+    // this = a * b. Cheaper when a is a 2D affine matrix
+    void multiply( const CMatrix & a, const CMatrix & b );
+
+    // Does the matrix only rotate about z, scale and translate
+    bool isAffine2D() const;
+
     // Get the transpose of a matrix
     CMatrix getTransposeMatrix() const;
 
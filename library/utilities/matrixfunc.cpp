@@ -0,0 +1,613 @@
+/************************************************************************
+*    FILE NAME:       matrixfunc.cpp
+*
+*    DESCRIPTION:     4x4 matrix kernels used by CMatrix
+*                     SSE or NEON is chosen at compile time with a
+*                     scalar fallback. Both paths do the same float
+*                     operations in the same order so they give the
+*                     same results, bit for bit.
+*
+*    NOTE:            This file needs to be built without multiply-add
+*                     contraction (-ffp-contract=off) or the compiler
+*                     is free to fuse the scalar path differently.
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/matrixfunc.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+#if defined(__matrix_sse__)
+#include <xmmintrin.h>
+#elif defined(__matrix_neon__)
+#include <arm_neon.h>
+#endif
+
+static_assert( sizeof(CPoint<float>) == sizeof(float) * 3, "CPoint<float> needs to be packed to transform arrays" );
+
+namespace NMatrixFunc
+{
+    /************************************************************************
+    *    DESC:  2x2 sub determinants of the top two rows and the bottom two
+    *           rows used for the inverse. Done the same way by both paths
+    *
+    *    ret:   float - determinant of the matrix
+    ************************************************************************/
+    float SubDeterminants( const float m[16], float s[6], float c[6] )
+    {
+        s[0] = m[0] * m[5] - m[4] * m[1];
+        s[1] = m[0] * m[6] - m[4] * m[2];
+        s[2] = m[0] * m[7] - m[4] * m[3];
+        s[3] = m[1] * m[6] - m[5] * m[2];
+        s[4] = m[1] * m[7] - m[5] * m[3];
+        s[5] = m[2] * m[7] - m[6] * m[3];
+
+        c[5] = m[10] * m[15] - m[14] * m[11];
+        c[4] = m[9]  * m[15] - m[13] * m[11];
+        c[3] = m[9]  * m[14] - m[13] * m[10];
+        c[2] = m[8]  * m[15] - m[12] * m[11];
+        c[1] = m[8]  * m[14] - m[12] * m[10];
+        c[0] = m[8]  * m[13] - m[12] * m[9];
+
+        return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+    }
+
+
+    /************************************************************************
+    *    DESC:  Name of the path selected at compile time
+    ************************************************************************/
+    const char * GetSimdName()
+    {
+        #if defined(__matrix_sse__)
+        return "SSE";
+        #elif defined(__matrix_neon__)
+        return "NEON";
+        #else
+        return "Scalar";
+        #endif
+    }
+
+
+    /************************************************************************
+    *    DESC:  dest = a * b
+    ************************************************************************/
+    void MultiplyScalar( float dest[16], const float a[16], const float b[16] )
+    {
+        float tmp[16];
+
+        for( int i = 0; i < 4; ++i )
+        {
+            for( int j = 0; j < 4; ++j )
+            {
+                tmp[(i*4)+j] = (a[i*4]     * b[j])
+                             + (a[(i*4)+1] * b[4+j])
+                             + (a[(i*4)+2] * b[8+j])
+                             + (a[(i*4)+3] * b[12+j]);
+            }
+        }
+
+        std::memcpy( dest, tmp, sizeof(tmp) );
+    }
+
+    void Multiply( float dest[16], const float a[16], const float b[16] )
+    {
+        #if defined(__matrix_sse__)
+        const __m128 b0 = _mm_loadu_ps( b );
+        const __m128 b1 = _mm_loadu_ps( b + 4 );
+        const __m128 b2 = _mm_loadu_ps( b + 8 );
+        const __m128 b3 = _mm_loadu_ps( b + 12 );
+
+        __m128 row[4];
+
+        for( int i = 0; i < 4; ++i )
+        {
+            const float * pA = a + (i*4);
+
+            row[i] = _mm_mul_ps( _mm_set1_ps( pA[0] ), b0 );
+            row[i] = _mm_add_ps( row[i], _mm_mul_ps( _mm_set1_ps( pA[1] ), b1 ) );
+            row[i] = _mm_add_ps( row[i], _mm_mul_ps( _mm_set1_ps( pA[2] ), b2 ) );
+            row[i] = _mm_add_ps( row[i], _mm_mul_ps( _mm_set1_ps( pA[3] ), b3 ) );
+        }
+
+        // Store after all the loads so dest can be a or b
+        for( int i = 0; i < 4; ++i )
+            _mm_storeu_ps( dest + (i*4), row[i] );
+
+        #elif defined(__matrix_neon__)
+        const float32x4_t b0 = vld1q_f32( b );
+        const float32x4_t b1 = vld1q_f32( b + 4 );
+        const float32x4_t b2 = vld1q_f32( b + 8 );
+        const float32x4_t b3 = vld1q_f32( b + 12 );
+
+        float32x4_t row[4];
+
+        // vmla may be fused on some targets so the multiply and add are kept separate
+        for( int i = 0; i < 4; ++i )
+        {
+            const float * pA = a + (i*4);
+
+            row[i] = vmulq_f32( vdupq_n_f32( pA[0] ), b0 );
+            row[i] = vaddq_f32( row[i], vmulq_f32( vdupq_n_f32( pA[1] ), b1 ) );
+            row[i] = vaddq_f32( row[i], vmulq_f32( vdupq_n_f32( pA[2] ), b2 ) );
+            row[i] = vaddq_f32( row[i], vmulq_f32( vdupq_n_f32( pA[3] ), b3 ) );
+        }
+
+        for( int i = 0; i < 4; ++i )
+            vst1q_f32( dest + (i*4), row[i] );
+
+        #else
+        MultiplyScalar( dest, a, b );
+        #endif
+    }
+
+
+    /************************************************************************
+    *    DESC:  dest = a * b where a is a 2D affine matrix
+    *           Only a[0], a[1], a[4], a[5], a[10] and the translation are
+    *           used. The terms that are left are added in the same order
+    *           as Multiply so the results only differ in the sign of zero
+    ************************************************************************/
+    void MultiplyAffine2DScalar( float dest[16], const float a[16], const float b[16] )
+    {
+        float tmp[16];
+
+        for( int j = 0; j < 4; ++j )
+        {
+            tmp[j]    = (a[0] * b[j]) + (a[1] * b[4+j]);
+            tmp[4+j]  = (a[4] * b[j]) + (a[5] * b[4+j]);
+            tmp[8+j]  = a[10] * b[8+j];
+            tmp[12+j] = (((a[12] * b[j]) + (a[13] * b[4+j])) + (a[14] * b[8+j])) + b[12+j];
+        }
+
+        std::memcpy( dest, tmp, sizeof(tmp) );
+    }
+
+    void MultiplyAffine2D( float dest[16], const float a[16], const float b[16] )
+    {
+        #if defined(__matrix_sse__)
+        const __m128 b0 = _mm_loadu_ps( b );
+        const __m128 b1 = _mm_loadu_ps( b + 4 );
+        const __m128 b2 = _mm_loadu_ps( b + 8 );
+        const __m128 b3 = _mm_loadu_ps( b + 12 );
+
+        const __m128 row0 = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( a[0] ), b0 ), _mm_mul_ps( _mm_set1_ps( a[1] ), b1 ) );
+        const __m128 row1 = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( a[4] ), b0 ), _mm_mul_ps( _mm_set1_ps( a[5] ), b1 ) );
+        const __m128 row2 = _mm_mul_ps( _mm_set1_ps( a[10] ), b2 );
+
+        __m128 row3 = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( a[12] ), b0 ), _mm_mul_ps( _mm_set1_ps( a[13] ), b1 ) );
+        row3 = _mm_add_ps( _mm_add_ps( row3, _mm_mul_ps( _mm_set1_ps( a[14] ), b2 ) ), b3 );
+
+        // Store after all the loads so dest can be b
+        _mm_storeu_ps( dest,      row0 );
+        _mm_storeu_ps( dest + 4,  row1 );
+        _mm_storeu_ps( dest + 8,  row2 );
+        _mm_storeu_ps( dest + 12, row3 );
+
+        #elif defined(__matrix_neon__)
+        const float32x4_t b0 = vld1q_f32( b );
+        const float32x4_t b1 = vld1q_f32( b + 4 );
+        const float32x4_t b2 = vld1q_f32( b + 8 );
+        const float32x4_t b3 = vld1q_f32( b + 12 );
+
+        const float32x4_t row0 = vaddq_f32( vmulq_f32( vdupq_n_f32( a[0] ), b0 ), vmulq_f32( vdupq_n_f32( a[1] ), b1 ) );
+        const float32x4_t row1 = vaddq_f32( vmulq_f32( vdupq_n_f32( a[4] ), b0 ), vmulq_f32( vdupq_n_f32( a[5] ), b1 ) );
+        const float32x4_t row2 = vmulq_f32( vdupq_n_f32( a[10] ), b2 );
+
+        float32x4_t row3 = vaddq_f32( vmulq_f32( vdupq_n_f32( a[12] ), b0 ), vmulq_f32( vdupq_n_f32( a[13] ), b1 ) );
+        row3 = vaddq_f32( vaddq_f32( row3, vmulq_f32( vdupq_n_f32( a[14] ), b2 ) ), b3 );
+
+        vst1q_f32( dest,      row0 );
+        vst1q_f32( dest + 4,  row1 );
+        vst1q_f32( dest + 8,  row2 );
+        vst1q_f32( dest + 12, row3 );
+
+        #else
+        MultiplyAffine2DScalar( dest, a, b );
+        #endif
+    }
+
+
+    /************************************************************************
+    *    DESC:  Transform a point by the matrix
+    ************************************************************************/
+    void TransformPointScalar( CPoint<float> & dest, const CPoint<float> & source, const float mat[16] )
+    {
+        const float x = source.x;
+        const float y = source.y;
+        const float z = source.z;
+
+        dest.x = ( x * mat[ 0 ] )
+               + ( y * mat[ 4 ] )
+               + ( z * mat[ 8 ] )
+               + mat[ 12 ];
+
+        dest.y = ( x * mat[ 1 ] )
+               + ( y * mat[ 5 ] )
+               + ( z * mat[ 9 ] )
+               + mat[ 13 ];
+
+        dest.z = ( x * mat[ 2 ] )
+               + ( y * mat[ 6 ] )
+               + ( z * mat[ 10 ] )
+               + mat[ 14 ];
+    }
+
+    void TransformPoint( CPoint<float> & dest, const CPoint<float> & source, const float mat[16] )
+    {
+        #if defined(__matrix_sse__)
+        __m128 result = _mm_mul_ps( _mm_set1_ps( source.x ), _mm_loadu_ps( mat ) );
+        result = _mm_add_ps( result, _mm_mul_ps( _mm_set1_ps( source.y ), _mm_loadu_ps( mat + 4 ) ) );
+        result = _mm_add_ps( result, _mm_mul_ps( _mm_set1_ps( source.z ), _mm_loadu_ps( mat + 8 ) ) );
+        result = _mm_add_ps( result, _mm_loadu_ps( mat + 12 ) );
+
+        float tmp[4];
+        _mm_storeu_ps( tmp, result );
+        std::memcpy( &dest, tmp, sizeof(CPoint<float>) );
+
+        #elif defined(__matrix_neon__)
+        float32x4_t result = vmulq_f32( vdupq_n_f32( source.x ), vld1q_f32( mat ) );
+        result = vaddq_f32( result, vmulq_f32( vdupq_n_f32( source.y ), vld1q_f32( mat + 4 ) ) );
+        result = vaddq_f32( result, vmulq_f32( vdupq_n_f32( source.z ), vld1q_f32( mat + 8 ) ) );
+        result = vaddq_f32( result, vld1q_f32( mat + 12 ) );
+
+        float tmp[4];
+        vst1q_f32( tmp, result );
+        std::memcpy( &dest, tmp, sizeof(CPoint<float>) );
+
+        #else
+        TransformPointScalar( dest, source, mat );
+        #endif
+    }
+
+
+    /************************************************************************
+    *    DESC:  Transform an array of points by the matrix
+    ************************************************************************/
+    void TransformPointsScalar( CPoint<float> * pDest, const CPoint<float> * pSource, size_t count, const float mat[16] )
+    {
+        for( size_t i = 0; i < count; ++i )
+            TransformPointScalar( pDest[i], pSource[i], mat );
+    }
+
+    void TransformPoints( CPoint<float> * pDest, const CPoint<float> * pSource, size_t count, const float mat[16] )
+    {
+        size_t i = 0;
+
+        #if defined(__matrix_sse__)
+        const __m128 m0 = _mm_set1_ps( mat[0] ),  m1 = _mm_set1_ps( mat[1] ),  m2 = _mm_set1_ps( mat[2] );
+        const __m128 m4 = _mm_set1_ps( mat[4] ),  m5 = _mm_set1_ps( mat[5] ),  m6 = _mm_set1_ps( mat[6] );
+        const __m128 m8 = _mm_set1_ps( mat[8] ),  m9 = _mm_set1_ps( mat[9] ),  m10 = _mm_set1_ps( mat[10] );
+        const __m128 m12 = _mm_set1_ps( mat[12] ), m13 = _mm_set1_ps( mat[13] ), m14 = _mm_set1_ps( mat[14] );
+
+        // Four points at a time. Shuffle xyz xyz xyz xyz into xxxx yyyy zzzz
+        for( ; i + 4 <= count; i += 4 )
+        {
+            const float * pIn = &pSource[i].x;
+            const __m128 a = _mm_loadu_ps( pIn );     // x0 y0 z0 x1
+            const __m128 b = _mm_loadu_ps( pIn + 4 ); // y1 z1 x2 y2
+            const __m128 c = _mm_loadu_ps( pIn + 8 ); // z2 x3 y3 z3
+
+            const __m128 x = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, _MM_SHUFFLE(1,0,0,2) ), _MM_SHUFFLE(3,0,3,0) );
+            const __m128 y = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE(0,0,0,1) ), _mm_shuffle_ps( b, c, _MM_SHUFFLE(0,2,0,3) ), _MM_SHUFFLE(2,0,2,0) );
+            const __m128 z = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE(0,1,0,2) ), _mm_shuffle_ps( c, c, _MM_SHUFFLE(0,3,0,0) ), _MM_SHUFFLE(2,0,2,0) );
+
+            const __m128 rx = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m0 ), _mm_mul_ps( y, m4 ) ), _mm_mul_ps( z, m8 ) ), m12 );
+            const __m128 ry = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m1 ), _mm_mul_ps( y, m5 ) ), _mm_mul_ps( z, m9 ) ), m13 );
+            const __m128 rz = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, m2 ), _mm_mul_ps( y, m6 ) ), _mm_mul_ps( z, m10 ) ), m14 );
+
+            // Shuffle back to xyz xyz xyz xyz
+            const __m128 xy01 = _mm_unpacklo_ps( rx, ry ); // x0 y0 x1 y1
+            const __m128 xy23 = _mm_unpackhi_ps( rx, ry ); // x2 y2 x3 y3
+
+            float * pOut = &pDest[i].x;
+            _mm_storeu_ps( pOut, _mm_shuffle_ps( xy01, _mm_shuffle_ps( rz, xy01, _MM_SHUFFLE(2,2,0,0) ), _MM_SHUFFLE(2,0,1,0) ) );
+            _mm_storeu_ps( pOut + 4, _mm_shuffle_ps( _mm_shuffle_ps( xy01, rz, _MM_SHUFFLE(1,1,3,3) ), xy23, _MM_SHUFFLE(1,0,2,0) ) );
+            _mm_storeu_ps( pOut + 8, _mm_shuffle_ps( _mm_shuffle_ps( rz, xy23, _MM_SHUFFLE(2,2,2,2) ), _mm_shuffle_ps( xy23, rz, _MM_SHUFFLE(3,3,3,3) ), _MM_SHUFFLE(2,0,2,0) ) );
+        }
+
+        #elif defined(__matrix_neon__)
+        const float32x4_t m0 = vdupq_n_f32( mat[0] ),  m1 = vdupq_n_f32( mat[1] ),  m2 = vdupq_n_f32( mat[2] );
+        const float32x4_t m4 = vdupq_n_f32( mat[4] ),  m5 = vdupq_n_f32( mat[5] ),  m6 = vdupq_n_f32( mat[6] );
+        const float32x4_t m8 = vdupq_n_f32( mat[8] ),  m9 = vdupq_n_f32( mat[9] ),  m10 = vdupq_n_f32( mat[10] );
+        const float32x4_t m12 = vdupq_n_f32( mat[12] ), m13 = vdupq_n_f32( mat[13] ), m14 = vdupq_n_f32( mat[14] );
+
+        // Four points at a time. vld3 splits xyz xyz xyz xyz into xxxx yyyy zzzz
+        for( ; i + 4 <= count; i += 4 )
+        {
+            const float32x4x3_t in = vld3q_f32( &pSource[i].x );
+            float32x4x3_t out;
+
+            out.val[0] = vaddq_f32( vaddq_f32( vaddq_f32( vmulq_f32( in.val[0], m0 ), vmulq_f32( in.val[1], m4 ) ), vmulq_f32( in.val[2], m8 ) ), m12 );
+            out.val[1] = vaddq_f32( vaddq_f32( vaddq_f32( vmulq_f32( in.val[0], m1 ), vmulq_f32( in.val[1], m5 ) ), vmulq_f32( in.val[2], m9 ) ), m13 );
+            out.val[2] = vaddq_f32( vaddq_f32( vaddq_f32( vmulq_f32( in.val[0], m2 ), vmulq_f32( in.val[1], m6 ) ), vmulq_f32( in.val[2], m10 ) ), m14 );
+
+            vst3q_f32( &pDest[i].x, out );
+        }
+        #endif
+
+        // What's left over
+        for( ; i < count; ++i )
+            TransformPoint( pDest[i], pSource[i], mat );
+    }
+
+
+    /************************************************************************
+    *    DESC:  General 4x4 inverse using 2x2 sub determinants
+    *
+    *           Each output row is worked out a lane at a time the same
+    *           way the SIMD path does it. The source rows are used in
+    *           the order 1,0,3,2 and the first two lanes use the bottom
+    *           sub determinants, the last two the top
+    *
+    *    ret:   bool - false if the matrix can't be inverted
+    ************************************************************************/
+    bool InvertScalar( float dest[16], const float mat[16] )
+    {
+        static const int SOURCE_ROW[4] = { 1, 0, 3, 2 };
+        static const int COLUMN[4][3] = { {1,2,3}, {0,2,3}, {0,1,3}, {0,1,2} };
+        static const int SUB_DET[4][3] = { {5,4,3}, {5,2,1}, {4,2,0}, {3,1,0} };
+
+        float s[6], c[6];
+        const float det = SubDeterminants( mat, s, c );
+
+        if( det == 0 )
+            return false;
+
+        const float invDet = 1.0 / det;
+
+        float tmp[16];
+
+        for( int row = 0; row < 4; ++row )
+        {
+            for( int lane = 0; lane < 4; ++lane )
+            {
+                const float * pSub = (lane < 2) ? c : s;
+                const float * pRow = mat + (SOURCE_ROW[lane] * 4);
+
+                float value = (pRow[COLUMN[row][0]] * pSub[SUB_DET[row][0]] - pRow[COLUMN[row][1]] * pSub[SUB_DET[row][1]])
+                            + pRow[COLUMN[row][2]] * pSub[SUB_DET[row][2]];
+
+                // Signs alternate like a checker board
+                if( ((row + lane) & 1) != 0 )
+                    value = -value;
+
+                tmp[(row * 4) + lane] = value * invDet;
+            }
+        }
+
+        std::memcpy( dest, tmp, sizeof(tmp) );
+
+        return true;
+    }
+
+    bool Invert( float dest[16], const float mat[16] )
+    {
+        #if defined(__matrix_sse__) || defined(__matrix_neon__)
+        float s[6], c[6];
+        const float det = SubDeterminants( mat, s, c );
+
+        if( det == 0 )
+            return false;
+
+        const float invDet = 1.0 / det;
+        #endif
+
+        #if defined(__matrix_sse__)
+        const __m128 r0 = _mm_loadu_ps( mat );
+        const __m128 r1 = _mm_loadu_ps( mat + 4 );
+        const __m128 r2 = _mm_loadu_ps( mat + 8 );
+        const __m128 r3 = _mm_loadu_ps( mat + 12 );
+
+        // Columns with the rows in the order 1,0,3,2
+        const __m128 t0 = _mm_shuffle_ps( r1, r0, _MM_SHUFFLE(1,0,1,0) );
+        const __m128 t1 = _mm_shuffle_ps( r3, r2, _MM_SHUFFLE(1,0,1,0) );
+        const __m128 t2 = _mm_shuffle_ps( r1, r0, _MM_SHUFFLE(3,2,3,2) );
+        const __m128 t3 = _mm_shuffle_ps( r3, r2, _MM_SHUFFLE(3,2,3,2) );
+
+        const __m128 col0 = _mm_shuffle_ps( t0, t1, _MM_SHUFFLE(2,0,2,0) );
+        const __m128 col1 = _mm_shuffle_ps( t0, t1, _MM_SHUFFLE(3,1,3,1) );
+        const __m128 col2 = _mm_shuffle_ps( t2, t3, _MM_SHUFFLE(2,0,2,0) );
+        const __m128 col3 = _mm_shuffle_ps( t2, t3, _MM_SHUFFLE(3,1,3,1) );
+
+        __m128 k[6];
+        for( int i = 0; i < 6; ++i )
+            k[i] = _mm_setr_ps( c[i], c[i], s[i], s[i] );
+
+        const __m128 signA = _mm_setr_ps( 0.f, -0.f, 0.f, -0.f );
+        const __m128 signB = _mm_setr_ps( -0.f, 0.f, -0.f, 0.f );
+        const __m128 scale = _mm_set1_ps( invDet );
+
+        const __m128 row0 = _mm_xor_ps( _mm_add_ps( _mm_sub_ps( _mm_mul_ps( col1, k[5] ), _mm_mul_ps( col2, k[4] ) ), _mm_mul_ps( col3, k[3] ) ), signA );
+        const __m128 row1 = _mm_xor_ps( _mm_add_ps( _mm_sub_ps( _mm_mul_ps( col0, k[5] ), _mm_mul_ps( col2, k[2] ) ), _mm_mul_ps( col3, k[1] ) ), signB );
+        const __m128 row2 = _mm_xor_ps( _mm_add_ps( _mm_sub_ps( _mm_mul_ps( col0, k[4] ), _mm_mul_ps( col1, k[2] ) ), _mm_mul_ps( col3, k[0] ) ), signA );
+        const __m128 row3 = _mm_xor_ps( _mm_add_ps( _mm_sub_ps( _mm_mul_ps( col0, k[3] ), _mm_mul_ps( col1, k[1] ) ), _mm_mul_ps( col2, k[0] ) ), signB );
+
+        _mm_storeu_ps( dest,      _mm_mul_ps( row0, scale ) );
+        _mm_storeu_ps( dest + 4,  _mm_mul_ps( row1, scale ) );
+        _mm_storeu_ps( dest + 8,  _mm_mul_ps( row2, scale ) );
+        _mm_storeu_ps( dest + 12, _mm_mul_ps( row3, scale ) );
+
+        return true;
+
+        #elif defined(__matrix_neon__)
+        const float col0Buf[4] = { mat[4], mat[0], mat[12], mat[8] };
+        const float col1Buf[4] = { mat[5], mat[1], mat[13], mat[9] };
+        const float col2Buf[4] = { mat[6], mat[2], mat[14], mat[10] };
+        const float col3Buf[4] = { mat[7], mat[3], mat[15], mat[11] };
+
+        const float32x4_t col0 = vld1q_f32( col0Buf );
+        const float32x4_t col1 = vld1q_f32( col1Buf );
+        const float32x4_t col2 = vld1q_f32( col2Buf );
+        const float32x4_t col3 = vld1q_f32( col3Buf );
+
+        float32x4_t k[6];
+        for( int i = 0; i < 6; ++i )
+        {
+            const float kBuf[4] = { c[i], c[i], s[i], s[i] };
+            k[i] = vld1q_f32( kBuf );
+        }
+
+        const uint32_t signABuf[4] = { 0, 0x80000000, 0, 0x80000000 };
+        const uint32_t signBBuf[4] = { 0x80000000, 0, 0x80000000, 0 };
+        const uint32x4_t signA = vld1q_u32( signABuf );
+        const uint32x4_t signB = vld1q_u32( signBBuf );
+        const float32x4_t scale = vdupq_n_f32( invDet );
+
+        const float32x4_t row0 = vaddq_f32( vsubq_f32( vmulq_f32( col1, k[5] ), vmulq_f32( col2, k[4] ) ), vmulq_f32( col3, k[3] ) );
+        const float32x4_t row1 = vaddq_f32( vsubq_f32( vmulq_f32( col0, k[5] ), vmulq_f32( col2, k[2] ) ), vmulq_f32( col3, k[1] ) );
+        const float32x4_t row2 = vaddq_f32( vsubq_f32( vmulq_f32( col0, k[4] ), vmulq_f32( col1, k[2] ) ), vmulq_f32( col3, k[0] ) );
+        const float32x4_t row3 = vaddq_f32( vsubq_f32( vmulq_f32( col0, k[3] ), vmulq_f32( col1, k[1] ) ), vmulq_f32( col2, k[0] ) );
+
+        vst1q_f32( dest,      vmulq_f32( vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( row0 ), signA ) ), scale ) );
+        vst1q_f32( dest + 4,  vmulq_f32( vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( row1 ), signB ) ), scale ) );
+        vst1q_f32( dest + 8,  vmulq_f32( vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( row2 ), signA ) ), scale ) );
+        vst1q_f32( dest + 12, vmulq_f32( vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( row3 ), signB ) ), scale ) );
+
+        return true;
+
+        #else
+        return InvertScalar( dest, mat );
+        #endif
+    }
+
+
+    /************************************************************************
+    *    DESC:  Sin and cos of an array of angles in radians
+    *
+    *           The angle is reduced to +-pi/4 and the number of quarter
+    *           turns picks the sign and which of the sin and cos fits is
+    *           used. The fits are the ones in the cephes library. Good to
+    *           about 1e-7 for the angles a game uses. Adding SC_ROUND
+    *           rounds a float to a whole number
+    ************************************************************************/
+    const float SC_2_OVER_PI = 0.636619772367581343f;
+    const float SC_ROUND = 12582912.f;
+    const float SC_PI_2_A = 1.5703125f;
+    const float SC_PI_2_B = 4.837512969970703125e-4f;
+    const float SC_PI_2_C = 7.54978995489188216e-8f;
+    const float SC_SIN_0 = -1.9515295891e-4f;
+    const float SC_SIN_1 = 8.3321608736e-3f;
+    const float SC_SIN_2 = -1.6666654611e-1f;
+    const float SC_COS_0 = 2.443315711809948e-5f;
+    const float SC_COS_1 = -1.388731625493765e-3f;
+    const float SC_COS_2 = 4.166664568298827e-2f;
+
+    void SinCosScalar( float * pSin, float * pCos, const float * pAngle, size_t count )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            const float angle = pAngle[i];
+            const float j = ((angle * SC_2_OVER_PI) + SC_ROUND) - SC_ROUND;
+            const float r = ((angle - (j * SC_PI_2_A)) - (j * SC_PI_2_B)) - (j * SC_PI_2_C);
+            const float z = r * r;
+
+            const float s = ((((((SC_SIN_0 * z) + SC_SIN_1) * z) + SC_SIN_2) * z) * r) + r;
+            const float c = (((((((SC_COS_0 * z) + SC_COS_1) * z) + SC_COS_2) * z) * z) - (0.5f * z)) + 1.f;
+
+            const int quarter = static_cast<int>(j) & 3;
+
+            float sinValue = (quarter & 1) ? c : s;
+            float cosValue = (quarter & 1) ? s : c;
+
+            if( (quarter & 2) != 0 )
+                sinValue = -sinValue;
+
+            if( ((quarter + 1) & 2) != 0 )
+                cosValue = -cosValue;
+
+            pSin[i] = sinValue;
+            pCos[i] = cosValue;
+        }
+    }
+
+    void SinCos( float * pSin, float * pCos, const float * pAngle, size_t count )
+    {
+        size_t i = 0;
+
+        #if defined(__matrix_sse__)
+        const __m128 twoOverPi = _mm_set1_ps( SC_2_OVER_PI );
+        const __m128 roundValue = _mm_set1_ps( SC_ROUND );
+        const __m128 piA = _mm_set1_ps( SC_PI_2_A );
+        const __m128 piB = _mm_set1_ps( SC_PI_2_B );
+        const __m128 piC = _mm_set1_ps( SC_PI_2_C );
+        const __m128 sin0 = _mm_set1_ps( SC_SIN_0 ), sin1 = _mm_set1_ps( SC_SIN_1 ), sin2 = _mm_set1_ps( SC_SIN_2 );
+        const __m128 cos0 = _mm_set1_ps( SC_COS_0 ), cos1 = _mm_set1_ps( SC_COS_1 ), cos2 = _mm_set1_ps( SC_COS_2 );
+        const __m128 half = _mm_set1_ps( 0.5f );
+        const __m128 one = _mm_set1_ps( 1.f );
+        const __m128 signBit = _mm_set1_ps( -0.f );
+
+        // Is the whole number odd. Half of it doesn't round to itself
+        auto isOdd = [half, roundValue]( __m128 value )
+        {
+            const __m128 halfValue = _mm_mul_ps( value, half );
+            return _mm_cmpneq_ps( halfValue, _mm_sub_ps( _mm_add_ps( halfValue, roundValue ), roundValue ) );
+        };
+
+        for( ; i + 4 <= count; i += 4 )
+        {
+            const __m128 angle = _mm_loadu_ps( pAngle + i );
+            const __m128 j = _mm_sub_ps( _mm_add_ps( _mm_mul_ps( angle, twoOverPi ), roundValue ), roundValue );
+            const __m128 r = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( angle, _mm_mul_ps( j, piA ) ), _mm_mul_ps( j, piB ) ), _mm_mul_ps( j, piC ) );
+            const __m128 z = _mm_mul_ps( r, r );
+
+            const __m128 s = _mm_add_ps( _mm_mul_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( sin0, z ), sin1 ), z ), sin2 ), z ), r ), r );
+            const __m128 c = _mm_add_ps( _mm_sub_ps( _mm_mul_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( cos0, z ), cos1 ), z ), cos2 ), z ), z ), _mm_mul_ps( half, z ) ), one );
+
+            // The quarter turns. Odd swaps the fits, the second bit negates the sin
+            // and the second bit of one more negates the cos
+            const __m128 odd = isOdd( j );
+            const __m128 oddValue = _mm_and_ps( odd, one );
+            const __m128 sinNeg = isOdd( _mm_mul_ps( _mm_sub_ps( j, oddValue ), half ) );
+            const __m128 cosNeg = isOdd( _mm_mul_ps( _mm_add_ps( j, oddValue ), half ) );
+
+            __m128 sinValue = _mm_or_ps( _mm_and_ps( odd, c ), _mm_andnot_ps( odd, s ) );
+            __m128 cosValue = _mm_or_ps( _mm_and_ps( odd, s ), _mm_andnot_ps( odd, c ) );
+            sinValue = _mm_xor_ps( sinValue, _mm_and_ps( sinNeg, signBit ) );
+            cosValue = _mm_xor_ps( cosValue, _mm_and_ps( cosNeg, signBit ) );
+
+            _mm_storeu_ps( pSin + i, sinValue );
+            _mm_storeu_ps( pCos + i, cosValue );
+        }
+
+        #elif defined(__matrix_neon__)
+        const float32x4_t twoOverPi = vdupq_n_f32( SC_2_OVER_PI );
+        const float32x4_t roundValue = vdupq_n_f32( SC_ROUND );
+        const float32x4_t piA = vdupq_n_f32( SC_PI_2_A );
+        const float32x4_t piB = vdupq_n_f32( SC_PI_2_B );
+        const float32x4_t piC = vdupq_n_f32( SC_PI_2_C );
+        const float32x4_t sin0 = vdupq_n_f32( SC_SIN_0 ), sin1 = vdupq_n_f32( SC_SIN_1 ), sin2 = vdupq_n_f32( SC_SIN_2 );
+        const float32x4_t cos0 = vdupq_n_f32( SC_COS_0 ), cos1 = vdupq_n_f32( SC_COS_1 ), cos2 = vdupq_n_f32( SC_COS_2 );
+        const float32x4_t half = vdupq_n_f32( 0.5f );
+        const float32x4_t one = vdupq_n_f32( 1.f );
+        const int32x4_t bit0 = vdupq_n_s32( 1 );
+        const int32x4_t bit1 = vdupq_n_s32( 2 );
+
+        for( ; i + 4 <= count; i += 4 )
+        {
+            const float32x4_t angle = vld1q_f32( pAngle + i );
+            const float32x4_t j = vsubq_f32( vaddq_f32( vmulq_f32( angle, twoOverPi ), roundValue ), roundValue );
+            const float32x4_t r = vsubq_f32( vsubq_f32( vsubq_f32( angle, vmulq_f32( j, piA ) ), vmulq_f32( j, piB ) ), vmulq_f32( j, piC ) );
+            const float32x4_t z = vmulq_f32( r, r );
+
+            const float32x4_t s = vaddq_f32( vmulq_f32( vmulq_f32( vaddq_f32( vmulq_f32( vaddq_f32( vmulq_f32( sin0, z ), sin1 ), z ), sin2 ), z ), r ), r );
+            const float32x4_t c = vaddq_f32( vsubq_f32( vmulq_f32( vmulq_f32( vaddq_f32( vmulq_f32( vaddq_f32( vmulq_f32( cos0, z ), cos1 ), z ), cos2 ), z ), z ), vmulq_f32( half, z ) ), one );
+
+            // The quarter turns. Odd swaps the fits, the second bit negates the sin
+            // and the second bit of one more negates the cos
+            const int32x4_t quarter = vcvtq_s32_f32( j );
+            const uint32x4_t odd = vceqq_s32( vandq_s32( quarter, bit0 ), bit0 );
+            const uint32x4_t sinNeg = vshlq_n_u32( vreinterpretq_u32_s32( vandq_s32( quarter, bit1 ) ), 30 );
+            const uint32x4_t cosNeg = vshlq_n_u32( vreinterpretq_u32_s32( vandq_s32( vaddq_s32( quarter, bit0 ), bit1 ) ), 30 );
+
+            const float32x4_t sinValue = vbslq_f32( odd, c, s );
+            const float32x4_t cosValue = vbslq_f32( odd, s, c );
+
+            vst1q_f32( pSin + i, vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( sinValue ), sinNeg ) ) );
+            vst1q_f32( pCos + i, vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( cosValue ), cosNeg ) ) );
+        }
+        #endif
+
+        SinCosScalar( pSin + i, pCos + i, pAngle + i, count - i );
+    }
+}
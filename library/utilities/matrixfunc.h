@@ -0,0 +1,62 @@
+/************************************************************************
+*    FILE NAME:       matrixfunc.h
+*
+*    DESCRIPTION:     4x4 matrix kernels used by CMatrix
+*                     SSE or NEON is chosen at compile time with a
+*                     scalar fallback. Both paths do the same float
+*                     operations in the same order so they give the
+*                     same results, bit for bit.
+************************************************************************/
+
+#ifndef __matrix_func_h__
+#define __matrix_func_h__
+
+// Game lib dependencies
+#include <common/point.h>
+
+// Standard lib dependencies
+#include <cstddef>
+
+// SIMD disable flag for testing purposes
+//#define __matrix_simd_disable__
+
+#if !defined(__matrix_simd_disable__)
+    #if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+        #define __matrix_sse__
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define __matrix_neon__
+    #endif
+#endif
+
+namespace NMatrixFunc
+{
+    // Name of the path selected at compile time
+    const char * GetSimdName();
+
+    // dest = a * b. dest can be a or b
+    void Multiply( float dest[16], const float a[16], const float b[16] );
+    void MultiplyScalar( float dest[16], const float a[16], const float b[16] );
+
+    // dest = a * b where a only rotates about z, scales and translates
+    // (see CMatrix::isAffine2D). The zero terms of a are skipped. dest can be b
+    void MultiplyAffine2D( float dest[16], const float a[16], const float b[16] );
+    void MultiplyAffine2DScalar( float dest[16], const float a[16], const float b[16] );
+
+    // Transform a point by the matrix
+    void TransformPoint( CPoint<float> & dest, const CPoint<float> & source, const float mat[16] );
+    void TransformPointScalar( CPoint<float> & dest, const CPoint<float> & source, const float mat[16] );
+
+    // Transform an array of points by the matrix. pDest can be pSource
+    void TransformPoints( CPoint<float> * pDest, const CPoint<float> * pSource, size_t count, const float mat[16] );
+    void TransformPointsScalar( CPoint<float> * pDest, const CPoint<float> * pSource, size_t count, const float mat[16] );
+
+    // General 4x4 inverse. Returns false if the matrix can't be inverted
+    bool Invert( float dest[16], const float mat[16] );
+    bool InvertScalar( float dest[16], const float mat[16] );
+
+    // Sin and cos of an array of angles in radians
+    void SinCos( float * pSin, float * pCos, const float * pAngle, size_t count );
+    void SinCosScalar( float * pSin, float * pCos, const float * pAngle, size_t count );
+}
+
+#endif  // __matrix_func_h__
@@ -0,0 +1,341 @@
+/************************************************************************
+*    FILE NAME:       profiler.cpp
+*
+*    DESCRIPTION:     Per-frame hierarchical CPU profiler
+*                     Zones are timed with a scoped marker and written to
+*                     a ring buffer owned by the thread that ran them, so
+*                     recording never takes a lock. The buffers can be
+*                     summed up per frame for the stat display or saved
+*                     as a chrome://tracing JSON file.
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/profiler.h>
+
+// Game lib dependencies
+#include <utilities/smartpointers.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// SDL lib dependencies
+#include <SDL.h>
+
+// Standard lib dependencies
+#include <algorithm>
+
+namespace
+{
+    // Buffer of the calling thread. Set the first time it records a zone
+    thread_local CProfileBuffer * t_pBuffer = nullptr;
+
+    // Zone totals for the summary
+    class CZoneTotal
+    {
+    public:
+        const char * m_pName;
+        uint32_t m_depth;
+        uint64_t m_firstStart;
+        uint64_t m_total;
+        uint64_t m_max;
+    };
+
+    /************************************************************************
+    *    DESC:  Add the name to the JSON string with the special
+    *           characters escaped
+    ************************************************************************/
+    void AddJsonString( std::string & json, const char * pStr )
+    {
+        json += '"';
+
+        for( ; *pStr != 0; ++pStr )
+        {
+            if( (*pStr == '"') || (*pStr == '\\') )
+                json += '\\';
+
+            if( static_cast<unsigned char>(*pStr) >= 0x20 )
+                json += *pStr;
+        }
+
+        json += '"';
+    }
+}
+
+std::atomic<bool> CProfiler::m_enabled(false);
+
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CProfileBuffer::CProfileBuffer( uint32_t threadIndex ) :
+    m_threadIndex(threadIndex),
+    m_depth(0),
+    m_upSlotArray( new CSlot[CAPACITY] ),
+    m_writeIndex(0)
+{
+}
+
+
+/************************************************************************
+*    DESC:  Record an event. Only called from the owning thread
+************************************************************************/
+void CProfileBuffer::record( const CProfileEvent & event )
+{
+    const uint64_t index = m_writeIndex.load( std::memory_order_relaxed );
+
+    CSlot & slot = m_upSlotArray[index & (CAPACITY - 1)];
+    slot.m_pName.store( event.m_pName, std::memory_order_relaxed );
+    slot.m_start.store( event.m_start, std::memory_order_relaxed );
+    slot.m_end.store( event.m_end, std::memory_order_relaxed );
+    slot.m_frame.store( event.m_frame, std::memory_order_relaxed );
+    slot.m_depth.store( event.m_depth, std::memory_order_relaxed );
+
+    // Publish the event to the readers
+    m_writeIndex.store( index + 1, std::memory_order_release );
+}
+
+
+/************************************************************************
+*    DESC:  Copy out the events still in the buffer, oldest first
+************************************************************************/
+void CProfileBuffer::copy( std::vector<CProfileEvent> & eventVec ) const
+{
+    const uint64_t end = m_writeIndex.load( std::memory_order_acquire );
+    const uint64_t begin = (end > CAPACITY) ? (end - CAPACITY) : 0;
+    const size_t offset = eventVec.size();
+
+    for( uint64_t i = begin; i < end; ++i )
+    {
+        const CSlot & slot = m_upSlotArray[i & (CAPACITY - 1)];
+
+        CProfileEvent event;
+        event.m_pName = slot.m_pName.load( std::memory_order_relaxed );
+        event.m_start = slot.m_start.load( std::memory_order_relaxed );
+        event.m_end = slot.m_end.load( std::memory_order_relaxed );
+        event.m_frame = slot.m_frame.load( std::memory_order_relaxed );
+        event.m_depth = slot.m_depth.load( std::memory_order_relaxed );
+        eventVec.push_back( event );
+    }
+
+    // Keep the copy from moving past the second read of the write index
+    std::atomic_thread_fence( std::memory_order_acquire );
+
+    // The writer doesn't wait on the readers. Anything it wrapped
+    // around and wrote over during the copy, or is writing now, is dropped
+    const uint64_t written = m_writeIndex.load( std::memory_order_acquire ) + 1;
+    if( written > begin + CAPACITY )
+    {
+        const uint64_t overwritten = std::min( written - CAPACITY, end ) - begin;
+        eventVec.erase( eventVec.begin() + offset, eventVec.begin() + offset + overwritten );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CProfiler::CProfiler() :
+    m_frame(0),
+    m_pFrameBuffer(nullptr),
+    m_summaryFrame(0),
+    m_startCounter(CHighResTimer::Instance().getCounter())
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CProfiler::~CProfiler()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Enable/disable recording
+************************************************************************/
+void CProfiler::enable( bool value )
+{
+    m_enabled.store( value, std::memory_order_relaxed );
+}
+
+
+/************************************************************************
+*    DESC:  Get the buffer of the calling thread
+************************************************************************/
+CProfileBuffer * CProfiler::getBuffer()
+{
+    if( t_pBuffer == nullptr )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        m_upBufferVec.emplace_back( new CProfileBuffer( m_upBufferVec.size() ) );
+        t_pBuffer = m_upBufferVec.back().get();
+    }
+
+    return t_pBuffer;
+}
+
+
+/************************************************************************
+*    DESC:  Start a zone on this thread and get it's depth
+************************************************************************/
+uint32_t CProfiler::beginZone()
+{
+    return getBuffer()->m_depth++;
+}
+
+
+/************************************************************************
+*    DESC:  End a zone on this thread
+************************************************************************/
+void CProfiler::endZone( const char * pName, uint64_t start, uint32_t depth )
+{
+    CProfileEvent event;
+    event.m_pName = pName;
+    event.m_start = start;
+    event.m_end = CHighResTimer::Instance().getCounter();
+    event.m_frame = m_frame.load( std::memory_order_relaxed );
+    event.m_depth = depth;
+
+    CProfileBuffer * pBuffer = getBuffer();
+    pBuffer->m_depth = depth;
+    pBuffer->record( event );
+}
+
+
+/************************************************************************
+*    DESC:  Mark the start of a game loop frame
+************************************************************************/
+void CProfiler::beginFrame()
+{
+    if( isEnabled() )
+    {
+        if( m_pFrameBuffer.load( std::memory_order_relaxed ) == nullptr )
+            m_pFrameBuffer.store( getBuffer(), std::memory_order_relaxed );
+
+        m_frame.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the per frame average and max of each zone since the last call
+*           Only the zones of the game loop thread are summed up. Zones
+*           nested deeper than maxDepth are left out. Each zone is listed
+*           as "name avg/max" in ms and indented by depth when the
+*           separator is a new line.
+************************************************************************/
+std::string CProfiler::getSummary( uint32_t maxDepth, const std::string & separator )
+{
+    const uint32_t frame = m_frame.load( std::memory_order_relaxed );
+    const uint32_t firstFrame = m_summaryFrame;
+    m_summaryFrame = frame;
+
+    CProfileBuffer * pFrameBuffer = m_pFrameBuffer.load( std::memory_order_relaxed );
+    if( (pFrameBuffer == nullptr) || (frame == firstFrame) )
+        return std::string();
+
+    std::vector<CProfileEvent> eventVec;
+    pFrameBuffer->copy( eventVec );
+
+    // Sum up the zones of the completed frames by name and depth
+    std::vector<CZoneTotal> totalVec;
+
+    for( auto & iter : eventVec )
+    {
+        if( (iter.m_frame < firstFrame) || (iter.m_frame >= frame) || (iter.m_depth > maxDepth) )
+            continue;
+
+        const uint64_t duration = iter.m_end - iter.m_start;
+
+        auto totalIter = std::find_if( totalVec.begin(), totalVec.end(),
+            [&iter]( const CZoneTotal & total ){ return (total.m_pName == iter.m_pName) && (total.m_depth == iter.m_depth); } );
+
+        if( totalIter == totalVec.end() )
+        {
+            totalVec.push_back( {iter.m_pName, iter.m_depth, iter.m_start, duration, duration} );
+        }
+        else
+        {
+            totalIter->m_firstStart = std::min( totalIter->m_firstStart, iter.m_start );
+            totalIter->m_total += duration;
+            totalIter->m_max = std::max( totalIter->m_max, duration );
+        }
+    }
+
+    // Children end before their parent so order by start time to list the parent first
+    std::sort( totalVec.begin(), totalVec.end(),
+        []( const CZoneTotal & a, const CZoneTotal & b ){ return a.m_firstStart < b.m_firstStart; } );
+
+    const CHighResTimer & timer = CHighResTimer::Instance();
+    const double frameCount = frame - firstFrame;
+    const bool indent = (separator.find('\n') != std::string::npos);
+    std::string summary;
+
+    for( auto & iter : totalVec )
+    {
+        if( !summary.empty() )
+            summary += separator;
+
+        summary += boost::str( boost::format("%s%s %.2f/%.2f")
+            % std::string( (indent ? iter.m_depth * 2 : 0), ' ' )
+            % iter.m_pName
+            % (timer.toMilliseconds( iter.m_total ) / frameCount)
+            % timer.toMilliseconds( iter.m_max ) );
+    }
+
+    return summary;
+}
+
+
+/************************************************************************
+*    DESC:  Save the events still in the buffers as a chrome://tracing JSON file
+*           Times are in micro seconds from the creation of the profiler
+************************************************************************/
+bool CProfiler::exportChromeTrace( const std::string & filePath )
+{
+    const CHighResTimer & timer = CHighResTimer::Instance();
+    std::string json = "{\"traceEvents\":[\n";
+    bool first = true;
+
+    const CProfileBuffer * pFrameBuffer = m_pFrameBuffer.load( std::memory_order_relaxed );
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    for( auto & iter : m_upBufferVec )
+    {
+        std::vector<CProfileEvent> eventVec;
+        iter->copy( eventVec );
+
+        if( !first )
+            json += ",\n";
+
+        first = false;
+
+        // Name the thread
+        json += boost::str( boost::format("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}")
+            % iter->m_threadIndex
+            % ((iter.get() == pFrameBuffer) ? "game loop" : boost::str( boost::format("thread %d") % iter->m_threadIndex )) );
+
+        for( auto & eventIter : eventVec )
+        {
+            json += ",\n{\"name\":";
+            AddJsonString( json, eventIter.m_pName );
+            json += boost::str( boost::format(",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"frame\":%d}}")
+                % (timer.toMilliseconds( eventIter.m_start - m_startCounter ) * 1000.0)
+                % (timer.toMilliseconds( eventIter.m_end - eventIter.m_start ) * 1000.0)
+                % iter->m_threadIndex
+                % eventIter.m_frame );
+        }
+    }
+
+    lock.unlock();
+
+    json += "\n]}\n";
+
+    NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( filePath.c_str(), "wb" ) );
+    if( scpFile.isNull() )
+        return false;
+
+    return (SDL_RWwrite( scpFile.get(), json.data(), json.size(), 1 ) == 1);
+}
@@ -0,0 +1,206 @@
+/************************************************************************
+*    FILE NAME:       profiler.h
+*
+*    DESCRIPTION:     Per-frame hierarchical CPU profiler
+*                     Zones are timed with a scoped marker and written to
+*                     a ring buffer owned by the thread that ran them, so
+*                     recording never takes a lock. The buffers can be
+*                     summed up per frame for the stat display or saved
+*                     as a chrome://tracing JSON file.
+************************************************************************/
+
+#ifndef __profiler_h__
+#define __profiler_h__
+
+// Game lib dependencies
+#include <utilities/highresolutiontimer.h>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+// Compile out all the profile zones
+//#define __profiler_disable__
+
+/************************************************************************
+*    desc:  A timed zone recorded by the profiler
+************************************************************************/
+class CProfileEvent
+{
+public:
+
+    // Name of the zone. Must be a string literal or live for the life of the game
+    const char * m_pName;
+
+    // Start and end performance counter
+    uint64_t m_start;
+    uint64_t m_end;
+
+    // Frame the zone was recorded in
+    uint32_t m_frame;
+
+    // Nesting depth of the zone on it's thread
+    uint32_t m_depth;
+};
+
+/************************************************************************
+*    desc:  Ring buffer of events written by one thread only.
+*           Readers copy the events and then drop the ones the writer
+*           may have overwritten while they were copying.
+************************************************************************/
+class CProfileBuffer
+{
+public:
+
+    // Number of events kept per thread. Must be a power of 2
+    enum{ CAPACITY = 1 << 14 };
+
+    CProfileBuffer( uint32_t threadIndex );
+
+    // Record an event. Only called from the owning thread
+    void record( const CProfileEvent & event );
+
+    // Copy out the events still in the buffer, oldest first
+    void copy( std::vector<CProfileEvent> & eventVec ) const;
+
+    // The index of the thread for the trace
+    const uint32_t m_threadIndex;
+
+    // Current nesting depth of the owning thread
+    uint32_t m_depth;
+
+private:
+
+    // Event slot. The fields are atomic so a reader copying a slot
+    // while the writer wraps around to it is not a data race
+    class CSlot
+    {
+    public:
+        std::atomic<const char *> m_pName;
+        std::atomic<uint64_t> m_start;
+        std::atomic<uint64_t> m_end;
+        std::atomic<uint32_t> m_frame;
+        std::atomic<uint32_t> m_depth;
+    };
+
+    // The events
+    std::unique_ptr<CSlot[]> m_upSlotArray;
+
+    // Total number of events written
+    std::atomic<uint64_t> m_writeIndex;
+};
+
+class CProfiler
+{
+public:
+
+    // Get the instance of the singleton class
+    static CProfiler & Instance()
+    {
+        static CProfiler profiler;
+        return profiler;
+    }
+
+    // Enable/disable recording
+    void enable( bool value );
+
+    // Is the profiler recording
+    static bool isEnabled()
+    {
+        return m_enabled.load( std::memory_order_relaxed );
+    }
+
+    // Start a zone on this thread and get it's depth
+    uint32_t beginZone();
+
+    // End a zone on this thread
+    void endZone( const char * pName, uint64_t start, uint32_t depth );
+
+    // Mark the start of a game loop frame
+    void beginFrame();
+
+    // Get the per frame average and max of each zone since the last call
+    std::string getSummary( uint32_t maxDepth, const std::string & separator );
+
+    // Save the events still in the buffers as a chrome://tracing JSON file
+    bool exportChromeTrace( const std::string & filePath );
+
+private:
+
+    // Constructor
+    CProfiler();
+
+    // Destructor
+    ~CProfiler();
+
+    // Get the buffer of the calling thread
+    CProfileBuffer * getBuffer();
+
+private:
+
+    // Recording flag checked by every zone
+    static std::atomic<bool> m_enabled;
+
+    // Buffers of all the threads that recorded a zone. Never freed
+    // because the threads hold on to a raw pointer
+    std::vector<std::unique_ptr<CProfileBuffer>> m_upBufferVec;
+
+    // Mutex for adding buffers and reading them
+    std::mutex m_mutex;
+
+    // The current frame
+    std::atomic<uint32_t> m_frame;
+
+    // Buffer of the thread running the game loop
+    std::atomic<CProfileBuffer *> m_pFrameBuffer;
+
+    // First frame of the next summary
+    uint32_t m_summaryFrame;
+
+    // Counter value all trace times are relative to
+    uint64_t m_startCounter;
+};
+
+/************************************************************************
+*    desc:  Times the scope it's declared in
+************************************************************************/
+class CProfileZone
+{
+public:
+
+    explicit CProfileZone( const char * pName ) : m_pName(nullptr)
+    {
+        if( CProfiler::isEnabled() )
+        {
+            m_pName = pName;
+            m_depth = CProfiler::Instance().beginZone();
+            m_start = CHighResTimer::Instance().getCounter();
+        }
+    }
+
+    ~CProfileZone()
+    {
+        if( m_pName != nullptr )
+            CProfiler::Instance().endZone( m_pName, m_start, m_depth );
+    }
+
+private:
+
+    const char * m_pName;
+    uint64_t m_start;
+    uint32_t m_depth;
+};
+
+#ifdef __profiler_disable__
+    #define PROFILE_ZONE( name )
+#else
+    #define PROFILE_ZONE_CAT2( a, b ) a##b
+    #define PROFILE_ZONE_CAT( a, b ) PROFILE_ZONE_CAT2( a, b )
+    #define PROFILE_ZONE( name ) CProfileZone PROFILE_ZONE_CAT( profileZone, __LINE__ )( name )
+#endif
+
+#endif  // __profiler_h__
@@ -0,0 +1,43 @@
+/************************************************************************
+*    FILE NAME:       randfunc.h
+*
+*    DESCRIPTION:     Unbiased bounded random number functions
+************************************************************************/
+
+#ifndef __rand_func_h__
+#define __rand_func_h__
+
+// Standard lib dependencies
+#include <random>
+#include <cstdint>
+
+namespace NRandFunc
+{
+    /************************************************************************
+    *    DESC:  Uniform random number in the range [0, range) without the
+    *           modulo bias. Lemire's multiply and shift with rejection.
+    *           Only rejects when the low bits land in the biased zone so
+    *           most calls take a single number from the generator
+    ************************************************************************/
+    inline uint32_t Bounded( std::mt19937 & rRng, uint32_t range )
+    {
+        uint64_t product = uint64_t(uint32_t(rRng())) * range;
+        uint32_t low = uint32_t(product);
+
+        if( low < range )
+        {
+            const uint32_t threshold = uint32_t(0u - range) % range;
+
+            while( low < threshold )
+            {
+                product = uint64_t(uint32_t(rRng())) * range;
+                low = uint32_t(product);
+            }
+        }
+
+        return uint32_t(product >> 32);
+    }
+
+}   // NRandFunc
+
+#endif  // __rand_func_h__
@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <common/defs.h>
 #include <common/worldvalue.h>
+#include <utilities/xmlcache.h>
 
 // Boost lib dependencies
 #include <boost/lexical_cast.hpp>
@@ -19,6 +20,9 @@
 #include <SDL.h>
 #include <SDL_mixer.h>
 
+// Standard lib dependencies
+#include <algorithm>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -48,6 +52,22 @@ CSettings::CSettings() :
     m_clearTargetBuffer(true),
     m_minThreadCount(2),
     m_maxThreadCount(0),
+    m_parallelSpriteUpdate(false),
+    m_parallelSpriteTransform(false),
+    m_parallelSpriteMinCount(256),
+    m_parallelSpriteGrainSize(64),
+    m_spriteBatch(false),
+    m_batchTransform(false),
+    m_xmlCache(true),
+    m_tickRate(0.f),
+    m_maxStepsPerFrame(5),
+    m_frameLimit(0.f),
+    m_replayMode(NDefs::ERM_OFF),
+    m_replayRender(true),
+    m_renderDevice(NDefs::ERD_OPENGL),
+    m_profilerEnable(false),
+    m_scriptFrameBudget(0),
+    m_scriptParallel(false),
     m_sectorSize(512),
     m_sectorSizeHalf(256),
     m_anisotropicLevel(NDefs::ETF_ANISOTROPIC_0X),
@@ -243,6 +263,89 @@ void CSettings::loadXML()
                     m_maxThreadCount = std::atoi(threadNode.getAttribute("maxThreadCount"));
             }
 
+            const XMLNode parallelSpriteNode = deviceNode.getChildNode("parallelSprites");
+            if( !parallelSpriteNode.isEmpty() )
+            {
+                if( parallelSpriteNode.isAttributeSet("update") )
+                    m_parallelSpriteUpdate = ( std::strcmp( parallelSpriteNode.getAttribute("update"), "true" ) == 0 );
+
+                if( parallelSpriteNode.isAttributeSet("transform") )
+                    m_parallelSpriteTransform = ( std::strcmp( parallelSpriteNode.getAttribute("transform"), "true" ) == 0 );
+
+                if( parallelSpriteNode.isAttributeSet("minSpriteCount") )
+                    m_parallelSpriteMinCount = std::atoi(parallelSpriteNode.getAttribute("minSpriteCount"));
+
+                if( parallelSpriteNode.isAttributeSet("grainSize") )
+                    m_parallelSpriteGrainSize = std::max( 1, std::atoi(parallelSpriteNode.getAttribute("grainSize")) );
+            }
+
+            const XMLNode spriteBatchNode = deviceNode.getChildNode("spriteBatch");
+            if( !spriteBatchNode.isEmpty() && spriteBatchNode.isAttributeSet("enable") )
+                m_spriteBatch = ( std::strcmp( spriteBatchNode.getAttribute("enable"), "true" ) == 0 );
+
+            const XMLNode batchTransformNode = deviceNode.getChildNode("batchTransform");
+            if( !batchTransformNode.isEmpty() && batchTransformNode.isAttributeSet("enable") )
+                m_batchTransform = ( std::strcmp( batchTransformNode.getAttribute("enable"), "true" ) == 0 );
+
+            // The settings file is already loaded so this only applies to the files loaded after it
+            const XMLNode xmlCacheNode = deviceNode.getChildNode("xmlCache");
+            if( !xmlCacheNode.isEmpty() && xmlCacheNode.isAttributeSet("enable") )
+            {
+                m_xmlCache = ( std::strcmp( xmlCacheNode.getAttribute("enable"), "true" ) == 0 );
+                NXMLCache::SetEnable( m_xmlCache );
+            }
+
+            const XMLNode timingNode = deviceNode.getChildNode("timing");
+            if( !timingNode.isEmpty() )
+            {
+                if( timingNode.isAttributeSet("tickRate") )
+                    m_tickRate = std::max( 0.f, (float)std::atof(timingNode.getAttribute("tickRate")) );
+
+                if( timingNode.isAttributeSet("maxStepsPerFrame") )
+                    m_maxStepsPerFrame = std::max( 1, std::atoi(timingNode.getAttribute("maxStepsPerFrame")) );
+
+                if( timingNode.isAttributeSet("frameLimit") )
+                    m_frameLimit = std::max( 0.f, (float)std::atof(timingNode.getAttribute("frameLimit")) );
+            }
+
+            const XMLNode replayNode = deviceNode.getChildNode("replay");
+            if( !replayNode.isEmpty() )
+            {
+                if( replayNode.isAttributeSet("mode") )
+                {
+                    const char * pAttr = replayNode.getAttribute("mode");
+
+                    if( std::strcmp( pAttr, "record" ) == 0 )
+                        m_replayMode = NDefs::ERM_RECORD;
+
+                    else if( std::strcmp( pAttr, "play" ) == 0 )
+                        m_replayMode = NDefs::ERM_PLAY;
+                }
+
+                if( replayNode.isAttributeSet("file") )
+                    m_replayFile = replayNode.getAttribute("file");
+
+                if( replayNode.isAttributeSet("render") )
+                    m_replayRender = ( std::strcmp( replayNode.getAttribute("render"), "true" ) == 0 );
+            }
+
+            const XMLNode renderDeviceNode = deviceNode.getChildNode("renderDevice");
+            if( !renderDeviceNode.isEmpty() && renderDeviceNode.isAttributeSet("type") )
+            {
+                if( std::strcmp( renderDeviceNode.getAttribute("type"), "null" ) == 0 )
+                    m_renderDevice = NDefs::ERD_NULL;
+            }
+
+            const XMLNode profilerNode = deviceNode.getChildNode("profiler");
+            if( !profilerNode.isEmpty() )
+            {
+                if( profilerNode.isAttributeSet("enable") )
+                    m_profilerEnable = ( std::strcmp( profilerNode.getAttribute("enable"), "true" ) == 0 );
+
+                if( profilerNode.isAttributeSet("traceFile") )
+                    m_profilerTraceFile = profilerNode.getAttribute("traceFile");
+            }
+
             // Get the attribute from the "depthStencilBuffer" node
             const XMLNode depthStencilBufferNode = deviceNode.getChildNode("depthStencilBuffer");
             if( !depthStencilBufferNode.isEmpty() )
@@ -292,6 +395,20 @@ void CSettings::loadXML()
                     CWorldValue::setSectorSize( m_sectorSize );
                 }
             }
+
+            // Get script settings
+            const XMLNode scriptNode = m_mainNode.getChildNode("script");
+            if( !scriptNode.isEmpty() )
+            {
+                if( scriptNode.isAttributeSet("byteCodePath") )
+                    m_scriptByteCodePath = scriptNode.getAttribute("byteCodePath");
+
+                if( scriptNode.isAttributeSet("frameBudget") )
+                    m_scriptFrameBudget = std::max( 0, std::atoi(scriptNode.getAttribute("frameBudget")) );
+
+                if( scriptNode.isAttributeSet("parallel") )
+                    m_scriptParallel = ( std::strcmp( scriptNode.getAttribute("parallel"), "true" ) == 0 );
+            }
         }
     }
 }
@@ -600,6 +717,145 @@ int CSettings::getMaxThreadCount() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the parallel sprite update/transform settings
+************************************************************************/
+bool CSettings::getParallelSpriteUpdate() const
+{
+    return m_parallelSpriteUpdate;
+}
+
+bool CSettings::getParallelSpriteTransform() const
+{
+    return m_parallelSpriteTransform;
+}
+
+int CSettings::getParallelSpriteMinCount() const
+{
+    return m_parallelSpriteMinCount;
+}
+
+int CSettings::getParallelSpriteGrainSize() const
+{
+    return m_parallelSpriteGrainSize;
+}
+
+
+/************************************************************************
+*    DESC:  Batch the 2D sprites of a strategy into as few draws as possible
+************************************************************************/
+bool CSettings::getSpriteBatch() const
+{
+    return m_spriteBatch;
+}
+
+
+/************************************************************************
+*    DESC:  Make the 2D sprite matrices in one pass over the transform store
+************************************************************************/
+bool CSettings::getBatchTransform() const
+{
+    return m_batchTransform;
+}
+
+
+/************************************************************************
+*    DESC:  Load the baked binary XML files when they're up to date
+************************************************************************/
+bool CSettings::getXMLCache() const
+{
+    return m_xmlCache;
+}
+
+
+/************************************************************************
+*    DESC:  Get the game loop timing settings
+************************************************************************/
+float CSettings::getTickRate() const
+{
+    return m_tickRate;
+}
+
+int CSettings::getMaxStepsPerFrame() const
+{
+    return m_maxStepsPerFrame;
+}
+
+float CSettings::getFrameLimit() const
+{
+    return m_frameLimit;
+}
+
+
+/************************************************************************
+*    DESC:  Get the replay settings
+************************************************************************/
+NDefs::EReplayMode CSettings::getReplayMode() const
+{
+    return m_replayMode;
+}
+
+const std::string & CSettings::getReplayFile() const
+{
+    return m_replayFile;
+}
+
+bool CSettings::getReplayRender() const
+{
+    return m_replayRender;
+}
+
+
+/************************************************************************
+*    DESC:  Get the render device type
+************************************************************************/
+NDefs::ERenderDevice CSettings::getRenderDevice() const
+{
+    return m_renderDevice;
+}
+
+
+/************************************************************************
+*    DESC:  Get the profiler settings
+************************************************************************/
+bool CSettings::getProfilerEnable() const
+{
+    return m_profilerEnable;
+}
+
+const std::string & CSettings::getProfilerTraceFile() const
+{
+    return m_profilerTraceFile;
+}
+
+
+/************************************************************************
+*    DESC:  Get the folder of the compiled script cache
+************************************************************************/
+const std::string & CSettings::getScriptByteCodePath() const
+{
+    return m_scriptByteCodePath;
+}
+
+
+/************************************************************************
+*    DESC:  Get the script time budget of a frame in microseconds
+************************************************************************/
+int CSettings::getScriptFrameBudget() const
+{
+    return m_scriptFrameBudget;
+}
+
+
+/************************************************************************
+*    DESC:  Are the parallel script groups run on the worker threads
+************************************************************************/
+bool CSettings::getScriptParallel() const
+{
+    return m_scriptParallel;
+}
+
+
 /************************************************************************
 *    DESC:  Get/Set the Anisotropic setting
 ************************************************************************/
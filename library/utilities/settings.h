@@ -120,6 +120,47 @@ public:
     // Get the maximum thread count
     int getMaxThreadCount() const;
     
+    // Get the parallel sprite update/transform settings
+    bool getParallelSpriteUpdate() const;
+    bool getParallelSpriteTransform() const;
+    int getParallelSpriteMinCount() const;
+    int getParallelSpriteGrainSize() const;
+    
+    // Batch the 2D sprites of a strategy into as few draws as possible
+    bool getSpriteBatch() const;
+
+    // Make the 2D sprite matrices in one pass over the transform store
+    bool getBatchTransform() const;
+    
+    // Load the baked binary XML files when they're up to date
+    bool getXMLCache() const;
+    
+    // Get the game loop timing settings
+    float getTickRate() const;
+    int getMaxStepsPerFrame() const;
+    float getFrameLimit() const;
+    
+    // Get the replay settings
+    NDefs::EReplayMode getReplayMode() const;
+    const std::string & getReplayFile() const;
+    bool getReplayRender() const;
+    
+    // Get the render device type
+    NDefs::ERenderDevice getRenderDevice() const;
+    
+    // Get the profiler settings
+    bool getProfilerEnable() const;
+    const std::string & getProfilerTraceFile() const;
+    
+    // Get the folder of the compiled script cache
+    const std::string & getScriptByteCodePath() const;
+    
+    // Get the script time budget of a frame in microseconds
+    int getScriptFrameBudget() const;
+    
+    // Are the parallel script groups run on the worker threads
+    bool getScriptParallel() const;
+    
     // Get the sector size
     int getSectorSize() const;
     
@@ -226,6 +267,55 @@ private:
     // Value of zero means use max hardware threads to cores
     int m_maxThreadCount;
     
+    // Split the sprite update/transform across the thread pool
+    bool m_parallelSpriteUpdate;
+    bool m_parallelSpriteTransform;
+    
+    // Minimum number of sprites in a strategy before it's split
+    int m_parallelSpriteMinCount;
+    
+    // Number of sprites handled by each job
+    int m_parallelSpriteGrainSize;
+    
+    // Batch the 2D sprites of a strategy
+    bool m_spriteBatch;
+
+    // Make the 2D sprite matrices in one pass over the transform store
+    bool m_batchTransform;
+    
+    // Load the baked binary XML files
+    bool m_xmlCache;
+    
+    // Steps per second of the fixed step game loop. Zero runs a step per frame
+    float m_tickRate;
+    
+    // Steps a slow frame can run to catch up
+    int m_maxStepsPerFrame;
+    
+    // Frames per second to sleep down to. Zero doesn't limit the frame rate
+    float m_frameLimit;
+    
+    // Record or play back the session from the file. The play back can skip rendering
+    NDefs::EReplayMode m_replayMode;
+    std::string m_replayFile;
+    bool m_replayRender;
+    
+    // Render with OpenGL or headless with the null device
+    NDefs::ERenderDevice m_renderDevice;
+    
+    // Record the profile zones and the file to save the trace to on exit
+    bool m_profilerEnable;
+    std::string m_profilerTraceFile;
+    
+    // Folder the compiled script groups are cached in. Empty disables the cache
+    std::string m_scriptByteCodePath;
+    
+    // Script time budget of a frame in microseconds. Zero runs the scripts unlimited
+    int m_scriptFrameBudget;
+    
+    // Run the script groups flagged parallel in the list table on the worker threads
+    bool m_scriptParallel;
+    
     // the sector size
     float m_sectorSize;
     float m_sectorSizeHalf;
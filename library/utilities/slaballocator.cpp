@@ -0,0 +1,121 @@
+/************************************************************************
+*    FILE NAME:       slaballocator.cpp
+*
+*    DESCRIPTION:     Fixed size object allocator
+*                     Memory is handed out from slabs of equal sized
+*                     slots. Freed slots go on a free list and are reused
+*                     so objects that come and go every few frames don't
+*                     touch the heap. Slabs are only freed with the
+*                     allocator. Not thread safe.
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/slaballocator.h>
+
+// Standard lib dependencies
+#include <algorithm>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSlabAllocator::CSlabAllocator( size_t objectSize, size_t slabCount ) :
+    m_slabCount( std::max( slabCount, size_t(1) ) ),
+    m_pFreeList(nullptr),
+    m_allocCount(0),
+    m_capacity(0)
+{
+    // The slab memory from new[] is aligned for any type. Keep
+    // each slot at a multiple of that so every slot is too
+    const size_t ALIGN = alignof(std::max_align_t);
+    m_slotSize = std::max( objectSize, sizeof(CFreeSlot) );
+    m_slotSize = ((m_slotSize + ALIGN - 1) / ALIGN) * ALIGN;
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CSlabAllocator::~CSlabAllocator()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Get memory for one object
+************************************************************************/
+void * CSlabAllocator::allocate()
+{
+    if( m_pFreeList == nullptr )
+        addSlab( m_slabCount );
+
+    CFreeSlot * pSlot = m_pFreeList;
+    m_pFreeList = pSlot->m_pNext;
+    ++m_allocCount;
+
+    return pSlot;
+}
+
+
+/************************************************************************
+*    DESC:  Return the memory of an object that has been destructed
+************************************************************************/
+void CSlabAllocator::deallocate( void * pMem )
+{
+    if( pMem != nullptr )
+    {
+        CFreeSlot * pSlot = static_cast<CFreeSlot *>(pMem);
+        pSlot->m_pNext = m_pFreeList;
+        m_pFreeList = pSlot;
+        --m_allocCount;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Make sure count objects can be allocated without adding a slab
+************************************************************************/
+void CSlabAllocator::reserve( size_t count )
+{
+    const size_t freeCount = m_capacity - m_allocCount;
+
+    if( count > freeCount )
+        addSlab( count - freeCount );
+}
+
+
+/************************************************************************
+*    DESC:  Add a slab of count slots to the free list
+************************************************************************/
+void CSlabAllocator::addSlab( size_t count )
+{
+    m_upSlabVec.emplace_back( new char[m_slotSize * count] );
+    char * pSlab = m_upSlabVec.back().get();
+
+    // Link the slots in address order so they are handed out that way
+    for( size_t i = count; i > 0; --i )
+    {
+        CFreeSlot * pSlot = reinterpret_cast<CFreeSlot *>(pSlab + ((i - 1) * m_slotSize));
+        pSlot->m_pNext = m_pFreeList;
+        m_pFreeList = pSlot;
+    }
+
+    m_capacity += count;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of objects allocated
+************************************************************************/
+size_t CSlabAllocator::getAllocCount() const
+{
+    return m_allocCount;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of objects that fit in the slabs
+************************************************************************/
+size_t CSlabAllocator::getCapacity() const
+{
+    return m_capacity;
+}
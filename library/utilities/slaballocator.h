@@ -0,0 +1,81 @@
+/************************************************************************
+*    FILE NAME:       slaballocator.h
+*
+*    DESCRIPTION:     Fixed size object allocator
+*                     Memory is handed out from slabs of equal sized
+*                     slots. Freed slots go on a free list and are reused
+*                     so objects that come and go every few frames don't
+*                     touch the heap. Slabs are only freed with the
+*                     allocator. Not thread safe.
+************************************************************************/
+
+#ifndef __slab_allocator_h__
+#define __slab_allocator_h__
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+class CSlabAllocator : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CSlabAllocator( size_t objectSize, size_t slabCount = 16 );
+
+    // Destructor
+    ~CSlabAllocator();
+
+    // Get memory for one object
+    void * allocate();
+
+    // Return the memory of an object that has been destructed
+    void deallocate( void * pMem );
+
+    // Make sure count objects can be allocated without adding a slab
+    void reserve( size_t count );
+
+    // Get the number of objects allocated
+    size_t getAllocCount() const;
+
+    // Get the number of objects that fit in the slabs
+    size_t getCapacity() const;
+
+private:
+
+    // Add a slab of count slots to the free list
+    void addSlab( size_t count );
+
+private:
+
+    // A free slot holds the pointer to the next free slot
+    class CFreeSlot
+    {
+    public:
+        CFreeSlot * m_pNext;
+    };
+
+    // Slot size. Rounded up to keep every slot aligned
+    size_t m_slotSize;
+
+    // Number of slots in a slab added when the free list runs out
+    size_t m_slabCount;
+
+    // The slabs
+    std::vector<std::unique_ptr<char[]>> m_upSlabVec;
+
+    // Head of the free list
+    CFreeSlot * m_pFreeList;
+
+    // Number of objects allocated
+    size_t m_allocCount;
+
+    // Number of slots in the slabs
+    size_t m_capacity;
+};
+
+#endif  // __slab_allocator_h__
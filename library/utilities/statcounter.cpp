@@ -11,11 +11,16 @@
 // Game lib dependencies
 #include <utilities/highresolutiontimer.h>
 #include <utilities/settings.h>
+#include <utilities/profiler.h>
 #include <common/build_defs.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <vector>
+#include <algorithm>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -26,6 +31,7 @@ CStatCounter::CStatCounter() :
     m_cycleCounter(0),
     m_scriptContexCounter(0),
     m_activeContexCounter(0),
+    m_deferredContexCounter(0),
     m_statsDisplayTimer(1000)
 {
     resetCounters();
@@ -93,6 +99,22 @@ void CStatCounter::resetCounters()
     m_elapsedFPSCounter = 0.0;
     m_cycleCounter = 0;
     m_activeContexCounter = 0;
+    m_deferredContexCounter = 0;
+
+    // Drop the script functions that didn't run and keep the rest to save reallocating them
+    auto iter = m_scriptTimeMap.begin();
+    while( iter != m_scriptTimeMap.end() )
+    {
+        if( iter->second.m_time == 0.0 )
+        {
+            iter = m_scriptTimeMap.erase( iter );
+        }
+        else
+        {
+            iter->second.m_time = 0.0;
+            ++iter;
+        }
+    }
 }
 
 
@@ -106,12 +128,43 @@ void CStatCounter::formatStatString()
         % (m_activeContexCounter / m_cycleCounter)
         % m_scriptContexCounter
         % (m_vObjCounter / m_cycleCounter)
-        % (m_physicsObjCounter / m_cycleCounter)
+        % (m_physicsObjCounter.load() / m_cycleCounter)
         % CSettings::Instance().getSize().w
         % CSettings::Instance().getSize().h
         //% (playerPos.x)
         //% (playerPos.y)
         );
+
+    // Add the contexts left over the script frame budget
+    if( m_deferredContexCounter > 0 )
+        m_statStr += boost::str( boost::format(" - scd: %d") % (m_deferredContexCounter / m_cycleCounter) );
+
+    // Add the per frame ms of the slowest script functions
+    if( !m_scriptTimeMap.empty() )
+    {
+        std::vector<const CScriptTime *> pTimeVec;
+        pTimeVec.reserve( m_scriptTimeMap.size() );
+
+        for( auto & iter : m_scriptTimeMap )
+            pTimeVec.push_back( &iter.second );
+
+        const size_t count = std::min( pTimeVec.size(), size_t(3) );
+        std::partial_sort( pTimeVec.begin(), pTimeVec.begin() + count, pTimeVec.end(),
+            []( const CScriptTime * pA, const CScriptTime * pB ){ return pA->m_time > pB->m_time; } );
+
+        m_statStr += " - script ms:";
+        for( size_t i = 0; i < count; ++i )
+            m_statStr += boost::str( boost::format("%s %s %.3f")
+                % ((i > 0) ? "," : "") % pTimeVec[i]->m_name % (pTimeVec[i]->m_time / (double)m_cycleCounter) );
+    }
+
+    // Add the per frame ms of the game loop phases
+    if( CProfiler::isEnabled() )
+    {
+        const std::string summary = CProfiler::Instance().getSummary( 1, " - " );
+        if( !summary.empty() )
+            m_statStr += " - ms: " + summary;
+    }
 }
 
 
@@ -129,7 +182,7 @@ void CStatCounter::incDisplayCounter( size_t value )
 ************************************************************************/
 void CStatCounter::incPhysicsObjectsCounter()
 {
-    ++m_physicsObjCounter;
+    m_physicsObjCounter.fetch_add( 1, std::memory_order_relaxed );
 }
 
 
@@ -149,3 +202,34 @@ void CStatCounter::incActiveScriptContexCounter()
 {
     ++m_activeContexCounter;
 }
+
+
+/************************************************************************
+*    DESC:  Inc the count of script contexts left over the frame budget
+************************************************************************/
+void CStatCounter::incDeferredScriptContexCounter()
+{
+    ++m_deferredContexCounter;
+}
+
+
+/************************************************************************
+*    DESC:  Add the execution time of a script function
+************************************************************************/
+void CStatCounter::addScriptTime( const void * pFunc, const char * pName, double ms )
+{
+    auto iter = m_scriptTimeMap.find( pFunc );
+    if( iter == m_scriptTimeMap.end() )
+        iter = m_scriptTimeMap.emplace( pFunc, CScriptTime{ pName, 0.0 } ).first;
+
+    iter->second.m_time += ms;
+}
+
+
+/************************************************************************
+*    DESC:  Forget the timed script functions
+************************************************************************/
+void CStatCounter::clearScriptTimes()
+{
+    m_scriptTimeMap.clear();
+}
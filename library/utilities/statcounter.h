@@ -15,6 +15,8 @@
 
 // Standard lib dependencies
 #include <string>
+#include <atomic>
+#include <unordered_map>
 
 class CStatCounter
 {
@@ -43,6 +45,15 @@ public:
     void incScriptContexCounter();
     void incActiveScriptContexCounter();
     
+    // Inc the count of script contexts left over the frame budget
+    void incDeferredScriptContexCounter();
+    
+    // Add the execution time of a script function
+    void addScriptTime( const void * pFunc, const char * pName, double ms );
+    
+    // Forget the timed script functions. Their pointers are stale after a group is freed
+    void clearScriptTimes();
+    
     // Connect/Disconnect to the signal
     void connect( const StatCounterSignal::slot_type & slot );
     void disconnect();
@@ -64,7 +75,8 @@ private:
     size_t m_vObjCounter;
     
     // Counter for physics objects
-    size_t m_physicsObjCounter;
+    // Incremented from worker threads during the parallel sprite update
+    std::atomic<size_t> m_physicsObjCounter;
 
     // Elapsed time counter
     double m_elapsedFPSCounter;
@@ -75,6 +87,17 @@ private:
     // Angle Script contex counter
     size_t m_scriptContexCounter;
     size_t m_activeContexCounter;
+    size_t m_deferredContexCounter;
+    
+    // Execution time of the script functions since the last display
+    class CScriptTime
+    {
+    public:
+        std::string m_name;
+        double m_time;
+    };
+    
+    std::unordered_map<const void *, CScriptTime> m_scriptTimeMap;
 
     // Stat string
     std::string m_statStr;
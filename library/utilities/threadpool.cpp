@@ -1,8 +1,10 @@
-
 /************************************************************************
 *    FILE NAME:       threadpool.cpp
 *
 *    DESCRIPTION:     Class to manage a thread pool
+*                     Work stealing scheduler. Each thread that posts
+*                     jobs owns a lock-free deque that idle workers
+*                     steal from.
 ************************************************************************/
 
 // Physical component dependency
@@ -11,11 +13,63 @@
 // Game lib dependencies
 #include <utilities/settings.h>
 
+namespace
+{
+    // Gives the queue back to the pool when the owning thread exits
+    // so threads that come and go, like the load threads, can reuse it
+    class CQueueOwner
+    {
+    public:
+        ~CQueueOwner()
+        {
+            if( m_pQueue != nullptr )
+                m_pQueue->release();
+        }
+
+        CJobQueue * m_pQueue = nullptr;
+    };
+
+    // Queue owned by this thread
+    thread_local CQueueOwner t_queueOwner;
+
+    // Where this thread starts looking for work to steal
+    thread_local unsigned int t_stealIndex = 0;
+
+    // Group of the jobs posted by a thread outside of a job. The posted
+    // jobs point to it so the thread lets them finish before it exits
+    class CThreadGroup
+    {
+    public:
+        ~CThreadGroup()
+        {
+            while( !m_group.isDone() )
+                std::this_thread::yield();
+        }
+
+        CJobGroup m_group;
+    };
+
+    thread_local CThreadGroup t_threadGroup;
+
+    // Group of the job running on this thread
+    thread_local CJobGroup * t_pJobGroup = nullptr;
+
+    // Index of the worker. -1 if this thread is not a worker
+    thread_local int t_workerIndex = -1;
+}
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
-CThreadPool::CThreadPool()
+CThreadPool::CThreadPool() :
+    m_queueCount(0),
+    m_queuedJobs(0),
+    m_sleeping(0),
+    m_stop(false)
 {
+    for( auto & iter : m_pQueue )
+        iter.store( nullptr, std::memory_order_relaxed );
+
     #if !defined(__thread_disable__)
     // Get minimum number of threads
     int threads = CSettings::Instance().getMinThreadCount();
@@ -35,33 +89,23 @@ CThreadPool::CThreadPool()
     else if( (maxThreads > threads) && (maxThreads <= maxCores) )
         threads = maxThreads;
 
+    // Leave room in the queue list for the threads that post
+    threads = std::min( threads, MAX_QUEUES / 2 );
+
     m_workers.reserve( threads );
 
+    // Create the worker queues up front so they are ready to steal from
     for( int i = 0; i < threads; ++i )
     {
-        m_workers.emplace_back(
-            [this] {
-                for (;;)
-                {
-                    std::function<void() > task;
-
-                    {
-                        std::unique_lock<std::mutex> lock(this->m_queue_mutex);
-                        this->m_condition.wait(lock,
-                            [this] { return this->m_stop || !this->m_tasks.empty(); });
-
-                        if (this->m_stop && this->m_tasks.empty())
-                            return;
-
-                        task = std::move(this->m_tasks.front());
-                        this->m_tasks.pop();
-                    }
-
-                    task();
-                }
-            }
-        );
+        m_queueVec.emplace_back( new CJobQueue );
+        m_queueVec.back()->acquire();
+        m_pQueue[i].store( m_queueVec.back().get(), std::memory_order_relaxed );
     }
+
+    m_queueCount.store( threads, std::memory_order_release );
+
+    for( int i = 0; i < threads; ++i )
+        m_workers.emplace_back( &CThreadPool::workerLoop, this, m_queueVec[i].get(), i );
     #endif
 }
 
@@ -73,7 +117,7 @@ CThreadPool::~CThreadPool()
 {
     #if !defined(__thread_disable__)
     {
-        std::unique_lock<std::mutex> lock( m_queue_mutex );
+        std::unique_lock<std::mutex> lock( m_sleep_mutex );
         m_stop = true;
     }
 
@@ -86,21 +130,357 @@ CThreadPool::~CThreadPool()
 
 
 /************************************************************************
-*    DESC:  Wait for the jobs to complete
+*    DESC:  Worker thread loop
+************************************************************************/
+void CThreadPool::workerLoop( CJobQueue * pQueue, int index )
+{
+    t_queueOwner.m_pQueue = pQueue;
+    t_workerIndex = index;
+
+    for(;;)
+    {
+        if( tryRunJob() )
+            continue;
+
+        // Spin for a little bit before going to sleep
+        bool foundJob = false;
+        for( int i = 0; (i < SPIN_COUNT) && !foundJob; ++i )
+        {
+            std::this_thread::yield();
+            foundJob = tryRunJob();
+        }
+
+        if( foundJob )
+            continue;
+
+        std::unique_lock<std::mutex> lock( m_sleep_mutex );
+
+        // The sleeping count and the queued count are both seq_cst so
+        // either the poster sees this thread sleeping or this thread sees the job
+        m_sleeping.fetch_add( 1 );
+        m_condition.wait( lock,
+            [this] { return m_stop || (m_queuedJobs.load() > 0); } );
+        m_sleeping.fetch_sub( 1 );
+
+        if( m_stop && (m_queuedJobs.load() <= 0) )
+        {
+            auto threadExitFunc = m_threadExitFunc;
+            lock.unlock();
+
+            if( threadExitFunc )
+                threadExitFunc();
+
+            return;
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the queue owned by the calling thread
+*           Threads that are not workers get a queue the first time
+*           they post. A queue released by an exited thread is reused
+************************************************************************/
+CJobQueue * CThreadPool::getQueue()
+{
+    if( t_queueOwner.m_pQueue != nullptr )
+        return t_queueOwner.m_pQueue;
+
+    std::unique_lock<std::mutex> lock( m_queue_mutex );
+
+    for( auto & iter : m_queueVec )
+    {
+        if( iter->acquire() )
+        {
+            t_queueOwner.m_pQueue = iter.get();
+            return iter.get();
+        }
+    }
+
+    const int count = m_queueCount.load( std::memory_order_relaxed );
+    if( count >= MAX_QUEUES )
+        throw std::runtime_error("Too many threads posting to ThreadPool");
+
+    m_queueVec.emplace_back( new CJobQueue );
+    m_queueVec.back()->acquire();
+    m_pQueue[count].store( m_queueVec.back().get(), std::memory_order_release );
+    m_queueCount.store( count + 1, std::memory_order_release );
+
+    t_queueOwner.m_pQueue = m_queueVec.back().get();
+
+    return t_queueOwner.m_pQueue;
+}
+
+
+/************************************************************************
+*    DESC:  Allocate a job from the calling thread's queue
+************************************************************************/
+CJob * CThreadPool::allocJob()
+{
+    return getQueue()->alloc();
+}
+
+
+/************************************************************************
+*    DESC:  Queue the job. The queue grows if it's full so the job
+*           is never run on the calling thread
+************************************************************************/
+void CThreadPool::enqueue( CJob * pJob )
+{
+    #if defined(__thread_disable__)
+    execute( pJob );
+    #else
+    // don't allow enqueueing after stopping the pool
+    if( m_stop )
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+
+    getQueue()->push( pJob );
+
+    m_queuedJobs.fetch_add( 1 );
+
+    if( m_sleeping.load() > 0 )
+    {
+        std::unique_lock<std::mutex> lock( m_sleep_mutex );
+        m_condition.notify_one();
+    }
+    #endif
+}
+
+
+/************************************************************************
+*    DESC:  Queue a created job
+************************************************************************/
+void CThreadPool::run( const CJobHandle & handle )
+{
+    enqueue( handle.m_pJob );
+}
+
+
+/************************************************************************
+*    DESC:  Pop a job from our own queue or steal one from another
+*
+*    ret:   bool - true if a job was executed
+************************************************************************/
+bool CThreadPool::tryRunJob()
+{
+    CJobQueue * pOwnQueue = getQueue();
+    CJob * pJob = pOwnQueue->pop();
+
+    if( pJob == nullptr )
+    {
+        const int count = m_queueCount.load( std::memory_order_acquire );
+        const unsigned int start = t_stealIndex++;
+
+        for( int i = 0; (i < count) && (pJob == nullptr); ++i )
+        {
+            CJobQueue * pQueue = m_pQueue[(start + i) % count].load( std::memory_order_acquire );
+
+            if( pQueue != pOwnQueue )
+                pJob = pQueue->steal();
+        }
+    }
+
+    if( pJob == nullptr )
+        return false;
+
+    m_queuedJobs.fetch_sub( 1, std::memory_order_relaxed );
+
+    execute( pJob );
+
+    return true;
+}
+
+
+/************************************************************************
+*    DESC:  Execute the job and notify anyone waiting on it
+*           The job finishes even if it throws so it's waiter doesn't
+*           hang. The exception is held for the waiter instead
+************************************************************************/
+void CThreadPool::execute( CJob * pJob )
+{
+    // The jobs posted by this job go to it's own group
+    CJobGroup group;
+    CJobGroup * pLastGroup = t_pJobGroup;
+    t_pJobGroup = &group;
+
+    std::exception_ptr exception;
+
+    try
+    {
+        pJob->execute();
+    }
+    catch(...)
+    {
+        exception = std::current_exception();
+    }
+
+    // The group is on the stack so the jobs posted by this job finish before it does
+    join( group );
+
+    if( !exception )
+        exception = group.takeException();
+
+    t_pJobGroup = pLastGroup;
+
+    if( exception )
+        storeException( pJob, exception );
+
+    finish( pJob );
+}
+
+
+/************************************************************************
+*    DESC:  Hold on to the exception of a failed job for whoever waits on it
+*           A posted job's exception goes to the group that posted it.
+*           Otherwise it's held for the waiter of the top parent's handle
+************************************************************************/
+void CThreadPool::storeException( CJob * pJob, std::exception_ptr exception )
+{
+    if( pJob->m_pGroup != nullptr )
+    {
+        pJob->m_pGroup->storeException( exception );
+        return;
+    }
+
+    // The parent can't finish before it's children so it's generation is still the handle's
+    CJob * pRoot = pJob;
+    while( pRoot->m_pParent != nullptr )
+        pRoot = pRoot->m_pParent;
+
+    pRoot->m_pOwner->storeException( pRoot, pRoot->m_generation.load( std::memory_order_relaxed ), exception );
+}
+
+
+/************************************************************************
+*    DESC:  Get the group the calling thread or running job posts to
+************************************************************************/
+CJobGroup * CThreadPool::getGroup()
+{
+    if( t_pJobGroup != nullptr )
+        return t_pJobGroup;
+
+    return &t_threadGroup.m_group;
+}
+
+
+/************************************************************************
+*    DESC:  Decrement the job's unfinished count. When it hits zero the
+*           job is recycled and it's parent is notified
+************************************************************************/
+void CThreadPool::finish( CJob * pJob )
+{
+    while( pJob != nullptr )
+    {
+        if( pJob->m_unfinished.fetch_sub( 1, std::memory_order_acq_rel ) != 1 )
+            return;
+
+        CJob * pParent = pJob->m_pParent;
+        CJobGroup * pGroup = pJob->m_pGroup;
+
+        // A failed earlier use of this job that was never waited on is dropped here
+        pJob->m_pOwner->dropException( pJob, pJob->m_generation.load( std::memory_order_relaxed ) );
+
+        // Bump the generation before recycling so handles see it as done
+        pJob->m_generation.fetch_add( 1, std::memory_order_release );
+        pJob->m_pOwner->free( pJob );
+
+        // The group may be gone as soon as it's done
+        if( pGroup != nullptr )
+            pGroup->done();
+
+        pJob = pParent;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Wait for the jobs posted by the caller to complete
+*           Only the jobs posted by the calling thread, or by the job
+*           it's running, are waited on. The calling thread helps out
+*           instead of blocking
 ************************************************************************/
 void CThreadPool::wait()
 {
     #if !defined(__thread_disable__)
-    // Wait for all the jobs to finish
-    // get() is a blocking call, waiting for each job to return
-    for( auto && iter : m_jobVec ) iter.get();
+    CJobGroup * pGroup = getGroup();
+
+    join( *pGroup );
 
-    // Clear the vector because all jobs are done
-    m_jobVec.clear();
+    // Pass along the exception like the future would have
+    std::exception_ptr exception = pGroup->takeException();
+    if( exception )
+        std::rethrow_exception( exception );
     #endif
 }
 
 
+/************************************************************************
+*    DESC:  Help run jobs until the group is done
+************************************************************************/
+void CThreadPool::join( CJobGroup & group )
+{
+    while( !group.isDone() )
+    {
+        if( !tryRunJob() )
+            std::this_thread::yield();
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Wait for a job and all it's children to complete
+*           The calling thread helps out instead of blocking
+************************************************************************/
+void CThreadPool::wait( const CJobHandle & handle )
+{
+    while( !handle.isDone() )
+    {
+        if( !tryRunJob() )
+            std::this_thread::yield();
+    }
+
+    // Pass along the exception of the job or one of it's children
+    if( handle.isValid() )
+    {
+        std::exception_ptr exception = handle.m_pJob->m_pOwner->takeException( handle );
+        if( exception )
+            std::rethrow_exception( exception );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of worker threads
+************************************************************************/
+int CThreadPool::getWorkerCount() const
+{
+    return m_workers.size();
+}
+
+
+/************************************************************************
+*    DESC:  Get the index of the calling worker thread
+*           Any other thread gets the worker count
+************************************************************************/
+int CThreadPool::getThreadIndex() const
+{
+    if( t_workerIndex < 0 )
+        return m_workers.size();
+
+    return t_workerIndex;
+}
+
+
+/************************************************************************
+*    DESC:  Set the function the workers call before they end
+************************************************************************/
+void CThreadPool::setThreadExit( const std::function<void()> & func )
+{
+    std::unique_lock<std::mutex> lock( m_sleep_mutex );
+    m_threadExitFunc = func;
+}
+
+
 /************************************************************************
 *    DESC:  Lock mutex for Synchronization
 ************************************************************************/
@@ -1,16 +1,20 @@
-
 /************************************************************************
 *    FILE NAME:       threadpool.h
 *
 *    DESCRIPTION:     Class to manage a thread pool
+*                     Work stealing scheduler. Each thread that posts
+*                     jobs owns a lock-free deque that idle workers
+*                     steal from.
 ************************************************************************/
 
 #ifndef __thread_pool_h__
 #define __thread_pool_h__
 
+// Game lib dependencies
+#include <utilities/jobqueue.h>
+
 // Standard lib dependencies
 #include <vector>
-#include <queue>
 #include <thread>
 #include <memory>
 #include <mutex>
@@ -18,6 +22,8 @@
 #include <functional>
 #include <stdexcept>
 #include <future>
+#include <exception>
+#include <algorithm>
 
 // Thread disable flag for testing purposes
 //#define __thread_disable__
@@ -25,7 +31,7 @@
 class CThreadPool
 {
 public:
-    
+
     static CThreadPool & Instance()
     {
         static CThreadPool threadPool;
@@ -36,49 +42,122 @@ public:
     template<class F, class... Args>
     auto postRetFut(F&& f, Args&&... args)
         -> std::future<typename std::result_of<F(Args...)>::type>;
-    
+
     // Post Lambda to the work queue and store future internally
     template<class F, class... Args>
     void post(F&& f, Args&&... args);
-    
-    // Wait for the jobs to complete
+
+    // Wait for the jobs posted by the caller to complete
     void wait();
-    
+
+    // Create a job that is not queued until run is called
+    template<class F>
+    CJobHandle createJob( F && func );
+
+    // Create a job that must finish before it's parent is considered done
+    template<class F>
+    CJobHandle createChildJob( const CJobHandle & parent, F && func );
+
+    // Queue a created job
+    void run( const CJobHandle & handle );
+
+    // Wait for a job and all it's children to complete. Rethrows if one failed
+    void wait( const CJobHandle & handle );
+
+    // Split the range [begin, end) into chunks of grain size and run them in parallel
+    template<class F>
+    void parallel_for( size_t begin, size_t end, size_t grain, F && func );
+
+    // Get the number of worker threads
+    int getWorkerCount() const;
+
+    // Get the index of the calling worker thread. Any other thread gets the worker count
+    // For the data kept per worker plus one for the thread that posts
+    int getThreadIndex() const;
+
+    // Set the function the workers call before they end
+    // For the libraries that keep data per thread
+    void setThreadExit( const std::function<void()> & func );
+
     // Lock mutex for Synchronization
     void lock();
-    
+
     // Unlock mutex for Synchronization
     void unlock();
-    
+
     // Get the mutex
     std::mutex & getMutex();
 
 private:
-    
+
     // Constructor
     CThreadPool();
-    
+
     // Destructor
     ~CThreadPool();
-    
+
+    // Get the queue owned by the calling thread
+    CJobQueue * getQueue();
+
+    // Allocate a job from the calling thread's queue
+    CJob * allocJob();
+
+    // Queue the job
+    void enqueue( CJob * pJob );
+
+    // Pop or steal a job and execute it
+    bool tryRunJob();
+
+    // Execute the job and notify anyone waiting on it
+    void execute( CJob * pJob );
+
+    // Decrement the job's unfinished count and recycle it when done
+    void finish( CJob * pJob );
+
+    // Help run jobs until the group is done
+    void join( CJobGroup & group );
+
+    // Hold on to the exception of a failed job for whoever waits on it
+    void storeException( CJob * pJob, std::exception_ptr exception );
+
+    // Get the group the calling thread or running job posts to
+    CJobGroup * getGroup();
+
+    // Worker thread loop
+    void workerLoop( CJobQueue * pQueue, int index );
+
 private:
-    
+
+    // Maximum number of threads that can own a queue at one time
+    enum{ MAX_QUEUES = 64, SPIN_COUNT = 64 };
+
     // need to keep track of threads so we can join them
     std::vector< std::thread > m_workers;
-    
-    // the task queue
-    std::queue< std::function<void()> > m_tasks;
-    
-    // Store future to wait for end of job que
-    std::vector< std::future<void> > m_jobVec;
+
+    // All the queues. Only added to, never removed
+    std::vector< std::unique_ptr<CJobQueue> > m_queueVec;
+
+    // Lock free copy of the queue list for the stealers
+    std::atomic<CJobQueue *> m_pQueue[MAX_QUEUES];
+    std::atomic<int> m_queueCount;
+
+    // Number of jobs sitting in the queues
+    std::atomic<int> m_queuedJobs;
+
+    // Number of sleeping workers
+    std::atomic<int> m_sleeping;
 
     // synchronization
     std::mutex m_queue_mutex;
+    std::mutex m_sleep_mutex;
     std::mutex m_mutex;
     std::condition_variable m_condition;
-    
+
     // Flag to allow the thread to fall through and end
-    bool m_stop = false;
+    std::atomic<bool> m_stop;
+
+    // Called by the workers before they end
+    std::function<void()> m_threadExitFunc;
 };
 
 
@@ -90,34 +169,22 @@ auto CThreadPool::postRetFut(F&& f, Args&&... args)
     -> std::future<typename std::result_of<F(Args...)>::type>
 {
     using return_type = typename std::result_of < F(Args...)>::type;
-    
-    #if defined(__thread_disable__)
-    auto task = std::make_shared < std::packaged_task < return_type()> >(
+
+    std::packaged_task<return_type()> task(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...) );
-    
-    std::future<return_type> res = task->get_future();
-    (*task)();
-    return res;
-    #else
-    auto task = std::make_shared < std::packaged_task < return_type()> >(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...) );
 
-    std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(m_queue_mutex);
+    std::future<return_type> res = task.get_future();
 
-        // don't allow enqueueing after stopping the pool
-        if( m_stop )
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+    #if defined(__thread_disable__)
+    task();
+    #else
+    CJob * pJob = allocJob();
+    pJob->set( std::move(task) );
 
-        m_tasks.emplace([task]() {
-            (*task)(); });
-    }
-    
-    m_condition.notify_one();
-    
-    return res;
+    enqueue( pJob );
     #endif
+
+    return res;
 }
 
 
@@ -128,23 +195,99 @@ template<class F, class... Args>
 void CThreadPool::post(F&& f, Args&&... args)
 {
     #if defined(__thread_disable__)
-    f();
+    std::bind(std::forward<F>(f), std::forward<Args>(args)...)();
     #else
-    auto task = std::make_shared < std::packaged_task <void()> >(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...) );
+    CJob * pJob = allocJob();
+    pJob->set( std::bind(std::forward<F>(f), std::forward<Args>(args)...) );
+    pJob->m_pGroup = getGroup();
+    pJob->m_pGroup->add();
+
+    enqueue( pJob );
+    #endif
+}
+
+
+/************************************************************************
+*    desc:  Create a job that is not queued until run is called
+************************************************************************/
+template<class F>
+CJobHandle CThreadPool::createJob( F && func )
+{
+    CJob * pJob = allocJob();
+    pJob->set( std::forward<F>(func) );
+
+    return CJobHandle( pJob, pJob->m_generation.load( std::memory_order_relaxed ) );
+}
+
+
+/************************************************************************
+*    desc:  Create a job that must finish before it's parent is done
+*           Children need to be created before the parent finishes,
+*           either before it's run or from inside the parent job
+************************************************************************/
+template<class F>
+CJobHandle CThreadPool::createChildJob( const CJobHandle & parent, F && func )
+{
+    parent.m_pJob->m_unfinished.fetch_add( 1, std::memory_order_relaxed );
+
+    CJobHandle handle = createJob( std::forward<F>(func) );
+    handle.m_pJob->m_pParent = parent.m_pJob;
+
+    return handle;
+}
+
+
+/************************************************************************
+*    desc:  Split the range [begin, end) into chunks of grain size and
+*           run them in parallel. func is called as func( first, last )
+*           The calling thread helps out until all chunks are done
+************************************************************************/
+template<class F>
+void CThreadPool::parallel_for( size_t begin, size_t end, size_t grain, F && func )
+{
+    if( begin >= end )
+        return;
+
+    if( grain == 0 )
+        grain = 1;
 
-    m_jobVec.emplace_back( task->get_future() );
+    #if defined(__thread_disable__)
+    func( begin, end );
+    #else
+    // Not worth the overhead of a job
+    if( (end - begin) <= grain || m_workers.empty() )
     {
-        std::unique_lock<std::mutex> lock( m_queue_mutex );
+        func( begin, end );
+        return;
+    }
 
-        // don't allow enqueueing after stopping the pool
-        if( m_stop )
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
 
-        m_tasks.emplace( [task]{ (*task)(); } );
+    CJobHandle root = createJob( []{} );
+
+    for( size_t first = begin; first < end; first += grain )
+    {
+        const size_t last = std::min( first + grain, end );
+
+        run( createChildJob( root,
+            [&func, &exception, &exceptionMutex, first, last]
+            {
+                try { func( first, last ); }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock( exceptionMutex );
+                    if( !exception )
+                        exception = std::current_exception();
+                }
+            } ) );
     }
-    
-    m_condition.notify_one();
+
+    run( root );
+    wait( root );
+
+    if( exception )
+        std::rethrow_exception( exception );
     #endif
 }
 
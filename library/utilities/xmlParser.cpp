@@ -78,6 +78,7 @@
 #endif
 
 #include <utilities/exceptionhandling.h>
+#include <utilities/xmlcache.h>
 
 #include <memory.h>
 #include <assert.h>
@@ -408,6 +409,12 @@ XMLCHAR xmltoc(XMLCSTR t,const XMLCHAR v){ if (t&&(*t)) return *t; return v; }
 // the following "openFileHelper" function to get an "error reporting mechanism" tailored to your needs.
 XMLNode XMLNode::openFileHelper(XMLCSTR filename, XMLCSTR tag)
 {
+#ifndef _XMLWIDECHAR
+    // Use the baked version of the file if it's up to date
+    XMLNode bakedNode;
+    if (NXMLCache::Load(filename,tag,bakedNode)) return bakedNode;
+#endif
+
     /*#if !(defined(__IOS__) || defined(__ANDROID__))
 
     FILE *f=xfopen(filename,_CXML("rb"));
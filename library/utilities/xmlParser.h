@@ -225,9 +225,12 @@ struct XMLNodeContents;
  *    <li> XMLNode::openFileHelper </li>
  *    <li> XMLNode::createXMLTopNode (or XMLNode::createXMLTopNode_WOSD)</li>
  * </ul> */
+namespace NXMLCache { class CNodeReader; }
 typedef struct XMLDLLENTRY XMLNode
 {
   private:
+    // The baked cache rebuilds trees with the same growth policy as the parser
+    friend class NXMLCache::CNodeReader;
 
     struct XMLNodeDataTag;
 
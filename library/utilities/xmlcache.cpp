@@ -0,0 +1,575 @@
+/************************************************************************
+*    FILE NAME:       xmlcache.cpp
+*
+*    DESCRIPTION:     Baked binary cache of parsed XML files
+*                     XML stays the authoring format. A baked file holds
+*                     the parsed node tree as a flat string table and an
+*                     array of offsets so loading is a straight copy
+*                     instead of a text parse. The baked file sits next to
+*                     the source with the ".bxml" extension and is only
+*                     used when the source still matches. The size and
+*                     modified time are checked first so the source is
+*                     only read and hashed when it's been touched.
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/xmlcache.h>
+
+// Game lib dependencies
+#include <utilities/smartpointers.h>
+
+// SDL lib dependencies
+#include <SDL.h>
+
+// Standard lib dependencies
+#include <sys/stat.h>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <cstring>
+#include <cctype>
+
+namespace NXMLCache
+{
+    namespace
+    {
+        // Baked file layout. All values are little endian.
+        //  CHeader
+        //  string table - null terminated strings, referenced by byte offset
+        //  tree         - uint32 words, the nodes in depth first order
+        //
+        // Each node is written as: name, isDeclaration, element count and then
+        // the elements in the order of the source: type followed by
+        //  child     - the child node
+        //  attribute - name, value
+        //  text      - value
+        //  clear     - value, clear tag index
+        class CHeader
+        {
+        public:
+            char m_magic[4];
+            uint32_t m_version;
+            uint64_t m_sourceHash;
+            uint64_t m_sourceSize;
+            int64_t m_sourceTime;
+            uint32_t m_stringSize;
+            uint32_t m_treeSize;
+        };
+
+        const char MAGIC[4] = { 'B', 'X', 'M', 'L' };
+
+        // Offset of a null string
+        const uint32_t NULL_STRING = 0xFFFFFFFF;
+
+        // Clear tags the parser knows. ie comments, CDATA
+        enum{ CLEAR_TAG_COUNT = 4 };
+
+
+        std::atomic<bool> enableCache(true);
+
+        /************************************************************************
+        *    DESC:  Get the parser's clear tag strings
+        *           The parser compares these by address when writing so the
+        *           rebuilt tree has to point to the parser's own table
+        ************************************************************************/
+        const XMLClear * GetClearTags()
+        {
+            class CClearTags
+            {
+            public:
+                CClearTags()
+                {
+                    m_node = XMLNode::parseString( "<a><![CDATA[0]]><!DOCTYPE 1><!--2--><PRE>3</PRE></a>", "a" );
+
+                    for( int i = 0; (i < CLEAR_TAG_COUNT) && (i < m_node.nClear()); ++i )
+                        m_tag[i] = m_node.getClear( i );
+                }
+
+                // Keep the tree so the strings stay valid
+                XMLNode m_node;
+                XMLClear m_tag[CLEAR_TAG_COUNT] = {};
+            };
+
+            static CClearTags clearTags;
+
+            return clearTags.m_tag;
+        }
+
+        /************************************************************************
+        *    DESC:  Read a file into a buffer
+        *
+        *    ret:   bool - false if the file can't be opened
+        ************************************************************************/
+        bool ReadFile( const std::string & filePath, std::vector<char> & buffer )
+        {
+            NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( filePath.c_str(), "rb" ) );
+            if( scpFile.isNull() )
+                return false;
+
+            const Sint64 size = SDL_RWseek( scpFile.get(), 0, RW_SEEK_END );
+            if( size < 0 )
+                return false;
+
+            buffer.resize( size );
+
+            SDL_RWseek( scpFile.get(), 0, RW_SEEK_SET );
+
+            return (size == 0) || (SDL_RWread( scpFile.get(), buffer.data(), 1, size ) == static_cast<size_t>(size));
+        }
+
+        /************************************************************************
+        *    DESC:  Get the size and modified time of a file
+        *
+        *    ret:   bool - false if the file doesn't exist
+        ************************************************************************/
+        bool GetFileInfo( const std::string & filePath, uint64_t & size, int64_t & time )
+        {
+            struct stat fileStat;
+            if( stat( filePath.c_str(), &fileStat ) != 0 )
+                return false;
+
+            size = fileStat.st_size;
+            time = fileStat.st_mtime;
+
+            return true;
+        }
+
+        /************************************************************************
+        *    DESC:  Case insensitive compare like the parser does for the tag
+        ************************************************************************/
+        bool TagMatch( XMLCSTR name, XMLCSTR tag )
+        {
+            if( (tag == nullptr) || (*tag == 0) )
+                return true;
+
+            if( name == nullptr )
+                return false;
+
+            for( ; *name && *tag; ++name, ++tag )
+                if( std::tolower( static_cast<unsigned char>(*name) ) != std::tolower( static_cast<unsigned char>(*tag) ) )
+                    return false;
+
+            return (*name == *tag);
+        }
+
+        /************************************************************************
+        *    DESC:  Writes the node tree to the string table and tree words
+        ************************************************************************/
+        class CWriter
+        {
+        public:
+
+            // Add a string to the table
+            uint32_t addString( XMLCSTR pStr )
+            {
+                if( pStr == nullptr )
+                    return NULL_STRING;
+
+                auto iter = m_stringMap.find( pStr );
+                if( iter != m_stringMap.end() )
+                    return iter->second;
+
+                const uint32_t offset = m_stringTable.size();
+                m_stringTable.insert( m_stringTable.end(), pStr, pStr + std::strlen( pStr ) + 1 );
+                m_stringMap.emplace( pStr, offset );
+
+                return offset;
+            }
+
+            // Add the node and all it's elements
+            bool addNode( const XMLNode & node )
+            {
+                const XMLClear * pClearTag = GetClearTags();
+                const int elementCount = node.nElement();
+
+                m_treeVec.push_back( addString( node.getName() ) );
+                m_treeVec.push_back( node.isDeclaration() );
+                m_treeVec.push_back( elementCount );
+
+                for( int i = 0; i < elementCount; ++i )
+                {
+                    const XMLNodeContents contents = node.enumContents( i );
+                    m_treeVec.push_back( contents.etype );
+
+                    if( contents.etype == eNodeChild )
+                    {
+                        if( !addNode( contents.child ) )
+                            return false;
+                    }
+                    else if( contents.etype == eNodeAttribute )
+                    {
+                        m_treeVec.push_back( addString( contents.attrib.lpszName ) );
+                        m_treeVec.push_back( addString( contents.attrib.lpszValue ) );
+                    }
+                    else if( contents.etype == eNodeText )
+                    {
+                        m_treeVec.push_back( addString( contents.text ) );
+                    }
+                    else if( contents.etype == eNodeClear )
+                    {
+                        int tag = 0;
+                        while( (tag < CLEAR_TAG_COUNT) && (pClearTag[tag].lpszOpenTag != contents.clear.lpszOpenTag) )
+                            ++tag;
+
+                        // Not one of the parser's clear tags
+                        if( tag == CLEAR_TAG_COUNT )
+                            return false;
+
+                        m_treeVec.push_back( addString( contents.clear.lpszValue ) );
+                        m_treeVec.push_back( tag );
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            std::vector<char> m_stringTable;
+            std::vector<uint32_t> m_treeVec;
+            std::unordered_map<std::string, uint32_t> m_stringMap;
+        };
+    }
+
+
+    /************************************************************************
+    *    DESC:  Rebuilds the node tree from the string table and tree words
+    *           Everything is bounds checked so a damaged file falls back
+    *           to the XML instead of crashing. The element count of each
+    *           node is known so its arrays are allocated once
+    ************************************************************************/
+    class CNodeReader
+    {
+    public:
+
+        CNodeReader( const char * pStringTable, uint32_t stringSize, const uint32_t * pTree, uint32_t treeSize ) :
+            m_pStringTable(pStringTable),
+            m_stringSize(stringSize),
+            m_pTree(pTree),
+            m_treeSize(treeSize),
+            m_index(0)
+        {}
+
+        // Read the next word of the tree
+        bool next( uint32_t & value )
+        {
+            if( m_index >= m_treeSize )
+                return false;
+
+            value = m_pTree[m_index++];
+
+            return true;
+        }
+
+        // Read a string and make a copy the node tree will own
+        bool nextString( XMLSTR & pStr )
+        {
+            uint32_t offset;
+            if( !next( offset ) )
+                return false;
+
+            pStr = nullptr;
+
+            if( offset == NULL_STRING )
+                return true;
+
+            if( offset >= m_stringSize )
+                return false;
+
+            pStr = stringDup( m_pStringTable + offset );
+
+            return true;
+        }
+
+        // Read the top node
+        bool readTop( XMLNode & node )
+        {
+            XMLSTR pName;
+            uint32_t isDeclaration;
+
+            if( !nextString( pName ) )
+                return false;
+
+            if( !next( isDeclaration ) )
+            {
+                freeXMLString( pName );
+                return false;
+            }
+
+            node = XMLNode::createXMLTopNode_WOSD( pName, isDeclaration );
+
+            return readElements( node ) && (m_index == m_treeSize);
+        }
+
+        // Read the elements of a node
+        bool readElements( XMLNode & node )
+        {
+            const XMLClear * pClearTag = GetClearTags();
+
+            uint32_t elementCount;
+            if( !next( elementCount ) || (elementCount > m_treeSize) )
+                return false;
+
+            // Size each element array for the whole node up front so the adds never realloc
+            const int memoryIncrease = elementCount + 1;
+
+            for( uint32_t i = 0; i < elementCount; ++i )
+            {
+                uint32_t type;
+                if( !next( type ) )
+                    return false;
+
+                if( type == eNodeChild )
+                {
+                    XMLSTR pName;
+                    uint32_t isDeclaration;
+
+                    if( !nextString( pName ) )
+                        return false;
+
+                    if( !next( isDeclaration ) )
+                    {
+                        freeXMLString( pName );
+                        return false;
+                    }
+
+                    XMLNode child = node.addChild_priv( memoryIncrease, pName, isDeclaration, -1 );
+
+                    if( !readElements( child ) )
+                        return false;
+                }
+                else if( type == eNodeAttribute )
+                {
+                    XMLSTR pName = nullptr;
+                    XMLSTR pValue = nullptr;
+
+                    if( !nextString( pName ) || !nextString( pValue ) )
+                    {
+                        freeXMLString( pName );
+                        return false;
+                    }
+
+                    node.addAttribute_priv( memoryIncrease, pName, pValue );
+                }
+                else if( type == eNodeText )
+                {
+                    XMLSTR pValue;
+                    if( !nextString( pValue ) )
+                        return false;
+
+                    node.addText_priv( memoryIncrease, pValue, -1 );
+                }
+                else if( type == eNodeClear )
+                {
+                    XMLSTR pValue;
+                    uint32_t tag;
+
+                    if( !nextString( pValue ) )
+                        return false;
+
+                    if( !next( tag ) || (tag >= CLEAR_TAG_COUNT) )
+                    {
+                        freeXMLString( pValue );
+                        return false;
+                    }
+
+                    node.addClear_priv( memoryIncrease, pValue, pClearTag[tag].lpszOpenTag, pClearTag[tag].lpszCloseTag, -1 );
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+    private:
+
+        const char * m_pStringTable;
+        uint32_t m_stringSize;
+        const uint32_t * m_pTree;
+        uint32_t m_treeSize;
+        uint32_t m_index;
+    };
+
+
+    /************************************************************************
+    *    DESC:  Allow the baked files to be used
+    ************************************************************************/
+    void SetEnable( bool enable )
+    {
+        enableCache = enable;
+    }
+
+    bool IsEnabled()
+    {
+        return enableCache;
+    }
+
+
+    /************************************************************************
+    *    DESC:  Load the baked version of the file if it's up to date
+    *           If the source is missing the baked file is used as is so
+    *           a build can ship without the XML
+    *
+    *    ret:   bool - false if the XML needs to be parsed
+    ************************************************************************/
+    bool Load( const std::string & filePath, XMLCSTR tag, XMLNode & node )
+    {
+        if( !enableCache )
+            return false;
+
+        std::vector<char> buffer;
+        if( !ReadFile( filePath + EXTENSION, buffer ) || (buffer.size() < sizeof(CHeader)) )
+            return false;
+
+        CHeader header;
+        std::memcpy( &header, buffer.data(), sizeof(header) );
+
+        if( (std::memcmp( header.m_magic, MAGIC, sizeof(MAGIC) ) != 0) ||
+            (header.m_version != VERSION) ||
+            ((header.m_treeSize % sizeof(uint32_t)) != 0) ||
+            (buffer.size() != sizeof(CHeader) + header.m_stringSize + header.m_treeSize) )
+            return false;
+
+        // Make sure the baked file is from this version of the source
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        if( GetFileInfo( filePath, sourceSize, sourceTime ) )
+        {
+            if( sourceSize != header.m_sourceSize )
+                return false;
+
+            // A new time may only mean the file was touched. ie a checkout. The hash decides
+            if( sourceTime != header.m_sourceTime )
+            {
+                std::vector<char> source;
+                if( !ReadFile( filePath, source ) ||
+                    (source.size() != header.m_sourceSize) ||
+                    (Hash( source.data(), source.size() ) != header.m_sourceHash) )
+                    return false;
+            }
+        }
+
+        // The tree words are copied out so they are aligned
+        std::vector<uint32_t> treeVec( header.m_treeSize / sizeof(uint32_t) );
+        if( !treeVec.empty() )
+            std::memcpy( treeVec.data(), buffer.data() + sizeof(CHeader) + header.m_stringSize, header.m_treeSize );
+
+        const char * pStringTable = buffer.data() + sizeof(CHeader);
+
+        // The string table has to end with a terminator so no read can run past it
+        if( (header.m_stringSize > 0) && (pStringTable[header.m_stringSize - 1] != 0) )
+            return false;
+
+        XMLNode top;
+        CNodeReader reader( pStringTable, header.m_stringSize, treeVec.data(), treeVec.size() );
+
+        if( !reader.readTop( top ) || !TagMatch( top.getName(), tag ) )
+            return false;
+
+        node = top;
+
+        return true;
+
+    }   // Load
+
+
+    /************************************************************************
+    *    DESC:  Bake the parsed node tree of the file
+    *
+    *    ret:   bool - false if it couldn't be written
+    ************************************************************************/
+    bool Save( const std::string & filePath, const XMLNode & node )
+    {
+        if( node.isEmpty() )
+            return false;
+
+        std::vector<char> source;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        if( !GetFileInfo( filePath, sourceSize, sourceTime ) || !ReadFile( filePath, source ) )
+            return false;
+
+        CWriter writer;
+        if( !writer.addNode( node ) )
+            return false;
+
+        CHeader header;
+        std::memcpy( header.m_magic, MAGIC, sizeof(MAGIC) );
+        header.m_version = VERSION;
+        header.m_sourceHash = Hash( source.data(), source.size() );
+        header.m_sourceSize = source.size();
+        header.m_sourceTime = sourceTime;
+        header.m_stringSize = writer.m_stringTable.size();
+        header.m_treeSize = writer.m_treeVec.size() * sizeof(uint32_t);
+
+        NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( (filePath + EXTENSION).c_str(), "wb" ) );
+        if( scpFile.isNull() )
+            return false;
+
+        bool result = (SDL_RWwrite( scpFile.get(), &header, sizeof(header), 1 ) == 1);
+
+        if( result && !writer.m_stringTable.empty() )
+            result = (SDL_RWwrite( scpFile.get(), writer.m_stringTable.data(), writer.m_stringTable.size(), 1 ) == 1);
+
+        if( result && !writer.m_treeVec.empty() )
+            result = (SDL_RWwrite( scpFile.get(), writer.m_treeVec.data(), header.m_treeSize, 1 ) == 1);
+
+        return result;
+
+    }   // Save
+
+
+    /************************************************************************
+    *    DESC:  Parse the file and bake it
+    *           The first element that isn't a declaration is baked
+    *
+    *    ret:   bool - false if it couldn't be parsed or written
+    ************************************************************************/
+    bool Bake( const std::string & filePath )
+    {
+        XMLResults results;
+        XMLNode node = XMLNode::parseFile( filePath.c_str(), nullptr, &results );
+
+        if( results.error != eXMLErrorNone )
+            return false;
+
+        // Skip past the unnamed node holding the declaration
+        if( node.getName() == nullptr )
+        {
+            XMLNode element;
+            for( int i = 0; (i < node.nChildNode()) && element.isEmpty(); ++i )
+                if( !node.getChildNode( i ).isDeclaration() )
+                    element = node.getChildNode( i );
+
+            node = element;
+        }
+
+        return Save( filePath, node );
+
+    }   // Bake
+
+
+    /************************************************************************
+    *    DESC:  Hash of the source file contents. 64 bit FNV-1a
+    ************************************************************************/
+    uint64_t Hash( const void * pData, size_t size )
+    {
+        const unsigned char * pByte = static_cast<const unsigned char *>(pData);
+        uint64_t hash = 0xcbf29ce484222325ULL;
+
+        for( size_t i = 0; i < size; ++i )
+        {
+            hash ^= pByte[i];
+            hash *= 0x100000001b3ULL;
+        }
+
+        return hash;
+
+    }   // Hash
+
+}   // NXMLCache
@@ -0,0 +1,52 @@
+/************************************************************************
+*    FILE NAME:       xmlcache.h
+*
+*    DESCRIPTION:     Baked binary cache of parsed XML files
+*                     XML stays the authoring format. A baked file holds
+*                     the parsed node tree as a flat string table and an
+*                     array of offsets so loading is a straight copy
+*                     instead of a text parse. The baked file sits next to
+*                     the source with the ".bxml" extension and is only
+*                     used when the source still matches. The size and
+*                     modified time are checked first so the source is
+*                     only read and hashed when it's been touched.
+************************************************************************/
+
+#ifndef __xml_cache_h__
+#define __xml_cache_h__
+
+// Game lib dependencies
+#include <utilities/xmlParser.h>
+
+// Standard lib dependencies
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace NXMLCache
+{
+    // Version of the baked format. Bump it when the layout changes
+    const uint32_t VERSION = 2;
+
+    // Extension added to the source file path
+    const char * const EXTENSION = ".bxml";
+
+    // Allow the baked files to be used. Enabled by default
+    void SetEnable( bool enable );
+    bool IsEnabled();
+
+    // Load the baked version of the file if it's up to date
+    bool Load( const std::string & filePath, XMLCSTR tag, XMLNode & node );
+
+    // Bake the parsed node tree of the file
+    bool Save( const std::string & filePath, const XMLNode & node );
+
+    // Parse the file and bake it
+    bool Bake( const std::string & filePath );
+
+    // Hash of the source file contents
+    uint64_t Hash( const void * pData, size_t size );
+
+}   // NXMLCache
+
+#endif  // __xml_cache_h__
@@ -18,6 +18,8 @@
 // Game lib dependencies
 #include <common/build_defs.h>
 #include <system/device.h>
+#include <system/renderdevice.h>
+#include <system/replay.h>
 #include <utilities/settings.h>
 #include <utilities/statcounter.h>
 #include <utilities/highresolutiontimer.h>
@@ -64,6 +66,9 @@
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <cstdlib>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -83,6 +88,9 @@ CGame::CGame()
 ************************************************************************/
 CGame::~CGame()
 {
+    // Close the replay file and print the play back timing
+    CReplay::Instance().stop();
+
     // Destroy the OpenGL context
     if( m_context != nullptr )
         SDL_GL_DeleteContext( m_context );
@@ -119,26 +127,29 @@ void CGame::create()
 void CGame::openGLInit()
 {
     // Init the clear color
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    CRenderDevice::Instance().clearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     // Init the stencil clear mask based on the bit size of the mask
     // Stencil buffer can only be 1 or 8 bits per pixel
     if( CSettings::Instance().getStencilBufferBitSize() == 1 )
-        glStencilMask(0x1);
+        CRenderDevice::Instance().stencilMask(0x1);
     else if( CSettings::Instance().getStencilBufferBitSize() == 8 )
-        glStencilMask(0xff);
+        CRenderDevice::Instance().stencilMask(0xff);
 
     // Cull the back face
-    glFrontFace(GL_CCW);
-    glCullFace(GL_BACK);
-    glEnable(GL_CULL_FACE);
+    CRenderDevice::Instance().frontFace(GL_CCW);
+    CRenderDevice::Instance().cullFace(GL_BACK);
+    CRenderDevice::Instance().enable(GL_CULL_FACE);
 
     // Enable alpha blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CRenderDevice::Instance().enable(GL_BLEND);
+    CRenderDevice::Instance().blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Make the zero texture the active texture
-    glActiveTexture(GL_TEXTURE0);
+    CRenderDevice::Instance().activeTexture(GL_TEXTURE0);
+
+    // This thread owns the context so it's the one that uploads the streamed textures
+    CTextureMgr::Instance().setRenderThread();
 
     // Init the clear buffer mask
     if( CSettings::Instance().getClearTargetBuffer() )
@@ -151,19 +162,19 @@ void CGame::openGLInit()
         m_clearBufferMask |= GL_STENCIL_BUFFER_BIT;
 
     if( CSettings::Instance().getEnableDepthBuffer() )
-        glEnable( GL_DEPTH_TEST );
+        CRenderDevice::Instance().enable( GL_DEPTH_TEST );
 
     // Clear the back buffer and flip it prior to showing the window
     // Keeps us from seeing a flash or flicker of pre init junk
-    glClear( GL_COLOR_BUFFER_BIT );
-    SDL_GL_SwapWindow( m_pWindow );
+    CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
+    CRenderDevice::Instance().present();
 
     // Show the window
     CDevice::Instance().showWindow( true );
 
     // Display a black screen
-    glClear( GL_COLOR_BUFFER_BIT );
-    SDL_GL_SwapWindow( m_pWindow );
+    CRenderDevice::Instance().clear( GL_COLOR_BUFFER_BIT );
+    CRenderDevice::Instance().present();
 }
 
 
@@ -174,6 +185,16 @@ void CGame::init()
 {
     openGLInit();
 
+    // Start recording or playing back the session
+    CReplay::Instance().start(
+        CSettings::Instance().getReplayMode(),
+        CSettings::Instance().getReplayFile(),
+        CSettings::Instance().getReplayRender() );
+
+    // Seed the random number generators so they can be played back
+    std::srand( CReplay::Instance().getSeed() );
+    NGenFunc::SeedRandom( CReplay::Instance().getSeed() );
+
     // Handle some events on startup
     pollEvents();
 
@@ -228,8 +249,8 @@ void CGame::pollEvents()
 
     CActionMgr::Instance().clearQueue();
 
-    // Handle events on queue
-    while( SDL_PollEvent( &msgEvent ) )
+    // Handle events on queue. Recorded or played back by the replay
+    while( CReplay::Instance().pollEvent( msgEvent ) )
     {
         CActionMgr::Instance().queueEvent( msgEvent );
 
@@ -254,19 +275,25 @@ void CGame::pollEvents()
 ****************************************************************************/
 bool CGame::gameLoop()
 {
+    // Begin the replay frame. The game stops when the play back runs out
+    if( !CReplay::Instance().beginFrame() )
+        stopGame();
+
     // Poll for game events
     pollEvents();
 
-    // Get our elapsed time
+    // Get our elapsed time. Played back from the replay
     CHighResTimer::Instance().calcElapsedTime();
+    CReplay::Instance().syncElapsedTime();
 
     // Main script update
+    CScriptMgr::Instance().beginFrame();
     CScriptMgr::Instance().update();
 
     if( m_gameRunning )
     {
         // Clear the buffers
-        glClear( m_clearBufferMask );
+        CRenderDevice::Instance().clear( m_clearBufferMask );
 
         // Process all game states
         CStrategyMgr::Instance().miscProcess();
@@ -277,7 +304,7 @@ bool CGame::gameLoop()
         CStrategyMgr::Instance().render();
 
         // Do the back buffer swap
-        SDL_GL_SwapWindow( m_pWindow );
+        CRenderDevice::Instance().present();
 
         // Unbind everything after a round of rendering
         CShaderMgr::Instance().unbind();
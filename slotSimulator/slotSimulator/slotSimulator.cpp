@@ -0,0 +1,756 @@
+// slotSimulator.cpp : Headless slot math simulator.
+//
+// Loads the same math XML the game does through CSlotMathMgr and spins the
+// slot group model on every core with independent seeded RNG streams.
+// Nothing here touches SDL video, GL or the CBetMgr singleton.
+//
+// Run from the game folder so the data paths resolve. ie
+// slotSimulator --spins 1000000000 --threads 32 --seed 1234
+//
+// --cycle evaluates every stop combination instead for the exact RTP.
+// --brute spins every stop combination through the slot group model and
+// checks the full cycle evaluation against it.
+
+// Game lib dependencies
+#include <slot/slotmathmanager.h>
+#include <slot/slotgroupmodel.h>
+#include <slot/playresult.h>
+#include <slot/paycombo.h>
+#include <slot/paytableset.h>
+#include <slot/paylineset.h>
+#include <slot/slotcycleevaluator.h>
+#include <utilities/exceptionhandling.h>
+
+// Standard lib dependencies
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// Command line settings
+struct CSimSettings
+{
+    std::string listTable = "data/objects/2d/slot/mathListTable.lst";
+    std::string group = "(big_pay_back)";
+    std::string mathId = "slot";
+    std::string stripSetId = "main_reel_strip";
+    std::string paytableSetId = "main_paytable";
+    std::string paylineFile = "data/objects/2d/slot/payline_4x5.cfg";
+    uint64_t spins = 10000000;
+    uint threads = 0;
+    uint lineBet = 1;
+    uint32_t seed = 0;
+    bool seedSet = false;
+    bool cycle = false;
+    bool brute = false;
+};
+
+// Hits and win of one pay combo
+struct CComboStat
+{
+    uint64_t hits = 0;
+    uint64_t win = 0;
+};
+
+// Stats kept by each thread and reduced at the end
+struct CSimStats
+{
+    uint64_t spins = 0;
+    uint64_t hits = 0;
+    uint64_t totalWin = 0;
+    uint64_t maxWin = 0;
+    long double winSquared = 0;
+    std::vector<CComboStat> comboStatVec;
+};
+
+// Number of spins the sum of squares is kept as an integer before it's moved to the long double
+const uint64_t SQUARE_FLUSH = 0x10000;
+
+/************************************************************************
+*    DESC:  Print the command line options
+************************************************************************/
+void PrintUsage()
+{
+    std::cout
+        << "slotSimulator [options]" << std::endl
+        << "  --list <file>        math list table (data/objects/2d/slot/mathListTable.lst)" << std::endl
+        << "  --group <name>       math group ((big_pay_back))" << std::endl
+        << "  --math <id>          slot math id (slot)" << std::endl
+        << "  --strips <id>        strip set id (main_reel_strip)" << std::endl
+        << "  --paytable <id>      paytable set id (main_paytable)" << std::endl
+        << "  --paylines <file>    payline set file (data/objects/2d/slot/payline_4x5.cfg)" << std::endl
+        << "  --spins <count>      total number of spins (10000000)" << std::endl
+        << "  --threads <count>    worker threads, 0 = all cores (0)" << std::endl
+        << "  --lineBet <credits>  line bet (1)" << std::endl
+        << "  --seed <value>       base seed, random if not set" << std::endl
+        << "  --cycle              evaluate the full cycle for the exact RTP" << std::endl
+        << "  --brute              check the full cycle against every combination of the model" << std::endl;
+}
+
+/************************************************************************
+*    DESC:  Parse the command line
+*
+*    ret:   bool - false if the program should exit
+************************************************************************/
+bool ParseCommandLine( int argc, char * argv[], CSimSettings & settings )
+{
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+
+        if( (arg == "--help") || (arg == "-h") )
+        {
+            PrintUsage();
+            return false;
+        }
+
+        if( arg == "--cycle" )
+        {
+            settings.cycle = true;
+            continue;
+        }
+
+        if( arg == "--brute" )
+        {
+            settings.brute = true;
+            continue;
+        }
+
+        if( i + 1 >= argc )
+        {
+            std::cout << "Missing value for " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+
+        const char * pValue = argv[++i];
+
+        if( arg == "--list" )
+            settings.listTable = pValue;
+
+        else if( arg == "--group" )
+            settings.group = pValue;
+
+        else if( arg == "--math" )
+            settings.mathId = pValue;
+
+        else if( arg == "--strips" )
+            settings.stripSetId = pValue;
+
+        else if( arg == "--paytable" )
+            settings.paytableSetId = pValue;
+
+        else if( arg == "--paylines" )
+            settings.paylineFile = pValue;
+
+        else if( arg == "--spins" )
+            settings.spins = std::strtoull( pValue, nullptr, 10 );
+
+        else if( arg == "--threads" )
+            settings.threads = std::strtoul( pValue, nullptr, 10 );
+
+        else if( arg == "--lineBet" )
+            settings.lineBet = std::strtoul( pValue, nullptr, 10 );
+
+        else if( arg == "--seed" )
+        {
+            settings.seed = std::strtoul( pValue, nullptr, 10 );
+            settings.seedSet = true;
+        }
+        else
+        {
+            std::cout << "Unknown option " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if( settings.lineBet == 0 )
+        settings.lineBet = 1;
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Run the spins for one thread
+*           Each thread has it's own model, play result and RNG stream
+************************************************************************/
+void RunSpins(
+    const CSimSettings & settings,
+    const CSlotMath & rSlotMath,
+    const std::unordered_map<const CPayCombo *, size_t> & comboIndexMap,
+    const uint totalBet,
+    const uint threadIndex,
+    const uint64_t spins,
+    CSimStats & stats )
+{
+    CPlayResult playResult;
+    CSlotGroupModel model( rSlotMath, playResult );
+    model.create( settings.stripSetId, settings.paytableSetId );
+
+    // The thread index makes each stream independent of the others
+    std::seed_seq seedSeq{ settings.seed, threadIndex };
+    model.seed( seedSeq );
+
+    uint64_t winSquared = 0;
+
+    for( uint64_t spin = 0; spin < spins; ++spin )
+    {
+        playResult.clear();
+        model.generateStops();
+        model.evaluate( settings.lineBet, totalBet );
+
+        const uint64_t win = playResult.addUpWin();
+
+        if( win > 0 )
+        {
+            ++stats.hits;
+            stats.totalWin += win;
+            winSquared += win * win;
+
+            if( win > stats.maxWin )
+                stats.maxWin = win;
+
+            for( uint i = 0; i < playResult.getPayCount(); ++i )
+            {
+                const CPay & rPay = playResult.getPay( i );
+                auto iter = comboIndexMap.find( rPay.getPayCombo() );
+
+                if( iter != comboIndexMap.end() )
+                {
+                    CComboStat & rStat = stats.comboStatVec[iter->second];
+                    ++rStat.hits;
+                    rStat.win += rPay.getFinalAward();
+                }
+            }
+        }
+
+        if( (spin % SQUARE_FLUSH) == (SQUARE_FLUSH - 1) )
+        {
+            stats.winSquared += winSquared;
+            winSquared = 0;
+        }
+    }
+
+    stats.winSquared += winSquared;
+    stats.spins = spins;
+}
+
+/************************************************************************
+*    DESC:  Format a "1 in x" hit rate
+************************************************************************/
+std::string OneIn( uint64_t spins, uint64_t hits )
+{
+    if( hits == 0 )
+        return "never";
+
+    std::stringstream ss;
+    ss << "1 in " << std::fixed << std::setprecision(2) << ((long double)spins / hits);
+
+    return ss.str();
+}
+
+/************************************************************************
+*    DESC:  Print the reduced stats
+************************************************************************/
+void PrintReport(
+    const CSimStats & stats,
+    const std::vector<const CPayCombo *> & comboVec,
+    const uint totalBet,
+    const double seconds )
+{
+    const long double spins = stats.spins;
+    const long double totalBetAmount = spins * totalBet;
+
+    // Each spin's win in units of the total bet
+    const long double rtp = stats.totalWin / totalBetAmount;
+    const long double meanSquare = (stats.winSquared / ((long double)totalBet * totalBet)) / spins;
+    const long double variance = std::max( meanSquare - (rtp * rtp), (long double)0 );
+    const long double stdDev = std::sqrt( variance );
+    const long double stdError = stdDev / std::sqrt( spins );
+
+    std::cout << std::fixed << std::endl;
+    std::cout << "Spins:                " << stats.spins << std::endl;
+    std::cout << "Total bet:            " << (uint64_t)totalBetAmount << std::endl;
+    std::cout << "Total win:            " << stats.totalWin << std::endl;
+    std::cout << "Max win:              " << stats.maxWin << " (" << std::setprecision(2) << ((long double)stats.maxWin / totalBet) << "x)" << std::endl;
+    std::cout << std::setprecision(6);
+    std::cout << "Hit frequency:        " << (stats.hits / spins) * 100 << "% (" << OneIn( stats.spins, stats.hits ) << ")" << std::endl;
+    std::cout << "RTP:                  " << rtp * 100 << "%" << std::endl;
+    std::cout << "Std deviation:        " << stdDev << std::endl;
+    std::cout << "Volatility index 90%: " << stdDev * 1.645 << std::endl;
+    std::cout << "RTP 90% confidence:   " << (rtp - 1.645 * stdError) * 100 << "% - " << (rtp + 1.645 * stdError) * 100 << "%" << std::endl;
+    std::cout << "RTP 95% confidence:   " << (rtp - 1.960 * stdError) * 100 << "% - " << (rtp + 1.960 * stdError) * 100 << "%" << std::endl;
+    std::cout << "RTP 99% confidence:   " << (rtp - 2.576 * stdError) * 100 << "% - " << (rtp + 2.576 * stdError) * 100 << "%" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Time:                 " << seconds << " sec (" << (uint64_t)(spins / seconds) << " spins/sec)" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(20) << "Symbol" << std::right << std::setw(6) << "Count" << std::setw(8) << "Award"
+              << std::setw(16) << "Hits" << std::setw(24) << "Hit rate" << std::setw(14) << "RTP %" << std::endl;
+    std::cout << std::string( 88, '-' ) << std::endl;
+
+    for( size_t i = 0; i < comboVec.size(); ++i )
+    {
+        const CComboStat & rStat = stats.comboStatVec[i];
+
+        std::cout << std::left << std::setw(20) << comboVec[i]->getSymbol() << std::right
+                  << std::setw(6) << comboVec[i]->getCount()
+                  << std::setw(8) << comboVec[i]->getAward()
+                  << std::setw(16) << rStat.hits
+                  << std::setw(24) << OneIn( stats.spins, rStat.hits )
+                  << std::setw(14) << std::setprecision(6) << ((rStat.win / totalBetAmount) * 100) << std::endl;
+    }
+}
+
+/************************************************************************
+*    DESC:  Load the math
+************************************************************************/
+const CSlotMath & LoadMath( const CSimSettings & settings )
+{
+    CSlotMathMgr::Instance().loadListTable( settings.listTable );
+    CSlotMathMgr::Instance().loadGroup( settings.group );
+    CSlotMathMgr::Instance().loadPaylineSetFromFile( settings.paylineFile );
+
+    return CSlotMathMgr::Instance().getSlotMath( settings.group, settings.mathId );
+}
+
+/************************************************************************
+*    DESC:  Load the math and run the simulation
+************************************************************************/
+int Simulate( const CSimSettings & settings )
+{
+    const CSlotMath & rSlotMath = LoadMath( settings );
+    const uint totalLines = CSlotMathMgr::Instance().getPaylineSet( rSlotMath.getPaylineSetID() ).getLineData().size();
+    const uint totalBet = settings.lineBet * totalLines;
+
+    // Index every pay combo in the paytable set for the per combo stats
+    std::vector<const CPayCombo *> comboVec;
+    std::unordered_map<const CPayCombo *, size_t> comboIndexMap;
+    for( auto & paytableIter : rSlotMath.getPaytableSet( settings.paytableSetId ) )
+    {
+        for( auto & comboIter : rSlotMath.getPayComboSet( paytableIter.getId() ) )
+        {
+            comboIndexMap.emplace( &comboIter, comboVec.size() );
+            comboVec.push_back( &comboIter );
+        }
+    }
+
+    uint threadCount = settings.threads;
+    if( threadCount == 0 )
+        threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::cout << "Math:      " << settings.group << " " << settings.mathId << " " << settings.stripSetId << " " << settings.paytableSetId << std::endl;
+    std::cout << "Lines:     " << totalLines << ", line bet " << settings.lineBet << ", total bet " << totalBet << std::endl;
+    std::cout << "Threads:   " << threadCount << std::endl;
+    std::cout << "Seed:      " << settings.seed << std::endl;
+
+    std::vector<CSimStats> statsVec( threadCount );
+    for( auto & iter : statsVec )
+        iter.comboStatVec.resize( comboVec.size() );
+
+    std::vector<std::thread> threadVec;
+    std::mutex errorMutex;
+    std::string error;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for( uint i = 0; i < threadCount; ++i )
+    {
+        // Spread the remainder over the first threads
+        const uint64_t spins = (settings.spins / threadCount) + ((i < (settings.spins % threadCount)) ? 1 : 0);
+
+        threadVec.emplace_back(
+            [&, i, spins]
+            {
+                try
+                {
+                    RunSpins( settings, rSlotMath, comboIndexMap, totalBet, i, spins, statsVec[i] );
+                }
+                catch( NExcept::CCriticalException & ex )
+                {
+                    std::lock_guard<std::mutex> lock( errorMutex );
+                    error = ex.getErrorTitle() + "\n" + ex.getErrorMsg();
+                }
+            } );
+    }
+
+    for( auto & iter : threadVec )
+        iter.join();
+
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    if( !error.empty() )
+    {
+        std::cout << error << std::endl;
+        return 1;
+    }
+
+    // Reduce the thread stats
+    CSimStats total;
+    total.comboStatVec.resize( comboVec.size() );
+
+    for( auto & iter : statsVec )
+    {
+        total.spins += iter.spins;
+        total.hits += iter.hits;
+        total.totalWin += iter.totalWin;
+        total.winSquared += iter.winSquared;
+        total.maxWin = std::max( total.maxWin, iter.maxWin );
+
+        for( size_t i = 0; i < comboVec.size(); ++i )
+        {
+            total.comboStatVec[i].hits += iter.comboStatVec[i].hits;
+            total.comboStatVec[i].win += iter.comboStatVec[i].win;
+        }
+    }
+
+    if( total.spins > 0 )
+        PrintReport( total, comboVec, totalBet, seconds );
+
+    return 0;
+}
+
+/************************************************************************
+*    DESC:  Reduce a fraction
+************************************************************************/
+std::string Fraction( CSlotCycleEvaluator::cycle_t num, CSlotCycleEvaluator::cycle_t den )
+{
+    CSlotCycleEvaluator::cycle_t a = num, b = den;
+    while( b != 0 )
+    {
+        CSlotCycleEvaluator::cycle_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    if( a > 1 )
+    {
+        num /= a;
+        den /= a;
+    }
+
+    return num.str() + "/" + den.str();
+}
+
+/************************************************************************
+*    DESC:  Format a fraction as a decimal with integer math
+************************************************************************/
+std::string Decimal( const CSlotCycleEvaluator::cycle_t & num, const CSlotCycleEvaluator::cycle_t & den, const int places )
+{
+    if( den == 0 )
+        return "0";
+
+    CSlotCycleEvaluator::cycle_t scale = 1;
+    for( int i = 0; i < places; ++i )
+        scale *= 10;
+
+    // Round to the nearest last place
+    const CSlotCycleEvaluator::cycle_t value = ((num * scale * 2) + den) / (den * 2);
+    std::string fraction = CSlotCycleEvaluator::cycle_t( value % scale ).str();
+
+    return CSlotCycleEvaluator::cycle_t( value / scale ).str() + "." + std::string( places - fraction.size(), '0' ) + fraction;
+}
+
+/************************************************************************
+*    DESC:  Load the math and evaluate the full cycle
+************************************************************************/
+int EvaluateCycle( const CSimSettings & settings )
+{
+    typedef CSlotCycleEvaluator::cycle_t cycle_t;
+
+    const CSlotMath & rSlotMath = LoadMath( settings );
+    const CPaylineSet & rPaylineSet = CSlotMathMgr::Instance().getPaylineSet( rSlotMath.getPaylineSetID() );
+    const uint totalLines = rPaylineSet.getLineData().size();
+    const uint totalBet = settings.lineBet * totalLines;
+
+    std::cout << "Math:      " << settings.group << " " << settings.mathId << " " << settings.stripSetId << " " << settings.paytableSetId << std::endl;
+    std::cout << "Lines:     " << totalLines << ", line bet " << settings.lineBet << ", total bet " << totalBet << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+
+    CSlotCycleEvaluator cycleEval( rSlotMath, rPaylineSet, settings.stripSetId, settings.paytableSetId );
+    cycleEval.evaluate( settings.lineBet, totalBet, settings.threads );
+
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    const cycle_t & cycle = cycleEval.getCycle();
+    const cycle_t totalBetAmount = cycle * totalBet;
+
+    // Variance of the win in units of the total bet
+    const long double mean = cycleEval.getTotalWin().convert_to<long double>() / totalBetAmount.convert_to<long double>();
+    const long double meanSquare =
+        cycleEval.getTotalWinSquared().convert_to<long double>() / (cycle.convert_to<long double>() * totalBet * totalBet);
+    const long double stdDev = std::sqrt( std::max( meanSquare - (mean * mean), (long double)0 ) );
+
+    std::cout << std::fixed << std::endl;
+    std::cout << "Cycle:                " << cycle.str() << std::endl;
+    std::cout << "Total bet:            " << totalBetAmount.str() << std::endl;
+    std::cout << "Total win:            " << cycleEval.getTotalWin().str() << std::endl;
+    std::cout << "Max win:              " << cycleEval.getMaxWin() << " (" << std::setprecision(2) << ((long double)cycleEval.getMaxWin() / totalBet) << "x)" << std::endl;
+    std::cout << "Hit frequency:        " << Decimal( cycleEval.getHits() * 100, cycle, 6 ) << "% (" << Fraction( cycleEval.getHits(), cycle ) << ")" << std::endl;
+    std::cout << "RTP:                  " << Decimal( cycleEval.getTotalWin() * 100, totalBetAmount, 6 ) << "% (" << Fraction( cycleEval.getTotalWin(), totalBetAmount ) << ")" << std::endl;
+    std::cout << std::setprecision(6);
+    std::cout << "Std deviation:        " << stdDev << std::endl;
+    std::cout << "Volatility index 90%: " << stdDev * 1.645 << std::endl;
+    std::cout << "Memoized states:      " << cycleEval.getStateCount() << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Time:                 " << seconds << " sec" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(20) << "Symbol" << std::right << std::setw(6) << "Count" << std::setw(8) << "Award"
+              << std::setw(20) << "Hits" << std::setw(20) << "Hit rate" << std::setw(14) << "RTP %" << std::endl;
+    std::cout << std::string( 88, '-' ) << std::endl;
+
+    const auto & rComboVec = cycleEval.getPayComboVec();
+    const auto & rHitVec = cycleEval.getComboHitVec();
+
+    // Find the first scatter combo to know which bet the award is multiplied by
+    size_t scatterStart = 0;
+    for( auto & paytableIter : rSlotMath.getPaytableSet( settings.paytableSetId ) )
+        if( paytableIter.getType() == NSlotDefs::EP_PAYLINE )
+            scatterStart += rSlotMath.getPayComboSet( paytableIter.getId() ).size();
+
+    for( size_t i = 0; i < rComboVec.size(); ++i )
+    {
+        const uint bet = (i < scatterStart) ? settings.lineBet : totalBet;
+        const cycle_t win = rHitVec[i] * rComboVec[i]->getAward() * bet;
+        std::string hitRate = "never";
+
+        if( rHitVec[i] != 0 )
+            hitRate = "1 in " + Decimal( cycle, rHitVec[i], 2 );
+
+        std::cout << std::left << std::setw(20) << rComboVec[i]->getSymbol() << std::right
+                  << std::setw(6) << rComboVec[i]->getCount()
+                  << std::setw(8) << rComboVec[i]->getAward()
+                  << std::setw(20) << rHitVec[i].str()
+                  << std::setw(20) << hitRate
+                  << std::setw(14) << Decimal( win * 100, totalBetAmount, 6 ) << std::endl;
+    }
+
+    return 0;
+}
+
+/************************************************************************
+*    DESC:  Compare a brute force sum to the full cycle sum
+************************************************************************/
+bool CheckSum( const std::string & name, const CSlotCycleEvaluator::cycle_t & brute, const CSlotCycleEvaluator::cycle_t & cycle )
+{
+    const bool match = (brute == cycle);
+
+    std::cout << (match ? "PASS  " : "FAIL  ") << std::left << std::setw(24) << name << std::right
+              << brute.str() << (match ? " == " : " != ") << cycle.str() << std::endl;
+
+    return match;
+}
+
+/************************************************************************
+*    DESC:  Spin every stop combination through the slot group model
+*           and check the full cycle evaluation against the sums
+************************************************************************/
+int BruteForceCycle( const CSimSettings & settings )
+{
+    typedef CSlotCycleEvaluator::cycle_t cycle_t;
+
+    const CSlotMath & rSlotMath = LoadMath( settings );
+    const CPaylineSet & rPaylineSet = CSlotMathMgr::Instance().getPaylineSet( rSlotMath.getPaylineSetID() );
+    const uint totalBet = settings.lineBet * rPaylineSet.getLineData().size();
+
+    std::cout << "Math:      " << settings.group << " " << settings.mathId << " " << settings.stripSetId << " " << settings.paytableSetId << std::endl;
+
+    CSlotCycleEvaluator cycleEval( rSlotMath, rPaylineSet, settings.stripSetId, settings.paytableSetId );
+    cycleEval.evaluate( settings.lineBet, totalBet, settings.threads );
+
+    const auto & rComboVec = cycleEval.getPayComboVec();
+    std::unordered_map<const CPayCombo *, size_t> comboIndexMap;
+    for( size_t i = 0; i < rComboVec.size(); ++i )
+        comboIndexMap.emplace( rComboVec[i], i );
+
+    // Sums of one thread
+    struct CBruteSums
+    {
+        cycle_t weight, win, winSquared, hits;
+        uint64_t maxWin = 0;
+        std::vector<cycle_t> comboHitVec;
+    };
+
+    uint threadCount = settings.threads;
+    if( threadCount == 0 )
+        threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::vector<CBruteSums> sumsVec( threadCount );
+    std::vector<std::thread> threadVec;
+    std::atomic<int> nextStop( 0 );
+    std::mutex errorMutex;
+    std::string error;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // The stops of the first strip are handed out to the threads
+    for( uint t = 0; t < threadCount; ++t )
+    {
+        threadVec.emplace_back(
+            [&, t]
+            {
+                try
+                {
+                    CBruteSums & rSums = sumsVec[t];
+                    rSums.comboHitVec.resize( rComboVec.size() );
+
+                    CPlayResult playResult;
+                    CSlotGroupModel model( rSlotMath, playResult );
+                    model.create( settings.stripSetId, settings.paytableSetId );
+
+                    const size_t stripCount = model.getCount();
+                    std::vector<int> stopVec( stripCount );
+
+                    for( int firstStop = nextStop++; firstStop < (int)model.getStrip(0).getStripVec().size(); firstStop = nextStop++ )
+                    {
+                        std::fill( stopVec.begin(), stopVec.end(), 0 );
+                        stopVec[0] = firstStop;
+
+                        // Step the other strips like an odometer
+                        size_t strip;
+                        do
+                        {
+                            model.setStops( stopVec );
+
+                            cycle_t weight = 1;
+                            for( size_t i = 0; i < stripCount; ++i )
+                                weight *= model.getStrip(i).getStripVec()[stopVec[i]].getWeight();
+
+                            playResult.clear();
+                            model.evaluate( settings.lineBet, totalBet );
+
+                            const uint64_t win = playResult.addUpWin();
+
+                            rSums.weight += weight;
+
+                            if( win > 0 )
+                            {
+                                rSums.win += weight * win;
+                                rSums.winSquared += weight * win * win;
+                                rSums.hits += weight;
+                                rSums.maxWin = std::max( rSums.maxWin, win );
+
+                                for( uint i = 0; i < playResult.getPayCount(); ++i )
+                                {
+                                    auto iter = comboIndexMap.find( playResult.getPay( i ).getPayCombo() );
+                                    if( iter != comboIndexMap.end() )
+                                        rSums.comboHitVec[iter->second] += weight;
+                                }
+                            }
+
+                            for( strip = stripCount - 1; strip > 0; --strip )
+                            {
+                                if( ++stopVec[strip] < (int)model.getStrip(strip).getStripVec().size() )
+                                    break;
+
+                                stopVec[strip] = 0;
+                            }
+                        }
+                        while( strip > 0 );
+                    }
+                }
+                catch( NExcept::CCriticalException & ex )
+                {
+                    std::lock_guard<std::mutex> lock( errorMutex );
+                    error = ex.getErrorTitle() + "\n" + ex.getErrorMsg();
+                }
+            } );
+    }
+
+    for( auto & iter : threadVec )
+        iter.join();
+
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    if( !error.empty() )
+    {
+        std::cout << error << std::endl;
+        return 1;
+    }
+
+    // Reduce the thread sums
+    CBruteSums total;
+    total.comboHitVec.resize( rComboVec.size() );
+
+    for( auto & iter : sumsVec )
+    {
+        total.weight += iter.weight;
+        total.win += iter.win;
+        total.winSquared += iter.winSquared;
+        total.hits += iter.hits;
+        total.maxWin = std::max( total.maxWin, iter.maxWin );
+
+        for( size_t i = 0; i < rComboVec.size(); ++i )
+            total.comboHitVec[i] += iter.comboHitVec[i];
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << "Time:      " << seconds << " sec" << std::endl << std::endl;
+
+    bool match = true;
+    match &= CheckSum( "Cycle", total.weight, cycleEval.getCycle() );
+    match &= CheckSum( "Total win", total.win, cycleEval.getTotalWin() );
+    match &= CheckSum( "Total win squared", total.winSquared, cycleEval.getTotalWinSquared() );
+    match &= CheckSum( "Hits", total.hits, cycleEval.getHits() );
+    match &= CheckSum( "Max win", total.maxWin, cycleEval.getMaxWin() );
+
+    for( size_t i = 0; i < rComboVec.size(); ++i )
+        match &= CheckSum(
+            rComboVec[i]->getSymbol() + " " + std::to_string( rComboVec[i]->getCount() ),
+            total.comboHitVec[i], cycleEval.getComboHitVec()[i] );
+
+    if( !match )
+    {
+        std::cout << std::endl << "Full cycle results don't match!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main( int argc, char * argv[] )
+{
+    CSimSettings settings;
+
+    if( !ParseCommandLine( argc, argv, settings ) )
+        return 0;
+
+    if( !settings.seedSet )
+        settings.seed = std::random_device()();
+
+    try
+    {
+        if( settings.brute )
+            return BruteForceCycle( settings );
+
+        if( settings.cycle )
+            return EvaluateCycle( settings );
+
+        return Simulate( settings );
+    }
+    catch( NExcept::CCriticalException & ex )
+    {
+        std::cout << ex.getErrorTitle() << std::endl << ex.getErrorMsg() << std::endl;
+    }
+    catch( std::exception & ex )
+    {
+        std::cout << ex.what() << std::endl;
+    }
+
+    return 1;
+}
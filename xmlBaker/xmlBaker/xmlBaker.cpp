@@ -0,0 +1,91 @@
+// xmlBaker.cpp : Bakes XML data files into the binary cache.
+//
+// Each file on the command line is parsed and written next to the source
+// with the ".bxml" extension. The game loads the baked file instead of
+// parsing the XML for as long as the source doesn't change.
+//
+// Run from the game folder. ie
+// find data -name "*.xml" -o -name "*.lst" -o -name "*.cfg" | xargs xmlBaker
+//
+// --clean removes the baked files instead.
+
+// Game lib dependencies
+#include <utilities/xmlcache.h>
+
+// Standard lib dependencies
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+/************************************************************************
+*    DESC:  Print the command line options
+************************************************************************/
+void PrintUsage()
+{
+    std::cout
+        << "xmlBaker [options] <file> [file...]" << std::endl
+        << "  --clean              remove the baked files instead" << std::endl
+        << "  --quiet              only print the files that fail" << std::endl;
+}
+
+/************************************************************************
+*    DESC:  Main entry point
+************************************************************************/
+int main( int argc, char * argv[] )
+{
+    std::vector<std::string> fileVec;
+    bool clean = false;
+    bool quiet = false;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+
+        if( (arg == "--help") || (arg == "-h") )
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        if( arg == "--clean" )
+            clean = true;
+
+        else if( arg == "--quiet" )
+            quiet = true;
+
+        else
+            fileVec.push_back( arg );
+    }
+
+    if( fileVec.empty() )
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    int failCount = 0;
+
+    for( auto & iter : fileVec )
+    {
+        if( clean )
+        {
+            std::remove( (iter + NXMLCache::EXTENSION).c_str() );
+        }
+        else if( NXMLCache::Bake( iter ) )
+        {
+            if( !quiet )
+                std::cout << "Baked " << iter << std::endl;
+        }
+        else
+        {
+            std::cout << "Failed to bake " << iter << std::endl;
+            ++failCount;
+        }
+    }
+
+    if( !clean )
+        std::cout << (fileVec.size() - failCount) << " of " << fileVec.size() << " files baked" << std::endl;
+
+    return (failCount == 0) ? 0 : 1;
+}